@@ -45,6 +45,16 @@ set(LIB_SUFFIX "" CACHE STRING "Suffix for 'lib' directories, e.g. '64'")
 option(WANT_THREADS "Enable multi threaded support." off)
 
 
+#------------------------------------------------------------------------------------#
+#                      Statically linked plug-ins (Default none)                     #
+#------------------------------------------------------------------------------------#
+
+# List of plug-in (lowercase) names that are linked into the Speect Engine
+# library instead of being built as dynamic shared objects, for example
+# "audio;array_float;utt_ebml". Requires CMake >= 3.13.
+set(STATIC_PLUGINS "" CACHE STRING "List of plug-ins to link statically into the Speect Engine library.")
+
+
 #------------------------------------------------------------------------------------#
 #                                Developers options                                  #
 #------------------------------------------------------------------------------------#
@@ -0,0 +1,87 @@
+######################################################################################
+##                                                                                  ##
+## AUTHOR  : Speect contributors                                                    ##
+## DATE    : October 2026                                                           ##
+##                                                                                  ##
+######################################################################################
+##                                                                                  ##
+## Speect Engine source files                                                       ##
+## Monotonic clock implementations abstraction                                      ##
+##                                                                                  ##
+######################################################################################
+
+# SPCT_TIME_SPECIFIC_IMPL_INCLUDES : list of implementation include files
+# SPCT_TIME_SPECIFIC_IMPL_DIR      : implementation directory
+
+
+set(SPCT_TIME_SUPPORT 0)
+
+#------------------------------------------------------------------------------------#
+#                              POSIX implementation                                  #
+#------------------------------------------------------------------------------------#
+
+set(SPCT_SRC_POSIX_TIME_FILES
+  posix/posix_stime.c
+)
+
+set(SPCT_INCLUDE_POSIX_TIME_FILES
+  posix/posix_stime.h
+)
+
+if(SPCT_UNIX OR SPCT_MACOSX)
+  set(SPCT_TIME_SPECIFIC_IMPL "${SPCT_INCLUDE_POSIX_TIME_FILES}")
+  set(SPCT_TIME_SPECIFIC_IMPL_DIR "posix")
+  list(APPEND SPCT_LIBRARY_SOURCES "${CMAKE_SPEECT_SOURCE_DIR}/engine/src/base/utils/platform/${SPCT_SRC_POSIX_TIME_FILES}")
+
+  set(SPCT_TIME_SUPPORT 1)
+endif(SPCT_UNIX OR SPCT_MACOSX)
+
+
+#------------------------------------------------------------------------------------#
+#                              WIN32 implementation                                  #
+#------------------------------------------------------------------------------------#
+
+set(SPCT_SRC_WIN32_TIME_FILES
+  win32/win32_stime.c
+)
+
+set(SPCT_INCLUDE_WIN32_TIME_FILES
+  win32/win32_stime.h
+)
+
+
+if(SPCT_WIN32)
+  set(SPCT_TIME_SPECIFIC_IMPL "${SPCT_INCLUDE_WIN32_TIME_FILES}")
+  set(SPCT_TIME_SPECIFIC_IMPL_DIR "win32")
+  list(APPEND SPCT_LIBRARY_SOURCES "${CMAKE_SPEECT_SOURCE_DIR}/engine/src/base/utils/platform/${SPCT_SRC_WIN32_TIME_FILES}")
+
+  set(SPCT_TIME_SUPPORT 1)
+endif(SPCT_WIN32)
+
+
+#------------------------------------------------------------------------------------#
+#                               engine header                                        #
+#------------------------------------------------------------------------------------#
+
+configure_file(${CMAKE_SPEECT_SOURCE_DIR}/engine/config/stime_impl.h.in 
+  ${CMAKE_SPEECT_BINARY_DIR}/engine/src/base/utils/platform/stime_impl.h)
+
+
+#------------------------------------------------------------------------------------#
+#                               installation                                         #
+#------------------------------------------------------------------------------------#
+
+install(FILES ${CMAKE_SPEECT_SOURCE_DIR}/engine/src/base/utils/platform/${SPCT_TIME_SPECIFIC_IMPL}
+  DESTINATION include/speect/engine/base/utils/platform/${SPCT_TIME_SPECIFIC_IMPL_DIR}/)
+
+install(FILES ${CMAKE_SPEECT_BINARY_DIR}/engine/src/base/utils/platform/stime_impl.h
+  DESTINATION include/speect/engine/base/utils/platform)
+
+
+#------------------------------------------------------------------------------------#
+#                          Error if no implementation                                #
+#------------------------------------------------------------------------------------#
+
+if(NOT SPCT_TIME_SUPPORT)
+  message(FATAL_ERROR "Unknown monotonic clock support.")    
+endif(NOT SPCT_TIME_SUPPORT)
@@ -98,6 +98,7 @@ set(SPCT_SRC_FILES
     src/datasources/generic_source.c
     src/datasources/load_int.c
     src/datasources/load_real.c
+    src/datasources/mem_source.c
     src/datasources/mmapfile_source.c  
 
 
@@ -125,6 +126,8 @@ set(SPCT_SRC_FILES
     src/main/managers.c
     src/main/modules.c
     src/main/plugin_path.c
+    src/main/profile.c
+    src/main/trace.c
 
 
 ######## src/pluginmanager #########
@@ -136,6 +139,7 @@ set(SPCT_SRC_FILES
     src/pluginmanager/manager.c
     src/pluginmanager/pluginmanager.c
     src/pluginmanager/plugin_object.c
+    src/pluginmanager/static_plugins.c
 
 
 ######## src/serialization #########
@@ -176,7 +180,15 @@ set(SPCT_SRC_FILES
     src/voicemanager/loaders/utt_types.c
 
     # src/voicemanager
+    src/voicemanager/audiostream.c
+    src/voicemanager/canceltoken.c
+    src/voicemanager/synthcache.c
+    src/voicemanager/image.c
     src/voicemanager/manager.c
+    src/voicemanager/synthpipeline.c
+    src/voicemanager/synthpool.c
+    src/voicemanager/synthsession.c
+    src/voicemanager/synthtext.c
     src/voicemanager/voice.c
     src/voicemanager/voicemanager.c
 )
@@ -282,6 +294,7 @@ set(SPCT_SRC_INCLUDE_FILES
    src/datasources/generic_source.h
    src/datasources/load_int.h
    src/datasources/load_real.h
+   src/datasources/mem_source.h
    src/datasources/mmapfile.h
    src/datasources/mmapfile_source.h
 
@@ -321,6 +334,8 @@ set(SPCT_SRC_INCLUDE_FILES
    src/main/managers.h
    src/main/modules.h
    src/main/plugin_path.h
+   src/main/profile.h
+   src/main/trace.h
 
 
 ######## src/pluginmanager #########
@@ -333,6 +348,7 @@ set(SPCT_SRC_INCLUDE_FILES
    src/pluginmanager/plugin.h
    src/pluginmanager/pluginmanager.h
    src/pluginmanager/plugin_object.h
+   src/pluginmanager/static_plugins.h
  
 
 ######## src/serialization #########
@@ -369,7 +385,15 @@ set(SPCT_SRC_INCLUDE_FILES
 ######## src/voicemanager ##########
 
    # src/voicemanager
+   src/voicemanager/audiostream.h
+   src/voicemanager/canceltoken.h
+   src/voicemanager/synthcache.h
+   src/voicemanager/image.h
    src/voicemanager/manager.h
+   src/voicemanager/synthpipeline.h
+   src/voicemanager/synthpool.h
+   src/voicemanager/synthsession.h
+   src/voicemanager/synthtext.h
    src/voicemanager/voice.h
    src/voicemanager/voicemanager.h
 
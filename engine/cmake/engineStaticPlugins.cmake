@@ -0,0 +1,36 @@
+######################################################################################
+##                                                                                  ##
+## AUTHOR  : Speect contributors                                                    ##
+## DATE    : October 2026                                                           ##
+##                                                                                  ##
+######################################################################################
+##                                                                                  ##
+## Speect Engine statically linked plug-ins table                                   ##
+##                                                                                  ##
+##                                                                                  ##
+######################################################################################
+
+# STATIC_PLUGINS is a CMake option in speect/cmake/spctOptions.cmake, the
+# plug-ins themselves are compiled into the Speect Engine library by
+# speect_plugin_create (speect/plugins/cmake/pluginFunctions.cmake).
+
+set(SPCT_STATIC_PLUGIN_DECLARATIONS "")
+set(SPCT_STATIC_PLUGIN_ENTRIES "")
+
+if(SPCT_ADD_PLUGINS)
+  foreach(static_plugin ${STATIC_PLUGINS})
+    string(TOLOWER "${static_plugin}" static_plugin_lowercase_name)
+    set(SPCT_STATIC_PLUGIN_DECLARATIONS
+      "${SPCT_STATIC_PLUGIN_DECLARATIONS}S_PLUGIN_API const s_plugin_params *s_plugin_init_${static_plugin_lowercase_name}(s_erc *error);\n")
+    set(SPCT_STATIC_PLUGIN_ENTRIES
+      "${SPCT_STATIC_PLUGIN_ENTRIES}\t{ \"${static_plugin_lowercase_name}.spi\", s_plugin_init_${static_plugin_lowercase_name} },\n")
+  endforeach(static_plugin ${STATIC_PLUGINS})
+endif(SPCT_ADD_PLUGINS)
+
+
+#------------------------------------------------------------------------------------#
+#                               engine header                                        #
+#------------------------------------------------------------------------------------#
+
+configure_file(${CMAKE_SPEECT_SOURCE_DIR}/engine/config/static_plugins.h.in
+  ${CMAKE_SPEECT_BINARY_DIR}/engine/src/pluginmanager/static_plugins_table.h)
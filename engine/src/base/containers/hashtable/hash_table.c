@@ -449,7 +449,6 @@ S_API const s_hash_element *s_hash_table_find(const s_hash_table *self,
 	s_hash_element *hte;
 	ulong y;
 	ulong x;
-	s_hash_table *selfnc = (s_hash_table *)self;
 
 
 	S_CLR_ERR(error);
@@ -465,10 +464,7 @@ S_API const s_hash_element *s_hash_table_find(const s_hash_table *self,
 		if ((x == hte->hval) &&
 		    (keyl == hte->keyl) &&
 		    !memcmp(key, hte->key, keyl))
-		{
-			selfnc->apos = y;
 			return hte;
-		}
 	}
 
 	return NULL;
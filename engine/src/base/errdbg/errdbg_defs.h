@@ -98,8 +98,12 @@ typedef enum
 	/* warnings */
 	S_WARNERR =       -6,     /*!< Warning, possible error.                  */
 
-	/* continue error context (must be last one in list) */
-	S_CONTERR =       -7      /*!< Error context continued.                  */
+	/* continue error context */
+	S_CONTERR =       -7,     /*!< Error context continued.                  */
+
+	/* cancellation (new codes are added after this one, the values
+	 * of the codes above are fixed for compiled plug-ins) */
+	S_CANCELLED =     -8      /*!< Operation cancelled or deadline passed.   */
 } s_erc;
 
 
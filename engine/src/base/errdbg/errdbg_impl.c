@@ -303,6 +303,37 @@ S_API s_bool s_errdbg_on(void)
 }
 
 
+S_API void s_errdbg_info(const char *fmt, ...)
+{
+#ifdef SPCT_ERROR_HANDLING
+	va_list argp;
+	s_erc local_err;
+
+
+	if (initialized != TRUE)
+		return;
+
+	s_mutex_lock(&errdbg_mutex);
+
+	va_start(argp, fmt);
+	local_err = s_logger_vwrite(ewd_logger, S_INFO_EVENT,
+								NULL, NULL, NULL, 0,
+								fmt, argp);
+	va_end(argp);
+
+	if (local_err != S_SUCCESS)
+	{
+		S_ERR_PRINT(local_err, "s_errdbg_info",
+					"Call to \"s_logger_vwrite\" failed");
+	}
+
+	s_mutex_unlock(&errdbg_mutex);
+#else /* !SPCT_ERROR_HANDLING */
+	S_UNUSED(fmt);
+#endif /* SPCT_ERROR_HANDLING */
+}
+
+
 S_API void s_set_errdbg_level(s_dbg_lvl level, s_erc *error)
 {
 	S_CLR_ERR(error);
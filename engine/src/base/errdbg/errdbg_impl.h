@@ -127,6 +127,18 @@ S_API void s_set_errdbg_logger(s_logger *logger);
 S_API s_bool s_errdbg_on(void);
 
 
+/**
+ * Write an informational message to the logger of the <i>Error and
+ * Debugging System</i>, regardless of the debug level. Does nothing
+ * if the system is deactivated or not initialized.
+ *
+ * @param fmt A format string specifying the message and the format
+ * of the variable length argument list. Same as the standard @c
+ * printf() function.
+ */
+S_API void s_errdbg_info(const char *fmt, ...);
+
+
 /**
  * Change the debugging level.
  *
@@ -63,10 +63,10 @@ static const char * const erc_strings[] =
 	/*  -2 */ "Memory allocation failed",
 	/*  -3 */ "Function argument(s) invalid",
 	/*  -4 */ "Class/object method does not exist",
-	/*  -5 */ "Method/function call failed",
-	/*  -6 */ "End of file/stream",
-	/*  -7 */ "Warning, possible error",
-	/*  -8 */ "Error context continued"    /* must be last one */
+	/*  -5 */ "End of file/stream",
+	/*  -6 */ "Warning, possible error",
+	/*  -7 */ "Error context continued",
+	/*  -8 */ "Operation cancelled"        /* must be last one */
 };
 
 
@@ -89,7 +89,7 @@ S_API char *s_error_str(s_erc error_code)
 	 * intialized. This is OK as long as erc_strings[]
 	 * are ascii characters.
 	 */
-	if (S_NUM_IN_RANGE(error_code, S_CONTERR, S_SUCCESS))
+	if (S_NUM_IN_RANGE(error_code, S_CANCELLED, S_SUCCESS))
 		enum_string = erc_strings[S_ABS(error_code)];
 	else
 		enum_string = "Undefined error";
@@ -46,6 +46,7 @@
 #include "base/utils/alloc.h"
 #include "base/utils/types.h"
 #include "base/errdbg/errdbg_utils.h"
+#include "base/errdbg/errdbg.h"
 #include "base/threads/platform/pthreads/pthreads_threads.h"
 
 
@@ -79,6 +80,32 @@
 	} while (0)
 
 
+/************************************************************************************/
+/*                                                                                  */
+/* Data types                                                                       */
+/*                                                                                  */
+/************************************************************************************/
+
+/*
+ * Start routine arguments of a thread, the Speect thread function
+ * signature differs from the POSIX one.
+ */
+typedef struct
+{
+	s_thread_func_t  func;
+	void            *arg;
+} s_pthread_start;
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static function prototypes                                                       */
+/*                                                                                  */
+/************************************************************************************/
+
+static void *s_pthread_start_routine(void *arg);
+
+
 /************************************************************************************/
 /*                                                                                  */
 /* Function implementations                                                         */
@@ -92,6 +119,18 @@ S_API void s_pthread_mutex_init(s_mutex_t *m)
 }
 
 
+S_API void s_pthread_mutex_init_recursive(s_mutex_t *m)
+{
+	pthread_mutexattr_t attr;
+
+
+	pthread_mutexattr_init(&attr);
+	pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+	pthread_mutex_init(m, &attr);
+	pthread_mutexattr_destroy(&attr);
+}
+
+
 S_API void s_pthread_mutex_destroy(s_mutex_t *m, const char *file_name, int line_number)
 {
 	if (pthread_mutex_destroy(m) != 0)
@@ -148,3 +187,150 @@ S_API unsigned long s_pthread_self(void)
 {
 	return (unsigned long)pthread_self();
 }
+
+
+S_API void s_pthread_cond_init(s_cond_t *c)
+{
+	/* always returns 0 */
+	pthread_cond_init(c, NULL);
+}
+
+
+S_API void s_pthread_cond_destroy(s_cond_t *c, const char *file_name, int line_number)
+{
+	if (pthread_cond_destroy(c) != 0)
+	{
+		_S_THREAD_ERR_PRINT(S_FAILURE,
+							"s_pthread_cond_destroy",
+							"Failed to destroy condition variable", file_name, line_number);
+	}
+}
+
+
+S_API void s_pthread_cond_wait(s_cond_t *c, s_mutex_t *m, const char *file_name, int line_number)
+{
+	if (pthread_cond_wait(c, m) != 0)
+	{
+		_S_THREAD_ERR_PRINT(S_FAILURE,
+							"s_pthread_cond_wait",
+							"Failed to wait on condition variable", file_name, line_number);
+	}
+}
+
+
+S_API void s_pthread_cond_signal(s_cond_t *c, const char *file_name, int line_number)
+{
+	if (pthread_cond_signal(c) != 0)
+	{
+		_S_THREAD_ERR_PRINT(S_FAILURE,
+							"s_pthread_cond_signal",
+							"Failed to signal condition variable", file_name, line_number);
+	}
+}
+
+
+S_API void s_pthread_cond_broadcast(s_cond_t *c, const char *file_name, int line_number)
+{
+	if (pthread_cond_broadcast(c) != 0)
+	{
+		_S_THREAD_ERR_PRINT(S_FAILURE,
+							"s_pthread_cond_broadcast",
+							"Failed to broadcast condition variable", file_name, line_number);
+	}
+}
+
+
+S_API void s_pthread_create(s_thread_t *t, s_thread_func_t func, void *arg, s_erc *error)
+{
+	s_pthread_start *start;
+	int rv;
+
+
+	S_CLR_ERR(error);
+
+	start = S_MALLOC(s_pthread_start, 1);
+	if (start == NULL)
+	{
+		S_FTL_ERR(error, S_MEMERROR,
+				  "s_pthread_create",
+				  "Failed to allocate memory for 's_pthread_start' object");
+		return;
+	}
+
+	start->func = func;
+	start->arg = arg;
+
+	rv = pthread_create(t, NULL, s_pthread_start_routine, start);
+	if (rv != 0)
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "s_pthread_create",
+				  "Call to \"pthread_create\" failed (%d)", rv);
+		S_FREE(start);
+	}
+}
+
+
+S_API void s_pthread_join(s_thread_t *t, const char *file_name, int line_number)
+{
+	if (pthread_join(*t, NULL) != 0)
+	{
+		_S_THREAD_ERR_PRINT(S_FAILURE,
+							"s_pthread_join",
+							"Failed to join thread", file_name, line_number);
+	}
+}
+
+
+S_API void s_pthread_key_create(s_thread_key_t *k, s_thread_key_destructor_t destructor,
+								  s_erc *error)
+{
+	int rv;
+
+
+	S_CLR_ERR(error);
+
+	rv = pthread_key_create(k, destructor);
+	if (rv != 0)
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "s_pthread_key_create",
+				  "Call to \"pthread_key_create\" failed (%d)", rv);
+	}
+}
+
+
+S_API void s_pthread_key_set(s_thread_key_t *k, void *value, s_erc *error)
+{
+	int rv;
+
+
+	S_CLR_ERR(error);
+
+	rv = pthread_setspecific(*k, value);
+	if (rv != 0)
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "s_pthread_key_set",
+				  "Call to \"pthread_setspecific\" failed (%d)", rv);
+	}
+}
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static function implementations                                                  */
+/*                                                                                  */
+/************************************************************************************/
+
+static void *s_pthread_start_routine(void *arg)
+{
+	s_pthread_start start;
+
+
+	start = *(s_pthread_start*)arg;
+	S_FREE(arg);
+
+	start.func(start.arg);
+	return NULL;
+}
@@ -51,6 +51,7 @@
 
 #include <pthread.h>  /* POSIX threads */
 #include "include/common.h"
+#include "base/errdbg/errdbg_defs.h"
 
 
 /************************************************************************************/
@@ -72,6 +73,9 @@ S_BEGIN_C_DECLS
 #define _S_MUTEX_INIT(M, __FILE__, __LINE__) s_pthread_mutex_init(M)
 
 
+#define _S_MUTEX_INIT_RECURSIVE(M, __FILE__, __LINE__) s_pthread_mutex_init_recursive(M)
+
+
 #define _S_MUTEX_DESTROY(M, __FILE__, __LINE__) s_pthread_mutex_destroy(M, __FILE__, __LINE__)
 
 
@@ -84,6 +88,39 @@ S_BEGIN_C_DECLS
 #define _S_THREAD_ID() s_pthread_self()
 
 
+#define _S_COND_INIT(C, __FILE__, __LINE__) s_pthread_cond_init(C)
+
+
+#define _S_COND_DESTROY(C, __FILE__, __LINE__) s_pthread_cond_destroy(C, __FILE__, __LINE__)
+
+
+#define _S_COND_WAIT(C, M, __FILE__, __LINE__) s_pthread_cond_wait(C, M, __FILE__, __LINE__)
+
+
+#define _S_COND_SIGNAL(C, __FILE__, __LINE__) s_pthread_cond_signal(C, __FILE__, __LINE__)
+
+
+#define _S_COND_BROADCAST(C, __FILE__, __LINE__) s_pthread_cond_broadcast(C, __FILE__, __LINE__)
+
+
+#define _S_THREAD_CREATE(T, FUNC, ARG, ERROR) s_pthread_create(T, FUNC, ARG, ERROR)
+
+
+#define _S_THREAD_JOIN(T, __FILE__, __LINE__) s_pthread_join(T, __FILE__, __LINE__)
+
+
+#define _S_THREAD_KEY_CREATE(K, D, ERROR) s_pthread_key_create(K, D, ERROR)
+
+
+#define _S_THREAD_KEY_DELETE(K) pthread_key_delete(*(K))
+
+
+#define _S_THREAD_KEY_GET(K) pthread_getspecific(*(K))
+
+
+#define _S_THREAD_KEY_SET(K, V, ERROR) s_pthread_key_set(K, V, ERROR)
+
+
 /************************************************************************************/
 /*                                                                                  */
 /* Typedefs                                                                         */
@@ -92,6 +129,16 @@ S_BEGIN_C_DECLS
 
 typedef pthread_mutex_t s_mutex_t;
 
+typedef pthread_cond_t s_cond_t;
+
+typedef pthread_t s_thread_t;
+
+typedef pthread_key_t s_thread_key_t;
+
+typedef void (*s_thread_key_destructor_t)(void *value);
+
+typedef void (*s_thread_func_t)(void *arg);
+
 
 /************************************************************************************/
 /*                                                                                  */
@@ -103,6 +150,10 @@ typedef pthread_mutex_t s_mutex_t;
 S_API void s_pthread_mutex_init(s_mutex_t *m);
 
 
+/* wrapper for pthread_mutex_init with the recursive mutex type */
+S_API void s_pthread_mutex_init_recursive(s_mutex_t *m);
+
+
 /* wrapper for pthread_mutex_destroy */
 S_API void s_pthread_mutex_destroy(s_mutex_t *m, const char *file_name, int line_number);
 
@@ -119,6 +170,41 @@ S_API void s_pthread_mutex_unlock(s_mutex_t *m, const char *file_name, int line_
 S_API unsigned long s_pthread_self(void);
 
 
+/* wrapper for pthread_cond_init */
+S_API void s_pthread_cond_init(s_cond_t *c);
+
+
+/* wrapper for pthread_cond_destroy */
+S_API void s_pthread_cond_destroy(s_cond_t *c, const char *file_name, int line_number);
+
+
+/* wrapper for pthread_cond_wait */
+S_API void s_pthread_cond_wait(s_cond_t *c, s_mutex_t *m, const char *file_name, int line_number);
+
+
+/* wrapper for pthread_cond_signal */
+S_API void s_pthread_cond_signal(s_cond_t *c, const char *file_name, int line_number);
+
+
+/* wrapper for pthread_cond_broadcast */
+S_API void s_pthread_cond_broadcast(s_cond_t *c, const char *file_name, int line_number);
+
+
+/* wrapper for pthread_create */
+S_API void s_pthread_create(s_thread_t *t, s_thread_func_t func, void *arg, s_erc *error);
+
+
+/* wrapper for pthread_join */
+S_API void s_pthread_join(s_thread_t *t, const char *file_name, int line_number);
+
+
+S_API void s_pthread_key_create(s_thread_key_t *k, s_thread_key_destructor_t destructor,
+								  s_erc *error);
+
+
+S_API void s_pthread_key_set(s_thread_key_t *k, void *value, s_erc *error);
+
+
 /************************************************************************************/
 /*                                                                                  */
 /* End external c declaration                                                       */
@@ -68,6 +68,16 @@ S_BEGIN_C_DECLS
 
 typedef int s_mutex_t;
 
+typedef int s_cond_t;
+
+typedef int s_thread_t;
+
+typedef void *s_thread_key_t;
+
+typedef void (*s_thread_key_destructor_t)(void *value);
+
+typedef void (*s_thread_func_t)(void *arg);
+
 
 /************************************************************************************/
 /*                                                                                  */
@@ -83,12 +93,28 @@ typedef int s_mutex_t;
 
 #  define _S_MUTEX_INIT(mutex, __FILE__, __LINE__) __noop
 
+#  define _S_MUTEX_INIT_RECURSIVE(mutex, __FILE__, __LINE__) __noop
+
 #  define _S_MUTEX_DESTROY(mutex, __FILE__, __LINE__) __noop
 
 #  define _S_MUTEX_LOCK(mutex, __FILE__, __LINE__) __noop
 
 #  define _S_MUTEX_UNLOCK(mutex, __FILE__, __LINE__) __noop
 
+#  define S_DECLARE_COND(NAME) int NAME
+
+#  define _S_COND_INIT(cond, __FILE__, __LINE__) __noop
+
+#  define _S_COND_DESTROY(cond, __FILE__, __LINE__) __noop
+
+#  define _S_COND_WAIT(cond, mutex, __FILE__, __LINE__) __noop
+
+#  define _S_COND_SIGNAL(cond, __FILE__, __LINE__) __noop
+
+#  define _S_COND_BROADCAST(cond, __FILE__, __LINE__) __noop
+
+#  define _S_THREAD_JOIN(thread, __FILE__, __LINE__) __noop
+
 #else /* !SPCT_MSVC */
 
 #define S_DECLARE_MUTEX_STATIC(NAME)                  /* NOP */
@@ -97,18 +123,51 @@ typedef int s_mutex_t;
 
 #define _S_MUTEX_INIT(mutex, __FILE__, __LINE__)      /* NOP */
 
+#define _S_MUTEX_INIT_RECURSIVE(mutex, __FILE__, __LINE__) /* NOP */
+
 #define _S_MUTEX_DESTROY(mutex, __FILE__, __LINE__)   /* NOP */
 
 #define _S_MUTEX_LOCK(mutex, __FILE__, __LINE__)      /* NOP */
 
 #define _S_MUTEX_UNLOCK(mutex, __FILE__, __LINE__)    /* NOP */
 
+#define S_DECLARE_COND(NAME)                          /* NOP */
+
+#define _S_COND_INIT(cond, __FILE__, __LINE__)        /* NOP */
+
+#define _S_COND_DESTROY(cond, __FILE__, __LINE__)     /* NOP */
+
+#define _S_COND_WAIT(cond, mutex, __FILE__, __LINE__) /* NOP */
+
+#define _S_COND_SIGNAL(cond, __FILE__, __LINE__)      /* NOP */
+
+#define _S_COND_BROADCAST(cond, __FILE__, __LINE__)   /* NOP */
+
+#define _S_THREAD_JOIN(thread, __FILE__, __LINE__)    /* NOP */
+
 #endif /* SPCT_WIN32 */
 
 
 #define _S_THREAD_ID() (unsigned long)0
 
 
+/* threads can not be created without a threads implementation */
+#define _S_THREAD_CREATE(thread, func, arg, error) (*(error) = S_FAILURE)
+
+
+/* there is only one thread, the destructor is never called */
+#define _S_THREAD_KEY_CREATE(key, destructor, error) (*(key) = NULL, *(error) = S_SUCCESS)
+
+
+#define _S_THREAD_KEY_DELETE(key) (*(key) = NULL)
+
+
+#define _S_THREAD_KEY_GET(key) (*(key))
+
+
+#define _S_THREAD_KEY_SET(key, value, error) (*(key) = (value), *(error) = S_SUCCESS)
+
+
 /************************************************************************************/
 /*                                                                                  */
 /* End external c declaration                                                       */
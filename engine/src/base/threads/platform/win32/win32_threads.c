@@ -42,9 +42,12 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <limits.h>
+#include <process.h>
 #include "base/utils/alloc.h"
 #include "base/utils/types.h"
 #include "base/errdbg/errdbg_utils.h"
+#include "base/errdbg/errdbg.h"
 #include "base/threads/platform/win32/win32_threads.h"
 
 
@@ -78,6 +81,65 @@
 	} while (0)
 
 
+/************************************************************************************/
+/*                                                                                  */
+/* Data types                                                                       */
+/*                                                                                  */
+/************************************************************************************/
+
+/*
+ * Start routine arguments of a thread, the Speect thread function
+ * signature differs from the win32 one.
+ */
+typedef struct
+{
+	s_thread_func_t  func;
+	void            *arg;
+} s_win32_thread_start;
+
+
+/*
+ * A thread-specific data key with a destructor, the win32 thread
+ * local storage does not call destructors.
+ */
+typedef struct
+{
+	s_thread_key_t             key;
+	s_thread_key_destructor_t  destructor;
+} s_win32_key_destructor;
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Defines                                                                          */
+/*                                                                                  */
+/************************************************************************************/
+
+/* maximum number of thread-specific data keys with a destructor */
+#define S_WIN32_MAX_KEY_DESTRUCTORS 16
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static variables                                                                 */
+/*                                                                                  */
+/************************************************************************************/
+
+/* free slots have a NULL destructor, keys are created and deleted at (de)initialization */
+static s_win32_key_destructor key_destructors[S_WIN32_MAX_KEY_DESTRUCTORS];
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static function prototypes                                                       */
+/*                                                                                  */
+/************************************************************************************/
+
+static unsigned __stdcall s_win32_thread_start_routine(void *arg);
+
+static void s_win32_run_key_destructors(void);
+
+
 /************************************************************************************/
 /*                                                                                  */
 /* Function implementations                                                         */
@@ -169,3 +231,260 @@ S_API unsigned long s_win32_thread_self(void)
 {
 	return (unsigned long)GetCurrentThreadId();
 }
+
+
+S_API void s_win32_cond_init(s_cond_t *c, const char *file_name, int line_number)
+{
+	c->sema = CreateSemaphore(NULL, 0, LONG_MAX, NULL);
+	if (!c->sema)
+	{
+		_S_THREAD_ERR_PRINT(S_FAILURE,
+							"s_win32_cond_init",
+							"Call to \"CreateSemaphore\" failed",
+							file_name, line_number);
+	}
+
+	InitializeCriticalSection(&c->waiters_lock);
+	c->waiters = 0;
+}
+
+
+S_API void s_win32_cond_destroy(s_cond_t *c, const char *file_name, int line_number)
+{
+	if (CloseHandle(c->sema) == 0)
+	{
+		_S_THREAD_ERR_PRINT(S_FAILURE,
+							"s_win32_cond_destroy",
+							"Call to \"CloseHandle\" failed",
+							file_name, line_number);
+	}
+
+	DeleteCriticalSection(&c->waiters_lock);
+}
+
+
+S_API void s_win32_cond_wait(s_cond_t *c, s_mutex_t *m, const char *file_name, int line_number)
+{
+	EnterCriticalSection(&c->waiters_lock);
+	c->waiters++;
+	LeaveCriticalSection(&c->waiters_lock);
+
+	s_win32_mutex_unlock(m, file_name, line_number);
+
+	if (WaitForSingleObject(c->sema, INFINITE) != WAIT_OBJECT_0)
+	{
+		_S_THREAD_ERR_PRINT(S_FAILURE,
+							"s_win32_cond_wait",
+							"Call to \"WaitForSingleObject\" failed",
+							file_name, line_number);
+	}
+
+	s_win32_mutex_lock(m, file_name, line_number);
+}
+
+
+S_API void s_win32_cond_signal(s_cond_t *c, const char *file_name, int line_number)
+{
+	BOOL ret = TRUE;
+
+
+	EnterCriticalSection(&c->waiters_lock);
+	if (c->waiters > 0)
+	{
+		c->waiters--;
+		ret = ReleaseSemaphore(c->sema, 1, NULL);
+	}
+	LeaveCriticalSection(&c->waiters_lock);
+
+	if (!ret)
+	{
+		_S_THREAD_ERR_PRINT(S_FAILURE,
+							"s_win32_cond_signal",
+							"Call to \"ReleaseSemaphore\" failed",
+							file_name, line_number);
+	}
+}
+
+
+S_API void s_win32_cond_broadcast(s_cond_t *c, const char *file_name, int line_number)
+{
+	BOOL ret = TRUE;
+
+
+	EnterCriticalSection(&c->waiters_lock);
+	if (c->waiters > 0)
+	{
+		ret = ReleaseSemaphore(c->sema, c->waiters, NULL);
+		c->waiters = 0;
+	}
+	LeaveCriticalSection(&c->waiters_lock);
+
+	if (!ret)
+	{
+		_S_THREAD_ERR_PRINT(S_FAILURE,
+							"s_win32_cond_broadcast",
+							"Call to \"ReleaseSemaphore\" failed",
+							file_name, line_number);
+	}
+}
+
+
+S_API void s_win32_thread_create(s_thread_t *t, s_thread_func_t func, void *arg, s_erc *error)
+{
+	s_win32_thread_start *start;
+	uintptr_t handle;
+
+
+	S_CLR_ERR(error);
+
+	start = S_MALLOC(s_win32_thread_start, 1);
+	if (start == NULL)
+	{
+		S_FTL_ERR(error, S_MEMERROR,
+				  "s_win32_thread_create",
+				  "Failed to allocate memory for 's_win32_thread_start' object");
+		return;
+	}
+
+	start->func = func;
+	start->arg = arg;
+
+	handle = _beginthreadex(NULL, 0, s_win32_thread_start_routine, start, 0, NULL);
+	if (handle == 0)
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "s_win32_thread_create",
+				  "Call to \"_beginthreadex\" failed");
+		S_FREE(start);
+		return;
+	}
+
+	*t = (HANDLE)handle;
+}
+
+
+S_API void s_win32_thread_join(s_thread_t *t, const char *file_name, int line_number)
+{
+	if (WaitForSingleObject(*t, INFINITE) != WAIT_OBJECT_0)
+	{
+		_S_THREAD_ERR_PRINT(S_FAILURE,
+							"s_win32_thread_join",
+							"Call to \"WaitForSingleObject\" failed",
+							file_name, line_number);
+	}
+
+	CloseHandle(*t);
+}
+
+
+S_API void s_win32_thread_key_create(s_thread_key_t *k, s_thread_key_destructor_t destructor,
+									   s_erc *error)
+{
+	int i;
+
+
+	S_CLR_ERR(error);
+
+	*k = TlsAlloc();
+	if (*k == TLS_OUT_OF_INDEXES)
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "s_win32_thread_key_create",
+				  "Call to \"TlsAlloc\" failed");
+		return;
+	}
+
+	if (destructor == NULL)
+		return;
+
+	for (i = 0; i < S_WIN32_MAX_KEY_DESTRUCTORS; i++)
+	{
+		if (key_destructors[i].destructor == NULL)
+		{
+			key_destructors[i].key = *k;
+			key_destructors[i].destructor = destructor;
+			return;
+		}
+	}
+
+	TlsFree(*k);
+	*k = TLS_OUT_OF_INDEXES;
+	S_CTX_ERR(error, S_FAILURE,
+			  "s_win32_thread_key_create",
+			  "Too many thread-specific data keys with a destructor (%d)",
+			  S_WIN32_MAX_KEY_DESTRUCTORS);
+}
+
+
+S_API void s_win32_thread_key_delete(s_thread_key_t *k)
+{
+	int i;
+
+
+	for (i = 0; i < S_WIN32_MAX_KEY_DESTRUCTORS; i++)
+	{
+		if ((key_destructors[i].destructor != NULL)
+			&& (key_destructors[i].key == *k))
+			key_destructors[i].destructor = NULL;
+	}
+
+	TlsFree(*k);
+}
+
+
+S_API void s_win32_thread_key_set(s_thread_key_t *k, void *value, s_erc *error)
+{
+	S_CLR_ERR(error);
+
+	if (!TlsSetValue(*k, value))
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "s_win32_thread_key_set",
+				  "Call to \"TlsSetValue\" failed");
+	}
+}
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static function implementations                                                  */
+/*                                                                                  */
+/************************************************************************************/
+
+static unsigned __stdcall s_win32_thread_start_routine(void *arg)
+{
+	s_win32_thread_start start;
+
+
+	start = *(s_win32_thread_start*)arg;
+	S_FREE(arg);
+
+	start.func(start.arg);
+	s_win32_run_key_destructors();
+	return 0;
+}
+
+
+static void s_win32_run_key_destructors(void)
+{
+	s_thread_key_destructor_t destructor;
+	s_thread_key_t key;
+	void *value;
+	int i;
+
+
+	for (i = 0; i < S_WIN32_MAX_KEY_DESTRUCTORS; i++)
+	{
+		key = key_destructors[i].key;
+		destructor = key_destructors[i].destructor;
+		if (destructor == NULL)
+			continue;
+
+		value = TlsGetValue(key);
+		if (value == NULL)
+			continue;
+
+		TlsSetValue(key, NULL);
+		destructor(value);
+	}
+}
@@ -51,6 +51,7 @@
 
 #include <windows.h>  /* Windows threads */
 #include "include/common.h"
+#include "base/errdbg/errdbg_defs.h"
 
 
 /************************************************************************************/
@@ -72,6 +73,10 @@ S_BEGIN_C_DECLS
 #define _S_MUTEX_INIT(M, __FILE__, __LINE__) s_win32_mutex_init(M, __FILE__, __LINE__)
 
 
+/* win32 mutexes are always recursive */
+#define _S_MUTEX_INIT_RECURSIVE(M, __FILE__, __LINE__) s_win32_mutex_init(M, __FILE__, __LINE__)
+
+
 #define _S_MUTEX_DESTROY(M, __FILE__, __LINE__) s_win32_mutex_destroy(M, __FILE__, __LINE__)
 
 
@@ -84,6 +89,39 @@ S_BEGIN_C_DECLS
 #define _S_THREAD_ID() s_win32_thread_self()
 
 
+#define _S_COND_INIT(C, __FILE__, __LINE__) s_win32_cond_init(C, __FILE__, __LINE__)
+
+
+#define _S_COND_DESTROY(C, __FILE__, __LINE__) s_win32_cond_destroy(C, __FILE__, __LINE__)
+
+
+#define _S_COND_WAIT(C, M, __FILE__, __LINE__) s_win32_cond_wait(C, M, __FILE__, __LINE__)
+
+
+#define _S_COND_SIGNAL(C, __FILE__, __LINE__) s_win32_cond_signal(C, __FILE__, __LINE__)
+
+
+#define _S_COND_BROADCAST(C, __FILE__, __LINE__) s_win32_cond_broadcast(C, __FILE__, __LINE__)
+
+
+#define _S_THREAD_CREATE(T, FUNC, ARG, ERROR) s_win32_thread_create(T, FUNC, ARG, ERROR)
+
+
+#define _S_THREAD_JOIN(T, __FILE__, __LINE__) s_win32_thread_join(T, __FILE__, __LINE__)
+
+
+#define _S_THREAD_KEY_CREATE(K, D, ERROR) s_win32_thread_key_create(K, D, ERROR)
+
+
+#define _S_THREAD_KEY_DELETE(K) s_win32_thread_key_delete(K)
+
+
+#define _S_THREAD_KEY_GET(K) TlsGetValue(*(K))
+
+
+#define _S_THREAD_KEY_SET(K, V, ERROR) s_win32_thread_key_set(K, V, ERROR)
+
+
 /************************************************************************************/
 /*                                                                                  */
 /* Typedefs                                                                         */
@@ -109,6 +147,49 @@ struct win32_api_mutex_s
 };
 
 
+/**
+ * s_cond structure for win32 threads.
+ */
+typedef struct win32_api_cond_s s_cond_t;
+
+
+/**
+ * Structure of the win32 condition variable. The mutex is a win32
+ * mutex handle and not a critical section, therefore the condition
+ * variable is a semaphore with a count of the waiting threads.
+ */
+struct win32_api_cond_s
+{
+	HANDLE           sema;          /* Semaphore the waiters block on     */
+	CRITICAL_SECTION waiters_lock;  /* Guards the waiters count           */
+	long             waiters;       /* Number of threads waiting          */
+};
+
+
+/**
+ * s_thread type for win32 threads.
+ */
+typedef HANDLE s_thread_t;
+
+
+/**
+ * Thread function type.
+ */
+typedef void (*s_thread_func_t)(void *arg);
+
+
+/**
+ * s_thread_key type for win32 threads (thread local storage index).
+ */
+typedef DWORD s_thread_key_t;
+
+
+/**
+ * Destructor of the values of a thread-specific data key.
+ */
+typedef void (*s_thread_key_destructor_t)(void *value);
+
+
 /************************************************************************************/
 /*                                                                                  */
 /* Function prototypes                                                              */
@@ -135,6 +216,47 @@ S_API void s_win32_mutex_unlock(s_mutex_t *m, const char *file_name, int line_nu
 S_API unsigned long s_win32_thread_self(void);
 
 
+/* win32 condition variable init */
+S_API void s_win32_cond_init(s_cond_t *c, const char *file_name, int line_number);
+
+
+/* win32 condition variable destroy */
+S_API void s_win32_cond_destroy(s_cond_t *c, const char *file_name, int line_number);
+
+
+/* win32 condition variable wait */
+S_API void s_win32_cond_wait(s_cond_t *c, s_mutex_t *m, const char *file_name, int line_number);
+
+
+/* win32 condition variable signal */
+S_API void s_win32_cond_signal(s_cond_t *c, const char *file_name, int line_number);
+
+
+/* win32 condition variable broadcast */
+S_API void s_win32_cond_broadcast(s_cond_t *c, const char *file_name, int line_number);
+
+
+/* wrapper for _beginthreadex */
+S_API void s_win32_thread_create(s_thread_t *t, s_thread_func_t func, void *arg, s_erc *error);
+
+
+/* win32 thread join */
+S_API void s_win32_thread_join(s_thread_t *t, const char *file_name, int line_number);
+
+
+/* wrapper for TlsAlloc */
+S_API void s_win32_thread_key_create(s_thread_key_t *k, s_thread_key_destructor_t destructor,
+									   s_erc *error);
+
+
+/* wrapper for TlsFree */
+S_API void s_win32_thread_key_delete(s_thread_key_t *k);
+
+
+/* wrapper for TlsSetValue */
+S_API void s_win32_thread_key_set(s_thread_key_t *k, void *value, s_erc *error);
+
+
 /************************************************************************************/
 /*                                                                                  */
 /* End external c declaration                                                       */
@@ -47,10 +47,11 @@
  * @ingroup SBase
  * @defgroup SThreads Threads Abstraction
  * Defines a set of macros to access multi-threaded functionality. The
- * Speect Engine itself is not multi-threaded, but it does need access
- * to mutex locks to be thread safe, and thread id's for logging
- * purposes. Different multi-threaded implementations are supported by
- * implementing the following macros:
+ * Speect Engine needs access to mutex locks to be thread safe, thread
+ * id's for logging purposes, and condition variables and threads for
+ * the synthesis worker pool (see @ref SSynthPool). Different
+ * multi-threaded implementations are supported by implementing the
+ * following macros:
  *
  * <table>
  *  <tr>
@@ -58,6 +59,10 @@
  *   <td> Initialize a mutex (see @ref s_mutex_init) </td>
  *  </tr>
  *  <tr>
+ *   <td> @code void _S_MUTEX_INIT_RECURSIVE(s_mutex *M, __FILE__, __LINE__) @endcode </td>
+ *   <td> Initialize a recursive mutex (see @ref s_mutex_init_recursive) </td>
+ *  </tr>
+ *  <tr>
  *   <td> @code void _S_MUTEX_DESTROY(s_mutex *M, __FILE__, __LINE__) @endcode </td>
  *   <td> Destroy a mutex (see @ref s_mutex_destroy) </td>
  *  </tr>
@@ -73,13 +78,60 @@
  *    <td> @code unsigned long _S_THREAD_ID(void) @endcode </td>
  *    <td> Get the calling thread id (see @ref s_thread_id) </td>
  *  </tr>
+ *  <tr>
+ *    <td> @code void _S_COND_INIT(s_cond *C, __FILE__, __LINE__) @endcode </td>
+ *    <td> Initialize a condition variable (see @ref s_cond_init) </td>
+ *  </tr>
+ *  <tr>
+ *    <td> @code void _S_COND_DESTROY(s_cond *C, __FILE__, __LINE__) @endcode </td>
+ *    <td> Destroy a condition variable (see @ref s_cond_destroy) </td>
+ *  </tr>
+ *  <tr>
+ *    <td> @code void _S_COND_WAIT(s_cond *C, s_mutex *M, __FILE__, __LINE__) @endcode </td>
+ *    <td> Wait on a condition variable (see @ref s_cond_wait) </td>
+ *  </tr>
+ *  <tr>
+ *    <td> @code void _S_COND_SIGNAL(s_cond *C, __FILE__, __LINE__) @endcode </td>
+ *    <td> Wake one waiter of a condition variable (see @ref s_cond_signal) </td>
+ *  </tr>
+ *  <tr>
+ *    <td> @code void _S_COND_BROADCAST(s_cond *C, __FILE__, __LINE__) @endcode </td>
+ *    <td> Wake all waiters of a condition variable (see @ref s_cond_broadcast) </td>
+ *  </tr>
+ *  <tr>
+ *    <td> @code void _S_THREAD_CREATE(s_thread *T, s_thread_func F, void *A, s_erc *E) @endcode </td>
+ *    <td> Create a thread (see @ref s_thread_create) </td>
+ *  </tr>
+ *  <tr>
+ *    <td> @code void _S_THREAD_JOIN(s_thread *T, __FILE__, __LINE__) @endcode </td>
+ *    <td> Wait for a thread to finish (see @ref s_thread_join) </td>
+ *  </tr>
+ *  <tr>
+ *    <td> @code void _S_THREAD_KEY_CREATE(s_thread_key *K, s_thread_key_destructor D, s_erc *E) @endcode </td>
+ *    <td> Create a thread-specific data key (see @ref s_thread_key_create) </td>
+ *  </tr>
+ *  <tr>
+ *    <td> @code void _S_THREAD_KEY_DELETE(s_thread_key *K) @endcode </td>
+ *    <td> Delete a thread-specific data key (see @ref s_thread_key_delete) </td>
+ *  </tr>
+ *  <tr>
+ *    <td> @code void *_S_THREAD_KEY_GET(s_thread_key *K) @endcode </td>
+ *    <td> Get the calling thread's value of a key (see @ref s_thread_key_get) </td>
+ *  </tr>
+ *  <tr>
+ *    <td> @code void _S_THREAD_KEY_SET(s_thread_key *K, void *V, s_erc *E) @endcode </td>
+ *    <td> Set the calling thread's value of a key (see @ref s_thread_key_set) </td>
+ *  </tr>
  * </table>
  *
- * and defining the appropriate structure to #s_mutex. See the
+ * and defining the appropriate structures to #s_mutex, #s_cond,
+ * #s_thread and #s_thread_key. See the
  * threads_win32.h, threads_pthreads.h and threads_none.h for
  * examples. The mutex functions will print an error message
  * to @c stderr and abort if it cannot create, lock, unlock or destroy
- * a mutex.
+ * a mutex, and likewise for condition variables. Without a threads
+ * implementation #s_thread_create fails, a thread-specific data key
+ * is a single value and all the other functions are no-ops.
  * @{
  */
 
@@ -118,6 +170,42 @@ S_BEGIN_C_DECLS
 typedef s_mutex_t s_mutex;
 
 
+/**
+ * Definition of a opaque condition variable structure.
+ */
+typedef s_cond_t s_cond;
+
+
+/**
+ * Definition of a opaque thread structure.
+ */
+typedef s_thread_t s_thread;
+
+
+/**
+ * Thread function type, the start routine of a thread created with
+ * #s_thread_create.
+ *
+ * @param arg The argument given to #s_thread_create.
+ */
+typedef s_thread_func_t s_thread_func;
+
+
+/**
+ * Definition of a opaque thread-specific data key structure.
+ */
+typedef s_thread_key_t s_thread_key;
+
+
+/**
+ * Destructor of the values of a thread-specific data key, see
+ * #s_thread_key_create.
+ *
+ * @param value The value of the exiting thread, never @c NULL.
+ */
+typedef s_thread_key_destructor_t s_thread_key_destructor;
+
+
 /************************************************************************************/
 /*                                                                                  */
 /* Macros                                                                           */
@@ -152,6 +240,20 @@ typedef s_mutex_t s_mutex;
 #endif /* S_DECLARE_MUTEX_STATIC */
 
 
+#ifndef S_DECLARE_COND /* defined in threads_none.h if no threading */
+
+/**
+ * Declare a #s_cond. Declare a #s_cond with the given name,
+ * based on the threads implementation.
+ * @hideinitializer
+ *
+ * @param NAME The name of the #s_cond.
+ */
+#  define S_DECLARE_COND(NAME) s_cond NAME
+
+#endif /* S_DECLARE_COND */
+
+
 /**
  * Initialize a mutex. Initializes the given #s_mutex mutex using the
  * default mutex attributes.
@@ -165,6 +267,22 @@ typedef s_mutex_t s_mutex;
 	} while (0)
 
 
+/**
+ * Initialize a recursive mutex. Initializes the given #s_mutex mutex
+ * so that the thread holding it can lock it again, it is released
+ * when it has been unlocked as many times as it was locked. Only use
+ * it for mutexes that are locked again in nested calls, and never
+ * wait on a condition variable with it (see #s_cond_wait).
+ * @hideinitializer
+ *
+ * @param mutex #s_mutex mutex pointer to initialize.
+ */
+#define s_mutex_init_recursive(mutex)							\
+	do {														\
+		_S_MUTEX_INIT_RECURSIVE(mutex, __FILE__, __LINE__);	\
+	} while (0)
+
+
 /**
  * Destroy a mutex. Destroys the given #s_mutex mutex.
  * @hideinitializer
@@ -213,6 +331,168 @@ typedef s_mutex_t s_mutex;
 #define s_thread_id() _S_THREAD_ID()
 
 
+/**
+ * Initialize a condition variable. Initializes the given #s_cond
+ * condition variable using the default attributes.
+ * @hideinitializer
+ *
+ * @param cond #s_cond condition variable pointer to initialize.
+ */
+#define s_cond_init(cond)							\
+	do {											\
+		_S_COND_INIT(cond, __FILE__, __LINE__);		\
+	} while (0)
+
+
+/**
+ * Destroy a condition variable. Destroys the given #s_cond
+ * condition variable.
+ * @hideinitializer
+ *
+ * @param cond #s_cond condition variable pointer to destroy.
+ */
+#define s_cond_destroy(cond)						\
+	do {											\
+		_S_COND_DESTROY(cond, __FILE__, __LINE__);	\
+	} while (0)
+
+
+/**
+ * Wait on a condition variable. The given #s_mutex mutex must be
+ * locked by the calling thread, it is atomically unlocked while
+ * waiting and locked again before returning. Waits can wake up
+ * spuriously, callers must check their predicate in a loop.
+ * @hideinitializer
+ *
+ * @param cond #s_cond condition variable pointer to wait on.
+ * @param mutex #s_mutex mutex pointer locked by the caller.
+ */
+#define s_cond_wait(cond, mutex)						\
+	do {												\
+		_S_COND_WAIT(cond, mutex, __FILE__, __LINE__);	\
+	} while (0)
+
+
+/**
+ * Signal a condition variable. Wakes at least one of the threads
+ * waiting on the given #s_cond condition variable.
+ * @hideinitializer
+ *
+ * @param cond #s_cond condition variable pointer to signal.
+ */
+#define s_cond_signal(cond)							\
+	do {											\
+		_S_COND_SIGNAL(cond, __FILE__, __LINE__);	\
+	} while (0)
+
+
+/**
+ * Broadcast a condition variable. Wakes all the threads waiting on
+ * the given #s_cond condition variable.
+ * @hideinitializer
+ *
+ * @param cond #s_cond condition variable pointer to broadcast.
+ */
+#define s_cond_broadcast(cond)							\
+	do {												\
+		_S_COND_BROADCAST(cond, __FILE__, __LINE__);	\
+	} while (0)
+
+
+/**
+ * Create a thread. Creates a new joinable thread that runs the
+ * given function with the given argument.
+ * @hideinitializer
+ *
+ * @param thread #s_thread pointer that receives the new thread.
+ * @param func The #s_thread_func start routine of the thread.
+ * @param arg The argument to pass to @c func.
+ * @param error Error code, set to #S_FAILURE if the thread could not
+ * be created or there is no threads implementation.
+ */
+#define s_thread_create(thread, func, arg, error)		\
+	do {												\
+		_S_THREAD_CREATE(thread, func, arg, error);		\
+	} while (0)
+
+
+/**
+ * Join a thread. Waits for the given #s_thread thread, created with
+ * #s_thread_create, to finish.
+ * @hideinitializer
+ *
+ * @param thread #s_thread thread pointer to join.
+ */
+#define s_thread_join(thread)							\
+	do {												\
+		_S_THREAD_JOIN(thread, __FILE__, __LINE__);		\
+	} while (0)
+
+
+/**
+ * Create a thread-specific data key. Every thread has its own value
+ * of the key, initially @c NULL. When a thread exits with a value
+ * that is not @c NULL, the value is given to the destructor.
+ * @hideinitializer
+ *
+ * @param key #s_thread_key pointer to create.
+ * @param destructor #s_thread_key_destructor of the values, can be
+ * @c NULL.
+ * @param error Error code, set to #S_FAILURE if the key could not be
+ * created.
+ *
+ * @note With win32 threads the destructor is only called for threads
+ * created with #s_thread_create. It is never called for the thread
+ * that calls #s_thread_key_delete, that thread must release its own
+ * value.
+ */
+#define s_thread_key_create(key, destructor, error)			\
+	do {													\
+		_S_THREAD_KEY_CREATE(key, destructor, error);		\
+	} while (0)
+
+
+/**
+ * Delete a thread-specific data key, created with
+ * #s_thread_key_create. The values of the threads are not freed,
+ * the destructor is not called for threads that exit afterwards.
+ * @hideinitializer
+ *
+ * @param key #s_thread_key pointer to delete.
+ */
+#define s_thread_key_delete(key)				\
+	do {										\
+		_S_THREAD_KEY_DELETE(key);				\
+	} while (0)
+
+
+/**
+ * Get the calling thread's value of a thread-specific data key.
+ * @hideinitializer
+ *
+ * @param key #s_thread_key pointer.
+ *
+ * @return The value (@c void*), @c NULL if it was not set by the
+ * calling thread.
+ */
+#define s_thread_key_get(key) _S_THREAD_KEY_GET(key)
+
+
+/**
+ * Set the calling thread's value of a thread-specific data key.
+ * @hideinitializer
+ *
+ * @param key #s_thread_key pointer.
+ * @param value The value (@c void*).
+ * @param error Error code, set to #S_FAILURE if the value could not
+ * be set.
+ */
+#define s_thread_key_set(key, value, error)		\
+	do {										\
+		_S_THREAD_KEY_SET(key, value, error);	\
+	} while (0)
+
+
 /************************************************************************************/
 /*                                                                                  */
 /* End external c declaration                                                       */
@@ -43,6 +43,56 @@
 
 #include <stdlib.h>
 #include "base/utils/alloc.h"
+#include "base/errdbg/errdbg.h"
+#include "base/threads/threads.h"
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static variables                                                                 */
+/*                                                                                  */
+/************************************************************************************/
+
+/* the allocations counted for a thread */
+typedef struct
+{
+	ulong  count;
+	ulong  bytes;
+	uint32 pauses;   /* nested pauses of counting, see _s_alloc_count_pause */
+} s_alloc_counter;
+
+
+static s_bool count_allocs = FALSE;   /* counting enabled by profiling   */
+
+static uint32 count_holds = 0;        /* holds on counting, see below    */
+
+/*
+ * count_allocs or count_holds > 0, written under count_mutex. The
+ * allocation wrappers read it without locking, a thread may count a
+ * few allocations more or less around a change, which only affects
+ * the (per thread) counts and not their consistency.
+ */
+static s_bool counting = FALSE;
+
+static s_bool counters_initialized = FALSE;
+
+/* the s_alloc_counter of a thread */
+static s_thread_key counter_key;
+
+S_DECLARE_MUTEX_STATIC(count_mutex);
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static function prototypes                                                       */
+/*                                                                                  */
+/************************************************************************************/
+
+static s_alloc_counter *thread_counter(void);
+
+static void count_alloc(size_t len);
+
+static void free_counter(void *counter);
 
 
 /************************************************************************************/
@@ -62,6 +112,9 @@ S_API void *_s_malloc(size_t len)
 
 	p = malloc(len);
 
+	if (counting)
+		count_alloc(len);
+
 	return p;
 }
 
@@ -77,6 +130,9 @@ S_API void *_s_calloc(size_t len)
 
 	p = calloc(len, 1);
 
+	if (counting)
+		count_alloc(len);
+
 	return p;
 }
 
@@ -90,8 +146,13 @@ S_API void *_s_realloc(void *p_old, size_t len)
 	if (p_old == NULL)
 		p_new = _s_malloc(len);
 	else if (len != 0)
+	{
 		p_new = realloc(p_old, len);
 
+		if (counting)
+			count_alloc(len);
+	}
+
 	if (p_new == NULL)
 	{
 		_s_free(p_old);
@@ -108,3 +169,175 @@ S_API void _s_free(void *p)
 		free(p);
 }
 
+
+S_LOCAL void _s_alloc_count_enable(s_bool enable)
+{
+	if (counters_initialized)
+		s_mutex_lock(&count_mutex);
+
+	count_allocs = enable;
+	counting = (count_allocs || (count_holds > 0));
+
+	if (counters_initialized)
+		s_mutex_unlock(&count_mutex);
+}
+
+
+S_LOCAL void _s_alloc_count_hold(s_bool hold)
+{
+	if (counters_initialized)
+		s_mutex_lock(&count_mutex);
+
+	if (hold)
+		count_holds++;
+	else if (count_holds > 0)
+		count_holds--;
+
+	counting = (count_allocs || (count_holds > 0));
+
+	if (counters_initialized)
+		s_mutex_unlock(&count_mutex);
+}
+
+
+S_LOCAL void _s_alloc_count_pause(s_bool pause)
+{
+	s_alloc_counter *counter;
+
+
+	counter = thread_counter();
+	if (counter == NULL)
+		return;
+
+	if (pause)
+		counter->pauses++;
+	else if (counter->pauses > 0)
+		counter->pauses--;
+}
+
+
+S_LOCAL ulong _s_alloc_count(void)
+{
+	const s_alloc_counter *counter;
+
+
+	if (!counters_initialized)
+		return 0;
+
+	counter = s_thread_key_get(&counter_key);
+	if (counter == NULL)
+		return 0;
+
+	return counter->count;
+}
+
+
+S_LOCAL ulong _s_alloc_bytes(void)
+{
+	const s_alloc_counter *counter;
+
+
+	if (!counters_initialized)
+		return 0;
+
+	counter = s_thread_key_get(&counter_key);
+	if (counter == NULL)
+		return 0;
+
+	return counter->bytes;
+}
+
+
+S_LOCAL void _s_alloc_init(void)
+{
+	s_erc local_err = S_SUCCESS;
+
+
+	if (counters_initialized)
+		return;
+
+	s_thread_key_create(&counter_key, free_counter, &local_err);
+	if (local_err != S_SUCCESS)
+	{
+		S_ERR_PRINT(S_FAILURE, "_s_alloc_init",
+					"Failed to create thread key, allocations are not counted");
+		return;
+	}
+
+	s_mutex_init(&count_mutex);
+	counters_initialized = TRUE;
+}
+
+
+S_LOCAL void _s_alloc_quit(void)
+{
+	s_alloc_counter *counter;
+
+
+	if (!counters_initialized)
+		return;
+
+	/* the destructor is not called for the quitting thread */
+	counter = s_thread_key_get(&counter_key);
+	if (counter != NULL)
+		free_counter(counter);
+
+	counters_initialized = FALSE;
+	s_thread_key_delete(&counter_key);
+	s_mutex_destroy(&count_mutex);
+}
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static function implementations                                                  */
+/*                                                                                  */
+/************************************************************************************/
+
+static s_alloc_counter *thread_counter(void)
+{
+	s_erc local_err = S_SUCCESS;
+	s_alloc_counter *counter;
+
+
+	if (!counters_initialized)
+		return NULL;
+
+	counter = s_thread_key_get(&counter_key);
+	if (counter != NULL)
+		return counter;
+
+	/* not with S_CALLOC, it would count itself */
+	counter = calloc(1, sizeof(s_alloc_counter));
+	if (counter == NULL)
+		return NULL;
+
+	s_thread_key_set(&counter_key, counter, &local_err);
+	if (local_err != S_SUCCESS)
+	{
+		free(counter);
+		return NULL;
+	}
+
+	return counter;
+}
+
+
+static void count_alloc(size_t len)
+{
+	s_alloc_counter *counter;
+
+
+	counter = thread_counter();
+	if ((counter == NULL) || (counter->pauses > 0))
+		return;
+
+	counter->count++;
+	counter->bytes += len;
+}
+
+
+static void free_counter(void *counter)
+{
+	free(counter);
+}
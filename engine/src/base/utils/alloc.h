@@ -67,6 +67,7 @@
 
 #include <stddef.h>
 #include "include/common.h"
+#include "base/utils/types.h"
 
 
 /************************************************************************************/
@@ -221,6 +222,57 @@ S_API void *_s_realloc(void *p_old, size_t len);
 S_API void _s_free(void *p);
 
 
+/*
+ * Enable or disable counting of allocations (for profiling), the
+ * counts are not reset. Allocations are counted per thread.
+ */
+S_LOCAL void _s_alloc_count_enable(s_bool enable);
+
+
+/*
+ * Hold or release counting of allocations (for instrumentation),
+ * counting is enabled while there are holds on it, independently of
+ * _s_alloc_count_enable. Thread safe.
+ */
+S_LOCAL void _s_alloc_count_hold(s_bool hold);
+
+
+/*
+ * Pause or resume counting of the allocations of the calling thread,
+ * pauses nest and counting resumes when every pause is resumed. For
+ * allocations of the instrumentation itself.
+ */
+S_LOCAL void _s_alloc_count_pause(s_bool pause);
+
+
+/*
+ * Number of allocations of the calling thread counted while counting
+ * was enabled.
+ */
+S_LOCAL ulong _s_alloc_count(void);
+
+
+/*
+ * Number of bytes allocated by the calling thread while counting was
+ * enabled.
+ */
+S_LOCAL ulong _s_alloc_bytes(void);
+
+
+/*
+ * Initialize the per thread allocation counters, before the other
+ * modules. Without it allocations are not counted.
+ */
+S_LOCAL void _s_alloc_init(void);
+
+
+/*
+ * Quit the per thread allocation counters, after the other modules.
+ * The counters of threads that are still running are not freed.
+ */
+S_LOCAL void _s_alloc_quit(void);
+
+
 /************************************************************************************/
 /*                                                                                  */
 /* End external c declaration                                                       */
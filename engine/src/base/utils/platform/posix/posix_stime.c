@@ -0,0 +1,97 @@
+/************************************************************************************/
+/* Copyright (c) 2008-2011 The Department of Arts and Culture,                      */
+/* The Government of the Republic of South Africa.                                  */
+/*                                                                                  */
+/* Contributors:  Meraka Institute, CSIR, South Africa.                             */
+/*                                                                                  */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy     */
+/* of this software and associated documentation files (the "Software"), to deal    */
+/* in the Software without restriction, including without limitation the rights     */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        */
+/* copies of the Software, and to permit persons to whom the Software is            */
+/* furnished to do so, subject to the following conditions:                         */
+/* The above copyright notice and this permission notice shall be included in       */
+/* all copies or substantial portions of the Software.                              */
+/*                                                                                  */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN        */
+/* THE SOFTWARE.                                                                    */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* AUTHOR  : Speect contributors                                                    */
+/* DATE    : 19 October 2026                                                        */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* POSIX monotonic and CPU time clocks.                                             */
+/*                                                                                  */
+/*                                                                                  */
+/************************************************************************************/
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Modules used                                                                     */
+/*                                                                                  */
+/************************************************************************************/
+
+#include <time.h>
+#include <string.h>
+#include <errno.h>
+#include "base/utils/platform/posix/posix_stime.h"
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Function implementations                                                         */
+/*                                                                                  */
+/************************************************************************************/
+
+S_LOCAL double s_posix_time_monotonic(s_erc *error)
+{
+	struct timespec ts;
+
+
+	S_CLR_ERR(error);
+
+	if (clock_gettime(CLOCK_MONOTONIC, &ts) != 0)
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "s_posix_time_monotonic",
+				  "Call to \"clock_gettime\" failed, reported error \"%s\"",
+				  strerror(errno));
+		return 0.0;
+	}
+
+	return (double)ts.tv_sec + ((double)ts.tv_nsec / 1.0e9);
+}
+
+
+S_LOCAL double s_posix_time_thread_cpu(s_erc *error)
+{
+	struct timespec ts;
+#ifdef CLOCK_THREAD_CPUTIME_ID
+	clockid_t clock = CLOCK_THREAD_CPUTIME_ID;
+#else
+	clockid_t clock = CLOCK_PROCESS_CPUTIME_ID;
+#endif
+
+
+	S_CLR_ERR(error);
+
+	if (clock_gettime(clock, &ts) != 0)
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "s_posix_time_thread_cpu",
+				  "Call to \"clock_gettime\" failed, reported error \"%s\"",
+				  strerror(errno));
+		return 0.0;
+	}
+
+	return (double)ts.tv_sec + ((double)ts.tv_nsec / 1.0e9);
+}
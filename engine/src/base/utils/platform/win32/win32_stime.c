@@ -0,0 +1,102 @@
+/************************************************************************************/
+/* Copyright (c) 2008-2011 The Department of Arts and Culture,                      */
+/* The Government of the Republic of South Africa.                                  */
+/*                                                                                  */
+/* Contributors:  Meraka Institute, CSIR, South Africa.                             */
+/*                                                                                  */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy     */
+/* of this software and associated documentation files (the "Software"), to deal    */
+/* in the Software without restriction, including without limitation the rights     */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        */
+/* copies of the Software, and to permit persons to whom the Software is            */
+/* furnished to do so, subject to the following conditions:                         */
+/* The above copyright notice and this permission notice shall be included in       */
+/* all copies or substantial portions of the Software.                              */
+/*                                                                                  */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN        */
+/* THE SOFTWARE.                                                                    */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* AUTHOR  : Speect contributors                                                    */
+/* DATE    : 19 October 2026                                                        */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* WIN32 monotonic and CPU time clocks.                                             */
+/*                                                                                  */
+/*                                                                                  */
+/************************************************************************************/
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Modules used                                                                     */
+/*                                                                                  */
+/************************************************************************************/
+
+#include <windows.h>
+#include "base/utils/platform/win32/win32_stime.h"
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Function implementations                                                         */
+/*                                                                                  */
+/************************************************************************************/
+
+S_LOCAL double s_win32_time_monotonic(s_erc *error)
+{
+	LARGE_INTEGER frequency;
+	LARGE_INTEGER counter;
+
+
+	S_CLR_ERR(error);
+
+	if (!QueryPerformanceFrequency(&frequency)
+		|| !QueryPerformanceCounter(&counter))
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "s_win32_time_monotonic",
+				  "Call to \"QueryPerformanceCounter\" failed");
+		return 0.0;
+	}
+
+	return (double)counter.QuadPart / (double)frequency.QuadPart;
+}
+
+
+S_LOCAL double s_win32_time_thread_cpu(s_erc *error)
+{
+	FILETIME creation_time;
+	FILETIME exit_time;
+	FILETIME kernel_time;
+	FILETIME user_time;
+	ULARGE_INTEGER kernel;
+	ULARGE_INTEGER user;
+
+
+	S_CLR_ERR(error);
+
+	if (!GetThreadTimes(GetCurrentThread(), &creation_time, &exit_time,
+						&kernel_time, &user_time))
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "s_win32_time_thread_cpu",
+				  "Call to \"GetThreadTimes\" failed");
+		return 0.0;
+	}
+
+	kernel.LowPart = kernel_time.dwLowDateTime;
+	kernel.HighPart = kernel_time.dwHighDateTime;
+	user.LowPart = user_time.dwLowDateTime;
+	user.HighPart = user_time.dwHighDateTime;
+
+	/* in 100 nanosecond units */
+	return (double)(kernel.QuadPart + user.QuadPart) / 1.0e7;
+}
@@ -145,3 +145,37 @@ S_API char *s_strtime(s_erc *error)
 	s_mutex_unlock(&time_mutex);
 	return rv;
 }
+
+
+S_API double s_time_monotonic(s_erc *error)
+{
+	double t;
+
+
+	S_CLR_ERR(error);
+
+	t = _S_TIME_MONOTONIC(error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "s_time_monotonic",
+				  "Failed to get monotonic time"))
+		return 0.0;
+
+	return t;
+}
+
+
+S_API double s_time_thread_cpu(s_erc *error)
+{
+	double t;
+
+
+	S_CLR_ERR(error);
+
+	t = _S_TIME_THREAD_CPU(error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "s_time_thread_cpu",
+				  "Failed to get thread CPU time"))
+		return 0.0;
+
+	return t;
+}
@@ -59,6 +59,7 @@
 
 #include "include/common.h"
 #include "base/errdbg/errdbg.h"
+#include "base/utils/platform/stime_impl.h"
 
 
 /************************************************************************************/
@@ -113,6 +114,35 @@ S_LOCAL void _s_time_quit(s_erc *error);
 S_API char *s_strtime(s_erc *error);
 
 
+/**
+ * Get the time of a monotonic high resolution clock. The clock is not
+ * related to the calendar time and is not affected by changes to the
+ * system time, it can only be used to measure elapsed time.
+ *
+ * @param error Error code.
+ *
+ * @return The time in seconds, with a sub-microsecond resolution
+ * where the platform supports it, since an unspecified starting point.
+ *
+ * @note Thread-safe.
+ */
+S_API double s_time_monotonic(s_erc *error);
+
+
+/**
+ * Get the CPU time used by the calling thread. Where the platform
+ * does not support per thread CPU time the CPU time of the process is
+ * returned.
+ *
+ * @param error Error code.
+ *
+ * @return The CPU time in seconds, since an unspecified starting point.
+ *
+ * @note Thread-safe.
+ */
+S_API double s_time_thread_cpu(s_erc *error);
+
+
 /************************************************************************************/
 /*                                                                                  */
 /* End external c declaration                                                       */
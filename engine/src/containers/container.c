@@ -172,7 +172,9 @@ static void InitContainer(void *obj, s_erc *error)
 
 
 	S_CLR_ERR(error);
-	s_mutex_init(&(self->container_mutex));
+
+	/* list and map methods call each other with the container locked */
+	s_mutex_init_recursive(&(self->container_mutex));
 }
 
 
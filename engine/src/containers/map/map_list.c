@@ -111,6 +111,36 @@ S_LOCAL void _s_map_list_class_add(s_erc *error)
 }
 
 
+S_LOCAL void _s_map_list_clear(SMapList *self, s_erc *error)
+{
+	s_list_element *e;
+
+
+	S_CLR_ERR(error);
+
+	if ((self == NULL) || (self->list == NULL))
+		return;
+
+	while ((e = (s_list_element*)s_list_first(self->list, error)) != NULL)
+	{
+		if (S_CHK_ERR(error, S_CONTERR,
+			      "_s_map_list_clear",
+			      "Call to s_list_first failed"))
+			return;
+
+		s_list_element_delete(e, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+			      "_s_map_list_clear",
+			      "Call to s_list_element_delete failed"))
+			return;
+	}
+
+	S_CHK_ERR(error, S_CONTERR,
+		  "_s_map_list_clear",
+		  "Call to s_list_first failed");
+}
+
+
 /************************************************************************************/
 /*                                                                                  */
 /*  Static function implementations                                                 */
@@ -143,6 +143,17 @@ typedef SMapClass SMapListClass;
 S_LOCAL void _s_map_list_class_add(s_erc *error);
 
 
+/**
+ * Delete all the key-value pairs of the given map-list, keeping the
+ * map-list itself so that it can be filled again.
+ * @private @memberof SMapList
+ *
+ * @param self The map-list to clear.
+ * @param error Error code.
+ */
+S_LOCAL void _s_map_list_clear(SMapList *self, s_erc *error);
+
+
 /************************************************************************************/
 /*                                                                                  */
 /* End external c declaration                                                       */
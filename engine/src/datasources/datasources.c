@@ -75,6 +75,12 @@ S_LOCAL void _s_datasources_init(s_erc *error)
 		      "Failed to initialize SMMapFileource class"))
 		local_err = *error;
 
+	_s_mem_source_class_add(error);
+	if (S_CHK_ERR(error, S_CONTERR,
+		      "_s_datasources_init",
+		      "Failed to initialize SMemsource class"))
+		local_err = *error;
+
 	_s_data_reader_class_add(error);
 	if (S_CHK_ERR(error, S_CONTERR,
 				  "_s_datasources_init",
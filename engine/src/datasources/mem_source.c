@@ -0,0 +1,327 @@
+/************************************************************************************/
+/* Copyright (c) 2008-2011 The Department of Arts and Culture,                      */
+/* The Government of the Republic of South Africa.                                  */
+/*                                                                                  */
+/* Contributors:  Meraka Institute, CSIR, South Africa.                             */
+/*                                                                                  */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy     */
+/* of this software and associated documentation files (the "Software"), to deal    */
+/* in the Software without restriction, including without limitation the rights     */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        */
+/* copies of the Software, and to permit persons to whom the Software is            */
+/* furnished to do so, subject to the following conditions:                         */
+/* The above copyright notice and this permission notice shall be included in       */
+/* all copies or substantial portions of the Software.                              */
+/*                                                                                  */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN        */
+/* THE SOFTWARE.                                                                    */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* AUTHOR  : Speect contributors                                                    */
+/* DATE    : 19 October 2026                                                        */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* A read-only memory data source class.                                            */
+/*                                                                                  */
+/*                                                                                  */
+/************************************************************************************/
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Modules used                                                                     */
+/*                                                                                  */
+/************************************************************************************/
+
+#include <string.h>
+#include "datasources/mem_source.h"
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Macros                                                                           */
+/*                                                                                  */
+/************************************************************************************/
+
+/**
+ * @hideinitializer
+ * Return the given #SMemsource parent class object as a #SMemsource object.
+ * @param SELF The given object.
+ * @return Given object as #SMemsource* type.
+ * @note This casting is not safety checked.
+ */
+#define S_MEMSOURCE(SELF)    ((SMemsource *)(SELF))
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static variables                                                                 */
+/*                                                                                  */
+/************************************************************************************/
+
+static SMemsourceClass MemsourceClass; /* Memsource class declaration. */
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static function prototypes                                                       */
+/*                                                                                  */
+/************************************************************************************/
+
+static size_t mem_copy(SMemsource *self, void *buf, size_t size, long pos,
+					   s_erc *error);
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Function implementations                                                         */
+/*                                                                                  */
+/************************************************************************************/
+
+S_API SDatasource *SMemsourceOpen(const uint8 *mem, size_t size, s_erc *error)
+{
+	SMemsource *self;
+
+
+	S_CLR_ERR(error);
+
+	if ((mem == NULL) && (size > 0))
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SMemsourceOpen",
+				  "Argument \"mem\" is NULL");
+		return NULL;
+	}
+
+	self = S_NEW(SMemsource, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SMemsourceOpen",
+				  "Failed to create new object"))
+		return NULL;
+
+	self->mem = mem;
+	self->size = size;
+
+	return S_DATASOURCE(self);
+}
+
+
+S_API SDatasource *SMemsourceOpenOwned(const uint8 *mem, size_t size, SObject *owner,
+									   s_erc *error)
+{
+	SDatasource *ds;
+
+
+	S_CLR_ERR(error);
+
+	ds = SMemsourceOpen(mem, size, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SMemsourceOpenOwned",
+				  "Call to \"SMemsourceOpen\" failed"))
+		return NULL;
+
+	if (owner != NULL)
+	{
+		SObjectIncRef(owner);
+		S_MEMSOURCE(ds)->owner = owner;
+	}
+
+	return ds;
+}
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Class registration                                                               */
+/*                                                                                  */
+/************************************************************************************/
+
+S_LOCAL void _s_mem_source_class_add(s_erc *error)
+{
+	S_CLR_ERR(error);
+	s_class_add(S_OBJECTCLASS(&MemsourceClass), error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "_s_mem_source_class_add",
+			  "Failed to add SMemsourceClass");
+}
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static function implementations                                                  */
+/*                                                                                  */
+/************************************************************************************/
+
+static size_t mem_copy(SMemsource *self, void *buf, size_t size, long pos,
+					   s_erc *error)
+{
+	size_t avail;
+
+
+	S_CLR_ERR(error);
+
+	if ((pos < 0) || ((size_t)pos > self->size))
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "mem_copy",
+				  "Bad position %ld, memory region size is %lu",
+				  pos, (unsigned long)self->size);
+		return 0;
+	}
+
+	avail = self->size - (size_t)pos;
+	if (size > avail)
+	{
+		memcpy(buf, &self->mem[pos], avail);
+		if (error != NULL)
+			*error = S_IOEOF; /* caller must decide if this is an error */
+		return avail;
+	}
+
+	memcpy(buf, &self->mem[pos], size);
+	return size;
+}
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static class function implementations                                            */
+/*                                                                                  */
+/************************************************************************************/
+
+static void InitMemsource(void *obj, s_erc *error)
+{
+	SMemsource *self = S_MEMSOURCE(obj);
+
+
+	S_CLR_ERR(error);
+	self->mem = NULL;
+	self->size = 0;
+	self->offset = 0;
+	self->owner = NULL;
+}
+
+
+static void DestroyMemsource(void *obj, s_erc *error)
+{
+	SMemsource *self = S_MEMSOURCE(obj);
+
+
+	S_CLR_ERR(error);
+
+	/* release our reference to the owner of the memory */
+	if (self->owner != NULL)
+		S_DELETE(self->owner, "DestroyMemsource", error);
+}
+
+
+static void DisposeMemsource(void *obj, s_erc *error)
+{
+	S_CLR_ERR(error);
+	SObjectDecRef(obj);
+}
+
+
+static size_t MemRead(SDatasource *ds, void *buf, size_t msize,
+					  size_t nmemb, s_erc *error)
+{
+	SMemsource *self = S_MEMSOURCE(ds);
+	size_t rv;
+
+
+	rv = mem_copy(self, buf, msize*nmemb, self->offset, error);
+	self->offset += (long)rv;
+
+	return rv;
+}
+
+
+static size_t MemReadAt(SDatasource *ds, void *buf, size_t msize,
+						size_t nmemb, long pos, s_erc *error)
+{
+	return mem_copy(S_MEMSOURCE(ds), buf, msize*nmemb, pos, error);
+}
+
+
+static long MemTell(SDatasource *ds, s_erc *error)
+{
+	S_CLR_ERR(error);
+
+	return (S_MEMSOURCE(ds)->offset);
+}
+
+
+static void MemSeek(SDatasource *ds, long offs, s_seek_mode mode,
+					s_erc *error)
+{
+	SMemsource *self = S_MEMSOURCE(ds);
+	long nOffs;
+
+
+	S_CLR_ERR(error);
+
+	switch (mode)
+	{
+	case S_SEEK_SET:
+		nOffs = offs;
+		break;
+	case S_SEEK_END:
+		nOffs = (long)self->size + offs;
+		break;
+	case S_SEEK_CUR:
+	default:
+		nOffs = self->offset + offs;
+		break;
+	}
+
+	if ((nOffs < 0) || ((size_t)nOffs > self->size))
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "MemSeek",
+				  "Bad seek position %ld, memory region size is %lu",
+				  nOffs, (unsigned long)self->size);
+		return;
+	}
+
+	self->offset = nOffs;
+}
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* SMemsource class initialization                                                  */
+/*                                                                                  */
+/************************************************************************************/
+
+/*
+ * This is exactly the same as SDatasourceClass.
+ */
+static SMemsourceClass MemsourceClass =
+{
+	/* SObjectClass */
+	{
+		"SDatasource:SMemsource",
+		sizeof(SMemsource),
+		{ 0, 1},
+		InitMemsource,    /* init    */
+		DestroyMemsource, /* destroy */
+		DisposeMemsource, /* dispose */
+		NULL,             /* compare */
+		NULL,             /* print   */
+		NULL,             /* copy    */
+	},
+	/* SMemsourceClass */
+	MemRead,                        /* read           */
+	MemReadAt,                      /* read_at        */
+	NULL,                           /* write          */
+	NULL,                           /* write_at       */
+	MemTell,                        /* tell           */
+	MemSeek                         /* seek           */
+};
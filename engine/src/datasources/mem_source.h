@@ -0,0 +1,195 @@
+/************************************************************************************/
+/* Copyright (c) 2008-2011 The Department of Arts and Culture,                      */
+/* The Government of the Republic of South Africa.                                  */
+/*                                                                                  */
+/* Contributors:  Meraka Institute, CSIR, South Africa.                             */
+/*                                                                                  */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy     */
+/* of this software and associated documentation files (the "Software"), to deal    */
+/* in the Software without restriction, including without limitation the rights     */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        */
+/* copies of the Software, and to permit persons to whom the Software is            */
+/* furnished to do so, subject to the following conditions:                         */
+/* The above copyright notice and this permission notice shall be included in       */
+/* all copies or substantial portions of the Software.                              */
+/*                                                                                  */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN        */
+/* THE SOFTWARE.                                                                    */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* AUTHOR  : Speect contributors                                                    */
+/* DATE    : 19 October 2026                                                        */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* A read-only memory data source class.                                            */
+/*                                                                                  */
+/*                                                                                  */
+/************************************************************************************/
+
+#ifndef _SPCT_MEM_SOURCE_H__
+#define _SPCT_MEM_SOURCE_H__
+
+
+/**
+ * @file mem_source.h
+ * Definition of the read-only memory data source class.
+ */
+
+
+/**
+ * @ingroup SDatasource
+ * @defgroup SMemSource Memory Data Source
+ * A read-only region of memory to be used as a data source. The
+ * memory is not copied by the data source. It must stay valid for the
+ * lifetime of the data source, either because the caller guarantees
+ * so (#SMemsourceOpen) or because the data source holds a reference
+ * to the object that owns the memory (#SMemsourceOpenOwned). Readers
+ * that hold on to such a data source may use its memory in place.
+ * @{
+ */
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Modules used                                                                     */
+/*                                                                                  */
+/************************************************************************************/
+
+#include "include/common.h"
+#include "base/utils/types.h"
+#include "datasources/data_source.h"
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Begin external c declaration                                                     */
+/*                                                                                  */
+/************************************************************************************/
+S_BEGIN_C_DECLS
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* SMemsource definition                                                            */
+/*                                                                                  */
+/************************************************************************************/
+
+/**
+ * The memory source structure. Provides an interface to a read-only
+ * memory region based data source.
+ * @extends SDatasource
+ */
+typedef struct
+{
+	/**
+	 * @protected Inherit from #SDatasource.
+	 */
+	SDatasource   obj;
+
+	/**
+	 * @protected Memory region (not owned).
+	 */
+	const uint8  *mem;
+
+	/**
+	 * @protected Size of the memory region.
+	 */
+	size_t        size;
+
+	/**
+	 * @protected  Current position.
+	 */
+	long          offset;
+
+	/**
+	 * @protected Object that owns the memory region, a reference is
+	 * held until the data source is deleted, or @c NULL.
+	 */
+	SObject      *owner;
+} SMemsource;
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* SMemsourceClass definition                                                       */
+/*                                                                                  */
+/************************************************************************************/
+
+/**
+ * Memsource class structure. Same as #SDatasourceClass as
+ * we are not adding any new methods.
+ */
+typedef SDatasourceClass SMemsourceClass;
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Function prototypes                                                              */
+/*                                                                                  */
+/************************************************************************************/
+
+/**
+ * Open a read-only memory region as a data source.
+ * @public @memberof SMemsource
+ *
+ * @param mem The memory region.
+ * @param size The size of the memory region in bytes.
+ * @param error Error code.
+ *
+ * @return Pointer to the newly created data source.
+ *
+ * @note The #SMemsource data source is read only and does @b not
+ * implement #SDatasourceClass methods @c write (#SDatasourceWrite) and
+ * @c write_at (#SDatasourceWriteAt).
+ * @note Reading past the end of the region reads the remaining bytes
+ * and sets the error code to #S_IOEOF.
+ */
+S_API SDatasource *SMemsourceOpen(const uint8 *mem, size_t size, s_erc *error);
+
+
+/**
+ * Open a read-only memory region, owned by the given object, as a data
+ * source. The data source holds a reference to @c owner, so the memory
+ * stays valid for as long as the data source exists, even if the
+ * owner is deleted by everyone else.
+ * @public @memberof SMemsource
+ * @param mem The memory region.
+ * @param size The size of the memory region in bytes.
+ * @param owner The object that owns the memory region, may be @c NULL.
+ * @param error Error code.
+ * @return Pointer to the newly created data source.
+ * @note Same as #SMemsourceOpen otherwise.
+ */
+S_API SDatasource *SMemsourceOpenOwned(const uint8 *mem, size_t size, SObject *owner,
+									   s_erc *error);
+
+
+/**
+ * Add the SMemsource class to the object system.
+ * @private
+ * @param error Error code.
+ */
+S_LOCAL void _s_mem_source_class_add(s_erc *error);
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* End external c declaration                                                       */
+/*                                                                                  */
+/************************************************************************************/
+S_END_C_DECLS
+
+
+/**
+ * @}
+ * end documentation
+ */
+
+#endif /* _SPCT_MEM_SOURCE_H__ */
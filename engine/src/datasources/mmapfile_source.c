@@ -138,7 +138,7 @@ S_API SDatasource *SMMapFilesourceOpenFile(const char *path, s_erc *error)
 
 	handle = s_mmapfile_open(path, &map_size, &mem, error);
 	if (S_CHK_ERR(error, S_CONTERR,
-				  "SMMapFilesourceOpenFile"
+				  "SMMapFilesourceOpenFile",
 				  "Call to \"s_mmapfile_open\" failed for file \"%s\"",
 				  path))
 	{
@@ -100,7 +100,7 @@ S_API s_mmap_file_handle *s_win32_mmapfile_open(const char *path, size_t *map_si
 		return NULL;
 	}
 
-	if (*mem == NULL)
+	if (mem == NULL)
 	{
 		S_CTX_ERR(error, S_ARGERROR,
 				  "s_win32_mmapfile_open",
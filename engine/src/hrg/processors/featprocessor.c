@@ -85,6 +85,7 @@
 /************************************************************************************/
 
 #include "base/utils/alloc.h"
+#include "main/trace.h"
 #include "hrg/processors/featprocessor.h"
 
 
@@ -201,7 +202,9 @@ S_API SObject *SFeatProcessorRun(const SFeatProcessor *self, const SItem *item,
 		return NULL;
 	}
 
+	S_TRACE_BEGIN("featproc", S_OBJECT_CLS(self)->name);
 	extractedFeat = S_FEATPROCESSOR_CALL(self, run)(self, item, error);
+	S_TRACE_END("featproc", S_OBJECT_CLS(self)->name);
 
 	if (S_CHK_ERR(error, S_CONTERR,
 				  "SFeatProcessorRun",
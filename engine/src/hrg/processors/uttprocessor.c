@@ -198,6 +198,34 @@ S_API void SUttProcessorRun(const SUttProcessor *self, SUtterance *utt, s_erc *e
 		return;
 	}
 
+	if (S_UTTPROCESSOR_METH_VALID(self, run_state))
+	{
+		s_erc local_err = S_SUCCESS;
+		void *state;
+
+
+		/* reentrant processor, run with a state of its pool */
+		state = SUttProcessorStateAcquire(self, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "SUttProcessorRun",
+					  "Call to \"SUttProcessorStateAcquire\" failed"))
+			return;
+
+		SUttProcessorRunState(self, state, utt, error);
+		S_CHK_ERR(error, S_CONTERR,
+				  "SUttProcessorRun",
+				  "Call to \"SUttProcessorRunState\" failed");
+
+		SUttProcessorStateRelease(self, state, &local_err);
+		if (S_CHK_ERR(&local_err, S_CONTERR,
+					  "SUttProcessorRun",
+					  "Call to \"SUttProcessorStateRelease\" failed")
+			&& (*error == S_SUCCESS))
+			*error = local_err;
+
+		return;
+	}
+
 	if (!S_UTTPROCESSOR_METH_VALID(self, run))
 	{
 		S_CTX_ERR(error, S_ARGERROR,
@@ -213,6 +241,208 @@ S_API void SUttProcessorRun(const SUttProcessor *self, SUtterance *utt, s_erc *e
 }
 
 
+S_API s_bool SUttProcessorHasState(const SUttProcessor *self, s_erc *error)
+{
+	S_CLR_ERR(error);
+
+	if (self == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SUttProcessorHasState",
+				  "Argument \"self\" is NULL");
+		return FALSE;
+	}
+
+	if (S_UTTPROCESSOR_METH_VALID(self, create_state)
+		&& S_UTTPROCESSOR_METH_VALID(self, run_state))
+		return TRUE;
+
+	return FALSE;
+}
+
+
+S_API void *SUttProcessorStateAcquire(const SUttProcessor *self, s_erc *error)
+{
+	SUttProcessor *pool = (SUttProcessor*)self;  /* the pool is mutable */
+	void *state = NULL;
+
+
+	S_CLR_ERR(error);
+
+	if (self == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SUttProcessorStateAcquire",
+				  "Argument \"self\" is NULL");
+		return NULL;
+	}
+
+	if (!S_UTTPROCESSOR_METH_VALID(self, create_state))
+		return NULL;
+
+	s_mutex_lock(&(pool->states_mutex));
+	if (pool->num_states > 0)
+		state = pool->states[--(pool->num_states)];
+	s_mutex_unlock(&(pool->states_mutex));
+
+	if (state != NULL)
+		return state;
+
+	/* pool is empty, create a new state (outside of the lock) */
+	state = S_UTTPROCESSOR_CALL(self, create_state)(self, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SUttProcessorStateAcquire",
+				  "UttProcessor method \"create_state\" failed"))
+		return NULL;
+
+	if (state == NULL)
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "SUttProcessorStateAcquire",
+				  "UttProcessor method \"create_state\" returned NULL");
+		return NULL;
+	}
+
+	return state;
+}
+
+
+S_API void SUttProcessorStateRelease(const SUttProcessor *self, void *state,
+									 s_erc *error)
+{
+	SUttProcessor *pool = (SUttProcessor*)self;  /* the pool is mutable */
+	void **tmp;
+
+
+	S_CLR_ERR(error);
+
+	if (self == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SUttProcessorStateRelease",
+				  "Argument \"self\" is NULL");
+		return;
+	}
+
+	if (state == NULL)
+		return;
+
+	s_mutex_lock(&(pool->states_mutex));
+
+	if (pool->num_states == pool->size_states)
+	{
+		tmp = S_REALLOC(pool->states, void*, pool->size_states + 4);
+		if (tmp == NULL)
+		{
+			s_mutex_unlock(&(pool->states_mutex));
+			S_FTL_ERR(error, S_MEMERROR,
+					  "SUttProcessorStateRelease",
+					  "Failed to allocate memory for state pool");
+
+			/* can't pool it, destroy it */
+			if (S_UTTPROCESSOR_METH_VALID(self, destroy_state))
+			{
+				s_erc local_err = S_SUCCESS;
+
+
+				S_UTTPROCESSOR_CALL(self, destroy_state)(self, state, &local_err);
+			}
+			return;
+		}
+
+		pool->states = tmp;
+		pool->size_states += 4;
+	}
+
+	pool->states[(pool->num_states)++] = state;
+	s_mutex_unlock(&(pool->states_mutex));
+}
+
+
+S_API void SUttProcessorRunState(const SUttProcessor *self, void *state,
+								 SUtterance *utt, s_erc *error)
+{
+	S_CLR_ERR(error);
+
+	if (self == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SUttProcessorRunState",
+				  "Argument \"self\" is NULL");
+		return;
+	}
+
+	if (utt == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SUttProcessorRunState",
+				  "Argument \"utt\" is NULL");
+		return;
+	}
+
+	if (!S_UTTPROCESSOR_METH_VALID(self, run_state))
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SUttProcessorRunState",
+				  "UttProcessor method \"run_state\" not implemented");
+		return;
+	}
+
+	if ((state == NULL) && S_UTTPROCESSOR_METH_VALID(self, create_state))
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SUttProcessorRunState",
+				  "Argument \"state\" is NULL");
+		return;
+	}
+
+	S_UTTPROCESSOR_CALL(self, run_state)(self, state, utt, error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "SUttProcessorRunState",
+			  "Failed to process utterance");
+}
+
+
+S_API void SUttProcessorClearStates(SUttProcessor *self, s_erc *error)
+{
+	s_erc local_err;
+	uint32 i;
+
+
+	S_CLR_ERR(error);
+
+	if (self == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SUttProcessorClearStates",
+				  "Argument \"self\" is NULL");
+		return;
+	}
+
+	s_mutex_lock(&(self->states_mutex));
+
+	for (i = 0; i < self->num_states; i++)
+	{
+		if (!S_UTTPROCESSOR_METH_VALID(self, destroy_state))
+			break;
+
+		local_err = S_SUCCESS;
+		S_UTTPROCESSOR_CALL(self, destroy_state)(self, self->states[i], &local_err);
+		if (S_CHK_ERR(&local_err, S_CONTERR,
+					  "SUttProcessorClearStates",
+					  "UttProcessor method \"destroy_state\" failed"))
+			*error = local_err;
+	}
+
+	self->num_states = 0;
+	if (self->states != NULL)
+		S_FREE(self->states);
+	self->size_states = 0;
+
+	s_mutex_unlock(&(self->states_mutex));
+}
+
+
 S_API s_bool SUttProcessorFeatureIsPresent(const SUttProcessor *self,
 										   const char *name,
 										   s_erc *error)
@@ -387,6 +617,11 @@ static void InitUttProcessor(void *obj, s_erc *error)
 
 	S_CLR_ERR(error);
 
+	self->states = NULL;
+	self->num_states = 0;
+	self->size_states = 0;
+	s_mutex_init(&(self->states_mutex));
+
 	self->features = S_MAP(S_NEW(SMapList, error));
 	if (S_CHK_ERR(error, S_CONTERR,
 				  "InitUttProcessor",
@@ -401,6 +636,14 @@ static void DestroyUttProcessor(void *obj, s_erc *error)
 
 
 	S_CLR_ERR(error);
+
+	/* states that were not cleared by the class */
+	SUttProcessorClearStates(self, error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "DestroyUttProcessor",
+			  "Call to \"SUttProcessorClearStates\" failed");
+	s_mutex_destroy(&(self->states_mutex));
+
 	if (self->features != NULL)
 		S_DELETE(self->features, "DestroyUttProcessor", error);
 }
@@ -434,8 +677,11 @@ static SUttProcessorClass UttProcessorClass =
 		NULL,                /* copy    */
 	},
 	/* SUttProcessorClass */
-	NULL,                    /* initialize */
-	NULL                     /* run        */
+	NULL,                    /* initialize    */
+	NULL,                    /* run           */
+	NULL,                    /* create_state  */
+	NULL,                    /* destroy_state */
+	NULL                     /* run_state     */
 };
 
 
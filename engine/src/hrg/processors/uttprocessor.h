@@ -93,6 +93,16 @@
  * @defgroup SUttProc Utterance Processor
  * The <i> Utterance Processor </i> class implementation. An Utterance Processor processes an
  * utterance by extracting information from it and then modifying it in some way.
+ *
+ * Utterance processors are shared by all the utterances synthesized
+ * with a voice, and therefore @c run must not modify the
+ * processor. Processors that need mutable working memory (for
+ * example a synthesis engine) implement the per-run state methods
+ * @c create_state, @c destroy_state and @c run_state instead of
+ * @c run. #SUttProcessorRun then acquires a state from the
+ * processor's pool of idle states (creating a new one if the pool is
+ * empty) for every call and returns it to the pool afterwards, so
+ * that one processor can run concurrently in many threads.
  * @{
  */
 
@@ -166,6 +176,26 @@ typedef struct
 	 * @protected UttProcessor features.
 	 */
 	SMap    *features;
+
+	/**
+	 * @private Pool of idle per-run states.
+	 */
+	void   **states;
+
+	/**
+	 * @private Number of idle per-run states in the pool.
+	 */
+	uint32   num_states;
+
+	/**
+	 * @private Size of the pool.
+	 */
+	uint32   size_states;
+
+	/**
+	 * @private Locking mutex of the pool.
+	 */
+	S_DECLARE_MUTEX(states_mutex);
 } SUttProcessor;
 
 
@@ -214,6 +244,45 @@ typedef struct
 	 * @param error Error code.
 	 */
 	void (* const run) (const SUttProcessor *self, SUtterance *utt, s_erc *error);
+
+	/**
+	 * @protected Create state function pointer.
+	 * Create a new per-run state of the UttProcessor, see
+	 * #SUttProcessorStateAcquire.
+	 *
+	 * @param self The UttProcessor.
+	 * @param error Error code.
+	 *
+	 * @return The new state.
+	 *
+	 * @note Not necessarily implemented, if implemented then
+	 * @c destroy_state and @c run_state must also be implemented.
+	 */
+	void *(* const create_state)(const SUttProcessor *self, s_erc *error);
+
+	/**
+	 * @protected Destroy state function pointer.
+	 * Destroy a per-run state created by @c create_state.
+	 *
+	 * @param self The UttProcessor.
+	 * @param state The state to destroy.
+	 * @param error Error code.
+	 */
+	void (* const destroy_state)(const SUttProcessor *self, void *state, s_erc *error);
+
+	/**
+	 * @protected Run with state function pointer.
+	 * Execute the UttProcessor on the given utterance, using the
+	 * given per-run state as working memory. Used instead of @c run
+	 * if implemented.
+	 *
+	 * @param self The UttProcessor to execute.
+	 * @param state The per-run state, only used by this call.
+	 * @param utt The utterance on which to execute the UttProcessor.
+	 * @param error Error code.
+	 */
+	void (* const run_state)(const SUttProcessor *self, void *state,
+							 SUtterance *utt, s_erc *error);
 } SUttProcessorClass;
 
 
@@ -250,6 +319,82 @@ S_API void SUttProcessorInit(SUttProcessor **self, const SVoice *voice, s_erc *e
 S_API void SUttProcessorRun(const SUttProcessor *self, SUtterance *utt, s_erc *error);
 
 
+/**
+ * Query if the given UttProcessor uses per-run states.
+ * @public @memberof SUttProcessor
+ *
+ * @param self The given UttProcessor.
+ * @param error Error code.
+ *
+ * @return #TRUE if the UttProcessor class implements the per-run
+ * state methods, otherwise #FALSE.
+ */
+S_API s_bool SUttProcessorHasState(const SUttProcessor *self, s_erc *error);
+
+
+/**
+ * Acquire a per-run state of the given UttProcessor. An idle state is
+ * taken from the UttProcessor's pool, or a new one is created if the
+ * pool is empty. The state must be returned with
+ * #SUttProcessorStateRelease.
+ * @public @memberof SUttProcessor
+ *
+ * @param self The given UttProcessor.
+ * @param error Error code.
+ *
+ * @return The state, or @c NULL if the UttProcessor does not use
+ * per-run states.
+ *
+ * @note Thread safe.
+ */
+S_API void *SUttProcessorStateAcquire(const SUttProcessor *self, s_erc *error);
+
+
+/**
+ * Return a per-run state, acquired with #SUttProcessorStateAcquire,
+ * to the given UttProcessor's pool.
+ * @public @memberof SUttProcessor
+ *
+ * @param self The given UttProcessor.
+ * @param state The state to return.
+ * @param error Error code.
+ *
+ * @note Thread safe.
+ */
+S_API void SUttProcessorStateRelease(const SUttProcessor *self, void *state,
+									 s_erc *error);
+
+
+/**
+ * Execute the UttProcessor on the given utterance with the given
+ * per-run state. #SUttProcessorRun acquires and releases a state
+ * itself, this function is for callers that hold on to a state over
+ * many runs.
+ * @public @memberof SUttProcessor
+ *
+ * @param self The UttProcessor to execute.
+ * @param state The per-run state, from #SUttProcessorStateAcquire.
+ * @param utt The utterance on which to execute the UttProcessor.
+ * @param error Error code.
+ */
+S_API void SUttProcessorRunState(const SUttProcessor *self, void *state,
+								 SUtterance *utt, s_erc *error);
+
+
+/**
+ * Destroy all the idle per-run states of the given UttProcessor.
+ * Classes with per-run states whose @c destroy_state method uses
+ * members of the class must call this function in their @c destroy
+ * method, before those members are freed (the base class destroys the
+ * remaining states after the class).
+ * @public @memberof SUttProcessor
+ *
+ * @param self The given UttProcessor.
+ * @param error Error code.
+ */
+S_API void SUttProcessorClearStates(SUttProcessor *self, s_erc *error);
+
+
 /**
  * Query if named feature is present in the given UttProcessor.
  * @public @memberof SUttProcessor
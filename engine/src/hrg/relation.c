@@ -506,7 +506,7 @@ static SItem *RelationAppend(SRelation *self, const SItem *toShare, s_erc *error
 
 
 	S_CLR_ERR(error);
-	newItem = S_NEW(SItem, error);
+	newItem = _s_utterance_new_item(self->utterance, error);
 	if (S_CHK_ERR(error, S_FAILURE,
 		      "RelationAppend",
 		      "Failed to create new item"))
@@ -538,7 +538,7 @@ static SItem *RelationPrepend(SRelation *self, const SItem *toShare, s_erc *erro
 
 
 	S_CLR_ERR(error);
-	newItem = S_NEW(SItem, error);
+	newItem = _s_utterance_new_item(self->utterance, error);
 	if (S_CHK_ERR(error, S_FAILURE,
 		      "RelationAppend",
 		      "Failed to create new item"))
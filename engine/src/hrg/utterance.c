@@ -158,6 +158,7 @@
 /*                                                                                  */
 /************************************************************************************/
 
+#include <string.h>
 #include "base/utils/alloc.h"
 #include "hrg/utterance.h"
 
@@ -207,6 +208,18 @@
 static SUtteranceClass UtteranceClass; /* SUtterance class declaration. */
 
 
+/************************************************************************************/
+/*                                                                                  */
+/* Static function definitions                                                      */
+/*                                                                                  */
+/************************************************************************************/
+
+static void recycle_push(SObject ***pool, uint32 *num, uint32 *size,
+						 SObject *object, s_erc *error);
+
+static void recycle_items(SUtterance *self, SItem *item, s_erc *error);
+
+
 /************************************************************************************/
 /*                                                                                  */
 /* Function implementations                                                         */
@@ -229,6 +242,91 @@ S_API void SUtteranceInit(SUtterance **self, const SVoice *voice, s_erc *error)
 }
 
 
+S_API void SUtteranceReset(SUtterance *self, s_erc *error)
+{
+	SIterator *itr;
+	SRelation *rel;
+	SItem *head;
+
+
+	S_CLR_ERR(error);
+
+	if (self == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SUtteranceReset",
+				  "Argument \"self\" is NULL");
+		return;
+	}
+
+	s_mutex_lock(&(self->utt_mutex));
+
+	_s_map_list_clear(S_MAPLIST(self->features), error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SUtteranceReset",
+				  "Call to \"_s_map_list_clear\" failed"))
+	{
+		s_mutex_unlock(&(self->utt_mutex));
+		return;
+	}
+
+	/* item id's */
+	SMapSetInt(self->features, "_id", 0, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SUtteranceReset",
+				  "Call to \"SMapSetInt\" failed"))
+	{
+		s_mutex_unlock(&(self->utt_mutex));
+		return;
+	}
+
+	itr = S_ITERATOR_GET(self->relations, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SUtteranceReset",
+				  "Call to \"S_ITERATOR_GET\" failed"))
+	{
+		s_mutex_unlock(&(self->utt_mutex));
+		return;
+	}
+
+	while (itr)
+	{
+		rel = S_RELATION(SIteratorUnlink(itr, error));
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "SUtteranceReset",
+					  "Call to \"SIteratorUnlink\" failed"))
+		{
+			S_DELETE(itr, "SUtteranceReset", error);
+			s_mutex_unlock(&(self->utt_mutex));
+			return;
+		}
+
+		/*
+		 * Detach the items from the relation before recycling them,
+		 * the relation is then deleted without any items.
+		 */
+		head = rel->head;
+		rel->head = NULL;
+		rel->tail = NULL;
+
+		recycle_items(self, head, error);
+		S_FORCE_DELETE(rel, "SUtteranceReset", error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "SUtteranceReset",
+					  "Call to \"recycle_items\" failed"))
+		{
+			S_DELETE(itr, "SUtteranceReset", error);
+			s_mutex_unlock(&(self->utt_mutex));
+			return;
+		}
+
+		itr = SIteratorNext(itr);
+	}
+
+	s_mutex_unlock(&(self->utt_mutex));
+}
+
+
 S_API const SVoice *SUtteranceVoice(const SUtterance *self, s_erc *error)
 {
 	const SVoice *voice;
@@ -547,6 +645,62 @@ S_LOCAL sint32 SUtteranceGetNextId(const SUtterance *self, s_erc *error)
 }
 
 
+S_LOCAL SItem *_s_utterance_new_item(const SUtterance *self, s_erc *error)
+{
+	SItem *item = NULL;
+
+
+	S_CLR_ERR(error);
+
+	if (self != NULL)
+	{
+		s_mutex_lock((s_mutex*)&(self->utt_id_mutex));
+		if (self->num_free_items > 0)
+			item = S_ITEM(self->free_items[--((SUtterance*)self)->num_free_items]);
+		s_mutex_unlock((s_mutex*)&(self->utt_id_mutex));
+
+		if (item != NULL)
+			return item;
+	}
+
+	item = S_NEW(SItem, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "_s_utterance_new_item",
+				  "Failed to create new item"))
+		return NULL;
+
+	return item;
+}
+
+
+S_LOCAL SItmContent *_s_utterance_new_item_content(const SUtterance *self, s_erc *error)
+{
+	SItmContent *content = NULL;
+
+
+	S_CLR_ERR(error);
+
+	if (self != NULL)
+	{
+		s_mutex_lock((s_mutex*)&(self->utt_id_mutex));
+		if (self->num_free_contents > 0)
+			content = S_ITMCONTENT(self->free_contents[--((SUtterance*)self)->num_free_contents]);
+		s_mutex_unlock((s_mutex*)&(self->utt_id_mutex));
+
+		if (content != NULL)
+			return content;
+	}
+
+	content = S_NEW(SItmContent, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "_s_utterance_new_item_content",
+				  "Failed to create new item content"))
+		return NULL;
+
+	return content;
+}
+
+
 S_API const SObject *SUtteranceGetFeature(const SUtterance *self,
 										  const char *name,
 										  s_erc *error)
@@ -721,6 +875,138 @@ S_LOCAL void _s_utterance_class_add(s_erc *error)
 }
 
 
+/************************************************************************************/
+/*                                                                                  */
+/* Static function implementations                                                  */
+/*                                                                                  */
+/************************************************************************************/
+
+/*
+ * Add an object to a recycle pool, growing the pool if required. If
+ * the pool can not grow then the object is deleted.
+ */
+static void recycle_push(SObject ***pool, uint32 *num, uint32 *size,
+						 SObject *object, s_erc *error)
+{
+	SObject **tmp;
+	uint32 new_size;
+
+
+	S_CLR_ERR(error);
+
+	if (*num == *size)
+	{
+		new_size = (*size == 0) ? 64 : (*size * 2);
+
+		/* not S_REALLOC, it frees the old pool on failure */
+		tmp = S_MALLOC(SObject*, new_size);
+		if (tmp == NULL)
+		{
+			S_FTL_ERR(error, S_MEMERROR,
+					  "recycle_push",
+					  "Failed to allocate memory for recycle pool");
+			S_FORCE_DELETE(object, "recycle_push", error);
+			return;
+		}
+
+		if (*num > 0)
+			memcpy(tmp, *pool, sizeof(SObject*) * (*num));
+
+		if (*pool != NULL)
+			S_FREE(*pool);
+
+		*pool = tmp;
+		*size = new_size;
+	}
+
+	(*pool)[(*num)++] = object;
+}
+
+
+/*
+ * Recycle the given item, its following siblings and all their
+ * daughters. The item's content is recycled when no other item
+ * references it. Items that can not be recycled are deleted.
+ */
+static void recycle_items(SUtterance *self, SItem *item, s_erc *error)
+{
+	SItem *next;
+	SItmContent *content;
+	size_t num_rel;
+	s_erc local_err;
+
+
+	S_CLR_ERR(error);
+
+	while (item != NULL)
+	{
+		next = item->next;
+
+		S_CLR_ERR(&local_err);
+		recycle_items(self, item->down, &local_err);
+		S_CHK_ERR(&local_err, S_CONTERR,
+				  "recycle_items",
+				  "Call to \"recycle_items\" failed");
+		item->down = NULL;
+
+		content = item->content;
+		if ((local_err == S_SUCCESS) && (content != NULL) && (item->relation != NULL))
+		{
+			SItmContentRemove(content, item->relation->name, &local_err);
+			S_CHK_ERR(&local_err, S_CONTERR,
+					  "recycle_items",
+					  "Call to \"SItmContentRemove\" failed");
+
+			if (local_err == S_SUCCESS)
+			{
+				item->content = NULL;
+
+				num_rel = SItmContentNumRelations(content, &local_err);
+				S_CHK_ERR(&local_err, S_CONTERR,
+						  "recycle_items",
+						  "Call to \"SItmContentNumRelations\" failed");
+
+				if ((local_err == S_SUCCESS) && (num_rel == 0))
+				{
+					_s_map_list_clear(S_MAPLIST(content->features), &local_err);
+					S_CHK_ERR(&local_err, S_CONTERR,
+							  "recycle_items",
+							  "Call to \"_s_map_list_clear\" failed");
+
+					if (local_err == S_SUCCESS)
+						recycle_push(&(self->free_contents), &(self->num_free_contents),
+									 &(self->free_contents_size), S_OBJECT(content),
+									 &local_err);
+					else
+						S_FORCE_DELETE(content, "recycle_items", &local_err);
+				}
+			}
+		}
+
+		item->next = NULL;
+		item->prev = NULL;
+		item->up = NULL;
+
+		if (local_err == S_SUCCESS)
+		{
+			item->relation = NULL;
+			recycle_push(&(self->free_items), &(self->num_free_items),
+						 &(self->free_items_size), S_OBJECT(item), &local_err);
+		}
+		else
+		{
+			/* deleting the item releases whatever it still holds */
+			S_FORCE_DELETE(item, "recycle_items", error);
+		}
+
+		if ((local_err != S_SUCCESS) && (*error == S_SUCCESS))
+			*error = local_err;
+
+		item = next;
+	}
+}
+
+
 /************************************************************************************/
 /*                                                                                  */
 /* Static class function implementations                                            */
@@ -735,6 +1021,12 @@ static void InitUtterance(void *obj, s_erc *error)
 	S_CLR_ERR(error);
 
 	self->voice = NULL;
+	self->free_items = NULL;
+	self->num_free_items = 0;
+	self->free_items_size = 0;
+	self->free_contents = NULL;
+	self->num_free_contents = 0;
+	self->free_contents_size = 0;
 
 	self->features = S_MAP(S_NEW(SMapList, error));
 	if (S_CHK_ERR(error, S_CONTERR,
@@ -764,6 +1056,7 @@ static void DestroyUtt(void *obj, s_erc *error)
 	SUtterance *self = obj;
 	SIterator *itr;
 	SRelation *rel;
+	SObject *recycled;
 
 	S_CLR_ERR(error);
 
@@ -803,6 +1096,26 @@ static void DestroyUtt(void *obj, s_erc *error)
 	}
 
 	S_DELETE(self->relations, "DestroyUtt", error);
+
+	/* recycled items and contents */
+	while (self->num_free_items > 0)
+	{
+		recycled = self->free_items[--self->num_free_items];
+		S_FORCE_DELETE(recycled, "DestroyUtt", error);
+	}
+
+	if (self->free_items != NULL)
+		S_FREE(self->free_items);
+
+	while (self->num_free_contents > 0)
+	{
+		recycled = self->free_contents[--self->num_free_contents];
+		S_FORCE_DELETE(recycled, "DestroyUtt", error);
+	}
+
+	if (self->free_contents != NULL)
+		S_FREE(self->free_contents);
+
 	s_mutex_unlock(&(self->utt_mutex));
 	s_mutex_destroy(&(self->utt_mutex));
 	s_mutex_destroy(&(self->utt_id_mutex));
@@ -250,13 +250,45 @@ struct SUtterance
 	 */
 	SMap    *relations;
 
+	/**
+	 * @protected Items released by #SUtteranceReset, reused when new
+	 * items are created in the utterance's relations.
+	 */
+	SObject **free_items;
+
+	/**
+	 * @protected Number of items in @c free_items.
+	 */
+	uint32    num_free_items;
+
+	/**
+	 * @protected Allocated size of @c free_items.
+	 */
+	uint32    free_items_size;
+
+	/**
+	 * @protected Item contents released by #SUtteranceReset, reused
+	 * when new items are created in the utterance's relations.
+	 */
+	SObject **free_contents;
+
+	/**
+	 * @protected Number of item contents in @c free_contents.
+	 */
+	uint32    num_free_contents;
+
+	/**
+	 * @protected Allocated size of @c free_contents.
+	 */
+	uint32    free_contents_size;
+
  	/**
 	 * @protected Locking mutex.
 	 */
 	S_DECLARE_MUTEX(utt_mutex);
 
 	/**
-	 * @protected Locking mutex for ids.
+	 * @protected Locking mutex for ids and recycled items.
 	 */
 	S_DECLARE_MUTEX(utt_id_mutex);
 };
@@ -418,6 +450,35 @@ S_API void SUtteranceInit(SUtterance **self, const SVoice *voice, s_erc *error);
 S_API const SVoice *SUtteranceVoice(const SUtterance *self, s_erc *error);
 
 
+/**
+ * @}
+ */
+
+
+/**
+ * @name Reset
+ * @{
+ */
+
+
+/**
+ * Reset the given utterance so that it can be used for another
+ * synthesis request. All the relations and features of the utterance
+ * are deleted, but the utterance keeps its containers, and the items
+ * and item contents of the deleted relations are kept aside to be
+ * reused by the items that are created next. The utterance's voice
+ * is not changed.
+ * @public @memberof SUtterance
+ *
+ * @param self The utterance to reset.
+ * @param error Error code.
+ *
+ * @note Items and relations of the utterance must not be used after a
+ * reset, any pointers to them are invalid.
+ */
+S_API void SUtteranceReset(SUtterance *self, s_erc *error);
+
+
 /**
  * @}
  */
@@ -524,6 +585,34 @@ S_API SList *SUtteranceRelationsKeys(const SUtterance *self, s_erc *error);
 S_LOCAL sint32 SUtteranceGetNextId(const SUtterance *self, s_erc *error);
 
 
+/**
+ * Get a new item for a relation of the given utterance. A recycled
+ * item (see #SUtteranceReset) is returned if one is available,
+ * otherwise a new item is created.
+ * @private @memberof SUtterance
+ *
+ * @param self The utterance, may be @c NULL.
+ * @param error Error code.
+ *
+ * @return Pointer to an item that still needs to be initialized.
+ */
+S_LOCAL SItem *_s_utterance_new_item(const SUtterance *self, s_erc *error);
+
+
+/**
+ * Get a new item content for an item of the given utterance. A
+ * recycled item content (see #SUtteranceReset) is returned if one is
+ * available, otherwise a new item content is created.
+ * @private @memberof SUtterance
+ *
+ * @param self The utterance, may be @c NULL.
+ * @param error Error code.
+ *
+ * @return Pointer to an empty item content.
+ */
+S_LOCAL SItmContent *_s_utterance_new_item_content(const SUtterance *self, s_erc *error);
+
+
 /**
  * @name Features
  * @{
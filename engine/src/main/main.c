@@ -46,6 +46,8 @@
 #include "main/loggers.h"
 #include "main/modules.h"
 #include "main/managers.h"
+#include "main/profile.h"
+#include "main/trace.h"
 #include "main/main.h"
 
 
@@ -73,11 +75,21 @@ S_API s_erc speect_init(s_logger *logger)
 	s_erc local_err = S_SUCCESS;
 	char *plugin_path;
 	s_logger *local_logger;
+	s_profile_mark total_mark;
+	s_profile_mark mark;
 
 
 	if (initialized_count++ > 0)
 		return S_SUCCESS;
 
+	/* per thread allocation counters, for the start-up profile and timings */
+	_s_alloc_init();
+
+	/* start-up profiling, before anything else so that it can be timed */
+	_s_profile_init();
+	_s_profile_begin(&total_mark);
+	_s_trace_init();
+
 #if 0  /* this seems to break stuff */
 	/* set the current locale */
 	if (setlocale(LC_ALL, "") == NULL)
@@ -121,7 +133,9 @@ S_API s_erc speect_init(s_logger *logger)
 #endif /* SPCT_ERROR_HANDLING */
 
 	/* initialize error handling module */
+	_s_profile_begin(&mark);
 	_s_errdbg_init(logger, S_DBG_NONE, &local_err);
+	_s_profile_end(&mark, "init", "error handling");
 	if (local_err != S_SUCCESS)
 	{
 		S_ERR_PRINT(S_FAILURE, "speect_init",
@@ -142,7 +156,9 @@ S_API s_erc speect_init(s_logger *logger)
 	}
 
 	/* create the class repository, size of 128 should be OK for now. */
+	_s_profile_begin(&mark);
 	_s_classes_create(128, &local_err);
+	_s_profile_end(&mark, "init", "class repository creation");
 	if (S_CHK_ERR(&local_err, S_CONTERR,
 				  "speect_init",
 				  "Failed to create Speect Engine class repository"))
@@ -154,7 +170,9 @@ S_API s_erc speect_init(s_logger *logger)
 	}
 
 	/* initialize the rest of the Speect modules */
+	_s_profile_begin(&mark);
 	_s_modules_init(&local_err);
+	_s_profile_end(&mark, "init", "modules");
 	if (S_CHK_ERR(&local_err, S_CONTERR,
 				  "speect_init",
 				  "Failed to initialize Speect Engine modules"))
@@ -166,7 +184,9 @@ S_API s_erc speect_init(s_logger *logger)
 	}
 
 	/* get the plug-in path */
+	_s_profile_begin(&mark);
 	plugin_path = _s_find_plugin_path(&local_err);
+	_s_profile_end(&mark, "init", "plug-in path");
 	if (S_CHK_ERR(&local_err, S_CONTERR,
 				  "speect_init",
 				  "Unable to find the plug-in path, call to \"_s_find_plugin_path\" failed"))
@@ -178,7 +198,9 @@ S_API s_erc speect_init(s_logger *logger)
 	}
 
 	/* initialize the class repository */
+	_s_profile_begin(&mark);
 	_s_classes_init(&local_err);
+	_s_profile_end(&mark, "init", "class registration");
 	if (S_CHK_ERR(&local_err, S_CONTERR,
 				  "speect_init",
 				  "Failed to initialize Speect Engine class repository"))
@@ -192,7 +214,9 @@ S_API s_erc speect_init(s_logger *logger)
 	}
 
 	/* initialize the managers (PluginManager/VoiceManager) */
+	_s_profile_begin(&mark);
 	_s_managers_init(&local_err);
+	_s_profile_end(&mark, "init", "managers");
 	if (S_CHK_ERR(&local_err, S_CONTERR,
 				  "speect_init",
 				  "Failed to initialize Speect Engine managers"))
@@ -225,6 +249,9 @@ S_API s_erc speect_init(s_logger *logger)
 
 	S_FREE(plugin_path);
 
+	_s_profile_end(&total_mark, "init", "speect_init");
+	_s_profile_dump();
+
 #ifdef SPCT_DEBUGMODE
 	_s_classes_print(&local_err);
 	S_CHK_ERR(&local_err, S_CONTERR,
@@ -250,6 +277,9 @@ S_API s_erc speect_quit(void)
 		|| (--initialized_count > 0))
 		return S_SUCCESS;
 
+	/* write the trace (SPCT_TRACE) while the error handling is available */
+	_s_trace_quit();
+
 	/* quit the managers (PluginManager/VoiceManager) */
 	_s_managers_quit(&local_err);
 	if (S_CHK_ERR(&local_err, S_CONTERR,
@@ -280,6 +310,9 @@ S_API s_erc speect_quit(void)
 		store_err = local_err;
 	}
 
+	_s_profile_quit();
+	_s_alloc_quit();
+
 	if ((store_err != S_SUCCESS) && (local_err == S_SUCCESS))
 		local_err = store_err;
 
@@ -98,7 +98,7 @@ S_LOCAL void _s_modules_init(s_erc *error)
 				  "Failed to intialize serialization module"))
 		local_err = *error;
 
-	_s_voicemanager_init(error);                           /* 1 class */
+	_s_voicemanager_init(error);                           /* 6 classes */
 	if (S_CHK_ERR(error, S_CONTERR,
 				  "_s_modules_init",
 				  "Failed to intialize voicemanager module"))
@@ -0,0 +1,562 @@
+/************************************************************************************/
+/* Copyright (c) 2008-2011 The Department of Arts and Culture,                      */
+/* The Government of the Republic of South Africa.                                  */
+/*                                                                                  */
+/* Contributors:  Meraka Institute, CSIR, South Africa.                             */
+/*                                                                                  */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy     */
+/* of this software and associated documentation files (the "Software"), to deal    */
+/* in the Software without restriction, including without limitation the rights     */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        */
+/* copies of the Software, and to permit persons to whom the Software is            */
+/* furnished to do so, subject to the following conditions:                         */
+/* The above copyright notice and this permission notice shall be included in       */
+/* all copies or substantial portions of the Software.                              */
+/*                                                                                  */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN        */
+/* THE SOFTWARE.                                                                    */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* AUTHOR  : Speect contributors                                                    */
+/* DATE    : 19 October 2026                                                        */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* Start-up profiling of the Speect Engine initialization, plug-in and              */
+/* voice loading.                                                                   */
+/*                                                                                  */
+/*                                                                                  */
+/************************************************************************************/
+
+/************************************************************************************/
+/*                                                                                  */
+/* Modules used                                                                     */
+/*                                                                                  */
+/************************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include "base/utils/alloc.h"
+#include "base/utils/stime.h"
+#include "base/strings/sprint.h"
+#include "base/threads/threads.h"
+#include "containers/containers.h"
+#include "main/profile.h"
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Defines                                                                          */
+/*                                                                                  */
+/************************************************************************************/
+
+/* maximum length of a step name */
+#define S_PROFILE_NAME_SIZE 128
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static variables                                                                 */
+/*                                                                                  */
+/************************************************************************************/
+
+typedef struct s_profile_record s_profile_record;
+
+struct s_profile_record
+{
+	const char       *category;
+	char              name[S_PROFILE_NAME_SIZE];
+	uint32            seq;
+	uint32            depth;
+	double            time;    /* milliseconds */
+	ulong             allocs;
+	s_bool            dumped;
+	s_profile_record *next;
+};
+
+
+static s_bool profile_enabled = FALSE;
+
+static s_bool profile_dump = FALSE;
+
+static s_bool profile_initialized = FALSE;
+
+static uint32 profile_seq = 0;
+
+/* the nesting depth of the steps of a thread, stored as the key value */
+static s_thread_key profile_depth_key;
+
+/* records, ordered by sequence number */
+static s_profile_record *profile_records = NULL;
+
+S_DECLARE_MUTEX_STATIC(profile_mutex);
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static function prototypes                                                       */
+/*                                                                                  */
+/************************************************************************************/
+
+static void insert_record(s_profile_record *record);
+
+static void format_record(const s_profile_record *record, char *buf, size_t size);
+
+static void free_records(void);
+
+static uint32 get_depth(void);
+
+static void set_depth(uint32 depth);
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Function implementations                                                         */
+/*                                                                                  */
+/************************************************************************************/
+
+S_API void s_profile_startup_enable(s_bool enable)
+{
+	profile_enabled = enable;
+	_s_alloc_count_enable(enable);
+}
+
+
+S_API s_bool s_profile_startup_enabled(void)
+{
+	return profile_enabled;
+}
+
+
+S_API SMap *s_profile_startup_get(s_erc *error)
+{
+	SMap *profile;
+	SList *steps;
+	SMap *step;
+	const s_profile_record *record;
+	double total_time = 0.0;
+	ulong total_allocs = 0;
+
+
+	S_CLR_ERR(error);
+
+	profile = S_MAP(S_NEW(SMapList, error));
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "s_profile_startup_get",
+				  "Failed to create new map"))
+		return NULL;
+
+	steps = S_LIST(S_NEW(SListList, error));
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "s_profile_startup_get",
+				  "Failed to create new list"))
+	{
+		S_DELETE(profile, "s_profile_startup_get", error);
+		return NULL;
+	}
+
+	SMapSetObject(profile, "steps", S_OBJECT(steps), error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "s_profile_startup_get",
+				  "Call to \"SMapSetObject\" failed"))
+	{
+		S_DELETE(steps, "s_profile_startup_get", error);
+		S_DELETE(profile, "s_profile_startup_get", error);
+		return NULL;
+	}
+
+	if (profile_initialized)
+		s_mutex_lock(&profile_mutex);
+
+	for (record = profile_records; record != NULL; record = record->next)
+	{
+		step = S_MAP(S_NEW(SMapList, error));
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "s_profile_startup_get",
+					  "Failed to create new map"))
+			break;
+
+		SListAppend(steps, S_OBJECT(step), error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "s_profile_startup_get",
+					  "Call to \"SListAppend\" failed"))
+		{
+			S_DELETE(step, "s_profile_startup_get", error);
+			break;
+		}
+
+		SMapSetString(step, "category", record->category, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "s_profile_startup_get",
+					  "Call to \"SMapSetString\" failed"))
+			break;
+
+		SMapSetString(step, "name", record->name, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "s_profile_startup_get",
+					  "Call to \"SMapSetString\" failed"))
+			break;
+
+		SMapSetInt(step, "depth", (sint32)record->depth, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "s_profile_startup_get",
+					  "Call to \"SMapSetInt\" failed"))
+			break;
+
+		SMapSetFloat(step, "time", (float)record->time, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "s_profile_startup_get",
+					  "Call to \"SMapSetFloat\" failed"))
+			break;
+
+		SMapSetInt(step, "allocations", (sint32)record->allocs, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "s_profile_startup_get",
+					  "Call to \"SMapSetInt\" failed"))
+			break;
+
+		if (record->depth == 0)
+		{
+			total_time += record->time;
+			total_allocs += record->allocs;
+		}
+	}
+
+	if (profile_initialized)
+		s_mutex_unlock(&profile_mutex);
+
+	if (*error != S_SUCCESS)
+	{
+		S_DELETE(profile, "s_profile_startup_get", error);
+		return NULL;
+	}
+
+	SMapSetFloat(profile, "time", (float)total_time, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "s_profile_startup_get",
+				  "Call to \"SMapSetFloat\" failed"))
+	{
+		S_DELETE(profile, "s_profile_startup_get", error);
+		return NULL;
+	}
+
+	SMapSetInt(profile, "allocations", (sint32)total_allocs, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "s_profile_startup_get",
+				  "Call to \"SMapSetInt\" failed"))
+	{
+		S_DELETE(profile, "s_profile_startup_get", error);
+		return NULL;
+	}
+
+	return profile;
+}
+
+
+S_API char *s_profile_startup_report(s_erc *error)
+{
+	const s_profile_record *record;
+	char line[S_PROFILE_NAME_SIZE + 96];
+	char *report;
+	char *tmp;
+	size_t len;
+	size_t line_len;
+	double total_time = 0.0;
+	ulong total_allocs = 0;
+
+
+	S_CLR_ERR(error);
+
+	s_asprintf(&report, error, "%12s %12s  %s\n",
+			   "time (ms)", "allocations", "step");
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "s_profile_startup_report",
+				  "Call to \"s_asprintf\" failed"))
+		return NULL;
+
+	len = strlen(report);
+
+	if (profile_initialized)
+		s_mutex_lock(&profile_mutex);
+
+	for (record = profile_records; record != NULL; record = record->next)
+	{
+		format_record(record, line, sizeof(line));
+		line_len = strlen(line);
+
+		tmp = S_REALLOC(report, char, len + line_len + 2);
+		if (tmp == NULL)
+		{
+			S_FTL_ERR(error, S_MEMERROR,
+					  "s_profile_startup_report",
+					  "Failed to allocate memory for report");
+			break;
+		}
+
+		report = tmp;
+		memcpy(report + len, line, line_len);
+		len += line_len;
+		report[len++] = '\n';
+		report[len] = '\0';
+
+		if (record->depth == 0)
+		{
+			total_time += record->time;
+			total_allocs += record->allocs;
+		}
+	}
+
+	if (profile_initialized)
+		s_mutex_unlock(&profile_mutex);
+
+	if (*error != S_SUCCESS)
+	{
+		S_FREE(report);
+		return NULL;
+	}
+
+	s_asprintf(&tmp, error, "%s%12.3f %12lu  %s\n",
+			   report, total_time, total_allocs, "total");
+	S_FREE(report);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "s_profile_startup_report",
+				  "Call to \"s_asprintf\" failed"))
+		return NULL;
+
+	return tmp;
+}
+
+
+S_API void s_profile_startup_clear(void)
+{
+	if (profile_initialized)
+		s_mutex_lock(&profile_mutex);
+
+	free_records();
+
+	if (profile_initialized)
+		s_mutex_unlock(&profile_mutex);
+}
+
+
+S_LOCAL void _s_profile_begin(s_profile_mark *mark)
+{
+	s_erc local_err = S_SUCCESS;
+
+
+	mark->active = (profile_enabled && profile_initialized);
+	if (!mark->active)
+		return;
+
+	s_mutex_lock(&profile_mutex);
+	mark->seq = profile_seq++;
+	s_mutex_unlock(&profile_mutex);
+
+	mark->depth = get_depth();
+	set_depth(mark->depth + 1);
+
+	mark->allocs = _s_alloc_count();
+	mark->start = s_time_monotonic(&local_err);
+}
+
+
+S_LOCAL void _s_profile_end(s_profile_mark *mark, const char *category,
+							const char *format, ...)
+{
+	s_erc local_err = S_SUCCESS;
+	s_profile_record *record;
+	double end;
+	ulong allocs;
+	va_list argp;
+
+
+	if (!mark->active)
+		return;
+
+	/* take the measurements before allocating the record */
+	end = s_time_monotonic(&local_err);
+	allocs = _s_alloc_count() - mark->allocs;
+
+	set_depth(mark->depth);
+
+	/* the record itself is not part of any (enclosing) step */
+	_s_alloc_count_pause(TRUE);
+	record = S_CALLOC(s_profile_record, 1);
+	if (record == NULL)
+	{
+		_s_alloc_count_pause(FALSE);
+		S_FTL_ERR(&local_err, S_MEMERROR,
+				  "_s_profile_end",
+				  "Failed to allocate memory for 's_profile_record' object");
+		return;
+	}
+
+	va_start(argp, format);
+	s_vszprintf(record->name, S_PROFILE_NAME_SIZE, format, argp, &local_err);
+	va_end(argp);
+	_s_alloc_count_pause(FALSE);
+	if (local_err != S_SUCCESS)
+		record->name[0] = '\0';
+
+	record->category = category;
+	record->seq = mark->seq;
+	record->depth = mark->depth;
+	record->time = (end - mark->start) * 1000.0;
+	record->allocs = allocs;
+	record->dumped = FALSE;
+
+	s_mutex_lock(&profile_mutex);
+	insert_record(record);
+	s_mutex_unlock(&profile_mutex);
+}
+
+
+S_LOCAL void _s_profile_dump(void)
+{
+	s_profile_record *record;
+	char line[S_PROFILE_NAME_SIZE + 96];
+
+
+	if (!profile_dump || !profile_enabled)
+		return;
+
+	s_mutex_lock(&profile_mutex);
+
+	for (record = profile_records; record != NULL; record = record->next)
+	{
+		if (record->dumped)
+			continue;
+
+		format_record(record, line, sizeof(line));
+		s_errdbg_info("start-up profile: %s", line);
+		record->dumped = TRUE;
+	}
+
+	s_mutex_unlock(&profile_mutex);
+}
+
+
+S_LOCAL void _s_profile_init(void)
+{
+	s_erc local_err = S_SUCCESS;
+	const char *env;
+
+
+	if (profile_initialized)
+		return;
+
+	s_thread_key_create(&profile_depth_key, NULL, &local_err);
+	if (local_err != S_SUCCESS)
+	{
+		S_ERR_PRINT(S_FAILURE, "_s_profile_init",
+					"Failed to create thread key, start-up profiling is not available");
+		return;
+	}
+
+	s_mutex_init(&profile_mutex);
+	profile_initialized = TRUE;
+
+	/* s_getenv is not available before the modules are initialized */
+	env = getenv("SPCT_PROFILE_STARTUP");
+	if ((env != NULL) && (env[0] != '\0') && (strcmp(env, "0") != 0))
+	{
+		profile_dump = TRUE;
+		s_profile_startup_enable(TRUE);
+	}
+}
+
+
+S_LOCAL void _s_profile_quit(void)
+{
+	if (!profile_initialized)
+		return;
+
+	free_records();
+	profile_seq = 0;
+	profile_initialized = FALSE;
+	s_thread_key_delete(&profile_depth_key);
+	s_mutex_destroy(&profile_mutex);
+}
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static function implementations                                                  */
+/*                                                                                  */
+/************************************************************************************/
+
+static void insert_record(s_profile_record *record)
+{
+	s_profile_record *prev;
+
+
+	if ((profile_records == NULL)
+		|| (profile_records->seq > record->seq))
+	{
+		record->next = profile_records;
+		profile_records = record;
+		return;
+	}
+
+	for (prev = profile_records;
+		 (prev->next != NULL) && (prev->next->seq < record->seq);
+		 prev = prev->next)
+		;
+
+	record->next = prev->next;
+	prev->next = record;
+}
+
+
+static void format_record(const s_profile_record *record, char *buf, size_t size)
+{
+	s_erc local_err = S_SUCCESS;
+	uint32 indent;
+
+
+	indent = record->depth * 2;
+	if (indent > 16)
+		indent = 16;
+
+	s_szprintf(buf, size, &local_err, "%12.3f %12lu  %*s[%s] %s",
+			   record->time, record->allocs, (int)indent, "",
+			   record->category, record->name);
+	if (local_err != S_SUCCESS)
+		buf[0] = '\0';
+}
+
+
+static void free_records(void)
+{
+	s_profile_record *record;
+
+
+	while (profile_records != NULL)
+	{
+		record = profile_records;
+		profile_records = record->next;
+		S_FREE(record);
+	}
+}
+
+
+static uint32 get_depth(void)
+{
+	return (uint32)(size_t)s_thread_key_get(&profile_depth_key);
+}
+
+
+static void set_depth(uint32 depth)
+{
+	s_erc local_err = S_SUCCESS;
+
+
+	s_thread_key_set(&profile_depth_key, (void*)(size_t)depth, &local_err);
+}
@@ -0,0 +1,230 @@
+/************************************************************************************/
+/* Copyright (c) 2008-2011 The Department of Arts and Culture,                      */
+/* The Government of the Republic of South Africa.                                  */
+/*                                                                                  */
+/* Contributors:  Meraka Institute, CSIR, South Africa.                             */
+/*                                                                                  */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy     */
+/* of this software and associated documentation files (the "Software"), to deal    */
+/* in the Software without restriction, including without limitation the rights     */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        */
+/* copies of the Software, and to permit persons to whom the Software is            */
+/* furnished to do so, subject to the following conditions:                         */
+/* The above copyright notice and this permission notice shall be included in       */
+/* all copies or substantial portions of the Software.                              */
+/*                                                                                  */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN        */
+/* THE SOFTWARE.                                                                    */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* AUTHOR  : Speect contributors                                                    */
+/* DATE    : 19 October 2026                                                        */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* Start-up profiling of the Speect Engine initialization, plug-in and              */
+/* voice loading.                                                                   */
+/*                                                                                  */
+/*                                                                                  */
+/************************************************************************************/
+
+#ifndef _SPCT_MAIN_PROFILE_H__
+#define _SPCT_MAIN_PROFILE_H__
+
+
+/**
+ * @file profile.h
+ * Start-up profiling.
+ */
+
+
+/**
+ * @ingroup Speect
+ * @defgroup SProfile Start-up Profiling
+ * Record monotonic timings and allocation counts of the steps taken
+ * during Speect Engine initialization, plug-in loading and voice
+ * loading.
+ *
+ * Profiling is off by default and costs a single flag test per step
+ * when off. It is switched on by calling #s_profile_startup_enable
+ * (which may be done before #speect_init), or by setting the
+ * @c SPCT_PROFILE_STARTUP environment variable to a non-zero value
+ * before #speect_init is called. In the latter case the steps are
+ * also dumped to the logger (as informational messages) at the end of
+ * #speect_init and of every voice load.
+ *
+ * Nested steps (for example the plug-ins loaded while loading a voice)
+ * are included in the timings and allocation counts of their
+ * enclosing steps.
+ * @{
+ */
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Modules used                                                                     */
+/*                                                                                  */
+/************************************************************************************/
+
+#include "include/common.h"
+#include "base/utils/types.h"
+#include "base/errdbg/errdbg.h"
+#include "containers/map/map.h"
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Begin external c declaration                                                     */
+/*                                                                                  */
+/************************************************************************************/
+S_BEGIN_C_DECLS
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Typedefs                                                                         */
+/*                                                                                  */
+/************************************************************************************/
+
+/**
+ * The start of a profiled step.
+ * @private
+ */
+typedef struct
+{
+	double  start;   /*!< Monotonic time at start of step (seconds).  */
+	ulong   allocs;  /*!< Allocation count at start of step.           */
+	uint32  seq;     /*!< Sequence number of step (order of starting). */
+	uint32  depth;   /*!< Nesting depth of step.                        */
+	s_bool  active;  /*!< If the step is being profiled.                */
+} s_profile_mark;
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Function prototypes                                                              */
+/*                                                                                  */
+/************************************************************************************/
+
+/**
+ * Enable or disable start-up profiling. May be called before
+ * #speect_init.
+ *
+ * @param enable If #TRUE then start-up steps are recorded.
+ */
+S_API void s_profile_startup_enable(s_bool enable);
+
+
+/**
+ * Query whether start-up profiling is enabled.
+ *
+ * @return #TRUE if start-up steps are being recorded.
+ */
+S_API s_bool s_profile_startup_enabled(void);
+
+
+/**
+ * Get the recorded start-up profile. The returned map has the
+ * following keys:
+ * <ul>
+ * <li> @c "steps" : an #SList of #SMap, one for every recorded step in
+ * the order the steps were started. Each map has the keys
+ * @c "category" (string), @c "name" (string), @c "depth" (int,
+ * nesting depth), @c "time" (float, milliseconds) and
+ * @c "allocations" (int, number of memory allocations). </li>
+ * <li> @c "time" : total time of the top-level steps (float, milliseconds). </li>
+ * <li> @c "allocations" : total allocations of the top-level steps (int). </li>
+ * </ul>
+ *
+ * @param error Error code.
+ *
+ * @return The start-up profile.
+ *
+ * @note Caller is responsible for the returned map.
+ */
+S_API SMap *s_profile_startup_get(s_erc *error);
+
+
+/**
+ * Get a human-readable report of the recorded start-up profile.
+ *
+ * @param error Error code.
+ *
+ * @return The report.
+ *
+ * @note Caller is responsible for the returned memory.
+ */
+S_API char *s_profile_startup_report(s_erc *error);
+
+
+/**
+ * Clear the recorded start-up profile.
+ */
+S_API void s_profile_startup_clear(void);
+
+
+/**
+ * Begin a profiled step. Does nothing if profiling is disabled.
+ * @private
+ *
+ * @param mark The start of the step.
+ */
+S_LOCAL void _s_profile_begin(s_profile_mark *mark);
+
+
+/**
+ * End a profiled step and record it. Does nothing if profiling was
+ * disabled when the step began.
+ * @private
+ *
+ * @param mark The start of the step, as given to #_s_profile_begin.
+ * @param category The step category, must be a static string.
+ * @param format Format of the step name, followed by its arguments.
+ */
+S_LOCAL void _s_profile_end(s_profile_mark *mark, const char *category,
+							const char *format, ...);
+
+
+/**
+ * Write the steps recorded since the last dump to the logger, if the
+ * @c SPCT_PROFILE_STARTUP environment variable was set.
+ * @private
+ */
+S_LOCAL void _s_profile_dump(void);
+
+
+/**
+ * Initialize the start-up profiling module. Reads the
+ * @c SPCT_PROFILE_STARTUP environment variable.
+ * @private
+ */
+S_LOCAL void _s_profile_init(void);
+
+
+/**
+ * Quit the start-up profiling module, clearing the recorded steps.
+ * @private
+ */
+S_LOCAL void _s_profile_quit(void);
+
+
+/**
+ * @}
+ */
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* End external c declaration                                                       */
+/*                                                                                  */
+/************************************************************************************/
+S_END_C_DECLS
+
+
+#endif /* _SPCT_MAIN_PROFILE_H__ */
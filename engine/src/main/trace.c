@@ -0,0 +1,673 @@
+/************************************************************************************/
+/* Copyright (c) 2008-2011 The Department of Arts and Culture,                      */
+/* The Government of the Republic of South Africa.                                  */
+/*                                                                                  */
+/* Contributors:  Meraka Institute, CSIR, South Africa.                             */
+/*                                                                                  */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy     */
+/* of this software and associated documentation files (the "Software"), to deal    */
+/* in the Software without restriction, including without limitation the rights     */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        */
+/* copies of the Software, and to permit persons to whom the Software is            */
+/* furnished to do so, subject to the following conditions:                         */
+/* The above copyright notice and this permission notice shall be included in       */
+/* all copies or substantial portions of the Software.                              */
+/*                                                                                  */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN        */
+/* THE SOFTWARE.                                                                    */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* AUTHOR  : Speect contributors                                                    */
+/* DATE    : 19 October 2026                                                        */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* Tracing of synthesis spans, exported as Chrome trace-event JSON.                 */
+/*                                                                                  */
+/*                                                                                  */
+/************************************************************************************/
+
+/************************************************************************************/
+/*                                                                                  */
+/* Modules used                                                                     */
+/*                                                                                  */
+/************************************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdarg.h>
+#include "base/utils/alloc.h"
+#include "base/utils/stime.h"
+#include "base/strings/sprint.h"
+#include "base/threads/threads.h"
+#include "main/trace.h"
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Defines                                                                          */
+/*                                                                                  */
+/************************************************************************************/
+
+/* size of a span name, including the trailing zero */
+#define S_TRACE_NAME_SIZE 64
+
+/*
+ * The owning thread publishes the event count of its buffer with
+ * release semantics after writing an event, and readers load it with
+ * acquire semantics. The fences pair up as in a seqlock, with the
+ * event count as sequence: a reader that copied a slot while its
+ * owner overwrote it sees the newer count after the copy.
+ */
+#if defined(__GNUC__)
+#  define S_TRACE_LOAD_ACQUIRE(P)     __atomic_load_n((P), __ATOMIC_ACQUIRE)
+#  define S_TRACE_LOAD_RELAXED(P)     __atomic_load_n((P), __ATOMIC_RELAXED)
+#  define S_TRACE_STORE_RELEASE(P, V) __atomic_store_n((P), (V), __ATOMIC_RELEASE)
+#  define S_TRACE_FENCE_ACQUIRE()     __atomic_thread_fence(__ATOMIC_ACQUIRE)
+#  define S_TRACE_FENCE_RELEASE()     __atomic_thread_fence(__ATOMIC_RELEASE)
+#elif defined(SPCT_MSVC)
+#  define S_TRACE_LOAD_ACQUIRE(P)     trace_load_acquire(P)
+#  define S_TRACE_LOAD_RELAXED(P)     (*(volatile const uint32*)(P))
+#  define S_TRACE_STORE_RELEASE(P, V) do { MemoryBarrier(); *(volatile uint32*)(P) = (V); } while (0)
+#  define S_TRACE_FENCE_ACQUIRE()     MemoryBarrier()
+#  define S_TRACE_FENCE_RELEASE()     MemoryBarrier()
+#else /* no atomics, only without threads */
+#  define S_TRACE_LOAD_ACQUIRE(P)     (*(P))
+#  define S_TRACE_LOAD_RELAXED(P)     (*(P))
+#  define S_TRACE_STORE_RELEASE(P, V) (*(P) = (V))
+#  define S_TRACE_FENCE_ACQUIRE()
+#  define S_TRACE_FENCE_RELEASE()
+#endif
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static variables                                                                 */
+/*                                                                                  */
+/************************************************************************************/
+
+typedef struct
+{
+	double      ts;                       /* microseconds since trace_epoch */
+	const char *category;
+	char        phase;
+	char        name[S_TRACE_NAME_SIZE];
+} s_trace_event;
+
+
+typedef struct s_trace_buffer s_trace_buffer;
+
+struct s_trace_buffer
+{
+	uint32          tid;      /* trace thread id, in order of first span */
+	unsigned long   thread;   /* thread id (s_thread_id) */
+	uint32          count;    /* events written, only by the owning thread (release) */
+	uint32          start;    /* first event after s_trace_clear, guarded by trace_mutex */
+	s_bool          released; /* owning thread has finished, can be reused */
+	s_trace_event   events[S_TRACE_BUFFER_SIZE];
+	s_trace_buffer *next;
+};
+
+
+/* a growing string */
+typedef struct
+{
+	char   *str;
+	size_t  len;
+	size_t  size;
+} s_trace_str;
+
+
+S_API s_bool _s_trace_active = FALSE;
+
+static s_bool trace_enabled = FALSE;
+
+static s_bool trace_initialized = FALSE;
+
+static double trace_epoch = 0.0;
+
+static char *trace_path = NULL;
+
+static uint32 trace_num_buffers = 0;
+
+/* ring buffers of the threads, guarded by trace_mutex */
+static s_trace_buffer *trace_buffers = NULL;
+
+static s_thread_key trace_key;
+
+S_DECLARE_MUTEX_STATIC(trace_mutex);
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static function prototypes                                                       */
+/*                                                                                  */
+/************************************************************************************/
+
+static s_trace_buffer *new_buffer(void);
+
+static s_trace_buffer *claim_buffer(void);
+
+static void release_buffer(void *buffer);
+
+static void trace_str_append(s_trace_str *str, s_erc *error, const char *format, ...);
+
+static void trace_str_append_name(s_trace_str *str, const char *name, s_erc *error);
+
+static void copy_name(char *dest, const char *src);
+
+#if !defined(__GNUC__) && defined(SPCT_MSVC)
+static uint32 trace_load_acquire(const uint32 *p);
+#endif
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Function implementations                                                         */
+/*                                                                                  */
+/************************************************************************************/
+
+S_API void s_trace_enable(s_bool enable)
+{
+	s_erc local_err = S_SUCCESS;
+
+
+	if (enable && !trace_enabled && (trace_epoch == 0.0))
+		trace_epoch = s_time_monotonic(&local_err);
+
+	trace_enabled = enable;
+	_s_trace_active = (trace_enabled && trace_initialized);
+}
+
+
+S_API s_bool s_trace_enabled(void)
+{
+	return trace_enabled;
+}
+
+
+S_API char *s_trace_get_json(s_erc *error)
+{
+	s_trace_str json = { NULL, 0, 0 };
+	const s_trace_buffer *buffer;
+	s_trace_event event;
+	uint32 count;
+	uint32 i;
+	s_bool first = TRUE;
+
+
+	S_CLR_ERR(error);
+
+	trace_str_append(&json, error, "{\"traceEvents\":[");
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "s_trace_get_json",
+				  "Call to \"trace_str_append\" failed"))
+		return NULL;
+
+	if (trace_initialized)
+		s_mutex_lock(&trace_mutex);
+
+	for (buffer = trace_buffers; buffer != NULL; buffer = buffer->next)
+	{
+		trace_str_append(&json, error,
+						 "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%lu,"
+						 "\"args\":{\"name\":\"thread %lu\"}}",
+						 first ? "" : ",", (ulong)buffer->tid, buffer->thread);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "s_trace_get_json",
+					  "Call to \"trace_str_append\" failed"))
+			break;
+
+		first = FALSE;
+
+		/*
+		 * The ring buffer holds the last S_TRACE_BUFFER_SIZE
+		 * events, and the owning thread keeps writing while we
+		 * read. Events are copied out of the buffer and dropped if
+		 * the owner may have started overwriting their slot.
+		 */
+		count = S_TRACE_LOAD_ACQUIRE(&(buffer->count));
+		i = (count > S_TRACE_BUFFER_SIZE) ? count - S_TRACE_BUFFER_SIZE : 0;
+		if (i < buffer->start)
+			i = buffer->start;
+
+		for (/* NOP */; i < count; i++)
+		{
+			memcpy(&event, &(buffer->events[i & (S_TRACE_BUFFER_SIZE - 1)]),
+				   sizeof(s_trace_event));
+
+			S_TRACE_FENCE_ACQUIRE();
+			if (i + S_TRACE_BUFFER_SIZE <= S_TRACE_LOAD_RELAXED(&(buffer->count)))
+				continue;
+
+			trace_str_append(&json, error, ",\n{\"name\":");
+			if (S_CHK_ERR(error, S_CONTERR,
+						  "s_trace_get_json",
+						  "Call to \"trace_str_append\" failed"))
+				break;
+
+			trace_str_append_name(&json, event.name, error);
+			if (S_CHK_ERR(error, S_CONTERR,
+						  "s_trace_get_json",
+						  "Call to \"trace_str_append_name\" failed"))
+				break;
+
+			trace_str_append(&json, error,
+							 ",\"cat\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,\"tid\":%lu}",
+							 event.category, event.phase, event.ts, (ulong)buffer->tid);
+			if (S_CHK_ERR(error, S_CONTERR,
+						  "s_trace_get_json",
+						  "Call to \"trace_str_append\" failed"))
+				break;
+		}
+
+		if (*error != S_SUCCESS)
+			break;
+	}
+
+	if (trace_initialized)
+		s_mutex_unlock(&trace_mutex);
+
+	if (*error == S_SUCCESS)
+	{
+		trace_str_append(&json, error, "\n],\"displayTimeUnit\":\"ms\"}\n");
+		S_CHK_ERR(error, S_CONTERR,
+				  "s_trace_get_json",
+				  "Call to \"trace_str_append\" failed");
+	}
+
+	if (*error != S_SUCCESS)
+	{
+		S_FREE(json.str);
+		return NULL;
+	}
+
+	return json.str;
+}
+
+
+S_API void s_trace_save_json(const char *path, s_erc *error)
+{
+	char *json;
+	FILE *file;
+	int rv;
+
+
+	S_CLR_ERR(error);
+
+	if (path == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "s_trace_save_json",
+				  "Argument \"path\" is NULL");
+		return;
+	}
+
+	json = s_trace_get_json(error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "s_trace_save_json",
+				  "Call to \"s_trace_get_json\" failed"))
+		return;
+
+	file = fopen(path, "w");
+	if (file == NULL)
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "s_trace_save_json",
+				  "Failed to open file \'%s\' for writing", path);
+		S_FREE(json);
+		return;
+	}
+
+	rv = fputs(json, file);
+	S_FREE(json);
+
+	if ((fclose(file) != 0) || (rv == EOF))
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "s_trace_save_json",
+				  "Failed to write file \'%s\'", path);
+	}
+}
+
+
+S_API void s_trace_clear(void)
+{
+	s_trace_buffer *buffer;
+
+
+	if (trace_initialized)
+		s_mutex_lock(&trace_mutex);
+
+	/* only the owning thread writes the count, drop the events before it */
+	for (buffer = trace_buffers; buffer != NULL; buffer = buffer->next)
+		buffer->start = S_TRACE_LOAD_ACQUIRE(&(buffer->count));
+
+	if (trace_initialized)
+		s_mutex_unlock(&trace_mutex);
+}
+
+
+S_API void _s_trace_event(char phase, const char *category, const char *name)
+{
+	s_erc local_err = S_SUCCESS;
+	s_trace_buffer *buffer;
+	s_trace_event *event;
+	uint32 count;
+
+
+	if (!trace_initialized)
+		return;
+
+	buffer = s_thread_key_get(&trace_key);
+	if (buffer == NULL)
+	{
+		buffer = new_buffer();
+		if (buffer == NULL)
+			return;
+	}
+
+	/*
+	 * Only this thread writes to the buffer. The fence orders the
+	 * previous count before the writes to the slot, which a reader
+	 * may be copying.
+	 */
+	count = buffer->count;
+	S_TRACE_FENCE_RELEASE();
+	event = &(buffer->events[count & (S_TRACE_BUFFER_SIZE - 1)]);
+	event->ts = (s_time_monotonic(&local_err) - trace_epoch) * 1.0e6;
+	event->category = category;
+	event->phase = phase;
+	copy_name(event->name, name);
+	S_TRACE_STORE_RELEASE(&(buffer->count), count + 1);
+}
+
+
+S_LOCAL void _s_trace_init(void)
+{
+	s_erc local_err = S_SUCCESS;
+	const char *env;
+
+
+	if (trace_initialized)
+		return;
+
+	s_thread_key_create(&trace_key, release_buffer, &local_err);
+	if (local_err != S_SUCCESS)
+	{
+		S_ERR_PRINT(S_FAILURE, "_s_trace_init",
+					"Failed to create thread key, tracing is not available");
+		return;
+	}
+
+	s_mutex_init(&trace_mutex);
+	trace_initialized = TRUE;
+
+	/* s_getenv is not available before the modules are initialized */
+	env = getenv("SPCT_TRACE");
+	if ((env != NULL) && (env[0] != '\0'))
+	{
+		trace_path = S_MALLOC(char, strlen(env) + 1);
+		if (trace_path != NULL)
+		{
+			strcpy(trace_path, env);
+			s_trace_enable(TRUE);
+		}
+	}
+
+	/* it may have been enabled before initialization */
+	_s_trace_active = trace_enabled;
+}
+
+
+S_LOCAL void _s_trace_quit(void)
+{
+	s_erc local_err = S_SUCCESS;
+	s_trace_buffer *buffer;
+
+
+	if (!trace_initialized)
+		return;
+
+	_s_trace_active = FALSE;
+
+	if (trace_path != NULL)
+	{
+		s_trace_save_json(trace_path, &local_err);
+		if (local_err != S_SUCCESS)
+			S_ERR_PRINT(local_err, "_s_trace_quit",
+						"Failed to write trace file named by SPCT_TRACE");
+
+		S_FREE(trace_path);
+	}
+
+	/* no spans are recorded after the modules have quit */
+	while (trace_buffers != NULL)
+	{
+		buffer = trace_buffers;
+		trace_buffers = buffer->next;
+		S_FREE(buffer);
+	}
+
+	trace_num_buffers = 0;
+	trace_epoch = 0.0;
+	trace_initialized = FALSE;
+	s_thread_key_delete(&trace_key);
+	s_mutex_destroy(&trace_mutex);
+}
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static function implementations                                                  */
+/*                                                                                  */
+/************************************************************************************/
+
+static s_trace_buffer *new_buffer(void)
+{
+	s_erc local_err = S_SUCCESS;
+	s_trace_buffer *buffer;
+
+
+	s_mutex_lock(&trace_mutex);
+	buffer = claim_buffer();
+	s_mutex_unlock(&trace_mutex);
+
+	if (buffer == NULL)
+		return NULL;
+
+	s_thread_key_set(&trace_key, buffer, &local_err);
+	if (local_err != S_SUCCESS)
+	{
+		release_buffer(buffer);
+		return NULL;
+	}
+
+	return buffer;
+}
+
+
+/*
+ * trace mutex must be locked by caller. Reuses the buffer of a
+ * finished thread, or allocates a new one if there are less than
+ * S_TRACE_MAX_BUFFERS.
+ */
+static s_trace_buffer *claim_buffer(void)
+{
+	s_trace_buffer *buffer;
+	uint32 num_buffers = 0;
+
+
+	for (buffer = trace_buffers; buffer != NULL; buffer = buffer->next)
+	{
+		if (buffer->released)
+			break;
+
+		num_buffers++;
+	}
+
+	if (buffer == NULL)
+	{
+		if (num_buffers >= S_TRACE_MAX_BUFFERS)
+			return NULL;
+
+		buffer = S_CALLOC(s_trace_buffer, 1);
+		if (buffer == NULL)
+			return NULL;
+
+		buffer->next = trace_buffers;
+		trace_buffers = buffer;
+	}
+
+	/* the events of the finished thread are dropped */
+	buffer->tid = ++trace_num_buffers;
+	buffer->thread = s_thread_id();
+	buffer->count = 0;
+	buffer->start = 0;
+	buffer->released = FALSE;
+
+	return buffer;
+}
+
+
+/* thread key destructor, the buffer keeps its events until it is reused */
+static void release_buffer(void *buffer)
+{
+	s_mutex_lock(&trace_mutex);
+	((s_trace_buffer*)buffer)->released = TRUE;
+	s_mutex_unlock(&trace_mutex);
+}
+
+
+static void trace_str_append(s_trace_str *str, s_erc *error, const char *format, ...)
+{
+	va_list argp;
+	char *tmp;
+	size_t len;
+
+
+	S_CLR_ERR(error);
+
+	va_start(argp, format);
+	s_vasprintf(&tmp, format, argp, error);
+	va_end(argp);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "trace_str_append",
+				  "Call to \"s_vasprintf\" failed"))
+		return;
+
+	len = strlen(tmp);
+	if (str->len + len + 1 > str->size)
+	{
+		char *new_str;
+		size_t new_size = (str->size == 0) ? 4096 : str->size;
+
+
+		while (str->len + len + 1 > new_size)
+			new_size *= 2;
+
+		new_str = S_REALLOC(str->str, char, new_size);
+		if (new_str == NULL)
+		{
+			S_FTL_ERR(error, S_MEMERROR,
+					  "trace_str_append",
+					  "Failed to allocate memory for trace");
+			str->str = NULL;
+			S_FREE(tmp);
+			return;
+		}
+
+		str->str = new_str;
+		str->size = new_size;
+	}
+
+	memcpy(str->str + str->len, tmp, len + 1);
+	str->len += len;
+	S_FREE(tmp);
+}
+
+
+/*
+ * append a span name as a JSON string, at most S_TRACE_NAME_SIZE - 1
+ * characters are read as the name may have been torn by a concurrent
+ * writer
+ */
+static void trace_str_append_name(s_trace_str *str, const char *name, s_erc *error)
+{
+	char escaped[(S_TRACE_NAME_SIZE * 6) + 3];
+	const char *c;
+	size_t i = 0;
+
+
+	S_CLR_ERR(error);
+
+	escaped[i++] = '\"';
+	for (c = name; (c < name + S_TRACE_NAME_SIZE - 1) && (*c != '\0'); c++)
+	{
+		if ((*c == '\"') || (*c == '\\'))
+		{
+			escaped[i++] = '\\';
+			escaped[i++] = *c;
+		}
+		else if ((unsigned char)*c < 0x20)
+		{
+			sprintf(escaped + i, "\\u%04x", (unsigned int)(unsigned char)*c);
+			i += 6;
+		}
+		else
+		{
+			escaped[i++] = *c;
+		}
+	}
+	escaped[i++] = '\"';
+	escaped[i] = '\0';
+
+	trace_str_append(str, error, "%s", escaped);
+	S_CHK_ERR(error, S_CONTERR,
+			  "trace_str_append_name",
+			  "Call to \"trace_str_append\" failed");
+}
+
+
+/* copy a span name, truncated on a UTF-8 character boundary */
+static void copy_name(char *dest, const char *src)
+{
+	size_t len = 0;
+
+
+	if (src != NULL)
+	{
+		while ((len < S_TRACE_NAME_SIZE - 1) && (src[len] != '\0'))
+			len++;
+
+		/* do not cut a multi-byte character */
+		if ((len == S_TRACE_NAME_SIZE - 1) && (src[len] != '\0'))
+		{
+			while ((len > 0) && (((unsigned char)src[len] & 0xC0) == 0x80))
+				len--;
+		}
+
+		memcpy(dest, src, len);
+	}
+
+	dest[len] = '\0';
+}
+
+
+#if !defined(__GNUC__) && defined(SPCT_MSVC)
+static uint32 trace_load_acquire(const uint32 *p)
+{
+	uint32 v = *(volatile const uint32*)p;
+
+
+	MemoryBarrier();
+	return v;
+}
+#endif
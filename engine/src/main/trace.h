@@ -0,0 +1,256 @@
+/************************************************************************************/
+/* Copyright (c) 2008-2011 The Department of Arts and Culture,                      */
+/* The Government of the Republic of South Africa.                                  */
+/*                                                                                  */
+/* Contributors:  Meraka Institute, CSIR, South Africa.                             */
+/*                                                                                  */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy     */
+/* of this software and associated documentation files (the "Software"), to deal    */
+/* in the Software without restriction, including without limitation the rights     */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        */
+/* copies of the Software, and to permit persons to whom the Software is            */
+/* furnished to do so, subject to the following conditions:                         */
+/* The above copyright notice and this permission notice shall be included in       */
+/* all copies or substantial portions of the Software.                              */
+/*                                                                                  */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN        */
+/* THE SOFTWARE.                                                                    */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* AUTHOR  : Speect contributors                                                    */
+/* DATE    : 19 October 2026                                                        */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* Tracing of synthesis spans, exported as Chrome trace-event JSON.                 */
+/*                                                                                  */
+/*                                                                                  */
+/************************************************************************************/
+
+#ifndef _SPCT_MAIN_TRACE_H__
+#define _SPCT_MAIN_TRACE_H__
+
+
+/**
+ * @file trace.h
+ * Tracing of synthesis spans.
+ */
+
+
+/**
+ * @ingroup Speect
+ * @defgroup STrace Tracing
+ * Record the begin and end of spans, such as the utterance processors
+ * and feature processors run by synthesis, the loading of voice data
+ * and of plug-ins, and dump them as Chrome trace-event JSON that can
+ * be viewed with @c chrome://tracing or Perfetto (https://ui.perfetto.dev).
+ *
+ * Every thread records its spans in its own ring buffer, without
+ * locking. A ring buffer keeps the last #S_TRACE_BUFFER_SIZE events of
+ * its thread, older events are overwritten. The buffer of a thread
+ * that has finished keeps its events until the buffer is reused by a
+ * new thread. At most #S_TRACE_MAX_BUFFERS buffers are allocated, the
+ * spans of threads that start while all of them are in use are not
+ * recorded.
+ *
+ * Tracing is off by default and costs a single branch per span when
+ * off. It is switched on by calling #s_trace_enable, or by setting the
+ * @c SPCT_TRACE environment variable to the name of a file before
+ * #speect_init is called. In the latter case the trace is written to
+ * the file by #speect_quit.
+ * @{
+ */
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Modules used                                                                     */
+/*                                                                                  */
+/************************************************************************************/
+
+#include "include/common.h"
+#include "base/utils/types.h"
+#include "base/errdbg/errdbg.h"
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Begin external c declaration                                                     */
+/*                                                                                  */
+/************************************************************************************/
+S_BEGIN_C_DECLS
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Defines                                                                          */
+/*                                                                                  */
+/************************************************************************************/
+
+/**
+ * The number of events of a thread's ring buffer, a power of 2.
+ */
+#define S_TRACE_BUFFER_SIZE 4096
+
+
+/**
+ * The maximum number of ring buffers, and so of threads that are
+ * traced at the same time.
+ */
+#define S_TRACE_MAX_BUFFERS 64
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Macros                                                                           */
+/*                                                                                  */
+/************************************************************************************/
+
+/**
+ * Begin a span of the calling thread. Does nothing if tracing is
+ * disabled.
+ * @hideinitializer
+ *
+ * @param CATEGORY The span category, must be a static string.
+ * @param NAME The span name, copied (and truncated to 63 bytes).
+ */
+#define S_TRACE_BEGIN(CATEGORY, NAME)						\
+	do {													\
+		if (_s_trace_active)								\
+			_s_trace_event('B', CATEGORY, NAME);			\
+	} while (0)
+
+
+/**
+ * End a span of the calling thread, begun with #S_TRACE_BEGIN. Does
+ * nothing if tracing is disabled.
+ * @hideinitializer
+ *
+ * @param CATEGORY The span category, must be a static string.
+ * @param NAME The span name, copied (and truncated to 63 bytes).
+ */
+#define S_TRACE_END(CATEGORY, NAME)							\
+	do {													\
+		if (_s_trace_active)								\
+			_s_trace_event('E', CATEGORY, NAME);			\
+	} while (0)
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Variables                                                                        */
+/*                                                                                  */
+/************************************************************************************/
+
+/**
+ * If spans are being recorded, tested by #S_TRACE_BEGIN and
+ * #S_TRACE_END.
+ * @private
+ */
+extern S_API s_bool _s_trace_active;
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Function prototypes                                                              */
+/*                                                                                  */
+/************************************************************************************/
+
+/**
+ * Enable or disable tracing. May be called before #speect_init.
+ *
+ * @param enable If #TRUE then spans are recorded.
+ */
+S_API void s_trace_enable(s_bool enable);
+
+
+/**
+ * Query whether tracing is enabled.
+ *
+ * @return #TRUE if spans are being recorded.
+ */
+S_API s_bool s_trace_enabled(void);
+
+
+/**
+ * Get the recorded spans as Chrome trace-event JSON, in the JSON
+ * object format (<tt>{"traceEvents" : [ ... ]}</tt>). Timestamps are
+ * in microseconds since tracing was first enabled.
+ *
+ * @param error Error code.
+ *
+ * @return The trace.
+ *
+ * @note Caller is responsible for the returned memory.
+ * @note Spans recorded while the trace is read may be partially
+ * written, read the trace when no synthesis is running for an exact
+ * trace.
+ */
+S_API char *s_trace_get_json(s_erc *error);
+
+
+/**
+ * Write the recorded spans as Chrome trace-event JSON to a file, see
+ * #s_trace_get_json.
+ *
+ * @param path The file name.
+ * @param error Error code.
+ */
+S_API void s_trace_save_json(const char *path, s_erc *error);
+
+
+/**
+ * Clear the recorded spans. Spans that are recorded by other threads
+ * while the trace is being cleared may be kept or dropped.
+ */
+S_API void s_trace_clear(void);
+
+
+/**
+ * Record an event of a span of the calling thread. Use
+ * #S_TRACE_BEGIN and #S_TRACE_END.
+ * @private
+ *
+ * @param phase The event phase, @c 'B' (begin) or @c 'E' (end).
+ * @param category The span category, must be a static string.
+ * @param name The span name.
+ */
+S_API void _s_trace_event(char phase, const char *category, const char *name);
+
+
+/**
+ * Initialize the tracing module. Reads the @c SPCT_TRACE environment
+ * variable.
+ * @private
+ */
+S_LOCAL void _s_trace_init(void);
+
+
+/**
+ * Quit the tracing module, writing the trace to the file named by the
+ * @c SPCT_TRACE environment variable, and freeing the ring buffers.
+ * @private
+ */
+S_LOCAL void _s_trace_quit(void);
+
+
+/**
+ * @}
+ */
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* End external c declaration                                                       */
+/*                                                                                  */
+/************************************************************************************/
+S_END_C_DECLS
+
+
+#endif /* _SPCT_MAIN_TRACE_H__ */
@@ -43,6 +43,8 @@
 
 #include "base/utils/alloc.h"
 #include "base/strings/strings.h"
+#include "main/profile.h"
+#include "pluginmanager/static_plugins.h"
 #include "pluginmanager/manager.h"
 #include "pluginmanager/library.h"
 
@@ -92,6 +94,15 @@
 static SLibraryClass LibraryClass; /* Library class declaration. */
 
 
+/************************************************************************************/
+/*                                                                                  */
+/* Static function prototypes                                                       */
+/*                                                                                  */
+/************************************************************************************/
+
+static s_plugin_init_fp load_dso(const char *path, SDso **libraryDso, s_erc *error);
+
+
 /************************************************************************************/
 /*                                                                                  */
 /* Function implementations                                                         */
@@ -169,6 +180,7 @@ static void InitLibrary(void *obj, s_erc *error)
 	self->in_pluginmanager = FALSE;
 	self->ready = FALSE;              /* set and queried by plug-in
 										 object */
+	self->is_static = FALSE;
 	s_mutex_init(&(self->library_mutex));
 }
 
@@ -183,7 +195,7 @@ static void DestroyLibrary(void *obj, s_erc *error)
 	S_CLR_ERR(error);
 	s_mutex_lock(&(self->library_mutex));
 
-	if (self->dso != NULL)
+	if ((self->dso != NULL) || self->is_static)
 	{
 		exit_function = self->plugin_info->at_exit;
 
@@ -195,7 +207,8 @@ static void DestroyLibrary(void *obj, s_erc *error)
 					  "Plugin dso at_exit function reported error");
 		}
 
-		S_DELETE(self->dso, "DestroyLibrary", error);
+		if (self->dso != NULL)
+			S_DELETE(self->dso, "DestroyLibrary", error);
 	}
 
 	if (self->path != NULL)
@@ -204,6 +217,7 @@ static void DestroyLibrary(void *obj, s_erc *error)
 	self->plugin_info = NULL;
 	self->in_pluginmanager = FALSE;
 	self->ready = FALSE;
+	self->is_static = FALSE;
 
 	if ((local_err != S_SUCCESS) && (*error == S_SUCCESS))
 		*error = local_err;
@@ -222,61 +236,99 @@ static void DisposeLibrary(void *obj, s_erc *error)
 
 
 /* name change because of clash in Windows */
-static void LoadLib(SLibrary *self, const char *path, s_erc *error)
+static s_plugin_init_fp load_dso(const char *path, SDso **libraryDso, s_erc *error)
 {
-	SDso *libraryDso;
+	SDso *dso;
 	s_plugin_init_fp plugin_initialize;
+	s_profile_mark mark;
 
 
 	S_CLR_ERR(error);
 
-	/* path gets freed when SLibrary is deleted */
-	self->path = s_strdup(path, error);
-	if (S_CHK_ERR(error, S_CONTERR,
-				  "LoadLib",
-				  "Call to \"s_strdup\" failed"))
-		return;
-
-	libraryDso = S_NEW(SDso, error);
+	dso = S_NEW(SDso, error);
 	if (S_CHK_ERR(error, S_CONTERR,
-				  "LoadLib",
+				  "load_dso",
 				  "Failed to create new dynamic shared object for Library"))
-		return;
+		return NULL;
 
-	SDsoLoad(libraryDso, path, error);
+	_s_profile_begin(&mark);
+	SDsoLoad(dso, path, error);
+	_s_profile_end(&mark, "plug-in", "dlopen '%s'", path);
 	if (S_CHK_ERR(error, S_CONTERR,
-				  "LoadLib",
+				  "load_dso",
 				  "Failed to load plug-in dynamic shared object at \"%s\"",
 				  path))
 	{
-		S_DELETE(libraryDso, "LoadLib", error);
-		return;
+		S_DELETE(dso, "load_dso", error);
+		return NULL;
 	}
 
 	/*
 	 * get the plugin initialization function
 	 * done as described in dlsym man page.
 	 */
-	plugin_initialize = (s_plugin_init_fp)SDsoGetSymbol(libraryDso, "s_plugin_init", error);
+	plugin_initialize = (s_plugin_init_fp)SDsoGetSymbol(dso, "s_plugin_init", error);
 	if (S_CHK_ERR(error, S_CONTERR,
-				  "LoadLib",
+				  "load_dso",
 				  "Failed to get \'s_plugin_init\' symbol from plug-in at \"%s\"",
 				  path))
 	{
-		S_DELETE(libraryDso, "LoadLib", error);
-		return;
+		S_DELETE(dso, "load_dso", error);
+		return NULL;
 	}
 
 	if (plugin_initialize == NULL)
 	{
 		S_CTX_ERR(error, S_FAILURE,
-				  "LoadLib",
+				  "load_dso",
 				  "Plug-in symbol \'s_plugin_init\' is NULL for plug-in at \"%s\"",
 				  path);
-		S_DELETE(libraryDso, "LoadLib", error);
+		S_DELETE(dso, "load_dso", error);
+		return NULL;
+	}
+
+	*libraryDso = dso;
+	return plugin_initialize;
+}
+
+
+static void LoadLib(SLibrary *self, const char *path, s_erc *error)
+{
+	SDso *libraryDso = NULL;
+	s_plugin_init_fp plugin_initialize;
+	s_profile_mark mark;
+
+
+	S_CLR_ERR(error);
+
+	/* path gets freed when SLibrary is deleted */
+	self->path = s_strdup(path, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "LoadLib",
+				  "Call to \"s_strdup\" failed"))
 		return;
+
+	/*
+	 * plug-ins that are statically linked into the engine are
+	 * resolved by name, otherwise load the dynamic shared object.
+	 */
+	plugin_initialize = _s_pm_get_static_plugin(path, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "LoadLib",
+				  "Call to \"_s_pm_get_static_plugin\" failed"))
+		return;
+
+	if (plugin_initialize == NULL)
+	{
+		plugin_initialize = load_dso(path, &libraryDso, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "LoadLib",
+					  "Call to \"load_dso\" failed"))
+			return;
 	}
 
+	_s_profile_begin(&mark);
+
 	/* run the plug-in initialization function */
 	self->plugin_info = (plugin_initialize)(error);
 	if (S_CHK_ERR(error, S_CONTERR,
@@ -287,6 +339,9 @@ static void LoadLib(SLibrary *self, const char *path, s_erc *error)
 		return;
 	}
 
+	_s_profile_end(&mark, "plug-in", "initialize '%s'",
+				   self->plugin_info->name);
+
 	/* check version compatibility */
 	if (!s_version_ok(self->plugin_info->s_abi))
 	{
@@ -302,7 +357,10 @@ static void LoadLib(SLibrary *self, const char *path, s_erc *error)
 	/* call plug-in register function */
 	if (self->plugin_info->reg_func != NULL)
 	{
+		_s_profile_begin(&mark);
 		self->plugin_info->reg_func(error);
+		_s_profile_end(&mark, "plug-in", "register '%s'",
+					   self->plugin_info->name);
 		if (S_CHK_ERR(error, S_CONTERR,
 					  "LoadLib",
 					  "Plug-in at \"%s\" failed to register",
@@ -314,6 +372,7 @@ static void LoadLib(SLibrary *self, const char *path, s_erc *error)
 	}
 
 	self->dso = libraryDso;
+	self->is_static = (libraryDso == NULL);
 }
 
 
@@ -144,6 +144,12 @@ typedef struct
 	 */
 	s_bool                 ready;
 
+	/**
+	 * @private Library is statically linked into the Speect Engine
+	 * (no dynamic shared object).
+	 */
+	s_bool                 is_static;
+
 	/**
 	 * @protected Locking mutex
 	 */
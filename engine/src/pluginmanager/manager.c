@@ -47,6 +47,8 @@
 #include "base/utils/vernum.h"
 #include "containers/containers.h"
 #include "serialization/json/json_parse_config.h"
+#include "main/profile.h"
+#include "main/trace.h"
 #include "pluginmanager/manager.h"
 
 
@@ -98,6 +100,7 @@ S_API SPlugin *s_pm_load_plugin(const char *path, s_erc *error)
 	SPlugin *plugin;
 	SLibrary *loaded;
 	char *new_path;
+	s_profile_mark mark;
 
 
 	S_CLR_ERR(error);
@@ -205,7 +208,11 @@ S_API SPlugin *s_pm_load_plugin(const char *path, s_erc *error)
 	s_mutex_unlock(&pm_mutex);
 
 	/* load library */
+	_s_profile_begin(&mark);
+	S_TRACE_BEGIN("plug-in", path);
 	SLibraryLoad(loaded, new_path, error);
+	S_TRACE_END("plug-in", path);
+	_s_profile_end(&mark, "plug-in", "load '%s'", path);
 	if (S_CHK_ERR(error, S_CONTERR,
 				  "s_pm_load_plugin",
 				  "Failed to load libraery at \'%s\'", new_path))
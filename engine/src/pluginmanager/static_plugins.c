@@ -0,0 +1,84 @@
+/************************************************************************************/
+/* Copyright (c) 2008-2011 The Department of Arts and Culture,                      */
+/* The Government of the Republic of South Africa.                                  */
+/*                                                                                  */
+/* Contributors:  Meraka Institute, CSIR, South Africa.                             */
+/*                                                                                  */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy     */
+/* of this software and associated documentation files (the "Software"), to deal    */
+/* in the Software without restriction, including without limitation the rights     */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        */
+/* copies of the Software, and to permit persons to whom the Software is            */
+/* furnished to do so, subject to the following conditions:                         */
+/* The above copyright notice and this permission notice shall be included in       */
+/* all copies or substantial portions of the Software.                              */
+/*                                                                                  */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN        */
+/* THE SOFTWARE.                                                                    */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* AUTHOR  : Speect contributors                                                    */
+/* DATE    : 19 October 2026                                                        */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* Table of plug-ins that are statically linked into the Speect Engine              */
+/* library.                                                                         */
+/*                                                                                  */
+/*                                                                                  */
+/************************************************************************************/
+
+/************************************************************************************/
+/*                                                                                  */
+/* Modules used                                                                     */
+/*                                                                                  */
+/************************************************************************************/
+
+#include "base/strings/strings.h"
+#include "pluginmanager/static_plugins_table.h"
+#include "pluginmanager/static_plugins.h"
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Function implementations                                                         */
+/*                                                                                  */
+/************************************************************************************/
+
+S_LOCAL s_plugin_init_fp _s_pm_get_static_plugin(const char *path, s_erc *error)
+{
+	const s_static_plugin *entry;
+	const char *name;
+	const char *ps;
+
+
+	S_CLR_ERR(error);
+
+	if ((path == NULL) || (static_plugins[0].name == NULL))
+		return NULL;
+
+	/* file name of the path */
+	name = path;
+	ps = s_strrchr(path, S_PATH_SEP, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "_s_pm_get_static_plugin",
+				  "Call to \"s_strrchr\" failed"))
+		return NULL;
+
+	if (ps != NULL)
+		name = ps + 1;
+
+	for (entry = static_plugins; entry->name != NULL; entry++)
+	{
+		if (s_strcmp(name, entry->name, error) == 0)
+			return entry->init;
+	}
+
+	return NULL;
+}
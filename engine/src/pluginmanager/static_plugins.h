@@ -0,0 +1,135 @@
+/************************************************************************************/
+/* Copyright (c) 2008-2011 The Department of Arts and Culture,                      */
+/* The Government of the Republic of South Africa.                                  */
+/*                                                                                  */
+/* Contributors:  Meraka Institute, CSIR, South Africa.                             */
+/*                                                                                  */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy     */
+/* of this software and associated documentation files (the "Software"), to deal    */
+/* in the Software without restriction, including without limitation the rights     */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        */
+/* copies of the Software, and to permit persons to whom the Software is            */
+/* furnished to do so, subject to the following conditions:                         */
+/* The above copyright notice and this permission notice shall be included in       */
+/* all copies or substantial portions of the Software.                              */
+/*                                                                                  */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN        */
+/* THE SOFTWARE.                                                                    */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* AUTHOR  : Speect contributors                                                    */
+/* DATE    : 19 October 2026                                                        */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* Table of plug-ins that are statically linked into the Speect Engine              */
+/* library.                                                                         */
+/*                                                                                  */
+/*                                                                                  */
+/************************************************************************************/
+
+#ifndef _SPCT_PLUGINMANAGER_STATIC_PLUGINS_H__
+#define _SPCT_PLUGINMANAGER_STATIC_PLUGINS_H__
+
+
+/**
+ * @file static_plugins.h
+ * Statically linked plug-ins.
+ */
+
+
+/**
+ * @ingroup SPluginManager
+ * @defgroup SStaticPlugins Statically Linked Plug-ins
+ * Plug-ins that are selected with the @c STATIC_PLUGINS CMake option
+ * are compiled into the Speect Engine library instead of into their
+ * own dynamic shared objects. Their @c s_plugin_init functions are
+ * registered in a compile-time table and #s_pm_load_plugin resolves
+ * them by file name (for example @c "audio.spi"), without going
+ * through the dynamic loader.
+ * @{
+ */
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Modules used                                                                     */
+/*                                                                                  */
+/************************************************************************************/
+
+#include "include/common.h"
+#include "base/errdbg/errdbg.h"
+#include "pluginmanager/plugin.h"
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Begin external c declaration                                                     */
+/*                                                                                  */
+/************************************************************************************/
+S_BEGIN_C_DECLS
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Typedefs                                                                         */
+/*                                                                                  */
+/************************************************************************************/
+
+/**
+ * A statically linked plug-in table entry.
+ */
+typedef struct
+{
+	/**
+	 * Plug-in file name, for example @c "audio.spi".
+	 */
+	const char       *name;
+
+	/**
+	 * Plug-in initialization function.
+	 */
+	s_plugin_init_fp  init;
+} s_static_plugin;
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Function prototypes                                                              */
+/*                                                                                  */
+/************************************************************************************/
+
+/**
+ * Get the initialization function of the statically linked plug-in
+ * with the given path. Only the file name of the path is used.
+ * @private
+ *
+ * @param path The plug-in path.
+ * @param error Error code.
+ *
+ * @return The plug-in initialization function, or @c NULL if the
+ * plug-in is not statically linked.
+ */
+S_LOCAL s_plugin_init_fp _s_pm_get_static_plugin(const char *path, s_erc *error);
+
+
+/**
+ * @}
+ */
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* End external c declaration                                                       */
+/*                                                                                  */
+/************************************************************************************/
+S_END_C_DECLS
+
+
+#endif /* _SPCT_PLUGINMANAGER_STATIC_PLUGINS_H__ */
@@ -152,8 +152,6 @@ static s_json_callbacks callbacks;
 S_API SMap *s_json_parse_config_file(const char *path, s_erc *error)
 {
 	SDatasource *ds;
-	s_json_context *context;
-	SJSONParser *JSON;
 	SMap *retVal;
 
 
@@ -164,34 +162,61 @@ S_API SMap *s_json_parse_config_file(const char *path, s_erc *error)
 				  "Failed to could not open data source file \"%s\" for reading", path))
 		return NULL;
 
+	retVal = s_json_parse_config_datasource(ds, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "s_json_parse_config_file",
+				  "Failed to parse JSON file, \"%s\"", path))
+		return NULL;
+
+	return retVal;
+}
+
+
+S_API SMap *s_json_parse_config_datasource(SDatasource *ds, s_erc *error)
+{
+	s_json_context *context;
+	SJSONParser *JSON;
+	SMap *retVal;
+
+
+	S_CLR_ERR(error);
+
+	if (ds == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "s_json_parse_config_datasource",
+				  "Argument \"ds\" is NULL");
+		return NULL;
+	}
+
 
 	context = S_MALLOC(s_json_context, 1);
 	if (context == NULL)
 	{
-		S_DELETE(ds, "s_json_parse_config_file", error);
+		S_DELETE(ds, "s_json_parse_config_datasource", error);
 		S_FTL_ERR(error, S_MEMERROR,
-				  "s_json_parse_config_file",
+				  "s_json_parse_config_datasource",
 				  "Failed to allocate memory for context structure");
 		return NULL;
 	}
 
 	context->containers = S_LIST(S_NEW(SListList, error));
 	if (S_CHK_ERR(error, S_FAILURE,
-				  "s_json_parse_config_file",
+				  "s_json_parse_config_datasource",
 				  "Failed to create 'SListList' object"))
 	{
-		S_DELETE(ds, "s_json_parse_config_file", error);
+		S_DELETE(ds, "s_json_parse_config_datasource", error);
 		S_FREE(context);
 		return NULL;
 	}
 
 	context->keys = S_LIST(S_NEW(SListList, error));
 	if (S_CHK_ERR(error, S_FAILURE,
-				  "s_json_parse_config_file",
+				  "s_json_parse_config_datasource",
 				  "Failed to create 'SListList' object"))
 	{
-		S_DELETE(ds, "s_json_parse_config_file", error);
-		S_DELETE(context->containers, "s_json_parse_config_file", error);
+		S_DELETE(ds, "s_json_parse_config_datasource", error);
+		S_DELETE(context->containers, "s_json_parse_config_datasource", error);
 		S_FREE(context);
 		return NULL;
 	}
@@ -200,54 +225,54 @@ S_API SMap *s_json_parse_config_file(const char *path, s_erc *error)
 
 	JSON = S_NEW(SJSONParser, error);
 	if (S_CHK_ERR(error, S_FAILURE,
-				  "s_json_parse_config_file",
+				  "s_json_parse_config_datasource",
 				  "Failed to create json object"))
 	{
-		S_DELETE(ds, "s_json_parse_config_file", error);
-		S_DELETE(context->containers, "s_json_parse_config_file", error);
-		S_DELETE(context->keys, "s_json_parse_config_file", error);
+		S_DELETE(ds, "s_json_parse_config_datasource", error);
+		S_DELETE(context->containers, "s_json_parse_config_datasource", error);
+		S_DELETE(context->keys, "s_json_parse_config_datasource", error);
 		S_FREE(context);
 		return NULL;
 	}
 
 	SJSONParserInit(&JSON, ds, TRUE, TRUE, &callbacks, (void*)context, error);
 	if (S_CHK_ERR(error, S_FAILURE,
-				  "s_json_parse_config_file",
+				  "s_json_parse_config_datasource",
 				  "Failed to initialize json object"))
 	{
-		S_DELETE(ds, "s_json_parse_config_file", error);
-		S_DELETE(context->containers, "s_json_parse_config_file", error);
-		S_DELETE(context->keys, "s_json_parse_config_file", error);
+		S_DELETE(ds, "s_json_parse_config_datasource", error);
+		S_DELETE(context->containers, "s_json_parse_config_datasource", error);
+		S_DELETE(context->keys, "s_json_parse_config_datasource", error);
 		S_FREE(context);
 		return NULL;
 	}
 
 	SJSONParserParse(JSON, error);
 	if (S_CHK_ERR(error, S_CONTERR,
-				  "s_json_parse_config_file",
-				  "Failed to parse JSON file, \"%s\"", path))
+				  "s_json_parse_config_datasource",
+				  "Failed to parse JSON data source"))
 	{
-		S_DELETE(context->containers, "s_json_parse_config_file", error);
-		S_DELETE(context->keys, "s_json_parse_config_file", error);
-		S_DELETE(JSON, "s_json_parse_config_file", error);
+		S_DELETE(context->containers, "s_json_parse_config_datasource", error);
+		S_DELETE(context->keys, "s_json_parse_config_datasource", error);
+		S_DELETE(JSON, "s_json_parse_config_datasource", error);
 
 		if (context->final != NULL)
-			S_DELETE(context->final, "s_json_parse_config_file", error);
+			S_DELETE(context->final, "s_json_parse_config_datasource", error);
 
 		S_FREE(context);
 		return NULL;
 	}
 
 
-	S_DELETE(JSON, "s_json_parse_config_file", error);
+	S_DELETE(JSON, "s_json_parse_config_datasource", error);
 
 	retVal = S_CAST(context->final, SMap, error);
-	if (S_CHK_ERR(error, S_CONTERR, "s_json_parse_config_file",
+	if (S_CHK_ERR(error, S_CONTERR, "s_json_parse_config_datasource",
 				  "Failed to cast return value to SMap"))
 		retVal = NULL;
 
-	S_DELETE(context->containers, "s_json_parse_config_file", error);
-	S_DELETE(context->keys, "s_json_parse_config_file", error);
+	S_DELETE(context->containers, "s_json_parse_config_datasource", error);
+	S_DELETE(context->keys, "s_json_parse_config_datasource", error);
 	S_FREE(context);
 
 	return retVal;
@@ -91,6 +91,7 @@
 #include "include/common.h"
 #include "base/errdbg/errdbg.h"
 #include "containers/map/map.h"
+#include "datasources/data_source.h"
 
 
 /************************************************************************************/
@@ -123,6 +124,24 @@ S_BEGIN_C_DECLS
 S_API SMap *s_json_parse_config_file(const char *path, s_erc *error);
 
 
+/**
+ * Parse a JavaScript Object Notation (JSON) format configuration from
+ * the given data source, and return the information in a map
+ * structure.
+ *
+ * @param ds The data source to parse. The function takes hold of the
+ * data source, it is deleted when parsing is done (also on errors).
+ * @param error Error Code.
+ *
+ * @return A map data structure containing the information of the
+ * configuration.
+ *
+ * @ingroup SJSON
+ * @relates SJSONParser
+ */
+S_API SMap *s_json_parse_config_datasource(SDatasource *ds, s_erc *error);
+
+
 /************************************************************************************/
 /*                                                                                  */
 /* End external c declaration                                                       */
@@ -490,6 +490,52 @@ S_API SObject *SObjectLoad(const char *path, const char *format, s_erc *error)
 }
 
 
+S_API SObject *SObjectLoadFromDatasource(SDatasource *ds, const char *format,
+										 s_erc *error)
+{
+	const SSerializedFile *serializedFile;
+	SObject *loadedObject;
+
+
+	S_CLR_ERR(error);
+
+	if (ds == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SObjectLoadFromDatasource",
+				  "Argument \"ds\" is NULL");
+		return NULL;
+	}
+
+	if (format == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SObjectLoadFromDatasource",
+				  "Argument \"format\" is NULL");
+		S_DELETE(ds, "SObjectLoadFromDatasource", error);
+		return NULL;
+	}
+
+	/* get the serializedFileClass object */
+	serializedFile = get_file_object(format, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SObjectLoadFromDatasource",
+				  "Call to \"get_file_object\" failed"))
+	{
+		S_DELETE(ds, "SObjectLoadFromDatasource", error);
+		return NULL;
+	}
+
+	loadedObject = SSerializedFileLoadFromDatasource(serializedFile, ds, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SObjectLoadFromDatasource",
+				  "Call to \"SSerializedFileLoadFromDatasource\" failed"))
+		return NULL;
+
+	return loadedObject;
+}
+
+
 /************************************************************************************/
 /*                                                                                  */
 /* Module init and quit                                                             */
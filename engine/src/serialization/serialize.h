@@ -215,6 +215,24 @@ S_API SObject *SObjectLoad(const char *path, const char *format,
 						   s_erc *error);
 
 
+/**
+ * Load data of an object in the given format from the given data
+ * source. The format's serialized file class must implement the
+ * @c load_from_datasource method.
+ * @public @memberof SObject
+ *
+ * @param ds The data source to read the object from. The function
+ * takes hold of the data source, it is deleted when reading is done
+ * (also on errors).
+ * @param format The format of the object data.
+ * @param error Error code.
+ *
+ * @return The loaded object.
+ */
+S_API SObject *SObjectLoadFromDatasource(SDatasource *ds, const char *format,
+										 s_erc *error);
+
+
 /**
  * Initialize the serialize module resources.
  * @private
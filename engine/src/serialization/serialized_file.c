@@ -233,6 +233,51 @@ S_LOCAL void SSerializedFileSaveToDatasource(const SSerializedFile *self, const
 }
 
 
+S_LOCAL SObject *SSerializedFileLoadFromDatasource(const SSerializedFile *self,
+												   SDatasource *ds, s_erc *error)
+{
+	SObject *loadedObject;
+
+
+	S_CLR_ERR(error);
+
+	if (ds == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SSerializedFileLoadFromDatasource",
+				  "Argument \"ds\" is NULL");
+		return NULL;
+	}
+
+	if (self == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SSerializedFileLoadFromDatasource",
+				  "Argument \"self\" is NULL");
+		S_DELETE(ds, "SSerializedFileLoadFromDatasource", error);
+		return NULL;
+	}
+
+	if (!S_SERIALIZED_FILE_METH_VALID(self, load_from_datasource))
+	{
+		S_CTX_ERR(error, S_METHINVLD,
+				  "SSerializedFileLoadFromDatasource",
+				  "Serialized file method \"load_from_datasource\" not implemented for format '%s'",
+				  S_SERIALIZED_FILE_CALL(self, format));
+		S_DELETE(ds, "SSerializedFileLoadFromDatasource", error);
+		return NULL;
+	}
+
+	loadedObject = S_SERIALIZED_FILE_CALL(self, load_from_datasource)(ds, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SSerializedFileLoadFromDatasource",
+				  "Class file method \"load_from_datasource\" failed"))
+		return NULL;
+
+	return loadedObject;
+}
+
+
 /************************************************************************************/
 /*                                                                                  */
 /* Class registration                                                               */
@@ -283,8 +328,9 @@ static SSerializedFileClass SerializedFileClass =
 		NULL,                  /* copy    */
 	},
 	/* SSerializedFileClass */
-	NULL,                      /* format             */
-	NULL,                      /* load               */
-	NULL,                      /* save               */
-	NULL                       /* save_to_datasource */
+	NULL,                      /* format               */
+	NULL,                      /* load                 */
+	NULL,                      /* save                 */
+	NULL,                      /* save_to_datasource   */
+	NULL                       /* load_from_datasource */
 };
@@ -151,6 +151,19 @@ typedef struct
 	void      (* const save_to_datasource) (const SObject *object, SDatasource* ds,
                                             s_erc *error);
 
+	/**
+	 * @protected LoadFromDatasource function pointer.
+	 * Load data of an object from the given datasource.
+	 *
+	 * @param ds The datasource from which data will be read. The
+	 * function takes hold of the datasource, it is deleted when
+	 * reading is done (also on errors).
+	 * @param error Error code.
+	 *
+	 * @return The loaded object.
+	 */
+	SObject *(* const load_from_datasource) (SDatasource *ds, s_erc *error);
+
 } SSerializedFileClass;
 
 
@@ -202,6 +215,21 @@ S_LOCAL void SSerializedFileSaveToDatasource(const SSerializedFile *self, const
 								 SDatasource* ds, s_erc *error);
 
 
+/**
+ * Load an object from a data source. This is just a wrapper function
+ * for the class method and used internally by #SObjectLoadFromDatasource
+ *
+ * @private
+ * @param self The SSerializedFile handler.
+ * @param ds The datasource from which data will be read, taken hold of.
+ * @param error Error code.
+ *
+ * @return The loaded object.
+ */
+S_LOCAL SObject *SSerializedFileLoadFromDatasource(const SSerializedFile *self,
+												   SDatasource *ds, s_erc *error);
+
+
 /**
  * Add the SSerializedFile class to the object system.
  * @private
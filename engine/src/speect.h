@@ -66,6 +66,8 @@
 #include "voicemanager/voicemanager.h"
 #include "utils/utils.h"
 #include "main/main.h"
+#include "main/profile.h"
+#include "main/trace.h"
 
 
 #endif /* _SPCT_SPEECT_H__ */
@@ -150,6 +150,9 @@ static STokenstream *tokenstream = NULL;
 
 static uint num_file_tokenstreams = 0;
 
+/* guards the tokenstream and the number of tokenstreams */
+S_DECLARE_MUTEX_STATIC(tokenstream_mutex);
+
 
 /************************************************************************************/
 /*                                                                                  */
@@ -205,6 +208,7 @@ static void Init(void *obj, s_erc *error)
 
 	S_CLR_ERR(error);
 
+	s_mutex_lock(&tokenstream_mutex);
 	if (num_file_tokenstreams++ == 0)
 	{
 		/* create a tokenstream to give us access to the STokenstreamClass functions */
@@ -212,8 +216,12 @@ static void Init(void *obj, s_erc *error)
 		if (S_CHK_ERR(error, S_CONTERR,
 					  "Init",
 					  "Failed to create tokenstream to give STokenstreamClass function access"))
+		{
+			s_mutex_unlock(&tokenstream_mutex);
 			return;
+		}
 	}
+	s_mutex_unlock(&tokenstream_mutex);
 
 	self->ds = NULL;
 }
@@ -229,8 +237,10 @@ static void Destroy(void *obj, s_erc *error)
 	if (self->ds != NULL)
 		S_DELETE(self->ds, "Destroy", error);
 
+	s_mutex_lock(&tokenstream_mutex);
 	if (--num_file_tokenstreams == 0)
 		S_DELETE(tokenstream, "Destroy", error);
+	s_mutex_unlock(&tokenstream_mutex);
 }
 
 
@@ -461,6 +471,7 @@ static s_bool QueryEOF(const STokenstream *self, s_erc *error)
 S_LOCAL void _s_tokenstream_file_class_add(s_erc *error)
 {
 	S_CLR_ERR(error);
+	s_mutex_init(&tokenstream_mutex);
 	s_class_add(S_OBJECTCLASS(&TokenstreamFileClass), error);
 	S_CHK_ERR(error, S_CONTERR,
 			  "_s_tokenstream_file_class_add",
@@ -152,6 +152,9 @@ static STokenstream *tokenstream = NULL;
 
 static uint num_string_tokenstreams = 0;
 
+/* guards the tokenstream and the number of tokenstreams */
+S_DECLARE_MUTEX_STATIC(tokenstream_mutex);
+
 
 /************************************************************************************/
 /*                                                                                  */
@@ -207,6 +210,7 @@ static void Init(void *obj, s_erc *error)
 
 	S_CLR_ERR(error);
 
+	s_mutex_lock(&tokenstream_mutex);
 	if (num_string_tokenstreams++ == 0)
 	{
 		/* create a tokenstream to give us access to the STokenstreamClass functions */
@@ -214,8 +218,12 @@ static void Init(void *obj, s_erc *error)
 		if (S_CHK_ERR(error, S_CONTERR,
 					  "Init",
 					  "Failed to create tokenstream to give STokenstreamClass function access"))
+		{
+			s_mutex_unlock(&tokenstream_mutex);
 			return;
+		}
 	}
+	s_mutex_unlock(&tokenstream_mutex);
 
 	self->string = NULL;
 	self->pos = 0;
@@ -233,8 +241,10 @@ static void Destroy(void *obj, s_erc *error)
 	if (self->string != NULL)
 		S_FREE(self->string);
 
+	s_mutex_lock(&tokenstream_mutex);
 	if (--num_string_tokenstreams == 0)
 		S_DELETE(tokenstream, "Destroy", error);
+	s_mutex_unlock(&tokenstream_mutex);
 }
 
 
@@ -514,6 +524,7 @@ static s_bool QueryEOF(const STokenstream *self, s_erc *error)
 S_LOCAL void _s_tokenstream_string_class_add(s_erc *error)
 {
 	S_CLR_ERR(error);
+	s_mutex_init(&tokenstream_mutex);
 	s_class_add(S_OBJECTCLASS(&TokenstreamStringClass), error);
 	S_CHK_ERR(error, S_CONTERR,
 			  "_s_tokenstream_string_class_add",
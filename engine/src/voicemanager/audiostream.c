@@ -0,0 +1,496 @@
+/************************************************************************************/
+/* Copyright (c) 2008-2011 The Department of Arts and Culture,                      */
+/* The Government of the Republic of South Africa.                                  */
+/*                                                                                  */
+/* Contributors:  Meraka Institute, CSIR, South Africa.                             */
+/*                                                                                  */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy     */
+/* of this software and associated documentation files (the "Software"), to deal    */
+/* in the Software without restriction, including without limitation the rights     */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        */
+/* copies of the Software, and to permit persons to whom the Software is            */
+/* furnished to do so, subject to the following conditions:                         */
+/* The above copyright notice and this permission notice shall be included in       */
+/* all copies or substantial portions of the Software.                              */
+/*                                                                                  */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN        */
+/* THE SOFTWARE.                                                                    */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* AUTHOR  : Speect contributors                                                    */
+/* DATE    : 19 October 2026                                                        */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* PCM audio stream of waveform generators.                                         */
+/*                                                                                  */
+/*                                                                                  */
+/************************************************************************************/
+
+/************************************************************************************/
+/*                                                                                  */
+/* Modules used                                                                     */
+/*                                                                                  */
+/************************************************************************************/
+
+#include <string.h>
+#include "voicemanager/audiostream.h"
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static variables                                                                 */
+/*                                                                                  */
+/************************************************************************************/
+
+static SAudioStreamClass AudioStreamClass; /* SAudioStream class declaration. */
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static function prototypes                                                       */
+/*                                                                                  */
+/************************************************************************************/
+
+static void write_samples(SAudioStream *self, const float *samples,
+						  uint32 num_samples, s_erc *error);
+
+static void keep_samples(SAudioStream *self, const float *samples,
+						 uint32 num_samples, s_erc *error);
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Function implementations                                                         */
+/*                                                                                  */
+/************************************************************************************/
+
+S_API void SAudioStreamInit(SAudioStream **self, uint32 chunk_size,
+							s_audio_chunk_cb_fp callback, void *userdata,
+							s_bool keep, s_erc *error)
+{
+	S_CLR_ERR(error);
+
+	if (*self == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SAudioStreamInit",
+				  "Argument \"self\" is NULL");
+		return;
+	}
+
+	(*self)->callback = callback;
+	(*self)->userdata = userdata;
+	(*self)->keep = keep;
+	(*self)->chunk_size = chunk_size;
+
+	if ((callback == NULL) || (chunk_size == 0))
+		return;
+
+	(*self)->chunk = S_MALLOC(float, chunk_size);
+	if ((*self)->chunk == NULL)
+	{
+		S_FTL_ERR(error, S_MEMERROR,
+				  "SAudioStreamInit",
+				  "Failed to allocate memory for 'float' object");
+		S_DELETE(*self, "SAudioStreamInit", error);
+		*self = NULL;
+	}
+}
+
+
+S_API void SAudioStreamWrite(SAudioStream *self, const float *samples,
+							 uint32 num_samples, uint32 sample_rate,
+							 s_erc *error)
+{
+	S_CLR_ERR(error);
+
+	if (self == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SAudioStreamWrite",
+				  "Argument \"self\" is NULL");
+		return;
+	}
+
+	if ((samples == NULL) && (num_samples > 0))
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SAudioStreamWrite",
+				  "Argument \"samples\" is NULL");
+		return;
+	}
+
+	if (sample_rate == 0)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SAudioStreamWrite",
+				  "Argument \"sample_rate\" is 0");
+		return;
+	}
+
+	if (self->sample_rate == 0)
+	{
+		self->sample_rate = sample_rate;
+	}
+	else if (self->sample_rate != sample_rate)
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "SAudioStreamWrite",
+				  "Sample rate %u differs from the sample rate %u of the stream",
+				  sample_rate, self->sample_rate);
+		return;
+	}
+
+	write_samples(self, samples, num_samples, error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "SAudioStreamWrite",
+			  "Call to \"write_samples\" failed");
+}
+
+
+S_API void SAudioStreamWriteSilence(SAudioStream *self, uint32 num_samples,
+									s_erc *error)
+{
+	S_CLR_ERR(error);
+
+	if (self == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SAudioStreamWriteSilence",
+				  "Argument \"self\" is NULL");
+		return;
+	}
+
+	/* NULL samples are silence */
+	write_samples(self, NULL, num_samples, error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "SAudioStreamWriteSilence",
+			  "Call to \"write_samples\" failed");
+}
+
+
+S_API void SAudioStreamFlush(SAudioStream *self, s_erc *error)
+{
+	S_CLR_ERR(error);
+
+	if (self == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SAudioStreamFlush",
+				  "Argument \"self\" is NULL");
+		return;
+	}
+
+	if ((self->chunk == NULL) || (self->chunk_fill == 0))
+		return;
+
+	self->callback(self->chunk, self->chunk_fill, self->sample_rate, self->userdata);
+	self->chunk_fill = 0;
+}
+
+
+S_API const float *SAudioStreamGetSamples(const SAudioStream *self, uint32 *num_samples,
+										  s_erc *error)
+{
+	S_CLR_ERR(error);
+
+	if (self == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SAudioStreamGetSamples",
+				  "Argument \"self\" is NULL");
+		return NULL;
+	}
+
+	if (num_samples == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SAudioStreamGetSamples",
+				  "Argument \"num_samples\" is NULL");
+		return NULL;
+	}
+
+	if (!self->keep)
+	{
+		*num_samples = 0;
+		return NULL;
+	}
+
+	*num_samples = self->num_samples;
+	return self->samples;
+}
+
+
+S_API uint32 SAudioStreamGetSampleRate(const SAudioStream *self, s_erc *error)
+{
+	S_CLR_ERR(error);
+
+	if (self == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SAudioStreamGetSampleRate",
+				  "Argument \"self\" is NULL");
+		return 0;
+	}
+
+	return self->sample_rate;
+}
+
+
+S_API SAudioStream *SAudioStreamGetFromUtt(const SUtterance *utt, s_erc *error)
+{
+	const SObject *stream;
+	s_bool is_present;
+	s_bool is_type;
+
+
+	S_CLR_ERR(error);
+
+	if (utt == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SAudioStreamGetFromUtt",
+				  "Argument \"utt\" is NULL");
+		return NULL;
+	}
+
+	is_present = SUtteranceFeatureIsPresent(utt, "audio-stream", error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SAudioStreamGetFromUtt",
+				  "Call to \"SUtteranceFeatureIsPresent\" failed"))
+		return NULL;
+
+	if (!is_present)
+		return NULL;
+
+	stream = SUtteranceGetFeature(utt, "audio-stream", error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SAudioStreamGetFromUtt",
+				  "Call to \"SUtteranceGetFeature\" failed"))
+		return NULL;
+
+	is_type = SObjectIsType(stream, "SAudioStream", error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SAudioStreamGetFromUtt",
+				  "Call to \"SObjectIsType\" failed"))
+		return NULL;
+
+	if (!is_type)
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "SAudioStreamGetFromUtt",
+				  "Utterance \'audio-stream\' feature is not of type \'SAudioStream\'");
+		return NULL;
+	}
+
+	/* the stream is written to by the utterance processors */
+	return S_AUDIOSTREAM(stream);
+}
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Class registration                                                               */
+/*                                                                                  */
+/************************************************************************************/
+
+S_LOCAL void _s_audio_stream_class_add(s_erc *error)
+{
+	S_CLR_ERR(error);
+	s_class_add(S_OBJECTCLASS(&AudioStreamClass), error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "_s_audio_stream_class_add",
+			  "Failed to add SAudioStreamClass");
+}
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static function implementations                                                  */
+/*                                                                                  */
+/************************************************************************************/
+
+/* NULL samples are silence */
+static void write_samples(SAudioStream *self, const float *samples,
+						  uint32 num_samples, s_erc *error)
+{
+	float *silence;
+	uint32 count;
+	uint32 done;
+
+
+	S_CLR_ERR(error);
+
+	if (num_samples == 0)
+		return;
+
+	if (self->keep)
+	{
+		keep_samples(self, samples, num_samples, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "write_samples",
+					  "Call to \"keep_samples\" failed"))
+			return;
+	}
+	else
+	{
+		self->num_samples += num_samples;
+	}
+
+	if (self->callback == NULL)
+		return;
+
+	if (self->chunk == NULL)
+	{
+		if (samples != NULL)
+		{
+			self->callback(samples, num_samples, self->sample_rate, self->userdata);
+			return;
+		}
+
+		silence = S_CALLOC(float, num_samples);
+		if (silence == NULL)
+		{
+			S_FTL_ERR(error, S_MEMERROR,
+					  "write_samples",
+					  "Failed to allocate memory for 'float' object");
+			return;
+		}
+
+		self->callback(silence, num_samples, self->sample_rate, self->userdata);
+		S_FREE(silence);
+		return;
+	}
+
+	for (done = 0; done < num_samples; done += count)
+	{
+		count = self->chunk_size - self->chunk_fill;
+		if (count > num_samples - done)
+			count = num_samples - done;
+
+		if (samples != NULL)
+			memcpy(self->chunk + self->chunk_fill, samples + done, count * sizeof(float));
+		else
+			memset(self->chunk + self->chunk_fill, 0, count * sizeof(float));
+
+		self->chunk_fill += count;
+		if (self->chunk_fill == self->chunk_size)
+		{
+			self->callback(self->chunk, self->chunk_size, self->sample_rate, self->userdata);
+			self->chunk_fill = 0;
+		}
+	}
+}
+
+
+static void keep_samples(SAudioStream *self, const float *samples,
+						 uint32 num_samples, s_erc *error)
+{
+	float *tmp;
+	uint32 new_size;
+
+
+	S_CLR_ERR(error);
+
+	if (self->num_samples + num_samples > self->samples_size)
+	{
+		/* grow geometrically, streams are written in many small pieces */
+		new_size = (self->samples_size > 0) ? self->samples_size : 4096;
+		while (new_size < self->num_samples + num_samples)
+			new_size *= 2;
+
+		tmp = S_REALLOC(self->samples, float, new_size);
+		if (tmp == NULL)
+		{
+			S_FTL_ERR(error, S_MEMERROR,
+					  "keep_samples",
+					  "Failed to reallocate memory for 'float' object");
+			return;
+		}
+
+		self->samples = tmp;
+		self->samples_size = new_size;
+	}
+
+	if (samples != NULL)
+		memcpy(self->samples + self->num_samples, samples, num_samples * sizeof(float));
+	else
+		memset(self->samples + self->num_samples, 0, num_samples * sizeof(float));
+
+	self->num_samples += num_samples;
+}
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static class function implementations                                            */
+/*                                                                                  */
+/************************************************************************************/
+
+static void InitAudioStream(void *obj, s_erc *error)
+{
+	SAudioStream *self = obj;
+
+
+	S_CLR_ERR(error);
+
+	self->callback = NULL;
+	self->userdata = NULL;
+	self->chunk_size = 0;
+	self->chunk = NULL;
+	self->chunk_fill = 0;
+	self->sample_rate = 0;
+	self->keep = FALSE;
+	self->samples = NULL;
+	self->num_samples = 0;
+	self->samples_size = 0;
+}
+
+
+static void DestroyAudioStream(void *obj, s_erc *error)
+{
+	SAudioStream *self = obj;
+
+
+	S_CLR_ERR(error);
+
+	if (self->chunk != NULL)
+		S_FREE(self->chunk);
+
+	if (self->samples != NULL)
+		S_FREE(self->samples);
+}
+
+
+static void DisposeAudioStream(void *obj, s_erc *error)
+{
+	S_CLR_ERR(error);
+	SObjectDecRef(obj);
+}
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* SAudioStream class initialization                                                */
+/*                                                                                  */
+/************************************************************************************/
+
+static SAudioStreamClass AudioStreamClass =
+{
+	"SAudioStream",
+	sizeof(SAudioStream),
+	{ 0, 1},
+	InitAudioStream,    /* init    */
+	DestroyAudioStream, /* destroy */
+	DisposeAudioStream, /* dispose */
+	NULL,               /* compare */
+	NULL,               /* print   */
+	NULL,               /* copy    */
+};
@@ -0,0 +1,337 @@
+/************************************************************************************/
+/* Copyright (c) 2008-2011 The Department of Arts and Culture,                      */
+/* The Government of the Republic of South Africa.                                  */
+/*                                                                                  */
+/* Contributors:  Meraka Institute, CSIR, South Africa.                             */
+/*                                                                                  */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy     */
+/* of this software and associated documentation files (the "Software"), to deal    */
+/* in the Software without restriction, including without limitation the rights     */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        */
+/* copies of the Software, and to permit persons to whom the Software is            */
+/* furnished to do so, subject to the following conditions:                         */
+/* The above copyright notice and this permission notice shall be included in       */
+/* all copies or substantial portions of the Software.                              */
+/*                                                                                  */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN        */
+/* THE SOFTWARE.                                                                    */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* AUTHOR  : Speect contributors                                                    */
+/* DATE    : 19 October 2026                                                        */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* PCM audio stream of waveform generators.                                         */
+/*                                                                                  */
+/*                                                                                  */
+/************************************************************************************/
+
+#ifndef _SPCT_AUDIO_STREAM_H__
+#define _SPCT_AUDIO_STREAM_H__
+
+
+/**
+ * @file audiostream.h
+ * PCM audio stream of waveform generators.
+ */
+
+
+/**
+ * @ingroup SVoices
+ * @defgroup SAudioStream Audio Stream
+ * A stream of PCM audio samples. A waveform generation utterance
+ * processor writes its samples to the audio stream of the utterance
+ * (the @c "audio-stream" feature, see #SAudioStreamGetFromUtt) if
+ * there is one, next to creating the @c "audio" feature. The stream
+ * delivers the samples to a callback function in chunks of a fixed
+ * size, and can keep all the written samples.
+ *
+ * The samples are floats in the range of the waveform generators, as
+ * in the @c SAudio plug-in class.
+ * @{
+ */
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Modules used                                                                     */
+/*                                                                                  */
+/************************************************************************************/
+
+#include "include/common.h"
+#include "base/utils/types.h"
+#include "base/errdbg/errdbg.h"
+#include "base/objsystem/objsystem.h"
+#include "hrg/hrg.h"
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Begin external c declaration                                                     */
+/*                                                                                  */
+/************************************************************************************/
+S_BEGIN_C_DECLS
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Macros                                                                           */
+/*                                                                                  */
+/************************************************************************************/
+
+/**
+ * @hideinitializer
+ * Return the given #SAudioStream child class object as an audio
+ * stream object.
+ *
+ * @param SELF The given object.
+ *
+ * @return Given object as #SAudioStream* type.
+ *
+ * @note This casting is not safety checked.
+ */
+#define S_AUDIOSTREAM(SELF)  ((SAudioStream *)(SELF))
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Data types                                                                       */
+/*                                                                                  */
+/************************************************************************************/
+
+/**
+ * Audio chunk callback function type.
+ *
+ * @param samples The samples of the chunk, only valid during the
+ * call.
+ * @param num_samples The number of samples of the chunk.
+ * @param sample_rate The sample rate of the samples, 0 if not known
+ * yet (only silence has been written).
+ * @param userdata The user data given with the callback.
+ */
+typedef void (*s_audio_chunk_cb_fp)(const float *samples, uint32 num_samples,
+									uint32 sample_rate, void *userdata);
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* SAudioStream definition                                                          */
+/*                                                                                  */
+/************************************************************************************/
+
+/**
+ * The SAudioStream structure.
+ * @extends SObject
+ */
+typedef struct
+{
+	/**
+	 * @protected Inherit from #SObject.
+	 */
+	SObject              obj;
+
+	/**
+	 * @protected Chunk callback, can be @c NULL.
+	 */
+	s_audio_chunk_cb_fp  callback;
+
+	/**
+	 * @protected Callback user data.
+	 */
+	void                *userdata;
+
+	/**
+	 * @protected Chunk size in samples, 0 delivers every write as
+	 * it is.
+	 */
+	uint32               chunk_size;
+
+	/**
+	 * @protected Samples of the current chunk.
+	 */
+	float               *chunk;
+
+	/**
+	 * @protected Number of samples in the current chunk.
+	 */
+	uint32               chunk_fill;
+
+	/**
+	 * @protected Sample rate, 0 if not known yet.
+	 */
+	uint32               sample_rate;
+
+	/**
+	 * @protected Keep the written samples flag.
+	 */
+	s_bool               keep;
+
+	/**
+	 * @protected Kept samples.
+	 */
+	float               *samples;
+
+	/**
+	 * @protected Number of written samples.
+	 */
+	uint32               num_samples;
+
+	/**
+	 * @protected Allocated size of the kept samples.
+	 */
+	uint32               samples_size;
+} SAudioStream;
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* SAudioStreamClass definition                                                     */
+/*                                                                                  */
+/************************************************************************************/
+
+/**
+ * The SAudioStreamClass type. Same as #SObjectClass as we
+ * do not add any new methods.
+ * @extends SObjectClass
+ */
+typedef SObjectClass SAudioStreamClass;
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Function prototypes                                                              */
+/*                                                                                  */
+/************************************************************************************/
+
+/**
+ * Initialize an audio stream.
+ *
+ * @public @memberof SAudioStream
+ * @param self The audio stream to initialize.
+ * @param chunk_size The number of samples of a chunk delivered to the
+ * callback function, if 0 every write is delivered as it is.
+ * @param callback The chunk callback function, can be @c NULL.
+ * @param userdata User data passed to the callback function.
+ * @param keep If #TRUE all the written samples are kept, see
+ * #SAudioStreamGetSamples.
+ * @param error Error code.
+ *
+ * @note If this function fails the stream will be deleted and the
+ * @c self variable will be set to @c NULL.
+ */
+S_API void SAudioStreamInit(SAudioStream **self, uint32 chunk_size,
+							s_audio_chunk_cb_fp callback, void *userdata,
+							s_bool keep, s_erc *error);
+
+
+/**
+ * Write samples to the audio stream. Full chunks are delivered to the
+ * callback function.
+ *
+ * @public @memberof SAudioStream
+ * @param self The audio stream.
+ * @param samples The samples to write.
+ * @param num_samples The number of samples to write.
+ * @param sample_rate The sample rate of the samples, must be the same
+ * for all the writes to the stream.
+ * @param error Error code.
+ */
+S_API void SAudioStreamWrite(SAudioStream *self, const float *samples,
+							 uint32 num_samples, uint32 sample_rate,
+							 s_erc *error);
+
+
+/**
+ * Write silence to the audio stream.
+ *
+ * @public @memberof SAudioStream
+ * @param self The audio stream.
+ * @param num_samples The number of silent samples to write.
+ * @param error Error code.
+ */
+S_API void SAudioStreamWriteSilence(SAudioStream *self, uint32 num_samples,
+									s_erc *error);
+
+
+/**
+ * Deliver the samples of an incomplete chunk to the callback function.
+ *
+ * @public @memberof SAudioStream
+ * @param self The audio stream.
+ * @param error Error code.
+ */
+S_API void SAudioStreamFlush(SAudioStream *self, s_erc *error);
+
+
+/**
+ * Get the samples kept by the audio stream.
+ *
+ * @public @memberof SAudioStream
+ * @param self The audio stream.
+ * @param num_samples Variable to receive the number of samples.
+ * @param error Error code.
+ *
+ * @return The kept samples, @c NULL if none or if the stream does not
+ * keep its samples.
+ */
+S_API const float *SAudioStreamGetSamples(const SAudioStream *self, uint32 *num_samples,
+										  s_erc *error);
+
+
+/**
+ * Get the sample rate of the audio stream.
+ *
+ * @public @memberof SAudioStream
+ * @param self The audio stream.
+ * @param error Error code.
+ *
+ * @return The sample rate, 0 if no samples have been written yet.
+ */
+S_API uint32 SAudioStreamGetSampleRate(const SAudioStream *self, s_erc *error);
+
+
+/**
+ * Get the audio stream of an utterance, the @c "audio-stream"
+ * feature. Waveform generation utterance processors write their
+ * samples to it.
+ *
+ * @public @memberof SAudioStream
+ * @param utt The utterance.
+ * @param error Error code.
+ *
+ * @return The audio stream of the utterance, or @c NULL if it has
+ * none.
+ */
+S_API SAudioStream *SAudioStreamGetFromUtt(const SUtterance *utt, s_erc *error);
+
+
+/**
+ * Add the SAudioStream class to the object system.
+ * @private
+ *
+ * @param error Error code.
+ */
+S_LOCAL void _s_audio_stream_class_add(s_erc *error);
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* End external c declaration                                                       */
+/*                                                                                  */
+/************************************************************************************/
+S_END_C_DECLS
+
+
+/**
+ * @}
+ * end documentation
+ */
+
+#endif /* _SPCT_AUDIO_STREAM_H__ */
@@ -0,0 +1,303 @@
+/************************************************************************************/
+/* Copyright (c) 2008-2011 The Department of Arts and Culture,                      */
+/* The Government of the Republic of South Africa.                                  */
+/*                                                                                  */
+/* Contributors:  Meraka Institute, CSIR, South Africa.                             */
+/*                                                                                  */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy     */
+/* of this software and associated documentation files (the "Software"), to deal    */
+/* in the Software without restriction, including without limitation the rights     */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        */
+/* copies of the Software, and to permit persons to whom the Software is            */
+/* furnished to do so, subject to the following conditions:                         */
+/* The above copyright notice and this permission notice shall be included in       */
+/* all copies or substantial portions of the Software.                              */
+/*                                                                                  */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN        */
+/* THE SOFTWARE.                                                                    */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* AUTHOR  : Speect contributors                                                    */
+/* DATE    : 19 October 2026                                                        */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* Cancellation tokens and deadlines of synthesis.                                  */
+/*                                                                                  */
+/*                                                                                  */
+/************************************************************************************/
+
+/************************************************************************************/
+/*                                                                                  */
+/* Modules used                                                                     */
+/*                                                                                  */
+/************************************************************************************/
+
+#include "base/utils/stime.h"
+#include "voicemanager/canceltoken.h"
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static variables                                                                 */
+/*                                                                                  */
+/************************************************************************************/
+
+static SCancelTokenClass CancelTokenClass; /* SCancelToken class declaration. */
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Function implementations                                                         */
+/*                                                                                  */
+/************************************************************************************/
+
+S_API void SCancelTokenCancel(SCancelToken *self, s_erc *error)
+{
+	S_CLR_ERR(error);
+
+	if (self == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SCancelTokenCancel",
+				  "Argument \"self\" is NULL");
+		return;
+	}
+
+	s_mutex_lock(&self->cancel_mutex);
+	self->cancelled = TRUE;
+	s_mutex_unlock(&self->cancel_mutex);
+}
+
+
+S_API void SCancelTokenSetDeadline(SCancelToken *self, double deadline, s_erc *error)
+{
+	S_CLR_ERR(error);
+
+	if (self == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SCancelTokenSetDeadline",
+				  "Argument \"self\" is NULL");
+		return;
+	}
+
+	s_mutex_lock(&self->cancel_mutex);
+	self->deadline = deadline;
+	s_mutex_unlock(&self->cancel_mutex);
+}
+
+
+S_API void SCancelTokenSetTimeout(SCancelToken *self, double timeout, s_erc *error)
+{
+	double now;
+
+
+	S_CLR_ERR(error);
+
+	if (self == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SCancelTokenSetTimeout",
+				  "Argument \"self\" is NULL");
+		return;
+	}
+
+	now = s_time_monotonic(error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SCancelTokenSetTimeout",
+				  "Call to \"s_time_monotonic\" failed"))
+		return;
+
+	SCancelTokenSetDeadline(self, now + timeout, error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "SCancelTokenSetTimeout",
+			  "Call to \"SCancelTokenSetDeadline\" failed");
+}
+
+
+S_API s_bool SCancelTokenIsCancelled(const SCancelToken *self, s_erc *error)
+{
+	s_bool cancelled;
+	double deadline;
+	double now;
+
+
+	S_CLR_ERR(error);
+
+	if (self == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SCancelTokenIsCancelled",
+				  "Argument \"self\" is NULL");
+		return FALSE;
+	}
+
+	s_mutex_lock((s_mutex*)&self->cancel_mutex);
+	cancelled = self->cancelled;
+	deadline = self->deadline;
+	s_mutex_unlock((s_mutex*)&self->cancel_mutex);
+
+	if (cancelled || (deadline == 0.0))
+		return cancelled;
+
+	now = s_time_monotonic(error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SCancelTokenIsCancelled",
+				  "Call to \"s_time_monotonic\" failed"))
+		return FALSE;
+
+	return (now >= deadline);
+}
+
+
+S_API void SCancelTokenCheck(const SCancelToken *self, s_erc *error)
+{
+	s_bool cancelled;
+
+
+	S_CLR_ERR(error);
+
+	if (self == NULL)
+		return;
+
+	cancelled = SCancelTokenIsCancelled(self, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SCancelTokenCheck",
+				  "Call to \"SCancelTokenIsCancelled\" failed"))
+		return;
+
+	if (cancelled)
+		S_CTX_ERR(error, S_CANCELLED,
+				  "SCancelTokenCheck",
+				  "Synthesis cancelled");
+}
+
+
+S_API const SCancelToken *SCancelTokenGetFromUtt(const SUtterance *utt, s_erc *error)
+{
+	const SObject *cancel;
+	s_bool is_present;
+	s_bool is_type;
+
+
+	S_CLR_ERR(error);
+
+	if (utt == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SCancelTokenGetFromUtt",
+				  "Argument \"utt\" is NULL");
+		return NULL;
+	}
+
+	is_present = SUtteranceFeatureIsPresent(utt, "cancel-token", error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SCancelTokenGetFromUtt",
+				  "Call to \"SUtteranceFeatureIsPresent\" failed"))
+		return NULL;
+
+	if (!is_present)
+		return NULL;
+
+	cancel = SUtteranceGetFeature(utt, "cancel-token", error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SCancelTokenGetFromUtt",
+				  "Call to \"SUtteranceGetFeature\" failed"))
+		return NULL;
+
+	is_type = SObjectIsType(cancel, "SCancelToken", error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SCancelTokenGetFromUtt",
+				  "Call to \"SObjectIsType\" failed"))
+		return NULL;
+
+	if (!is_type)
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "SCancelTokenGetFromUtt",
+				  "Utterance \'cancel-token\' feature is not of type \'SCancelToken\'");
+		return NULL;
+	}
+
+	return S_CANCELTOKEN(cancel);
+}
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Class registration                                                               */
+/*                                                                                  */
+/************************************************************************************/
+
+S_LOCAL void _s_cancel_token_class_add(s_erc *error)
+{
+	S_CLR_ERR(error);
+	s_class_add(S_OBJECTCLASS(&CancelTokenClass), error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "_s_cancel_token_class_add",
+			  "Failed to add SCancelTokenClass");
+}
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static class function implementations                                            */
+/*                                                                                  */
+/************************************************************************************/
+
+static void InitCancelToken(void *obj, s_erc *error)
+{
+	SCancelToken *self = obj;
+
+
+	S_CLR_ERR(error);
+
+	self->cancelled = FALSE;
+	self->deadline = 0.0;
+	s_mutex_init(&self->cancel_mutex);
+}
+
+
+static void DestroyCancelToken(void *obj, s_erc *error)
+{
+	SCancelToken *self = obj;
+
+
+	S_CLR_ERR(error);
+	S_UNUSED(self); /* only for the mutex */
+	s_mutex_destroy(&self->cancel_mutex);
+}
+
+
+static void DisposeCancelToken(void *obj, s_erc *error)
+{
+	S_CLR_ERR(error);
+	SObjectDecRef(obj);
+}
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* SCancelToken class initialization                                                */
+/*                                                                                  */
+/************************************************************************************/
+
+static SCancelTokenClass CancelTokenClass =
+{
+	"SCancelToken",
+	sizeof(SCancelToken),
+	{ 0, 1},
+	InitCancelToken,    /* init    */
+	DestroyCancelToken, /* destroy */
+	DisposeCancelToken, /* dispose */
+	NULL,               /* compare */
+	NULL,               /* print   */
+	NULL,               /* copy    */
+};
@@ -0,0 +1,268 @@
+/************************************************************************************/
+/* Copyright (c) 2008-2011 The Department of Arts and Culture,                      */
+/* The Government of the Republic of South Africa.                                  */
+/*                                                                                  */
+/* Contributors:  Meraka Institute, CSIR, South Africa.                             */
+/*                                                                                  */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy     */
+/* of this software and associated documentation files (the "Software"), to deal    */
+/* in the Software without restriction, including without limitation the rights     */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        */
+/* copies of the Software, and to permit persons to whom the Software is            */
+/* furnished to do so, subject to the following conditions:                         */
+/* The above copyright notice and this permission notice shall be included in       */
+/* all copies or substantial portions of the Software.                              */
+/*                                                                                  */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN        */
+/* THE SOFTWARE.                                                                    */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* AUTHOR  : Speect contributors                                                    */
+/* DATE    : 19 October 2026                                                        */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* Cancellation tokens and deadlines of synthesis.                                  */
+/*                                                                                  */
+/*                                                                                  */
+/************************************************************************************/
+
+#ifndef _SPCT_CANCEL_TOKEN_H__
+#define _SPCT_CANCEL_TOKEN_H__
+
+
+/**
+ * @file canceltoken.h
+ * Cancellation tokens and deadlines of synthesis.
+ */
+
+
+/**
+ * @ingroup SVoices
+ * @defgroup SCancelToken Cancellation Token
+ * Cooperative cancellation of synthesis. A cancellation token is
+ * set as the @c "cancel-token" feature of an utterance (see
+ * #SVoiceSynthUttCancellable and #SCancelTokenGetFromUtt). It is
+ * cancelled by calling #SCancelTokenCancel, from any thread, or when
+ * its deadline passes. The synthesis checks the token before every
+ * utterance processor, and long running utterance processors check it
+ * in their main loops, failing with the #S_CANCELLED error code.
+ *
+ * Cancellation is cooperative, an utterance processor that does not
+ * check the token runs to its end, and the token is only noticed
+ * before the next utterance processor.
+ * @{
+ */
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Modules used                                                                     */
+/*                                                                                  */
+/************************************************************************************/
+
+#include "include/common.h"
+#include "base/utils/types.h"
+#include "base/errdbg/errdbg.h"
+#include "base/threads/threads.h"
+#include "base/objsystem/objsystem.h"
+#include "hrg/hrg.h"
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Begin external c declaration                                                     */
+/*                                                                                  */
+/************************************************************************************/
+S_BEGIN_C_DECLS
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Macros                                                                           */
+/*                                                                                  */
+/************************************************************************************/
+
+/**
+ * @hideinitializer
+ * Return the given #SCancelToken child class object as a
+ * cancellation token object.
+ *
+ * @param SELF The given object.
+ *
+ * @return Given object as #SCancelToken* type.
+ *
+ * @note This casting is not safety checked.
+ */
+#define S_CANCELTOKEN(SELF)  ((SCancelToken *)(SELF))
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* SCancelToken definition                                                          */
+/*                                                                                  */
+/************************************************************************************/
+
+/**
+ * The SCancelToken structure.
+ * @extends SObject
+ */
+typedef struct
+{
+	/**
+	 * @protected Inherit from #SObject.
+	 */
+	SObject  obj;
+
+	/**
+	 * @protected Cancelled flag.
+	 */
+	s_bool   cancelled;
+
+	/**
+	 * @protected Deadline, a #s_time_monotonic time, or 0.0 for
+	 * none.
+	 */
+	double   deadline;
+
+	/**
+	 * @protected Locking mutex.
+	 */
+	S_DECLARE_MUTEX(cancel_mutex);
+} SCancelToken;
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* SCancelTokenClass definition                                                     */
+/*                                                                                  */
+/************************************************************************************/
+
+/**
+ * The SCancelTokenClass type. Same as #SObjectClass as we
+ * do not add any new methods.
+ * @extends SObjectClass
+ */
+typedef SObjectClass SCancelTokenClass;
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Function prototypes                                                              */
+/*                                                                                  */
+/************************************************************************************/
+
+/**
+ * Cancel the token. Synthesis of the utterances carrying the token
+ * fails with #S_CANCELLED at its next check.
+ *
+ * @public @memberof SCancelToken
+ * @param self The cancellation token.
+ * @param error Error code.
+ *
+ * @note Thread-safe.
+ */
+S_API void SCancelTokenCancel(SCancelToken *self, s_erc *error);
+
+
+/**
+ * Set the deadline of the token. The token is cancelled when the
+ * deadline passes.
+ *
+ * @public @memberof SCancelToken
+ * @param self The cancellation token.
+ * @param deadline The deadline, a time of the #s_time_monotonic
+ * clock, or 0.0 to clear the deadline.
+ * @param error Error code.
+ *
+ * @note Thread-safe.
+ */
+S_API void SCancelTokenSetDeadline(SCancelToken *self, double deadline, s_erc *error);
+
+
+/**
+ * Set the deadline of the token relative to the current time.
+ *
+ * @public @memberof SCancelToken
+ * @param self The cancellation token.
+ * @param timeout The time from now to the deadline, in seconds.
+ * @param error Error code.
+ *
+ * @note Thread-safe.
+ */
+S_API void SCancelTokenSetTimeout(SCancelToken *self, double timeout, s_erc *error);
+
+
+/**
+ * Query if the token is cancelled, either by #SCancelTokenCancel or
+ * because its deadline has passed.
+ *
+ * @public @memberof SCancelToken
+ * @param self The cancellation token.
+ * @param error Error code.
+ *
+ * @return #TRUE if cancelled, otherwise #FALSE.
+ *
+ * @note Thread-safe.
+ */
+S_API s_bool SCancelTokenIsCancelled(const SCancelToken *self, s_erc *error);
+
+
+/**
+ * Check the token, setting the error code to #S_CANCELLED if it is
+ * cancelled. Used by the synthesis and utterance processors at the
+ * points where they can stop.
+ *
+ * @public @memberof SCancelToken
+ * @param self The cancellation token, may be @c NULL in which case
+ * the check always succeeds.
+ * @param error Error code.
+ *
+ * @note Thread-safe.
+ */
+S_API void SCancelTokenCheck(const SCancelToken *self, s_erc *error);
+
+
+/**
+ * Get the cancellation token of an utterance, the @c "cancel-token"
+ * feature.
+ *
+ * @public @memberof SCancelToken
+ * @param utt The utterance.
+ * @param error Error code.
+ *
+ * @return The cancellation token of the utterance, or @c NULL if it
+ * has none.
+ */
+S_API const SCancelToken *SCancelTokenGetFromUtt(const SUtterance *utt, s_erc *error);
+
+
+/**
+ * Add the SCancelToken class to the object system.
+ * @private
+ *
+ * @param error Error code.
+ */
+S_LOCAL void _s_cancel_token_class_add(s_erc *error);
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* End external c declaration                                                       */
+/*                                                                                  */
+/************************************************************************************/
+S_END_C_DECLS
+
+
+/**
+ * @}
+ * end documentation
+ */
+
+#endif /* _SPCT_CANCEL_TOKEN_H__ */
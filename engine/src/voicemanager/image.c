@@ -0,0 +1,1061 @@
+/************************************************************************************/
+/* Copyright (c) 2008-2011 The Department of Arts and Culture,                      */
+/* The Government of the Republic of South Africa.                                  */
+/*                                                                                  */
+/* Contributors:  Meraka Institute, CSIR, South Africa.                             */
+/*                                                                                  */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy     */
+/* of this software and associated documentation files (the "Software"), to deal    */
+/* in the Software without restriction, including without limitation the rights     */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        */
+/* copies of the Software, and to permit persons to whom the Software is            */
+/* furnished to do so, subject to the following conditions:                         */
+/* The above copyright notice and this permission notice shall be included in       */
+/* all copies or substantial portions of the Software.                              */
+/*                                                                                  */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN        */
+/* THE SOFTWARE.                                                                    */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* AUTHOR  : Speect contributors                                                    */
+/* DATE    : 19 October 2026                                                        */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* Precompiled single file voice images. The image is a bundle of the voice         */
+/* config and data files, the data entries are deserialized from the mapped         */
+/* memory and not accessed in place.                                                */
+/*                                                                                  */
+/************************************************************************************/
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Modules used                                                                     */
+/*                                                                                  */
+/************************************************************************************/
+
+#include <string.h>
+#include "base/utils/alloc.h"
+#include "base/utils/path.h"
+#include "base/strings/strings.h"
+#include "containers/containers.h"
+#include "datasources/datasources.h"
+#include "serialization/serialize.h"
+#include "serialization/json/json_parse_config.h"
+#include "pluginmanager/pluginmanager.h"
+#include "voicemanager/loaders/data_config.h"
+#include "voicemanager/image.h"
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Defines                                                                          */
+/*                                                                                  */
+/************************************************************************************/
+
+/* voice image magic */
+#define S_VOICE_IMAGE_MAGIC "SPCTVIMG"
+
+/* size of voice image magic */
+#define S_VOICE_IMAGE_MAGIC_SIZE 8
+
+/* voice image format version */
+#define S_VOICE_IMAGE_VERSION 2
+
+/* alignment of the voice configuration and data blobs */
+#define S_VOICE_IMAGE_ALIGN 8
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Typedefs                                                                         */
+/*                                                                                  */
+/************************************************************************************/
+
+/*
+ * A data entry of the voice image. The format and plug-in are NULL
+ * if the data is stored as given in the voice configuration.
+ */
+typedef struct
+{
+	char   *name;
+	char   *format;
+	char   *plugin;
+	uint32  offset;
+	uint32  size;
+} s_voice_image_entry;
+
+
+/*
+ * A data format that the image compiler converts to a binary format,
+ * which is queried in place from the image mapping.
+ */
+typedef struct
+{
+	const char *format;       /* data format in the voice configuration */
+	const char *image_format; /* format of the data in the image        */
+	const char *image_plugin; /* plug-in of the image format            */
+} s_voice_image_inplace;
+
+
+/*
+ * The opaque voice image.
+ */
+struct s_voice_image
+{
+	char                *path;
+	SDatasource         *ds;            /* memory mapped image */
+	const uint8         *mem;
+	size_t               size;
+	uint32               config_offset;
+	uint32               config_size;
+	uint32               num_entries;
+	s_voice_image_entry *entries;
+};
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static variables                                                                 */
+/*                                                                                  */
+/************************************************************************************/
+
+/*
+ * JSON lexicons are compiled to the trie lexicon format. The trie
+ * writer takes the parsed JSON lexicon, and SLexiconTrie queries the
+ * trie in the image mapping without copying it.
+ */
+static const s_voice_image_inplace inplace_formats[] =
+{
+	{ "spct_lexicon", "spct_lexicon_trie", "lexicon_trie.spi" },
+	{ NULL, NULL, NULL }
+};
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static function prototypes                                                       */
+/*                                                                                  */
+/************************************************************************************/
+
+static uint32 read_uint32(const s_voice_image *image, size_t *pos, s_erc *error);
+
+static char *read_string(const s_voice_image *image, size_t *pos, s_erc *error);
+
+static void write_string(SDatasource *ds, const char *string, s_erc *error);
+
+static void write_uint32_at(SDatasource *ds, uint32 value, long pos, s_erc *error);
+
+static const s_voice_image_inplace *get_inplace_format(const char *format,
+													   s_erc *error);
+
+static void check_region(const s_voice_image *image, uint32 offset, uint32 size,
+						 s_erc *error);
+
+static void write_padding(SDatasource *ds, uint32 pos, s_erc *error);
+
+static uint32 align_offset(uint32 offset);
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Function implementations                                                         */
+/*                                                                                  */
+/************************************************************************************/
+
+S_LOCAL s_bool _s_voice_image_check(const char *path, s_erc *error)
+{
+	SDatasource *ds;
+	char magic[S_VOICE_IMAGE_MAGIC_SIZE];
+	size_t read;
+	s_erc local_err = S_SUCCESS;
+
+
+	S_CLR_ERR(error);
+
+	if (path == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "_s_voice_image_check",
+				  "Argument \"path\" is NULL");
+		return FALSE;
+	}
+
+	/*
+	 * do not report errors, if the file can not be opened it is not
+	 * an image and the caller will report the error.
+	 */
+	if (!s_file_exists(path, "rb", &local_err))
+		return FALSE;
+
+	ds = SFilesourceOpenFile(path, "rb", &local_err);
+	if (local_err != S_SUCCESS)
+		return FALSE;
+
+	read = SDatasourceRead(ds, magic, 1, S_VOICE_IMAGE_MAGIC_SIZE, &local_err);
+	S_DELETE(ds, "_s_voice_image_check", error);
+
+	if ((local_err != S_SUCCESS) || (read != S_VOICE_IMAGE_MAGIC_SIZE))
+		return FALSE;
+
+	if (memcmp(magic, S_VOICE_IMAGE_MAGIC, S_VOICE_IMAGE_MAGIC_SIZE) != 0)
+		return FALSE;
+
+	return TRUE;
+}
+
+
+S_LOCAL s_voice_image *_s_voice_image_open(const char *path, s_erc *error)
+{
+	s_voice_image *image;
+	size_t pos;
+	uint32 version;
+	uint32 i;
+
+
+	S_CLR_ERR(error);
+
+	if (path == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "_s_voice_image_open",
+				  "Argument \"path\" is NULL");
+		return NULL;
+	}
+
+	image = S_CALLOC(s_voice_image, 1);
+	if (image == NULL)
+	{
+		S_FTL_ERR(error, S_MEMERROR,
+				  "_s_voice_image_open",
+				  "Failed to allocate memory for 's_voice_image' object");
+		return NULL;
+	}
+
+	image->path = s_strdup(path, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "_s_voice_image_open",
+				  "Call to \"s_strdup\" failed"))
+		goto quit_error;
+
+	image->ds = SMMapFilesourceOpenFile(path, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "_s_voice_image_open",
+				  "Call to \"SMMapFilesourceOpenFile\" failed for voice image '%s'",
+				  path))
+		goto quit_error;
+
+	/* data loaded in place holds further references to the mapping */
+	SObjectIncRef(S_OBJECT(image->ds));
+
+	image->mem = ((SMMapFilesource*)image->ds)->mem;
+	image->size = ((SMMapFilesource*)image->ds)->map_size;
+
+	/* magic */
+	if ((image->size < S_VOICE_IMAGE_MAGIC_SIZE)
+		|| (memcmp(image->mem, S_VOICE_IMAGE_MAGIC, S_VOICE_IMAGE_MAGIC_SIZE) != 0))
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "_s_voice_image_open",
+				  "File '%s' is not a voice image", path);
+		goto quit_error;
+	}
+
+	pos = S_VOICE_IMAGE_MAGIC_SIZE;
+
+	version = read_uint32(image, &pos, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "_s_voice_image_open",
+				  "Failed to read voice image version"))
+		goto quit_error;
+
+	if (version != S_VOICE_IMAGE_VERSION)
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "_s_voice_image_open",
+				  "Voice image '%s' has version %d, expected version %d",
+				  path, version, S_VOICE_IMAGE_VERSION);
+		goto quit_error;
+	}
+
+	image->num_entries = read_uint32(image, &pos, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "_s_voice_image_open",
+				  "Failed to read voice image number of entries"))
+		goto quit_error;
+
+	image->config_offset = read_uint32(image, &pos, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "_s_voice_image_open",
+				  "Failed to read voice image configuration offset"))
+		goto quit_error;
+
+	image->config_size = read_uint32(image, &pos, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "_s_voice_image_open",
+				  "Failed to read voice image configuration size"))
+		goto quit_error;
+
+	check_region(image, image->config_offset, image->config_size, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "_s_voice_image_open",
+				  "Voice image configuration region is corrupt"))
+		goto quit_error;
+
+	if (image->num_entries > 0)
+	{
+		image->entries = S_CALLOC(s_voice_image_entry, image->num_entries);
+		if (image->entries == NULL)
+		{
+			S_FTL_ERR(error, S_MEMERROR,
+					  "_s_voice_image_open",
+					  "Failed to allocate memory for 's_voice_image_entry' objects");
+			goto quit_error;
+		}
+	}
+
+	for (i = 0; i < image->num_entries; i++)
+	{
+		s_voice_image_entry *entry = &(image->entries[i]);
+
+
+		entry->name = read_string(image, &pos, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "_s_voice_image_open",
+					  "Failed to read voice image entry name"))
+			goto quit_error;
+
+		if (entry->name == NULL)
+		{
+			S_CTX_ERR(error, S_FAILURE,
+					  "_s_voice_image_open",
+					  "Voice image '%s' has a data entry without a name", path);
+			goto quit_error;
+		}
+
+		entry->format = read_string(image, &pos, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "_s_voice_image_open",
+					  "Failed to read voice image entry format"))
+			goto quit_error;
+
+		entry->plugin = read_string(image, &pos, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "_s_voice_image_open",
+					  "Failed to read voice image entry plug-in"))
+			goto quit_error;
+
+		entry->offset = read_uint32(image, &pos, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "_s_voice_image_open",
+					  "Failed to read voice image entry offset"))
+			goto quit_error;
+
+		entry->size = read_uint32(image, &pos, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "_s_voice_image_open",
+					  "Failed to read voice image entry size"))
+			goto quit_error;
+
+		check_region(image, entry->offset, entry->size, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "_s_voice_image_open",
+					  "Voice image data region of entry '%s' is corrupt",
+					  entry->name))
+			goto quit_error;
+	}
+
+	return image;
+
+	/* errors start clean up code here */
+quit_error:
+	{
+		s_erc local_err = S_SUCCESS;
+
+
+		_s_voice_image_close(image, &local_err);
+	}
+
+	return NULL;
+}
+
+
+S_LOCAL SDatasource *_s_voice_image_config_source(const s_voice_image *image,
+												  s_erc *error)
+{
+	SDatasource *ds;
+
+
+	S_CLR_ERR(error);
+
+	if (image == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "_s_voice_image_config_source",
+				  "Argument \"image\" is NULL");
+		return NULL;
+	}
+
+	ds = SMemsourceOpen(&(image->mem[image->config_offset]), image->config_size, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "_s_voice_image_config_source",
+				  "Call to \"SMemsourceOpen\" failed"))
+		return NULL;
+
+	return ds;
+}
+
+
+S_LOCAL SDatasource *_s_voice_image_data_source(const s_voice_image *image,
+												const char *name, const char **format,
+												const char **plugin, s_erc *error)
+{
+	SDatasource *ds;
+	uint32 i;
+	int scomp;
+
+
+	S_CLR_ERR(error);
+
+	if (image == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "_s_voice_image_data_source",
+				  "Argument \"image\" is NULL");
+		return NULL;
+	}
+
+	if (name == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "_s_voice_image_data_source",
+				  "Argument \"name\" is NULL");
+		return NULL;
+	}
+
+	for (i = 0; i < image->num_entries; i++)
+	{
+		scomp = s_strcmp(image->entries[i].name, name, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "_s_voice_image_data_source",
+					  "Call to \"s_strcmp\" failed"))
+			return NULL;
+
+		if (scomp == 0)
+			break;
+	}
+
+	if (i == image->num_entries)
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "_s_voice_image_data_source",
+				  "Voice image '%s' does not have a '%s' data entry",
+				  image->path, name);
+		return NULL;
+	}
+
+	/* the data source keeps the mapping alive for in place data */
+	ds = SMemsourceOpenOwned(&(image->mem[image->entries[i].offset]),
+							 image->entries[i].size, S_OBJECT(image->ds), error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "_s_voice_image_data_source",
+				  "Call to \"SMemsourceOpenOwned\" failed"))
+		return NULL;
+
+	/* data compiled to another format */
+	if (image->entries[i].format != NULL)
+	{
+		*format = image->entries[i].format;
+		*plugin = image->entries[i].plugin;
+	}
+
+	return ds;
+}
+
+
+S_LOCAL const char *_s_voice_image_path(const s_voice_image *image)
+{
+	if (image == NULL)
+		return NULL;
+
+	return image->path;
+}
+
+
+S_LOCAL void _s_voice_image_close(s_voice_image *image, s_erc *error)
+{
+	uint32 i;
+
+
+	S_CLR_ERR(error);
+
+	if (image == NULL)
+		return;
+
+	if (image->entries != NULL)
+	{
+		for (i = 0; i < image->num_entries; i++)
+		{
+			if (image->entries[i].name != NULL)
+				S_FREE(image->entries[i].name);
+
+			if (image->entries[i].format != NULL)
+				S_FREE(image->entries[i].format);
+
+			if (image->entries[i].plugin != NULL)
+				S_FREE(image->entries[i].plugin);
+		}
+
+		S_FREE(image->entries);
+	}
+
+	if (image->ds != NULL)
+		S_DELETE(image->ds, "_s_voice_image_close", error);
+
+	if (image->path != NULL)
+		S_FREE(image->path);
+
+	S_FREE(image);
+}
+
+
+S_LOCAL void _s_voice_image_compile(const char *voice_path, const char *image_path,
+									s_erc *error)
+{
+	SMap *voiceConfig = NULL;
+	SMap *dataConfig = NULL;
+	SIterator *itr = NULL;
+	char *voice_base_path = NULL;
+	SDatasource *configSource = NULL;
+	SDatasource **dataSources = NULL;
+	SMap **convertedData = NULL;
+	SPlugin **convertPlugins = NULL;
+	const s_voice_image_inplace **inplace = NULL;
+	const char **data_names = NULL;
+	long *entry_pos = NULL;
+	SDatasource *out = NULL;
+	uint32 num_entries = 0;
+	uint32 header_size;
+	uint32 offset;
+	uint32 i;
+
+
+	S_CLR_ERR(error);
+
+	if (voice_path == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "_s_voice_image_compile",
+				  "Argument \"voice_path\" is NULL");
+		return;
+	}
+
+	if (image_path == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "_s_voice_image_compile",
+				  "Argument \"image_path\" is NULL");
+		return;
+	}
+
+	voiceConfig = s_json_parse_config_file(voice_path, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "_s_voice_image_compile",
+				  "Call to \"s_json_parse_config_file\" failed for voice config file '%s'",
+				  voice_path))
+		goto quit;
+
+	/* the voice configuration, as is */
+	configSource = SMMapFilesourceOpenFile(voice_path, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "_s_voice_image_compile",
+				  "Call to \"SMMapFilesourceOpenFile\" failed for voice config file '%s'",
+				  voice_path))
+		goto quit;
+
+	voice_base_path = s_get_base_path(voice_path, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "_s_voice_image_compile",
+				  "Call to \"s_get_base_path\" failed"))
+		goto quit;
+
+	dataConfig = _s_load_voice_data_config(voiceConfig, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "_s_voice_image_compile",
+				  "Call to \"_s_load_voice_data_config\" failed for voice config file '%s'",
+				  voice_path))
+		goto quit;
+
+	if (dataConfig != NULL)
+	{
+		num_entries = (uint32)SMapSize(dataConfig, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "_s_voice_image_compile",
+					  "Call to \"SMapSize\" failed"))
+			goto quit;
+	}
+
+	if (num_entries > 0)
+	{
+		dataSources = S_CALLOC(SDatasource*, num_entries);
+		convertedData = S_CALLOC(SMap*, num_entries);
+		convertPlugins = S_CALLOC(SPlugin*, num_entries);
+		inplace = S_CALLOC(const s_voice_image_inplace*, num_entries);
+		data_names = S_CALLOC(const char*, num_entries);
+		entry_pos = S_CALLOC(long, num_entries);
+		if ((dataSources == NULL) || (convertedData == NULL) || (convertPlugins == NULL)
+			|| (inplace == NULL) || (data_names == NULL) || (entry_pos == NULL))
+		{
+			S_FTL_ERR(error, S_MEMERROR,
+					  "_s_voice_image_compile",
+					  "Failed to allocate memory for data entries");
+			goto quit;
+		}
+
+		itr = S_ITERATOR_GET(dataConfig, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "_s_voice_image_compile",
+					  "Call to \"S_ITERATOR_GET\" failed"))
+			goto quit;
+	}
+
+	/* map all the data files, or read the ones that are converted */
+	for (i = 0; itr != NULL; itr = SIteratorNext(itr), i++)
+	{
+		const SMap *dataObjectMap;
+		const char *data_path;
+		const char *data_format;
+		char *combined_path;
+
+
+		data_names[i] = SIteratorKey(itr, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "_s_voice_image_compile",
+					  "Call to \"SIteratorKey\" failed"))
+			goto quit;
+
+		dataObjectMap = S_CAST(SIteratorObject(itr, error), SMap, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "_s_voice_image_compile",
+					  "Data '%s' in voice config file must be a map type",
+					  data_names[i]))
+			goto quit;
+
+		data_path = SMapGetStringDef(dataObjectMap, "path", NULL, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "_s_voice_image_compile",
+					  "Call to \"SMapGetStringDef\" of key 'path' failed"))
+			goto quit;
+
+		if (data_path == NULL)
+		{
+			S_CTX_ERR(error, S_FAILURE,
+					  "_s_voice_image_compile",
+					  "Data '%s' in voice config file does not have a 'path' key",
+					  data_names[i]);
+			goto quit;
+		}
+
+		data_format = SMapGetStringDef(dataObjectMap, "format", NULL, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "_s_voice_image_compile",
+					  "Call to \"SMapGetStringDef\" of key 'format' failed"))
+			goto quit;
+
+		inplace[i] = get_inplace_format(data_format, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "_s_voice_image_compile",
+					  "Call to \"get_inplace_format\" failed"))
+			goto quit;
+
+		combined_path = s_path_combine(voice_base_path, data_path, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "_s_voice_image_compile",
+					  "Call to \"s_path_combine\" failed"))
+			goto quit;
+
+		if (inplace[i] != NULL)
+		{
+			convertPlugins[i] = s_pm_load_plugin(inplace[i]->image_plugin, error);
+			if (S_CHK_ERR(error, S_CONTERR,
+						  "_s_voice_image_compile",
+						  "Call to \"s_pm_load_plugin\" failed for plug-in '%s' of data '%s'",
+						  inplace[i]->image_plugin, data_names[i]))
+			{
+				S_FREE(combined_path);
+				goto quit;
+			}
+
+			convertedData[i] = s_json_parse_config_file(combined_path, error);
+			if (S_CHK_ERR(error, S_CONTERR,
+						  "_s_voice_image_compile",
+						  "Call to \"s_json_parse_config_file\" failed for data '%s' at '%s'",
+						  data_names[i], combined_path))
+			{
+				S_FREE(combined_path);
+				goto quit;
+			}
+		}
+		else
+		{
+			dataSources[i] = SMMapFilesourceOpenFile(combined_path, error);
+			if (S_CHK_ERR(error, S_CONTERR,
+						  "_s_voice_image_compile",
+						  "Call to \"SMMapFilesourceOpenFile\" failed for data '%s' at '%s'",
+						  data_names[i], combined_path))
+			{
+				S_FREE(combined_path);
+				goto quit;
+			}
+		}
+
+		S_FREE(combined_path);
+	}
+
+	/* compute the header size, the blobs follow it */
+	header_size = S_VOICE_IMAGE_MAGIC_SIZE + 4 * sizeof(uint32);
+	for (i = 0; i < num_entries; i++)
+	{
+		header_size += 5 * sizeof(uint32) + s_strlen(data_names[i], error);
+		if (inplace[i] != NULL)
+			header_size += s_strlen(inplace[i]->image_format, error)
+				+ s_strlen(inplace[i]->image_plugin, error);
+	}
+
+	out = SFilesourceOpenFile(image_path, "wb", error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "_s_voice_image_compile",
+				  "Call to \"SFilesourceOpenFile\" failed for voice image '%s'",
+				  image_path))
+		goto quit;
+
+	SDatasourceSetByteOrder(out, S_BYTEORDER_LE, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "_s_voice_image_compile",
+				  "Call to \"SDatasourceSetByteOrder\" failed"))
+		goto quit;
+
+	SDatasourceWrite(out, S_VOICE_IMAGE_MAGIC, 1, S_VOICE_IMAGE_MAGIC_SIZE, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "_s_voice_image_compile",
+				  "Failed to write voice image magic"))
+		goto quit;
+
+	offset = align_offset(header_size);
+
+	s_uint32_write(out, S_VOICE_IMAGE_VERSION, error);
+	s_uint32_write(out, num_entries, error);
+	s_uint32_write(out, offset, error);
+	s_uint32_write(out, (uint32)((SMMapFilesource*)configSource)->map_size, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "_s_voice_image_compile",
+				  "Failed to write voice image header"))
+		goto quit;
+
+	/* the data offsets and sizes are filled in after the blobs are written */
+	for (i = 0; i < num_entries; i++)
+	{
+		write_string(out, data_names[i], error);
+		write_string(out, (inplace[i] != NULL) ? inplace[i]->image_format : NULL, error);
+		write_string(out, (inplace[i] != NULL) ? inplace[i]->image_plugin : NULL, error);
+		entry_pos[i] = SDatasourceTell(out, error);
+		s_uint32_write(out, 0, error);
+		s_uint32_write(out, 0, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "_s_voice_image_compile",
+					  "Failed to write voice image entry '%s'",
+					  data_names[i]))
+			goto quit;
+	}
+
+	/* blobs */
+	write_padding(out, header_size, error);
+	SDatasourceWrite(out, ((SMMapFilesource*)configSource)->mem, 1,
+					 ((SMMapFilesource*)configSource)->map_size, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "_s_voice_image_compile",
+				  "Failed to write voice image configuration"))
+		goto quit;
+
+	for (i = 0; i < num_entries; i++)
+	{
+		uint32 data_size;
+
+
+		write_padding(out, (uint32)SDatasourceTell(out, error), error);
+		offset = (uint32)SDatasourceTell(out, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "_s_voice_image_compile",
+					  "Failed to align voice image data '%s'",
+					  data_names[i]))
+			goto quit;
+
+		if (inplace[i] != NULL)
+			SObjectSaveToDatasource(S_OBJECT(convertedData[i]), out,
+									inplace[i]->image_format, error);
+		else
+			SDatasourceWrite(out, ((SMMapFilesource*)dataSources[i])->mem, 1,
+							 ((SMMapFilesource*)dataSources[i])->map_size, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "_s_voice_image_compile",
+					  "Failed to write voice image data '%s'",
+					  data_names[i]))
+			goto quit;
+
+		data_size = (uint32)SDatasourceTell(out, error) - offset;
+		write_uint32_at(out, offset, entry_pos[i], error);
+		write_uint32_at(out, data_size, entry_pos[i] + sizeof(uint32), error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "_s_voice_image_compile",
+					  "Failed to write voice image entry '%s'",
+					  data_names[i]))
+			goto quit;
+	}
+
+	/* normal exit and errors clean up code here */
+quit:
+	if (itr != NULL)
+		S_DELETE(itr, "_s_voice_image_compile", error);
+
+	if (out != NULL)
+		S_DELETE(out, "_s_voice_image_compile", error);
+
+	for (i = 0; i < num_entries; i++)
+	{
+		if ((dataSources != NULL) && (dataSources[i] != NULL))
+			S_DELETE(dataSources[i], "_s_voice_image_compile", error);
+
+		/* before the plug-in of the format */
+		if ((convertedData != NULL) && (convertedData[i] != NULL))
+			S_DELETE(convertedData[i], "_s_voice_image_compile", error);
+
+		if ((convertPlugins != NULL) && (convertPlugins[i] != NULL))
+			S_DELETE(convertPlugins[i], "_s_voice_image_compile", error);
+	}
+
+	if (dataSources != NULL)
+		S_FREE(dataSources);
+
+	if (convertedData != NULL)
+		S_FREE(convertedData);
+
+	if (convertPlugins != NULL)
+		S_FREE(convertPlugins);
+
+	if (inplace != NULL)
+		S_FREE(inplace);
+
+	if (data_names != NULL)
+		S_FREE(data_names);
+
+	if (entry_pos != NULL)
+		S_FREE(entry_pos);
+
+	if (configSource != NULL)
+		S_DELETE(configSource, "_s_voice_image_compile", error);
+
+	if (voice_base_path != NULL)
+		S_FREE(voice_base_path);
+
+	if (dataConfig != NULL)
+		S_DELETE(dataConfig, "_s_voice_image_compile", error);
+
+	if (voiceConfig != NULL)
+		S_DELETE(voiceConfig, "_s_voice_image_compile", error);
+}
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static function implementations                                                  */
+/*                                                                                  */
+/************************************************************************************/
+
+static uint32 read_uint32(const s_voice_image *image, size_t *pos, s_erc *error)
+{
+	const uint8 *p;
+
+
+	S_CLR_ERR(error);
+
+	if ((*pos + sizeof(uint32)) > image->size)
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "read_uint32",
+				  "Voice image '%s' is truncated",
+				  image->path);
+		return 0;
+	}
+
+	/* always little endian */
+	p = &(image->mem[*pos]);
+	*pos += sizeof(uint32);
+
+	return ((uint32)p[0]
+			| ((uint32)p[1] << 8)
+			| ((uint32)p[2] << 16)
+			| ((uint32)p[3] << 24));
+}
+
+
+static void check_region(const s_voice_image *image, uint32 offset, uint32 size,
+						 s_erc *error)
+{
+	S_CLR_ERR(error);
+
+	if (((size_t)offset > image->size)
+		|| ((size_t)size > (image->size - (size_t)offset)))
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "check_region",
+				  "Region [%lu, %lu) is outside of voice image '%s' of size %lu",
+				  (unsigned long)offset, (unsigned long)offset + size,
+				  image->path, (unsigned long)image->size);
+	}
+}
+
+
+static void write_padding(SDatasource *ds, uint32 pos, s_erc *error)
+{
+	static const uint8 zeros[S_VOICE_IMAGE_ALIGN] = { 0 };
+	uint32 pad;
+
+
+	S_CLR_ERR(error);
+
+	pad = align_offset(pos) - pos;
+	if (pad == 0)
+		return;
+
+	SDatasourceWrite(ds, zeros, 1, pad, error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "write_padding",
+			  "Call to \"SDatasourceWrite\" failed");
+}
+
+
+static uint32 align_offset(uint32 offset)
+{
+	return (offset + (S_VOICE_IMAGE_ALIGN - 1)) & ~((uint32)(S_VOICE_IMAGE_ALIGN - 1));
+}
+
+
+/* a string is its length and its characters, an empty string is read as NULL */
+static char *read_string(const s_voice_image *image, size_t *pos, s_erc *error)
+{
+	char *string;
+	uint32 size;
+
+
+	S_CLR_ERR(error);
+
+	size = read_uint32(image, pos, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "read_string",
+				  "Failed to read string size"))
+		return NULL;
+
+	if (size == 0)
+		return NULL;
+
+	check_region(image, (uint32)*pos, size, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "read_string",
+				  "String region is corrupt"))
+		return NULL;
+
+	string = S_MALLOC(char, size + 1);
+	if (string == NULL)
+	{
+		S_FTL_ERR(error, S_MEMERROR,
+				  "read_string",
+				  "Failed to allocate memory for 'char' object");
+		return NULL;
+	}
+
+	memcpy(string, &(image->mem[*pos]), size);
+	string[size] = '\0';
+	*pos += size;
+
+	return string;
+}
+
+
+static void write_string(SDatasource *ds, const char *string, s_erc *error)
+{
+	uint32 size;
+
+
+	S_CLR_ERR(error);
+
+	size = (string != NULL) ? (uint32)strlen(string) : 0;
+
+	s_uint32_write(ds, size, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "write_string",
+				  "Call to \"s_uint32_write\" failed"))
+		return;
+
+	if (size == 0)
+		return;
+
+	SDatasourceWrite(ds, string, 1, size, error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "write_string",
+			  "Call to \"SDatasourceWrite\" failed");
+}
+
+
+static void write_uint32_at(SDatasource *ds, uint32 value, long pos, s_erc *error)
+{
+	uint8 p[4];
+
+
+	S_CLR_ERR(error);
+
+	/* always little endian */
+	p[0] = (uint8)(value & 0xFF);
+	p[1] = (uint8)((value >> 8) & 0xFF);
+	p[2] = (uint8)((value >> 16) & 0xFF);
+	p[3] = (uint8)((value >> 24) & 0xFF);
+
+	SDatasourceWriteAt(ds, p, 1, 4, pos, error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "write_uint32_at",
+			  "Call to \"SDatasourceWriteAt\" failed");
+}
+
+
+static const s_voice_image_inplace *get_inplace_format(const char *format,
+													   s_erc *error)
+{
+	const s_voice_image_inplace *inplace;
+	int scomp;
+
+
+	S_CLR_ERR(error);
+
+	if (format == NULL)
+		return NULL;
+
+	for (inplace = inplace_formats; inplace->format != NULL; inplace++)
+	{
+		scomp = s_strcmp(inplace->format, format, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "get_inplace_format",
+					  "Call to \"s_strcmp\" failed"))
+			return NULL;
+
+		if (scomp == 0)
+			return inplace;
+	}
+
+	return NULL;
+}
@@ -0,0 +1,231 @@
+/************************************************************************************/
+/* Copyright (c) 2008-2011 The Department of Arts and Culture,                      */
+/* The Government of the Republic of South Africa.                                  */
+/*                                                                                  */
+/* Contributors:  Meraka Institute, CSIR, South Africa.                             */
+/*                                                                                  */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy     */
+/* of this software and associated documentation files (the "Software"), to deal    */
+/* in the Software without restriction, including without limitation the rights     */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        */
+/* copies of the Software, and to permit persons to whom the Software is            */
+/* furnished to do so, subject to the following conditions:                         */
+/* The above copyright notice and this permission notice shall be included in       */
+/* all copies or substantial portions of the Software.                              */
+/*                                                                                  */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN        */
+/* THE SOFTWARE.                                                                    */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* AUTHOR  : Speect contributors                                                    */
+/* DATE    : 19 October 2026                                                        */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* Precompiled single file voice images.                                            */
+/*                                                                                  */
+/*                                                                                  */
+/************************************************************************************/
+
+#ifndef _SPCT_VOICE_IMAGE_H__
+#define _SPCT_VOICE_IMAGE_H__
+
+
+/**
+ * @file voicemanager/image.h
+ * Precompiled single file voice images.
+ */
+
+
+/**
+ * @ingroup SVoiceManager
+ * @defgroup SVoiceImage Voice Images
+ * A voice image bundles a voice configuration file and all the data
+ * files it references into one file, see #s_vm_compile_voice. The
+ * image is memory mapped when loaded, and the voice data objects are
+ * read from the mapped memory with the data format's
+ * @c load_from_datasource method, without opening any further files.
+ *
+ * Data formats that have a binary layout which can be queried in
+ * place are serialized into that layout when the image is compiled:
+ * JSON lexicons are stored as trie lexicons (format
+ * "spct_lexicon_trie", see #SLexiconTrie). When loaded, such data
+ * uses the image mapping directly instead of a copy, so startup does
+ * not parse it and processes that load the same image share its
+ * pages. The data keeps a reference to the mapping (see
+ * #SMemsourceOpenOwned), which therefore stays valid while the data is
+ * in use. The other data entries are stored as is and deserialized
+ * into the usual in-memory objects.
+ *
+ * The image layout is (all integers are little endian #uint32):
+ * @verbatim
+   "SPCTVIMG"                  magic (8 bytes)
+   version
+   number of data entries
+   voice configuration offset
+   voice configuration size
+   data entries:
+      name length, name (not NULL terminated)
+      format length, format (0 if as in the voice configuration)
+      plug-in length, plug-in (0 if as in the voice configuration)
+      data offset
+      data size
+   voice configuration and data blobs (8 byte aligned)
+   @endverbatim
+ * Offsets are relative to the start of the image.
+ * @{
+ */
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Modules used                                                                     */
+/*                                                                                  */
+/************************************************************************************/
+
+#include "include/common.h"
+#include "base/errdbg/errdbg.h"
+#include "datasources/data_source.h"
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Begin external c declaration                                                     */
+/*                                                                                  */
+/************************************************************************************/
+S_BEGIN_C_DECLS
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Typedefs                                                                         */
+/*                                                                                  */
+/************************************************************************************/
+
+/**
+ * Type definition of the opaque voice image.
+ */
+typedef struct s_voice_image s_voice_image;
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Function prototypes                                                              */
+/*                                                                                  */
+/************************************************************************************/
+
+/**
+ * Query if the file at the given path is a voice image.
+ * @private
+ *
+ * @param path The full path and name of the file.
+ * @param error Error code.
+ *
+ * @return #TRUE if the file starts with the voice image magic,
+ * otherwise #FALSE.
+ */
+S_LOCAL s_bool _s_voice_image_check(const char *path, s_erc *error);
+
+
+/**
+ * Open and memory map the voice image at the given path.
+ * @private
+ *
+ * @param path The full path and name of the voice image.
+ * @param error Error code.
+ *
+ * @return The opened voice image.
+ */
+S_LOCAL s_voice_image *_s_voice_image_open(const char *path, s_erc *error);
+
+
+/**
+ * Get a data source for the voice configuration in the given voice
+ * image.
+ * @private
+ *
+ * @param image The voice image.
+ * @param error Error code.
+ *
+ * @return Data source, the caller is responsible for the memory.
+ */
+S_LOCAL SDatasource *_s_voice_image_config_source(const s_voice_image *image,
+												  s_erc *error);
+
+
+/**
+ * Get a data source for the named data entry in the given voice
+ * image. The data source holds a reference to the image mapping, so
+ * a data object may keep it to use the memory in place.
+ * @private
+ *
+ * @param image The voice image.
+ * @param name The data entry name (as in the voice configuration).
+ * @param format The data format of the voice configuration, replaced
+ * by the format of the data in the image if it was converted.
+ * @param plugin The data plug-in of the voice configuration, replaced
+ * by the plug-in of the format of the data in the image if it was
+ * converted.
+ * @param error Error code.
+ *
+ * @return Data source, the caller is responsible for the memory.
+ */
+S_LOCAL SDatasource *_s_voice_image_data_source(const s_voice_image *image,
+												const char *name, const char **format,
+												const char **plugin, s_erc *error);
+
+
+/**
+ * Get the path of the given voice image.
+ * @private
+ *
+ * @param image The voice image.
+ *
+ * @return The voice image path.
+ */
+S_LOCAL const char *_s_voice_image_path(const s_voice_image *image);
+
+
+/**
+ * Unmap and free the given voice image.
+ * @private
+ *
+ * @param image The voice image.
+ * @param error Error code.
+ */
+S_LOCAL void _s_voice_image_close(s_voice_image *image, s_erc *error);
+
+
+/**
+ * Compile the voice configuration file at @c voice_path, and all the
+ * data files it references, into a voice image at @c image_path.
+ * @private
+ *
+ * @param voice_path The full path and name of the voice configuration file.
+ * @param image_path The full path and name of the voice image to write.
+ * @param error Error code.
+ */
+S_LOCAL void _s_voice_image_compile(const char *voice_path, const char *image_path,
+									s_erc *error);
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* End external c declaration                                                       */
+/*                                                                                  */
+/************************************************************************************/
+S_END_C_DECLS
+
+
+/**
+ * @}
+ * end documentation
+ */
+
+#endif /* _SPCT_VOICE_IMAGE_H__ */
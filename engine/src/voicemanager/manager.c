@@ -46,8 +46,11 @@
 #include "containers/containers.h"
 #include "serialization/serialize.h"
 #include "pluginmanager/pluginmanager.h"
+#include "main/profile.h"
+#include "main/trace.h"
 #include "voicemanager/loaders/loaders.h"
 #include "voicemanager/voice.h"
+#include "voicemanager/image.h"
 #include "voicemanager/manager.h"
 
 
@@ -95,6 +98,7 @@ S_DECLARE_MUTEX_STATIC(vm_mutex);
 
 static const SObject *load_data(const char *plugin_path,
 								const char *data_path,
+								SDatasource *ds,
 								const char *data_format,
 								s_erc *error);
 
@@ -108,7 +112,8 @@ static void cache_add(const SObject *dataEntry, const char *data_path,
 static void cache_remove(const char *data_path, const char *data_identity,
 						 s_erc *error);
 
-static SVoice *load_voice_no_data(const char *path, SMap **dataConfig, s_erc *error);
+static SVoice *load_voice_no_data(const char *path, const s_voice_image *image,
+								  SMap **dataConfig, s_erc *error);
 
 static s_bool data_loaded(SObject *dataObject, s_erc *error);
 
@@ -127,6 +132,10 @@ S_API SVoice *s_vm_load_voice(const char *path, s_erc *error)
 {
 	SVoice *voice;
 	SMap *dataConfig = NULL;
+	s_voice_image *image = NULL;
+	s_bool is_image;
+	s_profile_mark total_mark;
+	s_profile_mark mark;
 
 
 	S_CLR_ERR(error);
@@ -139,21 +148,60 @@ S_API SVoice *s_vm_load_voice(const char *path, s_erc *error)
 		return NULL;
 	}
 
+	_s_profile_begin(&total_mark);
+
+	/* is it a precompiled voice image or a voice config file? */
+	is_image = _s_voice_image_check(path, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "s_vm_load_voice",
+				  "Call to \"_s_voice_image_check\" failed"))
+		return NULL;
+
+	if (is_image)
+	{
+		image = _s_voice_image_open(path, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "s_vm_load_voice",
+					  "Call to \"_s_voice_image_open\" failed"))
+			return NULL;
+	}
+
 	s_mutex_lock(&vm_mutex);
-	voice = load_voice_no_data(path, &dataConfig, error);
+	voice = load_voice_no_data(path, image, &dataConfig, error);
 	s_mutex_unlock(&vm_mutex);
 
 	if (S_CHK_ERR(error, S_CONTERR,
 				  "s_vm_load_voice",
 				  "Call to \"load_voice_no_data\" failed"))
+	{
+		if (image != NULL)
+			_s_voice_image_close(image, error);
 		return NULL;
+	}
+
+	if (image != NULL)
+	{
+		/* voice takes hold of image */
+		_s_voice_set_image(voice, image, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "s_vm_load_voice",
+					  "Call to \"_s_voice_set_image\" failed"))
+		{
+			_s_voice_image_close(image, error);
+			S_DELETE(voice, "s_vm_load_voice", error);
+			S_DELETE(dataConfig, "s_vm_load_voice", error);
+			return NULL;
+		}
+	}
 
 	/*
 	 * Now load data.
 	 * Data is loaded by voice and not above because the voice data
 	 * type is opaque and defined in the voice.
 	 */
+	_s_profile_begin(&mark);
 	_s_voice_load_data(voice, dataConfig, error); /* mutex is locked by _s_vm_load_data */
+	_s_profile_end(&mark, "voice", "data");
 	if (S_CHK_ERR(error, S_CONTERR,
 				  "s_vm_load_voice",
 				  "Call to \"_s_voice_load_data\" failed"))
@@ -164,6 +212,20 @@ S_API SVoice *s_vm_load_voice(const char *path, s_erc *error)
 	}
 
 	S_DELETE(dataConfig, "s_vm_load_voice", error);
+
+	/* resolve the utterance processors of the utterance types */
+	_s_voice_compile_utt_plans(voice, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "s_vm_load_voice",
+				  "Call to \"_s_voice_compile_utt_plans\" failed"))
+	{
+		S_DELETE(voice, "s_vm_load_voice", error);
+		return NULL;
+	}
+
+	_s_profile_end(&total_mark, "voice", "load '%s'", path);
+	_s_profile_dump();
+
 	return voice;
 }
 
@@ -231,7 +293,7 @@ S_LOCAL const SObject *_s_vm_load_data(const char *plugin_path,
 	}
 
 	s_mutex_lock(&vm_mutex);
-	dataObject = load_data(plugin_path, data_path, data_format, error);
+	dataObject = load_data(plugin_path, data_path, NULL, data_format, error);
 	s_mutex_unlock(&vm_mutex);
 
 	if (S_CHK_ERR(error, S_CONTERR,
@@ -243,6 +305,76 @@ S_LOCAL const SObject *_s_vm_load_data(const char *plugin_path,
 }
 
 
+S_LOCAL const SObject *_s_vm_load_data_from_source(const char *plugin_path,
+												   const char *data_id,
+												   SDatasource *ds,
+												   const char *data_format,
+												   s_erc *error)
+{
+	const SObject *dataObject;
+
+
+	S_CLR_ERR(error);
+
+	if (ds == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "_s_vm_load_data_from_source",
+				  "Argument \"ds\" is NULL");
+		return NULL;
+	}
+
+	if ((plugin_path == NULL) || (data_id == NULL) || (data_format == NULL))
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "_s_vm_load_data_from_source",
+				  "Argument \"plugin_path\", \"data_id\" or \"data_format\" is NULL");
+		S_DELETE(ds, "_s_vm_load_data_from_source", error);
+		return NULL;
+	}
+
+	s_mutex_lock(&vm_mutex);
+	dataObject = load_data(plugin_path, data_id, ds, data_format, error);
+	s_mutex_unlock(&vm_mutex);
+
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "_s_vm_load_data_from_source",
+				  "Call to \"load_data\" failed"))
+		return NULL;
+
+	return dataObject;
+}
+
+
+S_API void s_vm_compile_voice(const char *voice_path, const char *image_path,
+							  s_erc *error)
+{
+	S_CLR_ERR(error);
+
+	if (voice_path == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "s_vm_compile_voice",
+				  "Argument \"voice_path\" is NULL");
+		return;
+	}
+
+	if (image_path == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "s_vm_compile_voice",
+				  "Argument \"image_path\" is NULL");
+		return;
+	}
+
+	_s_voice_image_compile(voice_path, image_path, error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "s_vm_compile_voice",
+			  "Call to \"_s_voice_image_compile\" failed for voice config file '%s'",
+			  voice_path);
+}
+
+
 S_LOCAL void _s_vm_unload_data(SObject *dataObject, s_erc *error)
 {
 	S_CLR_ERR(error);
@@ -354,21 +486,46 @@ S_LOCAL void _s_vm_quit(s_erc *error)
 /*                                                                                  */
 /************************************************************************************/
 
-static SVoice *load_voice_no_data(const char *path, SMap **dataConfig, s_erc *error)
+static SVoice *load_voice_no_data(const char *path, const s_voice_image *image,
+								  SMap **dataConfig, s_erc *error)
 {
 	SVoice *voice;
 	SMap *voiceConfig;
+	s_profile_mark mark;
 
 
 	S_CLR_ERR(error);
 
-	voiceConfig = s_json_parse_config_file(path, error);
+	_s_profile_begin(&mark);
+
+	if (image != NULL)
+	{
+		SDatasource *ds;
+
+
+		ds = _s_voice_image_config_source(image, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "load_voice_no_data",
+					  "Call to \"_s_voice_image_config_source\" failed for voice image '%s'",
+					  path))
+			return NULL;
+
+		/* takes hold of ds */
+		voiceConfig = s_json_parse_config_datasource(ds, error);
+	}
+	else
+	{
+		voiceConfig = s_json_parse_config_file(path, error);
+	}
+
 	if (S_CHK_ERR(error, S_CONTERR,
 				  "load_voice_no_data",
-				  "Call to \"s_json_parse_config_file\" failed for voice config file '%s'",
+				  "Failed to parse voice config of '%s'",
 				  path))
 		return NULL;
 
+	_s_profile_end(&mark, "voice", "config");
+
 	voice = S_NEW(SVoice, error);
 	if (S_CHK_ERR(error, S_CONTERR,
 				  "load_voice_no_data",
@@ -389,7 +546,9 @@ static SVoice *load_voice_no_data(const char *path, SMap **dataConfig, s_erc *er
 		return NULL;
 	}
 
+	_s_profile_begin(&mark);
 	voice->plugins = _s_load_voice_plugins(voiceConfig, error);
+	_s_profile_end(&mark, "voice", "plug-ins");
 	if (S_CHK_ERR(error, S_CONTERR,
 				  "load_voice_no_data",
 				  "Call to \"_s_load_voice_plugins\" failed for '%s' voice config file",
@@ -423,9 +582,11 @@ static SVoice *load_voice_no_data(const char *path, SMap **dataConfig, s_erc *er
 		return NULL;
 	}
 
+	_s_profile_begin(&mark);
 	voice->featProcessors = _s_load_voice_feature_processors(voiceConfig,
 															 voice->plugins,
 															 error);
+	_s_profile_end(&mark, "voice", "feature processors");
 	if (S_CHK_ERR(error, S_CONTERR,
 				  "load_voice_no_data",
 				  "Call to \"_s_load_voice_feature_processors\" failed for '%s' voice config file",
@@ -436,7 +597,9 @@ static SVoice *load_voice_no_data(const char *path, SMap **dataConfig, s_erc *er
 		return NULL;
 	}
 
+	_s_profile_begin(&mark);
 	_s_load_voice_utterance_processors(voiceConfig, voice, error);
+	_s_profile_end(&mark, "voice", "utterance processors");
 	if (S_CHK_ERR(error, S_CONTERR,
 				  "load_voice_no_data",
 				  "Call to \"_s_load_voice_utterance_processors\" failed for '%s' voice config file",
@@ -447,7 +610,9 @@ static SVoice *load_voice_no_data(const char *path, SMap **dataConfig, s_erc *er
 		return NULL;
 	}
 
+	_s_profile_begin(&mark);
 	voice->uttTypes = _s_get_voice_utterance_types(voiceConfig, error);
+	_s_profile_end(&mark, "voice", "utterance types");
 	if (S_CHK_ERR(error, S_CONTERR,
 				  "load_voice_no_data",
 				  "Call to \"_s_get_voice_utterance_processors\" failed for '%s' voice config file",
@@ -477,6 +642,7 @@ static SVoice *load_voice_no_data(const char *path, SMap **dataConfig, s_erc *er
 
 static const SObject *load_data(const char *plugin_path,
 								const char *data_path,
+								SDatasource *ds,
 								const char *data_format,
 								s_erc *error)
 {
@@ -485,6 +651,7 @@ static const SObject *load_data(const char *plugin_path,
 	char *data_identity;
 	dataType *dataEntry;
 	SObject *tmp;
+	s_profile_mark mark;
 
 
 	S_CLR_ERR(error);
@@ -494,10 +661,17 @@ static const SObject *load_data(const char *plugin_path,
 				  "load_data",
 				  "Call to \"SMapGetObjectDef\" for data object at path \'%s\' failed",
 				  data_path))
+	{
+		if (ds != NULL)
+			S_DELETE(ds, "load_data", error);
 		return NULL;
+	}
 
 	if (tmp != NULL)
 	{
+		if (ds != NULL)
+			S_DELETE(ds, "load_data", error);
+
 		/*
 		 * it's loaded, increase the dataType object tmp's reference
 		 * count, and return the data object.
@@ -523,12 +697,23 @@ static const SObject *load_data(const char *plugin_path,
 				  "load_data",
 				  "Call to \"s_pm_load_plugin\" failed of data plug-in at \'%s\'",
 				  plugin_path))
+	{
+		if (ds != NULL)
+			S_DELETE(ds, "load_data", error);
 		return NULL;
+	}
 
-	dataObject = SObjectLoad(data_path, data_format, error);
+	_s_profile_begin(&mark);
+	S_TRACE_BEGIN("data", data_path);
+	if (ds != NULL)
+		dataObject = SObjectLoadFromDatasource(ds, data_format, error); /* takes hold of ds */
+	else
+		dataObject = SObjectLoad(data_path, data_format, error);
+	S_TRACE_END("data", data_path);
+	_s_profile_end(&mark, "data", "load '%s'", data_path);
 	if (S_CHK_ERR(error, S_CONTERR,
 				  "load_data",
-				  "Call to \"SObjectLoad\" failed for data at path \'%s\'",
+				  "Call to \"SObjectLoad/SObjectLoadFromDatasource\" failed for data at path \'%s\'",
 				  data_path))
 	{
 		S_DELETE(dataPlugin, "load_data", error);
@@ -61,6 +61,7 @@
 
 #include "include/common.h"
 #include "voicemanager/voice.h"
+#include "datasources/data_source.h"
 #include "base/errdbg/errdbg.h"
 
 
@@ -96,6 +97,25 @@ S_BEGIN_C_DECLS
 S_API SVoice *s_vm_load_voice(const char *path, s_erc *error);
 
 
+/**
+ * Compile the voice of the given voice config file, and all of its
+ * data files, into a single precompiled voice image file. The voice
+ * image can be loaded with #s_vm_load_voice in place of the voice
+ * config file, in which case the voice data is read from a memory map
+ * of the image.
+ *
+ * @note JSON lexicons are compiled to trie lexicons, which are
+ * queried in place in the mapped image. The other data objects are
+ * still deserialized when the image is loaded, see @ref SVoiceImage.
+ *
+ * @param voice_path The full path and name of the voice config file.
+ * @param image_path The full path and name of the voice image to create.
+ * @param error Error code.
+ */
+S_API void s_vm_compile_voice(const char *voice_path, const char *image_path,
+							  s_erc *error);
+
+
 /**
  * Load the data object described by the given parameters. If
  * the data object has already been loaded, then it is shared. This
@@ -118,6 +138,31 @@ S_LOCAL const SObject *_s_vm_load_data(const char *plugin_path,
 									   s_erc *error);
 
 
+/**
+ * Load the data object described by the given parameters from the
+ * given data source. If a data object with the given identifier has
+ * already been loaded, then it is shared.
+ * Used internally by #SVoice for precompiled voice images.
+ *
+ * @private
+ * @param plugin_path The full path and name of the plug-in of this
+ * data object.
+ * @param data_id A unique identifier of the data object.
+ * @param ds The data source to read the data object from.
+ * @param data_format The format of this data object.
+ * @param error Error code.
+ *
+ * @return The loaded data object.
+ *
+ * @note Takes hold of the data source, even on error.
+ */
+S_LOCAL const SObject *_s_vm_load_data_from_source(const char *plugin_path,
+												   const char *data_id,
+												   SDatasource *ds,
+												   const char *data_format,
+												   s_erc *error);
+
+
 /**
  * Unload the given voice data object. If the object is still
  * referenced by other voices then it is not unloaded.
@@ -0,0 +1,1817 @@
+/************************************************************************************/
+/* Copyright (c) 2008-2011 The Department of Arts and Culture,                      */
+/* The Government of the Republic of South Africa.                                  */
+/*                                                                                  */
+/* Contributors:  Meraka Institute, CSIR, South Africa.                             */
+/*                                                                                  */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy     */
+/* of this software and associated documentation files (the "Software"), to deal    */
+/* in the Software without restriction, including without limitation the rights     */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        */
+/* copies of the Software, and to permit persons to whom the Software is            */
+/* furnished to do so, subject to the following conditions:                         */
+/* The above copyright notice and this permission notice shall be included in       */
+/* all copies or substantial portions of the Software.                              */
+/*                                                                                  */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN        */
+/* THE SOFTWARE.                                                                    */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* AUTHOR  : Speect contributors                                                    */
+/* DATE    : 19 October 2026                                                        */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* Cache of synthesized audio, with memory and disk tiers.                          */
+/*                                                                                  */
+/*                                                                                  */
+/************************************************************************************/
+
+/************************************************************************************/
+/*                                                                                  */
+/* Modules used                                                                     */
+/*                                                                                  */
+/************************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "base/utils/alloc.h"
+#include "base/utils/byteswap.h"
+#include "base/utils/path.h"
+#include "base/strings/strings.h"
+#include "base/strings/sprint.h"
+#include "base/containers/hashtable/hash_functions.h"
+#include "voicemanager/voice.h"
+#include "voicemanager/synthcache.h"
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Defines                                                                          */
+/*                                                                                  */
+/************************************************************************************/
+
+/* initial size of the hash tables, 2^S_CACHE_TABLE_SIZE */
+#define S_CACHE_TABLE_SIZE 8
+
+/* size of the RIFF header of the disk tier files */
+#define S_CACHE_RIFF_HEADER 44
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Data types                                                                       */
+/*                                                                                  */
+/************************************************************************************/
+
+struct s_synth_cache_entry
+{
+	const char          *key;          /*!< Key, owned by the hash table element. */
+	float               *samples;      /*!< Samples, or NULL for an object.       */
+	SObject             *object;       /*!< Audio object, or NULL for samples.    */
+	uint32               num_samples;  /*!< Number of samples.                    */
+	uint32               sample_rate;  /*!< Sample rate.                          */
+	size_t               bytes;        /*!< Size of the entry.                    */
+	s_synth_cache_entry *newer;        /*!< More recently used entry.             */
+	s_synth_cache_entry *older;        /*!< Less recently used entry.             */
+};
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static variables                                                                 */
+/*                                                                                  */
+/************************************************************************************/
+
+static SSynthCacheClass SynthCacheClass; /* SSynthCache class declaration. */
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static function prototypes                                                       */
+/*                                                                                  */
+/************************************************************************************/
+
+static void free_entry(void *key, void *data, s_erc *error);
+
+static void free_index_entry(void *key, void *data, s_erc *error);
+
+static void lru_unlink(SSynthCache *self, s_synth_cache_entry *entry);
+
+static void lru_push(SSynthCache *self, s_synth_cache_entry *entry);
+
+static void memory_remove(SSynthCache *self, const char *key, s_erc *error);
+
+static s_synth_cache_entry *memory_insert(SSynthCache *self, const char *key,
+										  size_t bytes, s_erc *error);
+
+static void memory_add(SSynthCache *self, const char *key, const float *samples,
+					   uint32 num_samples, uint32 sample_rate, s_erc *error);
+
+static void store_samples(SSynthCache *self, const char *key, const float *samples,
+						  uint32 num_samples, uint32 sample_rate,
+						  const ulong *clears, s_erc *error);
+
+static void store_object(SSynthCache *self, const char *key, const SObject *object,
+						 const ulong *clears, s_erc *error);
+
+static void load_index(SSynthCache *self, s_erc *error);
+
+static void index_add(SSynthCache *self, const char *key, const char *file_name,
+					  s_erc *error);
+
+static void index_append(SSynthCache *self, const char *key, const char *file_name,
+						 s_erc *error);
+
+static char *disk_file_name(const char *key, s_erc *error);
+
+static void put_le32(s_byte *buf, uint32 val);
+
+static uint32 get_le32(const s_byte *buf);
+
+static void disk_write(const char *path, const float *samples, uint32 num_samples,
+					   uint32 sample_rate, s_erc *error);
+
+static float *disk_read(const char *path, uint32 *num_samples, uint32 *sample_rate,
+						s_erc *error);
+
+static float get_param(const SVoice *voice, const SUtterance *utt,
+					   const char *name, float def, s_erc *error);
+
+static char *normalize_text(const char *text, s_erc *error);
+
+static char *make_key(const SVoice *voice, const char *utt_type,
+					  const SUtterance *utt, const SObject *input,
+					  const char *prefix, s_erc *error);
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Function implementations                                                         */
+/*                                                                                  */
+/************************************************************************************/
+
+S_API void SSynthCacheInit(SSynthCache **self, size_t max_bytes,
+						   const char *dir, s_erc *error)
+{
+	S_CLR_ERR(error);
+
+	if (*self == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SSynthCacheInit",
+				  "Argument \"self\" is NULL");
+		return;
+	}
+
+	(*self)->max_bytes = max_bytes;
+
+	(*self)->entries = s_hash_table_new(free_entry, S_CACHE_TABLE_SIZE, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SSynthCacheInit",
+				  "Call to \"s_hash_table_new\" failed"))
+		goto quit_error;
+
+	if (dir == NULL)
+		return;
+
+	(*self)->dir = s_strdup(dir, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SSynthCacheInit",
+				  "Call to \"s_strdup\" failed"))
+		goto quit_error;
+
+	(*self)->index = s_hash_table_new(free_index_entry, S_CACHE_TABLE_SIZE, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SSynthCacheInit",
+				  "Call to \"s_hash_table_new\" failed"))
+		goto quit_error;
+
+	load_index(*self, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SSynthCacheInit",
+				  "Failed to load the index of cache directory \'%s\'", dir))
+		goto quit_error;
+
+	return;
+
+	/* error clean-up */
+quit_error:
+	{
+		s_erc local_err = S_SUCCESS;
+
+
+		S_DELETE(*self, "SSynthCacheInit", &local_err);
+		*self = NULL;
+	}
+}
+
+
+S_API float *SSynthCacheFetch(SSynthCache *self, const char *key,
+							  uint32 *num_samples, uint32 *sample_rate,
+							  s_erc *error)
+{
+	const s_hash_element *element;
+	s_synth_cache_entry *entry;
+	float *samples = NULL;
+	char *path = NULL;
+
+
+	S_CLR_ERR(error);
+
+	if (self == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SSynthCacheFetch",
+				  "Argument \"self\" is NULL");
+		return NULL;
+	}
+
+	if (key == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SSynthCacheFetch",
+				  "Argument \"key\" is NULL");
+		return NULL;
+	}
+
+	if ((num_samples == NULL) || (sample_rate == NULL))
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SSynthCacheFetch",
+				  "Arguments \"num_samples\" and \"sample_rate\" must not be NULL");
+		return NULL;
+	}
+
+	s_mutex_lock(&self->cache_mutex);
+
+	element = s_hash_table_find(self->entries, key, s_strzsize(key, error), error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SSynthCacheFetch",
+				  "Call to \"s_hash_table_find\" failed"))
+	{
+		s_mutex_unlock(&self->cache_mutex);
+		return NULL;
+	}
+
+	if (element != NULL)
+	{
+		entry = (s_synth_cache_entry*)s_hash_element_get_data(element, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "SSynthCacheFetch",
+					  "Call to \"s_hash_element_get_data\" failed"))
+		{
+			s_mutex_unlock(&self->cache_mutex);
+			return NULL;
+		}
+
+		if (entry->samples == NULL)
+		{
+			/* an audio object entry */
+			self->misses++;
+			s_mutex_unlock(&self->cache_mutex);
+			return NULL;
+		}
+
+		samples = S_MALLOC(float, entry->num_samples > 0 ? entry->num_samples : 1);
+		if (samples == NULL)
+		{
+			S_FTL_ERR(error, S_MEMERROR,
+					  "SSynthCacheFetch",
+					  "Failed to allocate memory for 'float' object");
+			s_mutex_unlock(&self->cache_mutex);
+			return NULL;
+		}
+
+		memcpy(samples, entry->samples, sizeof(float) * entry->num_samples);
+		*num_samples = entry->num_samples;
+		*sample_rate = entry->sample_rate;
+
+		/* now the most recently used */
+		lru_unlink(self, entry);
+		lru_push(self, entry);
+
+		self->memory_hits++;
+		s_mutex_unlock(&self->cache_mutex);
+		return samples;
+	}
+
+	if (self->index != NULL)
+	{
+		element = s_hash_table_find(self->index, key, s_strzsize(key, error), error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "SSynthCacheFetch",
+					  "Call to \"s_hash_table_find\" failed"))
+		{
+			s_mutex_unlock(&self->cache_mutex);
+			return NULL;
+		}
+
+		if (element != NULL)
+		{
+			path = s_path_combine(self->dir,
+								  (const char*)s_hash_element_get_data(element, error),
+								  error);
+			if (S_CHK_ERR(error, S_CONTERR,
+						  "SSynthCacheFetch",
+						  "Call to \"s_path_combine\" failed"))
+			{
+				s_mutex_unlock(&self->cache_mutex);
+				return NULL;
+			}
+		}
+	}
+
+	if (path == NULL)
+	{
+		self->misses++;
+		s_mutex_unlock(&self->cache_mutex);
+		return NULL;
+	}
+
+	/* don't hold the lock while reading the file */
+	s_mutex_unlock(&self->cache_mutex);
+
+	samples = disk_read(path, num_samples, sample_rate, error);
+	S_FREE(path);
+
+	s_mutex_lock(&self->cache_mutex);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SSynthCacheFetch",
+				  "Call to \"disk_read\" failed"))
+	{
+		/* a missing or broken file is a miss */
+		self->misses++;
+		s_mutex_unlock(&self->cache_mutex);
+		S_CLR_ERR(error);
+		return NULL;
+	}
+
+	self->disk_hits++;
+
+	memory_add(self, key, samples, *num_samples, *sample_rate, error);
+	s_mutex_unlock(&self->cache_mutex);
+	S_CHK_ERR(error, S_CONTERR,
+			  "SSynthCacheFetch",
+			  "Call to \"memory_add\" failed");
+
+	return samples;
+}
+
+
+S_API void SSynthCacheStore(SSynthCache *self, const char *key,
+							const float *samples, uint32 num_samples,
+							uint32 sample_rate, s_erc *error)
+{
+	S_CLR_ERR(error);
+
+	if (self == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SSynthCacheStore",
+				  "Argument \"self\" is NULL");
+		return;
+	}
+
+	if (key == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SSynthCacheStore",
+				  "Argument \"key\" is NULL");
+		return;
+	}
+
+	if ((samples == NULL) && (num_samples > 0))
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SSynthCacheStore",
+				  "Argument \"samples\" is NULL");
+		return;
+	}
+
+	store_samples(self, key, samples, num_samples, sample_rate, NULL, error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "SSynthCacheStore",
+			  "Call to \"store_samples\" failed");
+}
+
+
+S_API SObject *SSynthCacheFetchObject(SSynthCache *self, const char *key,
+									  s_erc *error)
+{
+	const s_hash_element *element;
+	s_synth_cache_entry *entry = NULL;
+	SObject *object = NULL;
+
+
+	S_CLR_ERR(error);
+
+	if (self == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SSynthCacheFetchObject",
+				  "Argument \"self\" is NULL");
+		return NULL;
+	}
+
+	if (key == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SSynthCacheFetchObject",
+				  "Argument \"key\" is NULL");
+		return NULL;
+	}
+
+	s_mutex_lock(&self->cache_mutex);
+
+	element = s_hash_table_find(self->entries, key, s_strzsize(key, error), error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SSynthCacheFetchObject",
+				  "Call to \"s_hash_table_find\" failed"))
+	{
+		s_mutex_unlock(&self->cache_mutex);
+		return NULL;
+	}
+
+	if (element != NULL)
+	{
+		entry = (s_synth_cache_entry*)s_hash_element_get_data(element, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "SSynthCacheFetchObject",
+					  "Call to \"s_hash_element_get_data\" failed"))
+		{
+			s_mutex_unlock(&self->cache_mutex);
+			return NULL;
+		}
+	}
+
+	if ((entry == NULL) || (entry->object == NULL))
+	{
+		self->misses++;
+		s_mutex_unlock(&self->cache_mutex);
+		return NULL;
+	}
+
+	/*
+	 * The cached object is never handed out, the utterances of the
+	 * hits could modify it or delete it concurrently.
+	 */
+	object = SObjectCopy(entry->object, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SSynthCacheFetchObject",
+				  "Call to \"SObjectCopy\" failed"))
+	{
+		s_mutex_unlock(&self->cache_mutex);
+		return NULL;
+	}
+
+	/* now the most recently used */
+	lru_unlink(self, entry);
+	lru_push(self, entry);
+
+	self->memory_hits++;
+	s_mutex_unlock(&self->cache_mutex);
+	return object;
+}
+
+
+S_API void SSynthCacheStoreObject(SSynthCache *self, const char *key,
+								  const SObject *object, s_erc *error)
+{
+	S_CLR_ERR(error);
+
+	if (self == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SSynthCacheStoreObject",
+				  "Argument \"self\" is NULL");
+		return;
+	}
+
+	if (key == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SSynthCacheStoreObject",
+				  "Argument \"key\" is NULL");
+		return;
+	}
+
+	if (object == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SSynthCacheStoreObject",
+				  "Argument \"object\" is NULL");
+		return;
+	}
+
+	store_object(self, key, object, NULL, error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "SSynthCacheStoreObject",
+			  "Call to \"store_object\" failed");
+}
+
+
+S_API void SSynthCacheClear(SSynthCache *self, s_bool disk, s_erc *error)
+{
+	const s_hash_element *element;
+	const s_hash_element *next;
+	char *path;
+	FILE *file;
+
+
+	S_CLR_ERR(error);
+
+	if (self == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SSynthCacheClear",
+				  "Argument \"self\" is NULL");
+		return;
+	}
+
+	s_mutex_lock(&self->cache_mutex);
+
+	/* drops the stores of syntheses started before the clear */
+	self->clears++;
+
+	while (self->oldest != NULL)
+	{
+		memory_remove(self, self->oldest->key, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "SSynthCacheClear",
+					  "Call to \"memory_remove\" failed"))
+		{
+			s_mutex_unlock(&self->cache_mutex);
+			return;
+		}
+	}
+
+	if (!disk || (self->index == NULL))
+	{
+		s_mutex_unlock(&self->cache_mutex);
+		return;
+	}
+
+	element = s_hash_table_first(self->index, error);
+	while ((element != NULL) && (*error == S_SUCCESS))
+	{
+		next = s_hash_element_next(element, error);
+		if (*error != S_SUCCESS)
+			break;
+
+		path = s_path_combine(self->dir,
+							  (const char*)s_hash_element_get_data(element, error),
+							  error);
+		if (*error != S_SUCCESS)
+			break;
+
+		remove(path);
+		S_FREE(path);
+
+		s_hash_element_delete((s_hash_element*)element, error);
+		element = next;
+	}
+
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SSynthCacheClear",
+				  "Failed to remove the disk tier entries"))
+	{
+		s_mutex_unlock(&self->cache_mutex);
+		return;
+	}
+
+	/* truncate the index */
+	path = s_path_combine(self->dir, "index", error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SSynthCacheClear",
+				  "Call to \"s_path_combine\" failed"))
+	{
+		s_mutex_unlock(&self->cache_mutex);
+		return;
+	}
+
+	file = fopen(path, "w");
+	if ((file == NULL) || (fclose(file) != 0))
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "SSynthCacheClear",
+				  "Failed to truncate cache index file \'%s\'", path);
+	}
+
+	S_FREE(path);
+	s_mutex_unlock(&self->cache_mutex);
+}
+
+
+S_API SMap *SSynthCacheGetCounters(const SSynthCache *self, s_erc *error)
+{
+	SMap *counters;
+	ulong memory_hits;
+	ulong disk_hits;
+	ulong misses;
+	uint32 entries;
+	size_t bytes;
+
+
+	S_CLR_ERR(error);
+
+	if (self == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SSynthCacheGetCounters",
+				  "Argument \"self\" is NULL");
+		return NULL;
+	}
+
+	s_mutex_lock((s_mutex*)&self->cache_mutex);
+	memory_hits = self->memory_hits;
+	disk_hits = self->disk_hits;
+	misses = self->misses;
+	bytes = self->bytes;
+	entries = s_hash_table_size(self->entries, error);
+	s_mutex_unlock((s_mutex*)&self->cache_mutex);
+
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SSynthCacheGetCounters",
+				  "Call to \"s_hash_table_size\" failed"))
+		return NULL;
+
+	counters = S_MAP(S_NEW(SMapList, error));
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SSynthCacheGetCounters",
+				  "Failed to create new 'SMapList' object"))
+		return NULL;
+
+	SMapSetInt(counters, "memory-hits", (sint32)memory_hits, error);
+	if (!*error)
+		SMapSetInt(counters, "disk-hits", (sint32)disk_hits, error);
+	if (!*error)
+		SMapSetInt(counters, "misses", (sint32)misses, error);
+	if (!*error)
+		SMapSetInt(counters, "entries", (sint32)entries, error);
+	if (!*error)
+		SMapSetInt(counters, "bytes", (sint32)bytes, error);
+
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SSynthCacheGetCounters",
+				  "Call to \"SMapSetInt\" failed"))
+	{
+		s_erc local_err = S_SUCCESS;
+
+
+		S_DELETE(counters, "SSynthCacheGetCounters", &local_err);
+		return NULL;
+	}
+
+	return counters;
+}
+
+
+S_API void SSynthCacheResetCounters(SSynthCache *self, s_erc *error)
+{
+	S_CLR_ERR(error);
+
+	if (self == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SSynthCacheResetCounters",
+				  "Argument \"self\" is NULL");
+		return;
+	}
+
+	s_mutex_lock(&self->cache_mutex);
+	self->memory_hits = 0;
+	self->disk_hits = 0;
+	self->misses = 0;
+	s_mutex_unlock(&self->cache_mutex);
+}
+
+
+S_LOCAL char *_s_synth_cache_key(const SVoice *voice, const char *utt_type,
+								 const SUtterance *utt, s_erc *error)
+{
+	const SObject *input;
+	s_bool is_present;
+	char *key;
+
+
+	S_CLR_ERR(error);
+
+	is_present = SUtteranceFeatureIsPresent(utt, "input", error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "_s_synth_cache_key",
+				  "Call to \"SUtteranceFeatureIsPresent\" failed"))
+		return NULL;
+
+	if (!is_present)
+		return NULL;
+
+	input = SUtteranceGetFeature(utt, "input", error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "_s_synth_cache_key",
+				  "Call to \"SUtteranceGetFeature\" failed"))
+		return NULL;
+
+	key = make_key(voice, utt_type, utt, input, "", error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "_s_synth_cache_key",
+				  "Call to \"make_key\" failed"))
+		return NULL;
+
+	return key;
+}
+
+
+S_LOCAL char *_s_synth_cache_input_key(const SVoice *voice, const char *utt_type,
+									   const SObject *input, s_erc *error)
+{
+	char *key;
+
+
+	S_CLR_ERR(error);
+
+	if (input == NULL)
+		return NULL;
+
+	/* audio object entries never share a key with samples entries */
+	key = make_key(voice, utt_type, NULL, input, "audio|", error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "_s_synth_cache_input_key",
+				  "Call to \"make_key\" failed"))
+		return NULL;
+
+	return key;
+}
+
+
+S_LOCAL s_bool _s_synth_cache_key_feature(const char *name)
+{
+	if (name == NULL)
+		return FALSE;
+
+	return ((strcmp(name, "rate") == 0)
+			|| (strcmp(name, "volume") == 0)
+			|| (strcmp(name, "half-tone") == 0));
+}
+
+
+S_LOCAL ulong _s_synth_cache_clears(SSynthCache *self)
+{
+	ulong clears;
+
+
+	s_mutex_lock(&self->cache_mutex);
+	clears = self->clears;
+	s_mutex_unlock(&self->cache_mutex);
+
+	return clears;
+}
+
+
+S_LOCAL void _s_synth_cache_store(SSynthCache *self, const char *key,
+								  const float *samples, uint32 num_samples,
+								  uint32 sample_rate, ulong clears, s_erc *error)
+{
+	S_CLR_ERR(error);
+
+	store_samples(self, key, samples, num_samples, sample_rate, &clears, error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "_s_synth_cache_store",
+			  "Call to \"store_samples\" failed");
+}
+
+
+S_LOCAL void _s_synth_cache_store_object(SSynthCache *self, const char *key,
+										 const SObject *object, ulong clears,
+										 s_erc *error)
+{
+	S_CLR_ERR(error);
+
+	store_object(self, key, object, &clears, error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "_s_synth_cache_store_object",
+			  "Call to \"store_object\" failed");
+}
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Class registration                                                               */
+/*                                                                                  */
+/************************************************************************************/
+
+S_LOCAL void _s_synth_cache_class_add(s_erc *error)
+{
+	S_CLR_ERR(error);
+	s_class_add(S_OBJECTCLASS(&SynthCacheClass), error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "_s_synth_cache_class_add",
+			  "Failed to add SSynthCacheClass");
+}
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static function implementations                                                  */
+/*                                                                                  */
+/************************************************************************************/
+
+/* hash table free function of the memory tier */
+static void free_entry(void *key, void *data, s_erc *error)
+{
+	s_synth_cache_entry *entry = data;
+
+
+	S_CLR_ERR(error);
+
+	S_FREE(key);
+
+	if (entry == NULL)
+		return;
+
+	if (entry->samples != NULL)
+		S_FREE(entry->samples);
+
+	if (entry->object != NULL)
+		S_DELETE(entry->object, "free_entry", error);
+
+	S_FREE(entry);
+}
+
+
+/* hash table free function of the disk tier index */
+static void free_index_entry(void *key, void *data, s_erc *error)
+{
+	S_CLR_ERR(error);
+	S_FREE(key);
+	S_FREE(data);
+}
+
+
+static void lru_unlink(SSynthCache *self, s_synth_cache_entry *entry)
+{
+	if (entry->newer != NULL)
+		entry->newer->older = entry->older;
+	else
+		self->newest = entry->older;
+
+	if (entry->older != NULL)
+		entry->older->newer = entry->newer;
+	else
+		self->oldest = entry->newer;
+
+	entry->newer = NULL;
+	entry->older = NULL;
+}
+
+
+static void lru_push(SSynthCache *self, s_synth_cache_entry *entry)
+{
+	entry->newer = NULL;
+	entry->older = self->newest;
+
+	if (self->newest != NULL)
+		self->newest->newer = entry;
+
+	self->newest = entry;
+
+	if (self->oldest == NULL)
+		self->oldest = entry;
+}
+
+
+/* remove an entry from the memory tier, cache mutex must be locked */
+static void memory_remove(SSynthCache *self, const char *key, s_erc *error)
+{
+	const s_hash_element *element;
+	s_synth_cache_entry *entry;
+
+
+	S_CLR_ERR(error);
+
+	element = s_hash_table_find(self->entries, key, s_strzsize(key, error), error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "memory_remove",
+				  "Call to \"s_hash_table_find\" failed"))
+		return;
+
+	if (element == NULL)
+		return;
+
+	entry = (s_synth_cache_entry*)s_hash_element_get_data(element, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "memory_remove",
+				  "Call to \"s_hash_element_get_data\" failed"))
+		return;
+
+	lru_unlink(self, entry);
+	self->bytes -= entry->bytes;
+
+	/* frees the key and the entry */
+	s_hash_element_delete((s_hash_element*)element, error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "memory_remove",
+			  "Call to \"s_hash_element_delete\" failed");
+}
+
+
+/*
+ * add (or replace) an empty entry of the given size in the memory
+ * tier, evicting the least recently used entries. Returns NULL if the
+ * entry is too large for the memory tier. Cache mutex must be locked.
+ */
+static s_synth_cache_entry *memory_insert(SSynthCache *self, const char *key,
+										  size_t bytes, s_erc *error)
+{
+	s_synth_cache_entry *entry;
+	char *entry_key;
+
+
+	S_CLR_ERR(error);
+
+	memory_remove(self, key, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "memory_insert",
+				  "Call to \"memory_remove\" failed"))
+		return NULL;
+
+	/* too large for the memory tier */
+	if (bytes > self->max_bytes)
+		return NULL;
+
+	while ((self->oldest != NULL) && (self->bytes + bytes > self->max_bytes))
+	{
+		memory_remove(self, self->oldest->key, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "memory_insert",
+					  "Call to \"memory_remove\" failed"))
+			return NULL;
+	}
+
+	entry = S_CALLOC(s_synth_cache_entry, 1);
+	if (entry == NULL)
+	{
+		S_FTL_ERR(error, S_MEMERROR,
+				  "memory_insert",
+				  "Failed to allocate memory for 's_synth_cache_entry' object");
+		return NULL;
+	}
+
+	entry_key = s_strdup(key, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "memory_insert",
+				  "Call to \"s_strdup\" failed"))
+	{
+		S_FREE(entry);
+		return NULL;
+	}
+
+	entry->key = entry_key;
+	entry->bytes = bytes;
+
+	s_hash_table_add(self->entries, entry_key, s_strzsize(entry_key, error),
+					 entry, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "memory_insert",
+				  "Call to \"s_hash_table_add\" failed"))
+	{
+		S_FREE(entry_key);
+		S_FREE(entry);
+		return NULL;
+	}
+
+	lru_push(self, entry);
+	self->bytes += bytes;
+
+	return entry;
+}
+
+
+/*
+ * add (or replace) a samples entry in the memory tier, cache mutex
+ * must be locked
+ */
+static void memory_add(SSynthCache *self, const char *key, const float *samples,
+					   uint32 num_samples, uint32 sample_rate, s_erc *error)
+{
+	s_synth_cache_entry *entry;
+	float *entry_samples;
+	size_t bytes;
+
+
+	S_CLR_ERR(error);
+
+	bytes = sizeof(s_synth_cache_entry) + s_strzsize(key, error)
+		+ (sizeof(float) * num_samples);
+
+	entry_samples = S_MALLOC(float, num_samples > 0 ? num_samples : 1);
+	if (entry_samples == NULL)
+	{
+		S_FTL_ERR(error, S_MEMERROR,
+				  "memory_add",
+				  "Failed to allocate memory for 'float' object");
+		return;
+	}
+
+	if (num_samples > 0)
+		memcpy(entry_samples, samples, sizeof(float) * num_samples);
+
+	entry = memory_insert(self, key, bytes, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "memory_add",
+				  "Call to \"memory_insert\" failed")
+		|| (entry == NULL))
+	{
+		S_FREE(entry_samples);
+		return;
+	}
+
+	entry->samples = entry_samples;
+	entry->num_samples = num_samples;
+	entry->sample_rate = sample_rate;
+}
+
+
+/*
+ * add the samples to the memory tier and the disk tier, unless the
+ * cache was cleared since the given number of clears (if not NULL)
+ */
+static void store_samples(SSynthCache *self, const char *key, const float *samples,
+						  uint32 num_samples, uint32 sample_rate,
+						  const ulong *clears, s_erc *error)
+{
+	const s_hash_element *element = NULL;
+	char *file_name = NULL;
+	char *path;
+
+
+	S_CLR_ERR(error);
+
+	s_mutex_lock(&self->cache_mutex);
+
+	if ((clears != NULL) && (*clears != self->clears))
+	{
+		s_mutex_unlock(&self->cache_mutex);
+		return;
+	}
+
+	memory_add(self, key, samples, num_samples, sample_rate, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "store_samples",
+				  "Call to \"memory_add\" failed"))
+	{
+		s_mutex_unlock(&self->cache_mutex);
+		return;
+	}
+
+	if (self->index != NULL)
+	{
+		element = s_hash_table_find(self->index, key, s_strzsize(key, error), error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "store_samples",
+					  "Call to \"s_hash_table_find\" failed"))
+		{
+			s_mutex_unlock(&self->cache_mutex);
+			return;
+		}
+	}
+
+	s_mutex_unlock(&self->cache_mutex);
+
+	if ((self->index == NULL) || (element != NULL))
+		return;
+
+	/* add to the disk tier */
+	file_name = disk_file_name(key, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "store_samples",
+				  "Call to \"disk_file_name\" failed"))
+		return;
+
+	path = s_path_combine(self->dir, file_name, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "store_samples",
+				  "Call to \"s_path_combine\" failed"))
+	{
+		S_FREE(file_name);
+		return;
+	}
+
+	disk_write(path, samples, num_samples, sample_rate, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "store_samples",
+				  "Call to \"disk_write\" failed"))
+	{
+		S_FREE(path);
+		S_FREE(file_name);
+		return;
+	}
+
+	s_mutex_lock(&self->cache_mutex);
+
+	if ((clears != NULL) && (*clears != self->clears))
+	{
+		/* cleared while writing the file */
+		remove(path);
+	}
+	else
+	{
+		index_append(self, key, file_name, error);
+		if (!S_CHK_ERR(error, S_CONTERR,
+					   "store_samples",
+					   "Call to \"index_append\" failed"))
+		{
+			index_add(self, key, file_name, error);
+			S_CHK_ERR(error, S_CONTERR,
+					  "store_samples",
+					  "Call to \"index_add\" failed");
+		}
+	}
+
+	s_mutex_unlock(&self->cache_mutex);
+	S_FREE(path);
+	S_FREE(file_name);
+}
+
+
+/*
+ * add a copy of the audio object to the memory tier, unless the cache
+ * was cleared since the given number of clears (if not NULL)
+ */
+static void store_object(SSynthCache *self, const char *key, const SObject *object,
+						 const ulong *clears, s_erc *error)
+{
+	s_synth_cache_entry *entry;
+	SObject *copy;
+	ulong alloc_bytes;
+	size_t bytes;
+
+
+	S_CLR_ERR(error);
+
+	/*
+	 * Copy outside of the lock, the size of the entry is what the copy
+	 * allocates (if allocations can be counted).
+	 */
+	_s_alloc_count_hold(TRUE);
+	alloc_bytes = _s_alloc_bytes();
+	copy = SObjectCopy(object, error);
+	alloc_bytes = _s_alloc_bytes() - alloc_bytes;
+	_s_alloc_count_hold(FALSE);
+
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "store_object",
+				  "Call to \"SObjectCopy\" failed"))
+		return;
+
+	/* no copy function */
+	if (copy == NULL)
+		return;
+
+	bytes = sizeof(s_synth_cache_entry) + s_strzsize(key, error)
+		+ (alloc_bytes > 0 ? alloc_bytes : S_OBJECT_CLS(copy)->size);
+
+	s_mutex_lock(&self->cache_mutex);
+
+	if ((clears != NULL) && (*clears != self->clears))
+	{
+		s_mutex_unlock(&self->cache_mutex);
+		S_DELETE(copy, "store_object", error);
+		return;
+	}
+
+	entry = memory_insert(self, key, bytes, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "store_object",
+				  "Call to \"memory_insert\" failed")
+		|| (entry == NULL))
+	{
+		s_erc local_err = S_SUCCESS;
+
+
+		s_mutex_unlock(&self->cache_mutex);
+		S_DELETE(copy, "store_object", &local_err);
+		return;
+	}
+
+	entry->object = copy;
+	s_mutex_unlock(&self->cache_mutex);
+}
+
+
+/*
+ * Load the index of the disk tier, lines of "<file name> <key>". Later
+ * lines replace earlier lines of the same key.
+ */
+static void load_index(SSynthCache *self, s_erc *error)
+{
+	char *path;
+	char *buf = NULL;
+	char *line;
+	char *end;
+	char *sep;
+	FILE *file;
+	long size;
+
+
+	S_CLR_ERR(error);
+
+	path = s_path_combine(self->dir, "index", error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "load_index",
+				  "Call to \"s_path_combine\" failed"))
+		return;
+
+	file = fopen(path, "rb");
+	S_FREE(path);
+
+	/* a new cache directory */
+	if (file == NULL)
+		return;
+
+	if ((fseek(file, 0, SEEK_END) != 0)
+		|| ((size = ftell(file)) < 0)
+		|| (fseek(file, 0, SEEK_SET) != 0))
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "load_index",
+				  "Failed to get the size of the index file");
+		fclose(file);
+		return;
+	}
+
+	buf = S_MALLOC(char, size + 1);
+	if (buf == NULL)
+	{
+		S_FTL_ERR(error, S_MEMERROR,
+				  "load_index",
+				  "Failed to allocate memory for 'char' object");
+		fclose(file);
+		return;
+	}
+
+	if (fread(buf, 1, (size_t)size, file) != (size_t)size)
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "load_index",
+				  "Failed to read the index file");
+		fclose(file);
+		S_FREE(buf);
+		return;
+	}
+
+	fclose(file);
+	buf[size] = '\0';
+
+	for (line = buf; *line != '\0'; line = end + 1)
+	{
+		/* an incomplete last line could hold a truncated key */
+		end = strchr(line, '\n');
+		if (end == NULL)
+			break;
+
+		*end = '\0';
+
+		sep = strchr(line, ' ');
+		if (sep == NULL)
+			continue;
+
+		*sep = '\0';
+		index_add(self, sep + 1, line, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "load_index",
+					  "Call to \"index_add\" failed"))
+			break;
+	}
+
+	S_FREE(buf);
+}
+
+
+/* add (or replace) a disk tier index entry, cache mutex must be locked */
+static void index_add(SSynthCache *self, const char *key, const char *file_name,
+					  s_erc *error)
+{
+	const s_hash_element *element;
+	char *index_key;
+	char *index_file;
+
+
+	S_CLR_ERR(error);
+
+	element = s_hash_table_find(self->index, key, s_strzsize(key, error), error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "index_add",
+				  "Call to \"s_hash_table_find\" failed"))
+		return;
+
+	if (element != NULL)
+	{
+		s_hash_element_delete((s_hash_element*)element, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "index_add",
+					  "Call to \"s_hash_element_delete\" failed"))
+			return;
+	}
+
+	index_key = s_strdup(key, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "index_add",
+				  "Call to \"s_strdup\" failed"))
+		return;
+
+	index_file = s_strdup(file_name, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "index_add",
+				  "Call to \"s_strdup\" failed"))
+	{
+		S_FREE(index_key);
+		return;
+	}
+
+	s_hash_table_add(self->index, index_key, s_strzsize(index_key, error),
+					 index_file, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "index_add",
+				  "Call to \"s_hash_table_add\" failed"))
+	{
+		S_FREE(index_key);
+		S_FREE(index_file);
+		return;
+	}
+}
+
+
+/* append a disk tier index entry to the index file */
+static void index_append(SSynthCache *self, const char *key, const char *file_name,
+						 s_erc *error)
+{
+	char *path;
+	FILE *file;
+	int rv;
+
+
+	S_CLR_ERR(error);
+
+	path = s_path_combine(self->dir, "index", error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "index_append",
+				  "Call to \"s_path_combine\" failed"))
+		return;
+
+	file = fopen(path, "a");
+	if (file == NULL)
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "index_append",
+				  "Failed to open cache index file \'%s\' for appending", path);
+		S_FREE(path);
+		return;
+	}
+
+	rv = fprintf(file, "%s %s\n", file_name, key);
+	if ((fclose(file) != 0) || (rv < 0))
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "index_append",
+				  "Failed to write cache index file \'%s\'", path);
+	}
+
+	S_FREE(path);
+}
+
+
+/* the disk tier file name of a key, a 64 bit hash of the key */
+static char *disk_file_name(const char *key, s_erc *error)
+{
+	char *file_name;
+	uint32 pc = 0;
+	uint32 pb = 0;
+
+
+	S_CLR_ERR(error);
+
+	s_hashlittle2((const uint32*)key, strlen(key), &pc, &pb);
+
+	s_asprintf(&file_name, error, "%08x%08x.wav", pc, pb);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "disk_file_name",
+				  "Call to \"s_asprintf\" failed"))
+		return NULL;
+
+	return file_name;
+}
+
+
+static void put_le32(s_byte *buf, uint32 val)
+{
+	buf[0] = (s_byte)(val & 0xff);
+	buf[1] = (s_byte)((val >> 8) & 0xff);
+	buf[2] = (s_byte)((val >> 16) & 0xff);
+	buf[3] = (s_byte)((val >> 24) & 0xff);
+}
+
+
+static uint32 get_le32(const s_byte *buf)
+{
+	return ((uint32)buf[0]) | ((uint32)buf[1] << 8)
+		| ((uint32)buf[2] << 16) | ((uint32)buf[3] << 24);
+}
+
+
+/* write a RIFF file of mono 32 bit float samples */
+static void disk_write(const char *path, const float *samples, uint32 num_samples,
+					   uint32 sample_rate, s_erc *error)
+{
+	s_byte header[S_CACHE_RIFF_HEADER];
+	uint32 data_size = num_samples * sizeof(float);
+	uint32 i;
+	FILE *file;
+	s_bool failed;
+
+
+	S_CLR_ERR(error);
+
+	memcpy(header, "RIFF", 4);
+	put_le32(header + 4, S_CACHE_RIFF_HEADER - 8 + data_size);
+	memcpy(header + 8, "WAVEfmt ", 8);
+	put_le32(header + 16, 16);                         /* fmt chunk size  */
+	header[20] = 3;                                    /* IEEE float      */
+	header[21] = 0;
+	header[22] = 1;                                    /* mono            */
+	header[23] = 0;
+	put_le32(header + 24, sample_rate);
+	put_le32(header + 28, sample_rate * sizeof(float)); /* byte rate      */
+	header[32] = sizeof(float);                        /* block align     */
+	header[33] = 0;
+	header[34] = 32;                                   /* bits per sample */
+	header[35] = 0;
+	memcpy(header + 36, "data", 4);
+	put_le32(header + 40, data_size);
+
+	file = fopen(path, "wb");
+	if (file == NULL)
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "disk_write",
+				  "Failed to open cache file \'%s\' for writing", path);
+		return;
+	}
+
+	failed = (fwrite(header, 1, S_CACHE_RIFF_HEADER, file) != S_CACHE_RIFF_HEADER);
+
+	for (i = 0; (i < num_samples) && !failed; i++)
+	{
+		float sample = s_swap_le_flt(samples[i]);
+
+
+		failed = (fwrite(&sample, sizeof(float), 1, file) != 1);
+	}
+
+	if ((fclose(file) != 0) || failed)
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "disk_write",
+				  "Failed to write cache file \'%s\'", path);
+		remove(path);
+	}
+}
+
+
+/* read a RIFF file written by disk_write */
+static float *disk_read(const char *path, uint32 *num_samples, uint32 *sample_rate,
+						s_erc *error)
+{
+	s_byte header[S_CACHE_RIFF_HEADER];
+	float *samples;
+	uint32 data_size;
+	uint32 i;
+	FILE *file;
+
+
+	S_CLR_ERR(error);
+
+	file = fopen(path, "rb");
+	if (file == NULL)
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "disk_read",
+				  "Failed to open cache file \'%s\' for reading", path);
+		return NULL;
+	}
+
+	if ((fread(header, 1, S_CACHE_RIFF_HEADER, file) != S_CACHE_RIFF_HEADER)
+		|| (memcmp(header, "RIFF", 4) != 0)
+		|| (memcmp(header + 8, "WAVEfmt ", 8) != 0)
+		|| (header[20] != 3) || (header[22] != 1) || (header[34] != 32)
+		|| (memcmp(header + 36, "data", 4) != 0))
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "disk_read",
+				  "Cache file \'%s\' is not a mono 32 bit float RIFF file", path);
+		fclose(file);
+		return NULL;
+	}
+
+	*sample_rate = get_le32(header + 24);
+	data_size = get_le32(header + 40);
+	*num_samples = data_size / sizeof(float);
+
+	samples = S_MALLOC(float, *num_samples > 0 ? *num_samples : 1);
+	if (samples == NULL)
+	{
+		S_FTL_ERR(error, S_MEMERROR,
+				  "disk_read",
+				  "Failed to allocate memory for 'float' object");
+		fclose(file);
+		return NULL;
+	}
+
+	if (fread(samples, sizeof(float), *num_samples, file) != *num_samples)
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "disk_read",
+				  "Failed to read cache file \'%s\'", path);
+		fclose(file);
+		S_FREE(samples);
+		return NULL;
+	}
+
+	fclose(file);
+
+	for (i = 0; i < *num_samples; i++)
+		samples[i] = s_swap_le_flt(samples[i]);
+
+	return samples;
+}
+
+
+/*
+ * A float parameter of the synthesis, the utterance feature (if an
+ * utterance is given), else the voice feature, else the default.
+ */
+static float get_param(const SVoice *voice, const SUtterance *utt,
+					   const char *name, float def, s_erc *error)
+{
+	const SObject *param = NULL;
+	s_bool is_present;
+	float val;
+
+
+	S_CLR_ERR(error);
+
+	is_present = FALSE;
+	if (utt != NULL)
+	{
+		is_present = SUtteranceFeatureIsPresent(utt, name, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "get_param",
+					  "Call to \"SUtteranceFeatureIsPresent\" failed"))
+			return def;
+	}
+
+	if (is_present)
+	{
+		param = SUtteranceGetFeature(utt, name, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "get_param",
+					  "Call to \"SUtteranceGetFeature\" failed"))
+			return def;
+	}
+	else
+	{
+		is_present = SVoiceFeatureIsPresent(voice, name, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "get_param",
+					  "Call to \"SVoiceFeatureIsPresent\" failed"))
+			return def;
+
+		if (is_present)
+		{
+			param = SVoiceGetFeature(voice, name, error);
+			if (S_CHK_ERR(error, S_CONTERR,
+						  "get_param",
+						  "Call to \"SVoiceGetFeature\" failed"))
+				return def;
+		}
+	}
+
+	if (param == NULL)
+		return def;
+
+	val = SObjectGetFloat(param, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "get_param",
+				  "Call to \"SObjectGetFloat\" failed"))
+		return def;
+
+	return val;
+}
+
+
+/*
+ * The text with leading and trailing white space removed, and runs
+ * of white space replaced by a single space.
+ */
+static char *normalize_text(const char *text, s_erc *error)
+{
+	char *normalized;
+	char *out;
+	s_bool space = FALSE;
+
+
+	S_CLR_ERR(error);
+
+	if (text == NULL)
+		text = "";
+
+	normalized = S_MALLOC(char, strlen(text) + 1);
+	if (normalized == NULL)
+	{
+		S_FTL_ERR(error, S_MEMERROR,
+				  "normalize_text",
+				  "Failed to allocate memory for 'char' object");
+		return NULL;
+	}
+
+	for (out = normalized; *text != '\0'; text++)
+	{
+		if ((*text == ' ') || (*text == '\t') || (*text == '\n')
+			|| (*text == '\r') || (*text == '\f') || (*text == '\v'))
+		{
+			space = (out != normalized);
+			continue;
+		}
+
+		if (space)
+			*out++ = ' ';
+
+		space = FALSE;
+		*out++ = *text;
+	}
+
+	*out = '\0';
+	return normalized;
+}
+
+
+/*
+ * The cache key of an input, NULL if the input is not an SString. The
+ * parameters are read from the utterance (if given) and the voice.
+ */
+static char *make_key(const SVoice *voice, const char *utt_type,
+					  const SUtterance *utt, const SObject *input,
+					  const char *prefix, s_erc *error)
+{
+	const s_version *version = NULL;
+	const char *name = NULL;
+	const char *lang_code = NULL;
+	char *text;
+	char *key;
+	float rate;
+	float volume = 1.0;
+	float half_tone = 0.0;
+	s_bool is_type;
+
+
+	S_CLR_ERR(error);
+
+	is_type = SObjectIsType(input, "SString", error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "make_key",
+				  "Call to \"SObjectIsType\" failed"))
+		return NULL;
+
+	if (!is_type)
+		return NULL;
+
+	/* the parameters read by the waveform generators */
+	rate = get_param(voice, utt, "rate", 1.0, error);
+	if (!*error)
+		volume = get_param(voice, utt, "volume", 1.0, error);
+	if (!*error)
+		half_tone = get_param(voice, utt, "half-tone", 0.0, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "make_key",
+				  "Call to \"get_param\" failed"))
+		return NULL;
+
+	name = SVoiceGetName(voice, error);
+	if (!*error)
+		lang_code = SVoiceGetLangCode(voice, error);
+	if (!*error)
+		version = SVoiceGetVersion(voice, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "make_key",
+				  "Failed to get the voice information"))
+		return NULL;
+
+	text = normalize_text(SObjectGetString(input, error), error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "make_key",
+				  "Call to \"normalize_text\" failed"))
+		return NULL;
+
+	s_asprintf(&key, error, "%s%s|%s|%d.%d|%s|rate=%g|volume=%g|half-tone=%g|%s",
+			   prefix, name ? name : "", lang_code ? lang_code : "",
+			   version ? version->major : 0, version ? version->minor : 0,
+			   utt_type, rate, volume, half_tone, text);
+	S_FREE(text);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "make_key",
+				  "Call to \"s_asprintf\" failed"))
+		return NULL;
+
+	return key;
+}
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static class function implementations                                            */
+/*                                                                                  */
+/************************************************************************************/
+
+static void InitSynthCache(void *obj, s_erc *error)
+{
+	SSynthCache *self = obj;
+
+
+	S_CLR_ERR(error);
+
+	self->entries = NULL;
+	self->newest = NULL;
+	self->oldest = NULL;
+	self->max_bytes = 0;
+	self->bytes = 0;
+	self->dir = NULL;
+	self->index = NULL;
+	self->memory_hits = 0;
+	self->disk_hits = 0;
+	self->misses = 0;
+	self->clears = 0;
+	s_mutex_init(&self->cache_mutex);
+}
+
+
+static void DestroySynthCache(void *obj, s_erc *error)
+{
+	SSynthCache *self = obj;
+
+
+	S_CLR_ERR(error);
+
+	if (self->entries != NULL)
+	{
+		s_hash_table_delete(self->entries, error);
+		S_CHK_ERR(error, S_CONTERR,
+				  "DestroySynthCache",
+				  "Call to \"s_hash_table_delete\" failed");
+	}
+
+	if (self->index != NULL)
+	{
+		s_hash_table_delete(self->index, error);
+		S_CHK_ERR(error, S_CONTERR,
+				  "DestroySynthCache",
+				  "Call to \"s_hash_table_delete\" failed");
+	}
+
+	if (self->dir != NULL)
+		S_FREE(self->dir);
+
+	s_mutex_destroy(&self->cache_mutex);
+}
+
+
+static void DisposeSynthCache(void *obj, s_erc *error)
+{
+	S_CLR_ERR(error);
+	SObjectDecRef(obj);
+}
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* SSynthCache class initialization                                                 */
+/*                                                                                  */
+/************************************************************************************/
+
+static SSynthCacheClass SynthCacheClass =
+{
+	"SSynthCache",
+	sizeof(SSynthCache),
+	{ 0, 1},
+	InitSynthCache,    /* init    */
+	DestroySynthCache, /* destroy */
+	DisposeSynthCache, /* dispose */
+	NULL,              /* compare */
+	NULL,              /* print   */
+	NULL,              /* copy    */
+};
@@ -0,0 +1,497 @@
+/************************************************************************************/
+/* Copyright (c) 2008-2011 The Department of Arts and Culture,                      */
+/* The Government of the Republic of South Africa.                                  */
+/*                                                                                  */
+/* Contributors:  Meraka Institute, CSIR, South Africa.                             */
+/*                                                                                  */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy     */
+/* of this software and associated documentation files (the "Software"), to deal    */
+/* in the Software without restriction, including without limitation the rights     */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        */
+/* copies of the Software, and to permit persons to whom the Software is            */
+/* furnished to do so, subject to the following conditions:                         */
+/* The above copyright notice and this permission notice shall be included in       */
+/* all copies or substantial portions of the Software.                              */
+/*                                                                                  */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN        */
+/* THE SOFTWARE.                                                                    */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* AUTHOR  : Speect contributors                                                    */
+/* DATE    : 19 October 2026                                                        */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* Cache of synthesized audio, with memory and disk tiers.                          */
+/*                                                                                  */
+/*                                                                                  */
+/************************************************************************************/
+
+#ifndef _SPCT_SYNTH_CACHE_H__
+#define _SPCT_SYNTH_CACHE_H__
+
+
+/**
+ * @file synthcache.h
+ * Cache of synthesized audio, with memory and disk tiers.
+ */
+
+
+/**
+ * @ingroup SVoices
+ * @defgroup SSynthCache Synthesis Cache
+ * Cache of synthesized audio. A voice with a cache (see
+ * #SVoiceSetSynthCache) looks up the audio of an utterance before
+ * synthesizing it and skips all the utterance processors on a hit.
+ * The audio of a miss is added to the cache once the utterance is
+ * synthesized.
+ *
+ * Two kinds of utterances with an #SString @c "input" feature are
+ * cached:
+ * <ul>
+ * <li> utterances with an audio stream that keeps its samples (see
+ * #SAudioStreamGetFromUtt), which is the case for the utterances of
+ * #SVoiceSynthText and #SSynthSession. The samples are cached, and a
+ * hit writes them to the audio stream, </li>
+ * <li> utterances of #SVoiceSynthUtt. A copy of their @c "audio"
+ * feature object is cached in the memory tier, and the utterance of a
+ * hit gets a copy of it. Audio objects that can not be copied
+ * (#SObjectCopy) are not cached. </li>
+ * </ul>
+ * The cache key is made of the voice name, language code and version,
+ * the utterance type, the @c "rate", @c "volume" and @c "half-tone"
+ * features of the utterance (or voice), and the input text with its
+ * white space normalized. The utterance of a hit has no relations.
+ * The voice clears its cache when its data, features, utterance
+ * processors or utterance types are changed, and audio synthesized
+ * before a clear is not added to the cache.
+ *
+ * The memory tier is a least recently used list bounded in bytes. The
+ * optional disk tier keeps every stored entry as a RIFF file of 32 bit
+ * float samples in the cache directory, listed in an @c index file,
+ * and is loaded into the memory tier on a hit. The disk tier is not
+ * bounded, and must not be shared by processes writing to it at the
+ * same time.
+ * @{
+ */
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Modules used                                                                     */
+/*                                                                                  */
+/************************************************************************************/
+
+#include "include/common.h"
+#include "base/utils/types.h"
+#include "base/errdbg/errdbg.h"
+#include "base/threads/threads.h"
+#include "base/objsystem/objsystem.h"
+#include "base/containers/hashtable/hash_table.h"
+#include "containers/containers.h"
+#include "hrg/hrg.h"
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Begin external c declaration                                                     */
+/*                                                                                  */
+/************************************************************************************/
+S_BEGIN_C_DECLS
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Macros                                                                           */
+/*                                                                                  */
+/************************************************************************************/
+
+/**
+ * @hideinitializer
+ * Return the given #SSynthCache child class object as a synthesis
+ * cache object.
+ *
+ * @param SELF The given object.
+ *
+ * @return Given object as #SSynthCache* type.
+ *
+ * @note This casting is not safety checked.
+ */
+#define S_SYNTHCACHE(SELF)  ((SSynthCache *)(SELF))
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Data types                                                                       */
+/*                                                                                  */
+/************************************************************************************/
+
+/**
+ * Type definition of an opaque synthesis cache entry.
+ */
+typedef struct s_synth_cache_entry s_synth_cache_entry;
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* SSynthCache definition                                                           */
+/*                                                                                  */
+/************************************************************************************/
+
+/**
+ * The SSynthCache structure.
+ * @extends SObject
+ */
+typedef struct
+{
+	/**
+	 * @protected Inherit from #SObject.
+	 */
+	SObject              obj;
+
+	/**
+	 * @protected Memory tier entries, by key.
+	 */
+	s_hash_table        *entries;
+
+	/**
+	 * @protected Most recently used memory tier entry.
+	 */
+	s_synth_cache_entry *newest;
+
+	/**
+	 * @protected Least recently used memory tier entry.
+	 */
+	s_synth_cache_entry *oldest;
+
+	/**
+	 * @protected Maximum size of the memory tier, in bytes.
+	 */
+	size_t               max_bytes;
+
+	/**
+	 * @protected Size of the memory tier, in bytes.
+	 */
+	size_t               bytes;
+
+	/**
+	 * @protected Disk tier directory, @c NULL if none.
+	 */
+	char                *dir;
+
+	/**
+	 * @protected Disk tier file names, by key, @c NULL if no disk
+	 * tier.
+	 */
+	s_hash_table        *index;
+
+	/**
+	 * @protected Number of memory tier hits.
+	 */
+	ulong                memory_hits;
+
+	/**
+	 * @protected Number of disk tier hits.
+	 */
+	ulong                disk_hits;
+
+	/**
+	 * @protected Number of misses.
+	 */
+	ulong                misses;
+
+	/**
+	 * @protected Number of clears.
+	 */
+	ulong                clears;
+
+	/**
+	 * @protected Locking mutex.
+	 */
+	S_DECLARE_MUTEX(cache_mutex);
+} SSynthCache;
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* SSynthCacheClass definition                                                      */
+/*                                                                                  */
+/************************************************************************************/
+
+/**
+ * The SSynthCacheClass type. Same as #SObjectClass as we
+ * do not add any new methods.
+ * @extends SObjectClass
+ */
+typedef SObjectClass SSynthCacheClass;
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Function prototypes                                                              */
+/*                                                                                  */
+/************************************************************************************/
+
+/**
+ * Initialize a synthesis cache.
+ *
+ * @public @memberof SSynthCache
+ * @param self The synthesis cache to initialize.
+ * @param max_bytes The maximum size of the memory tier, in bytes.
+ * @param dir The directory of the disk tier, which must exist, or @c
+ * NULL for no disk tier. The entries listed in its @c index file are
+ * available at once.
+ * @param error Error code.
+ *
+ * @note If this function fails the cache will be deleted and the @c
+ * self variable will be set to @c NULL.
+ */
+S_API void SSynthCacheInit(SSynthCache **self, size_t max_bytes,
+						   const char *dir, s_erc *error);
+
+
+/**
+ * Look up the samples of the given key, in the memory tier and then in
+ * the disk tier.
+ *
+ * @public @memberof SSynthCache
+ * @param self The synthesis cache.
+ * @param key The cache key.
+ * @param num_samples Variable to receive the number of samples.
+ * @param sample_rate Variable to receive the sample rate.
+ * @param error Error code.
+ *
+ * @return A copy of the cached samples, or @c NULL on a miss. The
+ * caller is responsible for the memory of the samples (#S_FREE).
+ *
+ * @note Thread-safe.
+ */
+S_API float *SSynthCacheFetch(SSynthCache *self, const char *key,
+							  uint32 *num_samples, uint32 *sample_rate,
+							  s_erc *error);
+
+
+/**
+ * Add the samples of the given key to the cache. The least recently
+ * used entries are removed from the memory tier to keep it within its
+ * maximum size. Samples that are larger than the memory tier are only
+ * kept in the disk tier.
+ *
+ * @public @memberof SSynthCache
+ * @param self The synthesis cache.
+ * @param key The cache key.
+ * @param samples The samples.
+ * @param num_samples The number of samples.
+ * @param sample_rate The sample rate.
+ * @param error Error code.
+ *
+ * @note Thread-safe.
+ */
+S_API void SSynthCacheStore(SSynthCache *self, const char *key,
+							const float *samples, uint32 num_samples,
+							uint32 sample_rate, s_erc *error);
+
+
+/**
+ * Look up the audio object of the given key in the memory tier.
+ *
+ * @public @memberof SSynthCache
+ * @param self The synthesis cache.
+ * @param key The cache key.
+ * @param error Error code.
+ *
+ * @return A copy of the cached audio object (#SObjectCopy), or @c NULL
+ * on a miss. The caller is responsible for the memory of the object.
+ *
+ * @note Thread-safe.
+ */
+S_API SObject *SSynthCacheFetchObject(SSynthCache *self, const char *key,
+									  s_erc *error);
+
+
+/**
+ * Add a copy (#SObjectCopy) of the given audio object to the memory
+ * tier of the cache, the caller keeps the given object. Objects that
+ * can not be copied are not added. The least recently used entries are
+ * removed from the memory tier to keep it within its maximum size.
+ *
+ * @public @memberof SSynthCache
+ * @param self The synthesis cache.
+ * @param key The cache key.
+ * @param object The audio object.
+ * @param error Error code.
+ *
+ * @note Thread-safe.
+ */
+S_API void SSynthCacheStoreObject(SSynthCache *self, const char *key,
+								  const SObject *object, s_erc *error);
+
+
+/**
+ * Remove all the entries of the memory tier, and optionally of the
+ * disk tier, deleting its files.
+ *
+ * @public @memberof SSynthCache
+ * @param self The synthesis cache.
+ * @param disk If #TRUE the disk tier is cleared as well.
+ * @param error Error code.
+ *
+ * @note Thread-safe.
+ */
+S_API void SSynthCacheClear(SSynthCache *self, s_bool disk, s_erc *error);
+
+
+/**
+ * Get the counters of the cache. The counters are given as an
+ * #SMap of #SInt objects with the keys @c "memory-hits", @c
+ * "disk-hits", @c "misses", @c "entries" (memory tier) and @c "bytes"
+ * (memory tier).
+ *
+ * @public @memberof SSynthCache
+ * @param self The synthesis cache.
+ * @param error Error code.
+ *
+ * @return The counters.
+ *
+ * @note The caller is responsible for the memory of the returned map.
+ * @note Thread-safe.
+ */
+S_API SMap *SSynthCacheGetCounters(const SSynthCache *self, s_erc *error);
+
+
+/**
+ * Reset the hit and miss counters of the cache.
+ *
+ * @public @memberof SSynthCache
+ * @param self The synthesis cache.
+ * @param error Error code.
+ *
+ * @note Thread-safe.
+ */
+S_API void SSynthCacheResetCounters(SSynthCache *self, s_erc *error);
+
+
+/**
+ * Make the cache key of an utterance, see @ref SSynthCache.
+ *
+ * @private
+ * @param voice The voice synthesizing the utterance.
+ * @param utt_type The utterance type.
+ * @param utt The utterance.
+ * @param error Error code.
+ *
+ * @return The cache key, or @c NULL if the utterance has no #SString
+ * @c "input" feature. The caller is responsible for the memory of the
+ * key.
+ */
+S_LOCAL char *_s_synth_cache_key(const SVoice *voice, const char *utt_type,
+								 const SUtterance *utt, s_erc *error);
+
+
+/**
+ * Make the cache key of an input, for utterances without features of
+ * their own (#SVoiceSynthUtt), see @ref SSynthCache.
+ *
+ * @private
+ * @param voice The voice synthesizing the input.
+ * @param utt_type The utterance type.
+ * @param input The utterance input.
+ * @param error Error code.
+ *
+ * @return The cache key, or @c NULL if the input is not an #SString
+ * object. The caller is responsible for the memory of the key.
+ */
+S_LOCAL char *_s_synth_cache_input_key(const SVoice *voice, const char *utt_type,
+									   const SObject *input, s_erc *error);
+
+
+/**
+ * Query if the given voice feature is part of the cache key, changes
+ * to the other voice features clear the cache.
+ *
+ * @private
+ * @param name The feature name.
+ *
+ * @return #TRUE or #FALSE.
+ */
+S_LOCAL s_bool _s_synth_cache_key_feature(const char *name);
+
+
+/**
+ * Get the number of clears of the cache, to be given to
+ * #_s_synth_cache_store or #_s_synth_cache_store_object. Thread-safe.
+ *
+ * @private
+ * @param self The synthesis cache.
+ *
+ * @return The number of clears.
+ */
+S_LOCAL ulong _s_synth_cache_clears(SSynthCache *self);
+
+
+/**
+ * As #SSynthCacheStore, but the samples are not added if the cache was
+ * cleared since the given number of clears was taken
+ * (#_s_synth_cache_clears), as they were synthesized with the old
+ * voice configuration.
+ *
+ * @private
+ * @param self The synthesis cache.
+ * @param key The cache key.
+ * @param samples The samples.
+ * @param num_samples The number of samples.
+ * @param sample_rate The sample rate.
+ * @param clears The number of clears before synthesis.
+ * @param error Error code.
+ */
+S_LOCAL void _s_synth_cache_store(SSynthCache *self, const char *key,
+								  const float *samples, uint32 num_samples,
+								  uint32 sample_rate, ulong clears, s_erc *error);
+
+
+/**
+ * As #SSynthCacheStoreObject, but the audio object is not added if the
+ * cache was cleared since the given number of clears was taken
+ * (#_s_synth_cache_clears).
+ *
+ * @private
+ * @param self The synthesis cache.
+ * @param key The cache key.
+ * @param object The audio object.
+ * @param clears The number of clears before synthesis.
+ * @param error Error code.
+ */
+S_LOCAL void _s_synth_cache_store_object(SSynthCache *self, const char *key,
+										 const SObject *object, ulong clears,
+										 s_erc *error);
+
+
+/**
+ * Add the SSynthCache class to the object system.
+ * @private
+ *
+ * @param error Error code.
+ */
+S_LOCAL void _s_synth_cache_class_add(s_erc *error);
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* End external c declaration                                                       */
+/*                                                                                  */
+/************************************************************************************/
+S_END_C_DECLS
+
+
+/**
+ * @}
+ * end documentation
+ */
+
+#endif /* _SPCT_SYNTH_CACHE_H__ */
@@ -0,0 +1,738 @@
+/************************************************************************************/
+/* Copyright (c) 2008-2011 The Department of Arts and Culture,                      */
+/* The Government of the Republic of South Africa.                                  */
+/*                                                                                  */
+/* Contributors:  Meraka Institute, CSIR, South Africa.                             */
+/*                                                                                  */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy     */
+/* of this software and associated documentation files (the "Software"), to deal    */
+/* in the Software without restriction, including without limitation the rights     */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        */
+/* copies of the Software, and to permit persons to whom the Software is            */
+/* furnished to do so, subject to the following conditions:                         */
+/* The above copyright notice and this permission notice shall be included in       */
+/* all copies or substantial portions of the Software.                              */
+/*                                                                                  */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN        */
+/* THE SOFTWARE.                                                                    */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* AUTHOR  : Speect contributors                                                    */
+/* DATE    : 19 October 2026                                                        */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* Stage-pipelined synthesis.                                                       */
+/*                                                                                  */
+/*                                                                                  */
+/************************************************************************************/
+
+/************************************************************************************/
+/*                                                                                  */
+/* Modules used                                                                     */
+/*                                                                                  */
+/************************************************************************************/
+
+#include "base/strings/strings.h"
+#include "base/threads/threads.h"
+#include "voicemanager/synthpipeline.h"
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Data types                                                                       */
+/*                                                                                  */
+/************************************************************************************/
+
+/*
+ * A pipeline stage, a run of utterance processors of the pipeline
+ * execution plan with its own thread and request queue.
+ */
+struct s_synth_stage
+{
+	SSynthPipeline       *pipeline;  /* Owning pipeline.                           */
+	uint32                index;     /* Index of the stage in the pipeline.        */
+	uint32                first;     /* First utterance processor in the plan.     */
+	uint32                last;      /* One past the last utterance processor.     */
+	s_thread              thread;    /* Stage thread.                              */
+	SSynthFuture         *head;      /* Queue head (oldest request).               */
+	SSynthFuture         *tail;      /* Queue tail (newest request).               */
+	uint32                queued;    /* Number of queued requests.                 */
+	uint32                queue_size;/* Maximum number of queued requests.         */
+	s_bool                shutdown;  /* No more requests will be queued.           */
+	S_DECLARE_MUTEX(stage_mutex);    /* Locking mutex.                             */
+	S_DECLARE_COND(not_empty);       /* Signals queued requests and shutdown.      */
+	S_DECLARE_COND(not_full);        /* Signals space in the queue.                */
+};
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static variables                                                                 */
+/*                                                                                  */
+/************************************************************************************/
+
+static SSynthPipelineClass SynthPipelineClass; /* SSynthPipeline class declaration. */
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static function prototypes                                                       */
+/*                                                                                  */
+/************************************************************************************/
+
+static void create_stages(SSynthPipeline *self, const SList *stages,
+						  uint32 queue_size, s_erc *error);
+
+static SSynthFuture *submit_request(SSynthPipeline *self, SObject *input,
+									s_synth_pool_cb_fp callback, void *userdata,
+									s_erc *error);
+
+static s_bool run_stage(s_synth_stage *stage, SSynthFuture *request);
+
+static void stage_push(s_synth_stage *stage, SSynthFuture *request, s_erc *error);
+
+#ifdef SPCT_USE_THREADS
+static void synth_stage_worker(void *arg);
+#endif /* SPCT_USE_THREADS */
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Function implementations                                                         */
+/*                                                                                  */
+/************************************************************************************/
+
+S_API void SSynthPipelineInit(SSynthPipeline **self, const SVoice *voice,
+							  const char *utt_type, const SList *stages,
+							  uint32 queue_size, s_erc *error)
+{
+#ifdef SPCT_USE_THREADS
+	uint32 i;
+#endif /* SPCT_USE_THREADS */
+
+
+	S_CLR_ERR(error);
+
+	if (*self == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SSynthPipelineInit",
+				  "Argument \"self\" is NULL");
+		return;
+	}
+
+	if (voice == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SSynthPipelineInit",
+				  "Argument \"voice\" is NULL");
+		goto quit_error;
+	}
+
+	if (utt_type == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SSynthPipelineInit",
+				  "Argument \"utt_type\" is NULL");
+		goto quit_error;
+	}
+
+	if (queue_size == 0)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SSynthPipelineInit",
+				  "Argument \"queue_size\" is 0");
+		goto quit_error;
+	}
+
+	(*self)->voice = voice;
+	(*self)->utt_type = s_strdup(utt_type, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SSynthPipelineInit",
+				  "Call to \"s_strdup\" failed"))
+		goto quit_error;
+
+	create_stages(*self, stages, queue_size, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SSynthPipelineInit",
+				  "Call to \"create_stages\" failed"))
+		goto quit_error;
+
+#ifdef SPCT_USE_THREADS
+	for (i = 0; i < (*self)->num_stages; i++)
+	{
+		s_thread_create(&((*self)->stages[i].thread), synth_stage_worker,
+						&((*self)->stages[i]), error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "SSynthPipelineInit",
+					  "Call to \"s_thread_create\" failed"))
+			goto quit_error;
+
+		/* only join the started threads */
+		(*self)->num_threads++;
+	}
+#endif /* SPCT_USE_THREADS */
+
+	return;
+
+	/* error clean-up */
+quit_error:
+	{
+		s_erc local_err = S_SUCCESS;
+
+
+		S_DELETE(*self, "SSynthPipelineInit", &local_err);
+		*self = NULL;
+	}
+}
+
+
+S_API SSynthFuture *SSynthPipelineSubmit(SSynthPipeline *self, SObject *input,
+										 s_erc *error)
+{
+	SSynthFuture *future;
+
+
+	S_CLR_ERR(error);
+
+	if (self == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SSynthPipelineSubmit",
+				  "Argument \"self\" is NULL");
+		return NULL;
+	}
+
+	future = submit_request(self, input, NULL, NULL, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SSynthPipelineSubmit",
+				  "Call to \"submit_request\" failed"))
+		return NULL;
+
+	return future;
+}
+
+
+S_API void SSynthPipelineSubmitCallback(SSynthPipeline *self, SObject *input,
+										s_synth_pool_cb_fp callback, void *userdata,
+										s_erc *error)
+{
+	S_CLR_ERR(error);
+
+	if (self == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SSynthPipelineSubmitCallback",
+				  "Argument \"self\" is NULL");
+		return;
+	}
+
+	if (callback == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SSynthPipelineSubmitCallback",
+				  "Argument \"callback\" is NULL");
+		return;
+	}
+
+	/* the pipeline deletes the request after the callback */
+	submit_request(self, input, callback, userdata, error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "SSynthPipelineSubmitCallback",
+			  "Call to \"submit_request\" failed");
+}
+
+
+S_API uint32 SSynthPipelineNumStages(const SSynthPipeline *self, s_erc *error)
+{
+	S_CLR_ERR(error);
+
+	if (self == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SSynthPipelineNumStages",
+				  "Argument \"self\" is NULL");
+		return 0;
+	}
+
+	return self->num_stages;
+}
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Class registration                                                               */
+/*                                                                                  */
+/************************************************************************************/
+
+S_LOCAL void _s_synth_pipeline_class_add(s_erc *error)
+{
+	S_CLR_ERR(error);
+	s_class_add(S_OBJECTCLASS(&SynthPipelineClass), error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "_s_synth_pipeline_class_add",
+			  "Failed to add SSynthPipelineClass");
+}
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static function implementations                                                  */
+/*                                                                                  */
+/************************************************************************************/
+
+/*
+ * Split the execution plan of the utterance type into stages. The
+ * plan is acquired once here and not per utterance, it holds
+ * references to the utterance processors for the life of the
+ * pipeline.
+ */
+static void create_stages(SSynthPipeline *self, const SList *stages,
+						  uint32 queue_size, s_erc *error)
+{
+	const char *proc_name;
+	const char *boundary;
+	uint32 num_procs;
+	size_t num_boundaries;
+	uint32 next_boundary;
+	uint32 i;
+	int rv;
+	s_synth_stage *stage;
+
+
+	S_CLR_ERR(error);
+
+	self->plan = _s_voice_acquire_utt_plan(self->voice, self->utt_type, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "create_stages",
+				  "Call to \"_s_voice_acquire_utt_plan\" failed"))
+		return;
+
+	num_procs = _s_voice_utt_plan_size(self->plan);
+	if (num_procs == 0)
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "create_stages",
+				  "Utterance type \'%s\' has no utterance processors",
+				  self->utt_type);
+		return;
+	}
+
+	if (stages != NULL)
+	{
+		num_boundaries = SListSize(stages, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "create_stages",
+					  "Call to \"SListSize\" failed"))
+			return;
+	}
+	else
+	{
+		num_boundaries = num_procs - 1;
+	}
+
+	if (num_boundaries >= num_procs)
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "create_stages",
+				  "More stages than utterance processors in utterance type \'%s\'",
+				  self->utt_type);
+		return;
+	}
+
+	self->stages = S_CALLOC(s_synth_stage, num_boundaries + 1);
+	if (self->stages == NULL)
+	{
+		S_FTL_ERR(error, S_MEMERROR,
+				  "create_stages",
+				  "Failed to allocate memory for 's_synth_stage' objects");
+		return;
+	}
+
+	for (i = 0; i <= num_boundaries; i++)
+	{
+		stage = &(self->stages[i]);
+		stage->pipeline = self;
+		stage->index = i;
+		stage->queue_size = queue_size;
+		s_mutex_init(&stage->stage_mutex);
+		s_cond_init(&stage->not_empty);
+		s_cond_init(&stage->not_full);
+	}
+
+	/* now the stages are there for DestroySynthPipeline to clean up */
+	self->num_stages = (uint32)num_boundaries + 1;
+
+	stage = &(self->stages[0]);
+	next_boundary = 0;
+	for (i = 1; (i < num_procs) && (next_boundary < num_boundaries); i++)
+	{
+		proc_name = _s_voice_utt_plan_name(self->plan, i);
+
+		if (stages != NULL)
+		{
+			boundary = SObjectGetString(SListNth(stages, next_boundary, error), error);
+			if (S_CHK_ERR(error, S_CONTERR,
+						  "create_stages",
+						  "Failed to get stage utterance processor name"))
+				return;
+		}
+		else
+		{
+			boundary = proc_name;
+		}
+
+		rv = s_strcmp(proc_name, boundary, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "create_stages",
+					  "Call to \"s_strcmp\" failed"))
+			return;
+
+		if (rv == 0)
+		{
+			/* start the next stage here */
+			stage->last = i;
+			next_boundary++;
+			stage = &(self->stages[next_boundary]);
+			stage->first = i;
+		}
+	}
+
+	stage->last = num_procs;
+
+	if (next_boundary < num_boundaries)
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "create_stages",
+				  "Stage utterance processors are not in utterance type \'%s\' order",
+				  self->utt_type);
+		return;
+	}
+}
+
+
+static SSynthFuture *submit_request(SSynthPipeline *self, SObject *input,
+									s_synth_pool_cb_fp callback, void *userdata,
+									s_erc *error)
+{
+	SSynthFuture *request;
+	s_erc local_err = S_SUCCESS;
+	uint32 i;
+
+
+	S_CLR_ERR(error);
+
+	if (input == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "submit_request",
+				  "Argument \"input\" is NULL");
+		return NULL;
+	}
+
+	request = _s_synth_future_new(self->utt_type, callback, userdata, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "submit_request",
+				  "Call to \"_s_synth_future_new\" failed"))
+		return NULL;
+
+	request->input = input;
+	if (self->num_threads == 0)
+	{
+		/* run the stages in the submitting thread */
+		for (i = 0; i < self->num_stages; i++)
+		{
+			if (!run_stage(&(self->stages[i]), request))
+				break;
+		}
+
+		return (callback == NULL) ? request : NULL;
+	}
+
+	stage_push(&(self->stages[0]), request, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "submit_request",
+				  "Call to \"stage_push\" failed"))
+	{
+		request->input = NULL; /* caller keeps the input */
+		request->done = TRUE;  /* not submitted */
+		S_DELETE(request, "submit_request", &local_err);
+		return NULL;
+	}
+
+	/* a callback request may already be deleted by the last stage */
+	return (callback == NULL) ? request : NULL;
+}
+
+
+/*
+ * Run the utterance processors of the stage on the request. Returns
+ * TRUE if the request must continue to the next stage, else the
+ * request is completed and must not be used again.
+ */
+static s_bool run_stage(s_synth_stage *stage, SSynthFuture *request)
+{
+	const SSynthPipeline *self = stage->pipeline;
+	SUtterance *utt;
+	s_erc result = S_SUCCESS;
+	s_erc local_err = S_SUCCESS;
+
+
+	if (stage->index == 0)
+	{
+		/* data retired by SVoiceReloadData is kept until the request leaves */
+		request->epoch = _s_voice_data_epoch_enter(self->voice);
+
+		utt = S_NEW(SUtterance, &result);
+		if (S_CHK_ERR(&result, S_CONTERR,
+					  "run_stage",
+					  "Failed to create new utterance"))
+			goto complete;
+
+		SUtteranceInit(&utt, self->voice, &result);
+		if (S_CHK_ERR(&result, S_CONTERR,
+					  "run_stage",
+					  "Failed to initialize new utterance"))
+			goto complete;
+
+		SUtteranceSetFeature(utt, "input", request->input, &result);
+		if (S_CHK_ERR(&result, S_CONTERR,
+					  "run_stage",
+					  "Failed to set utterance \'input\' feature"))
+			goto complete;
+
+		request->input = NULL; /* taken by the utterance */
+
+		SUtteranceSetFeature(utt, "utterance-type",
+							 SObjectSetString(self->utt_type, &result),
+							 &result);
+		if (S_CHK_ERR(&result, S_CONTERR,
+					  "run_stage",
+					  "Failed to set utterance \'utterance-type\' feature"))
+			goto complete;
+
+		/* the utterance travels in the future until completed */
+		request->utt = utt;
+	}
+
+	/* the same cancellation checks, timings and tracing as SVoiceSynthUtt */
+	utt = request->utt;
+	_s_voice_run_utt_plan(self->voice, self->plan, utt,
+						  stage->first, stage->last, &result);
+	if (S_CHK_ERR(&result, S_CONTERR,
+				  "run_stage",
+				  "Call to \"_s_voice_run_utt_plan\" failed"))
+		goto complete;
+
+	if (stage->index + 1 < self->num_stages)
+		return TRUE;
+
+complete:
+	request->utt = NULL;
+	if (result != S_SUCCESS)
+	{
+		S_DELETE(utt, "run_stage", &local_err);
+		utt = NULL;
+	}
+
+	if (request->epoch != NULL)
+	{
+		_s_voice_data_epoch_leave(self->voice, request->epoch, &local_err);
+		S_CHK_ERR(&local_err, S_CONTERR,
+				  "run_stage",
+				  "Call to \"_s_voice_data_epoch_leave\" failed"); /* just log it */
+		request->epoch = NULL;
+	}
+
+	_s_synth_future_complete(request, utt, result);
+	return FALSE;
+}
+
+
+static void stage_push(s_synth_stage *stage, SSynthFuture *request, s_erc *error)
+{
+	S_CLR_ERR(error);
+
+	s_mutex_lock(&stage->stage_mutex);
+
+	while ((stage->queued >= stage->queue_size) && !stage->shutdown)
+		s_cond_wait(&stage->not_full, &stage->stage_mutex);
+
+	if (stage->shutdown)
+	{
+		s_mutex_unlock(&stage->stage_mutex);
+		S_CTX_ERR(error, S_FAILURE,
+				  "stage_push",
+				  "Synthesis pipeline is shutting down");
+		return;
+	}
+
+	request->next = NULL;
+	if (stage->tail == NULL)
+		stage->head = request;
+	else
+		stage->tail->next = request;
+	stage->tail = request;
+	stage->queued++;
+
+	s_cond_signal(&stage->not_empty);
+	s_mutex_unlock(&stage->stage_mutex);
+}
+
+
+#ifdef SPCT_USE_THREADS
+static void synth_stage_worker(void *arg)
+{
+	s_synth_stage *stage = arg;
+	s_synth_stage *next = NULL;
+	SSynthFuture *request;
+	s_erc error = S_SUCCESS;
+
+
+	if (stage->index + 1 < stage->pipeline->num_stages)
+		next = &(stage->pipeline->stages[stage->index + 1]);
+
+	s_mutex_lock(&stage->stage_mutex);
+
+	while (TRUE)
+	{
+		while ((stage->head == NULL) && !stage->shutdown)
+			s_cond_wait(&stage->not_empty, &stage->stage_mutex);
+
+		/* drain the queue before shutting down */
+		if (stage->head == NULL)
+			break;
+
+		request = stage->head;
+		stage->head = request->next;
+		if (stage->head == NULL)
+			stage->tail = NULL;
+		stage->queued--;
+
+		s_cond_signal(&stage->not_full);
+		s_mutex_unlock(&stage->stage_mutex);
+
+		if (run_stage(stage, request))
+		{
+			/* can not fail, the next stage only shuts down after this one */
+			stage_push(next, request, &error);
+			S_CHK_ERR(&error, S_CONTERR,
+					  "synth_stage_worker",
+					  "Call to \"stage_push\" failed");
+		}
+
+		s_mutex_lock(&stage->stage_mutex);
+	}
+
+	s_mutex_unlock(&stage->stage_mutex);
+
+	/* this stage is drained, let the next stage drain */
+	if (next != NULL)
+	{
+		s_mutex_lock(&next->stage_mutex);
+		next->shutdown = TRUE;
+		s_cond_broadcast(&next->not_empty);
+		s_mutex_unlock(&next->stage_mutex);
+	}
+}
+#endif /* SPCT_USE_THREADS */
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static class function implementations                                            */
+/*                                                                                  */
+/************************************************************************************/
+
+static void InitSynthPipeline(void *obj, s_erc *error)
+{
+	SSynthPipeline *self = obj;
+
+
+	S_CLR_ERR(error);
+
+	self->voice = NULL;
+	self->utt_type = NULL;
+	self->plan = NULL;
+	self->stages = NULL;
+	self->num_stages = 0;
+	self->num_threads = 0;
+}
+
+
+static void DestroySynthPipeline(void *obj, s_erc *error)
+{
+	SSynthPipeline *self = obj;
+	s_synth_stage *first;
+	uint32 i;
+
+
+	S_CLR_ERR(error);
+
+	if (self->num_stages > 0)
+	{
+		first = &(self->stages[0]);
+
+		/* the stages drain one after the other */
+		s_mutex_lock(&first->stage_mutex);
+		first->shutdown = TRUE;
+		s_cond_broadcast(&first->not_empty);
+		s_cond_broadcast(&first->not_full);
+		s_mutex_unlock(&first->stage_mutex);
+
+		/* requests are only submitted once all the stage threads started */
+		for (i = 0; i < self->num_threads; i++)
+			s_thread_join(&(self->stages[i].thread));
+
+
+		for (i = 0; i < self->num_stages; i++)
+		{
+			s_cond_destroy(&(self->stages[i].not_full));
+			s_cond_destroy(&(self->stages[i].not_empty));
+			s_mutex_destroy(&(self->stages[i].stage_mutex));
+		}
+	}
+
+	if (self->stages != NULL)
+		S_FREE(self->stages);
+
+	if (self->plan != NULL)
+		_s_voice_release_utt_plan(self->voice, self->plan);
+
+	if (self->utt_type != NULL)
+		S_FREE(self->utt_type);
+}
+
+
+static void DisposeSynthPipeline(void *obj, s_erc *error)
+{
+	S_CLR_ERR(error);
+	SObjectDecRef(obj);
+}
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* SSynthPipeline class initialization                                              */
+/*                                                                                  */
+/************************************************************************************/
+
+static SSynthPipelineClass SynthPipelineClass =
+{
+	"SSynthPipeline",
+	sizeof(SSynthPipeline),
+	{ 0, 1},
+	InitSynthPipeline,    /* init    */
+	DestroySynthPipeline, /* destroy */
+	DisposeSynthPipeline, /* dispose */
+	NULL,                 /* compare */
+	NULL,                 /* print   */
+	NULL,                 /* copy    */
+};
@@ -0,0 +1,297 @@
+/************************************************************************************/
+/* Copyright (c) 2008-2011 The Department of Arts and Culture,                      */
+/* The Government of the Republic of South Africa.                                  */
+/*                                                                                  */
+/* Contributors:  Meraka Institute, CSIR, South Africa.                             */
+/*                                                                                  */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy     */
+/* of this software and associated documentation files (the "Software"), to deal    */
+/* in the Software without restriction, including without limitation the rights     */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        */
+/* copies of the Software, and to permit persons to whom the Software is            */
+/* furnished to do so, subject to the following conditions:                         */
+/* The above copyright notice and this permission notice shall be included in       */
+/* all copies or substantial portions of the Software.                              */
+/*                                                                                  */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN        */
+/* THE SOFTWARE.                                                                    */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* AUTHOR  : Speect contributors                                                    */
+/* DATE    : 19 October 2026                                                        */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* Stage-pipelined synthesis.                                                       */
+/*                                                                                  */
+/*                                                                                  */
+/************************************************************************************/
+
+#ifndef _SPCT_SYNTH_PIPELINE_H__
+#define _SPCT_SYNTH_PIPELINE_H__
+
+
+/**
+ * @file synthpipeline.h
+ * Stage-pipelined synthesis.
+ */
+
+
+/**
+ * @ingroup SVoices
+ * @defgroup SSynthPipeline Synthesis Pipeline
+ * Synthesis of a stream of utterances with the utterance processors
+ * of an utterance type grouped into stages, for example the text
+ * processing stage up to the lexical lookup, the label stage and the
+ * signal processing stage. Each stage runs in its own thread, with
+ * bounded queues between the stages, so that utterance N+1 is in the
+ * text processing stage while utterance N is in the signal processing
+ * stage. The utterance processors themselves are not changed.
+ *
+ * Requests are delivered in submission order through a future
+ * (#SSynthFuture) or a callback function, as with the synthesis pool
+ * (@ref SSynthPool), and the same rules apply to the shared voice. If
+ * the Speect Engine is built without threads support the stages run
+ * one after the other in the submitting thread.
+ * @{
+ */
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Modules used                                                                     */
+/*                                                                                  */
+/************************************************************************************/
+
+#include "include/common.h"
+#include "base/utils/types.h"
+#include "base/errdbg/errdbg.h"
+#include "base/objsystem/objsystem.h"
+#include "containers/containers.h"
+#include "voicemanager/voice.h"
+#include "voicemanager/synthpool.h"
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Begin external c declaration                                                     */
+/*                                                                                  */
+/************************************************************************************/
+S_BEGIN_C_DECLS
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Macros                                                                           */
+/*                                                                                  */
+/************************************************************************************/
+
+/**
+ * @hideinitializer
+ * Return the given #SSynthPipeline child class object as a synthesis
+ * pipeline object.
+ *
+ * @param SELF The given object.
+ *
+ * @return Given object as #SSynthPipeline* type.
+ *
+ * @note This casting is not safety checked.
+ */
+#define S_SYNTHPIPELINE(SELF)  ((SSynthPipeline *)(SELF))
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Data types                                                                       */
+/*                                                                                  */
+/************************************************************************************/
+
+/**
+ * The pipeline stage structure, opaque.
+ */
+typedef struct s_synth_stage s_synth_stage;
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* SSynthPipeline definition                                                        */
+/*                                                                                  */
+/************************************************************************************/
+
+/**
+ * The SSynthPipeline structure.
+ * @extends SObject
+ */
+typedef struct
+{
+	/**
+	 * @protected Inherit from #SObject.
+	 */
+	SObject        obj;
+
+	/**
+	 * @protected Shared voice.
+	 */
+	const SVoice  *voice;
+
+	/**
+	 * @protected Utterance type of the pipeline.
+	 */
+	char          *utt_type;
+
+	/**
+	 * @protected Execution plan of the utterance type, holds
+	 * references to the utterance processors.
+	 */
+	const struct s_utt_plan *plan;
+
+	/**
+	 * @protected Stages.
+	 */
+	s_synth_stage *stages;
+
+	/**
+	 * @protected Number of stages.
+	 */
+	uint32         num_stages;
+
+	/**
+	 * @protected Number of started stage threads.
+	 */
+	uint32         num_threads;
+} SSynthPipeline;
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* SSynthPipelineClass definition                                                   */
+/*                                                                                  */
+/************************************************************************************/
+
+/**
+ * The SSynthPipelineClass type. Same as #SObjectClass as we
+ * do not add any new methods.
+ * @extends SObjectClass
+ */
+typedef SObjectClass SSynthPipelineClass;
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Function prototypes                                                              */
+/*                                                                                  */
+/************************************************************************************/
+
+/**
+ * Initialize a synthesis pipeline for the given utterance type of
+ * the voice. The utterance processors of the utterance type are split
+ * into stages at the given processors.
+ *
+ * @public @memberof SSynthPipeline
+ * @param self The synthesis pipeline to initialize.
+ * @param voice The voice shared by the stages.
+ * @param utt_type The key of the utterance type as registered in the
+ * #SVoice @c uttTypes container.
+ * @param stages A list of #SString utterance processor names, each
+ * starts a new stage (the first stage starts at the first utterance
+ * processor). The names must be in utterance type order. If @c NULL
+ * every utterance processor is a stage.
+ * @param queue_size The maximum number of requests waiting in the
+ * queue of a stage. Must be greater than 0.
+ * @param error Error code.
+ *
+ * @note The pipeline runs the utterance processors of the utterance
+ * type as they were when it was initialized, later changes to the
+ * utterance processors or types of the voice do not affect it.
+ *
+ * @note If this function fails the pipeline will be deleted and the
+ * @c self variable will be set to @c NULL.
+ */
+S_API void SSynthPipelineInit(SSynthPipeline **self, const SVoice *voice,
+							  const char *utt_type, const SList *stages,
+							  uint32 queue_size, s_erc *error);
+
+
+/**
+ * Submit a synthesis request to the pipeline. Blocks while the queue
+ * of the first stage is full.
+ *
+ * @public @memberof SSynthPipeline
+ * @param self The synthesis pipeline.
+ * @param input The input to the synthesizer.
+ * @param error Error code.
+ *
+ * @return The future of the request.
+ *
+ * @note The caller is responsible for the memory of the returned
+ * future. Deleting a future that is not done waits for the pipeline.
+ *
+ * @note The pipeline takes hold of the @c input #SObject if this
+ * function does not fail.
+ */
+S_API SSynthFuture *SSynthPipelineSubmit(SSynthPipeline *self, SObject *input,
+										 s_erc *error);
+
+
+/**
+ * Submit a synthesis request to the pipeline, delivering the result
+ * to a callback function. The callback is called from the thread of
+ * the last stage the request ran in. Blocks while the queue of the
+ * first stage is full.
+ *
+ * @public @memberof SSynthPipeline
+ * @param self The synthesis pipeline.
+ * @param input The input to the synthesizer.
+ * @param callback The callback function.
+ * @param userdata User data passed to the callback function.
+ * @param error Error code.
+ *
+ * @note The pipeline takes hold of the @c input #SObject if this
+ * function does not fail.
+ */
+S_API void SSynthPipelineSubmitCallback(SSynthPipeline *self, SObject *input,
+										s_synth_pool_cb_fp callback, void *userdata,
+										s_erc *error);
+
+
+/**
+ * Get the number of stages of the pipeline.
+ *
+ * @public @memberof SSynthPipeline
+ * @param self The synthesis pipeline.
+ * @param error Error code.
+ *
+ * @return The number of stages.
+ */
+S_API uint32 SSynthPipelineNumStages(const SSynthPipeline *self, s_erc *error);
+
+
+/**
+ * Add the SSynthPipeline class to the object system.
+ * @private
+ *
+ * @param error Error code.
+ */
+S_LOCAL void _s_synth_pipeline_class_add(s_erc *error);
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* End external c declaration                                                       */
+/*                                                                                  */
+/************************************************************************************/
+S_END_C_DECLS
+
+
+/**
+ * @}
+ * end documentation
+ */
+
+#endif /* _SPCT_SYNTH_PIPELINE_H__ */
@@ -0,0 +1,785 @@
+/************************************************************************************/
+/* Copyright (c) 2008-2011 The Department of Arts and Culture,                      */
+/* The Government of the Republic of South Africa.                                  */
+/*                                                                                  */
+/* Contributors:  Meraka Institute, CSIR, South Africa.                             */
+/*                                                                                  */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy     */
+/* of this software and associated documentation files (the "Software"), to deal    */
+/* in the Software without restriction, including without limitation the rights     */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        */
+/* copies of the Software, and to permit persons to whom the Software is            */
+/* furnished to do so, subject to the following conditions:                         */
+/* The above copyright notice and this permission notice shall be included in       */
+/* all copies or substantial portions of the Software.                              */
+/*                                                                                  */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN        */
+/* THE SOFTWARE.                                                                    */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* AUTHOR  : Speect contributors                                                    */
+/* DATE    : 19 October 2026                                                        */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* Synthesis worker pool.                                                           */
+/*                                                                                  */
+/*                                                                                  */
+/************************************************************************************/
+
+/************************************************************************************/
+/*                                                                                  */
+/* Modules used                                                                     */
+/*                                                                                  */
+/************************************************************************************/
+
+#include "base/strings/strings.h"
+#include "voicemanager/synthpool.h"
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static variables                                                                 */
+/*                                                                                  */
+/************************************************************************************/
+
+static SSynthFutureClass SynthFutureClass; /* SSynthFuture class declaration. */
+
+static SSynthPoolClass SynthPoolClass;     /* SSynthPool class declaration.   */
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static function prototypes                                                       */
+/*                                                                                  */
+/************************************************************************************/
+
+static SSynthFuture *submit_request(SSynthPool *self, const char *utt_type,
+									SObject *input, SUtterance *utt,
+									s_synth_pool_cb_fp callback,
+									void *userdata, s_erc *error);
+
+static void run_request(const SSynthPool *self, SSynthFuture *request);
+
+static SUtterance *wait_request(SSynthFuture *self, s_erc *result);
+
+#ifdef SPCT_USE_THREADS
+static void synth_pool_worker(void *arg);
+#endif /* SPCT_USE_THREADS */
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Function implementations                                                         */
+/*                                                                                  */
+/************************************************************************************/
+
+S_API void SSynthPoolInit(SSynthPool **self, const SVoice *voice,
+						  uint32 num_workers, uint32 queue_size,
+						  s_erc *error)
+{
+#ifdef SPCT_USE_THREADS
+	uint32 i;
+#endif /* SPCT_USE_THREADS */
+
+
+	S_CLR_ERR(error);
+
+	if (*self == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SSynthPoolInit",
+				  "Argument \"self\" is NULL");
+		return;
+	}
+
+	if (voice == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SSynthPoolInit",
+				  "Argument \"voice\" is NULL");
+		S_DELETE(*self, "SSynthPoolInit", error);
+		*self = NULL;
+		return;
+	}
+
+	if (queue_size == 0)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SSynthPoolInit",
+				  "Argument \"queue_size\" is 0");
+		S_DELETE(*self, "SSynthPoolInit", error);
+		*self = NULL;
+		return;
+	}
+
+	(*self)->voice = voice;
+	(*self)->queue_size = queue_size;
+
+#ifdef SPCT_USE_THREADS
+	if (num_workers == 0)
+		return;
+
+	(*self)->workers = S_CALLOC(s_thread, num_workers);
+	if ((*self)->workers == NULL)
+	{
+		S_FTL_ERR(error, S_MEMERROR,
+				  "SSynthPoolInit",
+				  "Failed to allocate memory for 's_thread' objects");
+		S_DELETE(*self, "SSynthPoolInit", error);
+		*self = NULL;
+		return;
+	}
+
+	for (i = 0; i < num_workers; i++)
+	{
+		s_thread_create(&((*self)->workers[i]), synth_pool_worker, *self, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "SSynthPoolInit",
+					  "Call to \"s_thread_create\" failed"))
+		{
+			/* only join the started workers */
+			(*self)->num_workers = i;
+			S_DELETE(*self, "SSynthPoolInit", error);
+			*self = NULL;
+			return;
+		}
+	}
+
+	(*self)->num_workers = num_workers;
+#else /* !SPCT_USE_THREADS */
+	/* synthesize in the submitting thread */
+	S_UNUSED(num_workers);
+#endif /* SPCT_USE_THREADS */
+}
+
+
+S_API SSynthFuture *SSynthPoolSubmit(SSynthPool *self, const char *utt_type,
+									 SObject *input, s_erc *error)
+{
+	SSynthFuture *future;
+
+
+	S_CLR_ERR(error);
+
+	if (self == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SSynthPoolSubmit",
+				  "Argument \"self\" is NULL");
+		return NULL;
+	}
+
+	future = submit_request(self, utt_type, input, NULL, NULL, NULL, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SSynthPoolSubmit",
+				  "Call to \"submit_request\" failed"))
+		return NULL;
+
+	return future;
+}
+
+
+S_API void SSynthPoolSubmitCallback(SSynthPool *self, const char *utt_type,
+									SObject *input, s_synth_pool_cb_fp callback,
+									void *userdata, s_erc *error)
+{
+	S_CLR_ERR(error);
+
+	if (self == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SSynthPoolSubmitCallback",
+				  "Argument \"self\" is NULL");
+		return;
+	}
+
+	if (callback == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SSynthPoolSubmitCallback",
+				  "Argument \"callback\" is NULL");
+		return;
+	}
+
+	/* the pool deletes the request after the callback */
+	submit_request(self, utt_type, input, NULL, callback, userdata, error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "SSynthPoolSubmitCallback",
+			  "Call to \"submit_request\" failed");
+}
+
+
+S_API SSynthFuture *SSynthPoolSubmitUtt(SSynthPool *self, const char *utt_type,
+										SUtterance *utt, s_erc *error)
+{
+	SSynthFuture *future;
+
+
+	S_CLR_ERR(error);
+
+	if (self == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SSynthPoolSubmitUtt",
+				  "Argument \"self\" is NULL");
+		return NULL;
+	}
+
+	if (utt == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SSynthPoolSubmitUtt",
+				  "Argument \"utt\" is NULL");
+		return NULL;
+	}
+
+	future = submit_request(self, utt_type, NULL, utt, NULL, NULL, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SSynthPoolSubmitUtt",
+				  "Call to \"submit_request\" failed"))
+		return NULL;
+
+	return future;
+}
+
+
+S_API uint32 SSynthPoolNumWorkers(const SSynthPool *self, s_erc *error)
+{
+	S_CLR_ERR(error);
+
+	if (self == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SSynthPoolNumWorkers",
+				  "Argument \"self\" is NULL");
+		return 0;
+	}
+
+	return self->num_workers;
+}
+
+
+S_API s_bool SSynthFutureIsDone(SSynthFuture *self, s_erc *error)
+{
+	s_bool done;
+
+
+	S_CLR_ERR(error);
+
+	if (self == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SSynthFutureIsDone",
+				  "Argument \"self\" is NULL");
+		return FALSE;
+	}
+
+	s_mutex_lock(&self->future_mutex);
+	done = self->done;
+	s_mutex_unlock(&self->future_mutex);
+
+	return done;
+}
+
+
+S_API SUtterance *SSynthFutureWait(SSynthFuture *self, s_erc *error)
+{
+	SUtterance *utt;
+	s_erc result;
+
+
+	S_CLR_ERR(error);
+
+	if (self == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SSynthFutureWait",
+				  "Argument \"self\" is NULL");
+		return NULL;
+	}
+
+	utt = wait_request(self, &result);
+	if (result != S_SUCCESS)
+	{
+		S_CTX_ERR(error, result,
+				  "SSynthFutureWait",
+				  "Synthesis of the request failed");
+		return NULL;
+	}
+
+	return utt;
+}
+
+
+S_API SObject *SSynthFutureWaitAudio(SSynthFuture *self, s_erc *error)
+{
+	SUtterance *utt;
+	SObject *audio;
+	s_erc result;
+	s_erc local_err = S_SUCCESS;
+
+
+	S_CLR_ERR(error);
+
+	if (self == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SSynthFutureWaitAudio",
+				  "Argument \"self\" is NULL");
+		return NULL;
+	}
+
+	utt = wait_request(self, &result);
+	if (result != S_SUCCESS)
+	{
+		S_CTX_ERR(error, result,
+				  "SSynthFutureWaitAudio",
+				  "Synthesis of the request failed");
+		return NULL;
+	}
+
+	if (utt == NULL)
+		return NULL;
+
+	audio = (SObject*)SUtteranceGetFeature(utt, "audio", error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SSynthFutureWaitAudio",
+				  "Call to \"SUtteranceGetFeature\" failed"))
+	{
+		S_DELETE(utt, "SSynthFutureWaitAudio", &local_err);
+		return NULL;
+	}
+
+	/* keep the audio when the utterance is deleted */
+	SObjectIncRef(audio);
+	S_DELETE(utt, "SSynthFutureWaitAudio", error);
+
+	return audio;
+}
+
+
+S_LOCAL SSynthFuture *_s_synth_future_new(const char *utt_type,
+										 s_synth_pool_cb_fp callback,
+										 void *userdata, s_erc *error)
+{
+	SSynthFuture *request;
+	s_erc local_err = S_SUCCESS;
+
+
+	S_CLR_ERR(error);
+
+	request = S_NEW(SSynthFuture, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "_s_synth_future_new",
+				  "Failed to create new 'SSynthFuture' object"))
+		return NULL;
+
+	request->utt_type = s_strdup(utt_type, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "_s_synth_future_new",
+				  "Call to \"s_strdup\" failed"))
+	{
+		request->done = TRUE; /* not submitted */
+		S_DELETE(request, "_s_synth_future_new", &local_err);
+		return NULL;
+	}
+
+	request->callback = callback;
+	request->userdata = userdata;
+
+	return request;
+}
+
+
+S_LOCAL void _s_synth_future_complete(SSynthFuture *self, SUtterance *utt, s_erc result)
+{
+	s_erc local_err = S_SUCCESS;
+
+
+	if (self->callback != NULL)
+	{
+		self->callback(utt, result, self->userdata);
+		S_DELETE(self, "_s_synth_future_complete", &local_err);
+		return;
+	}
+
+	/* the future must not be touched after the unlock */
+	s_mutex_lock(&self->future_mutex);
+	self->utt = utt;
+	self->result = result;
+	self->done = TRUE;
+	s_cond_broadcast(&self->future_cond);
+	s_mutex_unlock(&self->future_mutex);
+}
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Class registration                                                               */
+/*                                                                                  */
+/************************************************************************************/
+
+S_LOCAL void _s_synth_pool_class_add(s_erc *error)
+{
+	S_CLR_ERR(error);
+
+	s_class_add(S_OBJECTCLASS(&SynthFutureClass), error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "_s_synth_pool_class_add",
+				  "Failed to add SSynthFutureClass"))
+		return;
+
+	s_class_add(S_OBJECTCLASS(&SynthPoolClass), error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "_s_synth_pool_class_add",
+			  "Failed to add SSynthPoolClass");
+}
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static function implementations                                                  */
+/*                                                                                  */
+/************************************************************************************/
+
+static SSynthFuture *submit_request(SSynthPool *self, const char *utt_type,
+									SObject *input, SUtterance *utt,
+									s_synth_pool_cb_fp callback,
+									void *userdata, s_erc *error)
+{
+	SSynthFuture *request;
+	s_bool key_present;
+	s_erc local_err = S_SUCCESS;
+
+
+	S_CLR_ERR(error);
+
+	if (utt_type == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "submit_request",
+				  "Argument \"utt_type\" is NULL");
+		return NULL;
+	}
+
+	if ((input == NULL) && (utt == NULL))
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "submit_request",
+				  "Argument \"input\" is NULL");
+		return NULL;
+	}
+
+	/* fail here and not in the worker */
+	key_present = SVoiceUttTypeIsPresent(self->voice, utt_type, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "submit_request",
+				  "Call to \"SVoiceUttTypeIsPresent\" failed"))
+		return NULL;
+
+	if (!key_present)
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "submit_request",
+				  "Given voice does not have a \'%s\' utterance type",
+				  utt_type);
+		return NULL;
+	}
+
+	request = _s_synth_future_new(utt_type, callback, userdata, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "submit_request",
+				  "Call to \"_s_synth_future_new\" failed"))
+		return NULL;
+
+	if (self->num_workers == 0)
+	{
+		request->input = input;
+		request->utt = utt;
+		run_request(self, request); /* deletes a callback request */
+		return (callback == NULL) ? request : NULL;
+	}
+
+	s_mutex_lock(&self->pool_mutex);
+
+	while ((self->queued >= self->queue_size) && !self->shutdown)
+		s_cond_wait(&self->not_full, &self->pool_mutex);
+
+	if (self->shutdown)
+	{
+		s_mutex_unlock(&self->pool_mutex);
+		S_CTX_ERR(error, S_FAILURE,
+				  "submit_request",
+				  "Synthesis pool is shutting down");
+		request->done = TRUE; /* not submitted */
+		S_DELETE(request, "submit_request", &local_err);
+		return NULL;
+	}
+
+	request->input = input;
+	request->utt = utt;
+	request->next = NULL;
+	if (self->tail == NULL)
+		self->head = request;
+	else
+		self->tail->next = request;
+	self->tail = request;
+	self->queued++;
+
+	s_cond_signal(&self->not_empty);
+	s_mutex_unlock(&self->pool_mutex);
+
+	/* a callback request may already be deleted by a worker */
+	return (callback == NULL) ? request : NULL;
+}
+
+
+static void run_request(const SSynthPool *self, SSynthFuture *request)
+{
+	SUtterance *utt;
+	s_erc result = S_SUCCESS;
+	s_erc local_err = S_SUCCESS;
+
+
+	if (request->input == NULL)
+	{
+		/* a request without input carries its utterance */
+		utt = request->utt;
+		request->utt = NULL;
+		SVoiceReSynthUtt(self->voice, request->utt_type, utt, &result);
+		S_CHK_ERR(&result, S_CONTERR,
+				  "run_request",
+				  "Call to \"SVoiceReSynthUtt\" failed");
+	}
+	else
+	{
+		/* the voice takes hold of the input */
+		utt = SVoiceSynthUtt(self->voice, request->utt_type, request->input, &result);
+		request->input = NULL;
+		S_CHK_ERR(&result, S_CONTERR,
+				  "run_request",
+				  "Call to \"SVoiceSynthUtt\" failed");
+	}
+
+	if (result != S_SUCCESS)
+	{
+		S_DELETE(utt, "run_request", &local_err);
+		utt = NULL;
+	}
+
+	_s_synth_future_complete(request, utt, result);
+}
+
+
+static SUtterance *wait_request(SSynthFuture *self, s_erc *result)
+{
+	SUtterance *utt;
+
+
+	s_mutex_lock(&self->future_mutex);
+
+	while (!self->done)
+		s_cond_wait(&self->future_cond, &self->future_mutex);
+
+	utt = self->utt;
+	self->utt = NULL;
+	*result = self->result;
+
+	s_mutex_unlock(&self->future_mutex);
+
+	return utt;
+}
+
+
+#ifdef SPCT_USE_THREADS
+static void synth_pool_worker(void *arg)
+{
+	SSynthPool *self = arg;
+	SSynthFuture *request;
+
+
+	s_mutex_lock(&self->pool_mutex);
+
+	while (TRUE)
+	{
+		while ((self->head == NULL) && !self->shutdown)
+			s_cond_wait(&self->not_empty, &self->pool_mutex);
+
+		/* drain the queue before shutting down */
+		if (self->head == NULL)
+			break;
+
+		request = self->head;
+		self->head = request->next;
+		if (self->head == NULL)
+			self->tail = NULL;
+		self->queued--;
+
+		s_cond_signal(&self->not_full);
+		s_mutex_unlock(&self->pool_mutex);
+
+		run_request(self, request);
+
+		s_mutex_lock(&self->pool_mutex);
+	}
+
+	s_mutex_unlock(&self->pool_mutex);
+}
+#endif /* SPCT_USE_THREADS */
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static class function implementations                                            */
+/*                                                                                  */
+/************************************************************************************/
+
+static void InitSynthFuture(void *obj, s_erc *error)
+{
+	SSynthFuture *self = obj;
+
+
+	S_CLR_ERR(error);
+
+	self->utt_type = NULL;
+	self->input = NULL;
+	self->utt = NULL;
+	self->result = S_SUCCESS;
+	self->callback = NULL;
+	self->userdata = NULL;
+	self->done = FALSE;
+	self->next = NULL;
+	self->epoch = NULL;
+	s_mutex_init(&self->future_mutex);
+	s_cond_init(&self->future_cond);
+}
+
+
+static void DestroySynthFuture(void *obj, s_erc *error)
+{
+	SSynthFuture *self = obj;
+	SUtterance *utt = NULL;
+	s_erc local_err = S_SUCCESS;
+
+
+	S_CLR_ERR(error);
+
+	/* wait for the worker to let go of a pending future */
+	if (self->callback == NULL)
+		utt = wait_request(self, &local_err);
+
+	if (utt != NULL)
+		S_DELETE(utt, "DestroySynthFuture", error);
+
+	if (self->input != NULL)
+		S_DELETE(self->input, "DestroySynthFuture", error);
+
+	if (self->utt_type != NULL)
+		S_FREE(self->utt_type);
+
+	s_cond_destroy(&self->future_cond);
+	s_mutex_destroy(&self->future_mutex);
+}
+
+
+static void DisposeSynthFuture(void *obj, s_erc *error)
+{
+	S_CLR_ERR(error);
+	SObjectDecRef(obj);
+}
+
+
+static void InitSynthPool(void *obj, s_erc *error)
+{
+	SSynthPool *self = obj;
+
+
+	S_CLR_ERR(error);
+
+	self->voice = NULL;
+	self->workers = NULL;
+	self->num_workers = 0;
+	self->head = NULL;
+	self->tail = NULL;
+	self->queued = 0;
+	self->queue_size = 0;
+	self->shutdown = FALSE;
+	s_mutex_init(&self->pool_mutex);
+	s_cond_init(&self->not_empty);
+	s_cond_init(&self->not_full);
+}
+
+
+static void DestroySynthPool(void *obj, s_erc *error)
+{
+	SSynthPool *self = obj;
+	uint32 i;
+
+
+	S_CLR_ERR(error);
+
+	s_mutex_lock(&self->pool_mutex);
+	self->shutdown = TRUE;
+	s_cond_broadcast(&self->not_empty);
+	s_cond_broadcast(&self->not_full);
+	s_mutex_unlock(&self->pool_mutex);
+
+	/* the workers finish the queued requests */
+	for (i = 0; i < self->num_workers; i++)
+		s_thread_join(&(self->workers[i]));
+
+	if (self->workers != NULL)
+		S_FREE(self->workers);
+
+	s_cond_destroy(&self->not_full);
+	s_cond_destroy(&self->not_empty);
+	s_mutex_destroy(&self->pool_mutex);
+}
+
+
+static void DisposeSynthPool(void *obj, s_erc *error)
+{
+	S_CLR_ERR(error);
+	SObjectDecRef(obj);
+}
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* SSynthFuture and SSynthPool class initialization                                 */
+/*                                                                                  */
+/************************************************************************************/
+
+static SSynthFutureClass SynthFutureClass =
+{
+	"SSynthFuture",
+	sizeof(SSynthFuture),
+	{ 0, 1},
+	InitSynthFuture,    /* init    */
+	DestroySynthFuture, /* destroy */
+	DisposeSynthFuture, /* dispose */
+	NULL,               /* compare */
+	NULL,               /* print   */
+	NULL,               /* copy    */
+};
+
+
+static SSynthPoolClass SynthPoolClass =
+{
+	"SSynthPool",
+	sizeof(SSynthPool),
+	{ 0, 1},
+	InitSynthPool,      /* init    */
+	DestroySynthPool,   /* destroy */
+	DisposeSynthPool,   /* dispose */
+	NULL,               /* compare */
+	NULL,               /* print   */
+	NULL,               /* copy    */
+};
@@ -0,0 +1,527 @@
+/************************************************************************************/
+/* Copyright (c) 2008-2011 The Department of Arts and Culture,                      */
+/* The Government of the Republic of South Africa.                                  */
+/*                                                                                  */
+/* Contributors:  Meraka Institute, CSIR, South Africa.                             */
+/*                                                                                  */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy     */
+/* of this software and associated documentation files (the "Software"), to deal    */
+/* in the Software without restriction, including without limitation the rights     */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        */
+/* copies of the Software, and to permit persons to whom the Software is            */
+/* furnished to do so, subject to the following conditions:                         */
+/* The above copyright notice and this permission notice shall be included in       */
+/* all copies or substantial portions of the Software.                              */
+/*                                                                                  */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN        */
+/* THE SOFTWARE.                                                                    */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* AUTHOR  : Speect contributors                                                    */
+/* DATE    : 19 October 2026                                                        */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* Synthesis worker pool.                                                           */
+/*                                                                                  */
+/*                                                                                  */
+/************************************************************************************/
+
+#ifndef _SPCT_SYNTH_POOL_H__
+#define _SPCT_SYNTH_POOL_H__
+
+
+/**
+ * @file synthpool.h
+ * Synthesis worker pool.
+ */
+
+
+/**
+ * @ingroup SVoices
+ * @defgroup SSynthPool Synthesis Worker Pool
+ * A pool of worker threads synthesizing utterances with one shared
+ * voice. Requests are submitted to a bounded queue and delivered
+ * through a future (#SSynthFuture) or a callback function. All the
+ * workers share the one loaded #SVoice, so a server process can use
+ * all its cores with one copy of the voice data.
+ *
+ * The voice must stay loaded for the lifetime of the pool, and its
+ * features, processors and utterance types must not be changed while
+ * the pool is running (voice data can be reloaded with
+ * #SVoiceReloadData). If the Speect Engine is built without threads
+ * support, or the pool has no workers, requests are synthesized in
+ * the submitting thread.
+ * @{
+ */
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Modules used                                                                     */
+/*                                                                                  */
+/************************************************************************************/
+
+#include "include/common.h"
+#include "base/utils/types.h"
+#include "base/errdbg/errdbg.h"
+#include "base/threads/threads.h"
+#include "base/objsystem/objsystem.h"
+#include "hrg/hrg.h"
+#include "voicemanager/voice.h"
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Begin external c declaration                                                     */
+/*                                                                                  */
+/************************************************************************************/
+S_BEGIN_C_DECLS
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Macros                                                                           */
+/*                                                                                  */
+/************************************************************************************/
+
+/**
+ * @hideinitializer
+ * Return the given #SSynthPool child class object as a synthesis
+ * pool object.
+ *
+ * @param SELF The given object.
+ *
+ * @return Given object as #SSynthPool* type.
+ *
+ * @note This casting is not safety checked.
+ */
+#define S_SYNTHPOOL(SELF)  ((SSynthPool *)(SELF))
+
+
+/**
+ * @hideinitializer
+ * Return the given #SSynthFuture child class object as a synthesis
+ * future object.
+ *
+ * @param SELF The given object.
+ *
+ * @return Given object as #SSynthFuture* type.
+ *
+ * @note This casting is not safety checked.
+ */
+#define S_SYNTHFUTURE(SELF)  ((SSynthFuture *)(SELF))
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Data types                                                                       */
+/*                                                                                  */
+/************************************************************************************/
+
+/**
+ * Synthesis request callback function type. Called from the worker
+ * thread that synthesized the request.
+ *
+ * @param utt The synthesized utterance, @c NULL if synthesis
+ * failed. The callback is responsible for the memory of the
+ * utterance.
+ * @param result The error code of the synthesis.
+ * @param userdata The user data given with the request.
+ */
+typedef void (*s_synth_pool_cb_fp)(SUtterance *utt, s_erc result, void *userdata);
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* SSynthFuture definition                                                          */
+/*                                                                                  */
+/************************************************************************************/
+
+/**
+ * The SSynthFuture structure. The future of a synthesis request,
+ * see #SSynthPoolSubmit.
+ * @extends SObject
+ */
+typedef struct SSynthFuture
+{
+	/**
+	 * @protected Inherit from #SObject.
+	 */
+	SObject              obj;
+
+	/**
+	 * @protected Utterance type of the request.
+	 */
+	char                *utt_type;
+
+	/**
+	 * @protected Input of the request, taken by the voice.
+	 */
+	SObject             *input;
+
+	/**
+	 * @protected Synthesized utterance, or the utterance to
+	 * synthesize of a request without input.
+	 */
+	SUtterance          *utt;
+
+	/**
+	 * @protected Error code of the synthesis.
+	 */
+	s_erc                result;
+
+	/**
+	 * @protected Callback of the request, @c NULL for a future.
+	 */
+	s_synth_pool_cb_fp   callback;
+
+	/**
+	 * @protected Callback user data.
+	 */
+	void                *userdata;
+
+	/**
+	 * @protected Synthesis done flag.
+	 */
+	s_bool               done;
+
+	/**
+	 * @protected Next request in the pool or pipeline stage queue.
+	 */
+	struct SSynthFuture *next;
+
+	/**
+	 * @protected Voice data epoch of a request in a pipeline.
+	 */
+	struct s_data_epoch *epoch;
+
+	/**
+	 * @protected Locking mutex.
+	 */
+	S_DECLARE_MUTEX(future_mutex);
+
+	/**
+	 * @protected Signals done.
+	 */
+	S_DECLARE_COND(future_cond);
+} SSynthFuture;
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* SSynthPool definition                                                            */
+/*                                                                                  */
+/************************************************************************************/
+
+/**
+ * The SSynthPool structure.
+ * @extends SObject
+ */
+typedef struct
+{
+	/**
+	 * @protected Inherit from #SObject.
+	 */
+	SObject       obj;
+
+	/**
+	 * @protected Shared voice.
+	 */
+	const SVoice *voice;
+
+	/**
+	 * @protected Worker threads.
+	 */
+	s_thread     *workers;
+
+	/**
+	 * @protected Number of worker threads.
+	 */
+	uint32        num_workers;
+
+	/**
+	 * @protected Queue head (oldest request).
+	 */
+	SSynthFuture *head;
+
+	/**
+	 * @protected Queue tail (newest request).
+	 */
+	SSynthFuture *tail;
+
+	/**
+	 * @protected Number of queued requests.
+	 */
+	uint32        queued;
+
+	/**
+	 * @protected Maximum number of queued requests.
+	 */
+	uint32        queue_size;
+
+	/**
+	 * @protected Pool is shutting down.
+	 */
+	s_bool        shutdown;
+
+	/**
+	 * @protected Locking mutex.
+	 */
+	S_DECLARE_MUTEX(pool_mutex);
+
+	/**
+	 * @protected Signals queued requests and shutdown.
+	 */
+	S_DECLARE_COND(not_empty);
+
+	/**
+	 * @protected Signals space in the queue.
+	 */
+	S_DECLARE_COND(not_full);
+} SSynthPool;
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* SSynthFutureClass and SSynthPoolClass definitions                                */
+/*                                                                                  */
+/************************************************************************************/
+
+/**
+ * The SSynthFutureClass type. Same as #SObjectClass as we
+ * do not add any new methods.
+ * @extends SObjectClass
+ */
+typedef SObjectClass SSynthFutureClass;
+
+
+/**
+ * The SSynthPoolClass type. Same as #SObjectClass as we
+ * do not add any new methods.
+ * @extends SObjectClass
+ */
+typedef SObjectClass SSynthPoolClass;
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Function prototypes                                                              */
+/*                                                                                  */
+/************************************************************************************/
+
+/**
+ * Initialize a synthesis pool. Starts @c num_workers worker threads
+ * that synthesize with the given voice.
+ *
+ * @public @memberof SSynthPool
+ * @param self The synthesis pool to initialize.
+ * @param voice The voice shared by the workers.
+ * @param num_workers The number of worker threads, if 0 the requests
+ * are synthesized in the submitting thread.
+ * @param queue_size The maximum number of requests waiting in the
+ * queue, #SSynthPoolSubmit blocks when the queue is full. Must be
+ * greater than 0.
+ * @param error Error code.
+ *
+ * @note If this function fails the pool will be deleted and the @c
+ * self variable will be set to @c NULL.
+ */
+S_API void SSynthPoolInit(SSynthPool **self, const SVoice *voice,
+						  uint32 num_workers, uint32 queue_size,
+						  s_erc *error);
+
+
+/**
+ * Submit a synthesis request to the pool. The request is synthesized
+ * with #SVoiceSynthUtt by one of the workers. Blocks while the
+ * queue is full.
+ *
+ * @public @memberof SSynthPool
+ * @param self The synthesis pool.
+ * @param utt_type The key of the utterance type as registered in the
+ * #SVoice @c uttTypes container.
+ * @param input The input to the synthesizer.
+ * @param error Error code.
+ *
+ * @return The future of the request.
+ *
+ * @note The caller is responsible for the memory of the returned
+ * future. Deleting a future that is not done waits for the worker.
+ *
+ * @note The pool takes hold of the @c input #SObject if this function
+ * does not fail.
+ */
+S_API SSynthFuture *SSynthPoolSubmit(SSynthPool *self, const char *utt_type,
+									 SObject *input, s_erc *error);
+
+
+/**
+ * Submit a synthesis request to the pool, delivering the result to a
+ * callback function. The callback is called from the worker thread
+ * that synthesized the request. Blocks while the queue is full.
+ *
+ * @public @memberof SSynthPool
+ * @param self The synthesis pool.
+ * @param utt_type The key of the utterance type as registered in the
+ * #SVoice @c uttTypes container.
+ * @param input The input to the synthesizer.
+ * @param callback The callback function.
+ * @param userdata User data passed to the callback function.
+ * @param error Error code.
+ *
+ * @note The pool takes hold of the @c input #SObject if this function
+ * does not fail.
+ */
+S_API void SSynthPoolSubmitCallback(SSynthPool *self, const char *utt_type,
+									SObject *input, s_synth_pool_cb_fp callback,
+									void *userdata, s_erc *error);
+
+
+/**
+ * Submit a synthesis request of an utterance to the pool. The
+ * utterance is synthesized with #SVoiceReSynthUtt by one of the
+ * workers, so that features set on it before, for example an @c
+ * "audio-stream" (see #SAudioStreamGetFromUtt), are seen by the
+ * utterance processors. Blocks while the queue is full.
+ *
+ * @public @memberof SSynthPool
+ * @param self The synthesis pool.
+ * @param utt_type The key of the utterance type as registered in the
+ * #SVoice @c uttTypes container.
+ * @param utt The utterance to synthesize.
+ * @param error Error code.
+ *
+ * @return The future of the request.
+ *
+ * @note The caller is responsible for the memory of the returned
+ * future. Deleting a future that is not done waits for the worker.
+ *
+ * @note The pool takes hold of the utterance if this function does
+ * not fail, it is returned by #SSynthFutureWait.
+ */
+S_API SSynthFuture *SSynthPoolSubmitUtt(SSynthPool *self, const char *utt_type,
+										SUtterance *utt, s_erc *error);
+
+
+/**
+ * Get the number of worker threads of the pool.
+ *
+ * @public @memberof SSynthPool
+ * @param self The synthesis pool.
+ * @param error Error code.
+ *
+ * @return The number of worker threads.
+ */
+S_API uint32 SSynthPoolNumWorkers(const SSynthPool *self, s_erc *error);
+
+
+/**
+ * Query if the synthesis of the request is done.
+ *
+ * @public @memberof SSynthFuture
+ * @param self The future.
+ * @param error Error code.
+ *
+ * @return #TRUE if done, else #FALSE.
+ */
+S_API s_bool SSynthFutureIsDone(SSynthFuture *self, s_erc *error);
+
+
+/**
+ * Wait for the synthesis of the request and get the synthesized
+ * utterance.
+ *
+ * @public @memberof SSynthFuture
+ * @param self The future.
+ * @param error Error code, set to the error of the synthesis if it
+ * failed.
+ *
+ * @return The synthesized utterance, or @c NULL if the synthesis
+ * failed or the utterance has already been taken from the future.
+ *
+ * @note The caller is responsible for the memory of the returned
+ * utterance.
+ */
+S_API SUtterance *SSynthFutureWait(SSynthFuture *self, s_erc *error);
+
+
+/**
+ * Wait for the synthesis of the request and get the synthesized
+ * audio, the @c "audio" feature of the utterance. The utterance is
+ * deleted.
+ *
+ * @public @memberof SSynthFuture
+ * @param self The future.
+ * @param error Error code, set to the error of the synthesis if it
+ * failed.
+ *
+ * @return The synthesized audio, or @c NULL if the synthesis failed
+ * or the utterance has already been taken from the future.
+ *
+ * @note The caller is responsible for the memory of the returned
+ * audio object.
+ */
+S_API SObject *SSynthFutureWaitAudio(SSynthFuture *self, s_erc *error);
+
+
+/**
+ * Create a new synthesis request future. Used by the synthesis
+ * executors (#SSynthPool and #SSynthPipeline).
+ *
+ * @private
+ * @param utt_type The key of the utterance type of the request.
+ * @param callback The callback function of the request, @c NULL for
+ * a future.
+ * @param userdata User data passed to the callback function.
+ * @param error Error code.
+ *
+ * @return The new request.
+ */
+S_LOCAL SSynthFuture *_s_synth_future_new(const char *utt_type,
+										 s_synth_pool_cb_fp callback,
+										 void *userdata, s_erc *error);
+
+
+/**
+ * Complete a synthesis request. A callback request is delivered to
+ * its callback and deleted, a future is marked done and its waiters
+ * woken. The request must not be used by the executor afterwards.
+ *
+ * @private
+ * @param self The request.
+ * @param utt The synthesized utterance, @c NULL if synthesis failed.
+ * @param result The error code of the synthesis.
+ */
+S_LOCAL void _s_synth_future_complete(SSynthFuture *self, SUtterance *utt, s_erc result);
+
+
+/**
+ * Add the SSynthFuture and SSynthPool classes to the object system.
+ * @private
+ *
+ * @param error Error code.
+ */
+S_LOCAL void _s_synth_pool_class_add(s_erc *error);
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* End external c declaration                                                       */
+/*                                                                                  */
+/************************************************************************************/
+S_END_C_DECLS
+
+
+/**
+ * @}
+ * end documentation
+ */
+
+#endif /* _SPCT_SYNTH_POOL_H__ */
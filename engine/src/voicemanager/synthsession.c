@@ -0,0 +1,601 @@
+/************************************************************************************/
+/* Copyright (c) 2008-2011 The Department of Arts and Culture,                      */
+/* The Government of the Republic of South Africa.                                  */
+/*                                                                                  */
+/* Contributors:  Meraka Institute, CSIR, South Africa.                             */
+/*                                                                                  */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy     */
+/* of this software and associated documentation files (the "Software"), to deal    */
+/* in the Software without restriction, including without limitation the rights     */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        */
+/* copies of the Software, and to permit persons to whom the Software is            */
+/* furnished to do so, subject to the following conditions:                         */
+/* The above copyright notice and this permission notice shall be included in       */
+/* all copies or substantial portions of the Software.                              */
+/*                                                                                  */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN        */
+/* THE SOFTWARE.                                                                    */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* AUTHOR  : Speect contributors                                                    */
+/* DATE    : 19 October 2026                                                        */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* Incremental text synthesis session.                                              */
+/*                                                                                  */
+/*                                                                                  */
+/************************************************************************************/
+
+/************************************************************************************/
+/*                                                                                  */
+/* Modules used                                                                     */
+/*                                                                                  */
+/************************************************************************************/
+
+#include <string.h>
+#include "base/strings/strings.h"
+#include "voicemanager/synthtext.h"
+#include "voicemanager/synthsession.h"
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static variables                                                                 */
+/*                                                                                  */
+/************************************************************************************/
+
+static SSynthSessionClass SynthSessionClass; /* SSynthSession class declaration. */
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static function prototypes                                                       */
+/*                                                                                  */
+/************************************************************************************/
+
+static void submit_texts(SSynthSession *self, s_bool finish, s_erc *error);
+
+static void submit_text(SSynthSession *self, const char *text, s_erc *error);
+
+static void reap_futures(SSynthSession *self, s_bool wait, s_erc *error);
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Function implementations                                                         */
+/*                                                                                  */
+/************************************************************************************/
+
+S_API void s_synth_session_opts_init(s_synth_session_opts *opts)
+{
+	if (opts == NULL)
+		return;
+
+	opts->utt_type = "text";
+	opts->uttbreak = "UttBreak";
+	opts->queue_size = 16;
+	opts->chunk_size = 0;
+	opts->chunk_callback = NULL;
+	opts->userdata = NULL;
+	opts->keep = FALSE;
+}
+
+
+S_API void SSynthSessionInit(SSynthSession **self, const SVoice *voice,
+							 const s_synth_session_opts *opts, s_erc *error)
+{
+	s_synth_session_opts defaults;
+
+
+	S_CLR_ERR(error);
+
+	if (*self == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SSynthSessionInit",
+				  "Argument \"self\" is NULL");
+		return;
+	}
+
+	if (voice == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SSynthSessionInit",
+				  "Argument \"voice\" is NULL");
+		goto quit_error;
+	}
+
+	if (opts == NULL)
+	{
+		s_synth_session_opts_init(&defaults);
+		opts = &defaults;
+	}
+
+	(*self)->voice = voice;
+
+	(*self)->utt_type = s_strdup(opts->utt_type, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SSynthSessionInit",
+				  "Call to \"s_strdup\" failed"))
+		goto quit_error;
+
+	(*self)->uttbreak = s_strdup(opts->uttbreak, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SSynthSessionInit",
+				  "Call to \"s_strdup\" failed"))
+		goto quit_error;
+
+	(*self)->stream = S_NEW(SAudioStream, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SSynthSessionInit",
+				  "Failed to create new 'SAudioStream' object"))
+		goto quit_error;
+
+	SAudioStreamInit(&((*self)->stream), opts->chunk_size, opts->chunk_callback,
+					 opts->userdata, opts->keep, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SSynthSessionInit",
+				  "Call to \"SAudioStreamInit\" failed"))
+		goto quit_error;
+
+	/* the session keeps the stream, the utterances share it */
+	SObjectIncRef(S_OBJECT((*self)->stream));
+
+	/* one worker, the utterances write to the stream in text order */
+	(*self)->pool = S_NEW(SSynthPool, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SSynthSessionInit",
+				  "Failed to create new 'SSynthPool' object"))
+		goto quit_error;
+
+	SSynthPoolInit(&((*self)->pool), voice, 1, opts->queue_size, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SSynthSessionInit",
+				  "Call to \"SSynthPoolInit\" failed"))
+		goto quit_error;
+
+	return;
+
+	/* error clean-up */
+quit_error:
+	{
+		s_erc local_err = S_SUCCESS;
+
+
+		S_DELETE(*self, "SSynthSessionInit", &local_err);
+		*self = NULL;
+	}
+}
+
+
+S_API void SSynthSessionFeed(SSynthSession *self, const char *text, s_erc *error)
+{
+	S_CLR_ERR(error);
+
+	if (self == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SSynthSessionFeed",
+				  "Argument \"self\" is NULL");
+		return;
+	}
+
+	if (text == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SSynthSessionFeed",
+				  "Argument \"text\" is NULL");
+		return;
+	}
+
+	/* let go of the utterances that are done */
+	reap_futures(self, FALSE, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SSynthSessionFeed",
+				  "Call to \"reap_futures\" failed"))
+		return;
+
+	if (self->text == NULL)
+		self->text = s_strdup(text, error);
+	else
+		s_sappend(&(self->text), text, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SSynthSessionFeed",
+				  "Failed to append text fragment to session text"))
+		return;
+
+	submit_texts(self, FALSE, error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "SSynthSessionFeed",
+			  "Call to \"submit_texts\" failed");
+}
+
+
+S_API void SSynthSessionFinish(SSynthSession *self, s_erc *error)
+{
+	s_erc local_err = S_SUCCESS;
+
+
+	S_CLR_ERR(error);
+
+	if (self == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SSynthSessionFinish",
+				  "Argument \"self\" is NULL");
+		return;
+	}
+
+	if (self->text != NULL)
+	{
+		submit_texts(self, TRUE, error);
+		S_CHK_ERR(error, S_CONTERR,
+				  "SSynthSessionFinish",
+				  "Call to \"submit_texts\" failed");
+	}
+
+	/* wait for all the submitted utterances, even if the above failed */
+	reap_futures(self, TRUE, &local_err);
+	if (*error != S_SUCCESS)
+		return;
+
+	if (S_CHK_ERR(&local_err, S_CONTERR,
+				  "SSynthSessionFinish",
+				  "Call to \"reap_futures\" failed"))
+	{
+		*error = local_err;
+		return;
+	}
+
+	SAudioStreamFlush(self->stream, error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "SSynthSessionFinish",
+			  "Call to \"SAudioStreamFlush\" failed");
+}
+
+
+S_API SAudioStream *SSynthSessionGetStream(const SSynthSession *self, s_erc *error)
+{
+	S_CLR_ERR(error);
+
+	if (self == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SSynthSessionGetStream",
+				  "Argument \"self\" is NULL");
+		return NULL;
+	}
+
+	return self->stream;
+}
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Class registration                                                               */
+/*                                                                                  */
+/************************************************************************************/
+
+S_LOCAL void _s_synth_session_class_add(s_erc *error)
+{
+	S_CLR_ERR(error);
+	s_class_add(S_OBJECTCLASS(&SynthSessionClass), error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "_s_synth_session_class_add",
+			  "Failed to add SSynthSessionClass");
+}
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static function implementations                                                  */
+/*                                                                                  */
+/************************************************************************************/
+
+/*
+ * Break the buffered text into utterances and submit the complete
+ * ones, all of them if finishing. The text of the last utterance is
+ * kept in the buffer. The utterance texts are located in the buffer,
+ * as the utterance break processor may drop trailing white space that
+ * must be kept for the next fragment.
+ */
+static void submit_texts(SSynthSession *self, s_bool finish, s_erc *error)
+{
+	SUtterance *breakUtt;
+	const SList *uttTexts;
+	const char *utt_text;
+	const char *found;
+	char *tail;
+	size_t num_utts;
+	size_t num_complete;
+	size_t pos = 0;
+	size_t i;
+	s_erc local_err = S_SUCCESS;
+
+
+	S_CLR_ERR(error);
+
+	breakUtt = _s_synth_text_break(self->voice, self->text, self->uttbreak, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "submit_texts",
+				  "Call to \"_s_synth_text_break\" failed"))
+		return;
+
+	uttTexts = S_LIST(SUtteranceGetFeature(breakUtt, "utterance-texts", error));
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "submit_texts",
+				  "Call to \"SUtteranceGetFeature\" failed"))
+		goto quit;
+
+	num_utts = SListSize(uttTexts, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "submit_texts",
+				  "Call to \"SListSize\" failed"))
+		goto quit;
+
+	if (finish)
+		num_complete = num_utts;
+	else if (num_utts > 0)
+		num_complete = num_utts - 1;
+	else
+		num_complete = 0;
+
+	for (i = 0; i < num_complete; i++)
+	{
+		utt_text = SObjectGetString(SListNth(uttTexts, (uint32)i, error), error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "submit_texts",
+					  "Failed to get utterance text %lu",
+					  (unsigned long)i))
+			goto quit;
+
+		if (!finish)
+		{
+			found = s_strstr(self->text + pos, utt_text, error);
+			if (S_CHK_ERR(error, S_CONTERR,
+						  "submit_texts",
+						  "Call to \"s_strstr\" failed"))
+				goto quit;
+
+			/* keep it in the buffer */
+			if (found == NULL)
+				break;
+
+			pos = (size_t)(found - self->text) + strlen(utt_text);
+		}
+
+		submit_text(self, utt_text, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "submit_texts",
+					  "Call to \"submit_text\" failed"))
+			goto quit;
+	}
+
+	if (finish)
+	{
+		S_FREE(self->text);
+	}
+	else if (pos > 0)
+	{
+		tail = s_strdup(self->text + pos, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "submit_texts",
+					  "Call to \"s_strdup\" failed"))
+			goto quit;
+
+		S_FREE(self->text);
+		self->text = tail;
+	}
+
+	/* clean-up */
+quit:
+	S_DELETE(breakUtt, "submit_texts", &local_err);
+}
+
+
+/*
+ * Submit an utterance writing to the audio stream of the session.
+ */
+static void submit_text(SSynthSession *self, const char *text, s_erc *error)
+{
+	SUtterance *utt;
+	SSynthFuture **futures;
+	SSynthFuture *future;
+	s_erc local_err = S_SUCCESS;
+
+
+	S_CLR_ERR(error);
+
+	if (self->num_futures == self->futures_size)
+	{
+		futures = S_REALLOC(self->futures, SSynthFuture*,
+							(self->futures_size == 0) ? 8 : self->futures_size * 2);
+		if (futures == NULL)
+		{
+			S_FTL_ERR(error, S_MEMERROR,
+					  "submit_text",
+					  "Failed to allocate memory for 'SSynthFuture*' object");
+			return;
+		}
+
+		self->futures = futures;
+		self->futures_size = (self->futures_size == 0) ? 8 : self->futures_size * 2;
+	}
+
+	utt = S_NEW(SUtterance, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "submit_text",
+				  "Failed to create new utterance"))
+		return;
+
+	SUtteranceInit(&utt, self->voice, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "submit_text",
+				  "Failed to initialize new utterance"))
+		return;
+
+	SUtteranceSetFeature(utt, "input", SObjectSetString(text, error), error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "submit_text",
+				  "Failed to set utterance \'input\' feature"))
+		goto quit_error;
+
+	SUtteranceSetFeature(utt, "audio-stream", S_OBJECT(self->stream), error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "submit_text",
+				  "Failed to set utterance \'audio-stream\' feature"))
+		goto quit_error;
+
+	future = SSynthPoolSubmitUtt(self->pool, self->utt_type, utt, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "submit_text",
+				  "Call to \"SSynthPoolSubmitUtt\" failed"))
+		goto quit_error;
+
+	self->futures[self->num_futures++] = future;
+	return;
+
+	/* error clean-up */
+quit_error:
+	S_DELETE(utt, "submit_text", &local_err);
+}
+
+
+/*
+ * Delete the futures of the utterances that are done, in text order,
+ * waiting for them if required. Stops at the first failed utterance.
+ */
+static void reap_futures(SSynthSession *self, s_bool wait, s_erc *error)
+{
+	SUtterance *utt;
+	s_bool is_done;
+	uint32 done = 0;
+	s_erc local_err = S_SUCCESS;
+
+
+	S_CLR_ERR(error);
+
+	while (done < self->num_futures)
+	{
+		if (!wait)
+		{
+			is_done = SSynthFutureIsDone(self->futures[done], error);
+			if (S_CHK_ERR(error, S_CONTERR,
+						  "reap_futures",
+						  "Call to \"SSynthFutureIsDone\" failed"))
+				break;
+
+			if (!is_done)
+				break;
+		}
+
+		utt = SSynthFutureWait(self->futures[done], error);
+		S_DELETE(self->futures[done], "reap_futures", &local_err);
+		done++;
+		if (utt != NULL)
+			S_DELETE(utt, "reap_futures", &local_err);
+
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "reap_futures",
+					  "Synthesis of an utterance of the session failed"))
+			break;
+	}
+
+	if (done == 0)
+		return;
+
+	self->num_futures -= done;
+	memmove(self->futures, self->futures + done,
+			self->num_futures * sizeof(SSynthFuture*));
+}
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static class function implementations                                            */
+/*                                                                                  */
+/************************************************************************************/
+
+static void InitSynthSession(void *obj, s_erc *error)
+{
+	SSynthSession *self = obj;
+
+
+	S_CLR_ERR(error);
+
+	self->voice = NULL;
+	self->utt_type = NULL;
+	self->uttbreak = NULL;
+	self->pool = NULL;
+	self->stream = NULL;
+	self->text = NULL;
+	self->futures = NULL;
+	self->num_futures = 0;
+	self->futures_size = 0;
+}
+
+
+static void DestroySynthSession(void *obj, s_erc *error)
+{
+	SSynthSession *self = obj;
+	uint32 i;
+
+
+	S_CLR_ERR(error);
+
+	/* deleting a future waits for its utterance */
+	for (i = 0; i < self->num_futures; i++)
+		S_DELETE(self->futures[i], "DestroySynthSession", error);
+
+	if (self->futures != NULL)
+		S_FREE(self->futures);
+
+	if (self->pool != NULL)
+		S_DELETE(self->pool, "DestroySynthSession", error);
+
+	if (self->stream != NULL)
+		S_DELETE(self->stream, "DestroySynthSession", error);
+
+	if (self->text != NULL)
+		S_FREE(self->text);
+
+	if (self->uttbreak != NULL)
+		S_FREE(self->uttbreak);
+
+	if (self->utt_type != NULL)
+		S_FREE(self->utt_type);
+}
+
+
+static void DisposeSynthSession(void *obj, s_erc *error)
+{
+	S_CLR_ERR(error);
+	SObjectDecRef(obj);
+}
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* SSynthSession class initialization                                               */
+/*                                                                                  */
+/************************************************************************************/
+
+static SSynthSessionClass SynthSessionClass =
+{
+	"SSynthSession",
+	sizeof(SSynthSession),
+	{ 0, 1},
+	InitSynthSession,    /* init    */
+	DestroySynthSession, /* destroy */
+	DisposeSynthSession, /* dispose */
+	NULL,                /* compare */
+	NULL,                /* print   */
+	NULL,                /* copy    */
+};
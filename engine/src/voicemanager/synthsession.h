@@ -0,0 +1,339 @@
+/************************************************************************************/
+/* Copyright (c) 2008-2011 The Department of Arts and Culture,                      */
+/* The Government of the Republic of South Africa.                                  */
+/*                                                                                  */
+/* Contributors:  Meraka Institute, CSIR, South Africa.                             */
+/*                                                                                  */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy     */
+/* of this software and associated documentation files (the "Software"), to deal    */
+/* in the Software without restriction, including without limitation the rights     */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        */
+/* copies of the Software, and to permit persons to whom the Software is            */
+/* furnished to do so, subject to the following conditions:                         */
+/* The above copyright notice and this permission notice shall be included in       */
+/* all copies or substantial portions of the Software.                              */
+/*                                                                                  */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN        */
+/* THE SOFTWARE.                                                                    */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* AUTHOR  : Speect contributors                                                    */
+/* DATE    : 19 October 2026                                                        */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* Incremental text synthesis session.                                              */
+/*                                                                                  */
+/*                                                                                  */
+/************************************************************************************/
+
+#ifndef _SPCT_SYNTH_SESSION_H__
+#define _SPCT_SYNTH_SESSION_H__
+
+
+/**
+ * @file synthsession.h
+ * Incremental text synthesis session.
+ */
+
+
+/**
+ * @ingroup SVoices
+ * @defgroup SSynthSession Incremental Text Synthesis
+ * Synthesis of a text that arrives in fragments, for example token by
+ * token from a dialogue system. The fragments are fed to a session,
+ * which breaks the text received so far into utterances with the
+ * utterance break processor (see @ref SSynthText). Every utterance
+ * except the last is complete, as text following it has been received,
+ * and is synthesized immediately while the last one is buffered until
+ * more text arrives or the session is finished.
+ *
+ * The utterances are synthesized one after the other in a synthesis
+ * worker thread (see @ref SSynthPool), writing their audio to the
+ * audio stream of the session while they are generated. If the Speect
+ * Engine is built without threads support the complete utterances are
+ * synthesized in #SSynthSessionFeed.
+ * @{
+ */
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Modules used                                                                     */
+/*                                                                                  */
+/************************************************************************************/
+
+#include "include/common.h"
+#include "base/utils/types.h"
+#include "base/errdbg/errdbg.h"
+#include "base/objsystem/objsystem.h"
+#include "voicemanager/voice.h"
+#include "voicemanager/audiostream.h"
+#include "voicemanager/synthpool.h"
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Begin external c declaration                                                     */
+/*                                                                                  */
+/************************************************************************************/
+S_BEGIN_C_DECLS
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Macros                                                                           */
+/*                                                                                  */
+/************************************************************************************/
+
+/**
+ * @hideinitializer
+ * Return the given #SSynthSession child class object as a synthesis
+ * session object.
+ *
+ * @param SELF The given object.
+ *
+ * @return Given object as #SSynthSession* type.
+ *
+ * @note This casting is not safety checked.
+ */
+#define S_SYNTHSESSION(SELF)  ((SSynthSession *)(SELF))
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Data types                                                                       */
+/*                                                                                  */
+/************************************************************************************/
+
+/**
+ * Options of #SSynthSessionInit, see #s_synth_session_opts_init for
+ * the defaults.
+ */
+typedef struct
+{
+	/**
+	 * Utterance type of the utterances, default @c "text".
+	 */
+	const char          *utt_type;
+
+	/**
+	 * Key of the utterance break processor in the voice @c
+	 * uttProcessors container, default @c "UttBreak".
+	 */
+	const char          *uttbreak;
+
+	/**
+	 * Maximum number of complete utterances waiting for synthesis,
+	 * #SSynthSessionFeed blocks while there are more, default 16.
+	 */
+	uint32               queue_size;
+
+	/**
+	 * Number of samples of the chunks delivered to the chunk
+	 * callback, default 0 (the samples as they are generated).
+	 */
+	uint32               chunk_size;
+
+	/**
+	 * Chunk callback, default @c NULL.
+	 */
+	s_audio_chunk_cb_fp  chunk_callback;
+
+	/**
+	 * Chunk callback user data, default @c NULL.
+	 */
+	void                *userdata;
+
+	/**
+	 * Keep the audio in the audio stream of the session, default
+	 * #FALSE.
+	 */
+	s_bool               keep;
+} s_synth_session_opts;
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* SSynthSession definition                                                         */
+/*                                                                                  */
+/************************************************************************************/
+
+/**
+ * The SSynthSession structure.
+ * @extends SObject
+ */
+typedef struct
+{
+	/**
+	 * @protected Inherit from #SObject.
+	 */
+	SObject        obj;
+
+	/**
+	 * @protected Voice of the session.
+	 */
+	const SVoice  *voice;
+
+	/**
+	 * @protected Utterance type of the utterances.
+	 */
+	char          *utt_type;
+
+	/**
+	 * @protected Key of the utterance break processor.
+	 */
+	char          *uttbreak;
+
+	/**
+	 * @protected Synthesis pool with one worker.
+	 */
+	SSynthPool    *pool;
+
+	/**
+	 * @protected Audio stream of the session.
+	 */
+	SAudioStream  *stream;
+
+	/**
+	 * @protected Buffered text of the incomplete utterance.
+	 */
+	char          *text;
+
+	/**
+	 * @protected Futures of the submitted utterances, in text order.
+	 */
+	SSynthFuture **futures;
+
+	/**
+	 * @protected Number of futures.
+	 */
+	uint32         num_futures;
+
+	/**
+	 * @protected Allocated size of the futures array.
+	 */
+	uint32         futures_size;
+} SSynthSession;
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* SSynthSessionClass definition                                                    */
+/*                                                                                  */
+/************************************************************************************/
+
+/**
+ * The SSynthSessionClass type. Same as #SObjectClass as we
+ * do not add any new methods.
+ * @extends SObjectClass
+ */
+typedef SObjectClass SSynthSessionClass;
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Function prototypes                                                              */
+/*                                                                                  */
+/************************************************************************************/
+
+/**
+ * Set the options of #SSynthSessionInit to their defaults.
+ *
+ * @param opts The options to set.
+ */
+S_API void s_synth_session_opts_init(s_synth_session_opts *opts);
+
+
+/**
+ * Initialize a synthesis session.
+ *
+ * @public @memberof SSynthSession
+ * @param self The synthesis session to initialize.
+ * @param voice The voice of the session.
+ * @param opts The options, @c NULL for the defaults.
+ * @param error Error code.
+ *
+ * @note If this function fails the session will be deleted and the
+ * @c self variable will be set to @c NULL.
+ *
+ * @note The chunk callback is called from the synthesis worker
+ * thread.
+ */
+S_API void SSynthSessionInit(SSynthSession **self, const SVoice *voice,
+							 const s_synth_session_opts *opts, s_erc *error);
+
+
+/**
+ * Feed a text fragment to the session. The complete utterances of the
+ * text received so far are submitted for synthesis.
+ *
+ * @public @memberof SSynthSession
+ * @param self The synthesis session.
+ * @param text The text fragment.
+ * @param error Error code.
+ *
+ * @note The synthesis errors of earlier utterances are reported by
+ * the next call to #SSynthSessionFeed or #SSynthSessionFinish.
+ */
+S_API void SSynthSessionFeed(SSynthSession *self, const char *text, s_erc *error);
+
+
+/**
+ * Finish the text of the session. The buffered text is synthesized,
+ * and the function returns once the audio of all the utterances has
+ * been written to the audio stream and the stream is flushed. The
+ * session can be fed again afterwards.
+ *
+ * @public @memberof SSynthSession
+ * @param self The synthesis session.
+ * @param error Error code.
+ */
+S_API void SSynthSessionFinish(SSynthSession *self, s_erc *error);
+
+
+/**
+ * Get the audio stream of the session.
+ *
+ * @public @memberof SSynthSession
+ * @param self The synthesis session.
+ * @param error Error code.
+ *
+ * @return The audio stream, its samples are only kept if the @c keep
+ * option is set.
+ *
+ * @note The stream is written to by the synthesis worker thread, the
+ * samples must only be read after #SSynthSessionFinish.
+ */
+S_API SAudioStream *SSynthSessionGetStream(const SSynthSession *self, s_erc *error);
+
+
+/**
+ * Add the SSynthSession class to the object system.
+ * @private
+ *
+ * @param error Error code.
+ */
+S_LOCAL void _s_synth_session_class_add(s_erc *error);
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* End external c declaration                                                       */
+/*                                                                                  */
+/************************************************************************************/
+S_END_C_DECLS
+
+
+/**
+ * @}
+ * end documentation
+ */
+
+#endif /* _SPCT_SYNTH_SESSION_H__ */
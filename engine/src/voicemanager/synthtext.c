@@ -0,0 +1,448 @@
+/************************************************************************************/
+/* Copyright (c) 2008-2011 The Department of Arts and Culture,                      */
+/* The Government of the Republic of South Africa.                                  */
+/*                                                                                  */
+/* Contributors:  Meraka Institute, CSIR, South Africa.                             */
+/*                                                                                  */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy     */
+/* of this software and associated documentation files (the "Software"), to deal    */
+/* in the Software without restriction, including without limitation the rights     */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        */
+/* copies of the Software, and to permit persons to whom the Software is            */
+/* furnished to do so, subject to the following conditions:                         */
+/* The above copyright notice and this permission notice shall be included in       */
+/* all copies or substantial portions of the Software.                              */
+/*                                                                                  */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN        */
+/* THE SOFTWARE.                                                                    */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* AUTHOR  : Speect contributors                                                    */
+/* DATE    : 19 October 2026                                                        */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* Long text synthesis.                                                             */
+/*                                                                                  */
+/*                                                                                  */
+/************************************************************************************/
+
+/************************************************************************************/
+/*                                                                                  */
+/* Modules used                                                                     */
+/*                                                                                  */
+/************************************************************************************/
+
+#include "hrg/processors/uttprocessor.h"
+#include "voicemanager/synthpool.h"
+#include "voicemanager/synthtext.h"
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static function prototypes                                                       */
+/*                                                                                  */
+/************************************************************************************/
+
+static SUtterance *new_text_utt(const SVoice *voice, const SObject *text,
+								s_erc *error);
+
+static void join_utt_audio(SAudioStream *audio, const SUtterance *utt,
+						   float pause, s_erc *error);
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Function implementations                                                         */
+/*                                                                                  */
+/************************************************************************************/
+
+S_API void s_synth_text_opts_init(s_synth_text_opts *opts)
+{
+	if (opts == NULL)
+		return;
+
+	opts->utt_type = "text";
+	opts->uttbreak = "UttBreak";
+	opts->num_workers = 4;
+	opts->pause = 0.0;
+	opts->chunk_size = 0;
+	opts->chunk_callback = NULL;
+	opts->userdata = NULL;
+	opts->keep = TRUE;
+}
+
+
+S_API SAudioStream *SVoiceSynthText(const SVoice *self, const char *text,
+									const s_synth_text_opts *opts, s_erc *error)
+{
+	s_synth_text_opts defaults;
+	SUtterance *breakUtt = NULL;
+	const SList *uttTexts;
+	SSynthPool *pool = NULL;
+	SSynthFuture **futures = NULL;
+	SAudioStream *audio = NULL;
+	SUtterance *utt;
+	size_t num_utts = 0;
+	size_t i;
+	s_erc local_err = S_SUCCESS;
+
+
+	S_CLR_ERR(error);
+
+	if (self == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SVoiceSynthText",
+				  "Argument \"self\" is NULL");
+		return NULL;
+	}
+
+	if (text == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SVoiceSynthText",
+				  "Argument \"text\" is NULL");
+		return NULL;
+	}
+
+	if (opts == NULL)
+	{
+		s_synth_text_opts_init(&defaults);
+		opts = &defaults;
+	}
+
+	audio = S_NEW(SAudioStream, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SVoiceSynthText",
+				  "Failed to create new 'SAudioStream' object"))
+		return NULL;
+
+	SAudioStreamInit(&audio, opts->chunk_size, opts->chunk_callback,
+					 opts->userdata, opts->keep, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SVoiceSynthText",
+				  "Call to \"SAudioStreamInit\" failed"))
+		return NULL;
+
+	/* run the utterance break processor once for the whole text */
+	breakUtt = _s_synth_text_break(self, text, opts->uttbreak, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SVoiceSynthText",
+				  "Call to \"_s_synth_text_break\" failed"))
+		goto quit;
+
+	uttTexts = S_LIST(SUtteranceGetFeature(breakUtt, "utterance-texts", error));
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SVoiceSynthText",
+				  "Call to \"SUtteranceGetFeature\" failed"))
+		goto quit;
+
+	num_utts = SListSize(uttTexts, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SVoiceSynthText",
+				  "Call to \"SListSize\" failed"))
+		goto quit;
+
+	if (num_utts == 0)
+		goto quit;
+
+	/* the queue holds all the utterances, submitting never blocks */
+	pool = S_NEW(SSynthPool, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SVoiceSynthText",
+				  "Failed to create new 'SSynthPool' object"))
+		goto quit;
+
+	SSynthPoolInit(&pool, self, opts->num_workers, (uint32)num_utts, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SVoiceSynthText",
+				  "Call to \"SSynthPoolInit\" failed"))
+		goto quit;
+
+	futures = S_CALLOC(SSynthFuture*, num_utts);
+	if (futures == NULL)
+	{
+		S_FTL_ERR(error, S_MEMERROR,
+				  "SVoiceSynthText",
+				  "Failed to allocate memory for 'SSynthFuture*' object");
+		goto quit;
+	}
+
+	for (i = 0; i < num_utts; i++)
+	{
+		utt = new_text_utt(self, SListNth(uttTexts, (uint32)i, error), error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "SVoiceSynthText",
+					  "Call to \"new_text_utt\" failed"))
+			goto quit;
+
+		futures[i] = SSynthPoolSubmitUtt(pool, opts->utt_type, utt, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "SVoiceSynthText",
+					  "Call to \"SSynthPoolSubmitUtt\" failed"))
+		{
+			S_DELETE(utt, "SVoiceSynthText", &local_err);
+			goto quit;
+		}
+	}
+
+	/* join the audio in text order, as soon as each utterance is done */
+	for (i = 0; i < num_utts; i++)
+	{
+		utt = SSynthFutureWait(futures[i], error);
+		S_DELETE(futures[i], "SVoiceSynthText", &local_err);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "SVoiceSynthText",
+					  "Synthesis of utterance %lu of the text failed",
+					  (unsigned long)i))
+			goto quit;
+
+		join_utt_audio(audio, utt, (i > 0) ? opts->pause : 0.0, error);
+		S_DELETE(utt, "SVoiceSynthText", &local_err);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "SVoiceSynthText",
+					  "Call to \"join_utt_audio\" failed"))
+			goto quit;
+	}
+
+	/* clean-up code */
+quit:
+	if (futures != NULL)
+	{
+		/* waits for the pending requests */
+		for (i = 0; i < num_utts; i++)
+			S_DELETE(futures[i], "SVoiceSynthText", &local_err);
+
+		S_FREE(futures);
+	}
+
+	S_DELETE(pool, "SVoiceSynthText", &local_err);
+	S_DELETE(breakUtt, "SVoiceSynthText", &local_err);
+
+	if (*error != S_SUCCESS)
+	{
+		S_DELETE(audio, "SVoiceSynthText", &local_err);
+		return NULL;
+	}
+
+	SAudioStreamFlush(audio, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SVoiceSynthText",
+				  "Call to \"SAudioStreamFlush\" failed"))
+	{
+		S_DELETE(audio, "SVoiceSynthText", &local_err);
+		return NULL;
+	}
+
+	return audio;
+}
+
+
+S_LOCAL SUtterance *_s_synth_text_break(const SVoice *voice, const char *text,
+										const char *uttbreak, s_erc *error)
+{
+	SUttProcessor *uttProc;
+	SUtterance *utt;
+	s_bool is_present;
+	s_erc local_err = S_SUCCESS;
+
+
+	S_CLR_ERR(error);
+
+	uttProc = _s_voice_acquire_utt_proc(voice, uttbreak, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "_s_synth_text_break",
+				  "Call to \"_s_voice_acquire_utt_proc\" failed"))
+		return NULL;
+
+	if (uttProc == NULL)
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "_s_synth_text_break",
+				  "Utterance processor \'%s\' not defined",
+				  uttbreak);
+		return NULL;
+	}
+
+	utt = S_NEW(SUtterance, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "_s_synth_text_break",
+				  "Failed to create new utterance"))
+	{
+		S_DELETE(uttProc, "_s_synth_text_break", &local_err);
+		return NULL;
+	}
+
+	SUtteranceInit(&utt, voice, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "_s_synth_text_break",
+				  "Failed to initialize new utterance"))
+		goto quit_error;
+
+	SUtteranceSetFeature(utt, "input", SObjectSetString(text, error), error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "_s_synth_text_break",
+				  "Failed to set utterance \'input\' feature"))
+		goto quit_error;
+
+	SUttProcessorRun(uttProc, utt, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "_s_synth_text_break",
+				  "Execution of utterance processor \'%s\' failed",
+				  uttbreak))
+		goto quit_error;
+
+	is_present = SUtteranceFeatureIsPresent(utt, "utterance-texts", error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "_s_synth_text_break",
+				  "Call to \"SUtteranceFeatureIsPresent\" failed"))
+		goto quit_error;
+
+	if (!is_present)
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "_s_synth_text_break",
+				  "Utterance processor \'%s\' did not set the \'utterance-texts\' feature",
+				  uttbreak);
+		goto quit_error;
+	}
+
+	S_DELETE(uttProc, "_s_synth_text_break", &local_err);
+	return utt;
+
+	/* error clean-up */
+quit_error:
+	S_DELETE(uttProc, "_s_synth_text_break", &local_err);
+	S_DELETE(utt, "_s_synth_text_break", &local_err);
+	return NULL;
+}
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static function implementations                                                  */
+/*                                                                                  */
+/************************************************************************************/
+
+/*
+ * A new utterance with the text as input, and an audio stream keeping
+ * the samples of the waveform generator.
+ */
+static SUtterance *new_text_utt(const SVoice *voice, const SObject *text,
+								s_erc *error)
+{
+	SUtterance *utt;
+	SAudioStream *stream;
+	const char *utt_text;
+	s_erc local_err = S_SUCCESS;
+
+
+	S_CLR_ERR(error);
+
+	utt_text = SObjectGetString(text, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "new_text_utt",
+				  "Call to \"SObjectGetString\" failed"))
+		return NULL;
+
+	utt = S_NEW(SUtterance, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "new_text_utt",
+				  "Failed to create new utterance"))
+		return NULL;
+
+	SUtteranceInit(&utt, voice, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "new_text_utt",
+				  "Failed to initialize new utterance"))
+		goto quit_error;
+
+	SUtteranceSetFeature(utt, "input", SObjectSetString(utt_text, error), error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "new_text_utt",
+				  "Failed to set utterance \'input\' feature"))
+		goto quit_error;
+
+	stream = S_NEW(SAudioStream, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "new_text_utt",
+				  "Failed to create new 'SAudioStream' object"))
+		goto quit_error;
+
+	SAudioStreamInit(&stream, 0, NULL, NULL, TRUE, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "new_text_utt",
+				  "Call to \"SAudioStreamInit\" failed"))
+		goto quit_error;
+
+	SUtteranceSetFeature(utt, "audio-stream", S_OBJECT(stream), error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "new_text_utt",
+				  "Failed to set utterance \'audio-stream\' feature"))
+	{
+		S_DELETE(stream, "new_text_utt", &local_err);
+		goto quit_error;
+	}
+
+	return utt;
+
+	/* error clean-up */
+quit_error:
+	S_DELETE(utt, "new_text_utt", &local_err);
+	return NULL;
+}
+
+
+static void join_utt_audio(SAudioStream *audio, const SUtterance *utt,
+						   float pause, s_erc *error)
+{
+	const SAudioStream *uttStream;
+	const float *samples;
+	uint32 num_samples;
+	uint32 sample_rate;
+
+
+	S_CLR_ERR(error);
+
+	uttStream = SAudioStreamGetFromUtt(utt, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "join_utt_audio",
+				  "Call to \"SAudioStreamGetFromUtt\" failed"))
+		return;
+
+	samples = SAudioStreamGetSamples(uttStream, &num_samples, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "join_utt_audio",
+				  "Call to \"SAudioStreamGetSamples\" failed"))
+		return;
+
+	if (num_samples == 0) /* no waveform generator */
+		return;
+
+	sample_rate = SAudioStreamGetSampleRate(uttStream, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "join_utt_audio",
+				  "Call to \"SAudioStreamGetSampleRate\" failed"))
+		return;
+
+	if ((pause > 0.0) && (audio->num_samples > 0))
+	{
+		SAudioStreamWriteSilence(audio, (uint32)(pause * sample_rate), error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "join_utt_audio",
+					  "Call to \"SAudioStreamWriteSilence\" failed"))
+			return;
+	}
+
+	SAudioStreamWrite(audio, samples, num_samples, sample_rate, error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "join_utt_audio",
+			  "Call to \"SAudioStreamWrite\" failed");
+}
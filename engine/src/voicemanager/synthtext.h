@@ -0,0 +1,207 @@
+/************************************************************************************/
+/* Copyright (c) 2008-2011 The Department of Arts and Culture,                      */
+/* The Government of the Republic of South Africa.                                  */
+/*                                                                                  */
+/* Contributors:  Meraka Institute, CSIR, South Africa.                             */
+/*                                                                                  */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy     */
+/* of this software and associated documentation files (the "Software"), to deal    */
+/* in the Software without restriction, including without limitation the rights     */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        */
+/* copies of the Software, and to permit persons to whom the Software is            */
+/* furnished to do so, subject to the following conditions:                         */
+/* The above copyright notice and this permission notice shall be included in       */
+/* all copies or substantial portions of the Software.                              */
+/*                                                                                  */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN        */
+/* THE SOFTWARE.                                                                    */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* AUTHOR  : Speect contributors                                                    */
+/* DATE    : 19 October 2026                                                        */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* Long text synthesis.                                                             */
+/*                                                                                  */
+/*                                                                                  */
+/************************************************************************************/
+
+#ifndef _SPCT_SYNTH_TEXT_H__
+#define _SPCT_SYNTH_TEXT_H__
+
+
+/**
+ * @file synthtext.h
+ * Long text synthesis.
+ */
+
+
+/**
+ * @ingroup SVoices
+ * @defgroup SSynthText Long Text Synthesis
+ * Synthesis of a text of many utterances. The text is broken into
+ * utterances once with an utterance break processor (the @c
+ * "utterance-texts" feature), the utterances are synthesized in
+ * parallel on a synthesis pool (@ref SSynthPool) and their audio is
+ * joined in text order, with optional pauses in between. The joined
+ * audio is delivered in chunks as soon as the utterances before it are
+ * done.
+ * @{
+ */
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Modules used                                                                     */
+/*                                                                                  */
+/************************************************************************************/
+
+#include "include/common.h"
+#include "base/utils/types.h"
+#include "base/errdbg/errdbg.h"
+#include "voicemanager/voice.h"
+#include "voicemanager/audiostream.h"
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Begin external c declaration                                                     */
+/*                                                                                  */
+/************************************************************************************/
+S_BEGIN_C_DECLS
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Data types                                                                       */
+/*                                                                                  */
+/************************************************************************************/
+
+/**
+ * Options of #SVoiceSynthText, see #s_synth_text_opts_init for the
+ * defaults.
+ */
+typedef struct
+{
+	/**
+	 * Utterance type of the utterances, default @c "text".
+	 */
+	const char          *utt_type;
+
+	/**
+	 * Key of the utterance break processor in the voice @c
+	 * uttProcessors container, default @c "UttBreak".
+	 */
+	const char          *uttbreak;
+
+	/**
+	 * Number of synthesis threads, default 4.
+	 */
+	uint32               num_workers;
+
+	/**
+	 * Pause between utterances in seconds, default 0.
+	 */
+	float                pause;
+
+	/**
+	 * Number of samples of the chunks delivered to the chunk
+	 * callback, default 0 (the audio of an utterance at a time).
+	 */
+	uint32               chunk_size;
+
+	/**
+	 * Chunk callback, default @c NULL.
+	 */
+	s_audio_chunk_cb_fp  chunk_callback;
+
+	/**
+	 * Chunk callback user data, default @c NULL.
+	 */
+	void                *userdata;
+
+	/**
+	 * Keep the joined audio in the returned stream, default #TRUE.
+	 */
+	s_bool               keep;
+} s_synth_text_opts;
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Function prototypes                                                              */
+/*                                                                                  */
+/************************************************************************************/
+
+/**
+ * Set the options of #SVoiceSynthText to their defaults.
+ *
+ * @param opts The options to set.
+ */
+S_API void s_synth_text_opts_init(s_synth_text_opts *opts);
+
+
+/**
+ * Synthesize a text of many utterances. The utterances are
+ * synthesized in parallel, their audio is written to the returned
+ * audio stream in text order.
+ *
+ * @public @memberof SVoice
+ * @param self The voice.
+ * @param text The text to synthesize.
+ * @param opts The options, @c NULL for the defaults.
+ * @param error Error code.
+ *
+ * @return The audio stream of the text. Its samples are only kept if
+ * the @c keep option is set.
+ *
+ * @note The caller is responsible for the memory of the returned
+ * audio stream.
+ *
+ * @note Waveform generation utterance processors must write to the
+ * audio stream of the utterance (see #SAudioStreamGetFromUtt) for
+ * their audio to be joined.
+ */
+S_API SAudioStream *SVoiceSynthText(const SVoice *self, const char *text,
+									const s_synth_text_opts *opts, s_erc *error);
+
+
+/**
+ * Run the utterance break processor on the text. Used by the text
+ * synthesizers (#SVoiceSynthText and #SSynthSession).
+ *
+ * @private
+ * @param voice The voice.
+ * @param text The text to break into utterances.
+ * @param uttbreak Key of the utterance break processor in the voice
+ * @c uttProcessors container.
+ * @param error Error code.
+ *
+ * @return A scratch utterance with the @c "utterance-texts" feature,
+ * a list of #SString utterance texts.
+ */
+S_LOCAL SUtterance *_s_synth_text_break(const SVoice *voice, const char *text,
+										const char *uttbreak, s_erc *error);
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* End external c declaration                                                       */
+/*                                                                                  */
+/************************************************************************************/
+S_END_C_DECLS
+
+
+/**
+ * @}
+ * end documentation
+ */
+
+#endif /* _SPCT_SYNTH_TEXT_H__ */
@@ -42,9 +42,18 @@
 
 #include "base/utils/path.h"
 #include "base/utils/alloc.h"
+#include "base/utils/stime.h"
+#include "base/utils/smath.h"
 #include "base/strings/strings.h"
+#include "base/strings/sprint.h"
+#include "base/threads/threads.h"
+#include "serialization/serialize.h"
+#include "main/trace.h"
+#include "serialization/json/json_parse_config.h"
+#include "pluginmanager/pluginmanager.h"
 #include "voicemanager/loaders/data_config.h"
 #include "voicemanager/manager.h"
+#include "voicemanager/image.h"
 #include "voicemanager/voice.h"
 
 
@@ -89,12 +98,140 @@
 	S_VOICE_CALL(SELF, FUNC) ? TRUE : FALSE
 
 
+/* buckets per octave of the utterance processor timing histograms */
+#define S_TIMING_BUCKETS_PER_OCTAVE 4
+
+/* number of buckets of the utterance processor timing histograms,
+ * bucket 0 is below 1 microsecond, the last bucket (16.8 seconds)
+ * is open ended.
+ */
+#define S_TIMING_BUCKETS (24 * S_TIMING_BUCKETS_PER_OCTAVE + 1)
+
+
 /************************************************************************************/
 /*                                                                                  */
 /* Voice data (opaque)                                                              */
 /*                                                                                  */
 /************************************************************************************/
 
+/**
+ * Type definition of a lazy data entry. Lazy data entries are
+ * defined in the voice data configuration with <tt>"load" :
+ * "lazy"</tt>, and are only loaded on the first request for them
+ * (#SVoiceGetData or #SVoicePrefetchData).
+ *
+ * An entry is loaded under its own load mutex and not the voice data
+ * mutex, so that loading one entry does not hold up the lookups of
+ * other data. The lookups that are loading an entry are counted in
+ * @c users, an entry that is removed from the voice in the meantime
+ * is freed by the last of them.
+ */
+typedef struct s_lazy_data s_lazy_data;
+
+struct s_lazy_data
+{
+	char          *name;    /*!< Data entry name.                    */
+	char          *format;  /*!< Data format.                        */
+	char          *plugin;  /*!< Data plug-in.                       */
+	char          *path;    /*!< Full path of data.                  */
+	const s_voice_image *image; /*!< Voice image of data, or @c NULL. */
+	const SObject *loaded;  /*!< Loaded data object, @c NULL if not, guarded by data mutex. */
+	uint32         users;   /*!< Lookups loading the entry, guarded by data mutex. */
+	s_bool         removed; /*!< Removed from the voice, guarded by data mutex. */
+	s_lazy_data   *next;    /*!< Next lazy data entry.               */
+	S_DECLARE_MUTEX(load_mutex); /*!< Loads the entry once.     */
+};
+
+
+/**
+ * Type definition of a retired data object. Data objects are retired
+ * when they are replaced by #SVoiceReloadData, and are only unloaded
+ * once all the syntheses that could be using them have finished.
+ * Replaced or deleted voice features and feature processors are
+ * retired in the same way, and deleted instead of unloaded.
+ */
+typedef struct s_retired_data s_retired_data;
+
+struct s_retired_data
+{
+	SObject        *object;       /*!< Retired data object.                  */
+	s_bool          voice_object; /*!< Feature or feature processor object.  */
+	s_retired_data *next;         /*!< Next retired data object.             */
+};
+
+
+/**
+ * Type definition of a data epoch. A synthesis enters the current
+ * epoch when it starts and leaves it when it finishes. Retiring a
+ * data object ends the current epoch, the data object can be unloaded
+ * when no syntheses are left in this or any older epoch.
+ */
+typedef struct s_data_epoch s_data_epoch;
+
+struct s_data_epoch
+{
+	uint32          readers;  /*!< Syntheses in this epoch.                */
+	s_retired_data *retired;  /*!< Data objects retired at end of epoch.   */
+	s_data_epoch   *next;     /*!< Next (newer) epoch.                     */
+};
+
+
+/**
+ * Type definition of the timing statistics of an utterance processor,
+ * aggregated over the syntheses made while timings were enabled (see
+ * #SVoiceTimingsEnable). The entries are kept until the voice is
+ * deleted, as compiled utterance types refer to them.
+ */
+typedef struct s_utt_proc_timing s_utt_proc_timing;
+
+struct s_utt_proc_timing
+{
+	char              *name;     /*!< Utterance processor name.            */
+	uint32             count;    /*!< Number of runs.                      */
+	double             wall;     /*!< Total wall time (seconds).           */
+	double             cpu;      /*!< Total CPU time (seconds).            */
+	ulong              allocs;   /*!< Total number of allocations.         */
+	ulong              bytes;    /*!< Total allocated bytes.               */
+	uint32             buckets[S_TIMING_BUCKETS]; /*!< Wall time histogram. */
+	s_utt_proc_timing *next;     /*!< Next entry.                          */
+};
+
+
+/**
+ * Type definition of the measurements of one utterance processor run.
+ */
+typedef struct
+{
+	double wall;    /* seconds */
+	double cpu;     /* seconds */
+	ulong  allocs;
+	ulong  bytes;
+} s_stage_timing;
+
+
+/**
+ * Type definition of a compiled utterance type. An utterance type is
+ * compiled into an execution plan, an array of the resolved utterance
+ * processors, the first time it is used (or when the voice is
+ * loaded). Plans are invalidated when the utterance processors or
+ * utterance types of the voice are changed, a plan that is still
+ * being run is freed by the last synthesis using it.
+ */
+typedef struct s_utt_plan s_utt_plan;
+
+struct s_utt_plan
+{
+	char                 *utt_type;   /*!< Utterance type key.                      */
+	uint32                num_procs;  /*!< Number of utterance processors.          */
+	const SUttProcessor **procs;      /*!< Processors, @c NULL if not defined.      */
+	char                **names;      /*!< Utterance processor names.               */
+	s_utt_proc_timing   **stats;      /*!< Timing statistics of the processors.     */
+	uint32                users;      /*!< Syntheses running the plan.              */
+	s_bool                stale;      /*!< Invalidated, free when no users are left. */
+	s_utt_plan           *next;       /*!< Next plan.                               */
+};
+
+
 /**
  * Type definition of the opaque voice data. It is just an SMap, but
  * we do not want anybody to have access to the normal SMap from the
@@ -102,7 +239,19 @@
  */
 struct s_voice_data
 {
-	SMap *dataObjects;
+	SMap        *dataObjects;
+	s_lazy_data *lazy;        /* lazy data entries, guarded by data_mutex. */
+	s_voice_image *image;     /* voice image the data is loaded from, or NULL. */
+	s_data_epoch *epochs;     /* oldest data epoch, guarded by data_mutex. */
+	s_data_epoch *epoch;      /* current data epoch, guarded by data_mutex. */
+	uint32        generation; /* data generation, guarded by data_mutex. */
+	SList        *plugins;    /* plug-ins of reloaded data objects. */
+	s_utt_plan   *plans;      /* compiled utterance types, guarded by voice_mutex. */
+	s_bool        timings;    /* utterance processor timings enabled. */
+	s_utt_proc_timing *timing_stats; /* guarded by timings_mutex. */
+	SSynthCache  *cache;      /* synthesis cache or NULL, guarded by voice_mutex. */
+	S_DECLARE_MUTEX(data_mutex);
+	S_DECLARE_MUTEX(timings_mutex);
 };
 
 
@@ -134,12 +283,104 @@ static SVoiceClass VoiceClass;  /* Voice class declaration. */
 
 static void unload_data_entry(SVoice *self, const char *data_name, s_erc *error);
 
+static void add_lazy_data_entry(SVoice *self, const char *data_name,
+								const s_data_info *data_info,
+								const char *path, s_erc *error);
+
+static s_lazy_data *find_lazy_data_entry(const SVoice *self, const char *data_name);
+
+static const SObject *load_lazy_data_entry(const SVoice *self, s_lazy_data *entry,
+										   s_erc *error);
+
+static void release_lazy_data_entry(const SVoice *self, s_lazy_data *entry);
+
+static void unload_lazy_data_entry(SVoice *self, const char *data_name, s_erc *error);
+
+static void free_lazy_data_entry(s_lazy_data *entry, s_erc *error);
+
+static const SObject *load_data_object(const s_voice_image *image, const char *data_name,
+									   const char *plugin, const char *path,
+									   const char *format, s_erc *error);
+
+static SObject *reload_data_object(SVoice *self, const char *data_name, s_erc *error);
+
+static void unload_data_object(SObject *dataObject, s_erc *error);
+
+static void retire_data_object(SVoice *self, SObject *dataObject, s_bool voice_object,
+							   s_erc *error);
+
+static SObject *unlink_voice_object(SMap *map, const char *key, s_erc *error);
+
+static s_data_epoch *data_epoch_enter(const SVoice *self);
+
+static void data_epoch_leave(const SVoice *self, s_data_epoch *epoch, s_erc *error);
+
+static s_retired_data *reclaim_retired_data(const SVoice *self);
+
+static void unload_retired_data(s_retired_data *retired, s_erc *error);
+
 static s_data_info *get_data_info(const SMap *map, s_erc *error);
 
 static void free_voice_info(s_voice_info *info);
 
 static void unload_voice_plugins(SList *plugins, s_erc *error);
 
+static s_utt_plan *compile_utt_plan(const SVoice *self, const char *utt_type,
+									s_erc *error);
+
+static const s_utt_plan *acquire_utt_plan(const SVoice *self, const char *utt_type,
+										  s_erc *error);
+
+static void release_utt_plan(const SVoice *self, const s_utt_plan *plan);
+
+static void run_utt_plan(const SVoice *self, const s_utt_plan *plan,
+						 SUtterance *utt, uint32 first, uint32 last,
+						 s_erc *error);
+
+static void invalidate_utt_plans(const SVoice *self);
+
+static void free_utt_plan(s_utt_plan *plan);
+
+static s_utt_proc_timing *get_timing_stats(const SVoice *self, const char *name,
+										   s_erc *error);
+
+static void run_utt_plan_timed(const SVoice *self, const s_utt_plan *plan,
+							   SUtterance *utt, const SCancelToken *cancel,
+							   uint32 first, uint32 last, s_erc *error);
+
+static void record_timings(const SVoice *self, const s_utt_plan *plan, uint32 first,
+						   const s_stage_timing *stages, uint32 num_stages);
+
+static void add_timings_feature(SUtterance *utt, const s_utt_plan *plan, uint32 first,
+								const s_stage_timing *stages, uint32 num_stages,
+								s_erc *error);
+
+static SMap *get_timing_stats_map(const s_utt_proc_timing *stats, s_erc *error);
+
+static uint32 timing_bucket(double wall);
+
+static double timing_percentile(const s_utt_proc_timing *stats, double p);
+
+static s_bool synth_cache_fetch(SSynthCache *cache, const SVoice *self,
+								const char *utt_type, SUtterance *utt,
+								char **key, uint32 *start, s_erc *error);
+
+static void synth_cache_store(SSynthCache *cache, const char *key,
+							  const SUtterance *utt, uint32 start, ulong clears,
+							  s_erc *error);
+
+static SUtterance *synth_cache_fetch_utt(SSynthCache *cache, const SVoice *self,
+										 const char *utt_type, SObject *input,
+										 const char *key, s_erc *error);
+
+static void synth_cache_store_utt(SSynthCache *cache, const char *key,
+								  const SUtterance *utt, ulong clears,
+								  s_erc *error);
+
+static void clear_synth_cache(const SVoice *self);
+
+static void release_synth_cache(SSynthCache *cache, s_erc *error);
+
 
 /************************************************************************************/
 /*                                                                                  */
@@ -152,8 +393,13 @@ static void unload_voice_plugins(SList *plugins, s_erc *error);
 S_API SUtterance *SVoiceSynthUtt(const SVoice *self, const char *utt_type,
 								 SObject *input, s_erc *error)
 {
-	SUtterance *utt;
+	SUtterance *utt = NULL;
 	s_bool key_present;
+	s_data_epoch *epoch;
+	SSynthCache *cache;
+	char *cache_key = NULL;
+	ulong cache_clears = 0;
+	s_erc local_err = S_SUCCESS;
 
 
 	S_CLR_ERR(error);
@@ -210,16 +456,80 @@ S_API SUtterance *SVoiceSynthUtt(const SVoice *self, const char *utt_type,
 		return NULL;
 	}
 
-	utt = S_VOICE_CALL(self, synth_utt)(self, utt_type, input, error);
+	/*
+	 * data retired by SVoiceReloadData is kept until we leave the
+	 * epoch. The voice mutex is not held while synthesizing, so that
+	 * threads sharing the voice (see SSynthPool) run concurrently.
+	 */
+	epoch = data_epoch_enter(self);
+
+	cache = self->data->cache;
+	if (cache != NULL)
+	{
+		SObjectIncRef(S_OBJECT(cache));
+		cache_clears = _s_synth_cache_clears(cache);
+	}
+	s_mutex_unlock((s_mutex*)&self->voice_mutex);
+
+	S_TRACE_BEGIN("synth", utt_type);
+
+	if (cache != NULL)
+	{
+		/* cache errors don't fail the synthesis, just log them */
+		cache_key = _s_synth_cache_input_key(self, utt_type, input, &local_err);
+		if (!S_CHK_ERR(&local_err, S_CONTERR,
+					   "SVoiceSynthUtt",
+					   "Call to \"_s_synth_cache_input_key\" failed")
+			&& (cache_key != NULL))
+		{
+			utt = synth_cache_fetch_utt(cache, self, utt_type, input,
+										cache_key, error);
+			if (S_CHK_ERR(error, S_CONTERR,
+						  "SVoiceSynthUtt",
+						  "Call to \"synth_cache_fetch_utt\" failed"))
+			{
+				S_FREE(cache_key);
+				S_DELETE(cache, "SVoiceSynthUtt", &local_err);
+				S_TRACE_END("synth", utt_type);
+				data_epoch_leave(self, epoch, &local_err);
+				return NULL;
+			}
+		}
+
+		S_CLR_ERR(&local_err);
+	}
+
+	if (utt == NULL)
+	{
+		utt = S_VOICE_CALL(self, synth_utt)(self, utt_type, input, error);
+
+		if ((cache_key != NULL) && (utt != NULL) && (*error == S_SUCCESS))
+		{
+			synth_cache_store_utt(cache, cache_key, utt, cache_clears, &local_err);
+			S_CHK_ERR(&local_err, S_CONTERR,
+					  "SVoiceSynthUtt",
+					  "Call to \"synth_cache_store_utt\" failed");
+			S_CLR_ERR(&local_err);
+		}
+	}
+
+	S_TRACE_END("synth", utt_type);
+
+	if (cache_key != NULL)
+		S_FREE(cache_key);
+
+	if (cache != NULL)
+		S_DELETE(cache, "SVoiceSynthUtt", &local_err);
+
+	data_epoch_leave(self, epoch, &local_err);
 	if (S_CHK_ERR(error, S_CONTERR,
 				  "SVoiceSynthUtt",
 				  "Call to class method \"synth_utt\" failed"))
-	{
-		s_mutex_unlock((s_mutex*)&self->voice_mutex);
 		return utt;
-	}
 
-	s_mutex_unlock((s_mutex*)&self->voice_mutex);
+	S_CHK_ERR(&local_err, S_CONTERR,
+			  "SVoiceSynthUtt",
+			  "Call to \"data_epoch_leave\" failed"); /* just log it */
 	return utt;
 }
 
@@ -228,6 +538,13 @@ S_API void SVoiceReSynthUtt(const SVoice *self, const char *utt_type,
 							SUtterance *utt, s_erc *error)
 {
 	s_bool key_present;
+	s_data_epoch *epoch;
+	SSynthCache *cache;
+	char *cache_key = NULL;
+	uint32 cache_start = 0;
+	s_bool cache_hit = FALSE;
+	ulong cache_clears = 0;
+	s_erc local_err = S_SUCCESS;
 
 
 	S_CLR_ERR(error);
@@ -284,148 +601,187 @@ S_API void SVoiceReSynthUtt(const SVoice *self, const char *utt_type,
 		return;
 	}
 
-	S_VOICE_CALL(self, re_synth_utt)(self, utt_type, utt, error);
-	if (S_CHK_ERR(error, S_CONTERR,
-				  "SVoiceReSynthUtt",
-				  "Call to class method \"re_synth_utt\" failed"))
+	/*
+	 * data retired by SVoiceReloadData is kept until we leave the
+	 * epoch. The voice mutex is not held while synthesizing, so that
+	 * threads sharing the voice (see SSynthPool) run concurrently.
+	 */
+	epoch = data_epoch_enter(self);
+
+	cache = self->data->cache;
+	if (cache != NULL)
 	{
-		s_mutex_unlock((s_mutex*)&self->voice_mutex);
-		return;
+		SObjectIncRef(S_OBJECT(cache));
+		cache_clears = _s_synth_cache_clears(cache);
 	}
-
 	s_mutex_unlock((s_mutex*)&self->voice_mutex);
-}
 
+	S_TRACE_BEGIN("synth", utt_type);
 
-/* info */
+	if (cache != NULL)
+	{
+		/* cache errors don't fail the synthesis, just log them */
+		cache_hit = synth_cache_fetch(cache, self, utt_type, utt,
+									  &cache_key, &cache_start, &local_err);
+		S_CHK_ERR(&local_err, S_CONTERR,
+				  "SVoiceReSynthUtt",
+				  "Call to \"synth_cache_fetch\" failed");
+		S_CLR_ERR(&local_err);
+	}
 
-S_API const char *SVoiceGetName(const SVoice *self, s_erc *error)
-{
-	S_CLR_ERR(error);
+	if (!cache_hit)
+		S_VOICE_CALL(self, re_synth_utt)(self, utt_type, utt, error);
 
-	if (self == NULL)
+	if ((cache_key != NULL) && (*error == S_SUCCESS))
 	{
-		S_CTX_ERR(error, S_ARGERROR,
-				  "SVoiceGetName",
-				  "Argument \"self\" is NULL");
-		return NULL;
+		synth_cache_store(cache, cache_key, utt, cache_start, cache_clears,
+						  &local_err);
+		S_CHK_ERR(&local_err, S_CONTERR,
+				  "SVoiceReSynthUtt",
+				  "Call to \"synth_cache_store\" failed");
+		S_CLR_ERR(&local_err);
 	}
 
-	return self->info? self->info->name : NULL;
-}
+	S_TRACE_END("synth", utt_type);
 
+	if (cache_key != NULL)
+		S_FREE(cache_key);
 
-S_API const char *SVoiceGetDescription(const SVoice *self, s_erc *error)
-{
-	S_CLR_ERR(error);
+	if (cache != NULL)
+		S_DELETE(cache, "SVoiceReSynthUtt", &local_err);
 
-	if (self == NULL)
-	{
-		S_CTX_ERR(error, S_ARGERROR,
-				  "SVoiceGetDescription",
-				  "Argument \"self\" is NULL");
-		return NULL;
-	}
+	data_epoch_leave(self, epoch, &local_err);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SVoiceReSynthUtt",
+				  "Call to class method \"re_synth_utt\" failed"))
+		return;
 
-	return self->info? self->info->description : NULL;
+	S_CHK_ERR(&local_err, S_CONTERR,
+			  "SVoiceReSynthUtt",
+			  "Call to \"data_epoch_leave\" failed"); /* just log it */
 }
 
 
-S_API const char *SVoiceGetGender(const SVoice *self, s_erc *error)
+S_API SUtterance *SVoiceSynthUttStream(const SVoice *self, const char *utt_type,
+									   SObject *input, SAudioStream *stream,
+									   s_erc *error)
 {
+	SUtterance *utt;
+	s_erc local_err = S_SUCCESS;
+
+
 	S_CLR_ERR(error);
 
 	if (self == NULL)
 	{
 		S_CTX_ERR(error, S_ARGERROR,
-				  "SVoiceGetGender",
+				  "SVoiceSynthUttStream",
 				  "Argument \"self\" is NULL");
 		return NULL;
 	}
 
-	return self->info? self->info->gender : NULL;
-}
-
-
-S_API const char *SVoiceGetLanguage(const SVoice *self, s_erc *error)
-{
-	S_CLR_ERR(error);
-
-	if (self == NULL)
+	if (utt_type == NULL)
 	{
 		S_CTX_ERR(error, S_ARGERROR,
-				  "SVoiceGetLanguage",
-				  "Argument \"self\" is NULL");
+				  "SVoiceSynthUttStream",
+				  "Argument \"utt_type\" is NULL");
 		return NULL;
 	}
 
-	return self->info? self->info->language : NULL;
-}
-
-
-S_API const char *SVoiceGetLangCode(const SVoice *self, s_erc *error)
-{
-	S_CLR_ERR(error);
-
-	if (self == NULL)
+	if (input == NULL)
 	{
 		S_CTX_ERR(error, S_ARGERROR,
-				  "SVoiceGetLangCode",
-				  "Argument \"self\" is NULL");
+				  "SVoiceSynthUttStream",
+				  "Argument \"input\" is NULL");
 		return NULL;
 	}
 
-	return self->info? self->info->lang_code : NULL;
-}
-
-
-S_API const s_version *SVoiceGetVersion(const SVoice *self, s_erc *error)
-{
-	S_CLR_ERR(error);
-
-	if (self == NULL)
+	if (stream == NULL)
 	{
 		S_CTX_ERR(error, S_ARGERROR,
-				  "SVoiceGetVersion",
-				  "Argument \"self\" is NULL");
+				  "SVoiceSynthUttStream",
+				  "Argument \"stream\" is NULL");
 		return NULL;
 	}
 
-	return self->info? &(self->info->version) : NULL;
-}
+	utt = S_NEW(SUtterance, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SVoiceSynthUttStream",
+				  "Failed to create new utterance"))
+	{
+		S_DELETE(input, "SVoiceSynthUttStream", &local_err);
+		return NULL;
+	}
 
+	SUtteranceInit(&utt, self, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SVoiceSynthUttStream",
+				  "Failed to initialize new utterance"))
+	{
+		S_DELETE(input, "SVoiceSynthUttStream", &local_err);
+		return NULL;
+	}
 
-/* data */
+	SUtteranceSetFeature(utt, "input", input, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SVoiceSynthUttStream",
+				  "Failed to set utterance \'input\' feature"))
+	{
+		S_DELETE(input, "SVoiceSynthUttStream", &local_err);
+		S_DELETE(utt, "SVoiceSynthUttStream", &local_err);
+		return NULL;
+	}
 
-S_API SList *SVoiceGetDataKeys(const SVoice *self, s_erc *error)
-{
-	SList *tmp;
+	/*
+	 * the caller keeps the stream, hold a reference while it is a
+	 * feature of the utterance
+	 */
+	SObjectIncRef(S_OBJECT(stream));
+	SUtteranceSetFeature(utt, "audio-stream", S_OBJECT(stream), error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SVoiceSynthUttStream",
+				  "Failed to set utterance \'audio-stream\' feature"))
+		goto quit_error;
 
+	SVoiceReSynthUtt(self, utt_type, utt, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SVoiceSynthUttStream",
+				  "Call to \"SVoiceReSynthUtt\" failed"))
+		goto quit_error;
 
-	S_CLR_ERR(error);
+	SUtteranceDelFeature(utt, "audio-stream", error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SVoiceSynthUttStream",
+				  "Call to \"SUtteranceDelFeature\" failed"))
+		goto quit_error;
 
-	if (self == NULL)
+	SObjectDecRef(S_OBJECT(stream));
+
+	SAudioStreamFlush(stream, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SVoiceSynthUttStream",
+				  "Call to \"SAudioStreamFlush\" failed"))
 	{
-		S_CTX_ERR(error, S_ARGERROR,
-				  "SVoiceGetDataKeys",
-				  "Argument \"self\" is NULL");
+		S_DELETE(utt, "SVoiceSynthUttStream", &local_err);
 		return NULL;
 	}
 
-	tmp = SMapGetKeys(self->data->dataObjects, error);
-	if (S_CHK_ERR(error, S_CONTERR,
-				  "SVoiceGetDataKeys",
-				  "Call to \"SMapGetKeys\" failed"))
-		return NULL;
+	return utt;
 
-	return tmp;
+	/* error clean-up */
+quit_error:
+	S_DELETE(utt, "SVoiceSynthUttStream", &local_err);
+	SObjectDecRef(S_OBJECT(stream));
+	return NULL;
 }
 
 
-S_API s_bool SVoiceDataIsPresent(const SVoice *self, const char *name,
-								 s_erc *error)
+S_API SUtterance *SVoiceSynthUttCancellable(const SVoice *self, const char *utt_type,
+											SObject *input, SCancelToken *cancel,
+											s_erc *error)
 {
-	s_bool key_present;
+	SUtterance *utt;
+	s_erc local_err = S_SUCCESS;
 
 
 	S_CLR_ERR(error);
@@ -433,68 +789,101 @@ S_API s_bool SVoiceDataIsPresent(const SVoice *self, const char *name,
 	if (self == NULL)
 	{
 		S_CTX_ERR(error, S_ARGERROR,
-				  "SVoiceDataIsPresent",
+				  "SVoiceSynthUttCancellable",
 				  "Argument \"self\" is NULL");
-		return FALSE;
+		return NULL;
 	}
 
-	if (name == NULL)
+	if (utt_type == NULL)
 	{
 		S_CTX_ERR(error, S_ARGERROR,
-				  "SVoiceDataIsPresent",
-				  "Argument \"name\" is NULL");
-		return FALSE;
+				  "SVoiceSynthUttCancellable",
+				  "Argument \"utt_type\" is NULL");
+		return NULL;
 	}
 
-	key_present = SMapObjectPresent(self->data->dataObjects, name, error);
-	if (S_CHK_ERR(error, S_CONTERR,
-				  "SVoiceDataIsPresent",
-				  "Call to \"SMapObjectPresent\" failed"))
-		return FALSE;
-
-	return key_present;
-}
-
-
-S_API const SObject *SVoiceGetData(const SVoice *self, const char *key, s_erc *error)
-{
-	const SObject *tmp;
-
-
-	S_CLR_ERR(error);
-
-	if (self == NULL)
+	if (input == NULL)
 	{
 		S_CTX_ERR(error, S_ARGERROR,
-				  "SVoiceGetData",
-				  "Argument \"self\" is NULL");
+				  "SVoiceSynthUttCancellable",
+				  "Argument \"input\" is NULL");
 		return NULL;
 	}
 
-	if (key == NULL)
+	if (cancel == NULL)
 	{
 		S_CTX_ERR(error, S_ARGERROR,
-				  "SVoiceGetData",
-				  "Argument \"key\" is NULL");
+				  "SVoiceSynthUttCancellable",
+				  "Argument \"cancel\" is NULL");
 		return NULL;
 	}
 
-	tmp = SMapGetObjectDef(self->data->dataObjects, key, NULL, error);
+	utt = S_NEW(SUtterance, error);
 	if (S_CHK_ERR(error, S_CONTERR,
-				  "SVoiceGetData",
-				  "Call to \"SMapGetObjectDef\" failed"))
+				  "SVoiceSynthUttCancellable",
+				  "Failed to create new utterance"))
+	{
+		S_DELETE(input, "SVoiceSynthUttCancellable", &local_err);
 		return NULL;
+	}
 
-	return tmp;
+	SUtteranceInit(&utt, self, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SVoiceSynthUttCancellable",
+				  "Failed to initialize new utterance"))
+	{
+		S_DELETE(input, "SVoiceSynthUttCancellable", &local_err);
+		return NULL;
+	}
+
+	SUtteranceSetFeature(utt, "input", input, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SVoiceSynthUttCancellable",
+				  "Failed to set utterance \'input\' feature"))
+	{
+		S_DELETE(input, "SVoiceSynthUttCancellable", &local_err);
+		S_DELETE(utt, "SVoiceSynthUttCancellable", &local_err);
+		return NULL;
+	}
+
+	/*
+	 * the caller keeps the token, to cancel it from another thread,
+	 * hold a reference while it is a feature of the utterance
+	 */
+	SObjectIncRef(S_OBJECT(cancel));
+	SUtteranceSetFeature(utt, "cancel-token", S_OBJECT(cancel), error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SVoiceSynthUttCancellable",
+				  "Failed to set utterance \'cancel-token\' feature"))
+		goto quit_error;
+
+	SVoiceReSynthUtt(self, utt_type, utt, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SVoiceSynthUttCancellable",
+				  "Call to \"SVoiceReSynthUtt\" failed"))
+		goto quit_error;
+
+	SUtteranceDelFeature(utt, "cancel-token", error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SVoiceSynthUttCancellable",
+				  "Call to \"SUtteranceDelFeature\" failed"))
+		goto quit_error;
+
+	SObjectDecRef(S_OBJECT(cancel));
+	return utt;
+
+	/* error clean-up */
+quit_error:
+	S_DELETE(utt, "SVoiceSynthUttCancellable", &local_err);
+	SObjectDecRef(S_OBJECT(cancel));
+	return NULL;
 }
 
 
-S_API void SVoiceSetData(SVoice *self, const char *key,
-						 SObject *object,  s_erc *error)
+S_API void SVoiceSynthUttRefill(const SVoice *self, const char *utt_type,
+								SObject *input, SUtterance *utt, s_erc *error)
 {
-	s_bool key_present;
-	s_bool vm_loaded_data;
-
+	s_erc local_err = S_SUCCESS;
 
 
 	S_CLR_ERR(error);
@@ -502,164 +891,117 @@ S_API void SVoiceSetData(SVoice *self, const char *key,
 	if (self == NULL)
 	{
 		S_CTX_ERR(error, S_ARGERROR,
-				  "SVoiceSetData",
+				  "SVoiceSynthUttRefill",
 				  "Argument \"self\" is NULL");
 		return;
 	}
 
-	if (key == NULL)
+	if (utt_type == NULL)
 	{
 		S_CTX_ERR(error, S_ARGERROR,
-				  "SVoiceSetData",
-				  "Argument \"key\" is NULL");
+				  "SVoiceSynthUttRefill",
+				  "Argument \"utt_type\" is NULL");
 		return;
 	}
 
-	if (object == NULL)
+	if (input == NULL)
 	{
 		S_CTX_ERR(error, S_ARGERROR,
-				  "SVoiceSetData",
-				  "Argument \"object\" is NULL");
+				  "SVoiceSynthUttRefill",
+				  "Argument \"input\" is NULL");
 		return;
 	}
 
-	s_mutex_lock(&self->voice_mutex);
-
-	/* check if the data is in the data objects map */
-	key_present = SMapObjectPresent(self->data->dataObjects, key, error);
-	if (S_CHK_ERR(error, S_CONTERR,
-				  "SVoiceSetData",
-				  "Call to \"SMapObjectPresent\" failed"))
+	if (utt == NULL)
 	{
-		s_mutex_unlock(&self->voice_mutex);
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SVoiceSynthUttRefill",
+				  "Argument \"utt\" is NULL");
+		S_DELETE(input, "SVoiceSynthUttRefill", &local_err);
 		return;
 	}
 
-	if (key_present)
+	/* keeps the utterance's containers and items for reuse */
+	SUtteranceReset(utt, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SVoiceSynthUttRefill",
+				  "Call to \"SUtteranceReset\" failed"))
 	{
-		/* delete the data and config key */
-		unload_data_entry(self, key, error);
-		if (S_CHK_ERR(error, S_CONTERR,
-					  "SVoiceSetData",
-					  "Call to \"unload_data_entry\" failed"))
-		{
-			s_mutex_unlock(&self->voice_mutex);
-			return;
-		}
+		S_DELETE(input, "SVoiceSynthUttRefill", &local_err);
+		return;
 	}
 
-	vm_loaded_data = _s_vm_data_loaded_inc_ref(object, error);
+	SUtteranceInit(&utt, self, error);
 	if (S_CHK_ERR(error, S_CONTERR,
-				  "SVoiceSetData",
-				  "Call to \"_s_vm_data_loaded_inc_ref\" failed"))
+				  "SVoiceSynthUttRefill",
+				  "Failed to initialize utterance"))
 	{
-		s_mutex_unlock(&self->voice_mutex);
+		S_DELETE(input, "SVoiceSynthUttRefill", &local_err);
 		return;
 	}
 
-	if (vm_loaded_data)
+	SUtteranceSetFeature(utt, "input", input, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SVoiceSynthUttRefill",
+				  "Failed to set utterance \'input\' feature"))
 	{
-		/* it was loaded previously by vm, just incremented reference
-		 * in _s_vm_data_loaded_inc_ref. Set it in data objects and
-		 * return.
-		 */
-		SMapSetObject(self->data->dataObjects, key, object, error);
-		S_CHK_ERR(error, S_CONTERR,
-				  "SVoiceSetData",
-				  "Call to \"SMapSetObject\" for data '%s' in data config failed",
-				  key); /* data is probably corrupted */
-		s_mutex_unlock(&self->voice_mutex);
+		S_DELETE(input, "SVoiceSynthUttRefill", &local_err);
 		return;
 	}
 
-	/* not previously loaded in voice manager */
-	SMapSetObject(self->data->dataObjects, key, object, error);
+	SVoiceReSynthUtt(self, utt_type, utt, error);
 	S_CHK_ERR(error, S_CONTERR,
-			  "SVoiceSetData",
-			  "Call to \"SMapSetObject\" failed");
-
-	s_mutex_unlock(&self->voice_mutex);
+			  "SVoiceSynthUttRefill",
+			  "Call to \"SVoiceReSynthUtt\" failed");
 }
 
 
-S_API void SVoiceDelData(SVoice *self, const char *key, s_erc *error)
-{
-	s_bool key_present;
-
+/* timings */
 
+S_API void SVoiceTimingsEnable(SVoice *self, s_bool enable, s_erc *error)
+{
 	S_CLR_ERR(error);
 
 	if (self == NULL)
 	{
 		S_CTX_ERR(error, S_ARGERROR,
-				  "SVoiceDelData",
+				  "SVoiceTimingsEnable",
 				  "Argument \"self\" is NULL");
 		return;
 	}
 
-	if (key == NULL)
-	{
-		S_CTX_ERR(error, S_ARGERROR,
-				  "SVoiceDelData",
-				  "Argument \"key\" is NULL");
-		return;
-	}
-
-	/* check if the data is in the configuration */
 	s_mutex_lock(&self->voice_mutex);
-	key_present = SMapObjectPresent(self->data->dataObjects, key, error);
-	if (S_CHK_ERR(error, S_CONTERR,
-				  "SVoiceDelData",
-				  "Call to \"SMapObjectPresent\" failed"))
-	{
-		s_mutex_unlock(&self->voice_mutex);
-		return;
-	}
-
-	if (key_present)
+	if (self->data->timings != enable)
 	{
-		/* delete the data and config key */
-		unload_data_entry(self, key, error);
-		S_CHK_ERR(error, S_CONTERR,
-				  "SVoiceDelData",
-				  "Call to \"unload_data_entry\" failed");
+		/* allocations are counted while any voice has timings enabled */
+		_s_alloc_count_hold(enable);
+		self->data->timings = enable;
 	}
-
 	s_mutex_unlock(&self->voice_mutex);
 }
 
 
-/* features */
-
-S_API SList *SVoiceGetFeatureKeys(const SVoice *self, s_erc *error)
+S_API s_bool SVoiceTimingsEnabled(const SVoice *self, s_erc *error)
 {
-	SList *tmp;
-
-
 	S_CLR_ERR(error);
 
 	if (self == NULL)
 	{
 		S_CTX_ERR(error, S_ARGERROR,
-				  "SVoiceGetFeatureKeys",
+				  "SVoiceTimingsEnabled",
 				  "Argument \"self\" is NULL");
-		return NULL;
+		return FALSE;
 	}
 
-	tmp = SMapGetKeys(self->features, error);
-	if (S_CHK_ERR(error, S_CONTERR,
-				  "SVoiceGetFeatureKeys",
-				  "Call to \"SMapGetKeys\" failed"))
-		return NULL;
-
-	return tmp;
+	return self->data->timings;
 }
 
 
-S_API s_bool SVoiceFeatureIsPresent(const SVoice *self, const char *name,
-								 s_erc *error)
+S_API SMap *SVoiceGetTimings(const SVoice *self, s_erc *error)
 {
-	s_bool key_present;
+	SMap *timings;
+	SMap *procTimings;
+	const s_utt_proc_timing *stats;
 
 
 	S_CLR_ERR(error);
@@ -667,32 +1009,54 @@ S_API s_bool SVoiceFeatureIsPresent(const SVoice *self, const char *name,
 	if (self == NULL)
 	{
 		S_CTX_ERR(error, S_ARGERROR,
-				  "SVoiceFeatureIsPresent",
+				  "SVoiceGetTimings",
 				  "Argument \"self\" is NULL");
-		return FALSE;
+		return NULL;
 	}
 
-	if (name == NULL)
+	timings = S_MAP(S_NEW(SMapList, error));
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SVoiceGetTimings",
+				  "Failed to create new map"))
+		return NULL;
+
+	s_mutex_lock((s_mutex*)&self->data->timings_mutex);
+	for (stats = self->data->timing_stats; stats != NULL; stats = stats->next)
 	{
-		S_CTX_ERR(error, S_ARGERROR,
-				  "SVoiceFeatureIsPresent",
-				  "Argument \"name\" is NULL");
-		return FALSE;
+		if (stats->count == 0)
+			continue;
+
+		procTimings = get_timing_stats_map(stats, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "SVoiceGetTimings",
+					  "Call to \"get_timing_stats_map\" failed"))
+			break;
+
+		SMapSetObject(timings, stats->name, S_OBJECT(procTimings), error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "SVoiceGetTimings",
+					  "Call to \"SMapSetObject\" failed"))
+		{
+			S_DELETE(procTimings, "SVoiceGetTimings", error);
+			break;
+		}
 	}
+	s_mutex_unlock((s_mutex*)&self->data->timings_mutex);
 
-	key_present = SMapObjectPresent(self->features, name, error);
-	if (S_CHK_ERR(error, S_CONTERR,
-				  "SVoiceFeatureIsPresent",
-				  "Call to \"SMapObjectPresent\" failed"))
-		return FALSE;
+	if (*error != S_SUCCESS)
+	{
+		S_DELETE(timings, "SVoiceGetTimings", error);
+		return NULL;
+	}
 
-	return key_present;
+	return timings;
 }
 
 
-S_API const SObject *SVoiceGetFeature(const SVoice *self, const char *key, s_erc *error)
+S_API void SVoiceResetTimings(SVoice *self, s_erc *error)
 {
-	const SObject *tmp;
+	s_utt_proc_timing *stats;
+	uint32 i;
 
 
 	S_CLR_ERR(error);
@@ -700,152 +1064,165 @@ S_API const SObject *SVoiceGetFeature(const SVoice *self, const char *key, s_erc
 	if (self == NULL)
 	{
 		S_CTX_ERR(error, S_ARGERROR,
-				  "SVoiceGetFeature",
+				  "SVoiceResetTimings",
 				  "Argument \"self\" is NULL");
-		return NULL;
+		return;
 	}
 
-	if (key == NULL)
+	/* the entries themselves are referred to by the compiled utterance types */
+	s_mutex_lock(&self->data->timings_mutex);
+	for (stats = self->data->timing_stats; stats != NULL; stats = stats->next)
 	{
-		S_CTX_ERR(error, S_ARGERROR,
-				  "SVoiceGetFeature",
-				  "Argument \"key\" is NULL");
-		return NULL;
+		stats->count = 0;
+		stats->wall = 0.0;
+		stats->cpu = 0.0;
+		stats->allocs = 0;
+		stats->bytes = 0;
+
+		for (i = 0; i < S_TIMING_BUCKETS; i++)
+			stats->buckets[i] = 0;
 	}
-
-	tmp = SMapGetObjectDef(self->features, key, NULL, error);
-	if (S_CHK_ERR(error, S_CONTERR,
-				  "SVoiceGetFeature",
-				  "Call to \"SMapGetObjectDef\" failed"))
-		return NULL;
-
-	return tmp;
+	s_mutex_unlock(&self->data->timings_mutex);
 }
 
 
-S_API void SVoiceSetFeature(SVoice *self, const char *key,
-							SObject *object,  s_erc *error)
+/* cache */
+
+S_API void SVoiceSetSynthCache(SVoice *self, SSynthCache *cache, s_erc *error)
 {
+	SSynthCache *oldCache;
+
+
 	S_CLR_ERR(error);
 
 	if (self == NULL)
 	{
 		S_CTX_ERR(error, S_ARGERROR,
-				  "SVoiceSetFeature",
+				  "SVoiceSetSynthCache",
 				  "Argument \"self\" is NULL");
 		return;
 	}
 
-	if (key == NULL)
-	{
-		S_CTX_ERR(error, S_ARGERROR,
-				  "SVoiceSetFeature",
-				  "Argument \"key\" is NULL");
-		return;
-	}
-
-	if (object == NULL)
-	{
-		S_CTX_ERR(error, S_ARGERROR,
-				  "SVoiceSetFeature",
-				  "Argument \"object\" is NULL");
-		return;
-	}
+	if (cache != NULL)
+		SObjectIncRef(S_OBJECT(cache));
 
-	s_mutex_lock((s_mutex*)&(self->voice_mutex));
-	SMapSetObject(self->features, key, object, error);
-	s_mutex_unlock((s_mutex*)&(self->voice_mutex));
+	s_mutex_lock(&self->voice_mutex);
+	oldCache = self->data->cache;
+	self->data->cache = cache;
+	s_mutex_unlock(&self->voice_mutex);
 
+	/* syntheses in flight hold their own reference */
+	release_synth_cache(oldCache, error);
 	S_CHK_ERR(error, S_CONTERR,
-			  "SVoiceSetFeature",
-			  "Call to \"SMapSetObject\" failed");
+			  "SVoiceSetSynthCache",
+			  "Call to \"release_synth_cache\" failed");
 }
 
 
-S_LOCAL void _SVoiceSetFeature_no_lock(SVoice *self, const char *key,
-									   SObject *object,  s_erc *error)
+/* info */
+
+S_API const char *SVoiceGetName(const SVoice *self, s_erc *error)
 {
 	S_CLR_ERR(error);
 
 	if (self == NULL)
 	{
 		S_CTX_ERR(error, S_ARGERROR,
-				  "_SVoiceSetFeature_no_lock",
+				  "SVoiceGetName",
 				  "Argument \"self\" is NULL");
-		return;
+		return NULL;
 	}
 
-	if (key == NULL)
-	{
-		S_CTX_ERR(error, S_ARGERROR,
-				  "_SVoiceSetFeature_no_lock",
-				  "Argument \"key\" is NULL");
-		return;
-	}
+	return self->info? self->info->name : NULL;
+}
 
-	if (object == NULL)
+
+S_API const char *SVoiceGetDescription(const SVoice *self, s_erc *error)
+{
+	S_CLR_ERR(error);
+
+	if (self == NULL)
 	{
 		S_CTX_ERR(error, S_ARGERROR,
-				  "_SVoiceSetFeature_no_lock",
-				  "Argument \"object\" is NULL");
-		return;
+				  "SVoiceGetDescription",
+				  "Argument \"self\" is NULL");
+		return NULL;
 	}
 
-	SMapSetObject(self->features, key, object, error);
-	S_CHK_ERR(error, S_CONTERR,
-			  "_SVoiceSetFeature_no_lock",
-			  "Call to \"SMapSetObject\" failed");
+	return self->info? self->info->description : NULL;
 }
 
 
-S_API void SVoiceDelFeature(SVoice *self, const char *key, s_erc *error)
+S_API const char *SVoiceGetGender(const SVoice *self, s_erc *error)
 {
-	s_bool key_present;
+	S_CLR_ERR(error);
+
+	if (self == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SVoiceGetGender",
+				  "Argument \"self\" is NULL");
+		return NULL;
+	}
+
+	return self->info? self->info->gender : NULL;
+}
 
 
+S_API const char *SVoiceGetLanguage(const SVoice *self, s_erc *error)
+{
 	S_CLR_ERR(error);
 
 	if (self == NULL)
 	{
 		S_CTX_ERR(error, S_ARGERROR,
-				  "SVoiceDelFeature",
+				  "SVoiceGetLanguage",
 				  "Argument \"self\" is NULL");
-		return;
+		return NULL;
 	}
 
-	if (key == NULL)
+	return self->info? self->info->language : NULL;
+}
+
+
+S_API const char *SVoiceGetLangCode(const SVoice *self, s_erc *error)
+{
+	S_CLR_ERR(error);
+
+	if (self == NULL)
 	{
 		S_CTX_ERR(error, S_ARGERROR,
-				  "SVoiceDelFeature",
-				  "Argument \"key\" is NULL");
-		return;
+				  "SVoiceGetLangCode",
+				  "Argument \"self\" is NULL");
+		return NULL;
 	}
 
-	s_mutex_lock((s_mutex*)&self->voice_mutex);
-	key_present = SMapObjectPresent(self->features, key, error);
-	if (S_CHK_ERR(error, S_CONTERR,
-				  "SVoiceDelFeature",
-				  "Call to \"SMapObjectPresent\" failed"))
+	return self->info? self->info->lang_code : NULL;
+}
+
+
+S_API const s_version *SVoiceGetVersion(const SVoice *self, s_erc *error)
+{
+	S_CLR_ERR(error);
+
+	if (self == NULL)
 	{
-		s_mutex_unlock((s_mutex*)&self->voice_mutex);
-		return;
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SVoiceGetVersion",
+				  "Argument \"self\" is NULL");
+		return NULL;
 	}
 
-	if (key_present)
-		SMapObjectDelete(self->features, key, error);
-
-	s_mutex_unlock((s_mutex*)&self->voice_mutex);
-	S_CHK_ERR(error, S_CONTERR,
-			  "SVoiceDelFeature",
-			  "Call to \"SMapObjectDelete\" failed");
+	return self->info? &(self->info->version) : NULL;
 }
 
 
-/* feature processors */
+/* data */
 
-S_API SList *SVoiceGetFeatProcKeys(const SVoice *self, s_erc *error)
+S_API SList *SVoiceGetDataKeys(const SVoice *self, s_erc *error)
 {
 	SList *tmp;
+	s_lazy_data *entry;
 
 
 	S_CLR_ERR(error);
@@ -853,23 +1230,51 @@ S_API SList *SVoiceGetFeatProcKeys(const SVoice *self, s_erc *error)
 	if (self == NULL)
 	{
 		S_CTX_ERR(error, S_ARGERROR,
-				  "SVoiceGetFeatProcKeys",
+				  "SVoiceGetDataKeys",
 				  "Argument \"self\" is NULL");
 		return NULL;
 	}
 
-	tmp = SMapGetKeys(self->featProcessors, error);
+	tmp = SMapGetKeys(self->data->dataObjects, error);
 	if (S_CHK_ERR(error, S_CONTERR,
-				  "SVoiceGetFeatProcKeys",
+				  "SVoiceGetDataKeys",
 				  "Call to \"SMapGetKeys\" failed"))
 		return NULL;
 
+	/* add the keys of the lazy data entries, loaded or not */
+	s_mutex_lock((s_mutex*)&self->data->data_mutex);
+	for (entry = self->data->lazy; entry != NULL; entry = entry->next)
+	{
+		if (tmp == NULL)
+		{
+			tmp = S_LIST(S_NEW(SListList, error));
+			if (S_CHK_ERR(error, S_CONTERR,
+						  "SVoiceGetDataKeys",
+						  "Failed to create new list for data keys"))
+			{
+				s_mutex_unlock((s_mutex*)&self->data->data_mutex);
+				return NULL;
+			}
+		}
+
+		SListAppend(tmp, SObjectSetString(entry->name, error), error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "SVoiceGetDataKeys",
+					  "Call to \"SListAppend/SObjectSetString\" failed"))
+		{
+			s_mutex_unlock((s_mutex*)&self->data->data_mutex);
+			S_DELETE(tmp, "SVoiceGetDataKeys", error);
+			return NULL;
+		}
+	}
+	s_mutex_unlock((s_mutex*)&self->data->data_mutex);
+
 	return tmp;
 }
 
 
-S_API s_bool SVoiceFeatProcIsPresent(const SVoice *self, const char *name,
-									s_erc *error)
+S_API s_bool SVoiceDataIsPresent(const SVoice *self, const char *name,
+								 s_erc *error)
 {
 	s_bool key_present;
 
@@ -879,7 +1284,7 @@ S_API s_bool SVoiceFeatProcIsPresent(const SVoice *self, const char *name,
 	if (self == NULL)
 	{
 		S_CTX_ERR(error, S_ARGERROR,
-				  "SVoiceFeatProcIsPresent",
+				  "SVoiceDataIsPresent",
 				  "Argument \"self\" is NULL");
 		return FALSE;
 	}
@@ -887,25 +1292,33 @@ S_API s_bool SVoiceFeatProcIsPresent(const SVoice *self, const char *name,
 	if (name == NULL)
 	{
 		S_CTX_ERR(error, S_ARGERROR,
-				  "SVoiceFeatProcIsPresent",
+				  "SVoiceDataIsPresent",
 				  "Argument \"name\" is NULL");
 		return FALSE;
 	}
 
-	key_present = SMapObjectPresent(self->featProcessors, name, error);
+	key_present = SMapObjectPresent(self->data->dataObjects, name, error);
 	if (S_CHK_ERR(error, S_CONTERR,
-				  "SVoiceFeatProcIsPresent",
+				  "SVoiceDataIsPresent",
 				  "Call to \"SMapObjectPresent\" failed"))
 		return FALSE;
 
+	if (!key_present)
+	{
+		s_mutex_lock((s_mutex*)&self->data->data_mutex);
+		if (find_lazy_data_entry(self, name) != NULL)
+			key_present = TRUE;
+		s_mutex_unlock((s_mutex*)&self->data->data_mutex);
+	}
+
 	return key_present;
 }
 
 
-S_API const SFeatProcessor *SVoiceGetFeatProc(const SVoice *self, const char *key,
-											  s_erc *error)
+S_API const SObject *SVoiceGetData(const SVoice *self, const char *key, s_erc *error)
 {
-	const SFeatProcessor *tmp;
+	const SObject *tmp;
+	s_lazy_data *entry;
 
 
 	S_CLR_ERR(error);
@@ -913,7 +1326,7 @@ S_API const SFeatProcessor *SVoiceGetFeatProc(const SVoice *self, const char *ke
 	if (self == NULL)
 	{
 		S_CTX_ERR(error, S_ARGERROR,
-				  "SVoiceGetFeatProc",
+				  "SVoiceGetData",
 				  "Argument \"self\" is NULL");
 		return NULL;
 	}
@@ -921,63 +1334,65 @@ S_API const SFeatProcessor *SVoiceGetFeatProc(const SVoice *self, const char *ke
 	if (key == NULL)
 	{
 		S_CTX_ERR(error, S_ARGERROR,
-				  "SVoiceGetFeatProc",
+				  "SVoiceGetData",
 				  "Argument \"key\" is NULL");
 		return NULL;
 	}
 
-	tmp = S_FEATPROCESSOR(SMapGetObjectDef(self->featProcessors, key, NULL, error));
-	if (S_CHK_ERR(error, S_CONTERR,
-				  "SVoiceGetFeatProc",
-				  "Call to \"SMapGetObjectDef\" failed"))
-		return NULL;
+	/*
+	 * The data mutex is only held for the lookup, it guards against a
+	 * concurrent SVoiceReloadData publishing a replacement data
+	 * object. Lazy data entries are loaded outside of it.
+	 */
+	while (TRUE)
+	{
+		s_mutex_lock((s_mutex*)&self->data->data_mutex);
+		tmp = SMapGetObjectDef(self->data->dataObjects, key, NULL, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "SVoiceGetData",
+					  "Call to \"SMapGetObjectDef\" failed"))
+		{
+			s_mutex_unlock((s_mutex*)&self->data->data_mutex);
+			return NULL;
+		}
 
-	return tmp;
-}
+		if (tmp != NULL)
+		{
+			s_mutex_unlock((s_mutex*)&self->data->data_mutex);
+			return tmp;
+		}
 
+		/* not in the data objects, check the lazy data entries */
+		entry = find_lazy_data_entry(self, key);
+		if ((entry == NULL) || (entry->loaded != NULL))
+		{
+			tmp = (entry != NULL)? entry->loaded : NULL;
+			s_mutex_unlock((s_mutex*)&self->data->data_mutex);
+			return tmp;
+		}
 
-S_API void SVoiceSetFeatProc(SVoice *self, const char *key,
-							 SFeatProcessor *featProc,  s_erc *error)
-{
-	S_CLR_ERR(error);
+		entry->users++;
+		s_mutex_unlock((s_mutex*)&self->data->data_mutex);
 
-	if (self == NULL)
-	{
-		S_CTX_ERR(error, S_ARGERROR,
-				  "SVoiceSetFeatProc",
-				  "Argument \"self\" is NULL");
-		return;
-	}
+		tmp = load_lazy_data_entry(self, entry, error);
+		release_lazy_data_entry(self, entry);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "SVoiceGetData",
+					  "Call to \"load_lazy_data_entry\" for data '%s' failed",
+					  key))
+			return NULL;
 
-	if (key == NULL)
-	{
-		S_CTX_ERR(error, S_ARGERROR,
-				  "SVoiceSetFeatProc",
-				  "Argument \"key\" is NULL");
-		return;
-	}
+		if (tmp != NULL)
+			return tmp;
 
-	if (featProc == NULL)
-	{
-		S_CTX_ERR(error, S_ARGERROR,
-				  "SVoiceSetFeatProc",
-				  "Argument \"featProc\" is NULL");
-		return;
+		/* the entry was removed while we were loading it, look again */
 	}
-
-	s_mutex_lock(&self->voice_mutex);
-	SMapSetObject(self->featProcessors, key, S_OBJECT(featProc), error);
-	s_mutex_unlock(&self->voice_mutex);
-
-	S_CHK_ERR(error, S_CONTERR,
-			  "SVoiceSetFeatProc",
-			  "Call to \"SMapSetObject\" failed");
 }
 
 
-S_API void SVoiceDelFeatProc(SVoice *self, const char *key, s_erc *error)
+S_API void SVoicePrefetchData(const SVoice *self, const char *key, s_erc *error)
 {
-	s_bool key_present;
+	s_lazy_data *entry;
 
 
 	S_CLR_ERR(error);
@@ -985,44 +1400,62 @@ S_API void SVoiceDelFeatProc(SVoice *self, const char *key, s_erc *error)
 	if (self == NULL)
 	{
 		S_CTX_ERR(error, S_ARGERROR,
-				  "SVoiceDelFeatProc",
+				  "SVoicePrefetchData",
 				  "Argument \"self\" is NULL");
 		return;
 	}
 
-	if (key == NULL)
+	if (key != NULL)
 	{
-		S_CTX_ERR(error, S_ARGERROR,
-				  "SVoiceDelFeatProc",
-				  "Argument \"key\" is NULL");
+		SVoiceGetData(self, key, error);
+		S_CHK_ERR(error, S_CONTERR,
+				  "SVoicePrefetchData",
+				  "Call to \"SVoiceGetData\" for data '%s' failed",
+				  key);
 		return;
 	}
 
-	s_mutex_lock(&self->voice_mutex);
-	key_present = SMapObjectPresent(self->featProcessors, key, error);
-	if (S_CHK_ERR(error, S_CONTERR,
-				  "SVoiceDelFeatProc",
-				  "Call to \"SMapObjectPresent\" failed"))
+	/*
+	 * All lazy data entries. The data mutex is released while an
+	 * entry loads, so the list is walked again from the start for the
+	 * next entry that is not loaded yet.
+	 */
+	while (TRUE)
 	{
-		s_mutex_unlock(&self->voice_mutex);
-		return;
-	}
+		s_mutex_lock((s_mutex*)&self->data->data_mutex);
+		for (entry = self->data->lazy; entry != NULL; entry = entry->next)
+		{
+			if (entry->loaded == NULL)
+				break;
+		}
 
-	if (key_present)
-		SMapObjectDelete(self->featProcessors, key, error);
+		if (entry == NULL)
+		{
+			s_mutex_unlock((s_mutex*)&self->data->data_mutex);
+			return;
+		}
 
-	s_mutex_unlock(&self->voice_mutex);
-	S_CHK_ERR(error, S_CONTERR,
-			  "SVoiceDelFeatProc",
-			  "Call to \"SMapObjectDelete\" failed");
-}
+		entry->users++;
+		s_mutex_unlock((s_mutex*)&self->data->data_mutex);
+
+		load_lazy_data_entry(self, entry, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "SVoicePrefetchData",
+					  "Call to \"load_lazy_data_entry\" for data '%s' failed",
+					  entry->name))
+		{
+			release_lazy_data_entry(self, entry);
+			return;
+		}
 
+		release_lazy_data_entry(self, entry);
+	}
+}
 
-/* utterance processors */
 
-S_API SList *SVoiceGetUttProcKeys(const SVoice *self, s_erc *error)
+S_API uint32 SVoiceGetDataGeneration(const SVoice *self, s_erc *error)
 {
-	SList *tmp;
+	uint32 generation;
 
 
 	S_CLR_ERR(error);
@@ -1030,25 +1463,25 @@ S_API SList *SVoiceGetUttProcKeys(const SVoice *self, s_erc *error)
 	if (self == NULL)
 	{
 		S_CTX_ERR(error, S_ARGERROR,
-				  "SVoiceGetUttProcKeys",
+				  "SVoiceGetDataGeneration",
 				  "Argument \"self\" is NULL");
-		return NULL;
+		return 0;
 	}
 
-	tmp = SMapGetKeys(self->uttProcessors, error);
-	if (S_CHK_ERR(error, S_CONTERR,
-				  "SVoiceGetUttProcKeys",
-				  "Call to \"SMapGetKeys\" failed"))
-		return NULL;
+	s_mutex_lock((s_mutex*)&self->data->data_mutex);
+	generation = self->data->generation;
+	s_mutex_unlock((s_mutex*)&self->data->data_mutex);
 
-	return tmp;
+	return generation;
 }
 
 
-S_API s_bool SVoiceUttProcIsPresent(const SVoice *self, const char *name,
-									s_erc *error)
+S_API void SVoiceSetData(SVoice *self, const char *key,
+						 SObject *object,  s_erc *error)
 {
 	s_bool key_present;
+	s_bool vm_loaded_data;
+
 
 
 	S_CLR_ERR(error);
@@ -1056,72 +1489,116 @@ S_API s_bool SVoiceUttProcIsPresent(const SVoice *self, const char *name,
 	if (self == NULL)
 	{
 		S_CTX_ERR(error, S_ARGERROR,
-				  "SVoiceUttProcIsPresent",
+				  "SVoiceSetData",
 				  "Argument \"self\" is NULL");
-		return FALSE;
+		return;
 	}
 
-	if (name == NULL)
+	if (key == NULL)
 	{
 		S_CTX_ERR(error, S_ARGERROR,
-				  "SVoiceUttProcIsPresent",
-				  "Argument \"name\" is NULL");
-		return FALSE;
+				  "SVoiceSetData",
+				  "Argument \"key\" is NULL");
+		return;
 	}
 
-	key_present = SMapObjectPresent(self->uttProcessors, name, error);
-	if (S_CHK_ERR(error, S_CONTERR,
-				  "SVoiceUttProcIsPresent",
-				  "Call to \"SMapObjectPresent\" failed"))
-		return FALSE;
+	if (object == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SVoiceSetData",
+				  "Argument \"object\" is NULL");
+		return;
+	}
 
-	return key_present;
-}
+	s_mutex_lock(&self->voice_mutex);
 
+	/* the cached audio was synthesized with the old data */
+	clear_synth_cache(self);
 
-S_API const SUttProcessor *SVoiceGetUttProc(const SVoice *self, const char *key,
-											s_erc *error)
-{
-	const SUttProcessor *tmp;
+	/* check if the data is in the data objects map */
+	key_present = SMapObjectPresent(self->data->dataObjects, key, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SVoiceSetData",
+				  "Call to \"SMapObjectPresent\" failed"))
+	{
+		s_mutex_unlock(&self->voice_mutex);
+		return;
+	}
 
+	if (key_present)
+	{
+		/* delete the data and config key */
+		unload_data_entry(self, key, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "SVoiceSetData",
+					  "Call to \"unload_data_entry\" failed"))
+		{
+			s_mutex_unlock(&self->voice_mutex);
+			return;
+		}
+	}
 
-	S_CLR_ERR(error);
+	/* an explicitly set data object replaces a lazy data entry */
+	unload_lazy_data_entry(self, key, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SVoiceSetData",
+				  "Call to \"unload_lazy_data_entry\" failed"))
+	{
+		s_mutex_unlock(&self->voice_mutex);
+		return;
+	}
 
-	if (self == NULL)
+	vm_loaded_data = _s_vm_data_loaded_inc_ref(object, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SVoiceSetData",
+				  "Call to \"_s_vm_data_loaded_inc_ref\" failed"))
 	{
-		S_CTX_ERR(error, S_ARGERROR,
-				  "SVoiceGetUttProc",
-				  "Argument \"self\" is NULL");
-		return NULL;
+		s_mutex_unlock(&self->voice_mutex);
+		return;
 	}
 
-	if (key == NULL)
+	if (vm_loaded_data)
 	{
-		S_CTX_ERR(error, S_ARGERROR,
-				  "SVoiceGetUttProc",
-				  "Argument \"key\" is NULL");
-		return NULL;
+		/* it was loaded previously by vm, just incremented reference
+		 * in _s_vm_data_loaded_inc_ref. Set it in data objects and
+		 * return.
+		 */
+		s_mutex_lock(&self->data->data_mutex);
+		SMapSetObject(self->data->dataObjects, key, object, error);
+		self->data->generation++;
+		s_mutex_unlock(&self->data->data_mutex);
+		S_CHK_ERR(error, S_CONTERR,
+				  "SVoiceSetData",
+				  "Call to \"SMapSetObject\" for data '%s' in data config failed",
+				  key); /* data is probably corrupted */
+		s_mutex_unlock(&self->voice_mutex);
+		return;
 	}
 
-	tmp = S_UTTPROCESSOR(SMapGetObjectDef(self->uttProcessors, key, NULL, error));
-	if (S_CHK_ERR(error, S_CONTERR,
-				  "SVoiceGetUttProc",
-				  "Call to \"SMapGetObjectDef\" failed"))
-		return NULL;
+	/* not previously loaded in voice manager */
+	s_mutex_lock(&self->data->data_mutex);
+	SMapSetObject(self->data->dataObjects, key, object, error);
+	self->data->generation++;
+	s_mutex_unlock(&self->data->data_mutex);
+	S_CHK_ERR(error, S_CONTERR,
+			  "SVoiceSetData",
+			  "Call to \"SMapSetObject\" failed");
 
-	return tmp;
+	s_mutex_unlock(&self->voice_mutex);
 }
 
 
-S_API void SVoiceSetUttProc(SVoice *self, const char *key,
-							SUttProcessor *uttProc,  s_erc *error)
+S_API void SVoiceDelData(SVoice *self, const char *key, s_erc *error)
 {
+	s_bool key_present;
+
+
 	S_CLR_ERR(error);
 
 	if (self == NULL)
 	{
 		S_CTX_ERR(error, S_ARGERROR,
-				  "SVoiceSetUttProc",
+				  "SVoiceDelData",
 				  "Argument \"self\" is NULL");
 		return;
 	}
@@ -1129,31 +1606,54 @@ S_API void SVoiceSetUttProc(SVoice *self, const char *key,
 	if (key == NULL)
 	{
 		S_CTX_ERR(error, S_ARGERROR,
-				  "SVoiceSetUttProc",
+				  "SVoiceDelData",
 				  "Argument \"key\" is NULL");
 		return;
 	}
 
-	if (uttProc == NULL)
+	/* check if the data is in the configuration */
+	s_mutex_lock(&self->voice_mutex);
+
+	/* the cached audio was synthesized with the old data */
+	clear_synth_cache(self);
+
+	key_present = SMapObjectPresent(self->data->dataObjects, key, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SVoiceDelData",
+				  "Call to \"SMapObjectPresent\" failed"))
 	{
-		S_CTX_ERR(error, S_ARGERROR,
-				  "SVoiceSetUttProc",
-				  "Argument \"uttProc\" is NULL");
+		s_mutex_unlock(&self->voice_mutex);
 		return;
 	}
 
-	s_mutex_lock(&self->voice_mutex);
-	SMapSetObject(self->uttProcessors, key, S_OBJECT(uttProc), error);
-	s_mutex_unlock(&self->voice_mutex);
+	if (key_present)
+	{
+		/* delete the data and config key */
+		unload_data_entry(self, key, error);
+		S_CHK_ERR(error, S_CONTERR,
+				  "SVoiceDelData",
+				  "Call to \"unload_data_entry\" failed");
+	}
+	else
+	{
+		unload_lazy_data_entry(self, key, error);
+		S_CHK_ERR(error, S_CONTERR,
+				  "SVoiceDelData",
+				  "Call to \"unload_lazy_data_entry\" failed");
+	}
 
-	S_CHK_ERR(error, S_CONTERR,
-			  "SVoiceSetUttProc",
-			  "Call to \"SMapSetObject\" failed");
+	s_mutex_unlock(&self->voice_mutex);
 }
 
 
-S_API void SVoiceDelUttProc(SVoice *self, const char *key, s_erc *error)
+S_API void SVoiceReloadData(SVoice *self, const char *key, s_erc *error)
 {
+	SObject *newObject;
+	SObject *oldObject = NULL;
+	s_lazy_data *entry;
+	s_retired_data *retired;
+	s_retired_data *reclaimed;
+	s_data_epoch *epoch;
 	s_bool key_present;
 
 
@@ -1162,7 +1662,7 @@ S_API void SVoiceDelUttProc(SVoice *self, const char *key, s_erc *error)
 	if (self == NULL)
 	{
 		S_CTX_ERR(error, S_ARGERROR,
-				  "SVoiceDelUttProc",
+				  "SVoiceReloadData",
 				  "Argument \"self\" is NULL");
 		return;
 	}
@@ -1170,50 +1670,187 @@ S_API void SVoiceDelUttProc(SVoice *self, const char *key, s_erc *error)
 	if (key == NULL)
 	{
 		S_CTX_ERR(error, S_ARGERROR,
-				  "SVoiceDelUttProc",
+				  "SVoiceReloadData",
 				  "Argument \"key\" is NULL");
 		return;
 	}
 
-	s_mutex_lock(&self->voice_mutex);
-	key_present = SMapObjectPresent(self->uttProcessors, key, error);
+	/*
+	 * load the replacement data object off to the side, without
+	 * locking the voice, so that syntheses continue.
+	 */
+	newObject = reload_data_object(self, key, error);
 	if (S_CHK_ERR(error, S_CONTERR,
-				  "SVoiceDelUttProc",
+				  "SVoiceReloadData",
+				  "Call to \"reload_data_object\" for data '%s' failed",
+				  key))
+		return;
+
+	retired = S_CALLOC(s_retired_data, 1);
+	epoch = S_CALLOC(s_data_epoch, 1);
+	if ((retired == NULL) || (epoch == NULL))
+	{
+		S_FTL_ERR(error, S_MEMERROR,
+				  "SVoiceReloadData",
+				  "Failed to allocate memory for data epoch");
+		if (retired != NULL)
+			S_FREE(retired);
+		if (epoch != NULL)
+			S_FREE(epoch);
+		unload_data_object(newObject, error);
+		return;
+	}
+
+	/* publish */
+	s_mutex_lock(&self->data->data_mutex);
+	key_present = SMapObjectPresent(self->data->dataObjects, key, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SVoiceReloadData",
 				  "Call to \"SMapObjectPresent\" failed"))
 	{
-		s_mutex_unlock(&self->voice_mutex);
+		s_erc local_err = S_SUCCESS;
+
+
+		s_mutex_unlock(&self->data->data_mutex);
+		S_FREE(retired);
+		S_FREE(epoch);
+		unload_data_object(newObject, &local_err);
 		return;
 	}
 
 	if (key_present)
-		SMapObjectDelete(self->uttProcessors, key, error);
+	{
+		/*
+		 * Replace the value in place, the map would delete the old
+		 * object, so we hold on to it with an extra reference.
+		 */
+		oldObject = (SObject*)SMapGetObject(self->data->dataObjects, key, error);
+		if (!S_CHK_ERR(error, S_CONTERR,
+					   "SVoiceReloadData",
+					   "Call to \"SMapGetObject\" failed"))
+		{
+			SObjectIncRef(oldObject);
+			SMapSetObject(self->data->dataObjects, key, newObject, error);
+			SObjectDecRef(oldObject);
+			if (S_CHK_ERR(error, S_CONTERR,
+						  "SVoiceReloadData",
+						  "Call to \"SMapSetObject\" failed"))
+				oldObject = NULL;
+		}
+	}
+	else
+	{
+		entry = find_lazy_data_entry(self, key);
+		if (entry != NULL)
+		{
+			oldObject = (SObject*)entry->loaded;
+			entry->loaded = newObject;
+		}
+		else
+		{
+			/* deleted while we were loading */
+			S_CTX_ERR(error, S_FAILURE,
+					  "SVoiceReloadData",
+					  "Voice does not have a '%s' data object",
+					  key);
+		}
+	}
+
+	if (*error != S_SUCCESS)
+	{
+		s_erc local_err = S_SUCCESS;
+
+
+		s_mutex_unlock(&self->data->data_mutex);
+		S_FREE(retired);
+		S_FREE(epoch);
+		unload_data_object(newObject, &local_err);
+		return;
+	}
+
+	if ((oldObject != NULL)
+		&& ((self->data->epochs != self->data->epoch)
+			|| (self->data->epoch->readers > 0)))
+	{
+		/*
+		 * Syntheses are in flight, retire the old data object at the
+		 * end of the current epoch, and start a new epoch.
+		 */
+		retired->object = oldObject;
+		retired->next = self->data->epoch->retired;
+		self->data->epoch->retired = retired;
+		self->data->epoch->next = epoch;
+		self->data->epoch = epoch;
+		oldObject = NULL;
+		retired = NULL;
+		epoch = NULL;
+	}
+
+	self->data->generation++;
+	reclaimed = reclaim_retired_data(self);
+	s_mutex_unlock(&self->data->data_mutex);
+
+	if (retired != NULL)
+		S_FREE(retired);
+
+	if (epoch != NULL)
+		S_FREE(epoch);
+
+	/* no syntheses in flight, unload now */
+	if (oldObject != NULL)
+	{
+		unload_data_object(oldObject, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "SVoiceReloadData",
+					  "Call to \"unload_data_object\" failed"))
+		{
+			s_erc local_err = S_SUCCESS;
+
+
+			unload_retired_data(reclaimed, &local_err);
+			return;
+		}
+	}
+
+	unload_retired_data(reclaimed, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SVoiceReloadData",
+				  "Call to \"unload_retired_data\" failed"))
+		return;
 
+	/* the cached audio was synthesized with the old data */
+	s_mutex_lock(&self->voice_mutex);
+	if (self->data->cache != NULL)
+	{
+		SSynthCacheClear(self->data->cache, TRUE, error);
+		S_CHK_ERR(error, S_CONTERR,
+				  "SVoiceReloadData",
+				  "Call to \"SSynthCacheClear\" failed");
+	}
 	s_mutex_unlock(&self->voice_mutex);
-	S_CHK_ERR(error, S_CONTERR,
-			  "SVoiceDelUttProc",
-			  "Call to \"SMapObjectDelete\" failed");
 }
 
 
-/* utterance types */
+/* features */
 
-S_API SList *SVoiceGetUttTypesKeys(const SVoice *self, s_erc *error)
+S_API SList *SVoiceGetFeatureKeys(const SVoice *self, s_erc *error)
 {
 	SList *tmp;
 
+
 	S_CLR_ERR(error);
 
 	if (self == NULL)
 	{
 		S_CTX_ERR(error, S_ARGERROR,
-				  "SVoiceGetUttTypeKeys",
+				  "SVoiceGetFeatureKeys",
 				  "Argument \"self\" is NULL");
 		return NULL;
 	}
 
-	tmp = SMapGetKeys(self->uttTypes, error);
+	tmp = SMapGetKeys(self->features, error);
 	if (S_CHK_ERR(error, S_CONTERR,
-				  "SVoiceGetUttTypeKeys",
+				  "SVoiceGetFeatureKeys",
 				  "Call to \"SMapGetKeys\" failed"))
 		return NULL;
 
@@ -1221,8 +1858,8 @@ S_API SList *SVoiceGetUttTypesKeys(const SVoice *self, s_erc *error)
 }
 
 
-S_API s_bool SVoiceUttTypeIsPresent(const SVoice *self, const char *name,
-									s_erc *error)
+S_API s_bool SVoiceFeatureIsPresent(const SVoice *self, const char *name,
+								 s_erc *error)
 {
 	s_bool key_present;
 
@@ -1232,7 +1869,7 @@ S_API s_bool SVoiceUttTypeIsPresent(const SVoice *self, const char *name,
 	if (self == NULL)
 	{
 		S_CTX_ERR(error, S_ARGERROR,
-				  "SVoiceUttTypeIsPresent",
+				  "SVoiceFeatureIsPresent",
 				  "Argument \"self\" is NULL");
 		return FALSE;
 	}
@@ -1240,14 +1877,14 @@ S_API s_bool SVoiceUttTypeIsPresent(const SVoice *self, const char *name,
 	if (name == NULL)
 	{
 		S_CTX_ERR(error, S_ARGERROR,
-				  "SVoiceUttTypeIsPresent",
+				  "SVoiceFeatureIsPresent",
 				  "Argument \"name\" is NULL");
 		return FALSE;
 	}
 
-	key_present = SMapObjectPresent(self->uttTypes, name, error);
+	key_present = SMapObjectPresent(self->features, name, error);
 	if (S_CHK_ERR(error, S_CONTERR,
-				  "SVoiceUttTypeIsPresent",
+				  "SVoiceFeatureIsPresent",
 				  "Call to \"SMapObjectPresent\" failed"))
 		return FALSE;
 
@@ -1255,17 +1892,17 @@ S_API s_bool SVoiceUttTypeIsPresent(const SVoice *self, const char *name,
 }
 
 
-S_API const SList *SVoiceGetUttType(const SVoice *self, const char *key,
-									s_erc *error)
+S_API const SObject *SVoiceGetFeature(const SVoice *self, const char *key, s_erc *error)
 {
-	const SList *tmp;
+	const SObject *tmp;
+
 
 	S_CLR_ERR(error);
 
 	if (self == NULL)
 	{
 		S_CTX_ERR(error, S_ARGERROR,
-				  "SVoiceGetUttType",
+				  "SVoiceGetFeature",
 				  "Argument \"self\" is NULL");
 		return NULL;
 	}
@@ -1273,14 +1910,14 @@ S_API const SList *SVoiceGetUttType(const SVoice *self, const char *key,
 	if (key == NULL)
 	{
 		S_CTX_ERR(error, S_ARGERROR,
-				  "SVoiceGetUttType",
+				  "SVoiceGetFeature",
 				  "Argument \"key\" is NULL");
 		return NULL;
 	}
 
-	tmp = S_LIST(SMapGetObjectDef(self->uttTypes, key, NULL, error));
+	tmp = SMapGetObjectDef(self->features, key, NULL, error);
 	if (S_CHK_ERR(error, S_CONTERR,
-				  "SVoiceGetUttType",
+				  "SVoiceGetFeature",
 				  "Call to \"SMapGetObjectDef\" failed"))
 		return NULL;
 
@@ -1288,15 +1925,18 @@ S_API const SList *SVoiceGetUttType(const SVoice *self, const char *key,
 }
 
 
-S_API void SVoiceSetUttType(SVoice *self, const char *key,
-							SList *uttType,  s_erc *error)
+S_API void SVoiceSetFeature(SVoice *self, const char *key,
+							SObject *object,  s_erc *error)
 {
+	SObject *oldObject;
+
+
 	S_CLR_ERR(error);
 
 	if (self == NULL)
 	{
 		S_CTX_ERR(error, S_ARGERROR,
-				  "SVoiceSetUttType",
+				  "SVoiceSetFeature",
 				  "Argument \"self\" is NULL");
 		return;
 	}
@@ -1304,40 +1944,64 @@ S_API void SVoiceSetUttType(SVoice *self, const char *key,
 	if (key == NULL)
 	{
 		S_CTX_ERR(error, S_ARGERROR,
-				  "SVoiceSetUttType",
+				  "SVoiceSetFeature",
 				  "Argument \"key\" is NULL");
 		return;
 	}
 
-	if (uttType == NULL)
+	if (object == NULL)
 	{
 		S_CTX_ERR(error, S_ARGERROR,
-				  "SVoiceSetUttType",
-				  "Argument \"uttType\" is NULL");
+				  "SVoiceSetFeature",
+				  "Argument \"object\" is NULL");
 		return;
 	}
 
-	s_mutex_lock(&self->voice_mutex);
-	SMapSetObject(self->uttTypes, key, S_OBJECT(uttType), error);
-	s_mutex_unlock(&self->voice_mutex);
+	s_mutex_lock((s_mutex*)&(self->voice_mutex));
 
-	S_CHK_ERR(error, S_CONTERR,
-			  "SVoiceSetUttType",
-			  "Call to \"SMapSetObject\" failed");
-}
+	/* the features of the cache key don't invalidate the cached audio */
+	if (!_s_synth_cache_key_feature(key))
+		clear_synth_cache(self);
 
+	/* syntheses in flight may still be using the old feature */
+	oldObject = unlink_voice_object(self->features, key, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SVoiceSetFeature",
+				  "Call to \"unlink_voice_object\" failed"))
+	{
+		s_mutex_unlock((s_mutex*)&(self->voice_mutex));
+		return;
+	}
 
-S_API void SVoiceDelUttType(SVoice *self, const char *key, s_erc *error)
-{
-	s_bool key_present;
+	SMapSetObject(self->features, key, object, error);
+	s_mutex_unlock((s_mutex*)&(self->voice_mutex));
+
+	S_CHK_ERR(error, S_CONTERR,
+			  "SVoiceSetFeature",
+			  "Call to \"SMapSetObject\" failed");
+
+	if ((oldObject != NULL) && (oldObject != object))
+	{
+		s_erc local_err = S_SUCCESS;
 
 
+		retire_data_object(self, oldObject, TRUE, &local_err);
+		S_CHK_ERR(&local_err, S_CONTERR,
+				  "SVoiceSetFeature",
+				  "Call to \"retire_data_object\" failed"); /* just log it */
+	}
+}
+
+
+S_LOCAL void _SVoiceSetFeature_no_lock(SVoice *self, const char *key,
+									   SObject *object,  s_erc *error)
+{
 	S_CLR_ERR(error);
 
 	if (self == NULL)
 	{
 		S_CTX_ERR(error, S_ARGERROR,
-				  "SVoiceDelUttType",
+				  "_SVoiceSetFeature_no_lock",
 				  "Argument \"self\" is NULL");
 		return;
 	}
@@ -1345,40 +2009,29 @@ S_API void SVoiceDelUttType(SVoice *self, const char *key, s_erc *error)
 	if (key == NULL)
 	{
 		S_CTX_ERR(error, S_ARGERROR,
-				  "SVoiceDelUttType",
+				  "_SVoiceSetFeature_no_lock",
 				  "Argument \"key\" is NULL");
 		return;
 	}
 
-	s_mutex_lock(&self->voice_mutex);
-	key_present = SMapObjectPresent(self->features, key, error);
-	if (S_CHK_ERR(error, S_CONTERR,
-				  "SVoiceDelUttType",
-				  "Call to \"SMapObjectPresent\" failed"))
+	if (object == NULL)
 	{
-		s_mutex_unlock(&self->voice_mutex);
+		S_CTX_ERR(error, S_ARGERROR,
+				  "_SVoiceSetFeature_no_lock",
+				  "Argument \"object\" is NULL");
 		return;
 	}
 
-	if (key_present)
-		SMapObjectDelete(self->uttTypes, key, error);
-
-	s_mutex_unlock(&self->voice_mutex);
+	SMapSetObject(self->features, key, object, error);
 	S_CHK_ERR(error, S_CONTERR,
-			  "SVoiceDelUttType",
-			  "Call to \"SMapObjectDelete\" failed");
+			  "_SVoiceSetFeature_no_lock",
+			  "Call to \"SMapSetObject\" failed");
 }
 
 
-S_LOCAL void _s_voice_load_data(SVoice *self, const SMap *dataConfig, s_erc *error)
+S_API void SVoiceDelFeature(SVoice *self, const char *key, s_erc *error)
 {
-	SIterator *itr;
-	const char *data_name;
-	const SObject *loaded;
-	const SMap *dataObjectMap;
-	s_data_info *data_info;
-	const SObject *vcfgObject;
-	char *voice_base_path;
+	SObject *oldObject;
 
 
 	S_CLR_ERR(error);
@@ -1386,345 +2039,2900 @@ S_LOCAL void _s_voice_load_data(SVoice *self, const SMap *dataConfig, s_erc *err
 	if (self == NULL)
 	{
 		S_CTX_ERR(error, S_ARGERROR,
-				  "_s_voice_load_data",
+				  "SVoiceDelFeature",
 				  "Argument \"self\" is NULL");
 		return;
 	}
 
-	/* get voice base path */
-	vcfgObject = SVoiceGetFeature(self, "config_file", error);
-	if (S_CHK_ERR(error, S_CONTERR,
-				  "_s_voice_load_data",
-				  "Call to \"SVoiceGetFeature\" failed, failed to get voice config file"))
+	if (key == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SVoiceDelFeature",
+				  "Argument \"key\" is NULL");
 		return;
+	}
 
-	voice_base_path = s_get_base_path(SObjectGetString(vcfgObject, error), error);
-	if (S_CHK_ERR(error, S_CONTERR,
-				  "_s_voice_load_data",
-				  "Call to \"s_get_base_path/SObjectGetString\" failed"))
-		return;
+	s_mutex_lock((s_mutex*)&self->voice_mutex);
 
-	/*
-	 * now iterate through data config and load everything
-	 */
-	itr = S_ITERATOR_GET(dataConfig, error);
+	/* the features of the cache key don't invalidate the cached audio */
+	if (!_s_synth_cache_key_feature(key))
+		clear_synth_cache(self);
+
+	oldObject = unlink_voice_object(self->features, key, error);
+	s_mutex_unlock((s_mutex*)&self->voice_mutex);
 	if (S_CHK_ERR(error, S_CONTERR,
-				  "_s_voice_load_data",
-				  "Call to \"S_ITERATOR_GET\" failed"))
-	{
-		S_DELETE(itr, "_s_voice_load_data", error);
-		S_FREE(voice_base_path);
+				  "SVoiceDelFeature",
+				  "Call to \"unlink_voice_object\" failed"))
 		return;
-	}
 
-	while (itr)
-	{
-		char *combined_path;
+	/* syntheses in flight may still be using it */
+	retire_data_object(self, oldObject, TRUE, error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "SVoiceDelFeature",
+			  "Call to \"retire_data_object\" failed");
+}
 
 
-		data_name = SIteratorKey(itr, error);
-		if (S_CHK_ERR(error, S_CONTERR,
-					  "_s_voice_load_data",
-					  "Call to \"SIteratorKey\" failed"))
-		{
-			S_DELETE(itr, "_s_voice_load_data", error);
-			S_FREE(voice_base_path);
-			return;
-		}
+/* feature processors */
 
-		/*
-		 * We have already checked this cast in
-		 * _s_voice_load_dataConfig (_s_load_voice_data_config)
-		 */
-		dataObjectMap = (const SMap*)SMapGetObjectDef(dataConfig, data_name, NULL, error);
-		if (S_CHK_ERR(error, S_CONTERR,
-					  "_s_voice_load_data",
-					  "Call to \"SMapGetObjectDef\" for data '%s' failed",
-					  data_name))
-		{
-			S_DELETE(itr, "_s_voice_load_data", error);
-			S_FREE(voice_base_path);
-			return;
-		}
+S_API SList *SVoiceGetFeatProcKeys(const SVoice *self, s_erc *error)
+{
+	SList *tmp;
 
-		if (dataObjectMap == NULL)
-		{
-			S_CTX_ERR(error, S_CONTERR,
-					  "_s_voice_load_data",
-					  "Data object map for data '%s' in data config in NULL",
-					  data_name);
-			S_DELETE(itr, "_s_voice_load_data", error);
-			S_FREE(voice_base_path);
-			return;
-		}
 
-		data_info = get_data_info(dataObjectMap, error);
-		if (S_CHK_ERR(error, S_CONTERR,
-					  "_s_voice_load_data",
-					  "Call to \"get_data_info\" for data '%s' in data config failed",
-					  data_name))
-		{
-			S_DELETE(itr, "_s_voice_load_data", error);
-			S_FREE(voice_base_path);
-			return;
-		}
+	S_CLR_ERR(error);
 
-		/* get data path, the one in the config file may be relative
-		 * to the voice base path
-		 */
-		combined_path = s_path_combine(voice_base_path, data_info->path,
-									   error);
-		if (S_CHK_ERR(error, S_CONTERR,
-					  "_s_voice_load_data",
-					  "Call to \"s_path_combine\" failed"))
-		{
-			S_DELETE(itr, "_s_voice_load_data", error);
-			S_FREE(voice_base_path);
-			return;
-		}
+	if (self == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SVoiceGetFeatProcKeys",
+				  "Argument \"self\" is NULL");
+		return NULL;
+	}
 
-		loaded = _s_vm_load_data(data_info->plugin, combined_path,
-								 data_info->format, error);
-		S_FREE(combined_path);
-		if (S_CHK_ERR(error, S_CONTERR,
-					  "_s_voice_load_data",
-					  "Call to \"_s_vm_load_data\" for data '%s' in data config failed",
-					  data_name))
-		{
-			S_FREE(data_info);
-			S_DELETE(itr, "_s_voice_load_data", error);
-			S_FREE(voice_base_path);
-			return;
-		}
+	tmp = SMapGetKeys(self->featProcessors, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SVoiceGetFeatProcKeys",
+				  "Call to \"SMapGetKeys\" failed"))
+		return NULL;
 
-		S_FREE(data_info);
+	return tmp;
+}
 
-		SMapSetObject(self->data->dataObjects, data_name, loaded, error);
-		if (S_CHK_ERR(error, S_CONTERR,
-					  "_s_voice_load_data",
-					  "Call to \"SMapSetObject\" for data '%s' in data config failed",
-					  data_name))
-		{
-			s_erc local_err = S_SUCCESS;
 
+S_API s_bool SVoiceFeatProcIsPresent(const SVoice *self, const char *name,
+									s_erc *error)
+{
+	s_bool key_present;
 
-			S_FREE(voice_base_path);
-			S_DELETE(itr, "_s_voice_load_data", error);
-			_s_vm_unload_data((SObject*)loaded, &local_err); /* error is already set */
-			return;
-		}
 
-		itr = SIteratorNext(itr);
-	}
+	S_CLR_ERR(error);
 
-	S_FREE(voice_base_path);
-}
+	if (self == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SVoiceFeatProcIsPresent",
+				  "Argument \"self\" is NULL");
+		return FALSE;
+	}
 
+	if (name == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SVoiceFeatProcIsPresent",
+				  "Argument \"name\" is NULL");
+		return FALSE;
+	}
 
-/************************************************************************************/
-/*                                                                                  */
-/* Class registration                                                               */
-/*                                                                                  */
-/************************************************************************************/
+	key_present = SMapObjectPresent(self->featProcessors, name, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SVoiceFeatProcIsPresent",
+				  "Call to \"SMapObjectPresent\" failed"))
+		return FALSE;
 
-S_LOCAL void _s_voice_class_add(s_erc *error)
-{
-	S_CLR_ERR(error);
-	s_class_add(S_OBJECTCLASS(&VoiceClass), error);
-	S_CHK_ERR(error, S_CONTERR,
-			  "_s_voice_class_add",
-			  "Failed to add SVoiceClass");
+	return key_present;
 }
 
 
-/************************************************************************************/
-/*                                                                                  */
-/* Static function implementations                                                  */
-/*                                                                                  */
-/************************************************************************************/
-
-static s_data_info *get_data_info(const SMap *map, s_erc *error)
+S_API const SFeatProcessor *SVoiceGetFeatProc(const SVoice *self, const char *key,
+											  s_erc *error)
 {
-	s_data_info *data_info;
-	const char *value;
+	const SFeatProcessor *tmp;
 
 
 	S_CLR_ERR(error);
 
-	data_info = S_MALLOC(s_data_info, 1);
-	if (data_info == NULL)
+	if (self == NULL)
 	{
-		S_FTL_ERR(error, S_MEMERROR,
-				  "get_data_info",
-				  "Failed to allocate memory for 's_data_info' object");
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SVoiceGetFeatProc",
+				  "Argument \"self\" is NULL");
 		return NULL;
 	}
 
-	/* format */
-	value = SMapGetStringDef(map, "format", NULL, error);
-	if (S_CHK_ERR(error, S_CONTERR,
-				  "get_data_info",
-				  "Call to \"SMapGetStringDef\" of key 'format' failed"))
+	if (key == NULL)
 	{
-		S_FREE(data_info);
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SVoiceGetFeatProc",
+				  "Argument \"key\" is NULL");
+		return NULL;
+	}
+
+	tmp = S_FEATPROCESSOR(SMapGetObjectDef(self->featProcessors, key, NULL, error));
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SVoiceGetFeatProc",
+				  "Call to \"SMapGetObjectDef\" failed"))
+		return NULL;
+
+	return tmp;
+}
+
+
+S_API void SVoiceSetFeatProc(SVoice *self, const char *key,
+							 SFeatProcessor *featProc,  s_erc *error)
+{
+	SObject *oldFeatProc;
+
+
+	S_CLR_ERR(error);
+
+	if (self == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SVoiceSetFeatProc",
+				  "Argument \"self\" is NULL");
+		return;
+	}
+
+	if (key == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SVoiceSetFeatProc",
+				  "Argument \"key\" is NULL");
+		return;
+	}
+
+	if (featProc == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SVoiceSetFeatProc",
+				  "Argument \"featProc\" is NULL");
+		return;
+	}
+
+	s_mutex_lock(&self->voice_mutex);
+
+	/* the cached audio was synthesized with the old feature processors */
+	clear_synth_cache(self);
+
+	/* a synthesis in flight may have looked up the old one */
+	oldFeatProc = unlink_voice_object(self->featProcessors, key, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SVoiceSetFeatProc",
+				  "Call to \"unlink_voice_object\" failed"))
+	{
+		s_mutex_unlock(&self->voice_mutex);
+		return;
+	}
+
+	SMapSetObject(self->featProcessors, key, S_OBJECT(featProc), error);
+	s_mutex_unlock(&self->voice_mutex);
+
+	S_CHK_ERR(error, S_CONTERR,
+			  "SVoiceSetFeatProc",
+			  "Call to \"SMapSetObject\" failed");
+
+	if ((oldFeatProc != NULL) && (oldFeatProc != S_OBJECT(featProc)))
+	{
+		s_erc local_err = S_SUCCESS;
+
+
+		retire_data_object(self, oldFeatProc, TRUE, &local_err);
+		S_CHK_ERR(&local_err, S_CONTERR,
+				  "SVoiceSetFeatProc",
+				  "Call to \"retire_data_object\" failed"); /* just log it */
+	}
+}
+
+
+S_API void SVoiceDelFeatProc(SVoice *self, const char *key, s_erc *error)
+{
+	SObject *oldFeatProc;
+
+
+	S_CLR_ERR(error);
+
+	if (self == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SVoiceDelFeatProc",
+				  "Argument \"self\" is NULL");
+		return;
+	}
+
+	if (key == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SVoiceDelFeatProc",
+				  "Argument \"key\" is NULL");
+		return;
+	}
+
+	s_mutex_lock(&self->voice_mutex);
+
+	/* the cached audio was synthesized with the old feature processors */
+	clear_synth_cache(self);
+
+	oldFeatProc = unlink_voice_object(self->featProcessors, key, error);
+	s_mutex_unlock(&self->voice_mutex);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SVoiceDelFeatProc",
+				  "Call to \"unlink_voice_object\" failed"))
+		return;
+
+	/* deleted at the end of the syntheses that may be running it */
+	retire_data_object(self, oldFeatProc, TRUE, error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "SVoiceDelFeatProc",
+			  "Call to \"retire_data_object\" failed");
+}
+
+
+/* utterance processors */
+
+S_API SList *SVoiceGetUttProcKeys(const SVoice *self, s_erc *error)
+{
+	SList *tmp;
+
+
+	S_CLR_ERR(error);
+
+	if (self == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SVoiceGetUttProcKeys",
+				  "Argument \"self\" is NULL");
+		return NULL;
+	}
+
+	tmp = SMapGetKeys(self->uttProcessors, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SVoiceGetUttProcKeys",
+				  "Call to \"SMapGetKeys\" failed"))
+		return NULL;
+
+	return tmp;
+}
+
+
+S_API s_bool SVoiceUttProcIsPresent(const SVoice *self, const char *name,
+									s_erc *error)
+{
+	s_bool key_present;
+
+
+	S_CLR_ERR(error);
+
+	if (self == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SVoiceUttProcIsPresent",
+				  "Argument \"self\" is NULL");
+		return FALSE;
+	}
+
+	if (name == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SVoiceUttProcIsPresent",
+				  "Argument \"name\" is NULL");
+		return FALSE;
+	}
+
+	key_present = SMapObjectPresent(self->uttProcessors, name, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SVoiceUttProcIsPresent",
+				  "Call to \"SMapObjectPresent\" failed"))
+		return FALSE;
+
+	return key_present;
+}
+
+
+S_API const SUttProcessor *SVoiceGetUttProc(const SVoice *self, const char *key,
+											s_erc *error)
+{
+	const SUttProcessor *tmp;
+
+
+	S_CLR_ERR(error);
+
+	if (self == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SVoiceGetUttProc",
+				  "Argument \"self\" is NULL");
+		return NULL;
+	}
+
+	if (key == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SVoiceGetUttProc",
+				  "Argument \"key\" is NULL");
+		return NULL;
+	}
+
+	tmp = S_UTTPROCESSOR(SMapGetObjectDef(self->uttProcessors, key, NULL, error));
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SVoiceGetUttProc",
+				  "Call to \"SMapGetObjectDef\" failed"))
+		return NULL;
+
+	return tmp;
+}
+
+
+S_API void SVoiceSetUttProc(SVoice *self, const char *key,
+							SUttProcessor *uttProc,  s_erc *error)
+{
+	S_CLR_ERR(error);
+
+	if (self == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SVoiceSetUttProc",
+				  "Argument \"self\" is NULL");
+		return;
+	}
+
+	if (key == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SVoiceSetUttProc",
+				  "Argument \"key\" is NULL");
+		return;
+	}
+
+	if (uttProc == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SVoiceSetUttProc",
+				  "Argument \"uttProc\" is NULL");
+		return;
+	}
+
+	s_mutex_lock(&self->voice_mutex);
+
+	/* the cached audio was synthesized with the old utterance processors */
+	clear_synth_cache(self);
+
+	SMapSetObject(self->uttProcessors, key, S_OBJECT(uttProc), error);
+	invalidate_utt_plans(self);
+	s_mutex_unlock(&self->voice_mutex);
+
+	S_CHK_ERR(error, S_CONTERR,
+			  "SVoiceSetUttProc",
+			  "Call to \"SMapSetObject\" failed");
+}
+
+
+S_API void SVoiceDelUttProc(SVoice *self, const char *key, s_erc *error)
+{
+	s_bool key_present;
+
+
+	S_CLR_ERR(error);
+
+	if (self == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SVoiceDelUttProc",
+				  "Argument \"self\" is NULL");
+		return;
+	}
+
+	if (key == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SVoiceDelUttProc",
+				  "Argument \"key\" is NULL");
+		return;
+	}
+
+	s_mutex_lock(&self->voice_mutex);
+
+	/* the cached audio was synthesized with the old utterance processors */
+	clear_synth_cache(self);
+
+	key_present = SMapObjectPresent(self->uttProcessors, key, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SVoiceDelUttProc",
+				  "Call to \"SMapObjectPresent\" failed"))
+	{
+		s_mutex_unlock(&self->voice_mutex);
+		return;
+	}
+
+	if (key_present)
+	{
+		SMapObjectDelete(self->uttProcessors, key, error);
+		invalidate_utt_plans(self);
+	}
+
+	s_mutex_unlock(&self->voice_mutex);
+	S_CHK_ERR(error, S_CONTERR,
+			  "SVoiceDelUttProc",
+			  "Call to \"SMapObjectDelete\" failed");
+}
+
+
+/* utterance types */
+
+S_API SList *SVoiceGetUttTypesKeys(const SVoice *self, s_erc *error)
+{
+	SList *tmp;
+
+	S_CLR_ERR(error);
+
+	if (self == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SVoiceGetUttTypeKeys",
+				  "Argument \"self\" is NULL");
+		return NULL;
+	}
+
+	tmp = SMapGetKeys(self->uttTypes, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SVoiceGetUttTypeKeys",
+				  "Call to \"SMapGetKeys\" failed"))
+		return NULL;
+
+	return tmp;
+}
+
+
+S_API s_bool SVoiceUttTypeIsPresent(const SVoice *self, const char *name,
+									s_erc *error)
+{
+	s_bool key_present;
+
+
+	S_CLR_ERR(error);
+
+	if (self == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SVoiceUttTypeIsPresent",
+				  "Argument \"self\" is NULL");
+		return FALSE;
+	}
+
+	if (name == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SVoiceUttTypeIsPresent",
+				  "Argument \"name\" is NULL");
+		return FALSE;
+	}
+
+	key_present = SMapObjectPresent(self->uttTypes, name, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SVoiceUttTypeIsPresent",
+				  "Call to \"SMapObjectPresent\" failed"))
+		return FALSE;
+
+	return key_present;
+}
+
+
+S_API const SList *SVoiceGetUttType(const SVoice *self, const char *key,
+									s_erc *error)
+{
+	const SList *tmp;
+
+	S_CLR_ERR(error);
+
+	if (self == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SVoiceGetUttType",
+				  "Argument \"self\" is NULL");
+		return NULL;
+	}
+
+	if (key == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SVoiceGetUttType",
+				  "Argument \"key\" is NULL");
+		return NULL;
+	}
+
+	tmp = S_LIST(SMapGetObjectDef(self->uttTypes, key, NULL, error));
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SVoiceGetUttType",
+				  "Call to \"SMapGetObjectDef\" failed"))
+		return NULL;
+
+	return tmp;
+}
+
+
+S_API void SVoiceSetUttType(SVoice *self, const char *key,
+							SList *uttType,  s_erc *error)
+{
+	S_CLR_ERR(error);
+
+	if (self == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SVoiceSetUttType",
+				  "Argument \"self\" is NULL");
+		return;
+	}
+
+	if (key == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SVoiceSetUttType",
+				  "Argument \"key\" is NULL");
+		return;
+	}
+
+	if (uttType == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SVoiceSetUttType",
+				  "Argument \"uttType\" is NULL");
+		return;
+	}
+
+	s_mutex_lock(&self->voice_mutex);
+
+	/* the cached audio was synthesized with the old utterance types */
+	clear_synth_cache(self);
+
+	SMapSetObject(self->uttTypes, key, S_OBJECT(uttType), error);
+	invalidate_utt_plans(self);
+	s_mutex_unlock(&self->voice_mutex);
+
+	S_CHK_ERR(error, S_CONTERR,
+			  "SVoiceSetUttType",
+			  "Call to \"SMapSetObject\" failed");
+}
+
+
+S_API void SVoiceDelUttType(SVoice *self, const char *key, s_erc *error)
+{
+	s_bool key_present;
+
+
+	S_CLR_ERR(error);
+
+	if (self == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SVoiceDelUttType",
+				  "Argument \"self\" is NULL");
+		return;
+	}
+
+	if (key == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "SVoiceDelUttType",
+				  "Argument \"key\" is NULL");
+		return;
+	}
+
+	s_mutex_lock(&self->voice_mutex);
+
+	/* the cached audio was synthesized with the old utterance types */
+	clear_synth_cache(self);
+
+	key_present = SMapObjectPresent(self->uttTypes, key, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "SVoiceDelUttType",
+				  "Call to \"SMapObjectPresent\" failed"))
+	{
+		s_mutex_unlock(&self->voice_mutex);
+		return;
+	}
+
+	if (key_present)
+	{
+		SMapObjectDelete(self->uttTypes, key, error);
+		invalidate_utt_plans(self);
+	}
+
+	s_mutex_unlock(&self->voice_mutex);
+	S_CHK_ERR(error, S_CONTERR,
+			  "SVoiceDelUttType",
+			  "Call to \"SMapObjectDelete\" failed");
+}
+
+
+S_LOCAL void _s_voice_load_data(SVoice *self, const SMap *dataConfig, s_erc *error)
+{
+	SIterator *itr;
+	const char *data_name;
+	const SObject *loaded;
+	const SMap *dataObjectMap;
+	s_data_info *data_info;
+	const SObject *vcfgObject;
+	char *voice_base_path;
+	const char *load_mode;
+
+
+	S_CLR_ERR(error);
+
+	if (self == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "_s_voice_load_data",
+				  "Argument \"self\" is NULL");
+		return;
+	}
+
+	/*
+	 * get voice base path, data in a voice image is identified by
+	 * the image path.
+	 */
+	vcfgObject = SVoiceGetFeature(self, "config_file", error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "_s_voice_load_data",
+				  "Call to \"SVoiceGetFeature\" failed, failed to get voice config file"))
+		return;
+
+	voice_base_path = s_get_base_path(SObjectGetString(vcfgObject, error), error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "_s_voice_load_data",
+				  "Call to \"s_get_base_path/SObjectGetString\" failed"))
+		return;
+
+	/*
+	 * now iterate through data config and load everything
+	 */
+	itr = S_ITERATOR_GET(dataConfig, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "_s_voice_load_data",
+				  "Call to \"S_ITERATOR_GET\" failed"))
+	{
+		S_DELETE(itr, "_s_voice_load_data", error);
+		S_FREE(voice_base_path);
+		return;
+	}
+
+	while (itr)
+	{
+		char *combined_path;
+
+
+		data_name = SIteratorKey(itr, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "_s_voice_load_data",
+					  "Call to \"SIteratorKey\" failed"))
+		{
+			S_DELETE(itr, "_s_voice_load_data", error);
+			S_FREE(voice_base_path);
+			return;
+		}
+
+		/*
+		 * We have already checked this cast in
+		 * _s_voice_load_dataConfig (_s_load_voice_data_config)
+		 */
+		dataObjectMap = (const SMap*)SMapGetObjectDef(dataConfig, data_name, NULL, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "_s_voice_load_data",
+					  "Call to \"SMapGetObjectDef\" for data '%s' failed",
+					  data_name))
+		{
+			S_DELETE(itr, "_s_voice_load_data", error);
+			S_FREE(voice_base_path);
+			return;
+		}
+
+		if (dataObjectMap == NULL)
+		{
+			S_CTX_ERR(error, S_CONTERR,
+					  "_s_voice_load_data",
+					  "Data object map for data '%s' in data config in NULL",
+					  data_name);
+			S_DELETE(itr, "_s_voice_load_data", error);
+			S_FREE(voice_base_path);
+			return;
+		}
+
+		data_info = get_data_info(dataObjectMap, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "_s_voice_load_data",
+					  "Call to \"get_data_info\" for data '%s' in data config failed",
+					  data_name))
+		{
+			S_DELETE(itr, "_s_voice_load_data", error);
+			S_FREE(voice_base_path);
+			return;
+		}
+
+		/* get data path, the one in the config file may be relative
+		 * to the voice base path. Data in a voice image is identified
+		 * by "<image path>#<data name>".
+		 */
+		if (self->data->image != NULL)
+			s_asprintf(&combined_path, error, "%s#%s",
+					   _s_voice_image_path(self->data->image), data_name);
+		else
+			combined_path = s_path_combine(voice_base_path, data_info->path,
+										   error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "_s_voice_load_data",
+					  "Call to \"s_asprintf/s_path_combine\" failed"))
+		{
+			S_DELETE(itr, "_s_voice_load_data", error);
+			S_FREE(voice_base_path);
+			return;
+		}
+
+		/* check if the data should be loaded lazily */
+		load_mode = SMapGetStringDef(dataObjectMap, "load", "eager", error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "_s_voice_load_data",
+					  "Call to \"SMapGetStringDef\" of key 'load' for data '%s' failed",
+					  data_name))
+		{
+			S_FREE(combined_path);
+			S_FREE(data_info);
+			S_DELETE(itr, "_s_voice_load_data", error);
+			S_FREE(voice_base_path);
+			return;
+		}
+
+		if (s_strcmp(load_mode, "lazy", error) == 0)
+		{
+			add_lazy_data_entry(self, data_name, data_info, combined_path, error);
+			S_FREE(combined_path);
+			S_FREE(data_info);
+			if (S_CHK_ERR(error, S_CONTERR,
+						  "_s_voice_load_data",
+						  "Call to \"add_lazy_data_entry\" for data '%s' failed",
+						  data_name))
+			{
+				S_DELETE(itr, "_s_voice_load_data", error);
+				S_FREE(voice_base_path);
+				return;
+			}
+
+			itr = SIteratorNext(itr);
+			continue;
+		}
+
+		if (s_strcmp(load_mode, "eager", error) != 0)
+		{
+			S_CTX_ERR(error, S_FAILURE,
+					  "_s_voice_load_data",
+					  "Unknown load mode '%s' for data '%s', expected 'eager' or 'lazy'",
+					  load_mode, data_name);
+			S_FREE(combined_path);
+			S_FREE(data_info);
+			S_DELETE(itr, "_s_voice_load_data", error);
+			S_FREE(voice_base_path);
+			return;
+		}
+
+		loaded = load_data_object(self->data->image, data_name, data_info->plugin,
+								  combined_path, data_info->format, error);
+		S_FREE(combined_path);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "_s_voice_load_data",
+					  "Call to \"load_data_object\" for data '%s' in data config failed",
+					  data_name))
+		{
+			S_FREE(data_info);
+			S_DELETE(itr, "_s_voice_load_data", error);
+			S_FREE(voice_base_path);
+			return;
+		}
+
+		S_FREE(data_info);
+
+		SMapSetObject(self->data->dataObjects, data_name, loaded, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "_s_voice_load_data",
+					  "Call to \"SMapSetObject\" for data '%s' in data config failed",
+					  data_name))
+		{
+			s_erc local_err = S_SUCCESS;
+
+
+			S_FREE(voice_base_path);
+			S_DELETE(itr, "_s_voice_load_data", error);
+			_s_vm_unload_data((SObject*)loaded, &local_err); /* error is already set */
+			return;
+		}
+
+		itr = SIteratorNext(itr);
+	}
+
+	S_FREE(voice_base_path);
+}
+
+
+S_LOCAL void _s_voice_set_image(SVoice *self, struct s_voice_image *image,
+								s_erc *error)
+{
+	S_CLR_ERR(error);
+
+	if (self == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "_s_voice_set_image",
+				  "Argument \"self\" is NULL");
+		return;
+	}
+
+	if (self->data->image != NULL)
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "_s_voice_set_image",
+				  "Voice already has a voice image");
+		return;
+	}
+
+	self->data->image = image;
+}
+
+
+S_LOCAL struct s_data_epoch *_s_voice_data_epoch_enter(const SVoice *self)
+{
+	return data_epoch_enter(self);
+}
+
+
+S_LOCAL void _s_voice_data_epoch_leave(const SVoice *self, struct s_data_epoch *epoch,
+									   s_erc *error)
+{
+	S_CLR_ERR(error);
+
+	data_epoch_leave(self, epoch, error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "_s_voice_data_epoch_leave",
+			  "Call to \"data_epoch_leave\" failed");
+}
+
+
+S_LOCAL SUttProcessor *_s_voice_acquire_utt_proc(const SVoice *self, const char *key,
+												 s_erc *error)
+{
+	SUttProcessor *uttProc;
+
+
+	S_CLR_ERR(error);
+
+	/* the utterance processor setters lock the voice */
+	s_mutex_lock((s_mutex*)&self->voice_mutex);
+	uttProc = (SUttProcessor*)SVoiceGetUttProc(self, key, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "_s_voice_acquire_utt_proc",
+				  "Call to \"SVoiceGetUttProc\" failed"))
+	{
+		s_mutex_unlock((s_mutex*)&self->voice_mutex);
+		return NULL;
+	}
+
+	if (uttProc != NULL)
+		SObjectIncRef(S_OBJECT(uttProc));
+	s_mutex_unlock((s_mutex*)&self->voice_mutex);
+
+	return uttProc;
+}
+
+
+S_LOCAL const struct s_utt_plan *_s_voice_acquire_utt_plan(const SVoice *self,
+														   const char *utt_type,
+														   s_erc *error)
+{
+	const s_utt_plan *plan;
+
+
+	S_CLR_ERR(error);
+
+	plan = acquire_utt_plan(self, utt_type, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "_s_voice_acquire_utt_plan",
+				  "Call to \"acquire_utt_plan\" failed"))
+		return NULL;
+
+	return plan;
+}
+
+
+S_LOCAL void _s_voice_release_utt_plan(const SVoice *self, const struct s_utt_plan *plan)
+{
+	release_utt_plan(self, plan);
+}
+
+
+S_LOCAL uint32 _s_voice_utt_plan_size(const struct s_utt_plan *plan)
+{
+	return plan->num_procs;
+}
+
+
+S_LOCAL const char *_s_voice_utt_plan_name(const struct s_utt_plan *plan, uint32 index)
+{
+	return plan->names[index];
+}
+
+
+S_LOCAL void _s_voice_run_utt_plan(const SVoice *self, const struct s_utt_plan *plan,
+								   SUtterance *utt, uint32 first, uint32 last,
+								   s_erc *error)
+{
+	S_CLR_ERR(error);
+
+	run_utt_plan(self, plan, utt, first, last, error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "_s_voice_run_utt_plan",
+			  "Call to \"run_utt_plan\" failed");
+}
+
+
+S_LOCAL void _s_voice_compile_utt_plans(SVoice *self, s_erc *error)
+{
+	SIterator *itr;
+	const char *utt_type;
+	s_utt_plan *plan;
+
+
+	S_CLR_ERR(error);
+
+	if (self->uttTypes == NULL)
+		return;
+
+	s_mutex_lock(&self->voice_mutex);
+	invalidate_utt_plans(self);
+
+	itr = S_ITERATOR_GET(self->uttTypes, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "_s_voice_compile_utt_plans",
+				  "Call to \"S_ITERATOR_GET\" failed"))
+	{
+		s_mutex_unlock(&self->voice_mutex);
+		return;
+	}
+
+	for (/* NOP */; itr != NULL; itr = SIteratorNext(itr))
+	{
+		utt_type = SIteratorKey(itr, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "_s_voice_compile_utt_plans",
+					  "Call to \"SIteratorKey\" failed"))
+		{
+			S_DELETE(itr, "_s_voice_compile_utt_plans", error);
+			s_mutex_unlock(&self->voice_mutex);
+			return;
+		}
+
+		plan = compile_utt_plan(self, utt_type, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "_s_voice_compile_utt_plans",
+					  "Failed to compile utterance type \'%s\'",
+					  utt_type))
+		{
+			S_DELETE(itr, "_s_voice_compile_utt_plans", error);
+			s_mutex_unlock(&self->voice_mutex);
+			return;
+		}
+
+		plan->next = self->data->plans;
+		self->data->plans = plan;
+	}
+
+	s_mutex_unlock(&self->voice_mutex);
+}
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Class registration                                                               */
+/*                                                                                  */
+/************************************************************************************/
+
+S_LOCAL void _s_voice_class_add(s_erc *error)
+{
+	S_CLR_ERR(error);
+	s_class_add(S_OBJECTCLASS(&VoiceClass), error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "_s_voice_class_add",
+			  "Failed to add SVoiceClass");
+}
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static function implementations                                                  */
+/*                                                                                  */
+/************************************************************************************/
+
+static s_data_info *get_data_info(const SMap *map, s_erc *error)
+{
+	s_data_info *data_info;
+	const char *value;
+
+
+	S_CLR_ERR(error);
+
+	data_info = S_MALLOC(s_data_info, 1);
+	if (data_info == NULL)
+	{
+		S_FTL_ERR(error, S_MEMERROR,
+				  "get_data_info",
+				  "Failed to allocate memory for 's_data_info' object");
+		return NULL;
+	}
+
+	/* format */
+	value = SMapGetStringDef(map, "format", NULL, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "get_data_info",
+				  "Call to \"SMapGetStringDef\" of key 'format' failed"))
+	{
+		S_FREE(data_info);
+		return NULL;
+	}
+
+	if (value == NULL)
+	{
+		S_CTX_ERR(error, S_CONTERR,
+				  "get_data_info",
+				  "Value of key 'format' is NULL");
+		S_FREE(data_info);
+		return NULL;
+	}
+
+	data_info->format = value;
+
+	/* plug-in */
+	value = SMapGetStringDef(map, "plug-in", NULL, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "get_data_info",
+				  "Call to \"SMapGetStringDef\" of key 'plug-in' failed"))
+	{
+		S_FREE(data_info);
+		return NULL;
+	}
+
+	if (value == NULL)
+	{
+		S_CTX_ERR(error, S_CONTERR,
+				  "get_data_info",
+				  "Value of key 'plug-in' is NULL");
+		S_FREE(data_info);
+		return NULL;
+	}
+
+	data_info->plugin = value;
+
+	/* path */
+	value = SMapGetStringDef(map, "path", NULL, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "get_data_info",
+				  "Call to \"SMapGetStringDef\" of key 'path' failed"))
+	{
+		S_FREE(data_info);
+		return NULL;
+	}
+
+	if (value == NULL)
+	{
+		S_CTX_ERR(error, S_CONTERR,
+				  "get_data_info",
+				  "Value of key 'path' is NULL");
+		S_FREE(data_info);
+		return NULL;
+	}
+
+	data_info->path = value;
+
+	return data_info;
+}
+
+
+static void unload_data_entry(SVoice *self, const char *data_name, s_erc *error)
+{
+	SObject *toUnload;
+
+
+	S_CLR_ERR(error);
+
+	s_mutex_lock(&self->data->data_mutex);
+	toUnload = SMapObjectUnlink(self->data->dataObjects, data_name, error);
+	self->data->generation++;
+	s_mutex_unlock(&self->data->data_mutex);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "unload_data_entry",
+				  "Call to \"SMapObjectUnlink\" failed"))
+		return;
+
+	retire_data_object(self, toUnload, FALSE, error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "unload_data_entry",
+			  "Call to \"retire_data_object\" failed");
+}
+
+
+/*
+ * Unload a data object that has already been unlinked from the
+ * voice. Syntheses in flight may still use it, in which case it is
+ * retired at the end of the current epoch (as in SVoiceReloadData).
+ * If voice_object is TRUE the object is a voice feature or feature
+ * processor, which is deleted and not unloaded. Data mutex must not
+ * be locked by caller.
+ */
+static void retire_data_object(SVoice *self, SObject *dataObject, s_bool voice_object,
+							   s_erc *error)
+{
+	s_retired_data *retired;
+	s_retired_data *reclaimed;
+	s_data_epoch *epoch;
+	s_erc local_err = S_SUCCESS;
+
+
+	S_CLR_ERR(error);
+
+	if (dataObject == NULL)
+		return;
+
+	retired = S_CALLOC(s_retired_data, 1);
+	epoch = S_CALLOC(s_data_epoch, 1);
+
+	/* the epochs are gone when the voice is being destroyed */
+	s_mutex_lock(&self->data->data_mutex);
+	if ((self->data->epoch != NULL)
+		&& ((self->data->epochs != self->data->epoch)
+			|| (self->data->epoch->readers > 0)))
+	{
+		if ((retired == NULL) || (epoch == NULL))
+		{
+			s_mutex_unlock(&self->data->data_mutex);
+			if (retired != NULL)
+				S_FREE(retired);
+			if (epoch != NULL)
+				S_FREE(epoch);
+
+			/* leak it rather than pull it from under the syntheses */
+			S_FTL_ERR(error, S_MEMERROR,
+					  "retire_data_object",
+					  "Failed to allocate memory for data epoch");
+			return;
+		}
+
+		retired->object = dataObject;
+		retired->voice_object = voice_object;
+		retired->next = self->data->epoch->retired;
+		self->data->epoch->retired = retired;
+		self->data->epoch->next = epoch;
+		self->data->epoch = epoch;
+		dataObject = NULL;
+		retired = NULL;
+		epoch = NULL;
+	}
+
+	reclaimed = reclaim_retired_data(self);
+	s_mutex_unlock(&self->data->data_mutex);
+
+	if (retired != NULL)
+		S_FREE(retired);
+
+	if (epoch != NULL)
+		S_FREE(epoch);
+
+	/* no syntheses in flight, unload now */
+	if ((dataObject != NULL) && voice_object)
+	{
+		S_DELETE(dataObject, "retire_data_object", error);
+	}
+	else if (dataObject != NULL)
+	{
+		unload_data_object(dataObject, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "retire_data_object",
+					  "Call to \"unload_data_object\" failed"))
+		{
+			unload_retired_data(reclaimed, &local_err);
+			return;
+		}
+	}
+
+	unload_retired_data(reclaimed, error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "retire_data_object",
+			  "Call to \"unload_retired_data\" failed");
+}
+
+
+static void unload_data_object(SObject *dataObject, s_erc *error)
+{
+	s_bool data_loaded;
+
+
+	S_CLR_ERR(error);
+
+	/*
+	 * check if the data object was loaded with
+	 * the VoiceManager.
+	 */
+	data_loaded = _s_vm_data_loaded(dataObject, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "unload_data_object",
+				  "Call to \"_s_vm_data_loaded\" failed"))
+		return;
+
+	if (data_loaded)
+	{
+		_s_vm_unload_data(dataObject, error);
+		S_CHK_ERR(error, S_CONTERR,
+				  "unload_data_object",
+				  "Call to \"_s_vm_unload_data\" failed");
+	}
+	else
+	{
+		/*
+		 * just do a delete, the VoiceManager does not have a handle
+		 * on this data object
+		 */
+		S_DELETE(dataObject, "unload_data_object", error);
+	}
+}
+
+
+/*
+ * Unlink the object of the given key from a voice map (the features
+ * or the feature processors), so that it can be retired. Returns NULL
+ * if the key is not in the map. Voice mutex must be locked by caller.
+ */
+static SObject *unlink_voice_object(SMap *map, const char *key, s_erc *error)
+{
+	SObject *object;
+	s_bool key_present;
+
+
+	S_CLR_ERR(error);
+
+	key_present = SMapObjectPresent(map, key, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "unlink_voice_object",
+				  "Call to \"SMapObjectPresent\" failed"))
+		return NULL;
+
+	if (!key_present)
+		return NULL;
+
+	object = SMapObjectUnlink(map, key, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "unlink_voice_object",
+				  "Call to \"SMapObjectUnlink\" failed"))
+		return NULL;
+
+	return object;
+}
+
+
+static void add_lazy_data_entry(SVoice *self, const char *data_name,
+								const s_data_info *data_info,
+								const char *path, s_erc *error)
+{
+	s_lazy_data *entry;
+
+
+	S_CLR_ERR(error);
+
+	entry = S_CALLOC(s_lazy_data, 1);
+	if (entry == NULL)
+	{
+		S_FTL_ERR(error, S_MEMERROR,
+				  "add_lazy_data_entry",
+				  "Failed to allocate memory for 's_lazy_data' object");
+		return;
+	}
+
+	s_mutex_init(&entry->load_mutex);
+
+	entry->name = s_strdup(data_name, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "add_lazy_data_entry",
+				  "Call to \"s_strdup\" failed"))
+	{
+		free_lazy_data_entry(entry, error);
+		return;
+	}
+
+	entry->format = s_strdup(data_info->format, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "add_lazy_data_entry",
+				  "Call to \"s_strdup\" failed"))
+	{
+		free_lazy_data_entry(entry, error);
+		return;
+	}
+
+	entry->plugin = s_strdup(data_info->plugin, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "add_lazy_data_entry",
+				  "Call to \"s_strdup\" failed"))
+	{
+		free_lazy_data_entry(entry, error);
+		return;
+	}
+
+	entry->path = s_strdup(path, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "add_lazy_data_entry",
+				  "Call to \"s_strdup\" failed"))
+	{
+		free_lazy_data_entry(entry, error);
+		return;
+	}
+
+	entry->image = self->data->image;
+
+	/* append, keeping the order of the data configuration */
+	s_mutex_lock(&self->data->data_mutex);
+	if (self->data->lazy == NULL)
+	{
+		self->data->lazy = entry;
+	}
+	else
+	{
+		s_lazy_data *tail;
+
+
+		for (tail = self->data->lazy; tail->next != NULL; tail = tail->next)
+			; /* NOP */
+
+		tail->next = entry;
+	}
+	s_mutex_unlock(&self->data->data_mutex);
+}
+
+
+/* data mutex must be locked by caller */
+static s_lazy_data *find_lazy_data_entry(const SVoice *self, const char *data_name)
+{
+	s_lazy_data *entry;
+	s_erc local_err = S_SUCCESS;
+
+
+	for (entry = self->data->lazy; entry != NULL; entry = entry->next)
+	{
+		if (s_strcmp(entry->name, data_name, &local_err) == 0)
+			return entry;
+	}
+
+	return NULL;
+}
+
+
+/*
+ * Load the entry if it is not loaded yet, and return the loaded data
+ * object. Returns NULL without an error if the entry was removed from
+ * the voice. The caller must hold a use of the entry (see users) and
+ * must not hold the data mutex.
+ */
+static const SObject *load_lazy_data_entry(const SVoice *self, s_lazy_data *entry,
+										   s_erc *error)
+{
+	const SObject *loaded;
+	SObject *discard = NULL;
+	s_bool removed;
+
+
+	S_CLR_ERR(error);
+
+	/* concurrent loads of the same entry wait here for the first one */
+	s_mutex_lock(&entry->load_mutex);
+
+	s_mutex_lock((s_mutex*)&self->data->data_mutex);
+	removed = entry->removed;
+	loaded = entry->loaded;
+	s_mutex_unlock((s_mutex*)&self->data->data_mutex);
+
+	if ((loaded != NULL) || removed)
+	{
+		s_mutex_unlock(&entry->load_mutex);
+		return loaded;
+	}
+
+	S_DEBUG(S_DBG_INFO,
+			"loading lazy voice data \'%s\' ...",
+			entry->name);
+
+	loaded = load_data_object(entry->image, entry->name, entry->plugin,
+							  entry->path, entry->format, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "load_lazy_data_entry",
+				  "Call to \"load_data_object\" for data '%s' failed",
+				  entry->name))
+	{
+		s_mutex_unlock(&entry->load_mutex);
+		return NULL;
+	}
+
+	/*
+	 * publish, unless the entry was removed or reloaded while we were
+	 * loading it.
+	 */
+	s_mutex_lock((s_mutex*)&self->data->data_mutex);
+	if (entry->removed || (entry->loaded != NULL))
+	{
+		discard = (SObject*)loaded;
+		loaded = entry->removed? NULL : entry->loaded;
+	}
+	else
+	{
+		entry->loaded = loaded;
+	}
+	s_mutex_unlock((s_mutex*)&self->data->data_mutex);
+
+	s_mutex_unlock(&entry->load_mutex);
+
+	if (discard != NULL)
+	{
+		s_erc local_err = S_SUCCESS;
+
+
+		unload_data_object(discard, &local_err);
+		S_CHK_ERR(&local_err, S_CONTERR,
+				  "load_lazy_data_entry",
+				  "Call to \"unload_data_object\" for data '%s' failed",
+				  entry->name); /* just log it */
+	}
+
+	return loaded;
+
+	S_UNUSED(self); /* if threads are not enabled */
+}
+
+
+/*
+ * Release a use of the entry taken for load_lazy_data_entry, the
+ * last use of a removed entry frees it.
+ */
+static void release_lazy_data_entry(const SVoice *self, s_lazy_data *entry)
+{
+	s_bool free_entry;
+	s_erc local_err = S_SUCCESS;
+
+
+	s_mutex_lock((s_mutex*)&self->data->data_mutex);
+	entry->users--;
+	free_entry = (entry->removed && (entry->users == 0));
+	s_mutex_unlock((s_mutex*)&self->data->data_mutex);
+
+	if (!free_entry)
+		return;
+
+	free_lazy_data_entry(entry, &local_err);
+	S_CHK_ERR(&local_err, S_CONTERR,
+			  "release_lazy_data_entry",
+			  "Call to \"free_lazy_data_entry\" failed"); /* just log it */
+
+	S_UNUSED(self); /* if threads are not enabled */
+}
+
+
+static void unload_lazy_data_entry(SVoice *self, const char *data_name, s_erc *error)
+{
+	s_lazy_data *entry;
+	s_lazy_data *prev = NULL;
+	SObject *loaded;
+	s_erc local_err = S_SUCCESS;
+
+
+	S_CLR_ERR(error);
+
+	s_mutex_lock(&self->data->data_mutex);
+	for (entry = self->data->lazy; entry != NULL; entry = entry->next)
+	{
+		if (s_strcmp(entry->name, data_name, &local_err) == 0)
+			break;
+
+		prev = entry;
+	}
+
+	if (entry == NULL)
+	{
+		s_mutex_unlock(&self->data->data_mutex);
+		return;
+	}
+
+	if (prev == NULL)
+		self->data->lazy = entry->next;
+	else
+		prev->next = entry->next;
+	self->data->generation++;
+	loaded = (SObject*)entry->loaded;
+	entry->loaded = NULL;
+	entry->removed = TRUE;
+
+	/* an entry that is being loaded is freed by its last user */
+	if (entry->users > 0)
+		entry = NULL;
+	s_mutex_unlock(&self->data->data_mutex);
+
+	if (entry != NULL)
+	{
+		free_lazy_data_entry(entry, &local_err);
+		S_CHK_ERR(&local_err, S_CONTERR,
+				  "unload_lazy_data_entry",
+				  "Call to \"free_lazy_data_entry\" failed");
+	}
+
+	retire_data_object(self, loaded, FALSE, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "unload_lazy_data_entry",
+				  "Call to \"retire_data_object\" failed"))
+		return;
+
+	if (local_err != S_SUCCESS)
+		*error = local_err;
+}
+
+
+static void free_lazy_data_entry(s_lazy_data *entry, s_erc *error)
+{
+	S_CLR_ERR(error);
+
+	if (entry->loaded != NULL)
+	{
+		unload_data_object((SObject*)entry->loaded, error);
+		S_CHK_ERR(error, S_CONTERR,
+				  "free_lazy_data_entry",
+				  "Call to \"unload_data_object\" for data '%s' failed",
+				  entry->name);
+	}
+
+	if (entry->name != NULL)
+		S_FREE(entry->name);
+
+	if (entry->format != NULL)
+		S_FREE(entry->format);
+
+	if (entry->plugin != NULL)
+		S_FREE(entry->plugin);
+
+	if (entry->path != NULL)
+		S_FREE(entry->path);
+
+	s_mutex_destroy(&entry->load_mutex);
+	S_FREE(entry);
+}
+
+
+static const SObject *load_data_object(const s_voice_image *image, const char *data_name,
+									   const char *plugin, const char *path,
+									   const char *format, s_erc *error)
+{
+	SDatasource *ds;
+	const SObject *loaded;
+
+
+	S_CLR_ERR(error);
+
+	if (image == NULL)
+	{
+		loaded = _s_vm_load_data(plugin, path, format, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "load_data_object",
+					  "Call to \"_s_vm_load_data\" failed"))
+			return NULL;
+
+		return loaded;
+	}
+
+	/* the image may store the data in another format */
+	ds = _s_voice_image_data_source(image, data_name, &format, &plugin, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "load_data_object",
+				  "Call to \"_s_voice_image_data_source\" failed"))
+		return NULL;
+
+	/* takes hold of ds */
+	loaded = _s_vm_load_data_from_source(plugin, path, ds, format, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "load_data_object",
+				  "Call to \"_s_vm_load_data_from_source\" failed"))
+		return NULL;
+
+	return loaded;
+}
+
+
+static SObject *reload_data_object(SVoice *self, const char *data_name, s_erc *error)
+{
+	const SObject *vcfgObject;
+	const char *config_file;
+	SMap *voiceConfig = NULL;
+	SMap *dataConfig = NULL;
+	const SMap *dataObjectMap;
+	s_data_info *data_info = NULL;
+	char *voice_base_path = NULL;
+	char *combined_path = NULL;
+	SPlugin *dataPlugin = NULL;
+	SObject *dataObject = NULL;
+
+
+	S_CLR_ERR(error);
+
+	if (self->data->image != NULL)
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "reload_data_object",
+				  "Data of a precompiled voice image can not be reloaded, "
+				  "recompile the voice image instead");
+		return NULL;
+	}
+
+	/* read the data configuration again, it may have changed */
+	vcfgObject = SVoiceGetFeature(self, "config_file", error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "reload_data_object",
+				  "Call to \"SVoiceGetFeature\" failed, failed to get voice config file"))
+		return NULL;
+
+	config_file = SObjectGetString(vcfgObject, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "reload_data_object",
+				  "Call to \"SObjectGetString\" failed"))
+		return NULL;
+
+	voiceConfig = s_json_parse_config_file(config_file, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "reload_data_object",
+				  "Call to \"s_json_parse_config_file\" failed for voice config file '%s'",
+				  config_file))
+		goto quit;
+
+	dataConfig = _s_load_voice_data_config(voiceConfig, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "reload_data_object",
+				  "Call to \"_s_load_voice_data_config\" failed"))
+		goto quit;
+
+	dataObjectMap = (const SMap*)SMapGetObjectDef(dataConfig, data_name, NULL, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "reload_data_object",
+				  "Call to \"SMapGetObjectDef\" for data '%s' failed",
+				  data_name))
+		goto quit;
+
+	if (dataObjectMap == NULL)
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "reload_data_object",
+				  "Voice config file '%s' does not define data '%s'",
+				  config_file, data_name);
+		goto quit;
+	}
+
+	data_info = get_data_info(dataObjectMap, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "reload_data_object",
+				  "Call to \"get_data_info\" for data '%s' failed",
+				  data_name))
+		goto quit;
+
+	voice_base_path = s_get_base_path(config_file, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "reload_data_object",
+				  "Call to \"s_get_base_path\" failed"))
+		goto quit;
+
+	combined_path = s_path_combine(voice_base_path, data_info->path, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "reload_data_object",
+				  "Call to \"s_path_combine\" failed"))
+		goto quit;
+
+	/*
+	 * Not loaded through the VoiceManager, its cache would return
+	 * the object we are replacing. The voice keeps a reference to
+	 * the plug-in for as long as it has the data object.
+	 */
+	dataPlugin = s_pm_load_plugin(data_info->plugin, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "reload_data_object",
+				  "Call to \"s_pm_load_plugin\" failed of data plug-in at '%s'",
+				  data_info->plugin))
+		goto quit;
+
+	dataObject = SObjectLoad(combined_path, data_info->format, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "reload_data_object",
+				  "Call to \"SObjectLoad\" failed for data at path '%s'",
+				  combined_path))
+		goto quit;
+
+	s_mutex_lock(&self->data->data_mutex);
+	if (self->data->plugins == NULL)
+	{
+		self->data->plugins = S_LIST(S_NEW(SListList, error));
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "reload_data_object",
+					  "Failed to create new list for data plug-ins"))
+			self->data->plugins = NULL;
+	}
+
+	if (self->data->plugins != NULL)
+	{
+		SListAppend(self->data->plugins, S_OBJECT(dataPlugin), error);
+		if (!S_CHK_ERR(error, S_CONTERR,
+					   "reload_data_object",
+					   "Call to \"SListAppend\" failed"))
+			dataPlugin = NULL; /* list has it */
+	}
+	s_mutex_unlock(&self->data->data_mutex);
+
+	if (*error != S_SUCCESS)
+		S_DELETE(dataObject, "reload_data_object", error);
+
+	/* normal exit and errors clean up code here */
+quit:
+	if (dataPlugin != NULL)
+		S_DELETE(dataPlugin, "reload_data_object", error);
+
+	if (combined_path != NULL)
+		S_FREE(combined_path);
+
+	if (voice_base_path != NULL)
+		S_FREE(voice_base_path);
+
+	if (data_info != NULL)
+		S_FREE(data_info);
+
+	if (dataConfig != NULL)
+		S_DELETE(dataConfig, "reload_data_object", error);
+
+	if (voiceConfig != NULL)
+		S_DELETE(voiceConfig, "reload_data_object", error);
+
+	if (*error != S_SUCCESS)
+		return NULL;
+
+	return dataObject;
+}
+
+
+static s_data_epoch *data_epoch_enter(const SVoice *self)
+{
+	s_data_epoch *epoch;
+
+
+	s_mutex_lock((s_mutex*)&self->data->data_mutex);
+	epoch = self->data->epoch;
+	epoch->readers++;
+	s_mutex_unlock((s_mutex*)&self->data->data_mutex);
+
+	return epoch;
+}
+
+
+static void data_epoch_leave(const SVoice *self, s_data_epoch *epoch, s_erc *error)
+{
+	s_retired_data *reclaimed;
+
+
+	S_CLR_ERR(error);
+
+	s_mutex_lock((s_mutex*)&self->data->data_mutex);
+	epoch->readers--;
+	reclaimed = reclaim_retired_data(self);
+	s_mutex_unlock((s_mutex*)&self->data->data_mutex);
+
+	/* unload outside of the data mutex, it locks the VoiceManager */
+	unload_retired_data(reclaimed, error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "data_epoch_leave",
+			  "Call to \"unload_retired_data\" failed");
+}
+
+
+/*
+ * data mutex must be locked by caller. Pops the old epochs without
+ * readers and returns their retired data objects.
+ */
+static s_retired_data *reclaim_retired_data(const SVoice *self)
+{
+	s_data_epoch *oldest;
+	s_retired_data *reclaimed = NULL;
+	s_retired_data *tail;
+
+
+	while ((self->data->epochs != self->data->epoch)
+		   && (self->data->epochs->readers == 0))
+	{
+		oldest = self->data->epochs;
+		self->data->epochs = oldest->next;
+
+		if (oldest->retired != NULL)
+		{
+			for (tail = oldest->retired; tail->next != NULL; tail = tail->next)
+				; /* NOP */
+
+			tail->next = reclaimed;
+			reclaimed = oldest->retired;
+		}
+
+		S_FREE(oldest);
+	}
+
+	return reclaimed;
+}
+
+
+static void unload_retired_data(s_retired_data *retired, s_erc *error)
+{
+	s_retired_data *next;
+	s_erc local_err;
+
+
+	S_CLR_ERR(error);
+
+	/* unload all, report the first error */
+	while (retired != NULL)
+	{
+		next = retired->next;
+
+		S_CLR_ERR(&local_err);
+		if (retired->voice_object)
+			S_DELETE(retired->object, "unload_retired_data", &local_err);
+		else
+			unload_data_object(retired->object, &local_err);
+		if (S_CHK_ERR(&local_err, S_CONTERR,
+					  "unload_retired_data",
+					  "Call to \"unload_data_object\" failed")
+			&& (*error == S_SUCCESS))
+			*error = local_err;
+
+		S_FREE(retired);
+		retired = next;
+	}
+}
+
+
+static void free_voice_info(s_voice_info *info)
+{
+	if (info != NULL)
+	{
+		if (info->name != NULL)
+			S_FREE(info->name);
+
+		if (info->description != NULL)
+			S_FREE(info->description);
+
+		if (info->gender != NULL)
+			S_FREE(info->gender);
+
+		if (info->language != NULL)
+			S_FREE(info->language);
+
+		if (info->lang_code != NULL)
+			S_FREE(info->lang_code);
+
+		S_FREE(info);
+	}
+}
+
+
+static void unload_voice_plugins(SList *plugins, s_erc *error)
+{
+	SIterator *itr;
+	SObject *plugin;
+
+
+	S_CLR_ERR(error);
+
+	itr = S_ITERATOR_GET(plugins, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "unload_voice_plugins",
+				  "Call to \"S_ITERATOR_GET\" failed"))
+		return;
+
+	while (itr != NULL)
+	{
+		plugin = SIteratorUnlink(itr, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "unload_voice_plugins",
+					  "Call to \"SIteratorUnlink\" failed"))
+		{
+			S_DELETE(itr, "unload_voice_plugins", error);
+			return;
+		}
+
+
+		S_DELETE(plugin, "unload_voice_plugins", error);
+		itr = SIteratorNext(itr);
+	}
+
+	S_DELETE(plugins, "unload_voice_plugins", error);
+}
+
+
+/* must be called with the voice mutex locked */
+static s_utt_plan *compile_utt_plan(const SVoice *self, const char *utt_type,
+									s_erc *error)
+{
+	const SList *uttType;
+	const SObject *tmp;
+	s_utt_plan *plan;
+	SIterator *itr;
+	uint32 i;
+
+
+	S_CLR_ERR(error);
+
+	uttType = SVoiceGetUttType(self, utt_type, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "compile_utt_plan",
+				  "Call to \"SVoiceGetUttType\" failed"))
+		return NULL;
+
+	if (uttType == NULL)
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "compile_utt_plan",
+				  "Given voice does not have a \'%s\' utterance type",
+				  utt_type);
+		return NULL;
+	}
+
+	plan = S_CALLOC(s_utt_plan, 1);
+	if (plan == NULL)
+	{
+		S_FTL_ERR(error, S_MEMERROR,
+				  "compile_utt_plan",
+				  "Failed to allocate memory for 's_utt_plan' object");
+		return NULL;
+	}
+
+	plan->utt_type = s_strdup(utt_type, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "compile_utt_plan",
+				  "Call to \"s_strdup\" failed"))
+	{
+		free_utt_plan(plan);
+		return NULL;
+	}
+
+	plan->num_procs = (uint32)SListSize(uttType, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "compile_utt_plan",
+				  "Call to \"SListSize\" failed"))
+	{
+		free_utt_plan(plan);
+		return NULL;
+	}
+
+	if (plan->num_procs == 0)
+		return plan;
+
+	plan->procs = S_CALLOC(const SUttProcessor*, plan->num_procs);
+	plan->names = S_CALLOC(char*, plan->num_procs);
+	plan->stats = S_CALLOC(s_utt_proc_timing*, plan->num_procs);
+	if ((plan->procs == NULL) || (plan->names == NULL) || (plan->stats == NULL))
+	{
+		S_FTL_ERR(error, S_MEMERROR,
+				  "compile_utt_plan",
+				  "Failed to allocate memory for utterance processors");
+		free_utt_plan(plan);
+		return NULL;
+	}
+
+	itr = S_ITERATOR_GET(uttType, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "compile_utt_plan",
+				  "Call to \"S_ITERATOR_GET\" failed"))
+	{
+		free_utt_plan(plan);
+		return NULL;
+	}
+
+	for (i = 0; (itr != NULL) && (i < plan->num_procs); itr = SIteratorNext(itr), i++)
+	{
+		plan->names[i] = s_strdup(SObjectGetString(SIteratorObject(itr, error), error),
+								  error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "compile_utt_plan",
+					  "Failed to get utterance processor name"))
+		{
+			S_DELETE(itr, "compile_utt_plan", error);
+			free_utt_plan(plan);
+			return NULL;
+		}
+
+		/*
+		 * an undefined utterance processor is only an error when
+		 * the utterance type is run, as before plans
+		 */
+		tmp = SMapGetObjectDef(self->uttProcessors, plan->names[i], NULL, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "compile_utt_plan",
+					  "Call to \"SMapGetObjectDef\" failed"))
+		{
+			S_DELETE(itr, "compile_utt_plan", error);
+			free_utt_plan(plan);
+			return NULL;
+		}
+
+		/*
+		 * the plan holds a reference, a stale plan still being run
+		 * keeps the utterance processors it was compiled with when
+		 * they are replaced or deleted from the voice
+		 */
+		plan->procs[i] = S_UTTPROCESSOR(tmp);
+		if (tmp != NULL)
+			SObjectIncRef((SObject*)tmp);
+
+		plan->stats[i] = get_timing_stats(self, plan->names[i], error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "compile_utt_plan",
+					  "Call to \"get_timing_stats\" failed"))
+		{
+			S_DELETE(itr, "compile_utt_plan", error);
+			free_utt_plan(plan);
+			return NULL;
+		}
+	}
+
+	if (itr != NULL)
+		S_DELETE(itr, "compile_utt_plan", error);
+
+	return plan;
+}
+
+
+static const s_utt_plan *acquire_utt_plan(const SVoice *self, const char *utt_type,
+										  s_erc *error)
+{
+	s_utt_plan *plan;
+
+
+	S_CLR_ERR(error);
+
+	s_mutex_lock((s_mutex*)&self->voice_mutex);
+
+	for (plan = self->data->plans; plan != NULL; plan = plan->next)
+	{
+		if (s_strcmp(plan->utt_type, utt_type, error) == 0)
+			break;
+	}
+
+	if (plan == NULL)
+	{
+		plan = compile_utt_plan(self, utt_type, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "acquire_utt_plan",
+					  "Call to \"compile_utt_plan\" failed"))
+		{
+			s_mutex_unlock((s_mutex*)&self->voice_mutex);
+			return NULL;
+		}
+
+		plan->next = self->data->plans;
+		self->data->plans = plan;
+	}
+
+	plan->users++;
+	s_mutex_unlock((s_mutex*)&self->voice_mutex);
+
+	return plan;
+}
+
+
+static void release_utt_plan(const SVoice *self, const s_utt_plan *plan)
+{
+	s_utt_plan *tmp = (s_utt_plan*)plan;
+
+
+	S_UNUSED(self); /* without threads support there is no mutex */
+	s_mutex_lock((s_mutex*)&self->voice_mutex);
+	tmp->users--;
+	if (tmp->stale && (tmp->users == 0))
+		free_utt_plan(tmp);
+	s_mutex_unlock((s_mutex*)&self->voice_mutex);
+}
+
+
+/*
+ * Run the utterance processors [first, last) of the plan, so that
+ * executors running parts of a plan (see SSynthPipeline) get the same
+ * cancellation checks, timings and tracing.
+ */
+static void run_utt_plan(const SVoice *self, const s_utt_plan *plan,
+						 SUtterance *utt, uint32 first, uint32 last,
+						 s_erc *error)
+{
+	const SCancelToken *cancel;
+	uint32 i;
+
+
+	S_CLR_ERR(error);
+
+	cancel = SCancelTokenGetFromUtt(utt, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "run_utt_plan",
+				  "Call to \"SCancelTokenGetFromUtt\" failed"))
+		return;
+
+	if (self->data->timings)
+	{
+		run_utt_plan_timed(self, plan, utt, cancel, first, last, error);
+		return;
+	}
+
+	for (i = first; i < last; i++)
+	{
+		if (plan->procs[i] == NULL)
+		{
+			S_CTX_ERR(error, S_FAILURE,
+					  "run_utt_plan",
+					  "Utterance processor \'%s\' not defined",
+					  plan->names[i]);
+			return;
+		}
+
+		SCancelTokenCheck(cancel, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "run_utt_plan",
+					  "Synthesis stopped before utterance processor \'%s\'",
+					  plan->names[i]))
+			return;
+
+		S_DEBUG(S_DBG_INFO,
+				"executing \'%s\' utterance processor ...",
+				plan->names[i]);
+
+		S_TRACE_BEGIN("uttproc", plan->names[i]);
+		SUttProcessorRun(plan->procs[i], utt, error);
+		S_TRACE_END("uttproc", plan->names[i]);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "run_utt_plan",
+					  "Execution of utterance processor \'%s\' failed",
+					  plan->names[i]))
+			return;
+	}
+}
+
+
+/* must be called with the voice mutex locked */
+static void invalidate_utt_plans(const SVoice *self)
+{
+	s_utt_plan *plan;
+
+
+	while (self->data->plans != NULL)
+	{
+		plan = self->data->plans;
+		self->data->plans = plan->next;
+
+		/* plans still being run are freed by their last user */
+		if (plan->users == 0)
+			free_utt_plan(plan);
+		else
+			plan->stale = TRUE;
+	}
+}
+
+
+/* must be called with the voice mutex locked */
+static void free_utt_plan(s_utt_plan *plan)
+{
+	uint32 i;
+
+
+	if (plan->names != NULL)
+	{
+		for (i = 0; i < plan->num_procs; i++)
+		{
+			if (plan->names[i] != NULL)
+				S_FREE(plan->names[i]);
+		}
+
+		S_FREE(plan->names);
+	}
+
+	if (plan->procs != NULL)
+	{
+		s_erc local_err = S_SUCCESS;
+
+
+		for (i = 0; i < plan->num_procs; i++)
+		{
+			if (plan->procs[i] != NULL)
+				S_DELETE(plan->procs[i], "free_utt_plan", &local_err);
+		}
+
+		S_FREE(plan->procs);
+	}
+
+	if (plan->stats != NULL)
+		S_FREE(plan->stats);
+
+	if (plan->utt_type != NULL)
+		S_FREE(plan->utt_type);
+
+	S_FREE(plan);
+}
+
+
+/* get the timing statistics entry of an utterance processor, or add it */
+static s_utt_proc_timing *get_timing_stats(const SVoice *self, const char *name,
+										   s_erc *error)
+{
+	s_utt_proc_timing *stats;
+
+
+	S_CLR_ERR(error);
+
+	s_mutex_lock((s_mutex*)&self->data->timings_mutex);
+	for (stats = self->data->timing_stats; stats != NULL; stats = stats->next)
+	{
+		if (s_strcmp(stats->name, name, error) == 0)
+		{
+			s_mutex_unlock((s_mutex*)&self->data->timings_mutex);
+			return stats;
+		}
+	}
+
+	stats = S_CALLOC(s_utt_proc_timing, 1);
+	if (stats == NULL)
+	{
+		S_FTL_ERR(error, S_MEMERROR,
+				  "get_timing_stats",
+				  "Failed to allocate memory for 's_utt_proc_timing' object");
+		s_mutex_unlock((s_mutex*)&self->data->timings_mutex);
+		return NULL;
+	}
+
+	stats->name = s_strdup(name, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "get_timing_stats",
+				  "Call to \"s_strdup\" failed"))
+	{
+		S_FREE(stats);
+		s_mutex_unlock((s_mutex*)&self->data->timings_mutex);
+		return NULL;
+	}
+
+	stats->next = self->data->timing_stats;
+	self->data->timing_stats = stats;
+	s_mutex_unlock((s_mutex*)&self->data->timings_mutex);
+
+	return stats;
+}
+
+
+static void run_utt_plan_timed(const SVoice *self, const s_utt_plan *plan,
+							   SUtterance *utt, const SCancelToken *cancel,
+							   uint32 first, uint32 last, s_erc *error)
+{
+	s_erc local_err = S_SUCCESS;
+	s_stage_timing *stages = NULL;
+	uint32 num_stages = 0;
+	double wall;
+	double cpu;
+	ulong allocs;
+	ulong bytes;
+	uint32 i;
+
+
+	S_CLR_ERR(error);
+
+	if (last > first)
+	{
+		stages = S_CALLOC(s_stage_timing, last - first);
+		if (stages == NULL)
+		{
+			S_FTL_ERR(error, S_MEMERROR,
+					  "run_utt_plan_timed",
+					  "Failed to allocate memory for 's_stage_timing' object");
+			return;
+		}
+	}
+
+	for (i = first; i < last; i++)
+	{
+		if (plan->procs[i] == NULL)
+		{
+			S_CTX_ERR(error, S_FAILURE,
+					  "run_utt_plan_timed",
+					  "Utterance processor \'%s\' not defined",
+					  plan->names[i]);
+			break;
+		}
+
+		SCancelTokenCheck(cancel, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "run_utt_plan_timed",
+					  "Synthesis stopped before utterance processor \'%s\'",
+					  plan->names[i]))
+			break;
+
+		S_DEBUG(S_DBG_INFO,
+				"executing \'%s\' utterance processor ...",
+				plan->names[i]);
+
+		allocs = _s_alloc_count();
+		bytes = _s_alloc_bytes();
+		cpu = s_time_thread_cpu(&local_err);
+		wall = s_time_monotonic(&local_err);
+
+		S_TRACE_BEGIN("uttproc", plan->names[i]);
+		SUttProcessorRun(plan->procs[i], utt, error);
+		S_TRACE_END("uttproc", plan->names[i]);
+
+		stages[num_stages].wall = s_time_monotonic(&local_err) - wall;
+		stages[num_stages].cpu = s_time_thread_cpu(&local_err) - cpu;
+		stages[num_stages].allocs = _s_alloc_count() - allocs;
+		stages[num_stages].bytes = _s_alloc_bytes() - bytes;
+		num_stages++;
+
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "run_utt_plan_timed",
+					  "Execution of utterance processor \'%s\' failed",
+					  plan->names[i]))
+			break;
+	}
+
+	record_timings(self, plan, first, stages, num_stages);
+
+	/* the utterance processors that were run, even if one failed */
+	add_timings_feature(utt, plan, first, stages, num_stages, &local_err);
+	S_CHK_ERR(&local_err, S_CONTERR,
+			  "run_utt_plan_timed",
+			  "Call to \"add_timings_feature\" failed");
+
+	if (stages != NULL)
+		S_FREE(stages);
+}
+
+
+static void record_timings(const SVoice *self, const s_utt_plan *plan, uint32 first,
+						   const s_stage_timing *stages, uint32 num_stages)
+{
+	s_utt_proc_timing *stats;
+	uint32 i;
+
+
+	S_UNUSED(self); /* only for the mutex */
+	s_mutex_lock((s_mutex*)&self->data->timings_mutex);
+	for (i = 0; i < num_stages; i++)
+	{
+		stats = plan->stats[first + i];
+		stats->count++;
+		stats->wall += stages[i].wall;
+		stats->cpu += stages[i].cpu;
+		stats->allocs += stages[i].allocs;
+		stats->bytes += stages[i].bytes;
+		stats->buckets[timing_bucket(stages[i].wall)]++;
+	}
+	s_mutex_unlock((s_mutex*)&self->data->timings_mutex);
+}
+
+
+/*
+ * Add the timings of the utterance processors [first, first +
+ * num_stages) of the plan to the utterance 'timings' feature, the
+ * feature is started at the first utterance processor of the plan.
+ */
+static void add_timings_feature(SUtterance *utt, const s_utt_plan *plan, uint32 first,
+								const s_stage_timing *stages, uint32 num_stages,
+								s_erc *error)
+{
+	SList *timings = NULL;
+	SMap *stage;
+	s_bool is_present = FALSE;
+	uint32 i;
+
+
+	S_CLR_ERR(error);
+
+	if (first > 0)
+	{
+		is_present = SUtteranceFeatureIsPresent(utt, "timings", error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "add_timings_feature",
+					  "Call to \"SUtteranceFeatureIsPresent\" failed"))
+			return;
+	}
+
+	if (is_present)
+	{
+		/* the utterance is ours while its processors run */
+		timings = (SList*)SUtteranceGetFeature(utt, "timings", error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "add_timings_feature",
+					  "Call to \"SUtteranceGetFeature\" failed"))
+			return;
+	}
+
+	if (timings == NULL)
+	{
+		timings = S_LIST(S_NEW(SListList, error));
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "add_timings_feature",
+					  "Failed to create new list"))
+			return;
+
+		SUtteranceSetFeature(utt, "timings", S_OBJECT(timings), error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "add_timings_feature",
+					  "Failed to set utterance \'timings\' feature"))
+		{
+			s_erc local_err = S_SUCCESS;
+
+
+			S_DELETE(timings, "add_timings_feature", &local_err);
+			return;
+		}
+	}
+
+	for (i = 0; i < num_stages; i++)
+	{
+		stage = S_MAP(S_NEW(SMapList, error));
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "add_timings_feature",
+					  "Failed to create new map"))
+			break;
+
+		SListAppend(timings, S_OBJECT(stage), error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "add_timings_feature",
+					  "Call to \"SListAppend\" failed"))
+		{
+			s_erc local_err = S_SUCCESS;
+
+
+			S_DELETE(stage, "add_timings_feature", &local_err);
+			break;
+		}
+
+		SMapSetString(stage, "name", plan->names[first + i], error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "add_timings_feature",
+					  "Call to \"SMapSetString\" failed"))
+			break;
+
+		SMapSetFloat(stage, "wall", (float)(stages[i].wall * 1000.0), error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "add_timings_feature",
+					  "Call to \"SMapSetFloat\" failed"))
+			break;
+
+		SMapSetFloat(stage, "cpu", (float)(stages[i].cpu * 1000.0), error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "add_timings_feature",
+					  "Call to \"SMapSetFloat\" failed"))
+			break;
+
+		SMapSetInt(stage, "allocations", (sint32)stages[i].allocs, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "add_timings_feature",
+					  "Call to \"SMapSetInt\" failed"))
+			break;
+
+		SMapSetInt(stage, "bytes", (sint32)stages[i].bytes, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "add_timings_feature",
+					  "Call to \"SMapSetInt\" failed"))
+			break;
+	}
+
+}
+
+
+/* must be called with the timings mutex locked */
+static SMap *get_timing_stats_map(const s_utt_proc_timing *stats, s_erc *error)
+{
+	SMap *map;
+
+
+	S_CLR_ERR(error);
+
+	map = S_MAP(S_NEW(SMapList, error));
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "get_timing_stats_map",
+				  "Failed to create new map"))
+		return NULL;
+
+	SMapSetInt(map, "count", (sint32)stats->count, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "get_timing_stats_map",
+				  "Call to \"SMapSetInt\" failed"))
+		goto quit_error;
+
+	SMapSetFloat(map, "wall", (float)(stats->wall * 1000.0 / stats->count), error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "get_timing_stats_map",
+				  "Call to \"SMapSetFloat\" failed"))
+		goto quit_error;
+
+	SMapSetFloat(map, "wall-p50", (float)timing_percentile(stats, 0.50), error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "get_timing_stats_map",
+				  "Call to \"SMapSetFloat\" failed"))
+		goto quit_error;
+
+	SMapSetFloat(map, "wall-p95", (float)timing_percentile(stats, 0.95), error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "get_timing_stats_map",
+				  "Call to \"SMapSetFloat\" failed"))
+		goto quit_error;
+
+	SMapSetFloat(map, "wall-p99", (float)timing_percentile(stats, 0.99), error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "get_timing_stats_map",
+				  "Call to \"SMapSetFloat\" failed"))
+		goto quit_error;
+
+	SMapSetFloat(map, "cpu", (float)(stats->cpu * 1000.0 / stats->count), error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "get_timing_stats_map",
+				  "Call to \"SMapSetFloat\" failed"))
+		goto quit_error;
+
+	SMapSetFloat(map, "allocations", (float)stats->allocs / stats->count, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "get_timing_stats_map",
+				  "Call to \"SMapSetFloat\" failed"))
+		goto quit_error;
+
+	SMapSetFloat(map, "bytes", (float)stats->bytes / stats->count, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "get_timing_stats_map",
+				  "Call to \"SMapSetFloat\" failed"))
+		goto quit_error;
+
+	return map;
+
+	/* error clean-up */
+quit_error:
+	S_DELETE(map, "get_timing_stats_map", error);
+	return NULL;
+}
+
+
+/*
+ * Histogram bucket of a wall time, bucket 0 is below 1 microsecond,
+ * bucket k > 0 is up to 2^(k/S_TIMING_BUCKETS_PER_OCTAVE) microseconds.
+ */
+static uint32 timing_bucket(double wall)
+{
+	double octaves;
+	uint32 bucket;
+
+
+	if (wall < 1.0e-6)
+		return 0;
+
+	octaves = s_log2(wall * 1.0e6);
+	bucket = (uint32)(octaves * S_TIMING_BUCKETS_PER_OCTAVE) + 1;
+	if (bucket >= S_TIMING_BUCKETS)
+		bucket = S_TIMING_BUCKETS - 1;
+
+	return bucket;
+}
+
+
+/*
+ * Percentile p (0..1) of the wall times in milliseconds, the upper
+ * bound of the histogram bucket it falls in.
+ */
+static double timing_percentile(const s_utt_proc_timing *stats, double p)
+{
+	uint32 rank;
+	uint32 seen = 0;
+	uint32 i;
+
+
+	rank = (uint32)ceil(p * stats->count);
+	if (rank == 0)
+		rank = 1;
+
+	for (i = 0; i < S_TIMING_BUCKETS; i++)
+	{
+		seen += stats->buckets[i];
+		if (seen >= rank)
+			break;
+	}
+
+	if (i >= S_TIMING_BUCKETS)
+		i = S_TIMING_BUCKETS - 1;
+
+	return pow(2.0, (double)i / S_TIMING_BUCKETS_PER_OCTAVE) / 1000.0;
+}
+
+
+/*
+ * Look up the audio of the utterance in the cache. On a hit the
+ * cached samples are written to the utterance's audio stream and
+ * TRUE is returned. On a miss of a cacheable utterance the key and
+ * the number of samples already in the stream are set, to store the
+ * audio once synthesized (synth_cache_store).
+ */
+static s_bool synth_cache_fetch(SSynthCache *cache, const SVoice *self,
+								const char *utt_type, SUtterance *utt,
+								char **key, uint32 *start, s_erc *error)
+{
+	SAudioStream *stream;
+	float *samples;
+	uint32 num_samples;
+	uint32 sample_rate;
+
+
+	S_CLR_ERR(error);
+	*key = NULL;
+
+	stream = SAudioStreamGetFromUtt(utt, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "synth_cache_fetch",
+				  "Call to \"SAudioStreamGetFromUtt\" failed"))
+		return FALSE;
+
+	if (stream == NULL)
+		return FALSE;
+
+	*key = _s_synth_cache_key(self, utt_type, utt, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "synth_cache_fetch",
+				  "Call to \"_s_synth_cache_key\" failed")
+		|| (*key == NULL))
+		return FALSE;
+
+	samples = SSynthCacheFetch(cache, *key, &num_samples, &sample_rate, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "synth_cache_fetch",
+				  "Call to \"SSynthCacheFetch\" failed"))
+		goto quit_miss;
+
+	if (samples != NULL)
+	{
+		SAudioStreamWrite(stream, samples, num_samples, sample_rate, error);
+		S_FREE(samples);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "synth_cache_fetch",
+					  "Call to \"SAudioStreamWrite\" failed"))
+			goto quit_miss;
+
+		S_FREE(*key);
+		return TRUE;
+	}
+
+	/* the samples of the synthesis must be kept to be stored */
+	if (!stream->keep)
+		goto quit_miss;
+
+	SAudioStreamGetSamples(stream, start, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "synth_cache_fetch",
+				  "Call to \"SAudioStreamGetSamples\" failed"))
+		goto quit_miss;
+
+	return FALSE;
+
+	/* not stored */
+quit_miss:
+	S_FREE(*key);
+	return FALSE;
+}
+
+
+/*
+ * store the samples written to the utterance's stream after start,
+ * unless the cache was cleared since clears was taken
+ */
+static void synth_cache_store(SSynthCache *cache, const char *key,
+							  const SUtterance *utt, uint32 start, ulong clears,
+							  s_erc *error)
+{
+	const SAudioStream *stream;
+	const float *samples;
+	uint32 num_samples;
+	uint32 sample_rate;
+
+
+	S_CLR_ERR(error);
+
+	stream = SAudioStreamGetFromUtt(utt, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "synth_cache_store",
+				  "Call to \"SAudioStreamGetFromUtt\" failed"))
+		return;
+
+	if (stream == NULL)
+		return;
+
+	samples = SAudioStreamGetSamples(stream, &num_samples, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "synth_cache_store",
+				  "Call to \"SAudioStreamGetSamples\" failed"))
+		return;
+
+	/* nothing synthesized, nothing to skip next time */
+	if ((samples == NULL) || (num_samples <= start))
+		return;
+
+	sample_rate = SAudioStreamGetSampleRate(stream, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "synth_cache_store",
+				  "Call to \"SAudioStreamGetSampleRate\" failed"))
+		return;
+
+	_s_synth_cache_store(cache, key, samples + start, num_samples - start,
+						 sample_rate, clears, error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "synth_cache_store",
+			  "Call to \"_s_synth_cache_store\" failed");
+}
+
+
+/*
+ * Look up the audio object of the input in the cache. On a hit a new
+ * utterance of the input is returned, with the "utterance-type"
+ * feature and a copy of the cached "audio" feature, else NULL.
+ */
+static SUtterance *synth_cache_fetch_utt(SSynthCache *cache, const SVoice *self,
+										 const char *utt_type, SObject *input,
+										 const char *key, s_erc *error)
+{
+	SUtterance *utt;
+	SObject *audio;
+	s_erc local_err = S_SUCCESS;
+
+
+	S_CLR_ERR(error);
+
+	audio = SSynthCacheFetchObject(cache, key, &local_err);
+	if (S_CHK_ERR(&local_err, S_CONTERR,
+				  "synth_cache_fetch_utt",
+				  "Call to \"SSynthCacheFetchObject\" failed")
+		|| (audio == NULL))
 		return NULL;
-	}
 
-	if (value == NULL)
+	/* failures before the input is given to the utterance are a miss */
+	utt = S_NEW(SUtterance, &local_err);
+	if (S_CHK_ERR(&local_err, S_CONTERR,
+				  "synth_cache_fetch_utt",
+				  "Failed to create new utterance"))
 	{
-		S_CTX_ERR(error, S_CONTERR,
-				  "get_data_info",
-				  "Value of key 'format' is NULL");
-		S_FREE(data_info);
+		S_DELETE(audio, "synth_cache_fetch_utt", &local_err);
 		return NULL;
 	}
 
-	data_info->format = value;
-
-	/* plug-in */
-	value = SMapGetStringDef(map, "plug-in", NULL, error);
-	if (S_CHK_ERR(error, S_CONTERR,
-				  "get_data_info",
-				  "Call to \"SMapGetStringDef\" of key 'plug-in' failed"))
+	SUtteranceInit(&utt, self, &local_err);
+	if (S_CHK_ERR(&local_err, S_CONTERR,
+				  "synth_cache_fetch_utt",
+				  "Failed to initialize new utterance"))
 	{
-		S_FREE(data_info);
+		S_DELETE(audio, "synth_cache_fetch_utt", &local_err);
+		S_DELETE(utt, "synth_cache_fetch_utt", &local_err);
 		return NULL;
 	}
 
-	if (value == NULL)
+	SUtteranceSetFeature(utt, "audio", audio, &local_err);
+	if (S_CHK_ERR(&local_err, S_CONTERR,
+				  "synth_cache_fetch_utt",
+				  "Failed to set utterance 'audio' feature"))
 	{
-		S_CTX_ERR(error, S_CONTERR,
-				  "get_data_info",
-				  "Value of key 'plug-in' is NULL");
-		S_FREE(data_info);
+		S_DELETE(audio, "synth_cache_fetch_utt", &local_err);
+		S_DELETE(utt, "synth_cache_fetch_utt", &local_err);
 		return NULL;
 	}
 
-	data_info->plugin = value;
-
-	/* path */
-	value = SMapGetStringDef(map, "path", NULL, error);
-	if (S_CHK_ERR(error, S_CONTERR,
-				  "get_data_info",
-				  "Call to \"SMapGetStringDef\" of key 'path' failed"))
+	SUtteranceSetFeature(utt, "utterance-type",
+						 SObjectSetString(utt_type, &local_err),
+						 &local_err);
+	if (S_CHK_ERR(&local_err, S_CONTERR,
+				  "synth_cache_fetch_utt",
+				  "Failed to set utterance 'utterance-type' feature"))
 	{
-		S_FREE(data_info);
+		S_DELETE(utt, "synth_cache_fetch_utt", &local_err);
 		return NULL;
 	}
 
-	if (value == NULL)
+	SUtteranceSetFeature(utt, "input", input, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "synth_cache_fetch_utt",
+				  "Failed to set utterance 'input' feature"))
 	{
-		S_CTX_ERR(error, S_CONTERR,
-				  "get_data_info",
-				  "Value of key 'path' is NULL");
-		S_FREE(data_info);
+		S_DELETE(utt, "synth_cache_fetch_utt", &local_err);
 		return NULL;
 	}
 
-	data_info->path = value;
-
-	return data_info;
+	return utt;
 }
 
 
-static void unload_data_entry(SVoice *self, const char *data_name, s_erc *error)
+/*
+ * store the "audio" feature object of the synthesized utterance,
+ * unless the cache was cleared since clears was taken
+ */
+static void synth_cache_store_utt(SSynthCache *cache, const char *key,
+								  const SUtterance *utt, ulong clears,
+								  s_erc *error)
 {
-	SObject *toUnload;
-	s_bool data_loaded;
+	const SObject *audio;
+	s_bool is_present;
 
 
 	S_CLR_ERR(error);
 
-	toUnload = SMapObjectUnlink(self->data->dataObjects, data_name, error);
+	is_present = SUtteranceFeatureIsPresent(utt, "audio", error);
 	if (S_CHK_ERR(error, S_CONTERR,
-				  "unload_data_entry",
-				  "Call to \"SMapObjectUnlink\" failed"))
+				  "synth_cache_store_utt",
+				  "Call to \"SUtteranceFeatureIsPresent\" failed"))
 		return;
 
-	/*
-	 * check if the data object was loaded with
-	 * the VoiceManager.
-	 */
-	data_loaded = _s_vm_data_loaded(toUnload, error);
+	if (!is_present)
+		return;
+
+	audio = SUtteranceGetFeature(utt, "audio", error);
 	if (S_CHK_ERR(error, S_CONTERR,
-				  "unload_data_entry",
-				  "Call to \"_s_vm_data_loaded\" failed"))
+				  "synth_cache_store_utt",
+				  "Call to \"SUtteranceGetFeature\" failed"))
 		return;
 
-	if (data_loaded)
-	{
-		_s_vm_unload_data(toUnload, error);
-		if (S_CHK_ERR(error, S_CONTERR,
-					  "unload_data_entry",
-					  "Call to \"_s_vm_unload_data\" failed"))
-			return;
-	}
-	else
-	{
-		/*
-		 * just do a delete, the VoiceManager does not have a handle
-		 * on this data object
-		 */
-		S_DELETE(toUnload, "unload_data_entry", error);
-	}
+	_s_synth_cache_store_object(cache, key, audio, clears, error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "synth_cache_store_utt",
+			  "Call to \"_s_synth_cache_store_object\" failed");
 }
 
 
-static void free_voice_info(s_voice_info *info)
+/*
+ * The cached audio was synthesized with the old configuration of the
+ * voice, voice mutex must be locked by the caller. Failures don't fail
+ * the change of configuration, just log them.
+ */
+static void clear_synth_cache(const SVoice *self)
 {
-	if (info != NULL)
-	{
-		if (info->name != NULL)
-			S_FREE(info->name);
-
-		if (info->description != NULL)
-			S_FREE(info->description);
-
-		if (info->gender != NULL)
-			S_FREE(info->gender);
+	s_erc local_err = S_SUCCESS;
 
-		if (info->language != NULL)
-			S_FREE(info->language);
 
-		if (info->lang_code != NULL)
-			S_FREE(info->lang_code);
+	if (self->data->cache == NULL)
+		return;
 
-		S_FREE(info);
-	}
+	SSynthCacheClear(self->data->cache, TRUE, &local_err);
+	S_CHK_ERR(&local_err, S_CONTERR,
+			  "clear_synth_cache",
+			  "Call to \"SSynthCacheClear\" failed");
 }
 
 
-static void unload_voice_plugins(SList *plugins, s_erc *error)
+/*
+ * Release the voice's reference to the cache. The memory tier is
+ * cleared first, the cached audio objects can be of classes of the
+ * voice's plug-ins, which are unloaded with the voice.
+ */
+static void release_synth_cache(SSynthCache *cache, s_erc *error)
 {
-	SIterator *itr;
-	SObject *plugin;
+	s_erc local_err = S_SUCCESS;
 
 
 	S_CLR_ERR(error);
 
-	itr = S_ITERATOR_GET(plugins, error);
-	if (S_CHK_ERR(error, S_CONTERR,
-				  "unload_voice_plugins",
-				  "Call to \"S_ITERATOR_GET\" failed"))
+	if (cache == NULL)
 		return;
 
-	while (itr != NULL)
-	{
-		plugin = SIteratorUnlink(itr, error);
-		if (S_CHK_ERR(error, S_CONTERR,
-					  "unload_voice_plugins",
-					  "Call to \"SIteratorUnlink\" failed"))
-		{
-			S_DELETE(itr, "unload_voice_plugins", error);
-			return;
-		}
-
-
-		S_DELETE(plugin, "unload_voice_plugins", error);
-		itr = SIteratorNext(itr);
-	}
+	SSynthCacheClear(cache, FALSE, &local_err);
+	S_CHK_ERR(&local_err, S_CONTERR,
+			  "release_synth_cache",
+			  "Call to \"SSynthCacheClear\" failed"); /* just log it */
 
-	S_DELETE(plugins, "unload_voice_plugins", error);
+	S_DELETE(cache, "release_synth_cache", error);
 }
 
 
@@ -1763,6 +4971,21 @@ static void InitVoice(void *obj, s_erc *error)
 				  "Failed to create new data objects map"))
 		return;
 
+	self->data->lazy = NULL;
+
+	/* the first data epoch */
+	self->data->epoch = S_CALLOC(s_data_epoch, 1);
+	if (self->data->epoch == NULL)
+	{
+		S_FTL_ERR(error, S_MEMERROR,
+				  "InitVoice",
+				  "Failed to allocate memory for 's_data_epoch' object");
+		return;
+	}
+
+	self->data->epochs = self->data->epoch;
+	s_mutex_init(&self->data->data_mutex);
+	s_mutex_init(&self->data->timings_mutex);
 	s_mutex_init(&self->voice_mutex);
 }
 
@@ -1779,6 +5002,36 @@ static void DestroyVoice(void *obj, s_erc *error)
 
 	free_voice_info(self->info);
 
+	/* no syntheses can be running the plans anymore */
+	while ((self->data != NULL) && (self->data->plans != NULL))
+	{
+		s_utt_plan *plan = self->data->plans;
+
+
+		self->data->plans = plan->next;
+		free_utt_plan(plan);
+	}
+
+	if (self->data != NULL)
+	{
+		if (self->data->timings)
+			_s_alloc_count_hold(FALSE);
+
+		while (self->data->timing_stats != NULL)
+		{
+			s_utt_proc_timing *stats = self->data->timing_stats;
+
+
+			self->data->timing_stats = stats->next;
+			S_FREE(stats->name);
+			S_FREE(stats);
+		}
+
+		s_mutex_destroy(&self->data->timings_mutex);
+
+		release_synth_cache(self->data->cache, error);
+	}
+
 	if (self->features != NULL)
 		S_DELETE(self->features, "DestroyVoice", error);
 
@@ -1791,16 +5044,39 @@ static void DestroyVoice(void *obj, s_erc *error)
 	if (self->uttTypes != NULL)
 		S_DELETE(self->uttTypes, "DestroyVoice", error);
 
-	if (self->plugins != NULL)
-	{
-		unload_voice_plugins(self->plugins, error);
-		S_CHK_ERR(error, S_CONTERR,
-				  "DestroyVoice",
-				  "Call to \"unload_voice_plugins\" failed");
-	}
-
 	if (self->data != NULL)
 	{
+		s_lazy_data *entry;
+
+
+		/* free the lazy data entries, unloading those that were loaded */
+		s_mutex_lock(&self->data->data_mutex);
+		while (self->data->lazy != NULL)
+		{
+			entry = self->data->lazy;
+			self->data->lazy = entry->next;
+			free_lazy_data_entry(entry, error);
+			S_CHK_ERR(error, S_CONTERR,
+					  "DestroyVoice",
+					  "Call to \"free_lazy_data_entry\" failed");
+		}
+
+		/* no syntheses are in flight, unload all the retired data */
+		while (self->data->epochs != NULL)
+		{
+			s_data_epoch *epoch = self->data->epochs;
+
+
+			self->data->epochs = epoch->next;
+			unload_retired_data(epoch->retired, error);
+			S_CHK_ERR(error, S_CONTERR,
+					  "DestroyVoice",
+					  "Call to \"unload_retired_data\" failed");
+			S_FREE(epoch);
+		}
+		self->data->epoch = NULL;
+		s_mutex_unlock(&self->data->data_mutex);
+
 		/*
 		 * now iterate through data config and delete everything
 		 */
@@ -1864,9 +5140,41 @@ static void DestroyVoice(void *obj, s_erc *error)
 		}
 
 		S_DELETE(self->data->dataObjects, "DestroyVoice", error);
+
+		/* after the data objects, they may need the plug-ins */
+		if (self->data->plugins != NULL)
+		{
+			unload_voice_plugins(self->data->plugins, error);
+			S_CHK_ERR(error, S_CONTERR,
+					  "DestroyVoice",
+					  "Call to \"unload_voice_plugins\" failed");
+		}
+
+		s_mutex_destroy(&self->data->data_mutex);
+
+		/* data used in place holds its own reference to the mapping */
+		if (self->data->image != NULL)
+		{
+			_s_voice_image_close(self->data->image, error);
+			S_CHK_ERR(error, S_CONTERR,
+					  "DestroyVoice",
+					  "Call to \"_s_voice_image_close\" failed");
+		}
+
 		S_FREE(self->data);
 	}
 
+	/* after the data, data objects that the utterance processors set
+	 * in the voice (see SVoiceSetData) may need their plug-ins
+	 */
+	if (self->plugins != NULL)
+	{
+		unload_voice_plugins(self->plugins, error);
+		S_CHK_ERR(error, S_CONTERR,
+				  "DestroyVoice",
+				  "Call to \"unload_voice_plugins\" failed");
+	}
+
 	s_mutex_unlock(&self->voice_mutex);
 	s_mutex_destroy(&self->voice_mutex);
 }
@@ -1882,21 +5190,13 @@ static void DisposeVoice(void *obj, s_erc *error)
 static SUtterance *SynthUtt(const SVoice *self, const char *utt_type,
 							SObject *input, s_erc *error)
 {
-	const SList *uttType;
-	const SUttProcessor *uttProc; /* utterance processor */
-	const char *utt_processor_name;
+	const s_utt_plan *plan;
 	SUtterance *utt;
-	SIterator *itr;
+	s_erc local_err = S_SUCCESS;
 
 
 	S_CLR_ERR(error);
 
-	uttType = SVoiceGetUttType(self, utt_type, error);
-	if (S_CHK_ERR(error, S_CONTERR,
-				  "SynthUtt",
-				  "Call to \"SVoiceGetUttType\" failed"))
-		return NULL;
-
 	/* create new utterance */
 	utt = S_NEW(SUtterance, error);
 	if (S_CHK_ERR(error, S_CONTERR,
@@ -1934,62 +5234,21 @@ static SUtterance *SynthUtt(const SVoice *self, const char *utt_type,
 		return NULL;
 	}
 
-	/* run utterance processors on utterance */
-	itr = S_ITERATOR_GET(uttType, error);
+	plan = acquire_utt_plan(self, utt_type, error);
 	if (S_CHK_ERR(error, S_CONTERR,
 				  "SynthUtt",
-				  "Call to \"S_ITERATOR_GET\" failed"))
+				  "Call to \"acquire_utt_plan\" failed"))
 	{
-		S_DELETE(utt, "SynthUtt", error);
+		S_DELETE(utt, "SynthUtt", &local_err);
 		return NULL;
 	}
 
-	for (/* NOP */; itr != NULL; itr = SIteratorNext(itr))
-	{
-		/* get utterance processor name */
-		utt_processor_name = SObjectGetString(SIteratorObject(itr, error), error);
-		if (S_CHK_ERR(error, S_CONTERR,
-					  "SynthUtt",
-					  "Failed to get utterance processor name"))
-		{
-			S_DELETE(itr, "SynthUtt", error);
-			return utt;
-		}
-
-		uttProc = S_UTTPROCESSOR(SMapGetObjectDef(self->uttProcessors, utt_processor_name,
-												  NULL, error));
-		if (S_CHK_ERR(error, S_CONTERR,
-					  "SynthUtt",
-					  "Call to \"SMapGetObjectDef\" failed"))
-		{
-			S_DELETE(itr, "SynthUtt", error);
-			return utt;
-		}
-
-		if (uttProc == NULL)
-		{
-			S_CTX_ERR(error, S_FAILURE,
-					  "SynthUtt",
-					  "Utterance processor \'%s\' not defined",
-					  utt_processor_name);
-			S_DELETE(itr, "SynthUtt", error);
-			return utt;
-		}
-
-		S_DEBUG(S_DBG_INFO,
-				"executing \'%s\' utterance processor ...",
-				utt_processor_name);
-
-		SUttProcessorRun(uttProc, utt, error);
-		if (S_CHK_ERR(error, S_CONTERR,
-					  "SynthUtt",
-					  "Execution of utterance processor \'%s\' failed",
-					  utt_processor_name))
-		{
-			S_DELETE(itr, "SynthUtt", error);
-			return utt;
-		}
-	}
+	/* run utterance processors on utterance */
+	run_utt_plan(self, plan, utt, 0, plan->num_procs, error);
+	release_utt_plan(self, plan);
+	S_CHK_ERR(error, S_CONTERR,
+			  "SynthUtt",
+			  "Call to \"run_utt_plan\" failed");
 
 	return utt;
 }
@@ -1998,20 +5257,11 @@ static SUtterance *SynthUtt(const SVoice *self, const char *utt_type,
 static void ReSynthUtt(const SVoice *self, const char *utt_type,
 					   SUtterance *utt, s_erc *error)
 {
-	const SList *uttType;
-	const SUttProcessor *uttProc; /* utterance processor */
-	const char *utt_processor_name;
-	SIterator *itr;
+	const s_utt_plan *plan;
 
 
 	S_CLR_ERR(error);
 
-	uttType = SVoiceGetUttType(self, utt_type, error);
-	if (S_CHK_ERR(error, S_CONTERR,
-				  "ReSynthUtt",
-				  "Call to \"SVoiceGetUttType\" failed"))
-		return;
-
 	SUtteranceSetFeature(utt, "utterance-type",
 						 SObjectSetString(utt_type, error),
 						 error);
@@ -2020,59 +5270,18 @@ static void ReSynthUtt(const SVoice *self, const char *utt_type,
 				  "Failed to set utterance \'utterance-type\' feature"))
 		return;
 
-	/* run utterance processors on utterance */
-	itr = S_ITERATOR_GET(uttType, error);
+	plan = acquire_utt_plan(self, utt_type, error);
 	if (S_CHK_ERR(error, S_CONTERR,
 				  "ReSynthUtt",
-				  "Call to \"S_ITERATOR_GET\" failed"))
+				  "Call to \"acquire_utt_plan\" failed"))
 		return;
 
-	for (/* NOP */; itr != NULL; itr = SIteratorNext(itr))
-	{
-		/* get utterance processor name */
-		utt_processor_name = SObjectGetString(SIteratorObject(itr, error), error);
-		if (S_CHK_ERR(error, S_CONTERR,
-					  "ReSynthUtt",
-					  "Failed to get utterance processor name"))
-		{
-			S_DELETE(itr, "ReSynthUtt", error);
-			return;
-		}
-
-		uttProc = S_UTTPROCESSOR(SMapGetObjectDef(self->uttProcessors, utt_processor_name,
-												  NULL, error));
-		if (S_CHK_ERR(error, S_CONTERR,
-					  "ReSynthUtt",
-					  "Call to \"SMapGetObjectDef\" failed"))
-		{
-			S_DELETE(itr, "ReSynthUtt", error);
-			return;
-		}
-
-		if (uttProc == NULL)
-		{
-			S_CTX_ERR(error, S_FAILURE,
-					  "ReSynthUtt",
-					  "Utterance processor \'%s\' not defined",
-					  utt_processor_name);
-			S_DELETE(itr, "ReSynthUtt", error);
-			return;
-		}
-
-		S_DEBUG(S_DBG_INFO,
-				"executing \'%s\' utterance processor ...",
-				utt_processor_name);
-
-		SUttProcessorRun(uttProc, utt, error);
-		if (S_CHK_ERR(error, S_CONTERR,
-					  "ReSynthUtt",
-					  "Execution of utterance processor \'%s\' failed",
-					  utt_processor_name))
-		{
-			S_DELETE(itr, "ReSynthUtt", error);
-			return;
-		}
-	}
+	/* run utterance processors on utterance */
+	run_utt_plan(self, plan, utt, 0, plan->num_procs, error);
+	release_utt_plan(self, plan);
+	S_CHK_ERR(error, S_CONTERR,
+			  "ReSynthUtt",
+			  "Call to \"run_utt_plan\" failed");
 }
 
 
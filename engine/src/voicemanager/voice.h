@@ -65,6 +65,9 @@
 #include "base/objsystem/objsystem.h"
 #include "hrg/hrg.h"
 #include "containers/containers.h"
+#include "voicemanager/audiostream.h"
+#include "voicemanager/canceltoken.h"
+#include "voicemanager/synthcache.h"
 
 
 /************************************************************************************/
@@ -304,6 +307,14 @@ typedef struct
  * utterance.
  *
  * @note The voice takes hold of the @c input #SObject
+ *
+ * @note If the voice has a synthesis cache (#SVoiceSetSynthCache), the
+ * utterance of a cache hit only has the @c "input", @c
+ * "utterance-type" and @c "audio" features.
+ *
+ * @note Several threads can synthesize with the same voice
+ * concurrently (see @ref SSynthPool), as long as the voice features,
+ * processors and utterance types are not changed at the same time.
  */
 S_API SUtterance *SVoiceSynthUtt(const SVoice *self, const char *utt_type,
 								 SObject *input, s_erc *error);
@@ -326,6 +337,216 @@ S_API void SVoiceReSynthUtt(const SVoice *self, const char *utt_type,
 							SUtterance *utt, s_erc *error);
 
 
+/**
+ * Synthesize an utterance with the given utterance type and input,
+ * streaming the audio. The audio stream is set as the @c
+ * "audio-stream" feature of the utterance, and waveform generation
+ * utterance processors write their samples to it while generating
+ * (see #SAudioStreamGetFromUtt), so that the chunk callback of the
+ * stream receives the first chunk before the utterance is done. The
+ * stream is flushed when the synthesis is done.
+ *
+ * @public @memberof SVoice
+ * @param self The voice used for synthesis.
+ * @param utt_type The key of the utterance type as registered in the
+ * #SVoice @c uttTypes container.
+ * @param input The input to the synthesizer.
+ * @param stream The audio stream.
+ * @param error Error code.
+ *
+ * @return The synthesized utterance.
+ *
+ * @note The caller is responsible for the memory of the returned
+ * utterance.
+ *
+ * @note The voice takes hold of the @c input #SObject. The caller
+ * keeps the @c stream, it is removed from the utterance before the
+ * utterance is returned.
+ */
+S_API SUtterance *SVoiceSynthUttStream(const SVoice *self, const char *utt_type,
+									   SObject *input, SAudioStream *stream,
+									   s_erc *error);
+
+
+/**
+ * Synthesize an utterance with the given utterance type and input,
+ * that can be cancelled. The cancellation token is set as the @c
+ * "cancel-token" feature of the utterance while synthesizing. It is
+ * checked before every utterance processor, and by the utterance
+ * processors that support it in their main loops (see @ref
+ * SCancelToken). If the token is cancelled, or its deadline passes,
+ * the synthesis stops with the #S_CANCELLED error code.
+ *
+ * @public @memberof SVoice
+ * @param self The voice used for synthesis.
+ * @param utt_type The key of the utterance type as registered in the
+ * #SVoice @c uttTypes container.
+ * @param input The input to the synthesizer.
+ * @param cancel The cancellation token.
+ * @param error Error code.
+ *
+ * @return The synthesized utterance, or @c NULL if the synthesis
+ * failed or was cancelled.
+ *
+ * @note The caller is responsible for the memory of the returned
+ * utterance.
+ *
+ * @note The voice takes hold of the @c input #SObject. The caller
+ * keeps the @c cancel token, it is removed from the utterance before
+ * the utterance is returned.
+ *
+ * @note To shed synthesis requests that waited too long, for example
+ * in the queue of a #SSynthPool, set the @c "cancel-token" feature of
+ * the utterance submitted with #SSynthPoolSubmitUtt. A token whose
+ * deadline has passed fails the request before its first utterance
+ * processor.
+ */
+S_API SUtterance *SVoiceSynthUttCancellable(const SVoice *self, const char *utt_type,
+											SObject *input, SCancelToken *cancel,
+											s_erc *error);
+
+
+/**
+ * Synthesize the given input into an existing utterance. The
+ * utterance is reset (#SUtteranceReset) and synthesized again with the
+ * given utterance type and input, reusing the containers, items and
+ * item contents of the previous synthesis. A service that synthesizes
+ * many short requests can keep one utterance per worker and refill
+ * it, instead of creating and deleting an utterance per request.
+ *
+ * @public @memberof SVoice
+ * @param self The voice used for synthesis.
+ * @param utt_type The key of the utterance type as registered in the
+ * #SVoice @c uttTypes container.
+ * @param input The input to the synthesizer.
+ * @param utt The utterance to refill.
+ * @param error Error code.
+ *
+ * @note The voice takes hold of the @c input #SObject. The caller
+ * keeps the utterance, which is associated with this voice after the
+ * call. Any items, relations or features obtained from the utterance
+ * before the call are invalid afterwards.
+ */
+S_API void SVoiceSynthUttRefill(const SVoice *self, const char *utt_type,
+								SObject *input, SUtterance *utt, s_erc *error);
+
+
+/**
+ * @}
+ */
+
+
+/**
+ * @name Timings
+ * Instrumentation of the utterance processors run by synthesis. When
+ * enabled, the wall time, CPU time (of the synthesizing thread) and
+ * memory allocations of every utterance processor run are measured.
+ * The measurements of an utterance are set as its @c "timings"
+ * feature, an #SList of #SMap, one for every utterance processor that
+ * was run in the order they were run. Each map has the keys @c "name"
+ * (string), @c "wall" (float, milliseconds), @c "cpu" (float,
+ * milliseconds), @c "allocations" (int) and @c "bytes" (int). The
+ * measurements are also aggregated per utterance processor, see
+ * #SVoiceGetTimings.
+ *
+ * Timings are disabled by default and then cost a single flag test
+ * per utterance. Allocations are counted process wide, so they are
+ * approximate when utterances are synthesized concurrently.
+ * @{
+ */
+
+
+/**
+ * Enable or disable the utterance processor timings of the voice.
+ *
+ * @public @memberof SVoice
+ * @param self The given voice.
+ * @param enable If #TRUE then the utterance processors are timed.
+ * @param error Error code.
+ */
+S_API void SVoiceTimingsEnable(SVoice *self, s_bool enable, s_erc *error);
+
+
+/**
+ * Query whether the utterance processor timings of the voice are
+ * enabled.
+ *
+ * @public @memberof SVoice
+ * @param self The given voice.
+ * @param error Error code.
+ *
+ * @return #TRUE if the utterance processors are timed.
+ */
+S_API s_bool SVoiceTimingsEnabled(const SVoice *self, s_erc *error);
+
+
+/**
+ * Get the aggregated utterance processor timings of the voice. The
+ * returned map has an #SMap for every utterance processor that was
+ * timed, keyed by the utterance processor name, with the keys
+ * @c "count" (int, number of runs), @c "wall" (float, mean in
+ * milliseconds), @c "wall-p50", @c "wall-p95" and @c "wall-p99"
+ * (float, percentiles in milliseconds), @c "cpu" (float, mean in
+ * milliseconds), @c "allocations" and @c "bytes" (float, means).
+ *
+ * @public @memberof SVoice
+ * @param self The given voice.
+ * @param error Error code.
+ *
+ * @return The utterance processor timings.
+ *
+ * @note The percentiles are taken from a histogram with 4 buckets per
+ * octave, they are the upper bound of their bucket (within 19%).
+ * @note Caller is responsible for the returned map.
+ */
+S_API SMap *SVoiceGetTimings(const SVoice *self, s_erc *error);
+
+
+/**
+ * Clear the aggregated utterance processor timings of the voice.
+ *
+ * @public @memberof SVoice
+ * @param self The given voice.
+ * @param error Error code.
+ */
+S_API void SVoiceResetTimings(SVoice *self, s_erc *error);
+
+
+/**
+ * @}
+ */
+
+
+/**
+ * @name Cache
+ * @{
+ */
+
+
+/**
+ * Set the synthesis cache of the given voice, see @ref
+ * SSynthCache. The voice looks up the utterances synthesized by
+ * #SVoiceSynthUtt and #SVoiceReSynthUtt (and the functions using them)
+ * in the cache.
+ *
+ * @public @memberof SVoice
+ * @param self The given voice.
+ * @param cache The synthesis cache, or @c NULL to stop caching.
+ * @param error Error code.
+ *
+ * @note The voice holds a reference to the cache (#SObjectIncRef) and
+ * deletes it when releasing it (replaced or voice deleted), unless
+ * other references are held: a caller that keeps using the cache, or
+ * sets it on other voices, must hold its own reference. The memory
+ * tier is cleared when the voice releases the cache.
+ * @note #SVoiceReloadData and the functions setting or deleting the
+ * voice data, features (except @c "rate", @c "volume" and @c
+ * "half-tone"), processors and utterance types clear the cache, memory
+ * and disk tiers.
+ */
+S_API void SVoiceSetSynthCache(SVoice *self, SSynthCache *cache, s_erc *error);
+
+
 /**
  * @}
  */
@@ -462,11 +683,48 @@ S_API s_bool SVoiceDataIsPresent(const SVoice *self, const char *name,
  *
  * @return Pointer to the data object of the named key, or #NULL if
  * data of named key is not present in voice.
+ *
+ * @note Data entries defined with <tt>"load" : "lazy"</tt> in the
+ * voice configuration file are loaded on the first call for their
+ * key. Concurrent callers wait for the load to complete, the data is
+ * only loaded once.
  */
 S_API const SObject *SVoiceGetData(const SVoice *self, const char *key,
 								   s_erc *error);
 
 
+/**
+ * Load the lazy @a data entry of the named key, or all lazy data
+ * entries if @c key is #NULL, so that later calls to #SVoiceGetData
+ * do not incur the loading cost. Data that is already loaded, or
+ * keys that are not lazy data entries, are ignored.
+ *
+ * @public @memberof SVoice
+ * @param self The given voice.
+ * @param key The string key of the data object to load, or #NULL
+ * for all lazy data entries.
+ * @param error Error code.
+ */
+S_API void SVoicePrefetchData(const SVoice *self, const char *key, s_erc *error);
+
+
+/**
+ * Get the @a data generation of the voice. The generation changes
+ * every time a data object is set, deleted or reloaded, so that
+ * anything derived from the data objects (for example a cache of
+ * pronunciations) can detect that it is out of date.
+ *
+ * @public @memberof SVoice
+ * @param self The given voice.
+ * @param error Error code.
+ *
+ * @return The data generation.
+ *
+ * @note Thread safe.
+ */
+S_API uint32 SVoiceGetDataGeneration(const SVoice *self, s_erc *error);
+
+
 /**
  * Set the value of the named voice @a data key to the
  * given #SObject. If the named key already exists
@@ -497,6 +755,28 @@ S_API void SVoiceSetData(SVoice *self, const char *key,
 S_API void SVoiceDelData(SVoice *self, const char *key, s_erc *error);
 
 
+/**
+ * Reload the named data object of the voice from the data file
+ * defined in the voice config file. The replacement data object is
+ * loaded without locking the voice, and then published atomically,
+ * so that syntheses in progress are not interrupted. The replaced
+ * data object is only unloaded once all the syntheses that started
+ * before it was replaced have finished.
+ *
+ * @public @memberof SVoice
+ * @param self The given voice.
+ * @param key The string key of the data object to reload.
+ * @param error Error code.
+ *
+ * @note Data objects obtained with #SVoiceGetData outside of a
+ * synthesis are not protected, and must not be used after the data
+ * object is reloaded.
+ * @note The data of a precompiled voice image can not be reloaded.
+ * @note Thread safe.
+ */
+S_API void SVoiceReloadData(SVoice *self, const char *key, s_erc *error);
+
+
 /**
  * @}
  */
@@ -885,6 +1165,169 @@ S_API void SVoiceDelUttType(SVoice *self, const char *key, s_erc *error);
 S_LOCAL void _s_voice_load_data(SVoice *self, const SMap *dataConfig, s_erc *error);
 
 
+/* voicemanager/image.h */
+struct s_voice_image;
+
+
+/**
+ * Set the voice image that the voice data is loaded from. Must be
+ * called before #_s_voice_load_data. This function is used by the
+ * <i>Voice Manager</i> in #s_vm_load_voice when the voice is a
+ * precompiled voice image.
+ *
+ * @private
+ * @param self The given voice.
+ * @param image The voice image.
+ * @param error Error code.
+ *
+ * @note The voice takes hold of the voice image, and closes it when
+ * the voice is deleted.
+ */
+S_LOCAL void _s_voice_set_image(SVoice *self, struct s_voice_image *image,
+								s_erc *error);
+
+
+/* opaque, voicemanager/voice.c */
+struct s_data_epoch;
+
+
+/**
+ * Enter the current data epoch of the voice. Data objects retired by
+ * #SVoiceReloadData are kept until all the synthesis that entered an
+ * epoch leave it. Used by synthesis executors that run the utterance
+ * processors themselves (see @ref SSynthPipeline).
+ *
+ * @private
+ * @param self The given voice.
+ *
+ * @return The entered data epoch.
+ */
+S_LOCAL struct s_data_epoch *_s_voice_data_epoch_enter(const SVoice *self);
+
+
+/**
+ * Leave a data epoch entered with #_s_voice_data_epoch_enter,
+ * unloading the retired data objects that are no longer used.
+ *
+ * @private
+ * @param self The given voice.
+ * @param epoch The data epoch to leave.
+ * @param error Error code.
+ */
+S_LOCAL void _s_voice_data_epoch_leave(const SVoice *self, struct s_data_epoch *epoch,
+									   s_erc *error);
+
+
+/**
+ * Get the utterance processor of the given key with an extra
+ * reference, so that it is not deleted by #SVoiceSetUttProc or
+ * #SVoiceDelUttProc while it runs. Release it with #S_DELETE.
+ *
+ * @private
+ * @param self The given voice.
+ * @param key The utterance processor key.
+ * @param error Error code.
+ *
+ * @return The utterance processor, or @c NULL if the voice does not
+ * have one for the given key.
+ */
+S_LOCAL SUttProcessor *_s_voice_acquire_utt_proc(const SVoice *self, const char *key,
+												 s_erc *error);
+
+
+/* opaque, voicemanager/voice.c */
+struct s_utt_plan;
+
+
+/**
+ * Acquire the execution plan of the given utterance type, compiling
+ * it if needed. The plan holds references to its utterance
+ * processors, and stays valid until released with
+ * #_s_voice_release_utt_plan, even if the utterance type or its
+ * processors are changed in the meantime. Used by synthesis executors
+ * that run the utterance processors themselves (see @ref
+ * SSynthPipeline).
+ *
+ * @private
+ * @param self The given voice.
+ * @param utt_type The utterance type key.
+ * @param error Error code.
+ *
+ * @return The execution plan.
+ */
+S_LOCAL const struct s_utt_plan *_s_voice_acquire_utt_plan(const SVoice *self,
+														   const char *utt_type,
+														   s_erc *error);
+
+
+/**
+ * Release an execution plan acquired with #_s_voice_acquire_utt_plan.
+ *
+ * @private
+ * @param self The given voice.
+ * @param plan The execution plan.
+ */
+S_LOCAL void _s_voice_release_utt_plan(const SVoice *self, const struct s_utt_plan *plan);
+
+
+/**
+ * Get the number of utterance processors of an execution plan.
+ *
+ * @private
+ * @param plan The execution plan.
+ *
+ * @return The number of utterance processors.
+ */
+S_LOCAL uint32 _s_voice_utt_plan_size(const struct s_utt_plan *plan);
+
+
+/**
+ * Get the name of an utterance processor of an execution plan.
+ *
+ * @private
+ * @param plan The execution plan.
+ * @param index The index of the utterance processor, less than
+ * #_s_voice_utt_plan_size.
+ *
+ * @return The utterance processor name.
+ */
+S_LOCAL const char *_s_voice_utt_plan_name(const struct s_utt_plan *plan, uint32 index);
+
+
+/**
+ * Run the utterance processors @c first up to (not including) @c last
+ * of an execution plan on the utterance, with the cancellation checks,
+ * timings and tracing of #SVoiceSynthUtt.
+ *
+ * @private
+ * @param self The given voice.
+ * @param plan The execution plan.
+ * @param utt The utterance.
+ * @param first The index of the first utterance processor to run.
+ * @param last The index after the last utterance processor to run.
+ * @param error Error code.
+ */
+S_LOCAL void _s_voice_run_utt_plan(const SVoice *self, const struct s_utt_plan *plan,
+								   SUtterance *utt, uint32 first, uint32 last,
+								   s_erc *error);
+
+
+/**
+ * Compile the utterance types of the voice into execution plans, the
+ * resolved utterance processors of each utterance type. This function
+ * is used by the <i>Voice Manager</i> in #s_vm_load_voice, so that
+ * synthesis does not have to look up the utterance processors of every
+ * utterance. The plans are invalidated by #SVoiceSetUttProc,
+ * #SVoiceDelUttProc, #SVoiceSetUttType and #SVoiceDelUttType, and
+ * compiled again when an utterance type is next used.
+ *
+ * @private
+ * @param self The given voice.
+ * @param error Error code.
+ */
+S_LOCAL void _s_voice_compile_utt_plans(SVoice *self, s_erc *error);
+
+
 /**
  * Add the SVoice class to the object system.
  * @private
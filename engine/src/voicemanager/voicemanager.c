@@ -64,6 +64,42 @@ S_LOCAL void _s_voicemanager_init(s_erc *error)
 				  "Failed to intialize SVoice class"))
 		local_err = *error;
 
+	_s_synth_pool_class_add(error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "_s_voicemanager_init",
+				  "Failed to intialize SSynthFuture and SSynthPool classes"))
+		local_err = *error;
+
+	_s_synth_pipeline_class_add(error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "_s_voicemanager_init",
+				  "Failed to intialize SSynthPipeline class"))
+		local_err = *error;
+
+	_s_audio_stream_class_add(error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "_s_voicemanager_init",
+				  "Failed to intialize SAudioStream class"))
+		local_err = *error;
+
+	_s_cancel_token_class_add(error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "_s_voicemanager_init",
+				  "Failed to intialize SCancelToken class"))
+		local_err = *error;
+
+	_s_synth_cache_class_add(error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "_s_voicemanager_init",
+				  "Failed to intialize SSynthCache class"))
+		local_err = *error;
+
+	_s_synth_session_class_add(error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "_s_voicemanager_init",
+				  "Failed to intialize SSynthSession class"))
+		local_err = *error;
+
 	/* if there was an error local_err will have it */
 	if ((local_err != S_SUCCESS) && (*error == S_SUCCESS))
 		*error = local_err;
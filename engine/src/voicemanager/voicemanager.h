@@ -60,6 +60,13 @@
 #include "include/common.h"
 #include "voicemanager/manager.h"
 #include "voicemanager/voice.h"
+#include "voicemanager/synthpool.h"
+#include "voicemanager/synthpipeline.h"
+#include "voicemanager/audiostream.h"
+#include "voicemanager/canceltoken.h"
+#include "voicemanager/synthcache.h"
+#include "voicemanager/synthtext.h"
+#include "voicemanager/synthsession.h"
 
 
 /************************************************************************************/
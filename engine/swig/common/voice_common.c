@@ -129,6 +129,30 @@ typedef struct
 	}
 
 
+	void data_reload(const char *key, s_erc *error)
+	{
+		SVoiceReloadData($self, key, error);
+	}
+
+
+	void timings_enable(s_bool enable, s_erc *error)
+	{
+		SVoiceTimingsEnable($self, enable, error);
+	}
+
+
+	s_bool timings_enabled(s_erc *error)
+	{
+		return SVoiceTimingsEnabled($self, error);
+	}
+
+
+	void timings_reset(s_erc *error)
+	{
+		SVoiceResetTimings($self, error);
+	}
+
+
 
 	void uttType_del(const char *key, s_erc *error)
 	{
@@ -92,6 +92,34 @@ and now it must be synthesized with a different utterance type.
 %feature("autodoc", voice_resynth_DOCSTRING) SVoice::resynth;
 
 
+%define voice_synth_stream_DOCSTRING
+"""
+synth_stream(input, callback[, utt_type='text', chunk_size=1024])
+
+Synthesize an utterance of the given utterance type with the voice,
+streaming the audio. The waveform generator delivers the samples to the
+callback in chunks while it is generating, so that playback can start
+before the utterance is done.
+
+:param input: The text to synthesize.
+:type input: str
+:param callback: Called as ``callback(samples, sample_rate)`` for every
+                 chunk, where ``samples`` is a list of floats.
+:type callback: callable
+:param utt_type: The utterance type to synthesize.
+:type utt_type: str
+:param chunk_size: The number of samples of a chunk, the last chunk can
+                   be shorter. If 0 the chunks are delivered as generated.
+:type chunk_size: int
+:return: The synthesized utterance.
+:rtype: :class:`SUtterance`
+:raises: RuntimeError if the synthesis or the callback failed.
+"""
+%enddef
+
+%feature("autodoc", voice_synth_stream_DOCSTRING) SVoice::synth_stream;
+
+
 %define voice_name_DOCSTRING
 """
 name()
@@ -221,6 +249,81 @@ Delete the voice data object referenced by the given key.
 %feature("autodoc", voice_data_del_DOCSTRING) SVoice::data_del;
 
 
+%define voice_data_reload_DOCSTRING
+"""
+data_reload(key)
+
+Reload the voice data object referenced by the given key from its
+data file, without interrupting syntheses that are in progress. The
+replaced data object is deleted once these syntheses have finished.
+
+:param key: The key of the data object.
+:type key: str
+"""
+%enddef
+
+%feature("autodoc", voice_data_reload_DOCSTRING) SVoice::data_reload;
+
+
+%define voice_timings_enable_DOCSTRING
+"""
+timings_enable(enable)
+
+Enable or disable the utterance processor timings of the voice. When
+enabled, the wall time, CPU time and memory allocations of every
+utterance processor run are measured, set as the ``timings`` feature
+of the synthesized utterance and aggregated in :meth:`timings`.
+
+:param enable: If ``True`` the utterance processors are timed.
+:type enable: bool
+"""
+%enddef
+
+%feature("autodoc", voice_timings_enable_DOCSTRING) SVoice::timings_enable;
+
+
+%define voice_timings_enabled_DOCSTRING
+"""
+timings_enabled()
+
+Query whether the utterance processor timings of the voice are enabled.
+
+:return: ``True`` if the utterance processors are timed.
+:rtype: bool
+"""
+%enddef
+
+%feature("autodoc", voice_timings_enabled_DOCSTRING) SVoice::timings_enabled;
+
+
+%define voice_timings_DOCSTRING
+"""
+timings()
+
+Get the aggregated utterance processor timings of the voice.
+
+:return: A dictionary keyed by utterance processor name, each value a
+         dictionary with the keys ``count``, ``wall``, ``wall-p50``,
+         ``wall-p95``, ``wall-p99``, ``cpu`` (milliseconds),
+         ``allocations`` and ``bytes`` (means per run).
+:rtype: dict
+"""
+%enddef
+
+%feature("autodoc", voice_timings_DOCSTRING) SVoice::timings;
+
+
+%define voice_timings_reset_DOCSTRING
+"""
+timings_reset()
+
+Clear the aggregated utterance processor timings of the voice.
+"""
+%enddef
+
+%feature("autodoc", voice_timings_reset_DOCSTRING) SVoice::timings_reset;
+
+
 %define voice_uttType_get_DOCSTRING
 """
 uttType_get(key)
@@ -34,8 +34,56 @@
 /*                                                                                  */
 /************************************************************************************/
 
+%newobject synth_stream;
 
 
+%{
+	/* chunk callback of SVoice::synth_stream */
+	typedef struct
+	{
+		PyObject *callback;
+		char     *py_error;
+		s_bool    failed;
+	} s_py_stream_cb_data;
+
+
+	static void s_py_audio_chunk_cb(const float *samples, uint32 num_samples,
+									uint32 sample_rate, void *userdata)
+	{
+		s_py_stream_cb_data *cb_data = userdata;
+		PyObject *psamples;
+		PyObject *result;
+		uint32 i;
+
+
+		/* stop calling back after the first failure */
+		if (cb_data->failed)
+			return;
+
+		psamples = PyList_New((Py_ssize_t)num_samples);
+		if (psamples == NULL)
+		{
+			cb_data->failed = TRUE;
+			cb_data->py_error = s_get_python_error_str();
+			return;
+		}
+
+		for (i = 0; i < num_samples; i++)
+			PyList_SET_ITEM(psamples, (Py_ssize_t)i, PyFloat_FromDouble((double)samples[i]));
+
+		result = PyObject_CallFunction(cb_data->callback, "Ol", psamples, (long)sample_rate);
+		Py_DECREF(psamples);
+		if (result == NULL)
+		{
+			cb_data->failed = TRUE;
+			cb_data->py_error = s_get_python_error_str();
+			return;
+		}
+
+		Py_DECREF(result);
+	}
+%}
+
 
 %extend SVoice
 {
@@ -739,6 +787,86 @@
 	}
 
 
+	SUtterance *synth_stream(const char *input, PyObject *callback, char *utt_type="text",
+							 int chunk_size=1024, s_erc *error)
+	{
+		s_py_stream_cb_data cb_data;
+		SAudioStream *stream;
+		SUtterance *utt;
+		SObject *inputObject;
+		s_erc local_err = S_SUCCESS;
+
+
+		if (!PyCallable_Check(callback))
+		{
+			S_CTX_ERR(error, S_ARGERROR,
+					  "SVoice::synth_stream",
+					  "Argument \"callback\" is not callable");
+			return NULL;
+		}
+
+		if (chunk_size < 0)
+		{
+			S_CTX_ERR(error, S_ARGERROR,
+					  "SVoice::synth_stream",
+					  "Argument \"chunk_size\" is negative");
+			return NULL;
+		}
+
+		cb_data.callback = callback;
+		cb_data.py_error = NULL;
+		cb_data.failed = FALSE;
+
+		stream = S_NEW(SAudioStream, error);
+		if (*error != S_SUCCESS)
+			return NULL;
+
+		SAudioStreamInit(&stream, (uint32)chunk_size, s_py_audio_chunk_cb,
+						 &cb_data, FALSE, error);
+		if (*error != S_SUCCESS)
+			return NULL;
+
+		inputObject = SObjectSetString(input, error);
+		if (*error != S_SUCCESS)
+		{
+			S_DELETE(stream, "SVoice::synth_stream", &local_err);
+			return NULL;
+		}
+
+		utt = SVoiceSynthUttStream($self, (const char*)utt_type, inputObject, stream, error);
+		S_DELETE(stream, "SVoice::synth_stream", &local_err);
+		if (*error != S_SUCCESS)
+		{
+			if (cb_data.py_error != NULL)
+				S_FREE(cb_data.py_error);
+			return NULL;
+		}
+
+		if (cb_data.failed)
+		{
+			if (cb_data.py_error != NULL)
+			{
+				S_CTX_ERR(error, S_FAILURE,
+						  "SVoice::synth_stream",
+						  "Call to the chunk callback failed. Reported error: %s",
+						  cb_data.py_error);
+				S_FREE(cb_data.py_error);
+			}
+			else
+			{
+				S_CTX_ERR(error, S_FAILURE,
+						  "SVoice::synth_stream",
+						  "Call to the chunk callback failed");
+			}
+
+			S_DELETE(utt, "SVoice::synth_stream", &local_err);
+			return NULL;
+		}
+
+		return utt;
+	}
+
+
 	void uttType_set(const char *key, PyObject *uttType, s_erc *error)
 	{
 		SObject *object;
@@ -805,6 +933,27 @@
 
 		return pdata;
 	}
+
+
+	PyObject *timings(s_erc *error)
+	{
+		SMap *timings;
+		PyObject *ptimings;
+
+
+		timings = SVoiceGetTimings($self, error);
+		if (*error != S_SUCCESS)
+			return NULL;
+
+		ptimings = s_sobject_2_pyobject(S_OBJECT(timings), TRUE, error);
+		if (*error != S_SUCCESS)
+		{
+			S_DELETE(timings, "SVoice::timings", error);
+			return NULL;
+		}
+
+		return ptimings;
+	}
 };
 
 
@@ -0,0 +1,676 @@
+/************************************************************************************/
+/* Copyright (c) 2008-2011 The Department of Arts and Culture,                      */
+/* The Government of the Republic of South Africa.                                  */
+/*                                                                                  */
+/* Contributors:  Meraka Institute, CSIR, South Africa.                             */
+/*                                                                                  */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy     */
+/* of this software and associated documentation files (the "Software"), to deal    */
+/* in the Software without restriction, including without limitation the rights     */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        */
+/* copies of the Software, and to permit persons to whom the Software is            */
+/* furnished to do so, subject to the following conditions:                         */
+/* The above copyright notice and this permission notice shall be included in       */
+/* all copies or substantial portions of the Software.                              */
+/*                                                                                  */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN        */
+/* THE SOFTWARE.                                                                    */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* AUTHOR  : Speect contributors                                                    */
+/* DATE    : 19 October 2026                                                        */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* Synthesis cache test.                                                            */
+/*                                                                                  */
+/* Adds an utterance type to the voice that ends with a callback utterance          */
+/* processor making audio out of the Segment relation, and synthesizes it through   */
+/* an SSynthCache: with SVoiceSynthUtt (audio object, memory tier) and with         */
+/* SVoiceReSynthUtt of an utterance with an audio stream (samples, disk tier).      */
+/* The audio of every miss and hit must be the audio synthesized without a cache,   */
+/* a hit must not run the utterance processors, and the cache counters must count   */
+/* the hits and misses.                                                             */
+/*                                                                                  */
+/************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "speect.h"
+#include "audio.h"
+#include "uttproc_callback.h"
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Defines                                                                          */
+/*                                                                                  */
+/************************************************************************************/
+
+/* utterance type of the test, the "text" type and the audio processor */
+#define AUDIO_UTT_TYPE "cache-test"
+
+/* key of the audio utterance processor */
+#define AUDIO_UTT_PROC "CacheTestAudio"
+
+/* samples per segment and sample rate of the audio */
+#define SEGMENT_SAMPLES 32
+#define SAMPLE_RATE     16000
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static variables                                                                 */
+/*                                                                                  */
+/************************************************************************************/
+
+/* number of times the audio utterance processor was run */
+static int num_runs = 0;
+
+/* audio synthesized without a cache */
+static float *expected = NULL;
+static uint32 expected_num = 0;
+
+
+/************************************************************************************/
+/*                                                                                  */
+/*  Static function implementations                                                 */
+/*                                                                                  */
+/************************************************************************************/
+
+static void usage(int rv)
+{
+	printf("usage: synth_cache_test -t TEXT -v VOICEFILE -d CACHEDIR\n"
+		   "  Synthesizes the text in TEXT, with voice specification in VOICEFILE,\n"
+		   "  through a synthesis cache with its disk tier in the empty directory\n"
+		   "  CACHEDIR, and compares the audio to synthesis without a cache.\n"
+		   "  TEXT, VOICEFILE and CACHEDIR are not optional.\n"
+		   "  --help      Output usage string\n");
+	exit(rv);
+}
+
+
+/*
+ * The audio utterance processor callback: SEGMENT_SAMPLES samples
+ * per segment, made from the segment name. The samples are written to
+ * the audio stream of the utterance if it has one, else they are set
+ * as the "audio" feature.
+ */
+static void make_audio(SUtterance *utt, void *sfunction, s_erc *error)
+{
+	const SRelation *segmentRel;
+	const SItem *itr;
+	const char *name;
+	SAudioStream *stream;
+	SAudio *audio;
+	float *samples = NULL;
+	float *tmp;
+	uint32 num_samples = 0;
+	uint32 i;
+
+
+	S_CLR_ERR(error);
+
+	(*(int*)sfunction)++;
+
+	segmentRel = SUtteranceGetRelation(utt, "Segment", error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "make_audio",
+				  "Call to \"SUtteranceGetRelation\" failed"))
+		return;
+
+	itr = SRelationHead(segmentRel, error);
+	while ((*error == S_SUCCESS) && (itr != NULL))
+	{
+		name = SItemGetName(itr, error);
+		if (*error != S_SUCCESS)
+			break;
+
+		tmp = S_REALLOC(samples, float, num_samples + SEGMENT_SAMPLES);
+		if (tmp == NULL)
+		{
+			S_FTL_ERR(error, S_MEMERROR,
+					  "make_audio",
+					  "Failed to allocate memory for 'float' object");
+			goto quit;
+		}
+
+		samples = tmp;
+
+		for (i = 0; i < SEGMENT_SAMPLES; i++)
+			samples[num_samples + i] = (float)(name[i % strlen(name)] - 'a') / 32.0f;
+
+		num_samples += SEGMENT_SAMPLES;
+		itr = SItemNext(itr, error);
+	}
+
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "make_audio",
+				  "Failed to make the samples of the segments"))
+		goto quit;
+
+	stream = SAudioStreamGetFromUtt(utt, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "make_audio",
+				  "Call to \"SAudioStreamGetFromUtt\" failed"))
+		goto quit;
+
+	if (stream != NULL)
+	{
+		SAudioStreamWrite(stream, samples, num_samples, SAMPLE_RATE, error);
+		S_CHK_ERR(error, S_CONTERR,
+				  "make_audio",
+				  "Call to \"SAudioStreamWrite\" failed");
+		goto quit;
+	}
+
+	audio = S_NEW(SAudio, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "make_audio",
+				  "Failed to create new 'SAudio' object"))
+		goto quit;
+
+	audio->sample_rate = SAMPLE_RATE;
+	audio->num_samples = num_samples;
+	audio->samples = samples;
+	samples = NULL;
+
+	SUtteranceSetFeature(utt, "audio", S_OBJECT(audio), error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "make_audio",
+				  "Call to \"SUtteranceSetFeature\" failed"))
+		S_DELETE(audio, "make_audio", error);
+
+quit:
+	if (samples != NULL)
+		S_FREE(samples);
+}
+
+
+/* add the audio utterance processor and utterance type to the voice */
+static void add_audio_utt_type(SVoice *voice, s_erc *error)
+{
+	SUttProcessor *uttProc;
+	const SList *textUttType;
+	SList *uttType;
+	SIterator *itr;
+
+
+	S_CLR_ERR(error);
+
+	uttProc = (SUttProcessor*)SObjectNewFromName("SUttProcessorCB", error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "add_audio_utt_type",
+				  "Failed to create new 'SUttProcessorCB' object"))
+		return;
+
+	S_UTTPROCESSOR_CB_CALL(uttProc, set_callback)(S_UTTPROCESSOR_CB(uttProc),
+												  make_audio, NULL, &num_runs, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "add_audio_utt_type",
+				  "Call to method \"set_callback\" failed"))
+	{
+		S_DELETE(uttProc, "add_audio_utt_type", error);
+		return;
+	}
+
+	SUttProcessorInit(&uttProc, voice, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "add_audio_utt_type",
+				  "Call to \"SUttProcessorInit\" failed"))
+		return;
+
+	SVoiceSetUttProc(voice, AUDIO_UTT_PROC, uttProc, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "add_audio_utt_type",
+				  "Call to \"SVoiceSetUttProc\" failed"))
+	{
+		S_DELETE(uttProc, "add_audio_utt_type", error);
+		return;
+	}
+
+	/* the processors of the "text" utterance type and the audio */
+	textUttType = SVoiceGetUttType(voice, "text", error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "add_audio_utt_type",
+				  "Call to \"SVoiceGetUttType\" failed"))
+		return;
+
+	uttType = S_LIST(S_NEW(SListList, error));
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "add_audio_utt_type",
+				  "Failed to create new 'SListList' object"))
+		return;
+
+	itr = S_ITERATOR_GET(textUttType, error);
+	while ((*error == S_SUCCESS) && (itr != NULL))
+	{
+		SListAppend(uttType,
+					SObjectSetString(SObjectGetString(SIteratorObject(itr, error), error),
+									 error),
+					error);
+		if (*error != S_SUCCESS)
+			break;
+
+		itr = SIteratorNext(itr);
+	}
+
+	if (itr != NULL)
+		S_DELETE(itr, "add_audio_utt_type", error);
+
+	SListAppend(uttType, SObjectSetString(AUDIO_UTT_PROC, error), error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "add_audio_utt_type",
+				  "Failed to make the utterance processors list"))
+	{
+		S_DELETE(uttType, "add_audio_utt_type", error);
+		return;
+	}
+
+	SVoiceSetUttType(voice, AUDIO_UTT_TYPE, uttType, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "add_audio_utt_type",
+				  "Call to \"SVoiceSetUttType\" failed"))
+		S_DELETE(uttType, "add_audio_utt_type", error);
+}
+
+
+/* are the samples the ones synthesized without a cache */
+static s_bool check_samples(const float *samples, uint32 num_samples, uint32 sample_rate)
+{
+	if ((samples == NULL) || (expected == NULL))
+		return FALSE;
+
+	return ((num_samples == expected_num)
+			&& (sample_rate == SAMPLE_RATE)
+			&& (memcmp(samples, expected, sizeof(float) * num_samples) == 0));
+}
+
+
+/* synthesize the text with SVoiceSynthUtt, is the "audio" feature the expected one */
+static s_bool synth_utt(const SVoice *voice, const char *text, s_erc *error)
+{
+	SUtterance *utt;
+	const SAudio *audio;
+	s_bool same;
+
+
+	S_CLR_ERR(error);
+
+	utt = SVoiceSynthUtt(voice, AUDIO_UTT_TYPE, SObjectSetString(text, error), error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "synth_utt",
+				  "Call to \"SVoiceSynthUtt\" failed"))
+		return FALSE;
+
+	audio = (const SAudio*)SUtteranceGetFeature(utt, "audio", error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "synth_utt",
+				  "Call to \"SUtteranceGetFeature\" failed"))
+	{
+		S_DELETE(utt, "synth_utt", error);
+		return FALSE;
+	}
+
+	/* the first synthesis, without a cache, gives the expected audio */
+	if ((expected == NULL) && (audio != NULL))
+	{
+		expected_num = audio->num_samples;
+		expected = S_MALLOC(float, expected_num);
+		if (expected != NULL)
+			memcpy(expected, audio->samples, sizeof(float) * expected_num);
+	}
+
+	same = (audio != NULL) && check_samples(audio->samples, audio->num_samples,
+											audio->sample_rate);
+	S_DELETE(utt, "synth_utt", error);
+	return same;
+}
+
+
+/*
+ * synthesize the text with SVoiceReSynthUtt of an utterance with an
+ * audio stream, are the samples of the stream the expected ones
+ */
+static s_bool synth_stream(const SVoice *voice, const char *text, s_erc *error)
+{
+	SUtterance *utt;
+	SAudioStream *stream;
+	const float *samples;
+	uint32 num_samples;
+	uint32 sample_rate;
+	s_bool same = FALSE;
+
+
+	S_CLR_ERR(error);
+
+	utt = S_NEW(SUtterance, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "synth_stream",
+				  "Failed to create new 'SUtterance' object"))
+		return FALSE;
+
+	SUtteranceInit(&utt, voice, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "synth_stream",
+				  "Call to \"SUtteranceInit\" failed"))
+		return FALSE;
+
+	SUtteranceSetFeature(utt, "input", SObjectSetString(text, error), error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "synth_stream",
+				  "Call to \"SUtteranceSetFeature\" failed"))
+		goto quit;
+
+	/* a stream that keeps its samples, the utterance holds it */
+	stream = S_NEW(SAudioStream, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "synth_stream",
+				  "Failed to create new 'SAudioStream' object"))
+		goto quit;
+
+	SAudioStreamInit(&stream, 0, NULL, NULL, TRUE, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "synth_stream",
+				  "Call to \"SAudioStreamInit\" failed"))
+		goto quit;
+
+	SUtteranceSetFeature(utt, "audio-stream", S_OBJECT(stream), error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "synth_stream",
+				  "Call to \"SUtteranceSetFeature\" failed"))
+	{
+		S_DELETE(stream, "synth_stream", error);
+		goto quit;
+	}
+
+	SVoiceReSynthUtt(voice, AUDIO_UTT_TYPE, utt, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "synth_stream",
+				  "Call to \"SVoiceReSynthUtt\" failed"))
+		goto quit;
+
+	samples = SAudioStreamGetSamples(stream, &num_samples, error);
+	sample_rate = SAudioStreamGetSampleRate(stream, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "synth_stream",
+				  "Failed to get the samples of the audio stream"))
+		goto quit;
+
+	same = check_samples(samples, num_samples, sample_rate);
+
+quit:
+	S_DELETE(utt, "synth_stream", error);
+	return same;
+}
+
+
+/* a new cache, with a disk tier in dir if not NULL, used by the voice */
+static SSynthCache *set_cache(SVoice *voice, const char *dir, s_erc *error)
+{
+	SSynthCache *cache;
+
+
+	S_CLR_ERR(error);
+
+	cache = S_NEW(SSynthCache, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "set_cache",
+				  "Failed to create new 'SSynthCache' object"))
+		return NULL;
+
+	SSynthCacheInit(&cache, 1 << 20, dir, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "set_cache",
+				  "Call to \"SSynthCacheInit\" failed"))
+		return NULL;
+
+	/* our reference, for the counters after the voice released it */
+	SObjectIncRef(S_OBJECT(cache));
+
+	SVoiceSetSynthCache(voice, cache, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "set_cache",
+				  "Call to \"SVoiceSetSynthCache\" failed"))
+	{
+		S_DELETE(cache, "set_cache", error);
+		return NULL;
+	}
+
+	return cache;
+}
+
+
+static void print_counters(const char *name, const SSynthCache *cache, s_erc *error)
+{
+	SMap *counters;
+
+
+	S_CLR_ERR(error);
+
+	counters = SSynthCacheGetCounters(cache, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "print_counters",
+				  "Call to \"SSynthCacheGetCounters\" failed"))
+		return;
+
+	printf("%s: %d memory hits, %d disk hits, %d misses\n", name,
+		   (int)SMapGetInt(counters, "memory-hits", error),
+		   (int)SMapGetInt(counters, "disk-hits", error),
+		   (int)SMapGetInt(counters, "misses", error));
+	S_DELETE(counters, "print_counters", error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "print_counters",
+			  "Failed to get the counters");
+}
+
+
+/* print the result of a synthesis and the number of processor runs */
+static void print_result(const char *name, s_bool same, int runs_before, int *rv)
+{
+	printf("%s: %s audio, %d runs\n", name, same ? "same" : "different",
+		   num_runs - runs_before);
+	if (!same)
+		*rv = 1;
+}
+
+
+/************************************************************************************/
+/*                                                                                  */
+/*  Main function                                                                   */
+/*                                                                                  */
+/************************************************************************************/
+
+
+int main(int argc, char **argv)
+{
+	s_erc error = S_SUCCESS;
+	int i;
+	const char *voicefile = NULL;
+	const char *text = NULL;
+	const char *dir = NULL;
+	SPlugin *audioPlugin = NULL;
+	SPlugin *callbackPlugin = NULL;
+	SVoice *voice = NULL;
+	SSynthCache *memoryCache = NULL;
+	SSynthCache *diskCache = NULL;
+	SSynthCache *reopenedCache = NULL;
+	s_bool same;
+	int runs;
+	int rv = 0;
+
+	/*
+	 * initialize speect
+	 */
+	error = speect_init(NULL);
+	if (error != S_SUCCESS)
+	{
+		printf("Failed to initialize Speect\n");
+		return 1;
+	}
+
+	/* parse options */
+	for (i = 1; i < argc; i++)
+	{
+		if ((strcmp(argv[i], "-h") == 0) || (strcmp(argv[i], "--help") == 0))
+			usage(0);
+		else if ((strcmp(argv[i], "-t") == 0) && (i + 1 < argc))
+			text = argv[++i];
+		else if ((strcmp(argv[i], "-v") == 0) && (i + 1 < argc))
+			voicefile = argv[++i];
+		else if ((strcmp(argv[i], "-d") == 0) && (i + 1 < argc))
+			dir = argv[++i];
+	}
+
+	if ((voicefile == NULL) || (text == NULL) || (dir == NULL))
+	{
+		S_CTX_ERR(&error, S_ARGERROR,
+				  "main",
+				  "Arguments are not optional, see usage");
+		usage(1);
+	}
+
+	/* the audio and callback utterance processor classes */
+	audioPlugin = s_pm_load_plugin("audio.spi", &error);
+	if (S_CHK_ERR(&error, S_CONTERR,
+				  "main",
+				  "Call to \"s_pm_load_plugin\" failed"))
+		goto quit;
+
+	callbackPlugin = s_pm_load_plugin("uttproc_cb.spi", &error);
+	if (S_CHK_ERR(&error, S_CONTERR,
+				  "main",
+				  "Call to \"s_pm_load_plugin\" failed"))
+		goto quit;
+
+	voice = s_vm_load_voice(voicefile, &error);
+	if (S_CHK_ERR(&error, S_CONTERR,
+				  "main",
+				  "Call to \"s_vm_load_voice\" failed"))
+		goto quit;
+
+	add_audio_utt_type(voice, &error);
+	if (S_CHK_ERR(&error, S_CONTERR,
+				  "main",
+				  "Call to \"add_audio_utt_type\" failed"))
+		goto quit;
+
+	/* the expected audio, without a cache */
+	synth_utt(voice, text, &error);
+	if (S_CHK_ERR(&error, S_CONTERR,
+				  "main",
+				  "Call to \"synth_utt\" failed"))
+		goto quit;
+
+	if (expected == NULL)
+	{
+		S_CTX_ERR(&error, S_FAILURE,
+				  "main",
+				  "The utterance type made no audio");
+		goto quit;
+	}
+
+	/* audio objects of SVoiceSynthUtt, memory tier */
+	memoryCache = set_cache(voice, NULL, &error);
+	if (S_CHK_ERR(&error, S_CONTERR,
+				  "main",
+				  "Call to \"set_cache\" failed"))
+		goto quit;
+
+	runs = num_runs;
+	same = synth_utt(voice, text, &error);
+	print_result("utterance miss", same, runs, &rv);
+
+	runs = num_runs;
+	same = synth_utt(voice, text, &error);
+	print_result("utterance hit", same, runs, &rv);
+
+	print_counters("memory cache", memoryCache, &error);
+	if (S_CHK_ERR(&error, S_CONTERR,
+				  "main",
+				  "Failed to synthesize with the memory cache"))
+		goto quit;
+
+	/* samples of an audio stream, disk tier */
+	diskCache = set_cache(voice, dir, &error);
+	if (S_CHK_ERR(&error, S_CONTERR,
+				  "main",
+				  "Call to \"set_cache\" failed"))
+		goto quit;
+
+	runs = num_runs;
+	same = synth_stream(voice, text, &error);
+	print_result("stream miss", same, runs, &rv);
+
+	runs = num_runs;
+	same = synth_stream(voice, text, &error);
+	print_result("stream hit", same, runs, &rv);
+
+	print_counters("disk cache", diskCache, &error);
+	if (S_CHK_ERR(&error, S_CONTERR,
+				  "main",
+				  "Failed to synthesize with the disk cache"))
+		goto quit;
+
+	/* a new cache of the same directory has the entry on disk only */
+	reopenedCache = set_cache(voice, dir, &error);
+	if (S_CHK_ERR(&error, S_CONTERR,
+				  "main",
+				  "Call to \"set_cache\" failed"))
+		goto quit;
+
+	runs = num_runs;
+	same = synth_stream(voice, text, &error);
+	print_result("stream disk hit", same, runs, &rv);
+
+	print_counters("reopened disk cache", reopenedCache, &error);
+	if (S_CHK_ERR(&error, S_CONTERR,
+				  "main",
+				  "Failed to synthesize with the reopened disk cache"))
+		goto quit;
+
+quit:
+	if (error != S_SUCCESS)
+		rv = 1;
+
+	/* the voice releases its cache reference, then we release ours */
+	if (voice != NULL)
+		S_DELETE(voice, "main", &error);
+
+	if (memoryCache != NULL)
+		S_DELETE(memoryCache, "main", &error);
+
+	if (diskCache != NULL)
+		S_DELETE(diskCache, "main", &error);
+
+	if (reopenedCache != NULL)
+		S_DELETE(reopenedCache, "main", &error);
+
+	if (expected != NULL)
+		S_FREE(expected);
+
+	if (callbackPlugin != NULL)
+		S_DELETE(callbackPlugin, "main", &error);
+
+	if (audioPlugin != NULL)
+		S_DELETE(audioPlugin, "main", &error);
+
+	/*
+	 * quit speect
+	 */
+	error = speect_quit();
+	if (error != S_SUCCESS)
+	{
+		printf("Call to 'speect_quit' failed\n");
+		return 1;
+	}
+
+	return rv;
+}
@@ -0,0 +1,459 @@
+/************************************************************************************/
+/* Copyright (c) 2008-2011 The Department of Arts and Culture,                      */
+/* The Government of the Republic of South Africa.                                  */
+/*                                                                                  */
+/* Contributors:  Meraka Institute, CSIR, South Africa.                             */
+/*                                                                                  */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy     */
+/* of this software and associated documentation files (the "Software"), to deal    */
+/* in the Software without restriction, including without limitation the rights     */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        */
+/* copies of the Software, and to permit persons to whom the Software is            */
+/* furnished to do so, subject to the following conditions:                         */
+/* The above copyright notice and this permission notice shall be included in       */
+/* all copies or substantial portions of the Software.                              */
+/*                                                                                  */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN        */
+/* THE SOFTWARE.                                                                    */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* AUTHOR  : Speect contributors                                                    */
+/* DATE    : 19 October 2026                                                        */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* Synthesis worker pool test.                                                      */
+/*                                                                                  */
+/* Synthesizes the same text through an SSynthPool with futures and with            */
+/* callbacks, through a pool with a queue of one request, and deletes futures       */
+/* before they are waited on. Every result is compared to the Segment relation     */
+/* of the text synthesized directly with the voice.                                 */
+/*                                                                                  */
+/************************************************************************************/
+
+#include <stdio.h>
+#include "speect.h"
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Defines                                                                          */
+/*                                                                                  */
+/************************************************************************************/
+
+/* number of requests of every part of the test */
+#define NUM_REQUESTS 16
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static variables                                                                 */
+/*                                                                                  */
+/************************************************************************************/
+
+/* Segment relation of the text synthesized directly with the voice */
+static char *expected = NULL;
+
+/* callback results, the callbacks are called from the worker threads */
+S_DECLARE_MUTEX_STATIC(callback_mutex);
+static int callbacks_ok = 0;
+
+
+/************************************************************************************/
+/*                                                                                  */
+/*  Static function implementations                                                 */
+/*                                                                                  */
+/************************************************************************************/
+
+static void usage(int rv)
+{
+    printf("usage: synth_pool_test -n NUMWORKERS -t TEXT -v VOICEFILE\n"
+           "  Synthesizes the text in TEXT, with voice specification in VOICEFILE,\n"
+		   "  through a synthesis pool with NUMWORKERS worker threads and\n"
+		   "  compares the results to direct synthesis with the voice.\n"
+		   "  TEXT and VOICEFILE are not optional.\n"
+           "  --help      Output usage string\n");
+	exit(rv);
+}
+
+
+/* the names of the Segment relation items, space separated */
+static char *get_segments(const SUtterance *utt, s_erc *error)
+{
+	const SRelation *segmentRel;
+	const SItem *itr;
+	char *segments;
+	char *tmp;
+
+
+	S_CLR_ERR(error);
+
+	segmentRel = SUtteranceGetRelation(utt, "Segment", error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "get_segments",
+				  "Call to \"SUtteranceGetRelation\" failed"))
+		return NULL;
+
+	itr = SRelationHead(segmentRel, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "get_segments",
+				  "Call to \"SRelationHead\" failed"))
+		return NULL;
+
+	segments = s_strdup("", error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "get_segments",
+				  "Call to \"s_strdup\" failed"))
+		return NULL;
+
+	while (itr != NULL)
+	{
+		s_asprintf(&tmp, error, "%s %s", segments, SItemGetName(itr, error));
+		S_FREE(segments);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "get_segments",
+					  "Call to \"s_asprintf/SItemGetName\" failed"))
+			return NULL;
+
+		segments = tmp;
+		itr = SItemNext(itr, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "get_segments",
+					  "Call to \"SItemNext\" failed"))
+		{
+			S_FREE(segments);
+			return NULL;
+		}
+	}
+
+	return segments;
+}
+
+
+/* is the utterance the same as the directly synthesized one */
+static s_bool check_utt(const SUtterance *utt)
+{
+	s_erc error = S_SUCCESS;
+	char *segments;
+	s_bool same;
+
+
+	if (utt == NULL)
+		return FALSE;
+
+	segments = get_segments(utt, &error);
+	if (S_CHK_ERR(&error, S_CONTERR,
+				  "check_utt",
+				  "Call to \"get_segments\" failed"))
+		return FALSE;
+
+	same = (s_strcmp(segments, expected, &error) == 0);
+	S_FREE(segments);
+
+	return same;
+}
+
+
+static void callback(SUtterance *utt, s_erc synth_error, void *userdata)
+{
+	s_erc error = S_SUCCESS;
+	s_bool same;
+
+
+	S_UNUSED(userdata);
+
+	same = (synth_error == S_SUCCESS) && check_utt(utt);
+
+	s_mutex_lock(&callback_mutex);
+	if (same)
+		callbacks_ok++;
+	s_mutex_unlock(&callback_mutex);
+
+	if (utt != NULL)
+		S_DELETE(utt, "callback", &error);
+}
+
+
+/* submit NUM_REQUESTS requests, returns the number of correct results */
+static int run_futures(SSynthPool *pool, const char *text, s_erc *error)
+{
+	SSynthFuture *futures[NUM_REQUESTS];
+	SUtterance *utt;
+	int futures_ok = 0;
+	int i;
+
+
+	S_CLR_ERR(error);
+
+	for (i = 0; i < NUM_REQUESTS; i++)
+	{
+		futures[i] = SSynthPoolSubmit(pool, "text", SObjectSetString(text, error), error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "run_futures",
+					  "Call to \"SSynthPoolSubmit\" failed"))
+			break;
+	}
+
+	while (i-- > 0)
+	{
+		s_erc local_err = S_SUCCESS;
+
+
+		utt = SSynthFutureWait(futures[i], &local_err);
+		if ((local_err == S_SUCCESS) && check_utt(utt))
+			futures_ok++;
+
+		if (utt != NULL)
+			S_DELETE(utt, "run_futures", &local_err);
+
+		S_DELETE(futures[i], "run_futures", &local_err);
+	}
+
+	return futures_ok;
+}
+
+
+/************************************************************************************/
+/*                                                                                  */
+/*  Main function                                                                   */
+/*                                                                                  */
+/************************************************************************************/
+
+
+int main(int argc, char **argv)
+{
+	s_erc error = S_SUCCESS;
+	int i;
+	int scomp;
+	const char *voicefile = NULL;
+	const char *text = NULL;
+	uint num_workers = 4;
+	SVoice *voice = NULL;
+	SSynthPool *pool = NULL;
+	SSynthFuture *future;
+	SUtterance *utt;
+	int futures_ok;
+	int queue_ok;
+	int rv = 0;
+
+	/*
+	 * initialize speect
+	 */
+	error = speect_init(NULL);
+	if (error != S_SUCCESS)
+	{
+		printf("Failed to initialize Speect\n");
+		return 1;
+	}
+
+	s_mutex_init(&callback_mutex);
+
+	/* parse options */
+    for (i=1; i<argc; i++)
+    {
+		scomp = s_strcmp(argv[i],"-h", &error);
+		if (S_CHK_ERR(&error, S_CONTERR,
+					  "main",
+					  "Call to \"s_strcmp\" failed"))
+			return 1;
+
+		if (scomp == 0)
+			usage(0);
+
+		scomp = s_strcmp(argv[i],"--help", &error);
+		if (S_CHK_ERR(&error, S_CONTERR,
+					  "main",
+					  "Call to \"s_strcmp\" failed"))
+			return 1;
+
+		if (scomp == 0)
+			usage(0);
+
+		scomp = s_strcmp(argv[i],"-t", &error);
+		if (S_CHK_ERR(&error, S_CONTERR,
+					  "main",
+					  "Call to \"s_strcmp\" failed"))
+			return 1;
+
+		if ((scomp == 0) && (i + 1 < argc))
+		{
+			text = argv[i+1];
+			i++;
+		}
+
+		scomp = s_strcmp(argv[i],"-v", &error);
+		if (S_CHK_ERR(&error, S_CONTERR,
+					  "main",
+					  "Call to \"s_strcmp\" failed"))
+			return 1;
+
+		if ((scomp == 0) && (i + 1 < argc))
+		{
+			voicefile = argv[i+1];
+			i++;
+		}
+
+		scomp = s_strcmp(argv[i],"-n", &error);
+		if (S_CHK_ERR(&error, S_CONTERR,
+					  "main",
+					  "Call to \"s_strcmp\" failed"))
+			return 1;
+
+		if ((scomp == 0) && (i + 1 < argc))
+		{
+			num_workers = (uint)s_atof(argv[i+1], &error);
+			if (S_CHK_ERR(&error, S_CONTERR,
+						  "main",
+						  "Call to \"s_atof\" failed"))
+				return 1;
+			i++;
+		}
+	}
+
+	if ((voicefile == NULL) || (text == NULL))
+	{
+		S_CTX_ERR(&error, S_ARGERROR,
+				  "main",
+				  "Arguments are not optional, see usage");
+		usage(1);
+	}
+
+	/* load the voice once, it is shared by all the workers */
+	voice = s_vm_load_voice(voicefile, &error);
+	if (S_CHK_ERR(&error, S_CONTERR,
+				  "main",
+				  "Call to \"s_vm_load_voice\" failed"))
+		goto quit;
+
+	/* the reference result */
+	utt = SVoiceSynthUtt(voice, "text", SObjectSetString(text, &error), &error);
+	if (S_CHK_ERR(&error, S_CONTERR,
+				  "main",
+				  "Call to \"SVoiceSynthUtt\" failed"))
+		goto quit;
+
+	expected = get_segments(utt, &error);
+	S_DELETE(utt, "main", &error);
+	if (S_CHK_ERR(&error, S_CONTERR,
+				  "main",
+				  "Call to \"get_segments\" failed"))
+		goto quit;
+
+	/* futures and callbacks */
+	pool = S_NEW(SSynthPool, &error);
+	if (S_CHK_ERR(&error, S_CONTERR,
+				  "main",
+				  "Failed to create new 'SSynthPool' object"))
+		goto quit;
+
+	SSynthPoolInit(&pool, voice, num_workers, NUM_REQUESTS, &error);
+	if (S_CHK_ERR(&error, S_CONTERR,
+				  "main",
+				  "Call to \"SSynthPoolInit\" failed"))
+		goto quit;
+
+	futures_ok = run_futures(pool, text, &error);
+	if (S_CHK_ERR(&error, S_CONTERR,
+				  "main",
+				  "Call to \"run_futures\" failed"))
+		goto quit;
+
+	printf("futures: %d of %d\n", futures_ok, NUM_REQUESTS);
+	if (futures_ok != NUM_REQUESTS)
+		rv = 1;
+
+	for (i = 0; i < NUM_REQUESTS; i++)
+	{
+		SSynthPoolSubmitCallback(pool, "text", SObjectSetString(text, &error),
+								 callback, NULL, &error);
+		if (S_CHK_ERR(&error, S_CONTERR,
+					  "main",
+					  "Call to \"SSynthPoolSubmitCallback\" failed"))
+			goto quit;
+	}
+
+	/* deleting the pool finishes the requests in the queue */
+	S_DELETE(pool, "main", &error);
+	pool = NULL;
+
+	printf("callbacks: %d of %d\n", callbacks_ok, NUM_REQUESTS);
+	if (callbacks_ok != NUM_REQUESTS)
+		rv = 1;
+
+	/* a queue of one request, submitting blocks until a worker takes it */
+	pool = S_NEW(SSynthPool, &error);
+	if (S_CHK_ERR(&error, S_CONTERR,
+				  "main",
+				  "Failed to create new 'SSynthPool' object"))
+		goto quit;
+
+	SSynthPoolInit(&pool, voice, num_workers, 1, &error);
+	if (S_CHK_ERR(&error, S_CONTERR,
+				  "main",
+				  "Call to \"SSynthPoolInit\" failed"))
+		goto quit;
+
+	queue_ok = run_futures(pool, text, &error);
+	if (S_CHK_ERR(&error, S_CONTERR,
+				  "main",
+				  "Call to \"run_futures\" failed"))
+		goto quit;
+
+	printf("full queue: %d of %d\n", queue_ok, NUM_REQUESTS);
+	if (queue_ok != NUM_REQUESTS)
+		rv = 1;
+
+	/*
+	 * futures deleted before they are waited on, deleting waits for
+	 * the worker and deletes the utterance
+	 */
+	for (i = 0; i < NUM_REQUESTS; i++)
+	{
+		future = SSynthPoolSubmit(pool, "text", SObjectSetString(text, &error), &error);
+		if (S_CHK_ERR(&error, S_CONTERR,
+					  "main",
+					  "Call to \"SSynthPoolSubmit\" failed"))
+			goto quit;
+
+		S_DELETE(future, "main", &error);
+		if (S_CHK_ERR(&error, S_CONTERR,
+					  "main",
+					  "Failed to delete 'SSynthFuture' object"))
+			goto quit;
+	}
+
+	printf("deleted futures: %d\n", NUM_REQUESTS);
+
+quit:
+	if (error != S_SUCCESS)
+		rv = 1;
+
+	if (pool != NULL)
+		S_DELETE(pool, "main", &error);
+
+	if (expected != NULL)
+		S_FREE(expected);
+
+	if (voice != NULL)
+		S_DELETE(voice, "main", &error);
+
+	s_mutex_destroy(&callback_mutex);
+
+	/*
+	 * quit speect
+	 */
+	error = speect_quit();
+	if (error != S_SUCCESS)
+	{
+		printf("Call to 'speect_quit' failed\n");
+		return 1;
+	}
+
+	return rv;
+}
@@ -0,0 +1,358 @@
+/************************************************************************************/
+/* Copyright (c) 2008-2011 The Department of Arts and Culture,                      */
+/* The Government of the Republic of South Africa.                                  */
+/*                                                                                  */
+/* Contributors:  Meraka Institute, CSIR, South Africa.                             */
+/*                                                                                  */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy     */
+/* of this software and associated documentation files (the "Software"), to deal    */
+/* in the Software without restriction, including without limitation the rights     */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        */
+/* copies of the Software, and to permit persons to whom the Software is            */
+/* furnished to do so, subject to the following conditions:                         */
+/* The above copyright notice and this permission notice shall be included in       */
+/* all copies or substantial portions of the Software.                              */
+/*                                                                                  */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN        */
+/* THE SOFTWARE.                                                                    */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* AUTHOR  : Speect contributors                                                    */
+/* DATE    : 19 October 2026                                                        */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* Voice data reload test.                                                          */
+/*                                                                                  */
+/* Synthesizes the same text through an SSynthPool while the addendum, phoneset     */
+/* and g2p rules of the voice are reloaded with SVoiceReloadData. Every result,     */
+/* and a direct synthesis after the reloads, is compared to the Segment relation    */
+/* of the text synthesized directly with the voice before any reload.               */
+/*                                                                                  */
+/************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "speect.h"
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Defines                                                                          */
+/*                                                                                  */
+/************************************************************************************/
+
+/* number of synthesis requests */
+#define NUM_REQUESTS 32
+
+/* a data object is reloaded after every RELOAD_EVERY requests */
+#define RELOAD_EVERY 4
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static variables                                                                 */
+/*                                                                                  */
+/************************************************************************************/
+
+/* Segment relation of the text synthesized directly with the voice */
+static char *expected = NULL;
+
+/* the reloaded data objects, in turn */
+static const char * const reload_keys[] = { "addendum", "phoneset", "g2p" };
+
+
+/************************************************************************************/
+/*                                                                                  */
+/*  Static function implementations                                                 */
+/*                                                                                  */
+/************************************************************************************/
+
+static void usage(int rv)
+{
+    printf("usage: synth_reload_test -n NUMWORKERS -t TEXT -v VOICEFILE\n"
+           "  Synthesizes the text in TEXT, with voice specification in VOICEFILE,\n"
+		   "  through a synthesis pool with NUMWORKERS worker threads while the\n"
+		   "  voice data is reloaded, and compares the results to direct\n"
+		   "  synthesis with the voice.\n"
+		   "  TEXT and VOICEFILE are not optional.\n"
+           "  --help      Output usage string\n");
+	exit(rv);
+}
+
+
+/* the names of the Segment relation items, space separated */
+static char *get_segments(const SUtterance *utt, s_erc *error)
+{
+	const SRelation *segmentRel;
+	const SItem *itr;
+	char *segments;
+	char *tmp;
+
+
+	S_CLR_ERR(error);
+
+	segmentRel = SUtteranceGetRelation(utt, "Segment", error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "get_segments",
+				  "Call to \"SUtteranceGetRelation\" failed"))
+		return NULL;
+
+	itr = SRelationHead(segmentRel, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "get_segments",
+				  "Call to \"SRelationHead\" failed"))
+		return NULL;
+
+	segments = s_strdup("", error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "get_segments",
+				  "Call to \"s_strdup\" failed"))
+		return NULL;
+
+	while (itr != NULL)
+	{
+		s_asprintf(&tmp, error, "%s %s", segments, SItemGetName(itr, error));
+		S_FREE(segments);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "get_segments",
+					  "Call to \"s_asprintf/SItemGetName\" failed"))
+			return NULL;
+
+		segments = tmp;
+		itr = SItemNext(itr, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "get_segments",
+					  "Call to \"SItemNext\" failed"))
+		{
+			S_FREE(segments);
+			return NULL;
+		}
+	}
+
+	return segments;
+}
+
+
+/* is the utterance the same as the directly synthesized one */
+static s_bool check_utt(const SUtterance *utt)
+{
+	s_erc error = S_SUCCESS;
+	char *segments;
+	s_bool same;
+
+
+	if (utt == NULL)
+		return FALSE;
+
+	segments = get_segments(utt, &error);
+	if (S_CHK_ERR(&error, S_CONTERR,
+				  "check_utt",
+				  "Call to \"get_segments\" failed"))
+		return FALSE;
+
+	same = (s_strcmp(segments, expected, &error) == 0);
+	S_FREE(segments);
+
+	return same;
+}
+
+
+/************************************************************************************/
+/*                                                                                  */
+/*  Main function                                                                   */
+/*                                                                                  */
+/************************************************************************************/
+
+
+int main(int argc, char **argv)
+{
+	s_erc error = S_SUCCESS;
+	int i;
+	const char *voicefile = NULL;
+	const char *text = NULL;
+	uint num_workers = 4;
+	SVoice *voice = NULL;
+	SSynthPool *pool = NULL;
+	SSynthFuture *futures[NUM_REQUESTS];
+	int num_futures = 0;
+	SUtterance *utt;
+	int syntheses_ok = 0;
+	int reloads = 0;
+	int reloads_ok = 0;
+	s_bool after_ok;
+	int rv = 0;
+
+	/*
+	 * initialize speect
+	 */
+	error = speect_init(NULL);
+	if (error != S_SUCCESS)
+	{
+		printf("Failed to initialize Speect\n");
+		return 1;
+	}
+
+	/* parse options */
+	for (i = 1; i < argc; i++)
+	{
+		if ((strcmp(argv[i], "-h") == 0) || (strcmp(argv[i], "--help") == 0))
+			usage(0);
+		else if ((strcmp(argv[i], "-t") == 0) && (i + 1 < argc))
+			text = argv[++i];
+		else if ((strcmp(argv[i], "-v") == 0) && (i + 1 < argc))
+			voicefile = argv[++i];
+		else if ((strcmp(argv[i], "-n") == 0) && (i + 1 < argc))
+			num_workers = (uint)atoi(argv[++i]);
+	}
+
+	if ((voicefile == NULL) || (text == NULL))
+	{
+		S_CTX_ERR(&error, S_ARGERROR,
+				  "main",
+				  "Arguments are not optional, see usage");
+		usage(1);
+	}
+
+	voice = s_vm_load_voice(voicefile, &error);
+	if (S_CHK_ERR(&error, S_CONTERR,
+				  "main",
+				  "Call to \"s_vm_load_voice\" failed"))
+		goto quit;
+
+	/* the reference result */
+	utt = SVoiceSynthUtt(voice, "text", SObjectSetString(text, &error), &error);
+	if (S_CHK_ERR(&error, S_CONTERR,
+				  "main",
+				  "Call to \"SVoiceSynthUtt\" failed"))
+		goto quit;
+
+	expected = get_segments(utt, &error);
+	S_DELETE(utt, "main", &error);
+	if (S_CHK_ERR(&error, S_CONTERR,
+				  "main",
+				  "Call to \"get_segments\" failed"))
+		goto quit;
+
+	pool = S_NEW(SSynthPool, &error);
+	if (S_CHK_ERR(&error, S_CONTERR,
+				  "main",
+				  "Failed to create new 'SSynthPool' object"))
+		goto quit;
+
+	SSynthPoolInit(&pool, voice, num_workers, NUM_REQUESTS, &error);
+	if (S_CHK_ERR(&error, S_CONTERR,
+				  "main",
+				  "Call to \"SSynthPoolInit\" failed"))
+		goto quit;
+
+	/*
+	 * reload the data while the workers synthesize, the replaced data
+	 * objects must stay valid until the syntheses using them finish
+	 */
+	for (i = 0; i < NUM_REQUESTS; i++)
+	{
+		futures[num_futures] = SSynthPoolSubmit(pool, "text", SObjectSetString(text, &error),
+												&error);
+		if (S_CHK_ERR(&error, S_CONTERR,
+					  "main",
+					  "Call to \"SSynthPoolSubmit\" failed"))
+			goto quit;
+
+		num_futures++;
+
+		if ((i % RELOAD_EVERY) == 0)
+		{
+			s_erc local_err = S_SUCCESS;
+
+
+			SVoiceReloadData(voice, reload_keys[reloads % 3], &local_err);
+			if (!S_CHK_ERR(&local_err, S_CONTERR,
+						   "main",
+						   "Call to \"SVoiceReloadData\" failed for \"%s\"",
+						   reload_keys[reloads % 3]))
+				reloads_ok++;
+
+			reloads++;
+		}
+	}
+
+	while (num_futures-- > 0)
+	{
+		s_erc local_err = S_SUCCESS;
+
+
+		utt = SSynthFutureWait(futures[num_futures], &local_err);
+		if ((local_err == S_SUCCESS) && check_utt(utt))
+			syntheses_ok++;
+
+		if (utt != NULL)
+			S_DELETE(utt, "main", &local_err);
+
+		S_DELETE(futures[num_futures], "main", &local_err);
+	}
+
+	num_futures = 0;
+
+	printf("syntheses: %d of %d\n", syntheses_ok, NUM_REQUESTS);
+	if (syntheses_ok != NUM_REQUESTS)
+		rv = 1;
+
+	printf("reloads: %d of %d\n", reloads_ok, reloads);
+	if (reloads_ok != reloads)
+		rv = 1;
+
+	/* the voice synthesizes the same with the reloaded data */
+	utt = SVoiceSynthUtt(voice, "text", SObjectSetString(text, &error), &error);
+	if (S_CHK_ERR(&error, S_CONTERR,
+				  "main",
+				  "Call to \"SVoiceSynthUtt\" failed"))
+		goto quit;
+
+	after_ok = check_utt(utt);
+	S_DELETE(utt, "main", &error);
+
+	printf("after reloads: %s\n", after_ok ? "same" : "different");
+	if (!after_ok)
+		rv = 1;
+
+quit:
+	if (error != S_SUCCESS)
+		rv = 1;
+
+	while (num_futures-- > 0)
+	{
+		s_erc local_err = S_SUCCESS;
+
+
+		S_DELETE(futures[num_futures], "main", &local_err);
+	}
+
+	if (pool != NULL)
+		S_DELETE(pool, "main", &error);
+
+	if (expected != NULL)
+		S_FREE(expected);
+
+	if (voice != NULL)
+		S_DELETE(voice, "main", &error);
+
+	/*
+	 * quit speect
+	 */
+	error = speect_quit();
+	if (error != S_SUCCESS)
+	{
+		printf("Call to 'speect_quit' failed\n");
+		return 1;
+	}
+
+	return rv;
+}
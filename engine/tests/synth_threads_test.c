@@ -98,7 +98,7 @@ void *child_fn(void *args)
 		pthread_exit((void*)myargs);
 
 	/* load voice */
-	voice = s_vm_load_voice(myargs->voicefile, TRUE, error);
+	voice = s_vm_load_voice(myargs->voicefile, error);
 	if (S_CHK_ERR(error, S_CONTERR,
 				  "child_fn",
 				  "Call to \"s_vm_load_voice\" failed"))
@@ -187,7 +187,7 @@ int main(int argc, char **argv)
 	/*
 	 * initialize speect
 	 */
-	error = speect_init();
+	error = speect_init(NULL);
 	if (error != S_SUCCESS)
 	{
 		printf("Failed to initialize Speect\n");
@@ -0,0 +1,555 @@
+/************************************************************************************/
+/* Copyright (c) 2008-2011 The Department of Arts and Culture,                      */
+/* The Government of the Republic of South Africa.                                  */
+/*                                                                                  */
+/* Contributors:  Meraka Institute, CSIR, South Africa.                             */
+/*                                                                                  */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy     */
+/* of this software and associated documentation files (the "Software"), to deal    */
+/* in the Software without restriction, including without limitation the rights     */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        */
+/* copies of the Software, and to permit persons to whom the Software is            */
+/* furnished to do so, subject to the following conditions:                         */
+/* The above copyright notice and this permission notice shall be included in       */
+/* all copies or substantial portions of the Software.                              */
+/*                                                                                  */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN        */
+/* THE SOFTWARE.                                                                    */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* AUTHOR  : Speect contributors                                                    */
+/* DATE    : 19 October 2026                                                        */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* Utterance refill test.                                                           */
+/*                                                                                  */
+/* Refills one utterance with SVoiceSynthUttRefill, alternating between two texts,  */
+/* and compares every refilled utterance to a fresh utterance of the same text:     */
+/* the relations, their items (with daughters) and the item and utterance           */
+/* features must be the same. Also checks that an utterance reset with             */
+/* SUtteranceReset is the same as a new utterance.                                  */
+/*                                                                                  */
+/************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include "speect.h"
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Defines                                                                          */
+/*                                                                                  */
+/************************************************************************************/
+
+/* number of refills with each text */
+#define NUM_REFILLS 8
+
+/* deepest indented item level of a dump */
+#define MAX_DEPTH 8
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static variables                                                                 */
+/*                                                                                  */
+/************************************************************************************/
+
+/* indentation of the items in a dump, two spaces per level */
+static const char indent[2 * MAX_DEPTH + 1] = "                ";
+
+
+/************************************************************************************/
+/*                                                                                  */
+/*  Static function implementations                                                 */
+/*                                                                                  */
+/************************************************************************************/
+
+static void usage(int rv)
+{
+	printf("usage: utt_refill_test -t TEXT -o OTHERTEXT -v VOICEFILE\n"
+		   "  Refills an utterance with the texts in TEXT and OTHERTEXT in turn,\n"
+		   "  with voice specification in VOICEFILE, and compares it to fresh\n"
+		   "  utterances of the same texts.\n"
+		   "  TEXT, OTHERTEXT and VOICEFILE are not optional.\n"
+		   "  --help      Output usage string\n");
+	exit(rv);
+}
+
+
+/* append the formatted string to the dump */
+static void append(char **dump, s_erc *error, const char *fmt, ...)
+{
+	va_list args;
+	char *tmp;
+	char *joined;
+
+
+	S_CLR_ERR(error);
+
+	va_start(args, fmt);
+	s_vasprintf(&tmp, fmt, args, error);
+	va_end(args);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "append",
+				  "Call to \"s_vasprintf\" failed"))
+		return;
+
+	s_asprintf(&joined, error, "%s%s", *dump, tmp);
+	S_FREE(tmp);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "append",
+				  "Call to \"s_asprintf\" failed"))
+		return;
+
+	S_FREE(*dump);
+	*dump = joined;
+}
+
+
+static int compare_keys(const void *a, const void *b)
+{
+	return strcmp(*(const char * const *)a, *(const char * const *)b);
+}
+
+
+/*
+ * the keys of the list sorted, so that containers with the same
+ * contents give the same dump whatever their order
+ */
+static const char **sorted_keys(const SList *keys, size_t *num, s_erc *error)
+{
+	const char **sorted;
+	size_t i;
+
+
+	S_CLR_ERR(error);
+
+	*num = SListSize(keys, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "sorted_keys",
+				  "Call to \"SListSize\" failed"))
+		return NULL;
+
+	sorted = S_MALLOC(const char*, *num + 1);
+	if (sorted == NULL)
+	{
+		S_FTL_ERR(error, S_MEMERROR,
+				  "sorted_keys",
+				  "Failed to allocate memory for 'const char*' object");
+		return NULL;
+	}
+
+	for (i = 0; i < *num; i++)
+	{
+		sorted[i] = SObjectGetString(SListNth(keys, (uint32)i, error), error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "sorted_keys",
+					  "Call to \"SListNth/SObjectGetString\" failed"))
+		{
+			S_FREE(sorted);
+			return NULL;
+		}
+	}
+
+	qsort(sorted, *num, sizeof(const char*), compare_keys);
+	return sorted;
+}
+
+
+/* append a feature, primitive values are written out, others by type */
+static void append_feature(char **dump, const char *key, const SObject *value,
+						   s_erc *error)
+{
+	const char *type;
+
+
+	S_CLR_ERR(error);
+
+	type = SObjectType(value, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "append_feature",
+				  "Call to \"SObjectType\" failed"))
+		return;
+
+	if (strcmp(type, "SString") == 0)
+		append(dump, error, " %s=\"%s\"", key, SObjectGetString(value, error));
+	else if (strcmp(type, "SInt") == 0)
+		append(dump, error, " %s=%d", key, (int)SObjectGetInt(value, error));
+	else if (strcmp(type, "SFloat") == 0)
+		append(dump, error, " %s=%g", key, (double)SObjectGetFloat(value, error));
+	else
+		append(dump, error, " %s=<%s>", key, type);
+
+	S_CHK_ERR(error, S_CONTERR,
+			  "append_feature",
+			  "Failed to append feature \"%s\"", key);
+}
+
+
+/* append the item, its features and its daughters */
+static void append_item(char **dump, const SItem *item, int depth, s_erc *error)
+{
+	SList *keys;
+	const char **sorted;
+	size_t num;
+	size_t i;
+	const SItem *daughter;
+
+
+	S_CLR_ERR(error);
+
+	/* the name is one of the features */
+	append(dump, error, "\n%sitem:",
+		   indent + sizeof(indent) - 1 - ((depth < MAX_DEPTH) ? 2 * depth : 2 * MAX_DEPTH));
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "append_item",
+				  "Call to \"append\" failed"))
+		return;
+
+	keys = SItemFeatKeys(item, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "append_item",
+				  "Call to \"SItemFeatKeys\" failed"))
+		return;
+
+	if (keys != NULL)
+	{
+		sorted = sorted_keys(keys, &num, error);
+		for (i = 0; (*error == S_SUCCESS) && (i < num); i++)
+			append_feature(dump, sorted[i], SItemGetObject(item, sorted[i], error), error);
+
+		if (sorted != NULL)
+			S_FREE(sorted);
+
+		S_DELETE(keys, "append_item", error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "append_item",
+					  "Failed to append item features"))
+			return;
+	}
+
+	daughter = SItemDaughter(item, error);
+	while ((*error == S_SUCCESS) && (daughter != NULL))
+	{
+		append_item(dump, daughter, depth + 1, error);
+		if (*error != S_SUCCESS)
+			break;
+
+		daughter = SItemNext(daughter, error);
+	}
+
+	S_CHK_ERR(error, S_CONTERR,
+			  "append_item",
+			  "Failed to append item daughters");
+}
+
+
+/* a dump of the relations and features of the utterance */
+static char *dump_utt(const SUtterance *utt, s_erc *error)
+{
+	SList *keys;
+	const char **sorted = NULL;
+	size_t num;
+	size_t i;
+	const SRelation *rel;
+	const SItem *item;
+	char *dump;
+
+
+	S_CLR_ERR(error);
+
+	dump = s_strdup("features:", error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "dump_utt",
+				  "Call to \"s_strdup\" failed"))
+		return NULL;
+
+	keys = SUtteranceFeatKeys(utt, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "dump_utt",
+				  "Call to \"SUtteranceFeatKeys\" failed"))
+		goto quit_error;
+
+	if (keys != NULL)
+	{
+		sorted = sorted_keys(keys, &num, error);
+		for (i = 0; (*error == S_SUCCESS) && (i < num); i++)
+			append_feature(&dump, sorted[i],
+						   SUtteranceGetFeature(utt, sorted[i], error), error);
+
+		if (sorted != NULL)
+			S_FREE(sorted);
+
+		S_DELETE(keys, "dump_utt", error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "dump_utt",
+					  "Failed to dump utterance features"))
+			goto quit_error;
+	}
+
+	keys = SUtteranceRelationsKeys(utt, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "dump_utt",
+				  "Call to \"SUtteranceRelationsKeys\" failed"))
+		goto quit_error;
+
+	if (keys == NULL)
+		return dump;
+
+	sorted = sorted_keys(keys, &num, error);
+	for (i = 0; (*error == S_SUCCESS) && (i < num); i++)
+	{
+		append(&dump, error, "\nrelation %s:", sorted[i]);
+		if (*error != S_SUCCESS)
+			break;
+
+		rel = SUtteranceGetRelation(utt, sorted[i], error);
+		if (*error != S_SUCCESS)
+			break;
+
+		item = SRelationHead(rel, error);
+		while ((*error == S_SUCCESS) && (item != NULL))
+		{
+			append_item(&dump, item, 1, error);
+			if (*error != S_SUCCESS)
+				break;
+
+			item = SItemNext(item, error);
+		}
+	}
+
+	if (sorted != NULL)
+		S_FREE(sorted);
+
+	S_DELETE(keys, "dump_utt", error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "dump_utt",
+				  "Failed to dump utterance relations"))
+		goto quit_error;
+
+	return dump;
+
+quit_error:
+	S_FREE(dump);
+	return NULL;
+}
+
+
+/* is the dump of the utterance the given one */
+static s_bool check_utt(const SUtterance *utt, const char *expected)
+{
+	s_erc error = S_SUCCESS;
+	char *dump;
+	s_bool same;
+
+
+	dump = dump_utt(utt, &error);
+	if (S_CHK_ERR(&error, S_CONTERR,
+				  "check_utt",
+				  "Call to \"dump_utt\" failed"))
+		return FALSE;
+
+	same = (strcmp(dump, expected) == 0);
+	S_FREE(dump);
+
+	return same;
+}
+
+
+/* the dump of a fresh utterance of the text */
+static char *fresh_dump(const SVoice *voice, const char *text, s_erc *error)
+{
+	SUtterance *utt;
+	char *dump;
+
+
+	S_CLR_ERR(error);
+
+	utt = SVoiceSynthUtt(voice, "text", SObjectSetString(text, error), error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "fresh_dump",
+				  "Call to \"SVoiceSynthUtt\" failed"))
+		return NULL;
+
+	dump = dump_utt(utt, error);
+	S_DELETE(utt, "fresh_dump", error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "fresh_dump",
+				  "Call to \"dump_utt\" failed"))
+	{
+		if (dump != NULL)
+			S_FREE(dump);
+		return NULL;
+	}
+
+	return dump;
+}
+
+
+/************************************************************************************/
+/*                                                                                  */
+/*  Main function                                                                   */
+/*                                                                                  */
+/************************************************************************************/
+
+
+int main(int argc, char **argv)
+{
+	s_erc error = S_SUCCESS;
+	int i;
+	const char *voicefile = NULL;
+	const char *texts[2] = { NULL, NULL };
+	char *expected[2] = { NULL, NULL };
+	SVoice *voice = NULL;
+	SUtterance *utt = NULL;
+	SUtterance *empty = NULL;
+	char *expected_empty = NULL;
+	s_bool reset_ok;
+	int refills_ok = 0;
+	int rv = 0;
+
+	/*
+	 * initialize speect
+	 */
+	error = speect_init(NULL);
+	if (error != S_SUCCESS)
+	{
+		printf("Failed to initialize Speect\n");
+		return 1;
+	}
+
+	/* parse options */
+	for (i = 1; i < argc; i++)
+	{
+		if ((strcmp(argv[i], "-h") == 0) || (strcmp(argv[i], "--help") == 0))
+			usage(0);
+		else if ((strcmp(argv[i], "-t") == 0) && (i + 1 < argc))
+			texts[0] = argv[++i];
+		else if ((strcmp(argv[i], "-o") == 0) && (i + 1 < argc))
+			texts[1] = argv[++i];
+		else if ((strcmp(argv[i], "-v") == 0) && (i + 1 < argc))
+			voicefile = argv[++i];
+	}
+
+	if ((voicefile == NULL) || (texts[0] == NULL) || (texts[1] == NULL))
+	{
+		S_CTX_ERR(&error, S_ARGERROR,
+				  "main",
+				  "Arguments are not optional, see usage");
+		usage(1);
+	}
+
+	voice = s_vm_load_voice(voicefile, &error);
+	if (S_CHK_ERR(&error, S_CONTERR,
+				  "main",
+				  "Call to \"s_vm_load_voice\" failed"))
+		goto quit;
+
+	/* the reference dumps, of fresh utterances */
+	for (i = 0; i < 2; i++)
+	{
+		expected[i] = fresh_dump(voice, texts[i], &error);
+		if (S_CHK_ERR(&error, S_CONTERR,
+					  "main",
+					  "Call to \"fresh_dump\" failed"))
+			goto quit;
+	}
+
+	/* the utterance that is refilled, starting with the other text */
+	utt = SVoiceSynthUtt(voice, "text", SObjectSetString(texts[1], &error), &error);
+	if (S_CHK_ERR(&error, S_CONTERR,
+				  "main",
+				  "Call to \"SVoiceSynthUtt\" failed"))
+		goto quit;
+
+	for (i = 0; i < 2 * NUM_REFILLS; i++)
+	{
+		SVoiceSynthUttRefill(voice, "text", SObjectSetString(texts[i % 2], &error),
+							 utt, &error);
+		if (S_CHK_ERR(&error, S_CONTERR,
+					  "main",
+					  "Call to \"SVoiceSynthUttRefill\" failed"))
+			goto quit;
+
+		if (check_utt(utt, expected[i % 2]))
+			refills_ok++;
+	}
+
+	printf("refills: %d of %d\n", refills_ok, 2 * NUM_REFILLS);
+	if (refills_ok != 2 * NUM_REFILLS)
+		rv = 1;
+
+	/* a reset utterance is the same as a new one */
+	SUtteranceReset(utt, &error);
+	if (S_CHK_ERR(&error, S_CONTERR,
+				  "main",
+				  "Call to \"SUtteranceReset\" failed"))
+		goto quit;
+
+	empty = S_NEW(SUtterance, &error);
+	if (S_CHK_ERR(&error, S_CONTERR,
+				  "main",
+				  "Failed to create new 'SUtterance' object"))
+		goto quit;
+
+	SUtteranceInit(&empty, voice, &error);
+	if (S_CHK_ERR(&error, S_CONTERR,
+				  "main",
+				  "Call to \"SUtteranceInit\" failed"))
+		goto quit;
+
+	expected_empty = dump_utt(empty, &error);
+	if (S_CHK_ERR(&error, S_CONTERR,
+				  "main",
+				  "Call to \"dump_utt\" failed"))
+		goto quit;
+
+	reset_ok = check_utt(utt, expected_empty);
+	printf("reset: %s\n", reset_ok ? "same as new" : "different");
+	if (!reset_ok)
+		rv = 1;
+
+quit:
+	if (error != S_SUCCESS)
+		rv = 1;
+
+	if (utt != NULL)
+		S_DELETE(utt, "main", &error);
+
+	if (empty != NULL)
+		S_DELETE(empty, "main", &error);
+
+	if (expected_empty != NULL)
+		S_FREE(expected_empty);
+
+	for (i = 0; i < 2; i++)
+	{
+		if (expected[i] != NULL)
+			S_FREE(expected[i]);
+	}
+
+	if (voice != NULL)
+		S_DELETE(voice, "main", &error);
+
+	/*
+	 * quit speect
+	 */
+	error = speect_quit();
+	if (error != S_SUCCESS)
+	{
+		printf("Call to 'speect_quit' failed\n");
+		return 1;
+	}
+
+	return rv;
+}
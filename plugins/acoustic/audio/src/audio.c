@@ -116,6 +116,42 @@ static void Dispose(void *obj, s_erc *error)
 }
 
 
+static SObject *Copy(const SObject *obj, s_erc *error)
+{
+	const SAudio *self = (const SAudio*)obj;
+	SAudio *copy;
+
+
+	S_CLR_ERR(error);
+
+	copy = S_NEW(SAudio, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "Copy",
+				  "Failed to create new 'SAudio' object"))
+		return NULL;
+
+	copy->sample_rate = self->sample_rate;
+
+	if (self->num_samples == 0)
+		return S_OBJECT(copy);
+
+	copy->samples = S_MALLOC(float, self->num_samples);
+	if (copy->samples == NULL)
+	{
+		S_FTL_ERR(error, S_MEMERROR,
+				  "Copy",
+				  "Failed to allocate memory for 'float' object");
+		S_DELETE(copy, "Copy", error);
+		return NULL;
+	}
+
+	memcpy(copy->samples, self->samples, sizeof(float) * self->num_samples);
+	copy->num_samples = self->num_samples;
+
+	return S_OBJECT(copy);
+}
+
+
 static void Resize(SAudio *self, uint32 new_size, s_erc *error)
 {
 	float *samples;
@@ -174,7 +210,7 @@ static SAudioClass AudioClass =
 		Dispose,         /* dispose */
 		NULL,            /* compare */
 		NULL,            /* print   */
-		NULL,            /* copy    */
+		Copy,            /* copy    */
 	},
 	/* SAudioClass */
 	Resize,              /* resize  */
@@ -206,14 +206,15 @@ static void MapTracks(SRelp *self, s_erc *error)
 }
 
 
-static SAudio *Generate(SRelp *self, s_erc *error)
+static SAudio *Generate(SRelp *self, SAudioStream *stream,
+						const SCancelToken *cancel, s_erc *error)
 {
 	SAudio *audio;
 
 
 	S_CLR_ERR(error);
 
-	audio = synthesis(self, error);
+	audio = synthesis(self, stream, cancel, error);
 	if (S_CHK_ERR(error, S_CONTERR,
 				  "Generate",
 				  "Call to \"synthesis\" failed"))
@@ -283,6 +283,11 @@ typedef struct
 	 * Generate the audio from the tracks.
 	 *
 	 * @param self The given #SRelp object.
+	 * @param stream Audio stream the samples are written to, pitch
+	 * period by pitch period, while they are generated. Can be @c NULL.
+	 * @param cancel Cancellation token checked at every pitch period,
+	 * generation stops with the #S_CANCELLED error code if it is
+	 * cancelled. Can be @c NULL.
 	 * @param error Error code.
 	 *
 	 * @return The generated audio.
@@ -290,7 +295,8 @@ typedef struct
 	 * @note The caller is responsible for the memory of the returned
 	 * audio object.
 	 */
-	SAudio *(*generate)(SRelp *self, s_erc *error);
+	SAudio *(*generate)(SRelp *self, SAudioStream *stream,
+						const SCancelToken *cancel, s_erc *error);
 } SRelpClass;
 
 
@@ -351,6 +357,9 @@ S_LOCAL void linear_mapping(SRelp *self, s_erc *error);
  * @private
  *
  * @param self The given #SRelp object.
+ * @param stream Audio stream the samples are written to, can be @c
+ * NULL.
+ * @param cancel Cancellation token, can be @c NULL.
  * @param error Error code.
  *
  * @return The resulting audio object.
@@ -358,7 +367,8 @@ S_LOCAL void linear_mapping(SRelp *self, s_erc *error);
  * @note The caller is responsible for the memory of the returned
  * audio object.
  */
-S_LOCAL SAudio *synthesis(SRelp *self, s_erc *error);
+S_LOCAL SAudio *synthesis(SRelp *self, SAudioStream *stream,
+						  const SCancelToken *cancel, s_erc *error);
 
 
 /**
@@ -130,7 +130,9 @@ static void td_synthesis(SRelp *self, s_erc *error);
 
 static void map_coefs(SRelp *self, s_erc *error);
 
-static void lpc_filter_fast(STrackFloat *lpc, SAudio *res, SAudio *sig, s_erc *error);
+static void lpc_filter_fast(STrackFloat *lpc, SAudio *res, SAudio *sig,
+							SAudioStream *stream, const SCancelToken *cancel,
+							s_erc *error);
 
 
 /************************************************************************************/
@@ -139,7 +141,8 @@ static void lpc_filter_fast(STrackFloat *lpc, SAudio *res, SAudio *sig, s_erc *e
 /*                                                                                  */
 /************************************************************************************/
 
-S_LOCAL SAudio *synthesis(SRelp *self, s_erc *error)
+S_LOCAL SAudio *synthesis(SRelp *self, SAudioStream *stream,
+						  const SCancelToken *cancel, s_erc *error)
 {
 	SAudio *waveform;
 
@@ -150,6 +153,12 @@ S_LOCAL SAudio *synthesis(SRelp *self, s_erc *error)
 				  "Call to \"copy_source_track\" failed"))
 		return NULL;
 
+	SCancelTokenCheck(cancel, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "synthesis",
+				  "Synthesis stopped before residual synthesis"))
+		return NULL;
+
 	td_synthesis(self, error);
 	if (S_CHK_ERR(error, S_CONTERR,
 				  "synthesis",
@@ -179,7 +188,7 @@ S_LOCAL SAudio *synthesis(SRelp *self, s_erc *error)
 
 	waveform->sample_rate = self->wave_res->sample_rate;
 
-	lpc_filter_fast(self->target, self->wave_res, waveform, error);
+	lpc_filter_fast(self->target, self->wave_res, waveform, stream, cancel, error);
 	if (S_CHK_ERR(error, S_CONTERR,
 				  "synthesis",
 				  "Call to \"lpc_filter_fast\" failed"))
@@ -348,7 +357,9 @@ static void map_coefs(SRelp *self, s_erc *error)
 }
 
 
-static void lpc_filter_fast(STrackFloat *lpc, SAudio *res, SAudio *sig, s_erc *error)
+static void lpc_filter_fast(STrackFloat *lpc, SAudio *res, SAudio *sig,
+							SAudioStream *stream, const SCancelToken *cancel,
+							s_erc *error)
 {
 	float *buff;
 	float *filt;
@@ -358,6 +369,7 @@ static void lpc_filter_fast(STrackFloat *lpc, SAudio *res, SAudio *sig, s_erc *e
 	float *signal;
 	uint32 i, j, k, m, n; /* counter variables */
 	uint32 start, end; /* counter variables */
+	uint32 streamed;
 
 
 	S_CLR_ERR(error);
@@ -386,12 +398,23 @@ static void lpc_filter_fast(STrackFloat *lpc, SAudio *res, SAudio *sig, s_erc *e
 	}
 
 	residual = res->samples;
+	streamed = k;
 	for (start = k, m = 0, i = 0; i < lpc->data->row_count - 1; ++i)
 	{
 		end = (uint32)((lpc->time[i] + lpc->time[i + 1]) * (float)res->sample_rate)/2;
 		if (end > res->num_samples)
 			end = res->num_samples;
 
+		SCancelTokenCheck(cancel, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "lpc_filter_fast",
+					  "Synthesis stopped"))
+		{
+			S_FREE(buff);
+			S_FREE(filt);
+			return;
+		}
+
 		for (j = 1; j < lpc->data->col_count; j++)
 			filt[j] = lpc->data->f[i][j];
 		n = j;
@@ -406,6 +429,23 @@ static void lpc_filter_fast(STrackFloat *lpc, SAudio *res, SAudio *sig, s_erc *e
 			buff[k] = s + residual[m];
 		}
 		start = end;
+
+		/* stream the samples of this pitch period */
+		if ((stream != NULL) && (k > streamed))
+		{
+			SAudioStreamWrite(stream, &(buff[streamed]), k - streamed,
+							  res->sample_rate, error);
+			if (S_CHK_ERR(error, S_CONTERR,
+						  "lpc_filter_fast",
+						  "Call to \"SAudioStreamWrite\" failed"))
+			{
+				S_FREE(buff);
+				S_FREE(filt);
+				return;
+			}
+
+			streamed = k;
+		}
 	}
 
 	signal = sig->samples;
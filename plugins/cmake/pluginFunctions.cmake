@@ -12,6 +12,7 @@
 ##   speect_plugin_headers          (Add plug-in header files)                      ##
 ##   speect_plugin_include_dirs     (Add plug-in include directories)               ##
 ##   speect_plugin_create           (Create the plug-in shared object)              ##
+##                                  (or link it into the Speect Engine library)     ##
 ##   speect_plugin_configure_info   (Configure a plug-in header with information)   ##
 ##   speect_include_plugin          (Include another plug-in in the build)          ##
 ##                                                                                  ##
@@ -168,6 +169,12 @@ endmacro(speect_plugin_include_dirs)
 # A plug-in CMake configuration file will also be created. This configuration file can be
 # included in other plug-in CMakeLists.txt to include their header files.
 #
+# If the plug-in is in the STATIC_PLUGINS list (speect/cmake/spctOptions.cmake) then
+# no shared object is created. The plug-in is compiled into the Speect Engine library
+# instead, with its s_plugin_init function renamed to s_plugin_init_lowercase_name, and
+# it is resolved by name from the table created in
+# speect/engine/cmake/engineStaticPlugins.cmake.
+#
 # :param link_lib_list: Extra libraries that the plug-in must be linked with.
 # :type link_lib_list: CMake list
 #
@@ -218,6 +225,12 @@ function(speect_plugin_create)
   ############################ Plugin library ##########################################
   set(${plugin_lowercase_name}_plugin ${plugin_lowercase_name}_SONAME)
 
+  list(FIND STATIC_PLUGINS "${plugin_lowercase_name}" plugin_static)
+  if(NOT plugin_static EQUAL -1)
+    speect_plugin_create_static()
+    return()
+  endif(NOT plugin_static EQUAL -1)
+
   add_library(${plugin_lowercase_name}_plugin ${SPCT_LIB_TYPE} ${${plugin_lowercase_name}_SRC_FILES})
 
   set_target_properties(${plugin_lowercase_name}_plugin
@@ -295,6 +308,96 @@ function(speect_plugin_create)
 endfunction(speect_plugin_create)
 
 
+#------------------------------------------------------------------------------------#
+#           Link the plug-in into the Speect Engine library (internal)               #
+#------------------------------------------------------------------------------------#
+#
+# speect_plugin_create_static()
+#
+# Called by speect_plugin_create for plug-ins in the STATIC_PLUGINS list, with the
+# include directories and PLUGIN_PLATFORM_LIBS already set up. The plug-in sources
+# are compiled as an object library which is added to the Speect Engine library
+# target. The plug-in's headers and CMake configuration file are still created so that
+# other plug-ins can use them.
+#
+
+macro(speect_plugin_create_static)
+
+  if(CMAKE_VERSION VERSION_LESS 3.13)
+    message(FATAL_ERROR "Statically linked plug-ins (STATIC_PLUGINS) require CMake >= 3.13")
+  endif(CMAKE_VERSION VERSION_LESS 3.13)
+
+  message(STATUS "linking plug-in \"${plugin_lowercase_name}\" into the Speect Engine library")
+
+  # the engine target is not built in this directory
+  cmake_policy(SET CMP0079 NEW)
+
+  add_library(${plugin_lowercase_name}_plugin OBJECT ${${plugin_lowercase_name}_SRC_FILES})
+
+  # SPCT_SRC, the plug-in is now part of the Speect Engine library
+  set_target_properties(${plugin_lowercase_name}_plugin
+    PROPERTIES
+    COMPILE_FLAGS "${SPCT_LIBRARY_CFLAGS} -DSPCT_SRC -Ds_plugin_init=s_plugin_init_${plugin_lowercase_name}"
+    POSITION_INDEPENDENT_CODE ON
+    )
+
+  target_sources(${SPCT_LIBRARIES_TARGET} PRIVATE $<TARGET_OBJECTS:${plugin_lowercase_name}_plugin>)
+  target_link_libraries(${SPCT_LIBRARIES_TARGET} ${PLUGIN_PLATFORM_LIBS})
+
+  set(${plugin_lowercase_name}_TARGET ${plugin_lowercase_name}_plugin)
+
+  # record that the plug-in was linked in, checked in speect/plugins/CMakeLists.txt
+  set(tmpliststatic ${SPCT_STATIC_PLUGINS_BUILT})
+  list(APPEND tmpliststatic ${plugin_lowercase_name})
+  set(SPCT_STATIC_PLUGINS_BUILT ${tmpliststatic} CACHE INTERNAL "List of statically linked Speect plug-ins" FORCE)
+
+  ################################# Installation #######################################
+
+  # get plugin directory structure
+  string(LENGTH ${CMAKE_SPEECT_SOURCE_DIR}/plugins/ length_plugin_main)
+  string(LENGTH ${CMAKE_CURRENT_SOURCE_DIR} length_plugin_current)
+  math(EXPR length_plugin_name "${length_plugin_current} - ${length_plugin_main}")
+  string(SUBSTRING ${CMAKE_CURRENT_SOURCE_DIR}
+    ${length_plugin_main} ${length_plugin_name} plugin_dir)
+
+  # Install header files.
+  install(DIRECTORY "${CMAKE_CURRENT_SOURCE_DIR}/src/"
+    DESTINATION include/speect/plugins/${plugin_dir}
+    FILES_MATCHING PATTERN "*.h"
+    PATTERN "platform" EXCLUDE)
+
+  install(DIRECTORY "${CMAKE_CURRENT_BINARY_DIR}/src/"
+    DESTINATION include/speect/plugins/${plugin_dir}
+    FILES_MATCHING PATTERN "*.h"
+    PATTERN "platform" EXCLUDE)
+
+  # For Config file installation
+  list(LENGTH ${plugin_lowercase_name}_INCLUDE_DIRS num_dirs)
+  list(APPEND PLUGIN_INFO
+    ${num_dirs}
+    ${plugin_lowercase_name}
+    ${${plugin_lowercase_name}_VERSION_MAJOR}
+    ${${plugin_lowercase_name}_VERSION_MINOR}
+    ${${plugin_lowercase_name}_INCLUDE_DIRS}
+    )
+
+  set(tmplist ${SPCT_PLUGIN_LIST})
+  list(APPEND tmplist ${PLUGIN_INFO})
+  set(SPCT_PLUGIN_LIST ${tmplist} CACHE INTERNAL "Speect Engine include directories")
+
+  ################################# Config file ########################################
+
+  set(tmp_name ${${plugin_lowercase_name}_INCLUDE_DIRS})
+  set(tmp_version_major ${${plugin_lowercase_name}_VERSION_MAJOR})
+  set(tmp_version_minor ${${plugin_lowercase_name}_VERSION_MINOR})
+
+  list(REMOVE_DUPLICATES tmp_name)
+  configure_file(${CMAKE_SPEECT_SOURCE_DIR}/plugins/config/pluginConf.cmake.in
+    ${CMAKE_SPEECT_BINARY_DIR}/plugins/cmakeconf/${plugin_lowercase_name}.cmake @ONLY)
+
+endmacro(speect_plugin_create_static)
+
+
 #------------------------------------------------------------------------------------#
 #                   Configure a plug-in header with information                      #
 #------------------------------------------------------------------------------------#
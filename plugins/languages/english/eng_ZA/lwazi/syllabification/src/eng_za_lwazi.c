@@ -67,6 +67,33 @@ typedef enum
 } s_cluster;
 
 
+/* the phone features used by the syllabification rules */
+typedef enum
+{
+	S_FEAT_VOWEL,
+	S_FEAT_HEIGHT_LOW,
+	S_FEAT_HEIGHT_MID,
+	S_FEAT_HEIGHT_HIGH,
+	S_FEAT_CLASS_SONORANT,
+	S_FEAT_CLASS_SYLLABIC,
+	S_FEAT_CLASS_CONSONANTAL,
+	S_FEAT_MANNER_TRILL,
+	S_FEAT_MANNER_FLAP,
+	S_FEAT_MANNER_APPROXIMANT,
+	S_FEAT_MANNER_LIQUID,
+	S_FEAT_MANNER_NASAL,
+	S_FEAT_MANNER_FRICATIVE,
+	S_FEAT_MANNER_PLOSIVE,
+	S_FEAT_MANNER_GLIDE,
+	S_FEAT_VOICED,
+	S_NUM_FEATS
+} s_phone_feat;
+
+
+/* test a phone feature mask for a feature */
+#define S_HAS_FEAT(FEATURES, FEAT) (((FEATURES) & ((uint32)1 << (FEAT))) != 0)
+
+
 /************************************************************************************/
 /*                                                                                  */
 /* Static variables                                                                 */
@@ -75,6 +102,27 @@ typedef enum
 
 static SSyllabEngZaLwaziClass SyllabEngZaLwaziClass; /* SSyllabEngZaLwazi class declaration. */
 
+/* phoneset feature names, indexed by s_phone_feat */
+static const char * const feature_names[S_NUM_FEATS] =
+{
+	"vowel",
+	"height_low",
+	"height_mid",
+	"height_high",
+	"class_sonorant",
+	"class_syllabic",
+	"class_consonantal",
+	"manner_trill",
+	"manner_flap",
+	"manner_approximant",
+	"manner_liquid",
+	"manner_nasal",
+	"manner_fricative",
+	"manner_plosive",
+	"manner_glide",
+	"voiced"
+};
+
 
 /************************************************************************************/
 /*                                                                                  */
@@ -82,25 +130,31 @@ static SSyllabEngZaLwaziClass SyllabEngZaLwaziClass; /* SSyllabEngZaLwazi class
 /*                                                                                  */
 /************************************************************************************/
 
-static s_bool phone_is_liquid(const SPhoneset *phoneset, const char *phone, s_erc *error);
+static void get_feature_ids(const SPhoneset *phoneset, sint32 *feature_ids, s_erc *error);
+
+static uint32 phone_features(const SPhoneset *phoneset, const sint32 *feature_ids,
+							 const char *phone, s_erc *error);
+
+static uint32 nth_phone_features(const SPhoneset *phoneset, const sint32 *feature_ids,
+								 const SList *syl, sint32 from_last,
+								 const char **phone, s_erc *error);
+
+static s_bool phone_is_liquid(uint32 features);
 
 static s_bool phone_is_syllabic_consonant(const char *phone, s_erc *error);
 
-static s_bool phone_is_approximant_liquid(const SPhoneset *phoneset, const char *phone,
-										  s_erc *error);
+static s_bool phone_is_approximant_liquid(uint32 features);
 
-static s_bool phone_is_obstrudent(const SPhoneset *phoneset, const char *phone,
-								  s_erc *error);
+static s_bool phone_is_obstrudent(uint32 features);
 
-static uint8 phone_sonority_level(const SPhoneset *phoneset, const char *phone,
-								  s_erc *error);
+static uint8 phone_sonority_level(uint32 features);
 
 static s_bool test_phone_cluster(const SPhoneset *phoneset, const char *cluster,
 								 const char *cluster_name, s_erc *error);
 
 static s_bool permissible_consonant_clusters(const SPhoneset *phoneset,
-											 const char *c_1, const char *c_rest,
-											 s_erc *error);
+											 const char *c_1, uint32 c_1_features,
+											 const char *c_rest, s_erc *error);
 
 static void pop_CV(SList *syllables, SList **syl, s_erc *error);
 
@@ -111,17 +165,20 @@ static void pop_CCCV(SList *syllables, SList **syl, s_erc *error);
 static void process_VCV(SList *syllables, SList **syl,
 						char *current_cluster, s_erc *error);
 
-static void process_VCCV(const SPhoneset *phoneset, SList *syllables,
-						 SList **syl, char *current_cluster, s_erc *error);
+static void process_VCCV(const SPhoneset *phoneset, const sint32 *feature_ids,
+						 SList *syllables, SList **syl, char *current_cluster,
+						 s_erc *error);
 
-static void process_VCCCV(const SPhoneset *phoneset, SList *syllables, SList **syl,
-						  char *current_cluster, s_erc *error);
+static void process_VCCCV(const SPhoneset *phoneset, const sint32 *feature_ids,
+						  SList *syllables, SList **syl, char *current_cluster,
+						  s_erc *error);
 
 static void process_VCCCCV(SList *syllables, SList **syl,
 						   char *current_cluster, s_erc *error);
 
-static void process_VCGV(const SPhoneset *phoneset, SList *syllables, SList **syl,
-						 char *current_cluster, s_erc *error);
+static void process_VCGV(const SPhoneset *phoneset, const sint32 *feature_ids,
+						 SList *syllables, SList **syl, char *current_cluster,
+						 s_erc *error);
 
 static void process_VCCGV(SList *syllables, SList **syl,
 						  char *current_cluster, s_erc *error);
@@ -169,44 +226,124 @@ S_LOCAL void _s_syllab_eng_za_lwazi_class_free(s_erc *error)
 /*                                                                                  */
 /************************************************************************************/
 
-static s_bool phone_is_liquid(const SPhoneset *phoneset, const char *phone, s_erc *error)
+/*
+ * Resolve the phoneset identifiers of the syllabification features,
+ * for phonesets that number their phones.
+ */
+static void get_feature_ids(const SPhoneset *phoneset, sint32 *feature_ids, s_erc *error)
 {
+	int i;
+
+
+	S_CLR_ERR(error);
+
+	for (i = 0; i < S_NUM_FEATS; i++)
+	{
+		feature_ids[i] = S_PHONESET_CALL(phoneset, get_feature_id)(phoneset,
+																   feature_names[i],
+																   error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "get_feature_ids",
+					  "Call to method \"get_feature_id\" failed"))
+			return;
+	}
+}
+
+
+/*
+ * Get the syllabification features of a phone as a bit mask (bits
+ * are s_phone_feat). With feature identifiers the phone name is
+ * looked up once, without (feature_ids is NULL) every feature is
+ * queried by name.
+ */
+static uint32 phone_features(const SPhoneset *phoneset, const sint32 *feature_ids,
+							 const char *phone, s_erc *error)
+{
+	uint32 features = 0;
+	sint32 phone_id = -1;
 	s_bool present;
+	int i;
 
 
 	S_CLR_ERR(error);
-	present = S_PHONESET_CALL(phoneset, phone_has_feature)(phoneset, phone,
-														   "manner_trill",
-														   error);
-	if (S_CHK_ERR(error, S_CONTERR,
-				  "phone_is_liquid",
-				  "Call to method \"phone_has_feature\" failed"))
-		return FALSE;
 
-	if (present)
-		return TRUE;
+	if (feature_ids != NULL)
+	{
+		phone_id = S_PHONESET_CALL(phoneset, get_phone_id)(phoneset, phone, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "phone_features",
+					  "Call to method \"get_phone_id\" failed"))
+			return 0;
+	}
 
-	present = S_PHONESET_CALL(phoneset, phone_has_feature)(phoneset, phone,
-														   "manner_flap",
-														   error);
+	for (i = 0; i < S_NUM_FEATS; i++)
+	{
+		if (feature_ids != NULL)
+			present = S_PHONESET_CALL(phoneset, phone_id_has_feature)(phoneset, phone_id,
+																	  feature_ids[i],
+																	  error);
+		else
+			present = S_PHONESET_CALL(phoneset, phone_has_feature)(phoneset, phone,
+																   feature_names[i],
+																   error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "phone_features",
+					  "Call to method \"phone_has_feature\" failed"))
+			return 0;
+
+		if (present)
+			features |= ((uint32)1 << i);
+	}
+
+	return features;
+}
+
+
+/*
+ * The features of the phone that is from_last places from the end of
+ * the syllable (1 is the last phone), the phone name is set in phone.
+ */
+static uint32 nth_phone_features(const SPhoneset *phoneset, const sint32 *feature_ids,
+								 const SList *syl, sint32 from_last,
+								 const char **phone, s_erc *error)
+{
+	const SObject *tmp;
+	uint32 features;
+
+
+	S_CLR_ERR(error);
+
+	tmp = SListNth(syl, SListSize(syl, error) - from_last, error);
 	if (S_CHK_ERR(error, S_CONTERR,
-				  "phone_is_liquid",
-				  "Call to method \"phone_has_feature\" failed"))
-		return FALSE;
+				  "nth_phone_features",
+				  "Call to \"SListNth/SListSize\" failed"))
+		return 0;
 
-	if (present)
-		return TRUE;
+	(*phone) = SObjectGetString(tmp, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "nth_phone_features",
+				  "Call to \"SObjectGetString\" failed"))
+		return 0;
 
-	present = phone_is_approximant_liquid(phoneset, phone, error);
+	features = phone_features(phoneset, feature_ids, (*phone), error);
 	if (S_CHK_ERR(error, S_CONTERR,
-				  "phone_is_liquid",
-				  "Call to \"phone_is_approximant_liquid\" failed"))
-		return FALSE;
+				  "nth_phone_features",
+				  "Call to \"phone_features\" failed"))
+		return 0;
+
+	return features;
+}
+
+
+static s_bool phone_is_liquid(uint32 features)
+{
+	if (S_HAS_FEAT(features, S_FEAT_MANNER_TRILL))
+		return TRUE;
 
-	if (present)
+	if (S_HAS_FEAT(features, S_FEAT_MANNER_FLAP))
 		return TRUE;
 
-	return FALSE;
+	return phone_is_approximant_liquid(features);
 }
 
 
@@ -239,197 +376,60 @@ static s_bool phone_is_syllabic_consonant(const char *phone, s_erc *error)
 }
 
 
-static s_bool phone_is_approximant_liquid(const SPhoneset *phoneset, const char *phone,
-										  s_erc *error)
+static s_bool phone_is_approximant_liquid(uint32 features)
 {
-	s_bool present_aprox;
-	s_bool present_liquid;
-
-
-	present_aprox = S_PHONESET_CALL(phoneset, phone_has_feature)(phoneset, phone,
-																 "manner_approximant",
-																 error);
-	if (S_CHK_ERR(error, S_CONTERR,
-				  "phone_is_approximant_liquid",
-				  "Call to method \"phone_has_feature\" failed"))
-		return FALSE;
-
-	present_liquid = S_PHONESET_CALL(phoneset, phone_has_feature)(phoneset, phone,
-																  "manner_liquid",
-																  error);
-	if (S_CHK_ERR(error, S_CONTERR,
-				  "phone_is_approximant_liquid",
-				  "Call to method \"phone_has_feature\" failed"))
-		return FALSE;
-
-	if (present_aprox && present_liquid)
+	if (S_HAS_FEAT(features, S_FEAT_MANNER_APPROXIMANT)
+		&& S_HAS_FEAT(features, S_FEAT_MANNER_LIQUID))
 		return TRUE;
 
 	return FALSE;
 }
 
 
-static s_bool phone_is_obstrudent(const SPhoneset *phoneset, const char *phone,
-								  s_erc *error)
+static s_bool phone_is_obstrudent(uint32 features)
 {
-	s_bool present_son;
-	s_bool present_syl;
-	s_bool present_cons;
-
-
-	S_CLR_ERR(error);
-
-	present_son = S_PHONESET_CALL(phoneset, phone_has_feature)(phoneset, phone,
-															   "class_sonorant",
-															   error);
-	if (S_CHK_ERR(error, S_CONTERR,
-				  "phone_is_glide",
-				  "Call to method \"phone_has_feature\" failed"))
-		return FALSE;
-
-
-	present_syl = S_PHONESET_CALL(phoneset, phone_has_feature)(phoneset, phone,
-															   "class_syllabic",
-															   error);
-	if (S_CHK_ERR(error, S_CONTERR,
-				  "phone_is_glide",
-				  "Call to method \"phone_has_feature\" failed"))
-		return FALSE;
-
-	present_cons = S_PHONESET_CALL(phoneset, phone_has_feature)(phoneset, phone,
-																"class_consonantal",
-																error);
-	if (S_CHK_ERR(error, S_CONTERR,
-				  "phone_is_glide",
-				  "Call to method \"phone_has_feature\" failed"))
-		return FALSE;
-
-	if (!present_son && !present_syl && present_cons)
+	if (!S_HAS_FEAT(features, S_FEAT_CLASS_SONORANT)
+		&& !S_HAS_FEAT(features, S_FEAT_CLASS_SYLLABIC)
+		&& S_HAS_FEAT(features, S_FEAT_CLASS_CONSONANTAL))
 		return TRUE;
 
 	return FALSE;
 }
 
 
-static uint8 phone_sonority_level(const SPhoneset *phoneset, const char *phone, s_erc *error)
+static uint8 phone_sonority_level(uint32 features)
 {
-	s_bool present;
-
-
-	S_CLR_ERR(error);
-	present = S_PHONESET_CALL(phoneset, phone_has_feature)(phoneset, phone,
-														   "vowel",
-														   error);
-	if (S_CHK_ERR(error, S_CONTERR,
-				  "phone_sonority_level",
-				  "Call to method \"phone_has_feature\" failed"))
-		return 0;
-
-	if (present)
+	if (S_HAS_FEAT(features, S_FEAT_VOWEL))
 	{
-		present = S_PHONESET_CALL(phoneset, phone_has_feature)(phoneset, phone,
-															   "height_low",
-															   error);
-		if (S_CHK_ERR(error, S_CONTERR,
-					  "phone_sonority_level",
-					  "Call to method \"phone_has_feature\" failed"))
-			return 0;
-
-		if (present)
+		if (S_HAS_FEAT(features, S_FEAT_HEIGHT_LOW))
 			return 9;
 
-		present = S_PHONESET_CALL(phoneset, phone_has_feature)(phoneset, phone,
-															   "height_mid",
-															   error);
-		if (S_CHK_ERR(error, S_CONTERR,
-					  "phone_sonority_level",
-					  "Call to method \"phone_has_feature\" failed"))
-			return 0;
-
-		if (present)
+		if (S_HAS_FEAT(features, S_FEAT_HEIGHT_MID))
 			return 8;
 
-
-		present = S_PHONESET_CALL(phoneset, phone_has_feature)(phoneset, phone,
-															   "height_high",
-															   error);
-		if (S_CHK_ERR(error, S_CONTERR,
-					  "phone_sonority_level",
-					  "Call to method \"phone_has_feature\" failed"))
-			return 0;
-
-		if (present)
+		if (S_HAS_FEAT(features, S_FEAT_HEIGHT_HIGH))
 			return 7;
 
 		return 7; /* for diphthongs ???*/
 	}
 
-	present = S_PHONESET_CALL(phoneset, phone_has_feature)(phoneset, phone,
-														   "manner_liquid",
-														   error);
-	if (S_CHK_ERR(error, S_CONTERR,
-				  "phone_sonority_level",
-				  "Call to method \"phone_has_feature\" failed"))
-		return 0;
-
-	if (present)
+	if (S_HAS_FEAT(features, S_FEAT_MANNER_LIQUID))
 		return 6;
 
-	present = S_PHONESET_CALL(phoneset, phone_has_feature)(phoneset, phone,
-														   "manner_nasal",
-														   error);
-	if (S_CHK_ERR(error, S_CONTERR,
-				  "phone_sonority_level",
-				  "Call to method \"phone_has_feature\" failed"))
-		return 0;
-
-	if (present)
+	if (S_HAS_FEAT(features, S_FEAT_MANNER_NASAL))
 		return 5;
 
-
-	present = S_PHONESET_CALL(phoneset, phone_has_feature)(phoneset, phone,
-														   "manner_fricative",
-														   error);
-	if (S_CHK_ERR(error, S_CONTERR,
-				  "phone_sonority_level",
-				  "Call to method \"phone_has_feature\" failed"))
-		return 0;
-
-	if (present)
+	if (S_HAS_FEAT(features, S_FEAT_MANNER_FRICATIVE))
 	{
-		present = S_PHONESET_CALL(phoneset, phone_has_feature)(phoneset, phone,
-															   "voiced",
-															   error);
-		if (S_CHK_ERR(error, S_CONTERR,
-					  "phone_sonority_level",
-					  "Call to method \"phone_has_feature\" failed"))
-			return 0;
-
-		if (present)
+		if (S_HAS_FEAT(features, S_FEAT_VOICED))
 			return 4;
 
 		return 3;
 	}
 
-	present = S_PHONESET_CALL(phoneset, phone_has_feature)(phoneset, phone,
-														   "manner_plosive",
-														   error);
-	if (S_CHK_ERR(error, S_CONTERR,
-				  "phone_sonority_level",
-				  "Call to method \"phone_has_feature\" failed"))
-		return 0;
-
-	if (present)
+	if (S_HAS_FEAT(features, S_FEAT_MANNER_PLOSIVE))
 	{
-		present = S_PHONESET_CALL(phoneset, phone_has_feature)(phoneset, phone,
-															   "voiced",
-															   error);
-		if (S_CHK_ERR(error, S_CONTERR,
-					  "phone_sonority_level",
-					  "Call to method \"phone_has_feature\" failed"))
-			return 0;
-
-		if (present)
+		if (S_HAS_FEAT(features, S_FEAT_VOICED))
 			return 2;
 
 		return 1;
@@ -515,8 +515,8 @@ static s_bool test_phone_cluster(const SPhoneset *phoneset, const char *cluster,
 
 /* ABY check this */
 static s_bool permissible_consonant_clusters(const SPhoneset *phoneset,
-											 const char *c_1, const char *c_rest,
-											 s_erc *error)
+											 const char *c_1, uint32 c_1_features,
+											 const char *c_rest, s_erc *error)
 {
 	char cluster[10] = "\0";
 	s_bool test_result;
@@ -557,15 +557,7 @@ static s_bool permissible_consonant_clusters(const SPhoneset *phoneset,
 	}
 
 	/* plosive clusters */
-	test_result = S_PHONESET_CALL(phoneset, phone_has_feature)(phoneset, c_1,
-															   "manner_plosive",
-															   error);
-	if (S_CHK_ERR(error, S_CONTERR,
-				  "permissible_consonant_clusters",
-				  "Call to SPhoneset method \"phone_has_feature\" failed"))
-		return FALSE;
-
-	if (test_result)
+	if (S_HAS_FEAT(c_1_features, S_FEAT_MANNER_PLOSIVE))
 	{
 		test_result = test_phone_cluster(phoneset, cluster,
 										 "wellformed_plosive_clusters", error);
@@ -578,15 +570,7 @@ static s_bool permissible_consonant_clusters(const SPhoneset *phoneset,
 	}
 
 	/* fricative clusters not /s/ */
-	test_result = S_PHONESET_CALL(phoneset, phone_has_feature)(phoneset, c_1,
-															   "manner_fricative",
-															   error);
-	if (S_CHK_ERR(error, S_CONTERR,
-				  "permissible_consonant_clusters",
-				  "Call to SPhoneset method \"phone_has_feature\" failed"))
-		return FALSE;
-
-	if (test_result)
+	if (S_HAS_FEAT(c_1_features, S_FEAT_MANNER_FRICATIVE))
 	{
 		test_result = test_phone_cluster(phoneset, cluster,
 										 "wellformed_fricative_clusters", error);
@@ -780,60 +764,43 @@ static void process_VCV(SList *syllables, SList **syl,
 }
 
 
-static void process_VCCV(const SPhoneset *phoneset, SList *syllables,
-						 SList **syl, char *current_cluster, s_erc *error)
+static void process_VCCV(const SPhoneset *phoneset, const sint32 *feature_ids,
+						 SList *syllables, SList **syl, char *current_cluster,
+						 s_erc *error)
 {
-	const SObject *C1;
-	const SObject *C2;
 	const char *c1_string;
 	const char *c2_string;
+	uint32 c1_features;
+	uint32 c2_features;
 	s_bool is_permissible_cluster;
 	uint8 c1_level;
 	uint8 c2_level;
 
 	S_CLR_ERR(error);
 
-	C1 = SListNth((*syl), SListSize((*syl), error) - 3, error); /* third from last */
+	/* third from last */
+	c1_features = nth_phone_features(phoneset, feature_ids, (*syl), 3, &c1_string, error);
 	if (S_CHK_ERR(error, S_CONTERR,
 				  "process_VCCV",
-				  "Call to \"SListNth/SListSize\" failed"))
+				  "Call to \"nth_phone_features\" failed"))
 		return;
 
-	c1_string = SObjectGetString(C1, error);
+	/* second from last */
+	c2_features = nth_phone_features(phoneset, feature_ids, (*syl), 2, &c2_string, error);
 	if (S_CHK_ERR(error, S_CONTERR,
 				  "process_VCCV",
-				  "Call to \"SObjectGetString\" failed"))
+				  "Call to \"nth_phone_features\" failed"))
 		return;
 
-	C2 = SListNth((*syl), SListSize((*syl), error) - 2, error); /* second from last */
-	if (S_CHK_ERR(error, S_CONTERR,
-				  "process_VCCV",
-				  "Call to \"SListNth/SListSize\" failed"))
-		return;
-
-	c2_string = SObjectGetString(C2, error);
-	if (S_CHK_ERR(error, S_CONTERR,
-				  "process_VCCV",
-				  "Call to \"SObjectGetString\" failed"))
-		return;
-
-	is_permissible_cluster = permissible_consonant_clusters(phoneset, c1_string, c2_string, error);
+	is_permissible_cluster = permissible_consonant_clusters(phoneset, c1_string, c1_features,
+															c2_string, error);
 	if (S_CHK_ERR(error, S_CONTERR,
 				  "process_VCCV",
 				  "Call to \"permissible_consonant_clusters\" failed"))
 		return;
 
-	c1_level = phone_sonority_level(phoneset, c1_string, error);
-	if (S_CHK_ERR(error, S_CONTERR,
-				  "process_VCCV",
-				  "Call to \"phone_sonority_level\" failed"))
-		return;
-
-	c2_level = phone_sonority_level(phoneset, c2_string, error);
-	if (S_CHK_ERR(error, S_CONTERR,
-				  "process_VCCV",
-				  "Call to \"phone_sonority_level\" failed"))
-		return;
+	c1_level = phone_sonority_level(c1_features);
+	c2_level = phone_sonority_level(c2_features);
 
 	/*
 	 * Tautosyllabic CC clusters  VCCV -> V.CCV
@@ -875,21 +842,8 @@ static void process_VCCV(const SPhoneset *phoneset, SList *syllables,
 					  "Call to \"s_strcmp\" failed"))
 			return;
 
-		c2_is_voiced = S_PHONESET_CALL(phoneset, phone_has_feature)(phoneset, c2_string,
-																	"voiced",
-																	error);
-		if (S_CHK_ERR(error, S_CONTERR,
-					  "process_VCCV",
-					  "Call to SPhoneset method \"phone_has_feature\" failed"))
-			return;
-
-		c2_is_stop = S_PHONESET_CALL(phoneset, phone_has_feature)(phoneset, c2_string,
-																  "manner_plosive",
-																  error);
-		if (S_CHK_ERR(error, S_CONTERR,
-					  "process_VCCV",
-					  "Call to SPhoneset method \"phone_has_feature\" failed"))
-			return;
+		c2_is_voiced = S_HAS_FEAT(c2_features, S_FEAT_VOICED);
+		c2_is_stop = S_HAS_FEAT(c2_features, S_FEAT_MANNER_PLOSIVE);
 
 		if ((scomp == 0)
 			&& (!c2_is_voiced)
@@ -978,15 +932,16 @@ static void process_VCCV(const SPhoneset *phoneset, SList *syllables,
 }
 
 
-static void process_VCCCV(const SPhoneset *phoneset, SList *syllables, SList **syl,
-						  char *current_cluster, s_erc *error)
+static void process_VCCCV(const SPhoneset *phoneset, const sint32 *feature_ids,
+						  SList *syllables, SList **syl, char *current_cluster,
+						  s_erc *error)
 {
-	const SObject *C1;
-	const SObject *C2;
-	const SObject *C3;
 	const char *c1_string;
 	const char *c2_string;
 	const char *c3_string;
+	uint32 c1_features;
+	uint32 c2_features;
+	uint32 c3_features;
 	s_bool c1_is_obstrudent;
 	s_bool c2_is_obstrudent;
 	s_bool c3_is_obstrudent;
@@ -995,59 +950,30 @@ static void process_VCCCV(const SPhoneset *phoneset, SList *syllables, SList **s
 
 	S_CLR_ERR(error);
 
-	C1 = SListNth((*syl), SListSize((*syl), error) - 4, error); /* fourth from last */
-	if (S_CHK_ERR(error, S_CONTERR,
-				  "process_VCCCV",
-				  "Call to \"SListNth/SListSize\" failed"))
-		return;
-
-	c1_string = SObjectGetString(C1, error);
-	if (S_CHK_ERR(error, S_CONTERR,
-				  "process_VCCCV",
-				  "Call to \"SObjectGetString\" failed"))
-		return;
-
-	C2 = SListNth((*syl), SListSize((*syl), error) - 3, error); /* third from last */
+	/* fourth from last */
+	c1_features = nth_phone_features(phoneset, feature_ids, (*syl), 4, &c1_string, error);
 	if (S_CHK_ERR(error, S_CONTERR,
 				  "process_VCCCV",
-				  "Call to \"SListNth/SListSize\" failed"))
-		return;
-
-	c2_string = SObjectGetString(C2, error);
-	if (S_CHK_ERR(error, S_CONTERR,
-				  "process_VCCCV",
-				  "Call to \"SObjectGetString\" failed"))
-		return;
-
-	C3 = SListNth((*syl), SListSize((*syl), error) - 2, error); /* second from last */
-	if (S_CHK_ERR(error, S_CONTERR,
-				  "process_VCCCV",
-				  "Call to \"SListNth/SListSize\" failed"))
-		return;
-
-	c3_string = SObjectGetString(C3, error);
-	if (S_CHK_ERR(error, S_CONTERR,
-				  "process_VCCCV",
-				  "Call to \"SObjectGetString\" failed"))
+				  "Call to \"nth_phone_features\" failed"))
 		return;
 
-	c1_is_obstrudent = phone_is_obstrudent(phoneset, c1_string, error);
+	/* third from last */
+	c2_features = nth_phone_features(phoneset, feature_ids, (*syl), 3, &c2_string, error);
 	if (S_CHK_ERR(error, S_CONTERR,
 				  "process_VCCCV",
-				  "Call to \"phone_is_obstrudent\" failed"))
+				  "Call to \"nth_phone_features\" failed"))
 		return;
 
-	c2_is_obstrudent = phone_is_obstrudent(phoneset, c2_string, error);
+	/* second from last */
+	c3_features = nth_phone_features(phoneset, feature_ids, (*syl), 2, &c3_string, error);
 	if (S_CHK_ERR(error, S_CONTERR,
 				  "process_VCCCV",
-				  "Call to \"phone_is_obstrudent\" failed"))
+				  "Call to \"nth_phone_features\" failed"))
 		return;
 
-	c3_is_obstrudent = phone_is_obstrudent(phoneset, c3_string, error);
-	if (S_CHK_ERR(error, S_CONTERR,
-				  "process_VCCCV",
-				  "Call to \"phone_is_obstrudent\" failed"))
-		return;
+	c1_is_obstrudent = phone_is_obstrudent(c1_features);
+	c2_is_obstrudent = phone_is_obstrudent(c2_features);
+	c3_is_obstrudent = phone_is_obstrudent(c3_features);
 
 	/*
 	 * CCC sequences in which all three segments are obstruents  VCCCV -> VC.CCV
@@ -1067,7 +993,8 @@ static void process_VCCCV(const SPhoneset *phoneset, SList *syllables, SList **s
 		return;
 	}
 
-	is_permissible_cluster = permissible_consonant_clusters(phoneset, c2_string, c3_string, error);
+	is_permissible_cluster = permissible_consonant_clusters(phoneset, c2_string, c2_features,
+															c3_string, error);
 	if (S_CHK_ERR(error, S_CONTERR,
 				  "process_VCCCV",
 				  "Call to \"permissible_consonant_clusters\" failed"))
@@ -1079,19 +1006,8 @@ static void process_VCCCV(const SPhoneset *phoneset, SList *syllables, SList **s
 		s_bool c1_is_liquid;
 
 
-		c1_is_nasal = S_PHONESET_CALL(phoneset, phone_has_feature)(phoneset, c1_string,
-																   "manner_nasal",
-																   error);
-		if (S_CHK_ERR(error, S_CONTERR,
-					  "process_VCCCV",
-					  "Call to SPhoneset method \"phone_has_feature\" failed"))
-			return;
-
-		c1_is_liquid = phone_is_liquid(phoneset, c1_string, error);
-		if (S_CHK_ERR(error, S_CONTERR,
-					  "process_VCCCV",
-					  "Call to \"phone_is_liquid\" failed"))
-			return;
+		c1_is_nasal = S_HAS_FEAT(c1_features, S_FEAT_MANNER_NASAL);
+		c1_is_liquid = phone_is_liquid(c1_features);
 
 		if (c1_is_nasal || c1_is_liquid)
 		{
@@ -1101,18 +1017,8 @@ static void process_VCCCV(const SPhoneset *phoneset, SList *syllables, SList **s
 			int scomp;
 
 
-			c2_level = phone_sonority_level(phoneset, c2_string, error);
-			if (S_CHK_ERR(error, S_CONTERR,
-						  "process_VCCCV",
-						  "Call to \"phone_sonority_level\" failed"))
-				return;
-
-			c3_level = phone_sonority_level(phoneset, c3_string, error);
-			if (S_CHK_ERR(error, S_CONTERR,
-						  "process_VCCCV",
-						  "Call to \"phone_sonority_level\" failed"))
-				return;
-
+			c2_level = phone_sonority_level(c2_features);
+			c3_level = phone_sonority_level(c3_features);
 
 			if (c2_level < c3_level)
 			{
@@ -1137,13 +1043,7 @@ static void process_VCCCV(const SPhoneset *phoneset, SList *syllables, SList **s
 			}
 
 
-			c3_is_plosive = S_PHONESET_CALL(phoneset, phone_has_feature)(phoneset, c3_string,
-																		 "manner_plosive",
-																		 error);
-			if (S_CHK_ERR(error, S_CONTERR,
-						  "process_VCCCV",
-						  "Call to SPhoneset method \"phone_has_feature\" failed"))
-				return;
+			c3_is_plosive = S_HAS_FEAT(c3_features, S_FEAT_MANNER_PLOSIVE);
 
 			scomp = s_strcmp(c2_string, "s", error);
 			if (S_CHK_ERR(error, S_CONTERR,
@@ -1186,17 +1086,8 @@ static void process_VCCCV(const SPhoneset *phoneset, SList *syllables, SList **s
 		 *     of English.
 		 */
 
-		c2_level = phone_sonority_level(phoneset, c2_string, error);
-		if (S_CHK_ERR(error, S_CONTERR,
-					  "process_VCCCV",
-					  "Call to \"phone_sonority_level\" failed"))
-			return;
-
-		c3_level = phone_sonority_level(phoneset, c3_string, error);
-		if (S_CHK_ERR(error, S_CONTERR,
-					  "process_VCCCV",
-					  "Call to \"phone_sonority_level\" failed"))
-			return;
+		c2_level = phone_sonority_level(c2_features);
+		c3_level = phone_sonority_level(c3_features);
 
 		if (c2_level <= c3_level)
 		{
@@ -1241,29 +1132,25 @@ static void process_VCCCCV(SList *syllables, SList **syl,
 }
 
 
-static void process_VCGV(const SPhoneset *phoneset, SList *syllables, SList **syl,
-						 char *current_cluster, s_erc *error)
+static void process_VCGV(const SPhoneset *phoneset, const sint32 *feature_ids,
+						 SList *syllables, SList **syl, char *current_cluster,
+						 s_erc *error)
 {
-	const SObject *C;
 	const SObject *G;
 	const char *c_string;
 	const char *g_string;
+	uint32 c_features;
 	s_bool c_is_stop;
 	s_bool is_permissible_cluster;
 
 
 	S_CLR_ERR(error);
 
-	C = SListNth((*syl), SListSize((*syl), error) - 3, error); /* third from last */
-	if (S_CHK_ERR(error, S_CONTERR,
-				  "process_VCGV",
-				  "Call to \"SListNth/SListSize\" failed"))
-		return;
-
-	c_string = SObjectGetString(C, error);
+	/* third from last */
+	c_features = nth_phone_features(phoneset, feature_ids, (*syl), 3, &c_string, error);
 	if (S_CHK_ERR(error, S_CONTERR,
 				  "process_VCGV",
-				  "Call to \"SObjectGetString\" failed"))
+				  "Call to \"nth_phone_features\" failed"))
 		return;
 
 	G = SListNth((*syl), SListSize((*syl), error) - 2, error); /* second from last */
@@ -1278,19 +1165,14 @@ static void process_VCGV(const SPhoneset *phoneset, SList *syllables, SList **sy
 				  "Call to \"SObjectGetString\" failed"))
 		return;
 
-	is_permissible_cluster = permissible_consonant_clusters(phoneset, c_string, g_string, error);
+	is_permissible_cluster = permissible_consonant_clusters(phoneset, c_string, c_features,
+															g_string, error);
 	if (S_CHK_ERR(error, S_CONTERR,
 				  "process_VCGV",
 				  "Call to \"permissible_consonant_clusters\" failed"))
 		return;
 
-	c_is_stop = S_PHONESET_CALL(phoneset, phone_has_feature)(phoneset, c_string,
-															 "manner_plosive",
-															 error);
-	if (S_CHK_ERR(error, S_CONTERR,
-				  "process_VCGV",
-				  "Call to SPhoneset method \"phone_has_feature\" failed"))
-		return;
+	c_is_stop = S_HAS_FEAT(c_features, S_FEAT_MANNER_PLOSIVE);
 
 	/*
 	 * VCGV -> V.CGV
@@ -1695,6 +1577,9 @@ static SList *Syllabify(const SSyllabification *self, const SItem *word,
 	size_t list_size;
 	s_bool testrv;
 	s_cluster cluster_type;
+	sint32 feature_ids[S_NUM_FEATS];
+	const sint32 *ids = NULL;
+	uint32 features;
 
 
 	S_CLR_ERR(error);
@@ -1751,6 +1636,20 @@ static SList *Syllabify(const SSyllabification *self, const SItem *word,
 		goto quit_error;
 	}
 
+	/* phonesets that number their phones are queried by identifier */
+	if ((S_PHONESET_METH_VALID(phoneset, get_phone_id))
+		&& (S_PHONESET_METH_VALID(phoneset, get_feature_id))
+		&& (S_PHONESET_METH_VALID(phoneset, phone_id_has_feature)))
+	{
+		get_feature_ids(phoneset, feature_ids, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "Syllabify",
+					  "Call to \"get_feature_ids\" failed"))
+			goto quit_error;
+
+		ids = feature_ids;
+	}
+
 	/* create syllables list */
 	syllables = S_LIST(S_NEW(SListList, error));
 	if (S_CHK_ERR(error, S_CONTERR,
@@ -1804,6 +1703,12 @@ static SList *Syllabify(const SSyllabification *self, const SItem *word,
 					  "Call to \"SObjectGetString\" failed"))
 			goto quit_error;
 
+		features = phone_features(phoneset, ids, phone_string, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "Syllabify",
+					  "Call to \"phone_features\" failed"))
+			goto quit_error;
+
 		/*
 		 * add the phone to the syllable for now, we add the
 		 * phone_string so that it is independent from the phoneList
@@ -1857,31 +1762,13 @@ static SList *Syllabify(const SSyllabification *self, const SItem *word,
 				goto quit_error;
 		}
 
-		prev_is_obstrudent = phone_is_obstrudent(phoneset, phone_string, error);
-		if (S_CHK_ERR(error, S_CONTERR,
-					  "Syllabify",
-					  "Call to \"phone_is_obstrudent\" failed"))
-			goto quit_error;
-
-		prev_is_nasal = S_PHONESET_CALL(phoneset,
-										phone_has_feature)(phoneset, phone_string,
-														   "manner_nasal", error);
-		if (S_CHK_ERR(error, S_CONTERR,
-					  "Syllabify",
-					  "Call to \"phone_has_feature\" failed"))
-			goto quit_error;
+		prev_is_obstrudent = phone_is_obstrudent(features);
+		prev_is_nasal = S_HAS_FEAT(features, S_FEAT_MANNER_NASAL);
 
 		/*
 		 * hacks end
 		 */
-		testrv = S_PHONESET_CALL(phoneset, phone_has_feature)(phoneset, phone_string,
-															  "vowel", error);
-		if (S_CHK_ERR(error, S_CONTERR,
-					  "Syllabify",
-					  "Call to \"phone_has_feature\" failed"))
-			goto quit_error;
-
-		if (testrv)
+		if (S_HAS_FEAT(features, S_FEAT_VOWEL))
 		{
 			s_strcat(current_cluster, "V", error);
 			if (S_CHK_ERR(error, S_CONTERR,
@@ -1891,14 +1778,7 @@ static SList *Syllabify(const SSyllabification *self, const SItem *word,
 		}
 		else
 		{
-			testrv = S_PHONESET_CALL(phoneset, phone_has_feature)(phoneset, phone_string,
-																  "manner_glide", error);
-			if (S_CHK_ERR(error, S_CONTERR,
-						  "Syllabify",
-						  "Call to \"phone_has_feature\" failed"))
-				goto quit_error;
-
-			if (testrv)
+			if (S_HAS_FEAT(features, S_FEAT_MANNER_GLIDE))
 			{
 				s_strcat(current_cluster, "G", error);
 				if (S_CHK_ERR(error, S_CONTERR,
@@ -1936,7 +1816,7 @@ static SList *Syllabify(const SSyllabification *self, const SItem *word,
 		}
 		case S_VCCV_CLUSTER:
 		{
-			process_VCCV(phoneset, syllables, &syl, current_cluster, error);
+			process_VCCV(phoneset, ids, syllables, &syl, current_cluster, error);
 			if (S_CHK_ERR(error, S_CONTERR,
 						  "Syllabify",
 						  "Call to \"process_VCCV\" failed"))
@@ -1946,7 +1826,7 @@ static SList *Syllabify(const SSyllabification *self, const SItem *word,
 		}
 		case S_VCCCV_CLUSTER:
 		{
-			process_VCCCV(phoneset, syllables, &syl, current_cluster, error);
+			process_VCCCV(phoneset, ids, syllables, &syl, current_cluster, error);
 			if (S_CHK_ERR(error, S_CONTERR,
 						  "Syllabify",
 						  "Call to \"process_VCCCV\" failed"))
@@ -1966,7 +1846,7 @@ static SList *Syllabify(const SSyllabification *self, const SItem *word,
 		}
 		case S_VCGV_CLUSTER:
 		{
-			process_VCGV(phoneset, syllables, &syl, current_cluster, error);
+			process_VCGV(phoneset, ids, syllables, &syl, current_cluster, error);
 			if (S_CHK_ERR(error, S_CONTERR,
 						  "Syllabify",
 						  "Call to \"process_VCGV\" failed"))
@@ -68,7 +68,35 @@ static SSyllabItaItMivoqClass SyllabItaItMivoqClass;
 
 enum PhoneLevels {occlusive, fricative, nasal, lateral, s, vibrant, approximant, vowel, error_level};
 
-static enum PhoneLevels phone_sonority_level(const SPhoneset* phoneset, const char* phone, s_erc *error);
+/* the phone features of the sonority scale, bits of a phone's feature mask */
+enum PhoneFeatures {feat_vowel, feat_plosive, feat_nasal, feat_lateral, feat_liquid,
+		    feat_approximant, feat_strident, feat_alveolar, feat_fricative,
+		    feat_affricate, num_features};
+
+static void get_feature_ids(const SPhoneset *phoneset, sint32 *feature_ids, s_erc *error);
+
+static uint32 phone_features(const SPhoneset *phoneset, const sint32 *feature_ids,
+			     const char *phone, s_erc *error);
+
+static enum PhoneLevels phone_sonority_level(uint32 features);
+
+/* the bit of a phone feature in a phone's feature mask */
+#define FEATURE_BIT(FEAT) ((uint32)1 << (FEAT))
+
+/* phoneset names of the phone features, indexed by enum PhoneFeatures */
+static const char * const feature_names[num_features] =
+{
+	"vowel",
+	"manner_plosive",
+	"manner_nasal",
+	"manner_lateral",
+	"manner_liquid",
+	"manner_approximant",
+	"manner_strident",
+	"place_alveolar",
+	"manner_fricative",
+	"manner_affricate"
+};
 
 /************************************************************************************/
 /*                                                                                  */
@@ -104,24 +132,76 @@ S_LOCAL void _s_syllab_ita_it_mivoq_class_free(s_erc *error)
 /*                                                                                  */
 /************************************************************************************/
 
-static s_bool phone_is_vowel(const SPhoneset *phoneset, const char *phone, s_erc *error)
+/*
+ * Look up the identifiers of the phone features, if the phoneset
+ * numbers its phones (see get_phone_id), else feature_ids is not set.
+ */
+static void get_feature_ids(const SPhoneset *phoneset, sint32 *feature_ids, s_erc *error)
 {
-	s_bool present;
+	int i;
 
 	S_CLR_ERR(error);
-	present = S_PHONESET_CALL(phoneset, phone_has_feature)(phoneset, phone,
-							       "vowel",
-							       error);
-	if (S_CHK_ERR(error, S_CONTERR,
-		      "phone_is_vowel",
-		      "Call to method \"phone_has_feature\" failed"))
-		return FALSE;
 
-	if (present)
-		return TRUE;
+	for (i = 0; i < num_features; i++)
+	{
+		feature_ids[i] = S_PHONESET_CALL(phoneset, get_feature_id)(phoneset,
+									   feature_names[i],
+									   error);
+		if (S_CHK_ERR(error, S_CONTERR,
+			      "get_feature_ids",
+			      "Call to method \"get_feature_id\" failed"))
+			return;
+	}
+}
 
-	return FALSE;
+
+/*
+ * The features of the phone as a mask of enum PhoneFeatures bits. The
+ * phone is looked up once with the feature identifiers (if not NULL),
+ * else each feature is queried by name.
+ */
+static uint32 phone_features(const SPhoneset *phoneset, const sint32 *feature_ids,
+			     const char *phone, s_erc *error)
+{
+	uint32 features = 0;
+	s_bool has_feature;
+	sint32 phone_id = -1;
+	int i;
+
+	S_CLR_ERR(error);
+
+	if (feature_ids != NULL)
+	{
+		phone_id = S_PHONESET_CALL(phoneset, get_phone_id)(phoneset, phone, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+			      "phone_features",
+			      "Call to method \"get_phone_id\" failed"))
+			return 0;
+	}
+
+	for (i = 0; i < num_features; i++)
+	{
+		if (feature_ids != NULL)
+			has_feature = S_PHONESET_CALL(phoneset, phone_id_has_feature)(phoneset, phone_id,
+										      feature_ids[i],
+										      error);
+		else
+			has_feature = S_PHONESET_CALL(phoneset, phone_has_feature)(phoneset, phone,
+										   feature_names[i],
+										   error);
+		if (S_CHK_ERR(error, S_CONTERR,
+			      "phone_features",
+			      "Call to method \"phone_has_feature\" failed"))
+			return 0;
+
+		if (has_feature)
+			features |= FEATURE_BIT(i);
+	}
+
+	return features;
 }
+
+
 /**
  * This function return sonority level of phones, according to some of their features
  * the sonority level is mostly in increasing order, with the major exception of
@@ -151,108 +231,33 @@ static s_bool phone_is_vowel(const SPhoneset *phoneset, const char *phone, s_erc
  *  - lateral   + 's' should be splitted
  *  - nasal + 's' should be splitted
  * */
-static enum PhoneLevels phone_sonority_level(const SPhoneset* phoneset, const char* phone, s_erc *error)
+static enum PhoneLevels phone_sonority_level(uint32 features)
 {
-	s_bool has_feature;
-	S_CLR_ERR(error);
-
 	/* Check if phone is a vowel */
-	has_feature = S_PHONESET_CALL(phoneset, phone_has_feature)(phoneset, phone,
-							       "vowel",
-							       error);
-	if (S_CHK_ERR(error, S_CONTERR,
-		      "phone_sonority_level",
-		      "Call to method \"phone_has_feature\" failed"))
-		return error_level;
-	if (has_feature)
+	if ((features & FEATURE_BIT(feat_vowel)))
 		return vowel;
 	/* Check if phone is an occlusive */
-	has_feature = S_PHONESET_CALL(phoneset, phone_has_feature)(phoneset, phone,
-							       "manner_plosive",
-							       error);
-	if (S_CHK_ERR(error, S_CONTERR,
-		      "phone_sonority_level",
-		      "Call to method \"phone_has_feature\" failed"))
-		return error_level;
-	if (has_feature)
+	if ((features & FEATURE_BIT(feat_plosive)))
 		return occlusive;
 	/* Check if phone is an nasal */
-	has_feature = S_PHONESET_CALL(phoneset, phone_has_feature)(phoneset, phone,
-							       "manner_nasal",
-							       error);
-	if (S_CHK_ERR(error, S_CONTERR,
-		      "phone_sonority_level",
-		      "Call to method \"phone_has_feature\" failed"))
-		return error_level;
-	if (has_feature)
+	if ((features & FEATURE_BIT(feat_nasal)))
 		return nasal;
 	/* Check if phone is an lateral */
-	has_feature = S_PHONESET_CALL(phoneset, phone_has_feature)(phoneset, phone,
-							       "manner_lateral",
-							       error);
-	if (S_CHK_ERR(error, S_CONTERR,
-		      "phone_sonority_level",
-		      "Call to method \"phone_has_feature\" failed"))
-		return error_level;
-	if (has_feature)
+	if ((features & FEATURE_BIT(feat_lateral)))
 		return lateral;
 	/* Check if phone is a vibrant (liquid+not lateral) */
-	has_feature = S_PHONESET_CALL(phoneset, phone_has_feature)(phoneset, phone,
-							       "manner_liquid",
-							       error);
-	if (S_CHK_ERR(error, S_CONTERR,
-		      "phone_sonority_level",
-		      "Call to method \"phone_has_feature\" failed"))
-		return error_level;
-	if (has_feature)
+	if ((features & FEATURE_BIT(feat_liquid)))
 		return vibrant;
 	/* Check if phone is an approximant (approximant+not vibrant+not lateral) */
-	has_feature = S_PHONESET_CALL(phoneset, phone_has_feature)(phoneset, phone,
-							       "manner_approximant",
-							       error);
-	if (S_CHK_ERR(error, S_CONTERR,
-		      "phone_sonority_level",
-		      "Call to method \"phone_has_feature\" failed"))
-		return error_level;
-	if (has_feature)
+	if ((features & FEATURE_BIT(feat_approximant)))
 		return approximant;
 	/* Check if phone is an s (strident+alveolar) */
-	has_feature = S_PHONESET_CALL(phoneset, phone_has_feature)(phoneset, phone,
-							       "manner_strident",
-							       error);
-	if (S_CHK_ERR(error, S_CONTERR,
-		      "phone_sonority_level",
-		      "Call to method \"phone_has_feature\" failed"))
-		return error_level;
-	if (has_feature) {
-		has_feature = S_PHONESET_CALL(phoneset, phone_has_feature)(phoneset, phone,
-									   "place_alveolar",
-									   error);
-		if (S_CHK_ERR(error, S_CONTERR,
-			      "phone_sonority_level",
-			      "Call to method \"phone_has_feature\" failed"))
-			return error_level;
-		if (has_feature)
-			return s;
-	}
+	if ((features & FEATURE_BIT(feat_strident)) && (features & FEATURE_BIT(feat_alveolar)))
+		return s;
 	/* Check if phone is a fricative ((fricative or affricate)+not s) */
-	has_feature = S_PHONESET_CALL(phoneset, phone_has_feature)(phoneset, phone,
-							       "manner_fricative",
-							       error);
-	if (S_CHK_ERR(error, S_CONTERR,
-		      "phone_sonority_level",
-		      "Call to method \"phone_has_feature\" failed"))
-		return error_level;
-	if (has_feature)
+	if ((features & FEATURE_BIT(feat_fricative)))
 		return fricative;
-	has_feature = S_PHONESET_CALL(phoneset, phone_has_feature)(phoneset, phone,
-							       "manner_affricate",
-							       error);
-	if (S_CHK_ERR(error, S_CONTERR,
-		      "phone_sonority_level",
-		      "Call to method \"phone_has_feature\" failed"))
-		return error_level;
-	if (has_feature)
+	if ((features & FEATURE_BIT(feat_affricate)))
 		return fricative;
 
 	return error_level;
@@ -421,6 +426,11 @@ static SList *Syllabify(const SSyllabification *self, const SItem *word,
 	const SObject *tmp;
 	const char *phone_string;
 	SIterator *itr_phoneList = NULL;
+	sint32 feature_ids[num_features];
+	s_bool numbered;
+	enum PhoneLevels *levels = NULL;
+	size_t num_phones;
+	uint32 features;
 
 	/* store for 'is_...' functions */
 	s_bool test_phone = FALSE;
@@ -482,6 +492,34 @@ static SList *Syllabify(const SSyllabification *self, const SItem *word,
 		      "Failed to create new 'SListList' object"))
 		goto quit_error;
 
+	/* look the features up once, and each phone once */
+	numbered = ((S_PHONESET_METH_VALID(phoneset, get_phone_id))
+		    && (S_PHONESET_METH_VALID(phoneset, get_feature_id))
+		    && (S_PHONESET_METH_VALID(phoneset, phone_id_has_feature)));
+	if (numbered)
+	{
+		get_feature_ids(phoneset, feature_ids, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+			      "Syllabify",
+			      "Call to \"get_feature_ids\" failed"))
+			goto quit_error;
+	}
+
+	num_phones = SListSize(phoneList, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+		      "Syllabify",
+		      "Call to \"SListSize\" failed"))
+		goto quit_error;
+
+	levels = S_MALLOC(enum PhoneLevels, num_phones > 0 ? num_phones : 1);
+	if (levels == NULL)
+	{
+		S_FTL_ERR(error, S_MEMERROR,
+			  "Syllabify",
+			  "Failed to allocate memory for 'enum PhoneLevels' object");
+		goto quit_error;
+	}
+
 	/* phones iterator */
 	itr_phoneList = S_ITERATOR_GET(phoneList, error);
 	if (S_CHK_ERR(error, S_CONTERR,
@@ -490,57 +528,51 @@ static SList *Syllabify(const SSyllabification *self, const SItem *word,
 		goto quit_error;
 	size_t i = 0;
 
-	/* associate the first phones to the first syllable, up to the first vowel */
-	size_t last_head = 0;
-	while (itr_phoneList != NULL  && !test_phone)
+	/* the sonority level of each phone, vowels are at the vowel level */
+	while (itr_phoneList != NULL)
 	{
 		tmp = SIteratorObject(itr_phoneList, error);
 		if (S_CHK_ERR(error, S_CONTERR,
-				  "Syllabify",
-				  "Call to method \"SIteratorObject\" failed"))
+			      "Syllabify",
+			      "Call to \"SIteratorObject\" failed"))
 			goto quit_error;
 
-		/* 'phone_string' is analyzed */
+		/* get phone name */
 		phone_string = SObjectGetString(tmp, error);
 		if (S_CHK_ERR(error, S_CONTERR,
 			      "Syllabify",
 			      "Call to \"SObjectGetString\" failed"))
 			goto quit_error;
 
-		test_phone = phone_is_vowel(phoneset, phone_string, error);
+		features = phone_features(phoneset, numbered ? feature_ids : NULL,
+					  phone_string, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+			      "Syllabify",
+			      "Call to \"phone_features\" failed"))
+			goto quit_error;
+
+		levels[i] = phone_sonority_level(features);
 
 		itr_phoneList = SIteratorNext(itr_phoneList);
 		i++;
 	}
 
+	/* associate the first phones to the first syllable, up to the first vowel */
+	size_t last_head = 0;
+	i = 0;
+	while (i < num_phones && !test_phone)
+	{
+		test_phone = (levels[i] == vowel);
+		i++;
+	}
+
 	/* iteratively find the first phone of each syllable by first finding
 	 * the vowel of the next syllable and then looking backward for the
 	 * next syllable first phone */
-	while (itr_phoneList != NULL)
+	while (i < num_phones)
 	{
-		tmp = SIteratorObject(itr_phoneList, error);
-		if (S_CHK_ERR(error, S_CONTERR,
-			      "Syllabify",
-			      "Call to \"SIteratorObject\" failed"))
-			goto quit_error;
-
-		/* get phone name */
-		phone_string = SObjectGetString(tmp, error);
-		if (S_CHK_ERR(error, S_CONTERR,
-			      "Syllabify",
-			      "Call to \"SObjectGetString\" failed"))
-			goto quit_error;
-
-
-		/* check if the current phone is a vowel */
-		s_bool is_vowel = phone_is_vowel(phoneset, phone_string, error);
-		if (S_CHK_ERR(error, S_CONTERR,
-			      "Syllabify",
-			      "Call to \"phone_is_vowel\" failed"))
-			goto quit_error;
-
 		/* if the current phone is a vowel at the i-th position, begin a backward loop */
-		if (is_vowel)
+		if (levels[i] == vowel)
 		{
 			/* variables used for direction control */
 			/* set the initial sonority level to vowel */
@@ -548,39 +580,11 @@ static SList *Syllabify(const SSyllabification *self, const SItem *word,
 			enum PhoneLevels phone_level_p = phone_level;
 
 			size_t j = i - 1;
-			const SObject *tmp_1 = SListNth(phoneList, j, error);
-			if (S_CHK_ERR(error, S_CONTERR,
-				      "Syllabify",
-				      "Call to \"SListNth\" failed"))
-				goto quit_error;
-
-			const char* phone_string_1 = SObjectGetString(tmp_1, error);
-			if (S_CHK_ERR(error, S_CONTERR,
-				      "Syllabify",
-				      "Call to \"SObjectGetString\" failed"))
-				goto quit_error;
-
 			s_bool is_dec_c = FALSE;
 			while (!is_dec_c)
 			{
-				const SObject *tmp_2 = SListNth(phoneList, j, error);
-				if (S_CHK_ERR(error, S_CONTERR,
-					      "Syllabify",
-					      "Call to \"SListNth\" failed"))
-					goto quit_error;
-
-				phone_string_1 = SObjectGetString(tmp_2, error);
-				if (S_CHK_ERR(error, S_CONTERR,
-					      "Syllabify",
-					      "Call to \"SObjectGetString\" failed"))
-					goto quit_error;
-
 				phone_level_p = phone_level;
-				phone_level = phone_sonority_level(phoneset, phone_string_1, error);
-				if (S_CHK_ERR(error, S_CONTERR,
-					      "Syllabify",
-					      "Call to \"phone_sonority_level\" failed"))
-					goto quit_error;
+				phone_level = levels[j];
 
 				/* check for previous direction */
 				is_dec_c = phone_level > phone_level_p;
@@ -631,7 +635,6 @@ static SList *Syllabify(const SSyllabification *self, const SItem *word,
 			}/*end of inner while*/
 		}
 
-		itr_phoneList = SIteratorNext(itr_phoneList);
 		i++;
 	}/* end of outer while */
 	if (last_head < i)
@@ -650,6 +653,7 @@ static SList *Syllabify(const SSyllabification *self, const SItem *word,
 			goto quit_error;
 	}
 
+	S_FREE(levels);
 	return syllables;
 
 quit_error:
@@ -659,6 +663,9 @@ quit_error:
 	if (itr_phoneList != NULL)
 		S_DELETE(itr_phoneList, "Syllabify", error);
 
+	if (levels != NULL)
+		S_FREE(levels);
+
 	return NULL;
 
 	S_UNUSED(self);
@@ -70,28 +70,30 @@ static s_bool test_h_cluster(const SPhoneset *phoneset,
 static s_bool test_c_illformed(const SPhoneset *phoneset,
 							   const char *phone, s_erc *error);
 
-static int phone_type(const SPhoneset *phoneset, const char *phone, s_erc *error);
+static int phone_type(const SPhoneset *phoneset, const sint32 *vowel_id,
+					  const char *phone, s_erc *error);
 
-static s_bool stress_test1(const SPhoneset *phoneset,
+static s_bool stress_test1(const SPhoneset *phoneset, const sint32 *vowel_id,
 						   SList *secondLast, const SList *last, s_erc *error);
 
-static void add_syllable_stress(const SPhoneset *phoneset, SList *syllables, s_erc *error);
+static void add_syllable_stress(const SPhoneset *phoneset, const sint32 *vowel_id,
+								SList *syllables, s_erc *error);
 
-static s_bool consonant_vowel(const SPhoneset *phoneset, const SList *last,
-							  s_erc *error);
+static s_bool consonant_vowel(const SPhoneset *phoneset, const sint32 *vowel_id,
+							  const SList *last, s_erc *error);
 
 static s_bool phone_is_n_m(const char *phone, s_erc *error);
 
-static s_bool stress_test2(const SPhoneset *phoneset,
+static s_bool stress_test2(const SPhoneset *phoneset, const sint32 *vowel_id,
 						   SList *secondLast, const SList *last,
 						   s_erc *error);
 
-static s_bool consonant_semi_vowel(const SPhoneset *phoneset, const SList *last,
-								   s_erc *error);
+static s_bool consonant_semi_vowel(const SPhoneset *phoneset, const sint32 *vowel_id,
+								   const SList *last, s_erc *error);
 
 static s_bool phone_is_y_w(const char *phone, s_erc *error);
 
-static s_bool stress_test3(const SPhoneset *phoneset,
+static s_bool stress_test3(const SPhoneset *phoneset, const sint32 *vowel_id,
 						   SList *secondLast, const SList *last,
 						   s_erc *error);
 
@@ -270,16 +272,41 @@ static s_bool test_c_illformed(const SPhoneset *phoneset,
 }
 
 
-static int phone_type(const SPhoneset *phoneset, const char *phone, s_erc *error)
+/*
+ * vowel_id is the phoneset identifier of the "vowel" feature, or NULL
+ * if the phoneset does not number its phones and features, then the
+ * feature is queried by name.
+ */
+static int phone_type(const SPhoneset *phoneset, const sint32 *vowel_id,
+					  const char *phone, s_erc *error)
 {
 	s_bool is_vowel;
+	sint32 phone_id;
 
 
 	S_CLR_ERR(error);
-	is_vowel = S_PHONESET_CALL(phoneset, phone_has_feature)(phoneset,
-															phone,
-															"vowel",
-															error);
+
+	if (vowel_id != NULL)
+	{
+		phone_id = S_PHONESET_CALL(phoneset, get_phone_id)(phoneset, phone, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "phone_type",
+					  "Call to method \"get_phone_id\" failed"))
+			return 0;
+
+		is_vowel = S_PHONESET_CALL(phoneset, phone_id_has_feature)(phoneset,
+																   phone_id,
+																   (*vowel_id),
+																   error);
+	}
+	else
+	{
+		is_vowel = S_PHONESET_CALL(phoneset, phone_has_feature)(phoneset,
+																phone,
+																"vowel",
+																error);
+	}
+
 	if (S_CHK_ERR(error, S_CONTERR,
 				  "phone_type",
 				  "Call to method \"phone_has_feature\" failed"))
@@ -299,7 +326,7 @@ static int phone_type(const SPhoneset *phoneset, const char *phone, s_erc *error
  *   	( ANY * [ o ] - V # = o1 )
  *   	( ANY * [ u ] - V # = u1 )
  */
-static s_bool stress_test1(const SPhoneset *phoneset,
+static s_bool stress_test1(const SPhoneset *phoneset, const sint32 *vowel_id,
 						   SList *secondLast, const SList *last,
 						   s_erc *error)
 {
@@ -327,7 +354,7 @@ static s_bool stress_test1(const SPhoneset *phoneset,
 				  "Call to \"SListNth/SObjectGetString\" failed"))
 		return FALSE;
 
-	p_type = phone_type(phoneset, lphone, error);
+	p_type = phone_type(phoneset, vowel_id, lphone, error);
 	if (S_CHK_ERR(error, S_CONTERR,
 				  "stress_test1",
 				  "Call to \"phone_type\" failed"))
@@ -355,7 +382,7 @@ static s_bool stress_test1(const SPhoneset *phoneset,
 				  "Call to \"SObjectGetString\" failed"))
 		return FALSE;
 
-	p_type = phone_type(phoneset, lphone, error);
+	p_type = phone_type(phoneset, vowel_id, lphone, error);
 	if (S_CHK_ERR(error, S_CONTERR,
 				  "stress_test1",
 				  "Call to \"phone_type\" failed"))
@@ -411,8 +438,8 @@ static s_bool stress_test1(const SPhoneset *phoneset,
 }
 
 
-static s_bool consonant_vowel(const SPhoneset *phoneset, const SList *last,
-							  s_erc *error)
+static s_bool consonant_vowel(const SPhoneset *phoneset, const sint32 *vowel_id,
+							  const SList *last, s_erc *error)
 {
 	size_t size;
 	const char *lphone = NULL;
@@ -436,7 +463,7 @@ static s_bool consonant_vowel(const SPhoneset *phoneset, const SList *last,
 				  "Call to \"SListNth/SObjectGetString\" failed"))
 		return FALSE;
 
-	p_type = phone_type(phoneset, lphone, error);
+	p_type = phone_type(phoneset, vowel_id, lphone, error);
 	if (S_CHK_ERR(error, S_CONTERR,
 				  "consonant_vowel",
 				  "Call to \"phone_type\" failed"))
@@ -451,7 +478,7 @@ static s_bool consonant_vowel(const SPhoneset *phoneset, const SList *last,
 				  "Call to \"SListNth/SObjectGetString\" failed"))
 		return FALSE;
 
-	p_type = phone_type(phoneset, lphone, error);
+	p_type = phone_type(phoneset, vowel_id, lphone, error);
 	if (S_CHK_ERR(error, S_CONTERR,
 				  "consonant_vowel",
 				  "Call to \"phone_type\" failed"))
@@ -528,7 +555,7 @@ static s_bool phone_is_y_w(const char *phone, s_erc *error)
  *   	( ANY * [ m ] - C V # = m1 )
  *   	( ANY * [ n ] - C V # = n1 )
  */
-static s_bool stress_test2(const SPhoneset *phoneset,
+static s_bool stress_test2(const SPhoneset *phoneset, const sint32 *vowel_id,
 						   SList *secondLast, const SList *last,
 						   s_erc *error)
 {
@@ -543,7 +570,7 @@ static s_bool stress_test2(const SPhoneset *phoneset,
 
 	S_CLR_ERR(error);
 
-	is_good = consonant_vowel(phoneset, last, error);
+	is_good = consonant_vowel(phoneset, vowel_id, last, error);
 	if (S_CHK_ERR(error, S_CONTERR,
 				  "stress_test2",
 				  "Call to \"consonant_vowel\" failed"))
@@ -571,7 +598,7 @@ static s_bool stress_test2(const SPhoneset *phoneset,
 				  "Call to \"SObjectGetString\" failed"))
 		return FALSE;
 
-	p_type = phone_type(phoneset, lphone, error);
+	p_type = phone_type(phoneset, vowel_id, lphone, error);
 	if (S_CHK_ERR(error, S_CONTERR,
 				  "stress_test2",
 				  "Call to \"phone_type\" failed"))
@@ -633,8 +660,8 @@ static s_bool stress_test2(const SPhoneset *phoneset,
 }
 
 
-static s_bool consonant_semi_vowel(const SPhoneset *phoneset, const SList *last,
-								   s_erc *error)
+static s_bool consonant_semi_vowel(const SPhoneset *phoneset, const sint32 *vowel_id,
+								   const SList *last, s_erc *error)
 {
 	size_t size;
 	const char *lphone = NULL;
@@ -659,7 +686,7 @@ static s_bool consonant_semi_vowel(const SPhoneset *phoneset, const SList *last,
 				  "Call to \"SListNth/SObjectGetString\" failed"))
 		return FALSE;
 
-	p_type = phone_type(phoneset, lphone, error);
+	p_type = phone_type(phoneset, vowel_id, lphone, error);
 	if (S_CHK_ERR(error, S_CONTERR,
 				  "consonant_semi_vowel",
 				  "Call to \"phone_type\" failed"))
@@ -689,7 +716,7 @@ static s_bool consonant_semi_vowel(const SPhoneset *phoneset, const SList *last,
 				  "Call to \"SListNth/SObjectGetString\" failed"))
 		return FALSE;
 
-	p_type = phone_type(phoneset, lphone, error);
+	p_type = phone_type(phoneset, vowel_id, lphone, error);
 	if (S_CHK_ERR(error, S_CONTERR,
 				  "consonant_semi_vowel",
 				  "Call to \"phone_type\" failed"))
@@ -711,7 +738,7 @@ static s_bool consonant_semi_vowel(const SPhoneset *phoneset, const SList *last,
  *   	( ANY * [ m ] - C SV V # = m1 )
  *   	( ANY * [ n ] - C SV V # = n1 )
  */
-static s_bool stress_test3(const SPhoneset *phoneset,
+static s_bool stress_test3(const SPhoneset *phoneset, const sint32 *vowel_id,
 						   SList *secondLast, const SList *last,
 						   s_erc *error)
 {
@@ -726,7 +753,7 @@ static s_bool stress_test3(const SPhoneset *phoneset,
 
 	S_CLR_ERR(error);
 
-	is_good = consonant_semi_vowel(phoneset, last, error);
+	is_good = consonant_semi_vowel(phoneset, vowel_id, last, error);
 	if (S_CHK_ERR(error, S_CONTERR,
 				  "stress_test3",
 				  "Call to \"consonant_semi_vowel\" failed"))
@@ -754,7 +781,7 @@ static s_bool stress_test3(const SPhoneset *phoneset,
 				  "Call to \"SObjectGetString\" failed"))
 		return FALSE;
 
-	p_type = phone_type(phoneset, lphone, error);
+	p_type = phone_type(phoneset, vowel_id, lphone, error);
 	if (S_CHK_ERR(error, S_CONTERR,
 				  "stress_test3",
 				  "Call to \"phone_type\" failed"))
@@ -817,7 +844,8 @@ static s_bool stress_test3(const SPhoneset *phoneset,
 
 
 
-static void add_syllable_stress(const SPhoneset *phoneset, SList *syllables, s_erc *error)
+static void add_syllable_stress(const SPhoneset *phoneset, const sint32 *vowel_id,
+								SList *syllables, s_erc *error)
 {
 	size_t list_size;
 	SList *secondLast;
@@ -858,7 +886,7 @@ static void add_syllable_stress(const SPhoneset *phoneset, SList *syllables, s_e
 	if (list_size == 1)
 	{
 		/* test 1, "last syllable is a vowel" in scheme code */
-		done = stress_test1(phoneset, secondLast, last, error);
+		done = stress_test1(phoneset, vowel_id, secondLast, last, error);
 		if (S_CHK_ERR(error, S_CONTERR,
 					  "add_syllable_stress",
 					  "Call to \"stress_test1\" failed"))
@@ -870,7 +898,7 @@ static void add_syllable_stress(const SPhoneset *phoneset, SList *syllables, s_e
 	else if (list_size == 2)
 	{
 		/* test 2, "last syllable is a consonant followed by a vowel" in scheme code */
-		done = stress_test2(phoneset, secondLast, last, error);
+		done = stress_test2(phoneset, vowel_id, secondLast, last, error);
 		if (S_CHK_ERR(error, S_CONTERR,
 					  "add_syllable_stress",
 					  "Call to \"stress_test2\" failed"))
@@ -883,7 +911,7 @@ static void add_syllable_stress(const SPhoneset *phoneset, SList *syllables, s_e
 	else if (list_size == 3)
 	{
 		/* test 3, "ast syllable is a consonant followed a semi-vowel then a vowel" in scheme code */
-		done = stress_test3(phoneset, secondLast, last, error);
+		done = stress_test3(phoneset, vowel_id, secondLast, last, error);
 		if (S_CHK_ERR(error, S_CONTERR,
 					  "add_syllable_stress",
 					  "Call to \"stress_test3\" failed"))
@@ -1008,6 +1036,8 @@ static SList *Syllabify(const SSyllabification *self, const SItem *word,
 	size_t list_size;
 	int prev_type = 0; /* 0 = not defined, 1 = vowel, 2 = consonant */
 	char prev_consonant[4] = "\0";
+	sint32 vowel_feature;
+	const sint32 *vowel_id = NULL;
 
 
 	S_CLR_ERR(error);
@@ -1064,6 +1094,20 @@ static SList *Syllabify(const SSyllabification *self, const SItem *word,
 		goto quit_error;
 	}
 
+	/* look the vowel feature up once if phones can be queried by identifier */
+	if ((S_PHONESET_METH_VALID(phoneset, get_phone_id))
+		&& (S_PHONESET_METH_VALID(phoneset, get_feature_id))
+		&& (S_PHONESET_METH_VALID(phoneset, phone_id_has_feature)))
+	{
+		vowel_feature = S_PHONESET_CALL(phoneset, get_feature_id)(phoneset, "vowel", error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "Syllabify",
+					  "Call to method \"get_feature_id\" failed"))
+			goto quit_error;
+
+		vowel_id = &vowel_feature;
+	}
+
 	/* create syllables list */
 	syllables = S_LIST(S_NEW(SListList, error));
 	if (S_CHK_ERR(error, S_CONTERR,
@@ -1124,7 +1168,7 @@ static SList *Syllabify(const SSyllabification *self, const SItem *word,
 						  "Call to \"SListPush/SObjectSetString\" failed"))
 				goto quit_error;
 
-			prev_type = phone_type(phoneset, phone_string, error);
+			prev_type = phone_type(phoneset, vowel_id, phone_string, error);
 			if (S_CHK_ERR(error, S_CONTERR,
 						  "Syllabify",
 						  "Call to \"phone_type\" failed"))
@@ -1174,7 +1218,7 @@ static SList *Syllabify(const SSyllabification *self, const SItem *word,
 						  "Call to \"SListPush/SObjectSetString\" failed"))
 				goto quit_error;
 
-			prev_type = phone_type(phoneset, phone_string, error);
+			prev_type = phone_type(phoneset, vowel_id, phone_string, error);
 			if (S_CHK_ERR(error, S_CONTERR,
 						  "Syllabify",
 						  "Call to \"phone_type\" failed"))
@@ -1292,7 +1336,7 @@ static SList *Syllabify(const SSyllabification *self, const SItem *word,
 							  "Call to \"SListPush/SObjectSetString\" failed"))
 					goto quit_error;
 
-				prev_type = phone_type(phoneset, phone_string, error);
+				prev_type = phone_type(phoneset, vowel_id, phone_string, error);
 				if (S_CHK_ERR(error, S_CONTERR,
 							  "Syllabify",
 							  "Call to \"phone_type\" failed"))
@@ -1320,7 +1364,7 @@ static SList *Syllabify(const SSyllabification *self, const SItem *word,
 						  "Call to \"SListPush/SObjectSetString\" failed"))
 				goto quit_error;
 
-			prev_type = phone_type(phoneset, phone_string, error);
+			prev_type = phone_type(phoneset, vowel_id, phone_string, error);
 			if (S_CHK_ERR(error, S_CONTERR,
 						  "Syllabify",
 						  "Call to \"phone_type\" failed"))
@@ -1340,7 +1384,7 @@ static SList *Syllabify(const SSyllabification *self, const SItem *word,
 
 	S_DELETE(phoneListCopy, "Syllabify", error);
 
-	add_syllable_stress(phoneset, syllables, error);
+	add_syllable_stress(phoneset, vowel_id, syllables, error);
 	if (S_CHK_ERR(error, S_CONTERR,
 				  "Syllabify",
 				  "Call to \"add_syllable_stress\" failed"))
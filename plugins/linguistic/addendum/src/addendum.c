@@ -167,5 +167,6 @@ static SAddendumClass AddendumClass =
 	NULL,             /* get_version     */
 	NULL,             /* get_feature     */
 	NULL,             /* get_word        */
-	NULL              /* add_word        */
+	NULL,             /* add_word        */
+	NULL              /* foreach_word    */
 };
@@ -159,6 +159,23 @@ typedef struct
 } s_addendum_info;
 
 
+/**
+ * Function that is called by #SAddendumClass::foreach_word for every
+ * word of an addendum.
+ *
+ * @param word The word.
+ * @param info The phones of the word, or its syllables (lists of
+ * phones) if @c syllabified is @c TRUE.
+ * @param syllabified If the word is syllabified.
+ * @param userdata The user data given to
+ * #SAddendumClass::foreach_word.
+ * @param error Error code.
+ */
+typedef void (*s_addendum_word_fp)(const char *word, const SList *info,
+								   s_bool syllabified, void *userdata,
+								   s_erc *error);
+
+
 /************************************************************************************/
 /*                                                                                  */
 /* SAddendum definition                                                             */
@@ -316,6 +333,23 @@ typedef struct
 	 */
 	void             (*add_word)           (SAddendum *self, const char *word,
 											SMap *features, s_erc *error);
+
+	/**
+	 * Call the given function for every word of the addendum, with
+	 * the first entry of the word (as @c get_word with @c NULL
+	 * features). This method is optional, it is @c NULL if the
+	 * addendum can not list its words.
+	 *
+	 * @param self The given addendum.
+	 * @param func The function to call for every word.
+	 * @param userdata User data passed to @c func.
+	 * @param error Error code.
+	 *
+	 * @note The word strings and lists given to @c func belong to
+	 * the addendum, they are valid until the addendum is deleted.
+	 */
+	void             (*foreach_word)       (const SAddendum *self, s_addendum_word_fp func,
+											void *userdata, s_erc *error);
 } SAddendumClass;
 
 
@@ -167,5 +167,6 @@ static SLexiconClass LexiconClass =
 	NULL,             /* get_lang_code   */
 	NULL,             /* get_version     */
 	NULL,             /* get_feature     */
-	NULL              /* get_word        */
+	NULL,             /* get_word        */
+	NULL              /* foreach_word    */
 };
@@ -158,6 +158,23 @@ typedef struct
 } s_lex_info;
 
 
+/**
+ * Function that is called by #SLexiconClass::foreach_word for every
+ * word of a lexicon.
+ *
+ * @param word The word.
+ * @param info The phones of the word, or its syllables (lists of
+ * phones) if @c syllabified is @c TRUE.
+ * @param syllabified If the word is syllabified.
+ * @param userdata The user data given to
+ * #SLexiconClass::foreach_word.
+ * @param error Error code.
+ */
+typedef void (*s_lexicon_word_fp)(const char *word, const SList *info,
+								  s_bool syllabified, void *userdata,
+								  s_erc *error);
+
+
 /************************************************************************************/
 /*                                                                                  */
 /* SLexicon definition                                                              */
@@ -296,6 +313,23 @@ typedef struct
 	SList           *(*get_word)           (const SLexicon *self, const char *word,
 											const SMap *features, s_bool *syllabified,
 											s_erc *error);
+
+	/**
+	 * Call the given function for every word of the lexicon, with
+	 * the first entry of the word (as @c get_word with @c NULL
+	 * features). This method is optional, it is @c NULL if the
+	 * lexicon can not list its words.
+	 *
+	 * @param self The given lexicon.
+	 * @param func The function to call for every word.
+	 * @param userdata User data passed to @c func.
+	 * @param error Error code.
+	 *
+	 * @note The word strings and lists given to @c func belong to
+	 * the lexicon, they are valid until the lexicon is deleted.
+	 */
+	void             (*foreach_word)       (const SLexicon *self, s_lexicon_word_fp func,
+											void *userdata, s_erc *error);
 } SLexiconClass;
 
 
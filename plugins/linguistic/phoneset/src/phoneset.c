@@ -103,6 +103,7 @@ static void Init(void *obj, s_erc *error)
 	}
 
 	self->features = NULL;
+	self->ids = NULL;
 }
 
 
@@ -131,6 +132,23 @@ static void Destroy(void *obj, s_erc *error)
 
 	if (self->features != NULL)
 		S_DELETE(self->features, "Destroy", error);
+
+	if (self->ids != NULL)
+	{
+		s_erc local_err = S_SUCCESS;
+
+
+		if (self->ids->phone_ids != NULL)
+			s_hash_table_delete(self->ids->phone_ids, &local_err);
+
+		if (self->ids->feature_ids != NULL)
+			s_hash_table_delete(self->ids->feature_ids, &local_err);
+
+		S_FREE(self->ids->phone_names);
+		S_FREE(self->ids->feature_names);
+		S_FREE(self->ids->masks);
+		S_FREE(self->ids);
+	}
 }
 
 
@@ -171,5 +189,10 @@ static SPhonesetClass PhonesetClass =
 	NULL,             /* phone_has_feature  */
 	NULL,             /* has_phone          */
 	NULL,             /* get_phone_features */
-	NULL              /* get_phone_list     */
+	NULL,             /* get_phone_list     */
+	NULL,             /* get_num_phones     */
+	NULL,             /* get_phone_id       */
+	NULL,             /* get_phone_name     */
+	NULL,             /* get_feature_id     */
+	NULL              /* phone_id_has_feature */
 };
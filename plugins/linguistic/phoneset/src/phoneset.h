@@ -161,6 +161,61 @@ typedef struct
 } s_phoneset_info;
 
 
+/**
+ * The phoneset identifiers structure. Phones and features are
+ * numbered densely from 0, and the features of a phone are a bitmask
+ * with a bit for every feature, which makes a query a table lookup
+ * instead of a search through the phone's feature list.
+ */
+typedef struct
+{
+	/**
+	 * Number of phones in the phoneset.
+	 */
+	uint32        num_phones;
+
+	/**
+	 * Number of different features of the phones.
+	 */
+	uint32        num_features;
+
+	/**
+	 * Number of @c uint32 words in the feature bitmask of a phone.
+	 */
+	uint32        mask_size;
+
+	/**
+	 * Phone names, indexed by phone identifier. The names are the
+	 * keys of the @c phone_ids table.
+	 */
+	const char  **phone_names;
+
+	/**
+	 * Feature names, indexed by feature identifier. The names are the
+	 * keys of the @c feature_ids table.
+	 */
+	const char  **feature_names;
+
+	/**
+	 * Feature bitmasks, @c mask_size words for every phone
+	 * identifier.
+	 */
+	uint32       *masks;
+
+	/**
+	 * Phone name to phone identifier (#uint32*) lookup table, which
+	 * owns the names and identifiers.
+	 */
+	s_hash_table *phone_ids;
+
+	/**
+	 * Feature name to feature identifier (#uint32*) lookup table,
+	 * which owns the names and identifiers.
+	 */
+	s_hash_table *feature_ids;
+} s_phoneset_ids;
+
+
 /************************************************************************************/
 /*                                                                                  */
 /* SPhoneset definition                                                             */
@@ -187,6 +242,12 @@ typedef struct
 	 * @protected Features
 	 */
 	SMap            *features;
+
+	/**
+	 * @protected Phone and feature identifiers, @c NULL if the
+	 * phoneset implementation does not number its phones.
+	 */
+	s_phoneset_ids  *ids;
 } SPhoneset;
 
 
@@ -330,6 +391,74 @@ typedef struct
 	 * list.
 	 */
 	SList           *(*get_phone_list)     (const SPhoneset *self, s_erc *error);
+
+	/**
+	 * Get the number of phones in the phoneset. Phone identifiers
+	 * are in the range <tt>[0, num_phones)</tt>.
+	 *
+	 * @param self The given phoneset.
+	 * @param error Error code.
+	 *
+	 * @return The number of phones in the phoneset.
+	 */
+	uint32           (*get_num_phones)     (const SPhoneset *self, s_erc *error);
+
+	/**
+	 * Get the identifier of the given phone. Callers that query a
+	 * phone more than once can look up its identifier once and use
+	 * the identifier based methods.
+	 *
+	 * @param self The given phoneset.
+	 * @param phone The phone for which the identifier is requested.
+	 * @param error Error code.
+	 *
+	 * @return The phone identifier, or @c -1 if the phone is not in
+	 * the phoneset.
+	 */
+	sint32           (*get_phone_id)       (const SPhoneset *self, const char *phone,
+											s_erc *error);
+
+	/**
+	 * Get the name of the phone with the given identifier.
+	 *
+	 * @param self The given phoneset.
+	 * @param phone_id The phone identifier.
+	 * @param error Error code.
+	 *
+	 * @return The phone name, or @c NULL if the identifier is not
+	 * valid.
+	 */
+	const char      *(*get_phone_name)     (const SPhoneset *self, sint32 phone_id,
+											s_erc *error);
+
+	/**
+	 * Get the identifier of the given phone feature.
+	 *
+	 * @param self The given phoneset.
+	 * @param feature The feature for which the identifier is requested.
+	 * @param error Error code.
+	 *
+	 * @return The feature identifier, or @c -1 if none of the phones
+	 * in the phoneset have the feature.
+	 */
+	sint32           (*get_feature_id)     (const SPhoneset *self, const char *feature,
+											s_erc *error);
+
+	/**
+	 * Query if the phone with the given identifier has the feature
+	 * with the given identifier, see #SPhonesetClass::phone_has_feature.
+	 *
+	 * @param self The given phoneset.
+	 * @param phone_id The phone identifier.
+	 * @param feature_id The feature identifier.
+	 * @param error Error code.
+	 *
+	 * @return @c TRUE if the feature is defined for the given phone,
+	 * else @c FALSE. If either identifier is @c -1 (not in the
+	 * phoneset) then @c FALSE is returned.
+	 */
+	s_bool           (*phone_id_has_feature)(const SPhoneset *self, sint32 phone_id,
+											 sint32 feature_id, s_erc *error);
 } SPhonesetClass;
 
 
@@ -196,8 +196,11 @@ static SUttProcessorCBClass UttProcessorCBClass =
 			NULL,            /* copy    */
 		},
 		/* SUttProcessorClass */
-		NULL,                /* initialize */
-		Run,                 /* run        */
+		NULL,                /* initialize    */
+		Run,                 /* run           */
+		NULL,                /* create_state  */
+		NULL,                /* destroy_state */
+		NULL,                /* run_state     */
 	},
 	SetCallback              /* set_callback */
 };
@@ -45,7 +45,9 @@
 %{
 	/*
 	 * Function that executes the Python callback
-	 * by calling PyObject_CallObject
+	 * by calling PyObject_CallObject. Utterance processors can run in
+	 * the worker threads of a synthesis pool, which do not hold the
+	 * Python GIL, so it is acquired for the duration of the call.
 	 */
 	static void execute_python_callback(SUtterance *utt, void *sfunction, s_erc *error)
 	{
@@ -53,6 +55,7 @@
 		PyObject *func;
 		PyObject *arglist;
 		PyObject *result;
+		PyGILState_STATE gstate;
 
 
 		S_CLR_ERR(error);
@@ -76,6 +79,8 @@
 		/* get Python function */
 		func = (PyObject*)sfunction;
 
+		gstate = PyGILState_Ensure();
+
 		/* Create Python utterance from the utt, FALSE as Python does
 		 * not own the utterance
 		 */
@@ -83,7 +88,10 @@
 		if (S_CHK_ERR(error, S_CONTERR,
 					  "execute_python_callback",
 					  "Call to \"s_sobject_2_pyobject\" failed"))
+		{
+			PyGILState_Release(gstate);
 			return;
+		}
 
 		/* create argument list */
 		arglist = Py_BuildValue("(O)", pyUtt);
@@ -105,6 +113,10 @@
 						  "execute_python_callback",
 						  "Call to \"Py_BuildValue\" failed");
 			}
+
+			Py_DECREF(pyUtt);
+			PyGILState_Release(gstate);
+			return;
 		}
 
 		/* call Python and execute the function */
@@ -135,6 +147,7 @@
 
 			/* cleanup */
 			Py_DECREF(pyUtt);
+			PyGILState_Release(gstate);
 
 			return;
 		}
@@ -144,6 +157,7 @@
 
 		/* this should be None */
 		Py_DECREF(result);
+		PyGILState_Release(gstate);
 	}
 
 
@@ -151,15 +165,19 @@
 	{
 		PyObject *callback_func;
 		SUttProcessorCB *self = S_UTTPROCESSOR_CB(uttProcPy);
+		PyGILState_STATE gstate;
 
 
 		callback_func = (PyObject*)self->sfunction;
 		self->sfunction = NULL;
 
 		/* decrement the reference count, we don't need
-		 * this function anymore
+		 * this function anymore (the voice may be deleted
+		 * outside of the Python thread)
 		 */
+		gstate = PyGILState_Ensure();
 		Py_DECREF(callback_func);
+		PyGILState_Release(gstate);
 	}
 
 
@@ -40,6 +40,8 @@
 /*                                                                                  */
 /************************************************************************************/
 
+#include <stddef.h>
+#include <string.h>
 #include "synthesize_hts_engine.h"
 #include "audio.h"
 
@@ -50,13 +52,15 @@
 /*                                                                                  */
 /************************************************************************************/
 
+/* prefix of the voice data key of the shared HTS Engine model */
+#define SPCT_HTS_MODEL_DATA_KEY "hts engine model 1.05"
+
 /* default values for HTS Engine params */
 #define SPCT_DEF_SAMPLING_RATE 16000
 #define SPCT_DEF_FPERIOD 80
 #define SPCT_DEF_ALPHA 0.42
 #define SPCT_DEF_STAGE 0.0
 #define SPCT_DEF_BETA 0.0
-#define SPCT_DEF_AUDIO_BUFF_SIZE 1600
 #define SPCT_DEF_UV_THRESHOLD 0.5
 #define SPCT_DEF_GV_WEIGHT_MCP 0.7
 #define SPCT_DEF_GV_WEIGHT_LF0 1.0
@@ -75,7 +79,6 @@ typedef struct
 	double alpha;
 	int stage;
 	double beta;
-	int audio_buff_size;
 	double uv_threshold;
 	HTS_Boolean use_log_gain;
 	double gv_weight_mcp;
@@ -83,6 +86,31 @@ typedef struct
 } hts_params;
 
 
+/*
+ * The members of HTS_Engine as handled by the run states: the global
+ * settings and the model set are shared with the model's engine, the
+ * others are private to a run. A per-run engine would share any other
+ * member unknowingly, so the build fails below if this hts_engine
+ * version has a different HTS_Engine.
+ */
+typedef struct
+{
+	HTS_Global     global;
+	HTS_Audio      audio;
+	HTS_ModelSet   ms;
+	HTS_Label      label;
+	HTS_SStreamSet sss;
+	HTS_PStreamSet pss;
+	HTS_GStreamSet gss;
+} s_hts_engine_layout;
+
+typedef char s_hts_engine_layout_check[
+	((sizeof(HTS_Engine) == sizeof(s_hts_engine_layout))
+	 && (offsetof(HTS_Engine, ms) == offsetof(s_hts_engine_layout, ms))
+	 && (offsetof(HTS_Engine, label) == offsetof(s_hts_engine_layout, label))
+	 && (offsetof(HTS_Engine, gss) == offsetof(s_hts_engine_layout, gss))) ? 1 : -1];
+
+
 /************************************************************************************/
 /*                                                                                  */
 /* Static variables                                                                 */
@@ -92,6 +120,9 @@ typedef struct
 /* SHTSEngineSynthUttProc105 class declaration. */
 static SHTSEngineSynthUttProc105Class HTSEngineSynthUttProc105Class;
 
+/* SHTSEngineModel105 class declaration. */
+static SHTSEngineModel105Class HTSEngineModel105Class;
+
 
 /************************************************************************************/
 /*                                                                                  */
@@ -111,10 +142,19 @@ static void get_trees_pdfs(const SList *trees, const SList *pdfs,
 static void load_hts_engine_data(const SMap *data, HTS_Engine *engine,
 								 const char *voice_base_path, s_erc *error);
 
-static void check_and_change_rate_volume(SHTSEngineSynthUttProc105 *HTSsynth,
+static void load_hts_engine_model(SHTSEngineModel105 *model, const SMap *features,
+								  const SVoice *voice, s_erc *error);
+
+static char *get_hts_model_key(const SMap *features, const SVoice *voice, s_erc *error);
+
+static void add_hts_data_to_hts_model_key(char **key, const SObject *data, s_erc *error);
+
+static void add_to_hts_model_key(char **key, const char *s, s_erc *error);
+
+static void check_and_change_rate_volume(HTS_Engine *engine,
 	const SUtterance *utt, s_erc *error);
 
-static void check_and_change_tone(SHTSEngineSynthUttProc105 *HTSsynth,
+static void check_and_change_tone(HTS_Engine *engine,
 	const SUtterance *utt, s_erc *error);
 
 /************************************************************************************/
@@ -127,20 +167,42 @@ static void check_and_change_tone(SHTSEngineSynthUttProc105 *HTSsynth,
 S_LOCAL void _s_hts_engine_synth_utt_proc_105_class_reg(s_erc *error)
 {
 	S_CLR_ERR(error);
+	s_class_reg(S_OBJECTCLASS(&HTSEngineModel105Class), error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "_s_hts_engine_synth_utt_proc_class_reg",
+				  "Failed to register SHTSEngineModel105Class"))
+		return;
+
 	s_class_reg(S_OBJECTCLASS(&HTSEngineSynthUttProc105Class), error);
-	S_CHK_ERR(error, S_CONTERR,
-			  "_s_hts_engine_synth_utt_proc_class_reg",
-			  "Failed to register SHTSEngineSynthUttProc105Class");
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "_s_hts_engine_synth_utt_proc_class_reg",
+				  "Failed to register SHTSEngineSynthUttProc105Class"))
+	{
+		s_erc local_err = S_SUCCESS;
+
+
+		s_class_free(S_OBJECTCLASS(&HTSEngineModel105Class), &local_err);
+	}
 }
 
 
 S_LOCAL void _s_hts_engine_synth_utt_proc_105_class_free(s_erc *error)
 {
+	s_erc local_err = S_SUCCESS;
+
+
 	S_CLR_ERR(error);
 	s_class_free(S_OBJECTCLASS(&HTSEngineSynthUttProc105Class), error);
 	S_CHK_ERR(error, S_CONTERR,
 			  "_s_hts_engine_synth_utt_proc_class_free",
 			  "Failed to free SHTSEngineSynthUttProc105Class");
+
+	s_class_free(S_OBJECTCLASS(&HTSEngineModel105Class), &local_err);
+	if (S_CHK_ERR(&local_err, S_CONTERR,
+				  "_s_hts_engine_synth_utt_proc_class_free",
+				  "Failed to free SHTSEngineModel105Class")
+		&& (*error == S_SUCCESS))
+		*error = local_err;
 }
 
 
@@ -150,7 +212,7 @@ S_LOCAL void _s_hts_engine_synth_utt_proc_105_class_free(s_erc *error)
 /*                                                                                  */
 /************************************************************************************/
 
-static void check_and_change_rate_volume(SHTSEngineSynthUttProc105 *HTSsynth,
+static void check_and_change_rate_volume(HTS_Engine *engine,
 	const SUtterance *utt, s_erc *error)
 {
 	s_bool utt_feature_is_present=FALSE;
@@ -183,7 +245,7 @@ static void check_and_change_rate_volume(SHTSEngineSynthUttProc105 *HTSsynth,
 				return;
 
 			if (var != 1.0f)
-				HTS_Label_set_speech_speed(&(HTSsynth->engine.label), var);
+				HTS_Label_set_speech_speed(&(engine->label), var);
 		}
 	}
 
@@ -210,13 +272,13 @@ static void check_and_change_rate_volume(SHTSEngineSynthUttProc105 *HTSsynth,
 				return;
 
 			if (var != 1.0f)
-				HTS_Engine_set_volume(&(HTSsynth->engine), var);
+				HTS_Engine_set_volume(engine, var);
 		}
 	}
 }
 
 
-static void check_and_change_tone(SHTSEngineSynthUttProc105 *HTSsynth,
+static void check_and_change_tone(HTS_Engine *engine,
 	const SUtterance *utt, s_erc *error)
 {
 	s_bool utt_feature_is_present=FALSE;
@@ -253,13 +315,13 @@ static void check_and_change_tone(SHTSEngineSynthUttProc105 *HTSsynth,
 				int i;
 				double f;
 
-				for (i = 0; i < HTS_SStreamSet_get_total_state(&(HTSsynth->engine.sss)); i++)
+				for (i = 0; i < HTS_SStreamSet_get_total_state(&(engine->sss)); i++)
 				{
-					f = HTS_SStreamSet_get_mean(&(HTSsynth->engine.sss), 1, i, 0); /* logf0 is stream 1 */
+					f = HTS_SStreamSet_get_mean(&(engine->sss), 1, i, 0); /* logf0 is stream 1 */
 					f += var * log(2.0) / 12;
 					if (f < log(10.0))
 						f = log(10.0);
-					HTS_SStreamSet_set_mean(&(HTSsynth->engine.sss), 1, i, 0, f);
+					HTS_SStreamSet_set_mean(&(engine->sss), 1, i, 0, f);
 				}
 			}
 		}
@@ -318,13 +380,6 @@ static hts_params *get_hts_engine_params(const SMap *features, s_erc *error)
 				  "Call to \"SMapGetFloatDef\" failed"))
 		goto quit_error;
 
-	engine_params->audio_buff_size = (int)SMapGetIntDef(features, "audio_buff_size",
-														SPCT_DEF_AUDIO_BUFF_SIZE, error);
-	if (S_CHK_ERR(error, S_CONTERR,
-				  "get_hts_engine_params",
-				  "Call to \"SMapGetIntDef\" failed"))
-		goto quit_error;
-
 	engine_params->uv_threshold = (double)SMapGetFloatDef(features, "uv_threshold",
 														  SPCT_DEF_UV_THRESHOLD, error);
 	if (S_CHK_ERR(error, S_CONTERR,
@@ -981,34 +1036,174 @@ static void load_hts_engine_data(const SMap *data, HTS_Engine *engine,
 }
 
 
-/************************************************************************************/
-/*                                                                                  */
-/* Static class function implementations                                            */
-/*                                                                                  */
-/************************************************************************************/
+static void add_to_hts_model_key(char **key, const char *s, s_erc *error)
+{
+	char *buf;
 
-/* we need to delete the window plug-in if any */
-static void Destroy(void *obj, s_erc *error)
+
+	S_CLR_ERR(error);
+
+	s_asprintf(&buf, error, "%s %s", *key, s);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "add_to_hts_model_key",
+				  "Call to \"s_asprintf\" failed"))
+		return;
+
+	S_FREE(*key);
+	*key = buf;
+}
+
+
+/* add the "hts engine data" (the model file names) to the model key */
+static void add_hts_data_to_hts_model_key(char **key, const SObject *data, s_erc *error)
 {
-	SHTSEngineSynthUttProc105 *self = obj;
+	SIterator *itr;
+	char *buf;
+	s_bool is_map;
+	s_bool is_list;
 
 
 	S_CLR_ERR(error);
-	HTS_Engine_clear(&(self->engine));
+
+	is_map = SObjectIsType(data, "SMap", error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "add_hts_data_to_hts_model_key",
+				  "Call to \"SObjectIsType\" failed"))
+		return;
+
+	is_list = SObjectIsType(data, "SList", error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "add_hts_data_to_hts_model_key",
+				  "Call to \"SObjectIsType\" failed"))
+		return;
+
+	if (!is_map && !is_list)
+	{
+		buf = SObjectPrint(data, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "add_hts_data_to_hts_model_key",
+					  "Call to \"SObjectPrint\" failed"))
+			return;
+
+		add_to_hts_model_key(key, buf, error);
+		S_FREE(buf);
+		S_CHK_ERR(error, S_CONTERR,
+				  "add_hts_data_to_hts_model_key",
+				  "Call to \"add_to_hts_model_key\" failed");
+		return;
+	}
+
+	itr = S_ITERATOR_GET(data, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "add_hts_data_to_hts_model_key",
+				  "Call to \"S_ITERATOR_GET\" failed"))
+		return;
+
+	while (itr != NULL)
+	{
+		if (is_map)
+		{
+			add_to_hts_model_key(key, SIteratorKey(itr, error), error);
+			if (S_CHK_ERR(error, S_CONTERR,
+						  "add_hts_data_to_hts_model_key",
+						  "Call to \"SIteratorKey/add_to_hts_model_key\" failed"))
+			{
+				S_DELETE(itr, "add_hts_data_to_hts_model_key", error);
+				return;
+			}
+		}
+
+		add_hts_data_to_hts_model_key(key, SIteratorObject(itr, error), error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "add_hts_data_to_hts_model_key",
+					  "Call to \"SIteratorObject/add_hts_data_to_hts_model_key\" failed"))
+		{
+			S_DELETE(itr, "add_hts_data_to_hts_model_key", error);
+			return;
+		}
+
+		itr = SIteratorNext(itr);
+	}
 }
 
 
-static void Dispose(void *obj, s_erc *error)
+/* The voice data key of the model: the plug-in version, the voice
+ * configuration file, the engine settings and the model files.
+ * Synthesizers of a voice only share a model if they would load
+ * exactly the same one.
+ */
+static char *get_hts_model_key(const SMap *features, const SVoice *voice, s_erc *error)
 {
+	hts_params *engine_params;
+	const SObject *vcfgObject;
+	const SObject *hts_data;
+	const char *config_file;
+	char *key = NULL;
+
+
 	S_CLR_ERR(error);
-	SObjectDecRef(obj);
+
+	vcfgObject = SVoiceGetFeature(voice, "config_file", error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "get_hts_model_key",
+				  "Call to \"SVoiceGetFeature\" failed, failed to get voice config file"))
+		return NULL;
+
+	config_file = SObjectGetString(vcfgObject, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "get_hts_model_key",
+				  "Call to \"SObjectGetString\" failed"))
+		return NULL;
+
+	engine_params = get_hts_engine_params(features, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "get_hts_model_key",
+				  "Call to \"get_hts_engine_params\" failed"))
+		return NULL;
+
+	s_asprintf(&key, error, "%s %s %d %d %g %d %g %g %d %g %g",
+			   SPCT_HTS_MODEL_DATA_KEY, config_file,
+			   engine_params->sampling_rate, engine_params->fperiod,
+			   engine_params->alpha, engine_params->stage, engine_params->beta,
+			   engine_params->uv_threshold, engine_params->use_log_gain,
+			   engine_params->gv_weight_mcp, engine_params->gv_weight_lf0);
+	S_FREE(engine_params);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "get_hts_model_key",
+				  "Call to \"s_asprintf\" failed"))
+		goto quit_error;
+
+	hts_data = SVoiceGetFeature(voice, "hts engine data", error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "get_hts_model_key",
+				  "Call to \"SVoiceGetFeature\" failed"))
+		goto quit_error;
+
+	if (hts_data != NULL)
+	{
+		add_hts_data_to_hts_model_key(&key, hts_data, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "get_hts_model_key",
+					  "Call to \"add_hts_data_to_hts_model_key\" failed"))
+			goto quit_error;
+	}
+
+	/* all OK */
+	return key;
+
+	/* error clean up */
+quit_error:
+	if (key != NULL)
+		S_FREE(key);
+
+	return NULL;
 }
 
 
-static void Initialize(SUttProcessor *self, const SVoice *voice, s_erc *error)
+static void load_hts_engine_model(SHTSEngineModel105 *model, const SMap *features,
+								  const SVoice *voice, s_erc *error)
 {
 	hts_params *engine_params;
-	SHTSEngineSynthUttProc105 *HTSsynth = (SHTSEngineSynthUttProc105*)self;
 	const SMap *hts_data;
 	const SObject *vcfgObject;
 	char *voice_base_path;
@@ -1019,69 +1214,69 @@ static void Initialize(SUttProcessor *self, const SVoice *voice, s_erc *error)
 	/* get voice base path */
 	vcfgObject = SVoiceGetFeature(voice, "config_file", error);
 	if (S_CHK_ERR(error, S_CONTERR,
-				  "Initialize",
+				  "load_hts_engine_model",
 				  "Call to \"SVoiceGetFeature\" failed, failed to get voice config file"))
 		return;
 
 	voice_base_path = s_get_base_path(SObjectGetString(vcfgObject, error), error);
 	if (S_CHK_ERR(error, S_CONTERR,
-				  "Initialize",
+				  "load_hts_engine_model",
 				  "Call to \"s_get_base_path/SObjectGetString\" failed"))
 		return;
 
 	/* get the HTS engine settings */
-	engine_params = get_hts_engine_params(self->features, error);
+	engine_params = get_hts_engine_params(features, error);
 	if (S_CHK_ERR(error, S_CONTERR,
-				  "Initialize",
+				  "load_hts_engine_model",
 				  "Call to \"get_hts_engine_params\" failed"))
 	{
 		S_FREE(voice_base_path);
 		return;
 	}
 
-	/* initialize the engine */
-	HTS_Engine_initialize(&(HTSsynth->engine), 2);
-
 	/* set the engine parameters */
-	HTS_Engine_set_sampling_rate(&(HTSsynth->engine), engine_params->sampling_rate);
-	HTS_Engine_set_fperiod(&(HTSsynth->engine), engine_params->fperiod);
-	HTS_Engine_set_alpha(&(HTSsynth->engine), engine_params->alpha);
-	HTS_Engine_set_gamma(&(HTSsynth->engine), engine_params->stage);
-	HTS_Engine_set_log_gain(&(HTSsynth->engine), engine_params->use_log_gain);
-	HTS_Engine_set_beta(&(HTSsynth->engine), engine_params->beta);
-	HTS_Engine_set_audio_buff_size(&(HTSsynth->engine), engine_params->audio_buff_size);
-	HTS_Engine_set_msd_threshold(&(HTSsynth->engine), 1, engine_params->uv_threshold);
-	HTS_Engine_set_gv_weight(&(HTSsynth->engine), 0, engine_params->gv_weight_mcp);
-	HTS_Engine_set_gv_weight(&(HTSsynth->engine), 1, engine_params->gv_weight_lf0);
+	HTS_Engine_set_sampling_rate(&(model->engine), engine_params->sampling_rate);
+	HTS_Engine_set_fperiod(&(model->engine), engine_params->fperiod);
+	HTS_Engine_set_alpha(&(model->engine), engine_params->alpha);
+	HTS_Engine_set_gamma(&(model->engine), engine_params->stage);
+	HTS_Engine_set_log_gain(&(model->engine), engine_params->use_log_gain);
+	HTS_Engine_set_beta(&(model->engine), engine_params->beta);
+	/* the samples are returned in the utterance, an audio output buffer
+	 * in the engine would be shared by all the runs of the model
+	 */
+	HTS_Engine_set_audio_buff_size(&(model->engine), 0);
+	HTS_Engine_set_msd_threshold(&(model->engine), 1, engine_params->uv_threshold);
+	HTS_Engine_set_gv_weight(&(model->engine), 0, engine_params->gv_weight_mcp);
+	HTS_Engine_set_gv_weight(&(model->engine), 1, engine_params->gv_weight_lf0);
 
 
 	S_FREE(engine_params);
 
 	hts_data = S_MAP(SVoiceGetFeature(voice, "hts engine data", error));
 	if (S_CHK_ERR(error, S_CONTERR,
-				  "Initialize",
+				  "load_hts_engine_model",
 				  "Call to \"SVoiceGetFeature\" failed"))
 		goto quit_error;
 
 	if (hts_data == NULL)
 	{
 		S_CTX_ERR(error, S_FAILURE,
-				  "Initialize",
+				  "load_hts_engine_model",
 				  "Failed to get \"hts engine data\" map from voice features");
 		goto quit_error;
 	}
 
-	load_hts_engine_data(hts_data, &(HTSsynth->engine), voice_base_path, error);
+	load_hts_engine_data(hts_data, &(model->engine), voice_base_path, error);
 	if (S_CHK_ERR(error, S_CONTERR,
-				  "Initialize",
+				  "load_hts_engine_model",
 				  "Call to \"load_hts_engine_data\" failed"))
 		goto quit_error;
 
-	HTS_Engine_set_duration_interpolation_weight(&(HTSsynth->engine), 0, 1.0);
-	HTS_Engine_set_parameter_interpolation_weight(&(HTSsynth->engine), 0, 0, 1.0);
-	HTS_Engine_set_parameter_interpolation_weight(&(HTSsynth->engine), 1, 0, 1.0);
-	HTS_Engine_set_gv_interpolation_weight(&(HTSsynth->engine), 0, 0, 1.0);
-	HTS_Engine_set_gv_interpolation_weight(&(HTSsynth->engine), 1, 0, 1.0);
+	HTS_Engine_set_duration_interpolation_weight(&(model->engine), 0, 1.0);
+	HTS_Engine_set_parameter_interpolation_weight(&(model->engine), 0, 0, 1.0);
+	HTS_Engine_set_parameter_interpolation_weight(&(model->engine), 1, 0, 1.0);
+	HTS_Engine_set_gv_interpolation_weight(&(model->engine), 0, 0, 1.0);
+	HTS_Engine_set_gv_interpolation_weight(&(model->engine), 1, 0, 1.0);
 
 
 	/* all OK */
@@ -1090,19 +1285,196 @@ static void Initialize(SUttProcessor *self, const SVoice *voice, s_erc *error)
 
 	/* error clean up */
 quit_error:
-	HTS_Engine_clear(&(HTSsynth->engine));
 	if (voice_base_path != NULL)
 		S_FREE(voice_base_path);
 }
 
 
-static void Run(const SUttProcessor *self, SUtterance *utt,
-				s_erc *error)
+/************************************************************************************/
+/*                                                                                  */
+/* Static class function implementations                                            */
+/*                                                                                  */
+/************************************************************************************/
+
+static void InitModel(void *obj, s_erc *error)
+{
+	SHTSEngineModel105 *self = obj;
+
+
+	S_CLR_ERR(error);
+	HTS_Engine_initialize(&(self->engine), 2);
+}
+
+
+static void DestroyModel(void *obj, s_erc *error)
+{
+	SHTSEngineModel105 *self = obj;
+
+
+	S_CLR_ERR(error);
+	HTS_Engine_clear(&(self->engine));
+}
+
+
+static void DisposeModel(void *obj, s_erc *error)
+{
+	S_CLR_ERR(error);
+	SObjectDecRef(obj);
+}
+
+
+static void Init(void *obj, s_erc *error)
+{
+	SHTSEngineSynthUttProc105 *self = obj;
+
+
+	S_CLR_ERR(error);
+	self->model = NULL;
+}
+
+
+static void Destroy(void *obj, s_erc *error)
+{
+	SHTSEngineSynthUttProc105 *self = obj;
+
+
+	S_CLR_ERR(error);
+
+	/* states are only copies of the model's engine */
+	SUttProcessorClearStates(S_UTTPROCESSOR(self), error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "Destroy",
+			  "Call to \"SUttProcessorClearStates\" failed");
+
+	S_DELETE(self->model, "Destroy", error);
+}
+
+
+static void Dispose(void *obj, s_erc *error)
+{
+	S_CLR_ERR(error);
+	SObjectDecRef(obj);
+}
+
+
+static void Initialize(SUttProcessor *self, const SVoice *voice, s_erc *error)
 {
 	SHTSEngineSynthUttProc105 *HTSsynth = (SHTSEngineSynthUttProc105*)self;
+	SHTSEngineModel105 *model;
+	const SObject *tmp;
+	char *key;
+	s_bool is_present;
+
+
+	S_CLR_ERR(error);
+
+	key = get_hts_model_key(self->features, voice, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "Initialize",
+				  "Call to \"get_hts_model_key\" failed"))
+		return;
+
+	/* share the model if it has already been loaded for this voice */
+	is_present = SVoiceDataIsPresent(voice, key, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "Initialize",
+				  "Call to \"SVoiceDataIsPresent\" failed"))
+		goto quit;
+
+	if (is_present)
+	{
+		tmp = SVoiceGetData(voice, key, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "Initialize",
+					  "Call to \"SVoiceGetData\" failed"))
+			goto quit;
+
+		model = S_CAST(tmp, SHTSEngineModel105, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "Initialize",
+					  "Voice data \"%s\" is not a \"SHTSEngineModel105\" object",
+					  key))
+			goto quit;
+
+		SObjectIncRef(S_OBJECT(model));
+		HTSsynth->model = model;
+		goto quit;
+	}
+
+	model = S_NEW(SHTSEngineModel105, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "Initialize",
+				  "Failed to create new 'SHTSEngineModel105' object"))
+		goto quit;
+
+	load_hts_engine_model(model, self->features, voice, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "Initialize",
+				  "Call to \"load_hts_engine_model\" failed"))
+	{
+		S_DELETE(model, "Initialize", error);
+		goto quit;
+	}
+
+	/* the voice owns the model, the utterance processor holds a reference */
+	SVoiceSetData((SVoice*)voice, key, S_OBJECT(model), error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "Initialize",
+				  "Call to \"SVoiceSetData\" failed"))
+	{
+		S_DELETE(model, "Initialize", error);
+		goto quit;
+	}
+
+	SObjectIncRef(S_OBJECT(model));
+	HTSsynth->model = model;
+
+	/* clean up */
+quit:
+	S_FREE(key);
+}
+
+
+static void *CreateState(const SUttProcessor *self, s_erc *error)
+{
+	HTS_Engine *engine;
+
+
+	S_CLR_ERR(error);
+	S_UNUSED(self);
+
+	engine = S_MALLOC(HTS_Engine, 1);
+	if (engine == NULL)
+	{
+		S_FTL_ERR(error, S_MEMERROR,
+				  "CreateState",
+				  "Failed to allocate memory for 'HTS_Engine' object");
+		return NULL;
+	}
+
+	return engine;
+}
+
+
+/* the model set belongs to the template engine, don't clear it here */
+static void DestroyState(const SUttProcessor *self, void *state, s_erc *error)
+{
+	S_CLR_ERR(error);
+	S_UNUSED(self);
+	S_FREE(state);
+}
+
+
+static void RunState(const SUttProcessor *self, void *engine_state, SUtterance *utt,
+					 s_erc *error)
+{
+	const SHTSEngineSynthUttProc105 *HTSsynth = (const SHTSEngineSynthUttProc105*)self;
+	HTS_Engine *engine = engine_state;
 	SPlugin *audioPlugin;
 	const SRelation *segmentRel;
 	SAudio *audio = NULL;
+	SAudioStream *stream;
+	const SCancelToken *cancel;
 	s_bool is_present;
 	char **label_data = NULL;
 	int label_size;
@@ -1116,30 +1488,45 @@ static void Run(const SUttProcessor *self, SUtterance *utt,
 
 	S_CLR_ERR(error);
 
+	/* Start from an empty engine with copies of the global settings
+	 * and the model set of the model's engine (see
+	 * s_hts_engine_layout), the arrays and trees they point to are
+	 * only read by the run. The model has no audio buffer, so the
+	 * empty audio output is never written. The label and the streams
+	 * are private to this run.
+	 */
+	memset(engine, 0, sizeof(HTS_Engine));
+	engine->global = HTSsynth->model->engine.global;
+	engine->ms = HTSsynth->model->engine.ms;
+	HTS_Label_initialize(&(engine->label));
+	HTS_SStreamSet_initialize(&(engine->sss));
+	HTS_PStreamSet_initialize(&(engine->pss));
+	HTS_GStreamSet_initialize(&(engine->gss));
+
 	/* we require the segment relation */
 	is_present = SUtteranceRelationIsPresent(utt, "Segment", error);
 	if (S_CHK_ERR(error, S_CONTERR,
-				  "Run",
+				  "RunState",
 				  "Call to \"SUtteranceRelationIsPresent\" failed"))
 		goto quit_error;
 
 	if (!is_present)
 	{
 		S_CTX_ERR(error, S_FAILURE,
-				  "Run",
+				  "RunState",
 				  "Failed to find 'Segment' relation in utterance");
 		goto quit_error;
 	}
 
 	segmentRel = SUtteranceGetRelation(utt, "Segment", error);
 	if (S_CHK_ERR(error, S_CONTERR,
-				  "Run",
+				  "RunState",
 				  "Call to \"SUtteranceGetRelation\" failed"))
 		goto quit_error;
 
 	item = SRelationHead(segmentRel, error);
 	if (S_CHK_ERR(error, S_CONTERR,
-				  "Run",
+				  "RunState",
 				  "Call to \"SRelationHead\" failed"))
 		goto quit_error;
 
@@ -1163,54 +1550,83 @@ static void Run(const SUttProcessor *self, SUtterance *utt,
 
 		dFeat = SItemPathToFeatProc(itemItr, "hts_labels", error);
 		if (S_CHK_ERR(error, S_CONTERR,
-					  "Run",
+					  "RunState",
 					  "Call to \"SItemPathToFeatProc\" failed"))
 			goto quit_error;
 
 		if (dFeat == NULL)
 		{
 			S_CTX_ERR(error, S_FAILURE,
-					  "Run",
+					  "RunState",
 					  "Failed to generate hts labels for segment item");
 			goto quit_error;
 		}
 
 		tmp = SObjectGetString(dFeat, error);
 		if (S_CHK_ERR(error, S_CONTERR,
-					  "Run",
+					  "RunState",
 					  "Call to \"SObjectGetString\" failed"))
 			goto quit_error;
 
 		label_data[counter++] = s_strdup(tmp, error);
 		if (S_CHK_ERR(error, S_CONTERR,
-					  "Run",
+					  "RunState",
 					  "Call to \"s_strdup\" failed"))
 			goto quit_error;
 
 		SItemSetObject((SItem*)itemItr, "hts_label", dFeat, error);
 		if (S_CHK_ERR(error, S_CONTERR,
-					  "Run",
+					  "RunState",
 					  "Call to \"SItemSetObject\" failed"))
 			goto quit_error;
 
 		itemItr = SItemNext(itemItr, error);
 	}
 
+	/*
+	 * The HTS Engine generates all the frames of a stream in one
+	 * call, the cancellation token of the utterance is checked
+	 * before every stream.
+	 */
+	cancel = SCancelTokenGetFromUtt(utt, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "RunState",
+				  "Call to \"SCancelTokenGetFromUtt\" failed"))
+		goto quit_error;
+
 	/* speech synthesis part */
-	HTS_Engine_load_label_from_string_list(&(HTSsynth->engine), label_data, label_size);
-	check_and_change_rate_volume(HTSsynth, utt, error);
+	HTS_Engine_load_label_from_string_list(engine, label_data, label_size);
+	check_and_change_rate_volume(engine, utt, error);
 	if (S_CHK_ERR(error, S_CONTERR,
-		"Run",
+		"RunState",
 		"Call to \"check_and_change_rate_volume\" failed"))
 		goto quit_error;
-	HTS_Engine_create_sstream(&(HTSsynth->engine));
-	check_and_change_tone(HTSsynth, utt, error);
+	SCancelTokenCheck(cancel, error);
 	if (S_CHK_ERR(error, S_CONTERR,
-		"Run",
+				  "RunState",
+				  "Synthesis stopped before state sequence generation"))
+		goto quit_error;
+
+	HTS_Engine_create_sstream(engine);
+	check_and_change_tone(engine, utt, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+		"RunState",
 		"Call to \"check_and_change_tone\" failed"))
 		goto quit_error;
-	HTS_Engine_create_pstream(&(HTSsynth->engine));
-	HTS_Engine_create_gstream(&(HTSsynth->engine));
+	SCancelTokenCheck(cancel, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "RunState",
+				  "Synthesis stopped before parameter generation"))
+		goto quit_error;
+
+	HTS_Engine_create_pstream(engine);
+	SCancelTokenCheck(cancel, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "RunState",
+				  "Synthesis stopped before waveform generation"))
+		goto quit_error;
+
+	HTS_Engine_create_gstream(engine);
 
 	itemItr = item;
 	counter = 0;
@@ -1220,9 +1636,9 @@ static void Run(const SUttProcessor *self, SUtterance *utt,
 	{
 		int j;
 		int duration;
-		HTS_SStreamSet *sss = &(HTSsynth->engine.sss);
-		const int nstate = HTS_ModelSet_get_nstate(&(HTSsynth->engine.ms));
-		const double rate = HTSsynth->engine.global.fperiod * 1e+7 / HTSsynth->engine.global.sampling_rate;
+		HTS_SStreamSet *sss = &(engine->sss);
+		const int nstate = HTS_ModelSet_get_nstate(&(engine->ms));
+		const double rate = engine->global.fperiod * 1e+7 / engine->global.sampling_rate;
 		float tmp;
 
 		for (j = 0, duration = 0; j < nstate; j++)
@@ -1231,14 +1647,14 @@ static void Run(const SUttProcessor *self, SUtterance *utt,
 		tmp = frame * rate;
 		SItemSetFloat((SItem*)itemItr, "start", tmp/1e+7, error);
 		if (S_CHK_ERR(error, S_CONTERR,
-					  "Run",
+					  "RunState",
 					  "Call to \"SItemSetFloat\" failed"))
 			goto quit_error;
 
 		tmp = (frame + duration) * rate;
 		SItemSetFloat((SItem*)itemItr, "end", tmp/1e+7, error);
 		if (S_CHK_ERR(error, S_CONTERR,
-					  "Run",
+					  "RunState",
 					  "Call to \"SItemSetFloat\" failed"))
 			goto quit_error;
 
@@ -1250,14 +1666,14 @@ static void Run(const SUttProcessor *self, SUtterance *utt,
 	/* create an audio object */
 	audio = S_NEW(SAudio, error);
 	if (S_CHK_ERR(error, S_CONTERR,
-				  "Run",
+				  "RunState",
 				  "Failed to create new 'SAudio' object"))
 		goto quit_error;
 
 	/* set audio feature in utterance */
 	SUtteranceSetFeature(utt, "audio", S_OBJECT(audio), error);
 	if (S_CHK_ERR(error, S_CONTERR,
-				  "Run",
+				  "RunState",
 				  "Call to \"SUtteranceSetFeature\" failed"))
 		goto quit_error;
 
@@ -1271,39 +1687,56 @@ static void Run(const SUttProcessor *self, SUtterance *utt,
 	 */
 	audioPlugin = s_pm_load_plugin("audio.spi", error);
 	if (S_CHK_ERR(error, S_CONTERR,
-				  "Run",
+				  "RunState",
 				  "Call to \"SUtteranceSetFeature\" failed"))
 		goto quit_error;
 
 	SUtteranceSetFeature(utt, "audio_plugin", S_OBJECT(audioPlugin), error);
 	if (S_CHK_ERR(error, S_CONTERR,
-				  "Run",
+				  "RunState",
 				  "Call to \"SUtteranceSetFeature\" failed"))
 	{
-		S_DELETE(audioPlugin, "Run", error);
+		S_DELETE(audioPlugin, "RunState", error);
 		goto quit_error;
 	}
 
-	audio->sample_rate = HTSsynth->engine.global.sampling_rate;
-	audio->num_samples = (uint32)HTS_GStreamSet_get_total_nsample(&(HTSsynth->engine).gss);
+	audio->sample_rate = engine->global.sampling_rate;
+	audio->num_samples = (uint32)HTS_GStreamSet_get_total_nsample(&(engine->gss));
 	audio->samples = S_MALLOC(float, audio->num_samples);
 	if (audio->samples == NULL)
 	{
 		S_FTL_ERR(error, S_MEMERROR,
-				  "Run",
+				  "RunState",
 				  "Failed to allocate memory for 'float' object");
 		goto quit_error;
 	}
 
 	/* write data */
 	for (i = 0; i < audio->num_samples; i++)
-		audio->samples[i] = (float)(HTS_GStreamSet_get_speech(&(HTSsynth->engine).gss, i) * 1.0);
+		audio->samples[i] = (float)(HTS_GStreamSet_get_speech(&(engine->gss), i) * 1.0);
+
+	/* stream the audio if the utterance has an audio stream */
+	stream = SAudioStreamGetFromUtt(utt, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "RunState",
+				  "Call to \"SAudioStreamGetFromUtt\" failed"))
+		goto quit_error;
+
+	if (stream != NULL)
+	{
+		SAudioStreamWrite(stream, audio->samples, audio->num_samples,
+						  audio->sample_rate, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "RunState",
+					  "Call to \"SAudioStreamWrite\" failed"))
+			goto quit_error;
+	}
 
 	for (counter = 0; counter < label_size; counter++)
 		S_FREE(label_data[counter]);
 	S_FREE(label_data);
 
-	HTS_Engine_refresh(&(HTSsynth->engine));
+	HTS_Engine_refresh(engine);
 
 	/* all OK here */
 	return;
@@ -1321,6 +1754,7 @@ quit_error:
 		S_FREE(label_data);
 	}
 
+	HTS_Engine_refresh(engine);
 	return;
 }
 
@@ -1338,7 +1772,7 @@ static SHTSEngineSynthUttProc105Class HTSEngineSynthUttProc105Class =
 		"SUttProcessor:SHTSEngineSynthUttProc105",
 		sizeof(SHTSEngineSynthUttProc105),
 		{ 0, 1},
-		NULL,            /* init    */
+		Init,            /* init    */
 		Destroy,         /* destroy */
 		Dispose,         /* dispose */
 		NULL,            /* compare */
@@ -1346,6 +1780,29 @@ static SHTSEngineSynthUttProc105Class HTSEngineSynthUttProc105Class =
 		NULL,            /* copy    */
 	},
 	/* SUttProcessorClass */
-	Initialize,          /* initialize */
-	Run                  /* run        */
+	Initialize,          /* initialize    */
+	NULL,                /* run           */
+	CreateState,         /* create_state  */
+	DestroyState,        /* destroy_state */
+	RunState             /* run_state     */
+};
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* SHTSEngineModel105 class initialization                                          */
+/*                                                                                  */
+/************************************************************************************/
+
+static SHTSEngineModel105Class HTSEngineModel105Class =
+{
+	"SHTSEngineModel105",
+	sizeof(SHTSEngineModel105),
+	{ 0, 1},
+	InitModel,       /* init    */
+	DestroyModel,    /* destroy */
+	DisposeModel,    /* dispose */
+	NULL,            /* compare */
+	NULL,            /* print   */
+	NULL,            /* copy    */
 };
@@ -61,6 +61,51 @@
 S_BEGIN_C_DECLS
 
 
+/************************************************************************************/
+/*                                                                                  */
+/* SHTSEngineModel105 definition                                                    */
+/*                                                                                  */
+/************************************************************************************/
+
+/**
+ * The SHTSEngineModel105 structure.
+ * The HTS Engine models of a voice. The model is loaded once per
+ * voice and configuration, by the first synthesizer utterance
+ * processor that is initialized, and set as voice data under a key
+ * made of the plug-in version, the voice configuration file, the
+ * engine settings and the model files. Other synthesizer utterance
+ * processors of the voice with the same configuration share it
+ * read-only.
+ * @extends SObject
+ */
+typedef struct
+{
+	/**
+	 * @protected Inherit from #SObject.
+	 */
+	SObject       obj;
+
+	/**
+	 * @protected The HTS Engine template. Holds the model set and
+	 * the global settings.
+	 */
+	HTS_Engine    engine;
+} SHTSEngineModel105;
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* SHTSEngineModel105Class definition                                               */
+/*                                                                                  */
+/************************************************************************************/
+
+/**
+ * Typedef of the HTS Engine model class. Does not add any new
+ * methods, therefore exactly the same as #SObjectClass.
+ */
+typedef SObjectClass SHTSEngineModel105Class;
+
+
 /************************************************************************************/
 /*                                                                                  */
 /* SHTSEngineSynthUttProc definition                                                */
@@ -80,9 +125,11 @@ typedef struct
 	SUttProcessor obj;
 
 	/**
-	 * @protected The HTS Engine.
+	 * @protected The shared HTS Engine model of the voice. Each run
+	 * synthesizes with a private copy of its engine (see
+	 * #SUttProcessorStateAcquire).
 	 */
-	HTS_Engine    engine;
+	SHTSEngineModel105 *model;
 } SHTSEngineSynthUttProc105;
 
 
@@ -106,8 +153,8 @@ typedef SUttProcessorClass SHTSEngineSynthUttProc105Class;
 /************************************************************************************/
 
 /**
- * Register the #SHTSEngineSynthUttProc105 plug-in class with the Speect Engine
- * object system.
+ * Register the #SHTSEngineSynthUttProc105 and #SHTSEngineModel105 plug-in
+ * classes with the Speect Engine object system.
  * @private
  *
  * @param error Error code.
@@ -116,8 +163,8 @@ S_LOCAL void _s_hts_engine_synth_utt_proc_105_class_reg(s_erc *error);
 
 
 /**
- * Free the #SHTSEngineSynthUttProc105 plug-in class from the Speect Engine
- * object system.
+ * Free the #SHTSEngineSynthUttProc105 and #SHTSEngineModel105 plug-in
+ * classes from the Speect Engine object system.
  * @private
  *
  * @param error Error code.
@@ -41,6 +41,8 @@
 /*                                                                                  */
 /************************************************************************************/
 
+#include <stddef.h>
+#include <string.h>
 #include "synthesize_hts_engine.h"
 #include "audio.h"
 
@@ -51,13 +53,15 @@
 /*                                                                                  */
 /************************************************************************************/
 
+/* prefix of the voice data key of the shared HTS Engine model */
+#define SPCT_HTS_MODEL_DATA_KEY "hts engine me model 1.05"
+
 /* default values for HTS Engine params */
 #define SPCT_DEF_SAMPLING_RATE 16000
 #define SPCT_DEF_FPERIOD 80
 #define SPCT_DEF_ALPHA 0.42
 #define SPCT_DEF_STAGE 0.0
 #define SPCT_DEF_BETA 0.0
-#define SPCT_DEF_AUDIO_BUFF_SIZE 1600
 #define SPCT_DEF_UV_THRESHOLD 0.5
 #define SPCT_DEF_GV_WEIGHT_MCP 0.7
 #define SPCT_DEF_GV_WEIGHT_LF0 1.0
@@ -76,7 +80,6 @@ typedef struct
 	double alpha;
 	int stage;
 	double beta;
-	int audio_buff_size;
 	double uv_threshold;
 	HTS_Boolean use_log_gain;
 	double gv_weight_mcp;
@@ -85,6 +88,44 @@ typedef struct
 } hts_params;
 
 
+/*
+ * The members of HTS_Engine as handled by the run states: the global
+ * settings and the model set are shared with the model's engine, the
+ * others are private to a run. A per-run engine would share any other
+ * member unknowingly, so the build fails below if this hts_engine
+ * version has a different HTS_Engine.
+ */
+typedef struct
+{
+	HTS_Global     global;
+	HTS_Audio      audio;
+	HTS_ModelSet   ms;
+	HTS_Label      label;
+	HTS_SStreamSet sss;
+	HTS_PStreamSet pss;
+	HTS_GStreamSet gss;
+} s_hts_engine_layout;
+
+typedef char s_hts_engine_layout_check[
+	((sizeof(HTS_Engine) == sizeof(s_hts_engine_layout))
+	 && (offsetof(HTS_Engine, ms) == offsetof(s_hts_engine_layout, ms))
+	 && (offsetof(HTS_Engine, label) == offsetof(s_hts_engine_layout, label))
+	 && (offsetof(HTS_Engine, gss) == offsetof(s_hts_engine_layout, gss))) ? 1 : -1];
+
+
+/* per-run state, a private copy of the engine and the mixed
+ * excitation work buffers (the filters are shared)
+ */
+typedef struct
+{
+	HTS_Engine  engine;
+	double     *xp_sig;
+	double     *xn_sig;
+	double     *hp;
+	double     *hn;
+} hts_me_state;
+
+
 /************************************************************************************/
 /*                                                                                  */
 /* Static variables                                                                 */
@@ -94,6 +135,9 @@ typedef struct
 /* SHTSEngineMESynthUttProc105 class declaration. */
 static SHTSEngineMESynthUttProc105Class HTSEngineMESynthUttProc105Class;
 
+/* SHTSEngineMEModel105 class declaration. */
+static SHTSEngineMEModel105Class HTSEngineMEModel105Class;
+
 
 /************************************************************************************/
 /*                                                                                  */
@@ -111,19 +155,28 @@ static void get_trees_pdfs(const SList *trees, const SList *pdfs,
 						   const char *voice_base_path, s_erc *error);
 
 static void load_hts_engine_data(const SMap *data,
-								 SHTSEngineMESynthUttProc105 *HTSsynth,
+								 SHTSEngineMEModel105 *model,
 								 const char *voice_base_path, s_erc *error);
 
-static void filter_constructor(SHTSEngineMESynthUttProc105 *HTSsynth, s_erc *error);
+static void load_hts_engine_model(SHTSEngineMEModel105 *model, const SMap *features,
+								  const SVoice *voice, s_erc *error);
+
+static char *get_hts_model_key(const SMap *features, const SVoice *voice, s_erc *error);
+
+static void add_hts_data_to_hts_model_key(char **key, const SObject *data, s_erc *error);
 
-static void filter_destructor(SHTSEngineMESynthUttProc105 *HTSsynth);
+static void add_to_hts_model_key(char **key, const char *s, s_erc *error);
 
-static void check_and_change_rate_volume(SHTSEngineMESynthUttProc105 *HTSsynth,
+static void filter_destructor(SHTSEngineMEModel105 *model);
+
+static void check_and_change_rate_volume(HTS_Engine *engine,
 										 const SUtterance *utt, s_erc *error);
 
-static void check_and_change_tone(SHTSEngineMESynthUttProc105 *HTSsynth,
+static void check_and_change_tone(HTS_Engine *engine,
 								  const SUtterance *utt, s_erc *error);
 
+static void DestroyState(const SUttProcessor *self, void *state, s_erc *error);
+
 
 /************************************************************************************/
 /*                                                                                  */
@@ -135,20 +188,42 @@ static void check_and_change_tone(SHTSEngineMESynthUttProc105 *HTSsynth,
 S_LOCAL void _s_hts_engine_me_synth_utt_proc_105_class_reg(s_erc *error)
 {
 	S_CLR_ERR(error);
+	s_class_reg(S_OBJECTCLASS(&HTSEngineMEModel105Class), error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "_s_hts_engine_me_synth_utt_proc_class_reg",
+				  "Failed to register SHTSEngineMEModel105Class"))
+		return;
+
 	s_class_reg(S_OBJECTCLASS(&HTSEngineMESynthUttProc105Class), error);
-	S_CHK_ERR(error, S_CONTERR,
-			  "_s_hts_engine_me_synth_utt_proc_class_reg",
-			  "Failed to register SHTSEngineMESynthUttProc105Class");
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "_s_hts_engine_me_synth_utt_proc_class_reg",
+				  "Failed to register SHTSEngineMESynthUttProc105Class"))
+	{
+		s_erc local_err = S_SUCCESS;
+
+
+		s_class_free(S_OBJECTCLASS(&HTSEngineMEModel105Class), &local_err);
+	}
 }
 
 
 S_LOCAL void _s_hts_engine_me_synth_utt_proc_105_class_free(s_erc *error)
 {
+	s_erc local_err = S_SUCCESS;
+
+
 	S_CLR_ERR(error);
 	s_class_free(S_OBJECTCLASS(&HTSEngineMESynthUttProc105Class), error);
 	S_CHK_ERR(error, S_CONTERR,
 			  "_s_hts_engine_me_synth_utt_proc_class_free",
 			  "Failed to free SHTSEngineMESynthUttProc105Class");
+
+	s_class_free(S_OBJECTCLASS(&HTSEngineMEModel105Class), &local_err);
+	if (S_CHK_ERR(&local_err, S_CONTERR,
+				  "_s_hts_engine_me_synth_utt_proc_class_free",
+				  "Failed to free SHTSEngineMEModel105Class")
+		&& (*error == S_SUCCESS))
+		*error = local_err;
 }
 
 
@@ -158,7 +233,7 @@ S_LOCAL void _s_hts_engine_me_synth_utt_proc_105_class_free(s_erc *error)
 /*                                                                                  */
 /************************************************************************************/
 
-static void check_and_change_rate_volume(SHTSEngineMESynthUttProc105 *HTSsynth,
+static void check_and_change_rate_volume(HTS_Engine *engine,
 										 const SUtterance *utt, s_erc *error)
 {
 	const SVoice *voice;
@@ -194,7 +269,7 @@ static void check_and_change_rate_volume(SHTSEngineMESynthUttProc105 *HTSsynth,
 			return;
 
 		if (var != 1.0)
-			HTS_Label_set_speech_speed(&(HTSsynth->engine.label), var);
+			HTS_Label_set_speech_speed(&(engine->label), var);
 	}
 
 	/* get volume feature */
@@ -216,11 +291,11 @@ static void check_and_change_rate_volume(SHTSEngineMESynthUttProc105 *HTSsynth,
 	if (var == 1.0)
 		return;
 	else
-		HTS_Engine_set_volume(&(HTSsynth->engine), var);
+		HTS_Engine_set_volume(engine, var);
 }
 
 
-static void check_and_change_tone(SHTSEngineMESynthUttProc105 *HTSsynth,
+static void check_and_change_tone(HTS_Engine *engine,
 								  const SUtterance *utt, s_erc *error)
 {
 	const SVoice *voice;
@@ -261,13 +336,13 @@ static void check_and_change_tone(SHTSEngineMESynthUttProc105 *HTSsynth,
 		int i;
 		double f;
 
-		for (i = 0; i < HTS_SStreamSet_get_total_state(&(HTSsynth->engine.sss)); i++)
+		for (i = 0; i < HTS_SStreamSet_get_total_state(&(engine->sss)); i++)
 		{
-			f = HTS_SStreamSet_get_mean(&(HTSsynth->engine.sss), 1, i, 0); /* logf0 is stream 1 */
+			f = HTS_SStreamSet_get_mean(&(engine->sss), 1, i, 0); /* logf0 is stream 1 */
 			f += var * log(2.0) / 12;
 			if (f < log(10.0))
 				f = log(10.0);
-			HTS_SStreamSet_set_mean(&(HTSsynth->engine.sss), 1, i, 0, f);
+			HTS_SStreamSet_set_mean(&(engine->sss), 1, i, 0, f);
 		}
 	}
 }
@@ -325,13 +400,6 @@ static hts_params *get_hts_engine_params(const SMap *features, s_bool *me, s_erc
 				  "Call to \"SMapGetFloatDef\" failed"))
 		goto quit_error;
 
-	engine_params->audio_buff_size = (int)SMapGetIntDef(features, "audio_buff_size",
-														SPCT_DEF_AUDIO_BUFF_SIZE, error);
-	if (S_CHK_ERR(error, S_CONTERR,
-				  "get_hts_engine_params",
-				  "Call to \"SMapGetIntDef\" failed"))
-		goto quit_error;
-
 	engine_params->uv_threshold = (double)SMapGetFloatDef(features, "uv_threshold",
 														  SPCT_DEF_UV_THRESHOLD, error);
 	if (S_CHK_ERR(error, S_CONTERR,
@@ -607,86 +675,26 @@ static void get_windows(const SList *windows, char ***cwindows,
 }
 
 
-static void filter_constructor(SHTSEngineMESynthUttProc105 *HTSsynth, s_erc *error)
-{
-	S_CLR_ERR(error);
-
-	HTSsynth->xp_sig = S_MALLOC(double, HTSsynth->me_filter_order);
-	if (HTSsynth->xp_sig == NULL)
-	{
-		S_FTL_ERR(error, S_MEMERROR,
-				  "filter_constructor",
-				  "Failed to allocate memory for mixed excitation pulse signal");
-		return;
-	}
-
-	HTSsynth->xn_sig = S_MALLOC(double, HTSsynth->me_filter_order);
-	if (HTSsynth->xn_sig == NULL)
-	{
-		S_FREE(HTSsynth->xp_sig);
-		S_FTL_ERR(error, S_MEMERROR,
-				  "filter_constructor",
-				  "Failed to allocate memory for mixed excitation noise signal");
-		return;
-	}
-
-	HTSsynth->hp = S_MALLOC(double, HTSsynth->me_filter_order);
-	if (HTSsynth->hp == NULL)
-	{
-		S_FREE(HTSsynth->xp_sig);
-		S_FREE(HTSsynth->xn_sig);
-		S_FTL_ERR(error, S_MEMERROR,
-				  "filter_constructor",
-				  "Failed to allocate memory for mixed excitation pulse shaping filter");
-		return;
-	}
-
-	HTSsynth->hn = S_MALLOC(double, HTSsynth->me_filter_order);
-	if (HTSsynth->hn == NULL)
-	{
-		S_FREE(HTSsynth->xp_sig);
-		S_FREE(HTSsynth->xn_sig);
-		S_FREE(HTSsynth->hp);
-		S_FTL_ERR(error, S_MEMERROR,
-				  "filter_constructor",
-				  "Failed to allocate memory for mixed excitation noise shaping filter");
-		return;
-	}
-}
-
-
-static void filter_destructor(SHTSEngineMESynthUttProc105 *HTSsynth)
+static void filter_destructor(SHTSEngineMEModel105 *model)
 {
 	int i;
 
-	for (i = 0; i < HTSsynth->me_num_filters; i++)
+	for (i = 0; i < model->me_num_filters; i++)
 	{
-		if (HTSsynth->me_filter[i] != NULL)
-			S_FREE(HTSsynth->me_filter[i]);
+		if (model->me_filter[i] != NULL)
+			S_FREE(model->me_filter[i]);
 	}
 
-	if (HTSsynth->me_filter != NULL)
-		S_FREE(HTSsynth->me_filter);
-
-	if (HTSsynth->xp_sig != NULL)
-		S_FREE(HTSsynth->xp_sig);
+	if (model->me_filter != NULL)
+		S_FREE(model->me_filter);
 
-	if (HTSsynth->xn_sig != NULL)
-		S_FREE(HTSsynth->xn_sig);
-
-	if (HTSsynth->hp != NULL)
-		S_FREE(HTSsynth->hp);
-
-	if (HTSsynth->hn != NULL)
-		S_FREE(HTSsynth->hn);
-
-	if (HTSsynth->pd_filter != NULL)
-		S_FREE(HTSsynth->pd_filter);
+	if (model->pd_filter != NULL)
+		S_FREE(model->pd_filter);
 }
 
 
 static void load_hts_engine_data(const SMap *data,
-								 SHTSEngineMESynthUttProc105 *HTSsynth,
+								 SHTSEngineMEModel105 *model,
 								 const char *voice_base_path, s_erc *error)
 {
 	const SMap *tmp;
@@ -703,7 +711,7 @@ static void load_hts_engine_data(const SMap *data,
 	const char *gv_tree;
 	const char *gv_switch;
 	const char *pd_filter;
-	HTS_Engine *engine = &(HTSsynth->engine);
+	HTS_Engine *engine = &(model->engine);
 
 
 	S_CLR_ERR(error);
@@ -1059,7 +1067,7 @@ static void load_hts_engine_data(const SMap *data,
 	}
 
 	/* band strengths */
-	if (HTSsynth->me == TRUE)
+	if (model->me == TRUE)
 	{
 		const char *me_filter;
 
@@ -1229,16 +1237,9 @@ static void load_hts_engine_data(const SMap *data,
 						  "Call to \"s_path_combine\" failed"))
 				return;
 
-			HTS_Engine_load_me_filter_from_fn(combined_path, &(HTSsynth->me_filter),
-											  &(HTSsynth->me_num_filters), &(HTSsynth->me_filter_order));
+			HTS_Engine_load_me_filter_from_fn(combined_path, &(model->me_filter),
+											  &(model->me_num_filters), &(model->me_filter_order));
 			S_FREE(combined_path);
-
-			/* allocate memory for other filter buffers */
-			filter_constructor(HTSsynth, error);
-			if (S_CHK_ERR(error, S_CONTERR,
-						  "load_hts_engine_data",
-						  "Call to \"filter_constructor\" failed"))
-				return;
 		}
 		else
 		{
@@ -1297,62 +1298,183 @@ static void load_hts_engine_data(const SMap *data,
 					  "Call to \"s_path_combine\" failed"))
 			return;
 
-		HTS_Engine_load_pd_filter_from_fn(combined_path, &(HTSsynth->pd_filter),
-										  &(HTSsynth->pd_filter_order));
+		HTS_Engine_load_pd_filter_from_fn(combined_path, &(model->pd_filter),
+										  &(model->pd_filter_order));
 		S_FREE(combined_path);
 	}
 }
 
 
-/************************************************************************************/
-/*                                                                                  */
-/* Static class function implementations                                            */
-/*                                                                                  */
-/************************************************************************************/
-
-
-static void Init(void *obj, s_erc *error)
+static void add_to_hts_model_key(char **key, const char *s, s_erc *error)
 {
-	SHTSEngineMESynthUttProc105 *HTSsynth = obj;
+	char *buf;
 
 
 	S_CLR_ERR(error);
-	HTSsynth->me = FALSE;            /* assume non mixed excitation voice     */
-	HTSsynth->me_filter = NULL;      /* mixed excitation filter coefficients  */
-	HTSsynth->me_num_filters = 0;    /* mixed excitation number of filters    */
-	HTSsynth->me_filter_order = 0;   /* mixed excitation filters order        */
-	HTSsynth->xp_sig = NULL;         /* pulse signal                          */
-	HTSsynth->xn_sig = NULL;         /* noise signal                          */
-	HTSsynth->hp = NULL;             /* pulse shaping filter                  */
-	HTSsynth->hn = NULL;             /* noise shaping filter                  */
-	HTSsynth->pd_filter = NULL;      /* pulse dispersion filter coefficients  */
-	HTSsynth->pd_filter_order = 0;   /* pulse dispersion filters order        */
+
+	s_asprintf(&buf, error, "%s %s", *key, s);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "add_to_hts_model_key",
+				  "Call to \"s_asprintf\" failed"))
+		return;
+
+	S_FREE(*key);
+	*key = buf;
 }
 
 
-/* we need to delete the window plug-in if any */
-static void Destroy(void *obj, s_erc *error)
+/* add the "hts engine data" (the model file names) to the model key */
+static void add_hts_data_to_hts_model_key(char **key, const SObject *data, s_erc *error)
 {
-	SHTSEngineMESynthUttProc105 *self = obj;
+	SIterator *itr;
+	char *buf;
+	s_bool is_map;
+	s_bool is_list;
 
 
 	S_CLR_ERR(error);
-	HTS_Engine_clear(&(self->engine));
-	filter_destructor(self);
+
+	is_map = SObjectIsType(data, "SMap", error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "add_hts_data_to_hts_model_key",
+				  "Call to \"SObjectIsType\" failed"))
+		return;
+
+	is_list = SObjectIsType(data, "SList", error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "add_hts_data_to_hts_model_key",
+				  "Call to \"SObjectIsType\" failed"))
+		return;
+
+	if (!is_map && !is_list)
+	{
+		buf = SObjectPrint(data, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "add_hts_data_to_hts_model_key",
+					  "Call to \"SObjectPrint\" failed"))
+			return;
+
+		add_to_hts_model_key(key, buf, error);
+		S_FREE(buf);
+		S_CHK_ERR(error, S_CONTERR,
+				  "add_hts_data_to_hts_model_key",
+				  "Call to \"add_to_hts_model_key\" failed");
+		return;
+	}
+
+	itr = S_ITERATOR_GET(data, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "add_hts_data_to_hts_model_key",
+				  "Call to \"S_ITERATOR_GET\" failed"))
+		return;
+
+	while (itr != NULL)
+	{
+		if (is_map)
+		{
+			add_to_hts_model_key(key, SIteratorKey(itr, error), error);
+			if (S_CHK_ERR(error, S_CONTERR,
+						  "add_hts_data_to_hts_model_key",
+						  "Call to \"SIteratorKey/add_to_hts_model_key\" failed"))
+			{
+				S_DELETE(itr, "add_hts_data_to_hts_model_key", error);
+				return;
+			}
+		}
+
+		add_hts_data_to_hts_model_key(key, SIteratorObject(itr, error), error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "add_hts_data_to_hts_model_key",
+					  "Call to \"SIteratorObject/add_hts_data_to_hts_model_key\" failed"))
+		{
+			S_DELETE(itr, "add_hts_data_to_hts_model_key", error);
+			return;
+		}
+
+		itr = SIteratorNext(itr);
+	}
 }
 
 
-static void Dispose(void *obj, s_erc *error)
+/* The voice data key of the model: the plug-in version, the voice
+ * configuration file, the engine settings and the model files.
+ * Synthesizers of a voice only share a model if they would load
+ * exactly the same one.
+ */
+static char *get_hts_model_key(const SMap *features, const SVoice *voice, s_erc *error)
 {
+	hts_params *engine_params;
+	const SObject *vcfgObject;
+	const SObject *hts_data;
+	const char *config_file;
+	char *key = NULL;
+	s_bool me;
+
+
 	S_CLR_ERR(error);
-	SObjectDecRef(obj);
+
+	vcfgObject = SVoiceGetFeature(voice, "config_file", error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "get_hts_model_key",
+				  "Call to \"SVoiceGetFeature\" failed, failed to get voice config file"))
+		return NULL;
+
+	config_file = SObjectGetString(vcfgObject, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "get_hts_model_key",
+				  "Call to \"SObjectGetString\" failed"))
+		return NULL;
+
+	engine_params = get_hts_engine_params(features, &me, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "get_hts_model_key",
+				  "Call to \"get_hts_engine_params\" failed"))
+		return NULL;
+
+	s_asprintf(&key, error, "%s %s %d %d %g %d %g %g %d %g %g %d %g",
+			   SPCT_HTS_MODEL_DATA_KEY, config_file,
+			   engine_params->sampling_rate, engine_params->fperiod,
+			   engine_params->alpha, engine_params->stage, engine_params->beta,
+			   engine_params->uv_threshold, engine_params->use_log_gain,
+			   engine_params->gv_weight_mcp, engine_params->gv_weight_lf0,
+			   me, engine_params->gv_weight_str);
+	S_FREE(engine_params);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "get_hts_model_key",
+				  "Call to \"s_asprintf\" failed"))
+		goto quit_error;
+
+	hts_data = SVoiceGetFeature(voice, "hts engine data", error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "get_hts_model_key",
+				  "Call to \"SVoiceGetFeature\" failed"))
+		goto quit_error;
+
+	if (hts_data != NULL)
+	{
+		add_hts_data_to_hts_model_key(&key, hts_data, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "get_hts_model_key",
+					  "Call to \"add_hts_data_to_hts_model_key\" failed"))
+			goto quit_error;
+	}
+
+	/* all OK */
+	return key;
+
+	/* error clean up */
+quit_error:
+	if (key != NULL)
+		S_FREE(key);
+
+	return NULL;
 }
 
 
-static void Initialize(SUttProcessor *self, const SVoice *voice, s_erc *error)
+static void load_hts_engine_model(SHTSEngineMEModel105 *model, const SMap *features,
+								  const SVoice *voice, s_erc *error)
 {
 	hts_params *engine_params;
-	SHTSEngineMESynthUttProc105 *HTSsynth = (SHTSEngineMESynthUttProc105*)self;
 	const SMap *hts_data;
 	const SObject *vcfgObject;
 	char *voice_base_path;
@@ -1363,20 +1485,20 @@ static void Initialize(SUttProcessor *self, const SVoice *voice, s_erc *error)
 	/* get voice base path */
 	vcfgObject = SVoiceGetFeature(voice, "config_file", error);
 	if (S_CHK_ERR(error, S_CONTERR,
-				  "Initialize",
+				  "load_hts_engine_model",
 				  "Call to \"SVoiceGetFeature\" failed, failed to get voice config file"))
 		return;
 
 	voice_base_path = s_get_base_path(SObjectGetString(vcfgObject, error), error);
 	if (S_CHK_ERR(error, S_CONTERR,
-				  "Initialize",
+				  "load_hts_engine_model",
 				  "Call to \"s_get_base_path/SObjectGetString\" failed"))
 		return;
 
 	/* get the HTS engine settings */
-	engine_params = get_hts_engine_params(self->features, &(HTSsynth->me), error);
+	engine_params = get_hts_engine_params(features, &(model->me), error);
 	if (S_CHK_ERR(error, S_CONTERR,
-				  "Initialize",
+				  "load_hts_engine_model",
 				  "Call to \"get_hts_engine_params\" failed"))
 	{
 		S_FREE(voice_base_path);
@@ -1384,65 +1506,70 @@ static void Initialize(SUttProcessor *self, const SVoice *voice, s_erc *error)
 	}
 
 	/* initialize the engine */
-	if (HTSsynth->me == TRUE)
+	if (model->me == TRUE)
 	{
 		/* extra stream for strengths */
-		HTS_Engine_initialize(&(HTSsynth->engine), 3);
+		HTS_Engine_initialize(&(model->engine), 3);
 	}
 	else
 	{
-		HTS_Engine_initialize(&(HTSsynth->engine), 2);
+		HTS_Engine_initialize(&(model->engine), 2);
 	}
 
+	model->initialized = TRUE;
+
 	/* set the engine parameters */
-	HTS_Engine_set_sampling_rate(&(HTSsynth->engine), engine_params->sampling_rate);
-	HTS_Engine_set_fperiod(&(HTSsynth->engine), engine_params->fperiod);
-	HTS_Engine_set_alpha(&(HTSsynth->engine), engine_params->alpha);
-	HTS_Engine_set_gamma(&(HTSsynth->engine), engine_params->stage);
-	HTS_Engine_set_log_gain(&(HTSsynth->engine), engine_params->use_log_gain);
-	HTS_Engine_set_beta(&(HTSsynth->engine), engine_params->beta);
-	HTS_Engine_set_audio_buff_size(&(HTSsynth->engine), engine_params->audio_buff_size);
-	HTS_Engine_set_msd_threshold(&(HTSsynth->engine), 1, engine_params->uv_threshold);
-	HTS_Engine_set_gv_weight(&(HTSsynth->engine), 0, engine_params->gv_weight_mcp);
-	HTS_Engine_set_gv_weight(&(HTSsynth->engine), 1, engine_params->gv_weight_lf0);
-
-	if (HTSsynth->me == TRUE)
-		HTS_Engine_set_gv_weight(&(HTSsynth->engine), 2, engine_params->gv_weight_str);
+	HTS_Engine_set_sampling_rate(&(model->engine), engine_params->sampling_rate);
+	HTS_Engine_set_fperiod(&(model->engine), engine_params->fperiod);
+	HTS_Engine_set_alpha(&(model->engine), engine_params->alpha);
+	HTS_Engine_set_gamma(&(model->engine), engine_params->stage);
+	HTS_Engine_set_log_gain(&(model->engine), engine_params->use_log_gain);
+	HTS_Engine_set_beta(&(model->engine), engine_params->beta);
+	/* the samples are returned in the utterance, an audio output buffer
+	 * in the engine would be shared by all the runs of the model
+	 */
+	HTS_Engine_set_audio_buff_size(&(model->engine), 0);
+	HTS_Engine_set_msd_threshold(&(model->engine), 1, engine_params->uv_threshold);
+	HTS_Engine_set_gv_weight(&(model->engine), 0, engine_params->gv_weight_mcp);
+	HTS_Engine_set_gv_weight(&(model->engine), 1, engine_params->gv_weight_lf0);
+
+	if (model->me == TRUE)
+		HTS_Engine_set_gv_weight(&(model->engine), 2, engine_params->gv_weight_str);
 
 	S_FREE(engine_params);
 
 	hts_data = S_MAP(SVoiceGetFeature(voice, "hts engine data", error));
 	if (S_CHK_ERR(error, S_CONTERR,
-				  "Initialize",
+				  "load_hts_engine_model",
 				  "Call to \"SVoiceGetFeature\" failed"))
 		goto quit_error;
 
 	if (hts_data == NULL)
 	{
 		S_CTX_ERR(error, S_FAILURE,
-				  "Initialize",
+				  "load_hts_engine_model",
 				  "Failed to get \"hts engine data\" map from voice features");
 		goto quit_error;
 	}
 
-	load_hts_engine_data(hts_data, HTSsynth, voice_base_path, error);
+	load_hts_engine_data(hts_data, model, voice_base_path, error);
 	if (S_CHK_ERR(error, S_CONTERR,
-				  "Initialize",
+				  "load_hts_engine_model",
 				  "Call to \"load_hts_engine_data\" failed"))
 		goto quit_error;
 
-	HTS_Engine_set_duration_interpolation_weight(&(HTSsynth->engine), 0, 1.0);
-	HTS_Engine_set_parameter_interpolation_weight(&(HTSsynth->engine), 0, 0, 1.0);
-	HTS_Engine_set_parameter_interpolation_weight(&(HTSsynth->engine), 1, 0, 1.0);
+	HTS_Engine_set_duration_interpolation_weight(&(model->engine), 0, 1.0);
+	HTS_Engine_set_parameter_interpolation_weight(&(model->engine), 0, 0, 1.0);
+	HTS_Engine_set_parameter_interpolation_weight(&(model->engine), 1, 0, 1.0);
 
-	if (HTSsynth->me == TRUE)
-		HTS_Engine_set_parameter_interpolation_weight(&(HTSsynth->engine), 2, 0, 1.0);
+	if (model->me == TRUE)
+		HTS_Engine_set_parameter_interpolation_weight(&(model->engine), 2, 0, 1.0);
 
-	HTS_Engine_set_gv_interpolation_weight(&(HTSsynth->engine), 0, 0, 1.0);
-	HTS_Engine_set_gv_interpolation_weight(&(HTSsynth->engine), 1, 0, 1.0);
+	HTS_Engine_set_gv_interpolation_weight(&(model->engine), 0, 0, 1.0);
+	HTS_Engine_set_gv_interpolation_weight(&(model->engine), 1, 0, 1.0);
 
-	if (HTSsynth->me == TRUE)
-		HTS_Engine_set_gv_interpolation_weight(&(HTSsynth->engine), 2, 0, 1.0);
+	if (model->me == TRUE)
+		HTS_Engine_set_gv_interpolation_weight(&(model->engine), 2, 0, 1.0);
 
 	/* all OK */
 	S_FREE(voice_base_path);
@@ -1450,20 +1577,240 @@ static void Initialize(SUttProcessor *self, const SVoice *voice, s_erc *error)
 
 	/* error clean up */
 quit_error:
-	HTS_Engine_clear(&(HTSsynth->engine));
-	filter_destructor(HTSsynth);
 	if (voice_base_path != NULL)
 		S_FREE(voice_base_path);
 }
 
 
-static void Run(const SUttProcessor *self, SUtterance *utt,
-				s_erc *error)
+/************************************************************************************/
+/*                                                                                  */
+/* Static class function implementations                                            */
+/*                                                                                  */
+/************************************************************************************/
+
+
+static void InitModel(void *obj, s_erc *error)
+{
+	SHTSEngineMEModel105 *model = obj;
+
+
+	S_CLR_ERR(error);
+	model->initialized = FALSE;   /* engine not initialized yet            */
+	model->me = FALSE;            /* assume non mixed excitation voice     */
+	model->me_filter = NULL;      /* mixed excitation filter coefficients  */
+	model->me_num_filters = 0;    /* mixed excitation number of filters    */
+	model->me_filter_order = 0;   /* mixed excitation filters order        */
+	model->pd_filter = NULL;      /* pulse dispersion filter coefficients  */
+	model->pd_filter_order = 0;   /* pulse dispersion filters order        */
+}
+
+
+static void DestroyModel(void *obj, s_erc *error)
+{
+	SHTSEngineMEModel105 *model = obj;
+
+
+	S_CLR_ERR(error);
+	if (model->initialized)
+		HTS_Engine_clear(&(model->engine));
+	filter_destructor(model);
+}
+
+
+static void DisposeModel(void *obj, s_erc *error)
+{
+	S_CLR_ERR(error);
+	SObjectDecRef(obj);
+}
+
+
+static void Init(void *obj, s_erc *error)
+{
+	SHTSEngineMESynthUttProc105 *self = obj;
+
+
+	S_CLR_ERR(error);
+	self->model = NULL;
+}
+
+
+static void Destroy(void *obj, s_erc *error)
+{
+	SHTSEngineMESynthUttProc105 *self = obj;
+
+
+	S_CLR_ERR(error);
+
+	/* states are only copies of the model's engine */
+	SUttProcessorClearStates(S_UTTPROCESSOR(self), error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "Destroy",
+			  "Call to \"SUttProcessorClearStates\" failed");
+
+	S_DELETE(self->model, "Destroy", error);
+}
+
+
+static void Dispose(void *obj, s_erc *error)
+{
+	S_CLR_ERR(error);
+	SObjectDecRef(obj);
+}
+
+
+static void Initialize(SUttProcessor *self, const SVoice *voice, s_erc *error)
 {
 	SHTSEngineMESynthUttProc105 *HTSsynth = (SHTSEngineMESynthUttProc105*)self;
+	SHTSEngineMEModel105 *model;
+	const SObject *tmp;
+	char *key;
+	s_bool is_present;
+
+
+	S_CLR_ERR(error);
+
+	key = get_hts_model_key(self->features, voice, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "Initialize",
+				  "Call to \"get_hts_model_key\" failed"))
+		return;
+
+	/* share the model if it has already been loaded for this voice */
+	is_present = SVoiceDataIsPresent(voice, key, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "Initialize",
+				  "Call to \"SVoiceDataIsPresent\" failed"))
+		goto quit;
+
+	if (is_present)
+	{
+		tmp = SVoiceGetData(voice, key, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "Initialize",
+					  "Call to \"SVoiceGetData\" failed"))
+			goto quit;
+
+		model = S_CAST(tmp, SHTSEngineMEModel105, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "Initialize",
+					  "Voice data \"%s\" is not a \"SHTSEngineMEModel105\" object",
+					  key))
+			goto quit;
+
+		SObjectIncRef(S_OBJECT(model));
+		HTSsynth->model = model;
+		goto quit;
+	}
+
+	model = S_NEW(SHTSEngineMEModel105, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "Initialize",
+				  "Failed to create new 'SHTSEngineMEModel105' object"))
+		goto quit;
+
+	load_hts_engine_model(model, self->features, voice, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "Initialize",
+				  "Call to \"load_hts_engine_model\" failed"))
+	{
+		S_DELETE(model, "Initialize", error);
+		goto quit;
+	}
+
+	/* the voice owns the model, the utterance processor holds a reference */
+	SVoiceSetData((SVoice*)voice, key, S_OBJECT(model), error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "Initialize",
+				  "Call to \"SVoiceSetData\" failed"))
+	{
+		S_DELETE(model, "Initialize", error);
+		goto quit;
+	}
+
+	SObjectIncRef(S_OBJECT(model));
+	HTSsynth->model = model;
+
+	/* clean up */
+quit:
+	S_FREE(key);
+}
+
+
+static void *CreateState(const SUttProcessor *self, s_erc *error)
+{
+	const SHTSEngineMESynthUttProc105 *HTSsynth = (const SHTSEngineMESynthUttProc105*)self;
+	hts_me_state *me_state;
+	s_erc local_err = S_SUCCESS;
+
+
+	S_CLR_ERR(error);
+
+	me_state = S_CALLOC(hts_me_state, 1);
+	if (me_state == NULL)
+	{
+		S_FTL_ERR(error, S_MEMERROR,
+				  "CreateState",
+				  "Failed to allocate memory for 'hts_me_state' object");
+		return NULL;
+	}
+
+	if (HTSsynth->model->me == FALSE)
+		return me_state;
+
+	me_state->xp_sig = S_MALLOC(double, HTSsynth->model->me_filter_order);
+	me_state->xn_sig = S_MALLOC(double, HTSsynth->model->me_filter_order);
+	me_state->hp = S_MALLOC(double, HTSsynth->model->me_filter_order);
+	me_state->hn = S_MALLOC(double, HTSsynth->model->me_filter_order);
+	if ((me_state->xp_sig == NULL) || (me_state->xn_sig == NULL)
+		|| (me_state->hp == NULL) || (me_state->hn == NULL))
+	{
+		S_FTL_ERR(error, S_MEMERROR,
+				  "CreateState",
+				  "Failed to allocate memory for mixed excitation work buffers");
+		DestroyState(self, me_state, &local_err);
+		return NULL;
+	}
+
+	return me_state;
+}
+
+
+/* the model set and filters belong to the template, don't clear them here */
+static void DestroyState(const SUttProcessor *self, void *state, s_erc *error)
+{
+	hts_me_state *me_state = state;
+
+
+	S_CLR_ERR(error);
+	S_UNUSED(self);
+
+	if (me_state->xp_sig != NULL)
+		S_FREE(me_state->xp_sig);
+
+	if (me_state->xn_sig != NULL)
+		S_FREE(me_state->xn_sig);
+
+	if (me_state->hp != NULL)
+		S_FREE(me_state->hp);
+
+	if (me_state->hn != NULL)
+		S_FREE(me_state->hn);
+
+	S_FREE(me_state);
+}
+
+
+static void RunState(const SUttProcessor *self, void *engine_state, SUtterance *utt,
+					 s_erc *error)
+{
+	const SHTSEngineMESynthUttProc105 *HTSsynth = (const SHTSEngineMESynthUttProc105*)self;
+	hts_me_state *me_state = engine_state;
+	HTS_Engine *engine = &(me_state->engine);
 	SPlugin *audioPlugin;
 	const SRelation *segmentRel;
 	SAudio *audio = NULL;
+	SAudioStream *stream;
+	const SCancelToken *cancel;
 	s_bool is_present;
 	char **label_data = NULL;
 	int label_size;
@@ -1473,36 +1820,51 @@ static void Run(const SUttProcessor *self, SUtterance *utt,
 	uint i;
 	int frame;
 	int state;
-	const double rate = HTSsynth->engine.global.fperiod * 1e+7 / HTSsynth->engine.global.sampling_rate;
+	const double rate = HTSsynth->model->engine.global.fperiod * 1e+7 / HTSsynth->model->engine.global.sampling_rate;
 	int nstate;
 
 
 	S_CLR_ERR(error);
 
+	/* Start from an empty engine with copies of the global settings
+	 * and the model set of the model's engine (see
+	 * s_hts_engine_layout), the arrays and trees they point to are
+	 * only read by the run. The model has no audio buffer, so the
+	 * empty audio output is never written. The label and the streams
+	 * are private to this run.
+	 */
+	memset(engine, 0, sizeof(HTS_Engine));
+	engine->global = HTSsynth->model->engine.global;
+	engine->ms = HTSsynth->model->engine.ms;
+	HTS_Label_initialize(&(engine->label));
+	HTS_SStreamSet_initialize(&(engine->sss));
+	HTS_PStreamSet_initialize(&(engine->pss));
+	HTS_GStreamSet_initialize(&(engine->gss));
+
 	/* we require the segment relation */
 	is_present = SUtteranceRelationIsPresent(utt, "Segment", error);
 	if (S_CHK_ERR(error, S_CONTERR,
-				  "Run",
+				  "RunState",
 				  "Call to \"SUtteranceRelationIsPresent\" failed"))
 		goto quit_error;
 
 	if (!is_present)
 	{
 		S_CTX_ERR(error, S_FAILURE,
-				  "Run",
+				  "RunState",
 				  "Failed to find 'Segment' relation in utterance");
 		goto quit_error;
 	}
 
 	segmentRel = SUtteranceGetRelation(utt, "Segment", error);
 	if (S_CHK_ERR(error, S_CONTERR,
-				  "Run",
+				  "RunState",
 				  "Call to \"SUtteranceGetRelation\" failed"))
 		goto quit_error;
 
 	item = SRelationHead(segmentRel, error);
 	if (S_CHK_ERR(error, S_CONTERR,
-				  "Run",
+				  "RunState",
 				  "Call to \"SRelationHead\" failed"))
 		goto quit_error;
 
@@ -1526,70 +1888,98 @@ static void Run(const SUttProcessor *self, SUtterance *utt,
 
 		dFeat = SItemPathToFeatProc(itemItr, "hts_labels", error);
 		if (S_CHK_ERR(error, S_CONTERR,
-					  "Run",
+					  "RunState",
 					  "Call to \"SItemPathToFeatProc\" failed"))
 			goto quit_error;
 
 		if (dFeat == NULL)
 		{
 			S_CTX_ERR(error, S_FAILURE,
-					  "Run",
+					  "RunState",
 					  "Failed to generate hts labels for segment item");
 			goto quit_error;
 		}
 
 		tmp = SObjectGetString(dFeat, error);
 		if (S_CHK_ERR(error, S_CONTERR,
-					  "Run",
+					  "RunState",
 					  "Call to \"SObjectGetString\" failed"))
 			goto quit_error;
 
 		label_data[counter++] = s_strdup(tmp, error);
 		if (S_CHK_ERR(error, S_CONTERR,
-					  "Run",
+					  "RunState",
 					  "Call to \"s_strdup\" failed"))
 			goto quit_error;
 
 		SItemSetObject((SItem*)itemItr, "hts_label", dFeat, error);
 		if (S_CHK_ERR(error, S_CONTERR,
-					  "Run",
+					  "RunState",
 					  "Call to \"SItemSetObject\" failed"))
 			goto quit_error;
 
 		itemItr = SItemNext(itemItr, error);
 	}
 
+	/*
+	 * The HTS Engine generates all the frames of a stream in one
+	 * call, the cancellation token of the utterance is checked
+	 * before every stream.
+	 */
+	cancel = SCancelTokenGetFromUtt(utt, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "RunState",
+				  "Call to \"SCancelTokenGetFromUtt\" failed"))
+		goto quit_error;
+
 	/* speech synthesis part */
-	HTS_Engine_load_label_from_string_list(&(HTSsynth->engine), label_data, label_size);
-	check_and_change_rate_volume(HTSsynth, utt, error);
+	HTS_Engine_load_label_from_string_list(engine, label_data, label_size);
+	check_and_change_rate_volume(engine, utt, error);
 	if (S_CHK_ERR(error, S_CONTERR,
-				  "Run",
+				  "RunState",
 				  "Call to \"check_and_change_rate_volume\" failed"))
 		goto quit_error;
 
-	HTS_Engine_create_sstream(&(HTSsynth->engine));
-	check_and_change_tone(HTSsynth, utt, error);
+	SCancelTokenCheck(cancel, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "RunState",
+				  "Synthesis stopped before state sequence generation"))
+		goto quit_error;
+
+	HTS_Engine_create_sstream(engine);
+	check_and_change_tone(engine, utt, error);
 	if (S_CHK_ERR(error, S_CONTERR,
-				  "Run",
+				  "RunState",
 				  "Call to \"check_and_change_tone\" failed"))
 		goto quit_error;
 
-	HTS_Engine_create_pstream(&(HTSsynth->engine));
+	SCancelTokenCheck(cancel, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "RunState",
+				  "Synthesis stopped before parameter generation"))
+		goto quit_error;
 
-	if (HTSsynth->me == TRUE) /* mixed excitation */
+	HTS_Engine_create_pstream(engine);
+	SCancelTokenCheck(cancel, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "RunState",
+				  "Synthesis stopped before waveform generation"))
+		goto quit_error;
+
+	if (HTSsynth->model->me == TRUE) /* mixed excitation */
 	{
-		HTS_Engine_create_gstream_me(&(HTSsynth->engine),
-									 HTSsynth->me_num_filters, HTSsynth->me_filter_order,
-									 HTSsynth->me_filter, HTSsynth->xp_sig, HTSsynth->xn_sig,
-									 HTSsynth->hp, HTSsynth->hn,
-									 HTSsynth->pd_filter, HTSsynth->pd_filter_order);
+		HTS_Engine_create_gstream_me(engine,
+									 HTSsynth->model->me_num_filters, HTSsynth->model->me_filter_order,
+									 HTSsynth->model->me_filter, me_state->xp_sig, me_state->xn_sig,
+									 me_state->hp, me_state->hn,
+									 HTSsynth->model->pd_filter, HTSsynth->model->pd_filter_order);
 	}
 	else
 	{
-		HTS_Engine_create_gstream(&(HTSsynth->engine));
+		HTS_Engine_create_gstream(engine);
 	}
 
-	nstate = HTS_Speect_ModelSet_get_nstate(&(HTSsynth->engine));
+	nstate = HTS_Speect_ModelSet_get_nstate(engine);
 	itemItr = item;
 	counter = 0;
 	frame = 0;
@@ -1601,19 +1991,19 @@ static void Run(const SUttProcessor *self, SUtterance *utt,
 		float tmp;
 
 		for (j = 0; j < nstate; j++)
-			duration += HTS_Speect_SStreamSet_get_duration(&(HTSsynth->engine), state++);
+			duration += HTS_Speect_SStreamSet_get_duration(engine, state++);
 
 		tmp = frame * rate;
 		SItemSetFloat((SItem*)itemItr, "start", tmp/1e+7, error);
 		if (S_CHK_ERR(error, S_CONTERR,
-					  "Run",
+					  "RunState",
 					  "Call to \"SItemSetFloat\" failed"))
 			goto quit_error;
 
 		tmp = (frame + duration) * rate;
 		SItemSetFloat((SItem*)itemItr, "end", tmp/1e+7, error);
 		if (S_CHK_ERR(error, S_CONTERR,
-					  "Run",
+					  "RunState",
 					  "Call to \"SItemSetFloat\" failed"))
 			goto quit_error;
 
@@ -1632,56 +2022,73 @@ static void Run(const SUttProcessor *self, SUtterance *utt,
 	 */
 	audioPlugin = s_pm_load_plugin("audio.spi", error);
 	if (S_CHK_ERR(error, S_CONTERR,
-				  "Run",
+				  "RunState",
 				  "Call to \"SUtteranceSetFeature\" failed"))
 		goto quit_error;
 
 	SUtteranceSetFeature(utt, "audio_plugin", S_OBJECT(audioPlugin), error);
 	if (S_CHK_ERR(error, S_CONTERR,
-				  "Run",
+				  "RunState",
 				  "Call to \"SUtteranceSetFeature\" failed"))
 	{
-		S_DELETE(audioPlugin, "Run", error);
+		S_DELETE(audioPlugin, "RunState", error);
 		goto quit_error;
 	}
 
 	/* create an audio object */
 	audio = S_NEW(SAudio, error);
 	if (S_CHK_ERR(error, S_CONTERR,
-				  "Run",
+				  "RunState",
 				  "Failed to create new 'SAudio' object"))
 		goto quit_error;
 
 	/* set audio feature in utterance */
 	SUtteranceSetFeature(utt, "audio", S_OBJECT(audio), error);
 	if (S_CHK_ERR(error, S_CONTERR,
-				  "Run",
+				  "RunState",
 				  "Call to \"SUtteranceSetFeature\" failed"))
 	{
-		S_DELETE(audio, "Run", error);
+		S_DELETE(audio, "RunState", error);
 		goto quit_error;
     }
 
-	audio->sample_rate = HTSsynth->engine.global.sampling_rate;
-	audio->num_samples = (uint32)HTS_Speect_GStreamSet_get_total_nsample(&(HTSsynth->engine));
+	audio->sample_rate = engine->global.sampling_rate;
+	audio->num_samples = (uint32)HTS_Speect_GStreamSet_get_total_nsample(engine);
 	audio->samples = S_MALLOC(float, audio->num_samples);
 	if (audio->samples == NULL)
 	{
 		S_FTL_ERR(error, S_MEMERROR,
-				  "Run",
+				  "RunState",
 				  "Failed to allocate memory for 'float' object");
 		goto quit_error;
 	}
 
 	/* write data */
 	for (i = 0; i < audio->num_samples; i++)
-		audio->samples[i] = (float)(HTS_Speect_GStreamSet_get_speech(&(HTSsynth->engine), i) * 1.0);
+		audio->samples[i] = (float)(HTS_Speect_GStreamSet_get_speech(engine, i) * 1.0);
+
+	/* stream the audio if the utterance has an audio stream */
+	stream = SAudioStreamGetFromUtt(utt, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "RunState",
+				  "Call to \"SAudioStreamGetFromUtt\" failed"))
+		goto quit_error;
+
+	if (stream != NULL)
+	{
+		SAudioStreamWrite(stream, audio->samples, audio->num_samples,
+						  audio->sample_rate, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "RunState",
+					  "Call to \"SAudioStreamWrite\" failed"))
+			goto quit_error;
+	}
 
 	for (counter = 0; counter < label_size; counter++)
 		S_FREE(label_data[counter]);
 	S_FREE(label_data);
 
-	HTS_Engine_refresh(&(HTSsynth->engine));
+	HTS_Engine_refresh(engine);
 
 	/* all OK here */
 	return;
@@ -1699,6 +2106,7 @@ quit_error:
 		S_FREE(label_data);
 	}
 
+	HTS_Engine_refresh(engine);
 	return;
 }
 
@@ -1724,6 +2132,29 @@ static SHTSEngineMESynthUttProc105Class HTSEngineMESynthUttProc105Class =
 		NULL,            /* copy    */
 	},
 	/* SUttProcessorClass */
-	Initialize,          /* initialize */
-	Run                  /* run        */
+	Initialize,          /* initialize    */
+	NULL,                /* run           */
+	CreateState,         /* create_state  */
+	DestroyState,        /* destroy_state */
+	RunState             /* run_state     */
+};
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* SHTSEngineMEModel105 class initialization                                        */
+/*                                                                                  */
+/************************************************************************************/
+
+static SHTSEngineMEModel105Class HTSEngineMEModel105Class =
+{
+	"SHTSEngineMEModel105",
+	sizeof(SHTSEngineMEModel105),
+	{ 0, 1},
+	InitModel,       /* init    */
+	DestroyModel,    /* destroy */
+	DisposeModel,    /* dispose */
+	NULL,            /* compare */
+	NULL,            /* print   */
+	NULL,            /* copy    */
 };
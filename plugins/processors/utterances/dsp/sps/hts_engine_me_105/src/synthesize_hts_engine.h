@@ -65,28 +65,39 @@ S_BEGIN_C_DECLS
 
 /************************************************************************************/
 /*                                                                                  */
-/* SHTSEngineMESynthUttProc definition                                              */
+/* SHTSEngineMEModel105 definition                                                  */
 /*                                                                                  */
 /************************************************************************************/
 
 /**
- * The SHTSEngineMESynthUttProc105 structure.
- * An utterance processor to do HTS Engine (mixed excitation)
- * synthesis of a segment relation stream.
- * @extends SUttProcessor
+ * The SHTSEngineMEModel105 structure.
+ * The HTS Engine (mixed excitation) models of a voice. The model is
+ * loaded once per voice and configuration, by the first synthesizer
+ * utterance processor that is initialized, and set as voice data
+ * under a key made of the plug-in version, the voice configuration
+ * file, the engine settings and the model files. Other synthesizer
+ * utterance processors of the voice with the same configuration
+ * share it read-only.
+ * @extends SObject
  */
 typedef struct
 {
 	/**
-	 * @protected Inherit from #SUttProcessor.
+	 * @protected Inherit from #SObject.
 	 */
-	SUttProcessor obj;
+	SObject       obj;
 
 	/**
-	 * @protected The HTS Engine.
+	 * @protected The HTS Engine template. Holds the model set and
+	 * the global settings.
 	 */
 	HTS_Engine    engine;
 
+	/**
+	 * @protected #TRUE if the HTS Engine has been initialized.
+	 */
+	s_bool        initialized;
+
 	/**
 	 * @protected #TRUE if this is a mixed excitation voice.
 	 */
@@ -108,34 +119,55 @@ typedef struct
 	double        **me_filter;
 
 	/**
-	 * @protected pulse signal, the size of this should be the filter order
+	 * @protected pulse dispersion filter
 	 */
-	double        *xp_sig;
+	double        *pd_filter;
 
 	/**
-	 * @protected noise signal, the size of this should be the filter order
+	 * @protected pulse dispersion filter order
 	 */
-	double        *xn_sig;
+	int           pd_filter_order;
+} SHTSEngineMEModel105;
 
-	/**
-	 * @protected pulse shaping filter, size of the filter order
-	 */
-	double        *hp;
 
-	/**
-	 * @protected noise shaping filter, size of the filter order
-	 */
-    double        *hn;
+/************************************************************************************/
+/*                                                                                  */
+/* SHTSEngineMEModel105Class definition                                             */
+/*                                                                                  */
+/************************************************************************************/
+
+/**
+ * Typedef of the HTS Engine (mixed excitation) model class. Does not
+ * add any new methods, therefore exactly the same as #SObjectClass.
+ */
+typedef SObjectClass SHTSEngineMEModel105Class;
+
 
+/************************************************************************************/
+/*                                                                                  */
+/* SHTSEngineMESynthUttProc definition                                              */
+/*                                                                                  */
+/************************************************************************************/
+
+/**
+ * The SHTSEngineMESynthUttProc105 structure.
+ * An utterance processor to do HTS Engine (mixed excitation)
+ * synthesis of a segment relation stream.
+ * @extends SUttProcessor
+ */
+typedef struct
+{
 	/**
-	 * @protected pulse dispersion filter
+	 * @protected Inherit from #SUttProcessor.
 	 */
-    double        *pd_filter;
+	SUttProcessor obj;
 
 	/**
-	 * @protected pulse dispersion filter order
+	 * @protected The shared HTS Engine model of the voice. Each run
+	 * synthesizes with a private copy of its engine (see
+	 * #SUttProcessorStateAcquire).
 	 */
-    int           pd_filter_order;
+	SHTSEngineMEModel105 *model;
 } SHTSEngineMESynthUttProc105;
 
 
@@ -159,8 +191,8 @@ typedef SUttProcessorClass SHTSEngineMESynthUttProc105Class;
 /************************************************************************************/
 
 /**
- * Register the #SHTSEngineMESynthUttProc105 plug-in class with the Speect Engine
- * object system.
+ * Register the #SHTSEngineMESynthUttProc105 and #SHTSEngineMEModel105 plug-in
+ * classes with the Speect Engine object system.
  * @private
  *
  * @param error Error code.
@@ -169,8 +201,8 @@ S_LOCAL void _s_hts_engine_me_synth_utt_proc_105_class_reg(s_erc *error);
 
 
 /**
- * Free the #SHTSEngineMESynthUttProc105 plug-in class from the Speect Engine
- * object system.
+ * Free the #SHTSEngineMESynthUttProc105 and #SHTSEngineMEModel105 plug-in
+ * classes from the Speect Engine object system.
  * @private
  *
  * @param error Error code.
@@ -300,6 +300,9 @@ static SCreateUnitsUttProcClass CreateUnitsUttProcClass =
 		NULL,            /* copy    */
 	},
 	/* SUttProcessorClass */
-	NULL,                /* initialize */
-	Run                  /* run        */
+	NULL,                /* initialize    */
+	Run,                 /* run           */
+	NULL,                /* create_state  */
+	NULL,                /* destroy_state */
+	NULL                 /* run_state     */
 };
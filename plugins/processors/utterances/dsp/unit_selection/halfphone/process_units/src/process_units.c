@@ -631,6 +631,9 @@ static SProcessUnitsUttProcClass ProcessUnitsUttProcClass =
 		NULL,            /* copy    */
 	},
 	/* SUttProcessorClass */
-	Initialize,          /* initialize */
-	Run                  /* run        */
+	Initialize,          /* initialize    */
+	Run,                 /* run           */
+	NULL,                /* create_state  */
+	NULL,                /* destroy_state */
+	NULL                 /* run_state     */
 };
@@ -781,6 +781,9 @@ static SSelectUnitsUttProcClass SelectUnitsUttProcClass =
 		NULL,            /* copy    */
 	},
 	/* SUttProcessorClass */
-	NULL,                /* initialize */
-	Run                  /* run        */
+	NULL,                /* initialize    */
+	Run,                 /* run           */
+	NULL,                /* create_state  */
+	NULL,                /* destroy_state */
+	NULL                 /* run_state     */
 };
@@ -208,6 +208,8 @@ static void Run(const SUttProcessor *self, SUtterance *utt,
 	const char *tmp;
 	int scomp;
 	SAudio *audio = NULL;
+	SAudioStream *stream;
+	const SCancelToken *cancel;
 	s_bool is_present;
 
 
@@ -301,8 +303,23 @@ static void Run(const SUttProcessor *self, SUtterance *utt,
 				  "Call to SRelp method \"map_tracks\" failed"))
 		goto quit_error;
 
+	/* the samples are streamed while generating if the utterance has
+	 * an audio stream */
+	stream = SAudioStreamGetFromUtt(utt, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "Run",
+				  "Call to \"SAudioStreamGetFromUtt\" failed"))
+		goto quit_error;
+
+	/* synthesis stops if the utterance is cancelled */
+	cancel = SCancelTokenGetFromUtt(utt, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "Run",
+				  "Call to \"SCancelTokenGetFromUtt\" failed"))
+		goto quit_error;
+
 	/* do synthesis */
-	audio = S_RELP_CALL(relpSynth, generate)(relpSynth, error);
+	audio = S_RELP_CALL(relpSynth, generate)(relpSynth, stream, cancel, error);
 	if (S_CHK_ERR(error, S_CONTERR,
 				  "Run",
 				  "Call to SRelp method \"generate\" failed"))
@@ -354,6 +371,9 @@ static SRELPSynthUnitsUttProcClass RELPSynthUnitsUttProcClass =
 		NULL,            /* copy    */
 	},
 	/* SUttProcessorClass */
-	Initialize,          /* initialize */
-	Run                  /* run        */
+	Initialize,          /* initialize    */
+	Run,                 /* run           */
+	NULL,                /* create_state  */
+	NULL,                /* destroy_state */
+	NULL                 /* run_state     */
 };
@@ -55,6 +55,28 @@
 /*                                                                                  */
 /************************************************************************************/
 
+/* character classes of token bytes */
+#define S_CRF_CHAR_DIGIT  0x01
+#define S_CRF_CHAR_UPPER  0x02
+#define S_CRF_CHAR_SYMBOL 0x04
+
+/* number of prefix and suffix attributes of a token */
+#define S_CRF_NUM_PREFIXES 3
+#define S_CRF_NUM_SUFFIXES 3
+
+/* number of prefix and suffix attributes of a folded token */
+#define S_CRF_NUM_FOLDED_PREFIXES 4
+#define S_CRF_NUM_FOLDED_SUFFIXES 6
+
+/* words before and after a token in the word attributes */
+#define S_CRF_WORD_WINDOW 9
+
+/* maximum byte width of a UTF-8 character */
+#define S_CRF_CHAR_SIZE 6
+
+/* value of prefix/suffix attributes of tokens that are too short */
+#define S_CRF_NIL "__nil__"
+
 
 /************************************************************************************/
 /*                                                                                  */
@@ -65,24 +87,154 @@
 /* SCrfSuiteUttProc class declaration. */
 static SCrfSuiteUttProcClass CrfSuiteUttProcClass;
 
+#define CD S_CRF_CHAR_DIGIT
+#define CU S_CRF_CHAR_UPPER
+#define CS S_CRF_CHAR_SYMBOL
+
+/* character class of each byte, anything other than [a-zA-Z0-9] is a symbol */
+static const uint8 char_classes[256] =
+{
+	CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, /* 0x00 */
+	CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, /* 0x10 */
+	CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, /* 0x20 */
+	CD, CD, CD, CD, CD, CD, CD, CD, CD, CD, CS, CS, CS, CS, CS, CS, /* 0x30 */
+	CS, CU, CU, CU, CU, CU, CU, CU, CU, CU, CU, CU, CU, CU, CU, CU, /* 0x40 */
+	CU, CU, CU, CU, CU, CU, CU, CU, CU, CU, CU, CS, CS, CS, CS, CS, /* 0x50 */
+	CS,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, /* 0x60 */
+	 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, CS, CS, CS, CS, CS, /* 0x70 */
+	CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, /* 0x80 */
+	CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, /* 0x90 */
+	CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, /* 0xA0 */
+	CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, /* 0xB0 */
+	CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, /* 0xC0 */
+	CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, /* 0xD0 */
+	CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, /* 0xE0 */
+	CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS, CS  /* 0xF0 */
+};
+
+#undef CD
+#undef CU
+#undef CS
+
+/* character class attributes, interned when a state is created */
+static const uint8 class_flags[3] =
+{
+	S_CRF_CHAR_DIGIT, S_CRF_CHAR_SYMBOL, S_CRF_CHAR_UPPER
+};
+
+static const char * const class_attributes[3][2] =
+{
+	{ "num[0]=N", "num[0]=Y" },
+	{ "sym[0]=N", "sym[0]=Y" },
+	{ "cap[0]=N", "cap[0]=Y" }
+};
+
+static const char * const prefix_names[S_CRF_NUM_PREFIXES] =
+{
+	"p1[0]=", "p2[0]=", "p3[0]="
+};
+
+static const char * const suffix_names[S_CRF_NUM_SUFFIXES] =
+{
+	"s1[0]=", "s2[0]=", "s3[0]="
+};
+
+static const char * const folded_prefix_names[S_CRF_NUM_FOLDED_PREFIXES] =
+{
+	"P1[0]=", "P2[0]=", "P3[0]=", "P4[0]="
+};
+
+static const char * const folded_suffix_names[S_CRF_NUM_FOLDED_SUFFIXES] =
+{
+	"S1[0]=", "S2[0]=", "S3[0]=", "S4[0]=", "S5[0]=", "S6[0]="
+};
+
+/* word attribute names, indexed by the word offset + S_CRF_WORD_WINDOW */
+static const char * const word_names[2 * S_CRF_WORD_WINDOW + 1] =
+{
+	"w[-9]", "w[-8]", "w[-7]", "w[-6]", "w[-5]", "w[-4]", "w[-3]", "w[-2]", "w[-1]",
+	"w[0]",
+	"w[1]", "w[2]", "w[3]", "w[4]", "w[5]", "w[6]", "w[7]", "w[8]", "w[9]"
+};
+
+/* word n-gram attributes, number of words followed by the word offsets */
+static const int word_ngrams[][6] =
+{
+	{ 1, 0 },
+	{ 1, -1 },
+	{ 1, 1 },
+	{ 1, -2 },
+	{ 1, 2 },
+	{ 2, -2, -1 },
+	{ 2, -1, 0 },
+	{ 2, 0, 1 },
+	{ 2, 1, 2 },
+	{ 3, -2, -1, 0 },
+	{ 3, -1, 0, 1 },
+	{ 3, 0, 1, 2 },
+	{ 4, -2, -1, 0, 1 },
+	{ 4, -1, 0, 1, 2 },
+	{ 5, -2, -1, 0, 1, 2 }
+};
+
 
 /************************************************************************************/
 /*                                                                                  */
-/* Static function prototypes                                                       */
+/* Static data types                                                                */
 /*                                                                                  */
 /************************************************************************************/
 
-static const char* removeDoubles ( const char* string, s_erc *error);
+/* A token of the utterance being tagged. */
+typedef struct
+{
+	SItem      *item;
+	const char *name;
+} s_crf_token;
 
-static const char* getFirstChars ( const char* string, int n,  s_erc *error);
 
-static const char* getLastChars (const char* string, int n,  s_erc *error);
+/*
+ * The per-run state. Taggers of the same crfsuite model share their
+ * lattice, so every state has its own model instance. The token and
+ * instance buffers only grow and are reused by the following runs.
+ */
+typedef struct
+{
+	crfsuite_model_t      *model;
+	crfsuite_tagger_t     *tagger;
+	crfsuite_dictionary_t *attrs;
+	crfsuite_dictionary_t *labels;
+
+	/* interned character class attribute IDs, [class][has class] */
+	int                    class_ids[3][2];
+	int                    unk_label;
+
+	/* tokens of all the phrases of the utterance */
+	s_crf_token           *tokens;
+	crfsuite_item_t       *items;
+	int                   *item_labels;
+	int                   *output;
+	int                    num_tokens;
+	int                    tokens_size;
+
+	/* index of the first token of each phrase */
+	int                   *phrases;
+	int                    num_phrases;
+	int                    phrases_size;
+
+	/* attribute name being built */
+	char                  *key;
+	size_t                 key_size;
+} s_crfsuite_state;
+
 
-static s_bool hasCapital (const char* string,  s_erc *error);
+/************************************************************************************/
+/*                                                                                  */
+/* Static function prototypes                                                       */
+/*                                                                                  */
+/************************************************************************************/
 
-static s_bool hasNumber (const char* string,  s_erc *error);
+static void DestroyState(const SUttProcessor *self, void *state, s_erc *error);
 
-static s_bool hasSymbol (const char* string,  s_erc *error);
 
 /************************************************************************************/
 /*                                                                                  */
@@ -117,189 +269,644 @@ S_LOCAL void _s_crfsuite_utt_proc_class_free(s_erc *error)
 /*                                                                                  */
 /************************************************************************************/
 
-static const char* removeDoubles ( const char* string, s_erc *error)
+/* make room for the given number of tokens, new items are empty */
+static void reserve_tokens(s_crfsuite_state *state, int num_tokens, s_erc *error)
 {
-	char* result = NULL;
-	char tmp[7];
-	char tmp2[7];
-	int i = 0;
+	s_crf_token *tokens;
+	crfsuite_item_t *items;
+	int *item_labels;
+	int *output;
+	int new_size;
+	int i;
 
-	if (string == NULL)
-		return NULL;
 
-	while (string[i] != '\0')
+	S_CLR_ERR(error);
+
+	if (num_tokens <= state->tokens_size)
+		return;
+
+	new_size = (state->tokens_size == 0) ? 32 : (state->tokens_size * 2);
+	while (new_size < num_tokens)
+		new_size *= 2;
+
+	tokens = S_REALLOC(state->tokens, s_crf_token, new_size);
+	if (tokens == NULL)
+	{
+		S_FTL_ERR(error, S_MEMERROR,
+				  "reserve_tokens",
+				  "Failed to reallocate memory for 's_crf_token' object");
+		return;
+	}
+	state->tokens = tokens;
+
+	items = S_REALLOC(state->items, crfsuite_item_t, new_size);
+	if (items == NULL)
+	{
+		S_FTL_ERR(error, S_MEMERROR,
+				  "reserve_tokens",
+				  "Failed to reallocate memory for 'crfsuite_item_t' object");
+		return;
+	}
+
+	for (i = state->tokens_size; i < new_size; i++)
+		crfsuite_item_init(&(items[i]));
+	state->items = items;
+
+	item_labels = S_REALLOC(state->item_labels, int, new_size);
+	if (item_labels == NULL)
+	{
+		S_FTL_ERR(error, S_MEMERROR,
+				  "reserve_tokens",
+				  "Failed to reallocate memory for 'int' object");
+		return;
+	}
+	state->item_labels = item_labels;
+
+	output = S_REALLOC(state->output, int, new_size);
+	if (output == NULL)
+	{
+		S_FTL_ERR(error, S_MEMERROR,
+				  "reserve_tokens",
+				  "Failed to reallocate memory for 'int' object");
+		return;
+	}
+	state->output = output;
+
+	state->tokens_size = new_size;
+}
+
+
+static void add_phrase(s_crfsuite_state *state, s_erc *error)
+{
+	int *phrases;
+	int new_size;
+
+
+	S_CLR_ERR(error);
+
+	if (state->num_phrases == state->phrases_size)
+	{
+		new_size = (state->phrases_size == 0) ? 8 : (state->phrases_size * 2);
+		phrases = S_REALLOC(state->phrases, int, new_size);
+		if (phrases == NULL)
+		{
+			S_FTL_ERR(error, S_MEMERROR,
+					  "add_phrase",
+					  "Failed to reallocate memory for 'int' object");
+			return;
+		}
+
+		state->phrases = phrases;
+		state->phrases_size = new_size;
+	}
+
+	state->phrases[state->num_phrases++] = state->num_tokens;
+}
+
+
+/* collect the tokens of all the phrases of the utterance */
+static void collect_tokens(s_crfsuite_state *state, const SUtterance *utt, s_erc *error)
+{
+	const SRelation *phraseRel;
+	const SItem *itrPhrase;
+	const SItem *token;
+	const SItem *finishToken;
+	s_crf_token *crfToken;
+
+
+	S_CLR_ERR(error);
+
+	state->num_tokens = 0;
+	state->num_phrases = 0;
+
+	phraseRel = SUtteranceGetRelation(utt, "Phrase", error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "collect_tokens",
+				  "Call to \"SUtteranceGetRelation\" failed"))
+		return;
+
+	itrPhrase = SRelationHead(phraseRel, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "collect_tokens",
+				  "Call to \"SRelationHead\" failed"))
+		return;
+
+	while (itrPhrase != NULL)
 	{
-		/*check if next char is the same of the actual char, if so it skips it
-		 * and check for the next one ( care for the UTF8 format )
-		 */
-		s_strncpy (tmp, string +i, 1, error);
+		add_phrase(state, error);
 		if (S_CHK_ERR(error, S_CONTERR,
-				  "removeDoubles",
-				  "Call to \"s_strncpy\" failed"))
-			return NULL;
+					  "collect_tokens",
+					  "Call to \"add_phrase\" failed"))
+			return;
 
-		s_strncpy (tmp2, string +i, 1, error);
+		token = SItemPathToItem(itrPhrase, "daughter.R:Token.parent", error);
 		if (S_CHK_ERR(error, S_CONTERR,
-				  "removeDoubles",
-				  "Call to \"s_strncpy\" failed"))
-			return NULL;
+					  "collect_tokens",
+					  "Call to \"SItemPathToItem\" failed"))
+			return;
 
-		int j = s_width(tmp2, error);
+		/* first token of the next phrase */
+		finishToken = SItemPathToItem(itrPhrase, "n.daughter.R:Token.parent", error);
 		if (S_CHK_ERR(error, S_CONTERR,
-				  "removeDoubles",
-				  "Call to \"s_width\" failed"))
-			return NULL;
+					  "collect_tokens",
+					  "Call to \"SItemPathToItem\" failed"))
+			return;
 
-		while ( string[i] == string[i+j] )
+		while ((token != NULL) && (token != finishToken))
 		{
-			s_strncpy (tmp2, string +i, 1, error);
+			reserve_tokens(state, state->num_tokens + 1, error);
 			if (S_CHK_ERR(error, S_CONTERR,
-					  "removeDoubles",
-					  "Call to \"s_strncpy\" failed"))
-				return NULL;
-			j += s_width(tmp2, error);
+						  "collect_tokens",
+						  "Call to \"reserve_tokens\" failed"))
+				return;
+
+			crfToken = &(state->tokens[state->num_tokens]);
+			crfToken->item = (SItem*)token;
+			crfToken->name = SItemGetName(token, error);
+			if (S_CHK_ERR(error, S_CONTERR,
+						  "collect_tokens",
+						  "Call to \"SItemGetName\" failed"))
+				return;
+
+			state->num_tokens++;
+
+			token = SItemNext(token, error);
+			if (S_CHK_ERR(error, S_CONTERR,
+						  "collect_tokens",
+						  "Call to \"SItemNext\" failed"))
+				return;
 		}
 
-		s_sappend (&result, tmp, error);
+		itrPhrase = SItemNext(itrPhrase, error);
 		if (S_CHK_ERR(error, S_CONTERR,
-				  "removeDoubles",
-				  "Call to \"s_sappend\" failed"))
-			return NULL;
-
-		i += j;
-		/*next char that is not repeated*/
+					  "collect_tokens",
+					  "Call to \"SItemNext\" failed"))
+			return;
 	}
+}
 
-	result = s_strlwr( result, error );
-	if (S_CHK_ERR(error, S_CONTERR,
-			  "removeDoubles",
-			  "Call to \"s_strlwr\" failed"))
-		return NULL;
 
-	return result;
+/* append a string to the attribute name at the given length, returns the new length */
+static size_t key_append(s_crfsuite_state *state, size_t len, const char *string,
+						 size_t size, s_erc *error)
+{
+	char *key;
+	size_t new_size;
+
+
+	S_CLR_ERR(error);
 
+	if (len + size + 1 > state->key_size)
+	{
+		new_size = (state->key_size == 0) ? 256 : (state->key_size * 2);
+		while (new_size < len + size + 1)
+			new_size *= 2;
+
+		key = S_REALLOC(state->key, char, new_size);
+		if (key == NULL)
+		{
+			S_FTL_ERR(error, S_MEMERROR,
+					  "key_append",
+					  "Failed to reallocate memory for 'char' object");
+			return 0;
+		}
+
+		state->key = key;
+		state->key_size = new_size;
+	}
+
+	memcpy(state->key + len, string, size);
+	state->key[len + size] = '\0';
+
+	return len + size;
 }
 
-static const char* getFirstChars ( const char* string, int n,  s_erc *error)
+
+/* attributes that are not in the model are skipped, as crfsuite does */
+static void append_attribute(crfsuite_item_t *item, int attribute_id, s_erc *error)
 {
-	char* result = NULL;
-	char tmp[7];
-	int i = 0, j = 0;
+	crfsuite_attribute_t attribute;
 
-	if (string == NULL)
-		return NULL;
 
-	while (string[i] != '\0' && j < n )
+	S_CLR_ERR(error);
+
+	if (attribute_id < 0)
+		return;
+
+	crfsuite_attribute_set(&attribute, attribute_id, 1.0);
+	if (crfsuite_item_append_attribute(item, &attribute) != 0)
 	{
-		s_strncpy (tmp, string +i, 1, error);
-		if (S_CHK_ERR(error, S_CONTERR,
-				  "getFirstChars",
-				  "Call to \"s_strncpy\" failed"))
-			return NULL;
+		S_FTL_ERR(error, S_MEMERROR,
+				  "append_attribute",
+				  "Call to \"crfsuite_item_append_attribute\" failed");
+		return;
+	}
+}
 
-		s_sappend (&result, tmp, error);
-		if (S_CHK_ERR(error, S_CONTERR,
-				  "getFirstChars",
-				  "Call to \"s_sappend\" failed"))
-			return NULL;
 
-		j += 1;
-		i += s_width(tmp, error);
-		if (S_CHK_ERR(error, S_CONTERR,
-				  "getFirstChars",
-				  "Call to \"s_width\" failed"))
-			return NULL;
+/* append the attribute "name=value", a NULL value is S_CRF_NIL */
+static void append_string_attribute(s_crfsuite_state *state, crfsuite_item_t *item,
+									const char *name, const char *value,
+									size_t value_size, s_erc *error)
+{
+	size_t len;
+
+
+	S_CLR_ERR(error);
+
+	if (value == NULL)
+	{
+		value = S_CRF_NIL;
+		value_size = sizeof(S_CRF_NIL) - 1;
 	}
 
-	if ( j == n )
-		return result;
-	else
-		return NULL;
+	len = key_append(state, 0, name, strlen(name), error);
+	if (!S_CHK_ERR(error, S_CONTERR,
+				   "append_string_attribute",
+				   "Call to \"key_append\" failed"))
+		key_append(state, len, value, value_size, error);
+
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "append_string_attribute",
+				  "Call to \"key_append\" failed"))
+		return;
+
+	append_attribute(item, state->attrs->to_id(state->attrs, state->key), error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "append_string_attribute",
+			  "Call to \"append_attribute\" failed");
 }
 
-static const char* getLastChars (const char* string, int n,  s_erc *error)
+
+/*
+ * Append the attributes of the token itself, computed in one scan of
+ * the token name: the character classes, the prefixes and suffixes,
+ * and the prefixes and suffixes of the folded token. The folded token
+ * is lower case and drops characters that follow a character with the
+ * same lead byte, like the previous feature extraction did, so that
+ * the attributes match the trained models.
+ */
+static void append_token_attributes(s_crfsuite_state *state, crfsuite_item_t *item,
+									const char *name, s_erc *error)
 {
-	char* result = NULL;
-	char tmp[7];
-	int i = 0;
+	size_t prefix_ends[S_CRF_NUM_PREFIXES];
+	size_t suffix_starts[S_CRF_NUM_SUFFIXES];
+	char folded_head[S_CRF_NUM_FOLDED_PREFIXES * S_CRF_CHAR_SIZE];
+	size_t folded_head_ends[S_CRF_NUM_FOLDED_PREFIXES];
+	char folded_tail[S_CRF_NUM_FOLDED_SUFFIXES][S_CRF_CHAR_SIZE];
+	size_t folded_tail_widths[S_CRF_NUM_FOLDED_SUFFIXES];
+	char folded_suffix[S_CRF_NUM_FOLDED_SUFFIXES * S_CRF_CHAR_SIZE];
+	size_t folded_suffix_starts[S_CRF_NUM_FOLDED_SUFFIXES];
+	size_t num_chars = 0;
+	size_t num_folded = 0;
+	size_t num_tail;
+	size_t pos = 0;
+	size_t prev = 0;
+	size_t width;
+	size_t folded_width;
+	size_t len;
+	size_t start;
+	size_t i;
+	uint8 classes = 0;
+	uint32 c;
+	char *slot;
 
-	int j = s_strlen(string, error);
-	if (S_CHK_ERR(error, S_CONTERR,
-			  "getLastChars",
-			  "Call to \"s_strlen\" failed"))
-		return NULL;
 
-	if (string == NULL || j < n )
-		return NULL;
+	S_CLR_ERR(error);
 
-	while (string[i] != '\0' && j > 0 )
+	while (name[pos] != '\0')
 	{
-		s_strncpy (tmp, string +i, 1, error);
+		width = s_width(name + pos, error);
 		if (S_CHK_ERR(error, S_CONTERR,
-				  "getLastChars",
-				  "Call to \"s_strncpy\" failed"))
-			return NULL;
+					  "append_token_attributes",
+					  "Call to \"s_width\" failed"))
+			return;
+
+		for (i = 0; (i < width) && (name[pos + i] != '\0'); i++)
+			classes |= char_classes[(uchar)name[pos + i]];
+		width = i;
 
-		j -= 1;
+		if (num_chars < S_CRF_NUM_PREFIXES)
+			prefix_ends[num_chars] = pos + width;
+		suffix_starts[num_chars % S_CRF_NUM_SUFFIXES] = pos;
 
-		if ( j < n )
+		if ((num_chars == 0) || (name[pos] != name[prev]))
 		{
-			s_sappend (&result, tmp, error);
+			c = s_getc(name + pos, error);
 			if (S_CHK_ERR(error, S_CONTERR,
-					  "getLastChars",
-					  "Call to \"s_sappend\" failed"))
-				return NULL;
+						  "append_token_attributes",
+						  "Call to \"s_getc\" failed"))
+				return;
+
+			c = s_tolower(c, error);
+			if (S_CHK_ERR(error, S_CONTERR,
+						  "append_token_attributes",
+						  "Call to \"s_tolower\" failed"))
+				return;
+
+			slot = folded_tail[num_folded % S_CRF_NUM_FOLDED_SUFFIXES];
+			folded_width = s_setc(slot, c, error);
+			if (S_CHK_ERR(error, S_CONTERR,
+						  "append_token_attributes",
+						  "Call to \"s_setc\" failed"))
+				return;
+
+			folded_tail_widths[num_folded % S_CRF_NUM_FOLDED_SUFFIXES] = folded_width;
+
+			if (num_folded < S_CRF_NUM_FOLDED_PREFIXES)
+			{
+				start = (num_folded == 0) ? 0 : folded_head_ends[num_folded - 1];
+				memcpy(folded_head + start, slot, folded_width);
+				folded_head_ends[num_folded] = start + folded_width;
+			}
+
+			num_folded++;
 		}
 
-		i += s_width(tmp, error);
+		num_chars++;
+		prev = pos;
+		pos += width;
+	}
+
+	/* character classes */
+	for (i = 0; i < 3; i++)
+	{
+		append_attribute(item, state->class_ids[i][(classes & class_flags[i]) != 0], error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "append_token_attributes",
+					  "Call to \"append_attribute\" failed"))
+			return;
+	}
+
+	/* prefixes of 1 to 3 characters */
+	for (i = 0; i < S_CRF_NUM_PREFIXES; i++)
+	{
+		append_string_attribute(state, item, prefix_names[i],
+								(num_chars > i) ? name : NULL,
+								(num_chars > i) ? prefix_ends[i] : 0, error);
 		if (S_CHK_ERR(error, S_CONTERR,
-				  "getLastChars",
-				  "Call to \"s_width\" failed"))
-			return NULL;
+					  "append_token_attributes",
+					  "Call to \"append_string_attribute\" failed"))
+			return;
 	}
 
-		return result;
+	/* suffixes of 1 to 3 characters */
+	for (i = 0; i < S_CRF_NUM_SUFFIXES; i++)
+	{
+		start = 0;
+		if (num_chars > i)
+			start = suffix_starts[(num_chars - i - 1) % S_CRF_NUM_SUFFIXES];
+
+		append_string_attribute(state, item, suffix_names[i],
+								(num_chars > i) ? name + start : NULL, pos - start, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "append_token_attributes",
+					  "Call to \"append_string_attribute\" failed"))
+			return;
+	}
+
+	/* prefixes of 1 to 4 characters of the folded token */
+	for (i = 0; i < S_CRF_NUM_FOLDED_PREFIXES; i++)
+	{
+		append_string_attribute(state, item, folded_prefix_names[i],
+								(num_folded > i) ? folded_head : NULL,
+								(num_folded > i) ? folded_head_ends[i] : 0, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "append_token_attributes",
+					  "Call to \"append_string_attribute\" failed"))
+			return;
+	}
+
+	/* suffixes of 1 to 6 characters of the folded token, the
+	 * last characters are copied out of the ring in order */
+	num_tail = (num_folded < S_CRF_NUM_FOLDED_SUFFIXES) ? num_folded : S_CRF_NUM_FOLDED_SUFFIXES;
+	len = 0;
+	for (i = 0; i < num_tail; i++)
+	{
+		c = (uint32)((num_folded - num_tail + i) % S_CRF_NUM_FOLDED_SUFFIXES);
+		folded_suffix_starts[i] = len;
+		memcpy(folded_suffix + len, folded_tail[c], folded_tail_widths[c]);
+		len += folded_tail_widths[c];
+	}
+
+	for (i = 0; i < S_CRF_NUM_FOLDED_SUFFIXES; i++)
+	{
+		start = 0;
+		if (num_tail > i)
+			start = folded_suffix_starts[num_tail - i - 1];
+
+		append_string_attribute(state, item, folded_suffix_names[i],
+								(num_tail > i) ? folded_suffix + start : NULL,
+								len - start, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "append_token_attributes",
+					  "Call to \"append_string_attribute\" failed"))
+			return;
+	}
 }
 
-static s_bool hasCapital (const char* string,  s_erc *error)
+
+/*
+ * Append the attribute of the words at the given offsets from the
+ * token, "w[o1]|w[o2]=word1|word2". Nothing is appended if one of the
+ * words is outside of the phrase.
+ */
+static void append_word_attribute(s_crfsuite_state *state, crfsuite_item_t *item,
+								  const s_crf_token *phrase, int num_words, int pos,
+								  const int *offsets, int num_offsets, s_erc *error)
 {
-	s_bool result;
+	const char *word_name;
+	size_t len = 0;
+	int i;
+
 
-	result = s_smatches ( string, ".*[A-Z]+.*", error );
+	S_CLR_ERR(error);
+
+	for (i = 0; i < num_offsets; i++)
+	{
+		if ((pos + offsets[i] < 0) || (pos + offsets[i] >= num_words))
+			return;
+	}
+
+	for (i = 0; i < num_offsets; i++)
+	{
+		if (i > 0)
+			len = key_append(state, len, "|", 1, error);
+
+		word_name = word_names[offsets[i] + S_CRF_WORD_WINDOW];
+		if (!S_CHK_ERR(error, S_CONTERR,
+					   "append_word_attribute",
+					   "Call to \"key_append\" failed"))
+			len = key_append(state, len, word_name, strlen(word_name), error);
+
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "append_word_attribute",
+					  "Call to \"key_append\" failed"))
+			return;
+	}
+
+	len = key_append(state, len, "=", 1, error);
 	if (S_CHK_ERR(error, S_CONTERR,
-			  "hasCapital",
-			  "Call to \"s_smatches\" failed"))
-		return FALSE;
+				  "append_word_attribute",
+				  "Call to \"key_append\" failed"))
+		return;
+
+	for (i = 0; i < num_offsets; i++)
+	{
+		if (i > 0)
+			len = key_append(state, len, "|", 1, error);
+
+		word_name = phrase[pos + offsets[i]].name;
+		if (!S_CHK_ERR(error, S_CONTERR,
+					   "append_word_attribute",
+					   "Call to \"key_append\" failed"))
+			len = key_append(state, len, word_name, strlen(word_name), error);
 
-	return result;
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "append_word_attribute",
+					  "Call to \"key_append\" failed"))
+			return;
+	}
+
+	append_attribute(item, state->attrs->to_id(state->attrs, state->key), error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "append_word_attribute",
+			  "Call to \"append_attribute\" failed");
 }
 
-static s_bool hasNumber (const char* string,  s_erc *error)
+
+/* Append the attributes of the words around the token in its phrase. */
+static void append_word_attributes(s_crfsuite_state *state, crfsuite_item_t *item,
+								   const s_crf_token *phrase, int num_words, int pos,
+								   s_erc *error)
 {
-	s_bool result;
+	int offsets[2];
+	size_t i;
+	int j;
 
-	result = s_smatches ( string, ".*[0-9]+.*", error );
-	if (S_CHK_ERR(error, S_CONTERR,
-			  "hasCapital",
-			  "Call to \"s_smatches\" failed"))
-		return FALSE;
 
-	return result;
+	S_CLR_ERR(error);
+
+	/* n-grams around the token */
+	for (i = 0; i < sizeof(word_ngrams) / sizeof(word_ngrams[0]); i++)
+	{
+		append_word_attribute(state, item, phrase, num_words, pos,
+							  &(word_ngrams[i][1]), word_ngrams[i][0], error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "append_word_attributes",
+					  "Call to \"append_word_attribute\" failed"))
+			return;
+	}
+
+	/* the token with each of the words before it, then after it */
+	offsets[0] = 0;
+	for (j = 1; j <= S_CRF_WORD_WINDOW; j++)
+	{
+		offsets[1] = -j;
+		append_word_attribute(state, item, phrase, num_words, pos, offsets, 2, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "append_word_attributes",
+					  "Call to \"append_word_attribute\" failed"))
+			return;
+	}
+
+	for (j = 1; j <= S_CRF_WORD_WINDOW; j++)
+	{
+		offsets[1] = j;
+		append_word_attribute(state, item, phrase, num_words, pos, offsets, 2, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "append_word_attributes",
+					  "Call to \"append_word_attribute\" failed"))
+			return;
+	}
 }
 
-static s_bool hasSymbol (const char* string,  s_erc *error)
+
+/* Build the crfsuite items of all the collected tokens. */
+static void build_items(s_crfsuite_state *state, s_erc *error)
 {
-	s_bool result;
+	const s_crf_token *phrase;
+	crfsuite_item_t *item;
+	int num_words;
+	int start;
+	int p;
+	int i;
+
+
+	S_CLR_ERR(error);
+
+	for (p = 0; p < state->num_phrases; p++)
+	{
+		start = state->phrases[p];
+		num_words = ((p + 1 < state->num_phrases) ? state->phrases[p + 1] : state->num_tokens) - start;
+		phrase = state->tokens + start;
+
+		for (i = 0; i < num_words; i++)
+		{
+			item = &(state->items[start + i]);
+			item->num_contents = 0;
+			state->item_labels[start + i] = state->unk_label;
+
+			append_token_attributes(state, item, phrase[i].name, error);
+			if (S_CHK_ERR(error, S_CONTERR,
+						  "build_items",
+						  "Call to \"append_token_attributes\" failed"))
+				return;
+
+			append_word_attributes(state, item, phrase, num_words, i, error);
+			if (S_CHK_ERR(error, S_CONTERR,
+						  "build_items",
+						  "Call to \"append_word_attributes\" failed"))
+				return;
+		}
+	}
+}
 
-	result = s_smatches ( string, ".*?[^a-zA-Z0-9].*", error );
-	if (S_CHK_ERR(error, S_CONTERR,
-			  "hasCapital",
-			  "Call to \"s_smatches\" failed"))
-		return FALSE;
 
-	return result;
+/* Tag the phrases one after the other, on the shared item buffer. */
+static void tag_phrases(s_crfsuite_state *state, s_erc *error)
+{
+	crfsuite_instance_t instance;
+	floatval_t score;
+	int start;
+	int end;
+	int p;
+
+
+	S_CLR_ERR(error);
+
+	for (p = 0; p < state->num_phrases; p++)
+	{
+		start = state->phrases[p];
+		end = (p + 1 < state->num_phrases) ? state->phrases[p + 1] : state->num_tokens;
+		if (start == end)
+			continue;
+
+		/* a view of the phrase items, owned by the state */
+		crfsuite_instance_init(&instance);
+		instance.num_items = end - start;
+		instance.items = state->items + start;
+		instance.labels = state->item_labels + start;
+
+		if (state->tagger->set(state->tagger, &instance) != 0)
+		{
+			S_CTX_ERR(error, S_FAILURE,
+					  "tag_phrases",
+					  "Call to crfsuite tagger \"set\" failed");
+			return;
+		}
+
+		if (state->tagger->viterbi(state->tagger, state->output + start, &score) != 0)
+		{
+			S_CTX_ERR(error, S_FAILURE,
+					  "tag_phrases",
+					  "Call to crfsuite tagger \"viterbi\" failed");
+			return;
+		}
+	}
 }
 
+
 /************************************************************************************/
 /*                                                                                  */
 /* Static class function implementations                                            */
@@ -311,8 +918,11 @@ static void Destroy(void *obj, s_erc *error)
 {
 	SCrfSuiteUttProc *self = obj;
 
+
 	S_CLR_ERR(error);
-	S_UNUSED(self);
+
+	if (self->model_file != NULL)
+		S_FREE(self->model_file);
 }
 
 
@@ -362,6 +972,9 @@ static void Initialize(SUttProcessor *self, const SVoice *voice, s_erc *error)
 				  "Call to \"SObjectGetString\" failed"))
 			return;
 
+		if (crfsuiteProc->model_file != NULL)
+			S_FREE(crfsuiteProc->model_file);
+
 		crfsuiteProc->model_file = s_path_combine(voice_base_path, path, error);
 		if (S_CHK_ERR(error, S_CONTERR,
 				  "Initialize",
@@ -384,584 +997,164 @@ static void Initialize(SUttProcessor *self, const SVoice *voice, s_erc *error)
 
 }
 
-static crfsuite_instance_t* create_phrase_instance ( SItem* phrase,
-                                                 crfsuite_dictionary_t* attrs,
-                                                 crfsuite_dictionary_t* labels,
-                                                 s_erc *error)
+
+static void *CreateState(const SUttProcessor *self, s_erc *error)
 {
-	crfsuite_instance_t * result = malloc ( sizeof(crfsuite_instance_t) );
-	int i = 0;
-	int L = labels->num(labels);
-	const SItem* itrItem = NULL;
-	const SItem* itrItemNext = NULL;
-	const SItem* finishItem = NULL;
-
-	const char* lbl[] = {"num", "sym", "cap", "p1", "p2", "p3",
-							"s1", "s2", "s3", "P1", "P2", "P3", "P4",
-							"S1", "S2", "S3", "S4", "S5", "S6", "w" };
-
-	const int words_length = 19;
-	const char* words[19] = {			 NULL, NULL, NULL, NULL, NULL,
-										NULL, NULL, NULL, NULL, NULL,
-										NULL, NULL, NULL, NULL, NULL,
-										NULL, NULL, NULL, NULL};
-	int position = 0;
-
-	int lbl_counter = 0;
-	char buffer[8192];
-
-	crfsuite_instance_init ( result );
-
-	itrItemNext = SItemPathToItem (phrase, "daughter.R:Token.parent", error);
-	if (S_CHK_ERR(error, S_CONTERR,
-			  "create_phrase_instance",
-			  "Call to \"SItemPathToItem\" failed"))
-		return NULL;
+	const SCrfSuiteUttProc *crfsuiteProc = (const SCrfSuiteUttProc*)self;
+	s_crfsuite_state *state;
+	s_erc local_err = S_SUCCESS;
+	int i;
 
-	finishItem = SItemPathToItem (phrase, "n.daughter.R:Token.parent", error);
-	if (S_CHK_ERR(error, S_CONTERR,
-			  "create_phrase_instance",
-			  "Call to \"SItemPathToItem\" failed"))
-		return NULL;
 
-	int counter = 0;
+	S_CLR_ERR(error);
 
-	while ( itrItemNext != finishItem && itrItemNext != NULL && counter < 9)
+	state = S_CALLOC(s_crfsuite_state, 1);
+	if (state == NULL)
 	{
-		words[counter] = SItemGetName(itrItemNext, error);
-		if (S_CHK_ERR(error, S_CONTERR,
-				  "create_phrase_instance",
-				  "Call to \"SItemGetName\" failed"))
-			return NULL;
-
-		counter++;
-
-		itrItemNext = SItemNext(itrItemNext, error);
-		if (S_CHK_ERR(error, S_CONTERR,
-				  "create_phrase_instance",
-				  "Call to \"SItemNext\" failed"))
-			return NULL;
-	}
-
-	itrItem = SItemPathToItem (phrase, "daughter.R:Token.parent", error);
-	if (S_CHK_ERR(error, S_CONTERR,
-			  "create_phrase_instance",
-			  "Call to \"SItemPathToItem\" failed"))
+		S_FTL_ERR(error, S_MEMERROR,
+				  "CreateState",
+				  "Failed to allocate memory for 's_crfsuite_state' object");
 		return NULL;
+	}
 
-	while ( itrItem != finishItem && itrItem != NULL)
+	if (crfsuite_create_instance_from_file(crfsuiteProc->model_file,
+										   (void**)&(state->model)) != 0)
 	{
-		/* Extraction of the features for each token */
-		const char *tokenName = SItemGetName (itrItem, error);
-		if (S_CHK_ERR(error, S_CONTERR,
-				  "create_phrase_instance",
-				  "Call to \"SItemGetName\" failed"))
-			return NULL;
-
-        lbl_counter = 0;
-
-		/* Extraction of label's ID */
-		int tokenID = labels->to_id(labels, "UNK");
-		int attribute_id;
-
-		/* If unknown the set the 0 labels (unknown) */
-		if (tokenID < 0)
-			tokenID = L;
-
-		crfsuite_item_t itemToken;
-		crfsuite_attribute_t attribute;
-
-		crfsuite_item_init(&itemToken);
-
-		const char *feat = NULL;
-		s_bool found = FALSE;
-
-
-		/* if token contains numbers */
-		found = hasNumber (tokenName, error);
-		if (S_CHK_ERR(error, S_CONTERR,
-				  "create_phrase_instance",
-				  "Call to \"hasNumber\" failed"))
-			return NULL;
-
-		sprintf(buffer, "%s[%d]=%s", lbl[lbl_counter], 0, found? "Y" : "N");
-		lbl_counter++;
-
-
-		attribute_id = attrs->to_id (attrs,buffer);
-		crfsuite_attribute_set (&attribute, attribute_id, 1.0);
-		crfsuite_item_append_attribute(&itemToken, &attribute);
-
-
-		/* if token contains symbols */
-		found = hasSymbol (tokenName, error);
-		if (S_CHK_ERR(error, S_CONTERR,
-				  "create_phrase_instance",
-				  "Call to \"hasSymbol\" failed"))
-			return NULL;
-
-		sprintf(buffer, "%s[%d]=%s", lbl[lbl_counter], 0, found? "Y" : "N");
-		lbl_counter++;
-
-		attribute_id = attrs->to_id (attrs,buffer);
-		crfsuite_attribute_set (&attribute, attribute_id, 1.0);
-		crfsuite_item_append_attribute(&itemToken, &attribute);
-
-
-		/* if token contains Capitals */
-		found = hasCapital (tokenName, error);
-		if (S_CHK_ERR(error, S_CONTERR,
-				  "create_phrase_instance",
-				  "Call to \"hasCapital\" failed"))
-			return NULL;
-
-		sprintf(buffer, "%s[%d]=%s", lbl[lbl_counter], 0, found? "Y" : "N");
-		lbl_counter++;
-
-		attribute_id = attrs->to_id (attrs,buffer);
-		crfsuite_attribute_set (&attribute, attribute_id, 1.0);
-		crfsuite_item_append_attribute(&itemToken, &attribute);
-
-
-		/* Prefixes of 1 to 3 chars of token */
-		i = 1;
-		while ( i < 4 )
-		{
-			feat = getFirstChars ( tokenName, i, error );
-			if (S_CHK_ERR(error, S_CONTERR,
-					  "create_phrase_instance",
-					  "Call to \"getFirstChars\" failed"))
-				return NULL;
-
-			if ( feat == NULL )
-				feat = "__nil__";
-
-			sprintf(buffer, "%s[%d]=%s", lbl[lbl_counter], 0, feat);
-			lbl_counter++;
-
-			attribute_id = attrs->to_id (attrs,buffer);
-			crfsuite_attribute_set (&attribute, attribute_id, 1.0);
-			crfsuite_item_append_attribute(&itemToken, &attribute);
-
-			i += 1;
-		}
-
-		/* Suffixes of 1 to 3 chars of token */
-		i = 1;
-		while ( i < 4 )
-		{
-			feat = getLastChars ( tokenName, i, error );
-			if (S_CHK_ERR(error, S_CONTERR,
-					  "create_phrase_instance",
-					  "Call to \"getLastChars\" failed"))
-				return NULL;
-
-			if ( feat == NULL )
-				feat = "__nil__";
-
-			sprintf(buffer, "%s[%d]=%s", lbl[lbl_counter], 0, feat);
-			lbl_counter++;
-
-			attribute_id = attrs->to_id (attrs,buffer);
-			crfsuite_attribute_set (&attribute, attribute_id, 1.0);
-			crfsuite_item_append_attribute(&itemToken, &attribute);
-
-			i += 1;
-		}
-
-		/* Prefixes of 1 to 4 chars of token without duplicates adjacent */
-		i = 1;
-		while ( i < 5 )
-		{
-			feat = getFirstChars ( removeDoubles(tokenName, error), i, error );
-			if (S_CHK_ERR(error, S_CONTERR,
-					  "create_phrase_instance",
-					  "Call to \"removeDoubles\" failed"))
-				return NULL;
-			if (S_CHK_ERR(error, S_CONTERR,
-					  "create_phrase_instance",
-					  "Call to \"getFirstChars\" failed"))
-				return NULL;
-
-			if ( feat == NULL )
-				feat = "__nil__";
-
-			sprintf(buffer, "%s[%d]=%s", lbl[lbl_counter], 0, feat);
-			lbl_counter++;
-
-			attribute_id = attrs->to_id (attrs,buffer);
-			crfsuite_attribute_set (&attribute, attribute_id, 1.0);
-			crfsuite_item_append_attribute(&itemToken, &attribute);
-
-			i += 1;
-		}
-
-		/* Suffixes of 1 to 6 chars of token without duplicates adjacent */
-		i = 1;
-		while ( i < 7 )
-		{
-			feat = getLastChars ( removeDoubles(tokenName, error), i, error );
-			if (S_CHK_ERR(error, S_CONTERR,
-					  "create_phrase_instance",
-					  "Call to \"removeDoubles\" failed"))
-				return NULL;
-			if (S_CHK_ERR(error, S_CONTERR,
-					  "create_phrase_instance",
-					  "Call to \"getFirstChars\" failed"))
-				return NULL;
-
-			if ( feat == NULL )
-				feat = "__nil__";
-
-			sprintf(buffer, "%s[%d]=%s", lbl[lbl_counter], 0, feat);
-			lbl_counter++;
-
-			attribute_id = attrs->to_id (attrs,buffer);
-			crfsuite_attribute_set (&attribute, attribute_id, 1.0);
-			crfsuite_item_append_attribute(&itemToken, &attribute);
-
-			i += 1;
-		}
-
-		/* Words features */
-
-		sprintf(buffer, "%s[%d]=%s", lbl[lbl_counter], 0, words[(position+0+words_length)%words_length]);
-
-		attribute_id = attrs->to_id (attrs,buffer);
-		crfsuite_attribute_set (&attribute, attribute_id, 1.0);
-		crfsuite_item_append_attribute(&itemToken, &attribute);
-
-		const char *tmp = words[(position-1+words_length)%words_length];
-		if(tmp!=NULL)
-		{
-			sprintf(buffer, "%s[%d]=%s", lbl[lbl_counter], -1, tmp);
-
-			attribute_id = attrs->to_id (attrs,buffer);
-			crfsuite_attribute_set (&attribute, attribute_id, 1.0);
-			crfsuite_item_append_attribute(&itemToken, &attribute);
-		}
-
-		tmp = words[(position+1+words_length)%words_length];
-		if(tmp!=NULL)
-		{
-			sprintf(buffer, "%s[%d]=%s", lbl[lbl_counter], 1, tmp);
+		S_CTX_ERR(error, S_FAILURE,
+				  "CreateState",
+				  "Failed to load the CRFSuite model \"%s\"",
+				  crfsuiteProc->model_file);
+		goto quit_error;
+	}
 
-			attribute_id = attrs->to_id (attrs,buffer);
-			crfsuite_attribute_set (&attribute, attribute_id, 1.0);
-			crfsuite_item_append_attribute(&itemToken, &attribute);
-		}
+	if ((state->model->get_attrs(state->model, &(state->attrs)) != 0)
+		|| (state->model->get_labels(state->model, &(state->labels)) != 0)
+		|| (state->model->get_tagger(state->model, &(state->tagger)) != 0))
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "CreateState",
+				  "Failed to get the CRFSuite model attributes, labels or tagger");
+		goto quit_error;
+	}
 
-		tmp = words[(position-2+words_length)%words_length];
-		if(tmp!=NULL)
-		{
-			sprintf(buffer, "%s[%d]=%s", lbl[lbl_counter], -2, tmp);
+	for (i = 0; i < 3; i++)
+	{
+		state->class_ids[i][0] = state->attrs->to_id(state->attrs, class_attributes[i][0]);
+		state->class_ids[i][1] = state->attrs->to_id(state->attrs, class_attributes[i][1]);
+	}
 
-			attribute_id = attrs->to_id (attrs,buffer);
-			crfsuite_attribute_set (&attribute, attribute_id, 1.0);
-			crfsuite_item_append_attribute(&itemToken, &attribute);
-		}
+	/* if unknown then set the 0 labels (unknown) */
+	state->unk_label = state->labels->to_id(state->labels, "UNK");
+	if (state->unk_label < 0)
+		state->unk_label = state->labels->num(state->labels);
 
-		tmp = words[(position+2+words_length)%words_length];
-		if(tmp!=NULL)
-		{
-			sprintf(buffer, "%s[%d]=%s", lbl[lbl_counter], 2, tmp);
+	return state;
 
-			attribute_id = attrs->to_id (attrs,buffer);
-			crfsuite_attribute_set (&attribute, attribute_id, 1.0);
-			crfsuite_item_append_attribute(&itemToken, &attribute);
-		}
+	/* error cleanup */
+quit_error:
+	DestroyState(self, state, &local_err);
+	return NULL;
+}
 
-		const char * tmp1 = NULL;
-		i = 0;
-		while ( i < 4 )
-		{
-			tmp = words[(position-2+i+words_length)%words_length];
-			tmp1 = words[(position-1+i+words_length)%words_length];
-			if( tmp!=NULL && tmp1 != NULL )
-			{
-				sprintf(buffer, "%s[%d]|%s[%d]=%s|%s", lbl[lbl_counter], -2+i,
-													   lbl[lbl_counter], -1+i,
-													   tmp, tmp1 );
 
-				attribute_id = attrs->to_id (attrs,buffer);
-				crfsuite_attribute_set (&attribute, attribute_id, 1.0);
-				crfsuite_item_append_attribute(&itemToken, &attribute);
-			}
-			i++;
-		}
+static void DestroyState(const SUttProcessor *self, void *crfsuite_state, s_erc *error)
+{
+	s_crfsuite_state *state = crfsuite_state;
+	int i;
 
-		const char * tmp2 = NULL;
-		i = 0;
-		while ( i < 3 )
-		{
-			tmp = words[(position-2+i+words_length)%words_length];
-			tmp1 = words[(position-1+i+words_length)%words_length];
-			tmp2 = words[(position+0+i+words_length)%words_length];
-			if( tmp!=NULL && tmp1 != NULL && tmp2 != NULL )
-			{
-				sprintf(buffer, "%s[%d]|%s[%d]|%s[%d]=%s|%s|%s",
-													   lbl[lbl_counter], -2+i,
-													   lbl[lbl_counter], -1+i,
-													   lbl[lbl_counter], +0+i,
-													   tmp, tmp1, tmp2 );
-
-				attribute_id = attrs->to_id (attrs,buffer);
-				crfsuite_attribute_set (&attribute, attribute_id, 1.0);
-				crfsuite_item_append_attribute(&itemToken, &attribute);
-			}
-			i++;
-		}
 
-		const char * tmp3 = NULL;
-		i = 0;
-		while ( i < 2 )
-		{
-			tmp  = words[(position-2+i+words_length)%words_length];
-			tmp1 = words[(position-1+i+words_length)%words_length];
-			tmp2 = words[(position+0+i+words_length)%words_length];
-			tmp3 = words[(position+1+i+words_length)%words_length];
-			if( tmp!=NULL && tmp1 != NULL && tmp2 != NULL && tmp3 != NULL )
-			{
-				sprintf(buffer, "%s[%d]|%s[%d]|%s[%d]|%s[%d]=%s|%s|%s|%s",
-													   lbl[lbl_counter], -2+i,
-													   lbl[lbl_counter], -1+i,
-													   lbl[lbl_counter], +0+i,
-													   lbl[lbl_counter], +1+i,
-													   tmp, tmp1, tmp2, tmp3 );
-
-				attribute_id = attrs->to_id (attrs,buffer);
-				crfsuite_attribute_set (&attribute, attribute_id, 1.0);
-				crfsuite_item_append_attribute(&itemToken, &attribute);
-			}
-			i++;
-		}
+	S_CLR_ERR(error);
+	S_UNUSED(self);
 
-		tmp  = words[(position-2+words_length)%words_length];
-		tmp1 = words[(position-1+words_length)%words_length];
-		tmp2 = words[(position+0+words_length)%words_length];
-		tmp3 = words[(position+1+words_length)%words_length];
-		const char * tmp4 = words[(position+2+words_length)%words_length];
-		if( tmp!=NULL && tmp1 != NULL && tmp2 != NULL && tmp3 != NULL && tmp4 != NULL )
-		{
-			sprintf(buffer, "%s[%d]|%s[%d]|%s[%d]|%s[%d]|%s[%d]=%s|%s|%s|%s|%s",
-												   lbl[lbl_counter], -2,
-												   lbl[lbl_counter], -1,
-												   lbl[lbl_counter], +0,
-												   lbl[lbl_counter], +1,
-												   lbl[lbl_counter], +2,
-												   tmp, tmp1, tmp2, tmp3, tmp4 );
-
-			attribute_id = attrs->to_id (attrs,buffer);
-			crfsuite_attribute_set (&attribute, attribute_id, 1.0);
-			crfsuite_item_append_attribute(&itemToken, &attribute);
-		}
+	for (i = 0; i < state->tokens_size; i++)
+		crfsuite_item_finish(&(state->items[i]));
 
-		tmp  = words[(position+0+words_length)%words_length];
+	if (state->tokens != NULL)
+		S_FREE(state->tokens);
 
-		i = 1;
-		while ( i < 10 )
-		{
-			tmp1  = words[(position-i+words_length)%words_length];
-			if ( tmp1 != NULL )
-			{
-				sprintf(buffer, "%s[%d]|%s[%d]=%s|%s", lbl[lbl_counter], 0,
-													   lbl[lbl_counter], 0-i,
-													   tmp, tmp1 );
+	if (state->items != NULL)
+		S_FREE(state->items);
 
-				attribute_id = attrs->to_id (attrs,buffer);
-				crfsuite_attribute_set (&attribute, attribute_id, 1.0);
-				crfsuite_item_append_attribute(&itemToken, &attribute);
-			}
-			i++;
-		}
+	if (state->item_labels != NULL)
+		S_FREE(state->item_labels);
 
-		i = 1;
-		while ( i < 10 )
-		{
-			tmp1  = words[(position+i+words_length)%words_length];
-			if ( tmp1 != NULL )
-			{
-				sprintf(buffer, "%s[%d]|%s[%d]=%s|%s", lbl[lbl_counter], 0,
-													   lbl[lbl_counter], 0+i,
-													   tmp, tmp1 );
+	if (state->output != NULL)
+		S_FREE(state->output);
 
-				attribute_id = attrs->to_id (attrs,buffer);
-				crfsuite_attribute_set (&attribute, attribute_id, 1.0);
-				crfsuite_item_append_attribute(&itemToken, &attribute);
-			}
-			i++;
-		}
+	if (state->phrases != NULL)
+		S_FREE(state->phrases);
 
+	if (state->key != NULL)
+		S_FREE(state->key);
 
+	if (state->tagger != NULL)
+		state->tagger->release(state->tagger);
 
+	if (state->labels != NULL)
+		state->labels->release(state->labels);
 
-		/* Update words array */
-		position++;
-		if ( itrItemNext != NULL )
-		{
-			words[position+9] = SItemGetName (itrItemNext, error);
-			if (S_CHK_ERR(error, S_CONTERR,
-					  "create_phrase_instance",
-					  "Call to \"SItemNext\" failed"))
-				return NULL;
+	if (state->attrs != NULL)
+		state->attrs->release(state->attrs);
 
-			itrItemNext = SItemNext ( itrItemNext, error );
-			if (S_CHK_ERR(error, S_CONTERR,
-					  "create_phrase_instance",
-					  "Call to \"SItemNext\" failed"))
-				return NULL;
-		}
-		else
-			words[position+9] = NULL;
-
-		itrItem = SItemNext ( itrItem, error );
-		if (S_CHK_ERR(error, S_CONTERR,
-				  "create_phrase_instance",
-				  "Call to \"SItemNext\" failed"))
-			return NULL;
-
-		crfsuite_instance_append(result, &itemToken, tokenID);
-		crfsuite_item_finish(&itemToken);
-	}
-
-	return result;
+	if (state->model != NULL)
+		state->model->release(state->model);
 
+	S_FREE(state);
 }
 
 
-static void Run(const SUttProcessor *self, SUtterance *utt,
-		s_erc *error)
+/*
+ * Tag all the phrases of the utterance: the tokens are collected and
+ * their items built in one pass, then the phrases are tagged one after
+ * the other with the tagger of the state.
+ */
+static void RunState(const SUttProcessor *self, void *crfsuite_state, SUtterance *utt,
+					 s_erc *error)
 {
-	SCrfSuiteUttProc *crfsuiteProc = (SCrfSuiteUttProc*)self;
+	s_crfsuite_state *state = crfsuite_state;
+	const char *label;
+	int i;
 
-	crfsuite_model_t * ptr_model = malloc (sizeof(crfsuite_tagger_t));
-	crfsuite_tagger_t * ptr_tagger = malloc (sizeof(crfsuite_tagger_t));
-	crfsuite_dictionary_t * ptr_attrs = malloc (sizeof(crfsuite_dictionary_t));
-	crfsuite_dictionary_t * ptr_labels = malloc (sizeof(crfsuite_dictionary_t));
-	crfsuite_instance_t * instance = malloc (sizeof(crfsuite_instance_t));
-
-	/* Initialize model object */
-	if ( crfsuite_create_instance_from_file( crfsuiteProc->model_file,
-	                                              (void**)&ptr_model
-	                                            ) != 0 ) {
-		goto exit_cleanup;
-	}
 
-	const SRelation* phrase = SUtteranceGetRelation(utt, "Phrase", error);
+	S_CLR_ERR(error);
+	S_UNUSED(self);
+
+	collect_tokens(state, utt, error);
 	if (S_CHK_ERR(error, S_CONTERR,
-			  "Run",
-			  "Call to \"SUtteranceGetRelation\" failed"))
+				  "RunState",
+				  "Call to \"collect_tokens\" failed"))
 		return;
 
-	SItem* itrPhrase = SRelationHead( phrase, error );
+	build_items(state, error);
 	if (S_CHK_ERR(error, S_CONTERR,
-			  "Run",
-			  "Call to \"SRelationHead\" failed"))
+				  "RunState",
+				  "Call to \"build_items\" failed"))
 		return;
 
-	while ( itrPhrase != NULL )
-	{
-		/* Obtain the dictionary interface representing the labels in the model. */
-		if ( ptr_model->get_labels(ptr_model, &ptr_labels) != 0) {
-			goto exit_cleanup;
-		}
-
-		/* Obtain the dictionary interface representing the attributes in the model. */
-		if ( ptr_model->get_attrs(ptr_model, &ptr_attrs) != 0) {
-			goto exit_cleanup;
-		}
-
-		/* Obtain the tagger interface. */
-		if ( ptr_model->get_tagger(ptr_model, &ptr_tagger) != 0) {
-			goto exit_cleanup;
-		}
-
-		instance = create_phrase_instance ( itrPhrase, ptr_attrs, ptr_labels, error );
-		int *output = calloc(sizeof(int), instance->num_items);
-		floatval_t score = 0;
-
-		/* Set the instance to the tagger. */
-		if ( ptr_tagger->set(ptr_tagger, instance) != 0) {
-			goto exit_cleanup;
-		}
-
-		/* Obtain the viterbi label sequence. */
-		if (ptr_tagger->viterbi(ptr_tagger, output, &score) != 0) {
-			goto exit_cleanup;
-		}
-
-		/* Extract the output and insert in the POS attribute */
-
-		const SItem* tokenTMP = SItemPathToItem ( itrPhrase, "daughter.R:Token", error );
-		if (S_CHK_ERR(error, S_CONTERR,
-				  "Run",
-				  "Call to \"SItemPathToItem\" failed"))
-			return;
-
-		SItem* token = SItemParent (tokenTMP, error);
-		if (S_CHK_ERR(error, S_CONTERR,
-				  "Run",
-				  "Call to \"SItemParent\" failed"))
-			return;
-
-		const SItem* lastToken = SItemPathToItem ( itrPhrase, "n.daughter.R:Token.parent", error );
-		if (S_CHK_ERR(error, S_CONTERR,
-				  "Run",
-				  "Call to \"SItemPathToItem\" failed"))
-			return;
-
-		int i = 0;
+	tag_phrases(state, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "RunState",
+				  "Call to \"tag_phrases\" failed"))
+		return;
 
-		while ( token != NULL && token != lastToken )
+	/* Extract the output and insert in the POS attribute */
+	for (i = 0; i < state->num_tokens; i++)
+	{
+		if (state->labels->to_string(state->labels, state->output[i], &label) != 0)
 		{
-			const char * str = malloc (sizeof (char)*16);
-			ptr_labels->to_string (ptr_labels, output[i], &str);
-
-			i += 1;
-
-			SItemSetString (token, "POS", str, error);
-			if (S_CHK_ERR(error, S_CONTERR,
-					  "Run",
-					  "Call to \"SItemSetString\" failed"))
-				return;
-
-			token = SItemNext(token, error);
-			if (S_CHK_ERR(error, S_CONTERR,
-					  "Run",
-					  "Call to \"SItemNext\" failed"))
-				return;
+			S_CTX_ERR(error, S_FAILURE,
+					  "RunState",
+					  "Call to crfsuite labels \"to_string\" failed");
+			return;
 		}
 
-		free(output);
-		crfsuite_instance_finish(instance);
-
-		itrPhrase = SItemNext(itrPhrase, error);
+		SItemSetString(state->tokens[i].item, "POS", label, error);
+		state->labels->free(state->labels, label);
 		if (S_CHK_ERR(error, S_CONTERR,
-				  "Run",
-				  "Call to \"SItemNext\" failed"))
+					  "RunState",
+					  "Call to \"SItemSetString\" failed"))
 			return;
 	}
-
-	/* here all is OK */
-
-	S_UNUSED(utt);
-
-exit_cleanup:
-	if ( ptr_model != NULL )
-		free ( ptr_model );
-
-	if ( ptr_tagger != NULL )
-		free ( ptr_tagger );
-
-	if ( ptr_attrs != NULL )
-		free ( ptr_attrs );
-
-	if ( ptr_labels != NULL )
-		free ( ptr_labels );
-
-	if ( instance != NULL )
-		free ( instance );
-
 }
 
 
@@ -986,6 +1179,9 @@ static SCrfSuiteUttProcClass CrfSuiteUttProcClass =
 		NULL,            /* copy    */
 	},
 	/* SUttProcessorClass */
-	Initialize,          /* initialize */
-	Run                  /* run        */
+	Initialize,          /* initialize    */
+	NULL,                /* run           */
+	CreateState,         /* create_state  */
+	DestroyState,        /* destroy_state */
+	RunState             /* run_state     */
 };
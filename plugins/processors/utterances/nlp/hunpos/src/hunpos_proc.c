@@ -59,6 +59,24 @@
 #define SPCT_DEF_MAX_TOKENS_NUMBER 100
 
 
+/************************************************************************************/
+/*                                                                                  */
+/* Data types                                                                       */
+/*                                                                                  */
+/************************************************************************************/
+
+/*
+ * Per-run state of the hunpos processor. A hunpos tagger keeps its
+ * working memory in the instance, so every concurrent run gets its
+ * own tagger.
+ */
+typedef struct
+{
+	Hunpos       *tagger;  /* hunpos tagger of this state.             */
+	const SItem **data;    /* tokens of a call, max_tokens_number long. */
+} s_hunpos_state;
+
+
 /************************************************************************************/
 /*                                                                                  */
 /* Static variables                                                                 */
@@ -80,6 +98,8 @@ static void load_hunpos_data(const SMap *data, SHunposUttProc *hunposProc,
 
 static void clear_hunpos_data(SHunposUttProc *hunposProc, s_erc *error);
 
+static void DestroyState(const SUttProcessor *self, void *state, s_erc *error);
+
 
 /************************************************************************************/
 /*                                                                                  */
@@ -185,14 +205,6 @@ static void clear_hunpos_data(SHunposUttProc *hunposProc, s_erc *error)
 
 	if (hunposProc->model_file != NULL)
 		S_FREE(hunposProc->model_file);
-
-	if (hunposProc->hunpos_instance != NULL)
-		hunpos_tagger_destroy(hunposProc->hunpos_instance, error);
-	hunposProc->hunpos_instance = NULL;
-	if (S_CHK_ERR(error, S_CONTERR,
-		      "clear_hunpos_data",
-		      "Call to \"hunpos_tagger_destroy\" failed"))
-		return;
 }
 
 
@@ -223,13 +235,14 @@ static void set_tag(void* data, int n, const char * tag, int* error)
  * Prepare the structure for the next call to hunpos.
  * @private
  *
+ * @param tagger hunpos tagger of the per-run state.
  * @param relation_head starting SItem for this new phrase. It must be a Phrase SItem if @p is_phrase_present is true, a Token otherwise.
  * @param data data structure to fill with new SItem pointers.
  * @param is_phrase_present tells if we're using phrases or directly tokens
  * @param error Error code.
  *
  */
-static void call_hunpos(const SHunposUttProc *hunposProc, const SItem* relation_head, const SItem** data, s_bool is_phrase_present, s_erc *error)
+static void call_hunpos(const SHunposUttProc *hunposProc, Hunpos *tagger, const SItem* relation_head, const SItem** data, s_bool is_phrase_present, s_erc *error)
 {
 	const SItem* phrase_start_item;
 	const SItem* current_token;
@@ -332,7 +345,7 @@ static void call_hunpos(const SHunposUttProc *hunposProc, const SItem* relation_
 
 		/* do the tagging */
 		int hunpos_error = 0;
-		hunpos_tagger_tag(hunposProc->hunpos_instance, tokens_count, data, &read_token, data, &set_tag, &hunpos_error);
+		hunpos_tagger_tag(tagger, tokens_count, data, &read_token, data, &set_tag, &hunpos_error);
 		if (hunpos_error !=0)
 		{
 			S_CTX_ERR(error, S_FAILURE,
@@ -364,7 +377,6 @@ static void Init(void *obj, s_erc *error)
 
 	S_CLR_ERR(error);
 	self->model_file = NULL;
-	self->hunpos_instance = NULL;
 }
 
 
@@ -422,45 +434,106 @@ static void Initialize(SUttProcessor *self, const SVoice *voice, s_erc *error)
 		goto quit_error;
 	}
 
+	/* the hunpos taggers are created with the per-run states */
 	load_hunpos_data(hunpos_data, hunposProc, voice_base_path, error);
 	if (S_CHK_ERR(error, S_CONTERR,
 		      "Initialize",
 		      "Call to \"load_hunpos_data\" failed"))
 		goto quit_error;
 
+	/* all OK */
+	S_FREE(voice_base_path);
+	return;
+
+	/* error clean up */
+quit_error:
+	clear_hunpos_data(hunposProc, error);
+	if (voice_base_path != NULL)
+		S_FREE(voice_base_path);
+}
+
 
-	/* create the hunpos instance */
+static void *CreateState(const SUttProcessor *self, s_erc *error)
+{
+	const SHunposUttProc *hunposProc = (const SHunposUttProc*)self;
+	s_hunpos_state *state;
+	s_erc local_err = S_SUCCESS;
 	int hunpos_error = 0;
-	hunposProc->hunpos_instance = hunpos_tagger_new( hunposProc->model_file, NULL, hunposProc->max_guessed_tags, hunposProc->theta, &hunpos_error );
-	if (hunpos_error !=0)
+
+
+	S_CLR_ERR(error);
+
+	state = S_CALLOC(s_hunpos_state, 1);
+	if (state == NULL)
 	{
+		S_FTL_ERR(error, S_MEMERROR,
+			  "CreateState",
+			  "Failed to allocate memory for 's_hunpos_state' object");
+		return NULL;
+	}
+
+	state->data = S_CALLOC(const SItem*, hunposProc->max_tokens_number);
+	if (state->data == NULL)
+	{
+		S_FTL_ERR(error, S_MEMERROR,
+			  "CreateState",
+			  "Failed to allocate memory for 'SItem*' objects");
+		goto quit_error;
+	}
+
+	state->tagger = hunpos_tagger_new(hunposProc->model_file, NULL,
+					  hunposProc->max_guessed_tags,
+					  hunposProc->theta, &hunpos_error);
+	if ((hunpos_error != 0) || (state->tagger == NULL))
+	{
+		state->tagger = NULL;
 		S_CTX_ERR(error, S_FAILURE,
-			  "Initialize",
+			  "CreateState",
 			  "Call to \"hunpos_tagger_new\" failed");
 		goto quit_error;
 	}
 
-	/* all OK */
-	S_FREE(voice_base_path);
-	return;
+	return state;
 
 	/* error clean up */
 quit_error:
-	clear_hunpos_data(hunposProc, error);
-	if (voice_base_path != NULL)
-		S_FREE(voice_base_path);
+	DestroyState(self, state, &local_err);
+	return NULL;
 }
 
 
-static void Run(const SUttProcessor *self, SUtterance *utt,
-		s_erc *error)
+static void DestroyState(const SUttProcessor *self, void *hunpos_state, s_erc *error)
+{
+	s_hunpos_state *state = hunpos_state;
+
+
+	S_CLR_ERR(error);
+	S_UNUSED(self);
+
+	if (state->tagger != NULL)
+	{
+		hunpos_tagger_destroy(state->tagger, error);
+		S_CHK_ERR(error, S_CONTERR,
+			  "DestroyState",
+			  "Call to \"hunpos_tagger_destroy\" failed");
+	}
+
+	if (state->data != NULL)
+		S_FREE(state->data);
+
+	S_FREE(state);
+}
+
+
+static void RunState(const SUttProcessor *self, void *hunpos_state, SUtterance *utt,
+		     s_erc *error)
 {
 	SHunposUttProc *hunposProc = (SHunposUttProc*)self;
+	s_hunpos_state *state = hunpos_state;
 	const SRelation *relation;
 	s_bool is_present;
 	s_bool is_phrase_present;
 	const SItem *current_item;
-	const SItem **data_list;
 
 
 	S_CLR_ERR(error);
@@ -468,14 +541,14 @@ static void Run(const SUttProcessor *self, SUtterance *utt,
 	/* we require the token relation */
 	is_present = SUtteranceRelationIsPresent(utt, "Token", error);
 	if (S_CHK_ERR(error, S_CONTERR,
-		      "Run",
+		      "RunState",
 		      "Call to \"SUtteranceRelationIsPresent\" failed"))
 		return;
 
 	if (!is_present)
 	{
 		S_CTX_ERR(error, S_FAILURE,
-			  "Run",
+			  "RunState",
 			  "Failed to find 'Token' relation in utterance");
 		return;
 	}
@@ -483,7 +556,7 @@ static void Run(const SUttProcessor *self, SUtterance *utt,
 	/* check if phrase relation is present */
 	is_phrase_present = SUtteranceRelationIsPresent(utt, "Phrase", error);
 	if (S_CHK_ERR(error, S_CONTERR,
-		      "Run",
+		      "RunState",
 		      "Call to \"SUtteranceRelationIsPresent\" failed"))
 		return;
 
@@ -491,7 +564,7 @@ static void Run(const SUttProcessor *self, SUtterance *utt,
 	{
 		relation = SUtteranceGetRelation(utt, "Phrase", error);
 		if (S_CHK_ERR(error, S_CONTERR,
-			      "Run",
+			      "RunState",
 			      "Call to \"SUtteranceGetRelation\" failed"))
 			return;
 	}
@@ -499,7 +572,7 @@ static void Run(const SUttProcessor *self, SUtterance *utt,
 	{
 		relation = SUtteranceGetRelation(utt, "Token", error);
 		if (S_CHK_ERR(error, S_CONTERR,
-			      "Run",
+			      "RunState",
 			      "Call to \"SUtteranceGetRelation\" failed"))
 			return;
 	}
@@ -509,17 +582,13 @@ static void Run(const SUttProcessor *self, SUtterance *utt,
 	 */
 	current_item = SRelationHead(relation, error);
 	if (S_CHK_ERR(error, S_CONTERR,
-		      "Run",
+		      "RunState",
 		      "Call to \"SRelationHead\" failed"))
 		return;
 
-	/* alloc the needed structure */
-	data_list = S_MALLOC(SItem*, hunposProc->max_tokens_number);
-
-	/* tag the data */
-	call_hunpos(hunposProc, current_item, data_list, is_phrase_present, error);
-
-	S_FREE(data_list);
+	/* tag the data with the tagger of this run */
+	call_hunpos(hunposProc, state->tagger, current_item, state->data,
+		    is_phrase_present, error);
 
 	/* here all is OK */
 	return;
@@ -547,6 +616,9 @@ static SHunposUttProcClass HunposUttProcClass =
 		NULL,            /* copy    */
 	},
 	/* SUttProcessorClass */
-	Initialize,          /* initialize */
-	Run                  /* run        */
+	Initialize,          /* initialize    */
+	NULL,                /* run           */
+	CreateState,         /* create_state  */
+	DestroyState,        /* destroy_state */
+	RunState             /* run_state     */
 };
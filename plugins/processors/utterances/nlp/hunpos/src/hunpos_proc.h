@@ -98,11 +98,6 @@ typedef struct
 	 * @protected Maximum lenght of token passed in a single call to hunpos.
 	 */
 	int           max_tokens_number;
-
-	/**
-	 * @protected The hunpos instance.
-	 */
-	Hunpos       *hunpos_instance;
 } SHunposUttProc;
 
 
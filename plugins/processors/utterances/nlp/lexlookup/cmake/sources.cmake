@@ -16,6 +16,7 @@
 speect_plugin_sources(
   src/plugin.c
   src/lexlookup_proc.c
+  src/pron_resolver.c
   )
  
 
@@ -23,5 +24,6 @@ speect_plugin_sources(
 
 speect_plugin_headers(
   src/lexlookup_proc.h
+  src/pron_resolver.h
   )
 
@@ -48,6 +48,80 @@
 #include "lexlookup_proc.h"
 #include "hrg/processors/featprocessor.h"
 #include "phoneset.h"
+#include "base/containers/hashtable/hash_table.h"
+#include <string.h>
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Defines                                                                          */
+/*                                                                                  */
+/************************************************************************************/
+
+/* default number of words in the pronunciation memo */
+#define S_LEXLOOKUP_MEMO_SIZE 4096
+
+/* initial size of the pronunciation memo hash table, 2^S_LEXLOOKUP_MEMO_TABLE_SIZE */
+#define S_LEXLOOKUP_MEMO_TABLE_SIZE 10
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Data types                                                                       */
+/*                                                                                  */
+/************************************************************************************/
+
+/* a phone of a memoized pronunciation */
+typedef struct
+{
+	char *name;
+	char *syllablepart;  /* or NULL */
+	char *duration;      /* or NULL */
+} s_memo_phone;
+
+
+/* a syllable of a memoized pronunciation */
+typedef struct
+{
+	char         *stress;  /* or NULL */
+	uint32        num_phones;
+	s_memo_phone *phones;
+} s_memo_syllable;
+
+
+/* a memoized pronunciation */
+typedef struct s_memo_pron s_memo_pron;
+
+struct s_memo_pron
+{
+	char            *word;
+	uint32           num_syllables;
+	s_memo_syllable *syllables;
+	uint32           refs;   /* memo and runs copying it, guarded by memo_mutex. */
+	s_memo_pron     *newer;
+	s_memo_pron     *older;
+};
+
+
+struct s_lexlookup_memo
+{
+	s_hash_table *prons;       /* word -> s_memo_pron. */
+	s_memo_pron  *newest;
+	s_memo_pron  *oldest;
+	uint32        num_prons;
+	uint32        max_prons;
+	uint32        generation;  /* voice data generation of the pronunciations. */
+	S_DECLARE_MUTEX(memo_mutex);
+};
+
+
+/* a word of the current run, and what the memo did for it */
+typedef struct
+{
+	s_bool  memoized;  /* copied from the memo. */
+	char   *word;      /* down-cased word to add to the memo, or NULL. */
+} s_run_word;
+
 
 /************************************************************************************/
 /*                                                                                  */
@@ -68,6 +142,41 @@ static void s_get_lexical_objects(const SUttProcessor *self, SUtterance *utt,
 								  SG2P **g2p, SLexicon **lexicon, SAddendum **addendum,
 								  SSyllabification **syllab, s_erc *error);
 
+static s_lexlookup_memo *memo_new(uint32 max_prons, s_erc *error);
+
+static void memo_delete(s_lexlookup_memo *memo, s_erc *error);
+
+static void lru_unlink(s_lexlookup_memo *memo, s_memo_pron *pron);
+
+static void lru_push(s_lexlookup_memo *memo, s_memo_pron *pron);
+
+static void memo_drop_oldest(s_lexlookup_memo *memo, s_erc *error);
+
+static void memo_sync(s_lexlookup_memo *memo, uint32 generation, s_erc *error);
+
+static s_memo_pron *memo_acquire(s_lexlookup_memo *memo, const char *word, s_erc *error);
+
+static void memo_release(s_lexlookup_memo *memo, s_memo_pron *pron);
+
+static char *item_string(const SItem *item, const char *name, s_erc *error);
+
+static uint32 num_daughters(const SItem *item, s_erc *error);
+
+static void memo_add(s_lexlookup_memo *memo, uint32 generation, const char *word,
+					 const SItem *wordItem, s_erc *error);
+
+static void memo_build(const s_memo_pron *pron, SItem *wordItem, SRelation *syllableRel,
+					   SRelation *sylStructRel, SRelation *segmentRel, s_erc *error);
+
+static void free_pron(s_memo_pron *pron);
+
+static void free_memo_entry(void *key, void *data, s_erc *error);
+
+static void run_words_grow(s_run_word **words, uint32 *size, uint32 needed,
+						   s_erc *error);
+
+static void run_words_free(s_run_word *words, uint32 num_words);
+
 
 /************************************************************************************/
 /*                                                                                  */
@@ -167,6 +276,621 @@ static void s_get_lexical_objects(const SUttProcessor *self, SUtterance *utt,
 }
 
 
+static s_lexlookup_memo *memo_new(uint32 max_prons, s_erc *error)
+{
+	s_lexlookup_memo *memo;
+
+
+	S_CLR_ERR(error);
+
+	memo = S_CALLOC(s_lexlookup_memo, 1);
+	if (memo == NULL)
+	{
+		S_FTL_ERR(error, S_MEMERROR,
+				  "memo_new",
+				  "Failed to allocate memory for 's_lexlookup_memo' object");
+		return NULL;
+	}
+
+	memo->prons = s_hash_table_new(free_memo_entry, S_LEXLOOKUP_MEMO_TABLE_SIZE, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "memo_new",
+				  "Call to \"s_hash_table_new\" failed"))
+	{
+		S_FREE(memo);
+		return NULL;
+	}
+
+	memo->max_prons = max_prons;
+	s_mutex_init(&memo->memo_mutex);
+
+	return memo;
+}
+
+
+static void memo_delete(s_lexlookup_memo *memo, s_erc *error)
+{
+	S_CLR_ERR(error);
+
+	/* releases the pronunciations */
+	s_hash_table_delete(memo->prons, error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "memo_delete",
+			  "Call to \"s_hash_table_delete\" failed");
+
+	s_mutex_destroy(&memo->memo_mutex);
+	S_FREE(memo);
+}
+
+
+static void lru_unlink(s_lexlookup_memo *memo, s_memo_pron *pron)
+{
+	if (pron->newer != NULL)
+		pron->newer->older = pron->older;
+	else
+		memo->newest = pron->older;
+
+	if (pron->older != NULL)
+		pron->older->newer = pron->newer;
+	else
+		memo->oldest = pron->newer;
+
+	pron->newer = NULL;
+	pron->older = NULL;
+}
+
+
+static void lru_push(s_lexlookup_memo *memo, s_memo_pron *pron)
+{
+	pron->newer = NULL;
+	pron->older = memo->newest;
+
+	if (memo->newest != NULL)
+		memo->newest->newer = pron;
+
+	memo->newest = pron;
+
+	if (memo->oldest == NULL)
+		memo->oldest = pron;
+}
+
+
+/* drop the least recently used pronunciation, memo mutex must be locked */
+static void memo_drop_oldest(s_lexlookup_memo *memo, s_erc *error)
+{
+	const s_hash_element *element;
+	s_memo_pron *pron;
+
+
+	S_CLR_ERR(error);
+
+	pron = memo->oldest;
+	lru_unlink(memo, pron);
+	memo->num_prons--;
+
+	element = s_hash_table_find(memo->prons, pron->word, s_strzsize(pron->word, error),
+								error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "memo_drop_oldest",
+				  "Call to \"s_hash_table_find\" failed"))
+		return;
+
+	if (element == NULL)
+		return;
+
+	/* releases the pronunciation */
+	s_hash_element_delete((s_hash_element*)element, error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "memo_drop_oldest",
+			  "Call to \"s_hash_element_delete\" failed");
+}
+
+
+/* empty the memo if the voice data has changed since it was filled */
+static void memo_sync(s_lexlookup_memo *memo, uint32 generation, s_erc *error)
+{
+	S_CLR_ERR(error);
+
+	s_mutex_lock(&memo->memo_mutex);
+	if (memo->generation == generation)
+	{
+		s_mutex_unlock(&memo->memo_mutex);
+		return;
+	}
+
+	while (memo->oldest != NULL)
+	{
+		memo_drop_oldest(memo, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "memo_sync",
+					  "Call to \"memo_drop_oldest\" failed"))
+		{
+			s_mutex_unlock(&memo->memo_mutex);
+			return;
+		}
+	}
+
+	memo->generation = generation;
+	s_mutex_unlock(&memo->memo_mutex);
+}
+
+
+/*
+ * get the memoized pronunciation of the word, or NULL, the
+ * pronunciation must be released with memo_release.
+ */
+static s_memo_pron *memo_acquire(s_lexlookup_memo *memo, const char *word, s_erc *error)
+{
+	const s_hash_element *element;
+	s_memo_pron *pron;
+
+
+	S_CLR_ERR(error);
+
+	s_mutex_lock(&memo->memo_mutex);
+	element = s_hash_table_find(memo->prons, word, s_strzsize(word, error), error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "memo_acquire",
+				  "Call to \"s_hash_table_find\" failed")
+		|| (element == NULL))
+	{
+		s_mutex_unlock(&memo->memo_mutex);
+		return NULL;
+	}
+
+	pron = (s_memo_pron*)s_hash_element_get_data(element, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "memo_acquire",
+				  "Call to \"s_hash_element_get_data\" failed"))
+	{
+		s_mutex_unlock(&memo->memo_mutex);
+		return NULL;
+	}
+
+	lru_unlink(memo, pron);
+	lru_push(memo, pron);
+	pron->refs++;
+	s_mutex_unlock(&memo->memo_mutex);
+
+	return pron;
+}
+
+
+static void memo_release(s_lexlookup_memo *memo, s_memo_pron *pron)
+{
+	s_mutex_lock(&memo->memo_mutex);
+	if (--pron->refs == 0)
+		free_pron(pron);
+	s_mutex_unlock(&memo->memo_mutex);
+
+	S_UNUSED(memo); /* without threads */
+}
+
+
+/* copy of a string feature of the item, or NULL if not present */
+static char *item_string(const SItem *item, const char *name, s_erc *error)
+{
+	const char *value;
+	s_bool is_present;
+
+
+	S_CLR_ERR(error);
+
+	is_present = SItemFeatureIsPresent(item, name, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "item_string",
+				  "Call to \"SItemFeatureIsPresent\" failed"))
+		return NULL;
+
+	if (!is_present)
+		return NULL;
+
+	value = SItemGetString(item, name, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "item_string",
+				  "Call to \"SItemGetString\" failed"))
+		return NULL;
+
+	return s_strdup(value, error);
+}
+
+
+/* count the daughters of the item */
+static uint32 num_daughters(const SItem *item, s_erc *error)
+{
+	const SItem *daughter;
+	uint32 count = 0;
+
+
+	S_CLR_ERR(error);
+
+	daughter = SItemDaughter(item, error);
+	while ((daughter != NULL) && (*error == S_SUCCESS))
+	{
+		count++;
+		daughter = SItemNext(daughter, error);
+	}
+
+	S_CHK_ERR(error, S_CONTERR,
+			  "num_daughters",
+			  "Call to \"SItemDaughter/SItemNext\" failed");
+
+	return count;
+}
+
+
+/*
+ * memoize the pronunciation that has been built for the word, if the
+ * voice data has not changed in the meantime.
+ */
+static void memo_add(s_lexlookup_memo *memo, uint32 generation, const char *word,
+					 const SItem *wordItem, s_erc *error)
+{
+	const s_hash_element *element;
+	const SItem *sylStructWord;
+	const SItem *syllable;
+	const SItem *phone;
+	s_memo_syllable *memoSyl;
+	s_memo_phone *memoPhone;
+	s_memo_pron *pron;
+	uint32 i;
+	uint32 j;
+
+
+	S_CLR_ERR(error);
+
+	sylStructWord = SItemAs(wordItem, "SylStructure", error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "memo_add",
+				  "Call to \"SItemAs\" failed"))
+		return;
+
+	/* word has no pronunciation */
+	if (sylStructWord == NULL)
+		return;
+
+	pron = S_CALLOC(s_memo_pron, 1);
+	if (pron == NULL)
+	{
+		S_FTL_ERR(error, S_MEMERROR,
+				  "memo_add",
+				  "Failed to allocate memory for 's_memo_pron' object");
+		return;
+	}
+
+	pron->refs = 1;
+	pron->word = s_strdup(word, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "memo_add",
+				  "Call to \"s_strdup\" failed"))
+		goto quit_error;
+
+	pron->num_syllables = num_daughters(sylStructWord, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "memo_add",
+				  "Call to \"num_daughters\" failed"))
+		goto quit_error;
+
+	if (pron->num_syllables > 0)
+	{
+		pron->syllables = S_CALLOC(s_memo_syllable, pron->num_syllables);
+		if (pron->syllables == NULL)
+		{
+			S_FTL_ERR(error, S_MEMERROR,
+					  "memo_add",
+					  "Failed to allocate memory for 's_memo_syllable' object");
+			goto quit_error;
+		}
+	}
+
+	syllable = SItemDaughter(sylStructWord, error);
+	for (i = 0; (i < pron->num_syllables) && (*error == S_SUCCESS); i++)
+	{
+		memoSyl = &pron->syllables[i];
+
+		memoSyl->stress = item_string(syllable, "stress", error);
+		if (*error != S_SUCCESS)
+			break;
+
+		memoSyl->num_phones = num_daughters(syllable, error);
+		if (*error != S_SUCCESS)
+			break;
+
+		if (memoSyl->num_phones > 0)
+		{
+			memoSyl->phones = S_CALLOC(s_memo_phone, memoSyl->num_phones);
+			if (memoSyl->phones == NULL)
+			{
+				S_FTL_ERR(error, S_MEMERROR,
+						  "memo_add",
+						  "Failed to allocate memory for 's_memo_phone' object");
+				goto quit_error;
+			}
+		}
+
+		phone = SItemDaughter(syllable, error);
+		for (j = 0; (j < memoSyl->num_phones) && (*error == S_SUCCESS); j++)
+		{
+			memoPhone = &memoSyl->phones[j];
+
+			memoPhone->name = s_strdup(SItemGetName(phone, error), error);
+			if (*error == S_SUCCESS)
+				memoPhone->syllablepart = item_string(phone, "syllablepart", error);
+			if (*error == S_SUCCESS)
+				memoPhone->duration = item_string(phone, "duration", error);
+			if (*error == S_SUCCESS)
+				phone = SItemNext(phone, error);
+		}
+
+		if (*error == S_SUCCESS)
+			syllable = SItemNext(syllable, error);
+	}
+
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "memo_add",
+				  "Failed to copy the pronunciation of word '%s'", word))
+		goto quit_error;
+
+	s_mutex_lock(&memo->memo_mutex);
+
+	/* voice data changed, or another run added it first */
+	if (memo->generation != generation)
+	{
+		s_mutex_unlock(&memo->memo_mutex);
+		goto quit_error;
+	}
+
+	element = s_hash_table_find(memo->prons, pron->word, s_strzsize(pron->word, error),
+								error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "memo_add",
+				  "Call to \"s_hash_table_find\" failed")
+		|| (element != NULL))
+	{
+		s_mutex_unlock(&memo->memo_mutex);
+		goto quit_error;
+	}
+
+	s_hash_table_add(memo->prons, pron->word, s_strzsize(pron->word, error),
+					 pron, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "memo_add",
+				  "Call to \"s_hash_table_add\" failed"))
+	{
+		s_mutex_unlock(&memo->memo_mutex);
+		goto quit_error;
+	}
+
+	lru_push(memo, pron);
+	memo->num_prons++;
+
+	while (memo->num_prons > memo->max_prons)
+	{
+		memo_drop_oldest(memo, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "memo_add",
+					  "Call to \"memo_drop_oldest\" failed"))
+			break;
+	}
+
+	s_mutex_unlock(&memo->memo_mutex);
+	return;
+
+	/* error clean-up code, also discards a pronunciation that is not needed */
+quit_error:
+	free_pron(pron);
+}
+
+
+/* build the syllable structure of the word from the memoized pronunciation */
+static void memo_build(const s_memo_pron *pron, SItem *wordItem, SRelation *syllableRel,
+					   SRelation *sylStructRel, SRelation *segmentRel, s_erc *error)
+{
+	const s_memo_syllable *memoSyl;
+	const s_memo_phone *memoPhone;
+	SItem *sylStructureWordItem;
+	SItem *syllableItem;
+	SItem *sylStructSylItem;
+	SItem *segmentItem;
+	SItem *sylStructSegItem;
+	uint32 i;
+	uint32 j;
+
+
+	S_CLR_ERR(error);
+
+	sylStructureWordItem = SRelationAppend(sylStructRel, wordItem, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "memo_build",
+				  "Call to \"SRelationAppend\" failed"))
+		return;
+
+	for (i = 0; i < pron->num_syllables; i++)
+	{
+		memoSyl = &pron->syllables[i];
+
+		syllableItem = SRelationAppend(syllableRel, NULL, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "memo_build",
+					  "Call to \"SRelationAppend\" failed"))
+			return;
+
+		SItemSetName(syllableItem, "syl", error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "memo_build",
+					  "Call to \"SItemSetName\" failed"))
+			return;
+
+		sylStructSylItem = SItemAddDaughter(sylStructureWordItem, syllableItem, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "memo_build",
+					  "Call to \"SItemAddDaughter\" failed"))
+			return;
+
+		for (j = 0; j < memoSyl->num_phones; j++)
+		{
+			memoPhone = &memoSyl->phones[j];
+
+			segmentItem = SRelationAppend(segmentRel, NULL, error);
+			if (S_CHK_ERR(error, S_CONTERR,
+						  "memo_build",
+						  "Call to \"SRelationAppend\" failed"))
+				return;
+
+			SItemSetName(segmentItem, memoPhone->name, error);
+			if (S_CHK_ERR(error, S_CONTERR,
+						  "memo_build",
+						  "Call to \"SItemSetName\" failed"))
+				return;
+
+			sylStructSegItem = SItemAddDaughter(sylStructSylItem, segmentItem, error);
+			if (S_CHK_ERR(error, S_CONTERR,
+						  "memo_build",
+						  "Call to \"SItemAddDaughter\" failed"))
+				return;
+
+			if (memoPhone->syllablepart != NULL)
+			{
+				SItemSetString(sylStructSegItem, "syllablepart",
+							   memoPhone->syllablepart, error);
+				if (S_CHK_ERR(error, S_CONTERR,
+							  "memo_build",
+							  "Call to \"SItemSetString\" failed"))
+					return;
+			}
+
+			if (memoPhone->duration != NULL)
+			{
+				SItemSetString(sylStructSegItem, "duration", memoPhone->duration, error);
+				if (S_CHK_ERR(error, S_CONTERR,
+							  "memo_build",
+							  "Call to \"SItemSetString\" failed"))
+					return;
+			}
+		}
+
+		/* set after the phones, as s_compute_stresses does */
+		if (memoSyl->stress != NULL)
+		{
+			SItemSetString(sylStructSylItem, "stress", memoSyl->stress, error);
+			if (S_CHK_ERR(error, S_CONTERR,
+						  "memo_build",
+						  "Call to \"SItemSetString\" failed"))
+				return;
+		}
+	}
+}
+
+
+static void free_pron(s_memo_pron *pron)
+{
+	s_memo_syllable *memoSyl;
+	uint32 i;
+	uint32 j;
+
+
+	if (pron->syllables != NULL)
+	{
+		for (i = 0; i < pron->num_syllables; i++)
+		{
+			memoSyl = &pron->syllables[i];
+
+			if (memoSyl->phones != NULL)
+			{
+				for (j = 0; j < memoSyl->num_phones; j++)
+				{
+					if (memoSyl->phones[j].name != NULL)
+						S_FREE(memoSyl->phones[j].name);
+
+					if (memoSyl->phones[j].syllablepart != NULL)
+						S_FREE(memoSyl->phones[j].syllablepart);
+
+					if (memoSyl->phones[j].duration != NULL)
+						S_FREE(memoSyl->phones[j].duration);
+				}
+
+				S_FREE(memoSyl->phones);
+			}
+
+			if (memoSyl->stress != NULL)
+				S_FREE(memoSyl->stress);
+		}
+
+		S_FREE(pron->syllables);
+	}
+
+	if (pron->word != NULL)
+		S_FREE(pron->word);
+
+	S_FREE(pron);
+}
+
+
+/* hash table free function of the memo, the key is the word of the pronunciation */
+static void free_memo_entry(void *key, void *data, s_erc *error)
+{
+	s_memo_pron *pron = data;
+
+
+	S_CLR_ERR(error);
+	S_UNUSED(key);
+
+	if ((pron != NULL) && (--pron->refs == 0))
+		free_pron(pron);
+}
+
+
+static void run_words_grow(s_run_word **words, uint32 *size, uint32 needed,
+						   s_erc *error)
+{
+	s_run_word *tmp;
+	uint32 new_size;
+
+
+	S_CLR_ERR(error);
+
+	if (needed <= *size)
+		return;
+
+	new_size = (*size == 0) ? 32 : (*size * 2);
+	tmp = S_MALLOC(s_run_word, new_size);
+	if (tmp == NULL)
+	{
+		S_FTL_ERR(error, S_MEMERROR,
+				  "run_words_grow",
+				  "Failed to allocate memory for 's_run_word' object");
+		return;
+	}
+
+	if (*words != NULL)
+	{
+		memcpy(tmp, *words, sizeof(s_run_word) * (*size));
+		S_FREE(*words);
+	}
+
+	*words = tmp;
+	*size = new_size;
+}
+
+
+static void run_words_free(s_run_word *words, uint32 num_words)
+{
+	uint32 i;
+
+
+	if (words == NULL)
+		return;
+
+	for (i = 0; i < num_words; i++)
+	{
+		if (words[i].word != NULL)
+			S_FREE(words[i].word);
+	}
+
+	S_FREE(words);
+}
+
+
 /************************************************************************************/
 /*                                                                                  */
 /* Static class function implementations                                            */
@@ -177,12 +901,33 @@ static void s_get_lexical_objects(const SUttProcessor *self, SUtterance *utt,
 static void Destroy(void *obj, s_erc *error)
 {
 	SUttProcessor *self = obj;
+	SLexLookupUttProc *lexlookup = obj;
 	const SObject *tmp;
 	SPlugin *sylPlugin;
 
 
 	S_CLR_ERR(error);
 
+	if (lexlookup->memo != NULL)
+	{
+		memo_delete(lexlookup->memo, error);
+		lexlookup->memo = NULL;
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "Destroy",
+					  "Call to \"memo_delete\" failed"))
+			return;
+	}
+
+	if (lexlookup->resolver != NULL)
+	{
+		s_pron_resolver_delete(lexlookup->resolver, error);
+		lexlookup->resolver = NULL;
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "Destroy",
+					  "Call to \"s_pron_resolver_delete\" failed"))
+			return;
+	}
+
 	/* check if a syllabification plug-in is defined as a feature */
 	tmp = SMapGetObjectDef(self->features, "_syll_func_plugin", NULL, error);
 	if (S_CHK_ERR(error, S_CONTERR,
@@ -315,11 +1060,45 @@ s_compute_stresses_cleanup:
 
 }
 
+/*
+ * query a phone feature, with the phone and feature identifiers if
+ * the phoneset numbers its phones (numbered), else by name.
+ */
+static s_bool s_phone_has_feature(const SPhoneset *phoneset, s_bool numbered,
+								  const char *phone, sint32 phone_id,
+								  const char *feature, sint32 feature_id,
+								  s_erc *error)
+{
+	s_bool has_feature;
+
+
+	S_CLR_ERR(error);
+
+	if (numbered)
+		has_feature = S_PHONESET_CALL(phoneset, phone_id_has_feature)(phoneset, phone_id,
+																	   feature_id, error);
+	else
+		has_feature = S_PHONESET_CALL(phoneset, phone_has_feature)(phoneset, phone,
+																	feature, error);
+
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "s_phone_has_feature",
+				  "Call to \"phone_has_feature\" failed"))
+		return FALSE;
+
+	return has_feature;
+}
+
+
 static void s_compute_phonetic_features (SItem* word, s_erc *error )
 {
 	SItem *syllable;
 	SItem * phone;
 	char* position_in_syllable_string = NULL;
+	s_bool numbered;
+	sint32 vowel_id = -1;
+	sint32 long_id = -1;
+	sint32 short_id = -1;
 
 	/* Extract Phoneset from Voice*/
 	const SVoice* voice = SItemVoice (word, error);
@@ -333,6 +1112,24 @@ static void s_compute_phonetic_features (SItem* word, s_erc *error )
 				  "s_compute_phonetic_features",
 				  "Call to \"SVoiceGetData\" failed"))
 		return;
+
+	/* look the features up once, and each phone once */
+	numbered = ((S_PHONESET_METH_VALID(phoneset, get_phone_id))
+				&& (S_PHONESET_METH_VALID(phoneset, get_feature_id))
+				&& (S_PHONESET_METH_VALID(phoneset, phone_id_has_feature)));
+	if (numbered)
+	{
+		vowel_id = S_PHONESET_CALL(phoneset, get_feature_id)(phoneset, "vowel", error);
+		if (!*error)
+			long_id = S_PHONESET_CALL(phoneset, get_feature_id)(phoneset, "duration_long", error);
+		if (!*error)
+			short_id = S_PHONESET_CALL(phoneset, get_feature_id)(phoneset, "duration_short", error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "s_compute_phonetic_features",
+					  "Call to \"get_feature_id\" failed"))
+			return;
+	}
+
 	SItem *wordAsSylStructure = SItemAs(word, "SylStructure", error);
 	if (S_CHK_ERR(error, S_CONTERR,
 		      "s_compute_stresses",
@@ -361,14 +1158,21 @@ static void s_compute_phonetic_features (SItem* word, s_erc *error )
 				      "s_compute_phonetic_features",
 				      "Call to \"SItemGetName\" failed"))
 				return;
-			s_bool isVowel = S_PHONESET_CALL(phoneset, phone_has_feature)
-				(phoneset,
-				 phone_value,
-				 "vowel",
-				 error);
+			sint32 phone_id = -1;
+			if (numbered)
+			{
+				phone_id = S_PHONESET_CALL(phoneset, get_phone_id)(phoneset, phone_value, error);
+				if (S_CHK_ERR(error, S_CONTERR,
+					      "s_compute_phonetic_features",
+					      "Call to \"get_phone_id\" failed"))
+					return;
+			}
+
+			s_bool isVowel = s_phone_has_feature(phoneset, numbered, phone_value, phone_id,
+							     "vowel", vowel_id, error);
 			if (S_CHK_ERR(error, S_CONTERR,
 				      "s_compute_phonetic_features",
-				      "Call to \"phone_has_feature\" failed"))
+				      "Call to \"s_phone_has_feature\" failed"))
 				return;
 
 			if( isVowel )
@@ -390,24 +1194,18 @@ static void s_compute_phonetic_features (SItem* word, s_erc *error )
 						  "Call to \"SItemSetString\" failed"))
 				return;
 
-			s_bool hasLong = S_PHONESET_CALL(phoneset, phone_has_feature)
-				(phoneset,
-				 phone_value,
-				 "duration_long",
-				 error);
+			s_bool hasLong = s_phone_has_feature(phoneset, numbered, phone_value, phone_id,
+							     "duration_long", long_id, error);
 			if (S_CHK_ERR(error, S_CONTERR,
 				      "s_compute_phonetic_features",
-				      "Call to \"phone_has_feature\" failed"))
+				      "Call to \"s_phone_has_feature\" failed"))
 				return;
 
-			s_bool hasShort = S_PHONESET_CALL(phoneset, phone_has_feature)
-				(phoneset,
-				 phone_value,
-				 "duration_short",
-				 error);
+			s_bool hasShort = s_phone_has_feature(phoneset, numbered, phone_value, phone_id,
+							     "duration_short", short_id, error);
 			if (S_CHK_ERR(error, S_CONTERR,
 				      "s_compute_phonetic_features",
-				      "Call to \"phone_has_feature\" failed"))
+				      "Call to \"s_phone_has_feature\" failed"))
 				return;
 
 			const char * feat = NULL;
@@ -448,6 +1246,9 @@ static void s_compute_phonetic_features (SItem* word, s_erc *error )
 
 static void Initialize(SUttProcessor *self, const SVoice *voice, s_erc *error)
 {
+	SLexLookupUttProc *lexlookup = (SLexLookupUttProc*)self;
+	sint32 memo_size;
+	sint32 use_resolver;
 	const SObject *tmp;
 	const SMap *syllInfo;
 	const char *plugin_name;
@@ -460,6 +1261,59 @@ static void Initialize(SUttProcessor *self, const SVoice *voice, s_erc *error)
 
 	S_CLR_ERR(error);
 
+	/* the pronunciation memo */
+	memo_size = SMapGetIntDef(self->features, "pronunciation memo size",
+							  S_LEXLOOKUP_MEMO_SIZE, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "Initialize",
+				  "Call to \"SMapGetIntDef\" failed"))
+		return;
+
+	if (lexlookup->memo != NULL)
+	{
+		memo_delete(lexlookup->memo, error);
+		lexlookup->memo = NULL;
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "Initialize",
+					  "Call to \"memo_delete\" failed"))
+			return;
+	}
+
+	if (memo_size > 0)
+	{
+		lexlookup->memo = memo_new((uint32)memo_size, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "Initialize",
+					  "Call to \"memo_new\" failed"))
+			return;
+	}
+
+	/* the pronunciation resolver */
+	use_resolver = SMapGetIntDef(self->features, "pronunciation resolver", 0, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "Initialize",
+				  "Call to \"SMapGetIntDef\" failed"))
+		return;
+
+	if (lexlookup->resolver != NULL)
+	{
+		s_pron_resolver_delete(lexlookup->resolver, error);
+		lexlookup->resolver = NULL;
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "Initialize",
+					  "Call to \"s_pron_resolver_delete\" failed"))
+			return;
+	}
+
+	if (use_resolver != 0)
+	{
+		lexlookup->resolver = s_pron_resolver_new(error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "Initialize",
+					  "Call to \"s_pron_resolver_new\" failed"))
+			return;
+	}
+
 	/* check if a syllabification function is defined as a feature,
 	 * and if so, create the syllabification object */
 	tmp = SMapGetObjectDef(self->features, "syllabification function", NULL, error);
@@ -620,8 +1474,10 @@ static void Run(const SUttProcessor *self, SUtterance *utt,
 	SItem *wordItemcopy;
 	char *downcase_word;
 	SList *phones;
+	const SList *wordInfo;
 	s_bool syllabified;
 	SList *syllablesPhones;
+	s_bool own_syllables;
 	SItem *sylStructureWordItem;
 	SItem *syllableItem;
 	SItem *sylStructSylItem;
@@ -630,15 +1486,61 @@ static void Run(const SUttProcessor *self, SUtterance *utt,
 	SIterator *phoneItr = NULL;
 	const SObject *phone;
 	s_bool is_present;
+	s_lexlookup_memo *memo;
+	s_pron_resolver *resolver;
+	s_pron_index *index = NULL;
+	s_memo_pron *pron;
+	s_run_word *words = NULL;
+	s_run_word *runWord = NULL;
+	uint32 num_words = 0;
+	uint32 words_size = 0;
+	uint32 word_index;
+	uint32 generation = 0;
 
 
 	S_CLR_ERR(error);
+
+	/*
+	 * get the data generation before the lexical objects, so that
+	 * pronunciations of replaced objects are never memoized as
+	 * current.
+	 */
+	memo = ((const SLexLookupUttProc*)self)->memo;
+	resolver = ((const SLexLookupUttProc*)self)->resolver;
+	if ((memo != NULL) || (resolver != NULL))
+	{
+		generation = SVoiceGetDataGeneration(SUtteranceVoice(utt, error), error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "Run",
+					  "Call to \"SVoiceGetDataGeneration\" failed"))
+			goto quit_error;
+	}
+
+	if (memo != NULL)
+	{
+		memo_sync(memo, generation, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "Run",
+					  "Call to \"memo_sync\" failed"))
+			goto quit_error;
+	}
+
 	s_get_lexical_objects(self, utt, &g2p, &lexicon, &addendum, &syllab, error);
 	if (S_CHK_ERR(error, S_CONTERR,
 				  "Run",
 				  "Call to \"s_get_lexical_objects\" failed"))
 		goto quit_error;
 
+	if (resolver != NULL)
+	{
+		index = s_pron_resolver_acquire(resolver, generation, addendum, lexicon, g2p,
+										error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "Run",
+					  "Call to \"s_pron_resolver_acquire\" failed"))
+			goto quit_error;
+	}
+
 	/* we require the word relation */
 	is_present = SUtteranceRelationIsPresent(utt, "Word", error);
 	if (S_CHK_ERR(error, S_CONTERR,
@@ -698,6 +1600,20 @@ static void Run(const SUttProcessor *self, SUtterance *utt,
 
 	while (wordItem != NULL)
 	{
+		/* keep track of the words for the memo */
+		if (memo != NULL)
+		{
+			run_words_grow(&words, &words_size, num_words + 1, error);
+			if (S_CHK_ERR(error, S_CONTERR,
+						  "Run",
+						  "Call to \"run_words_grow\" failed"))
+				goto quit_error;
+
+			runWord = &words[num_words++];
+			runWord->memoized = FALSE;
+			runWord->word = NULL;
+		}
+
 		/* get word and downcase it */
 		downcase_word = s_strlwr(s_strdup(SItemGetName(wordItem, error), error), error);
 		if (S_CHK_ERR(error, S_CONTERR,
@@ -708,74 +1624,136 @@ static void Run(const SUttProcessor *self, SUtterance *utt,
 		if  (downcase_word == NULL || s_strcmp(downcase_word, "", error) == 0)
 			goto continue_cycle;
 
-		phones = NULL;
-		syllabified = FALSE;
-
-		/* get phone sequence for word */
-		if (addendum != NULL)
+		/* memoized pronunciation */
+		if (memo != NULL)
 		{
-			phones = S_ADDENDUM_CALL(addendum, get_word)(addendum,
-														 downcase_word,
-														 NULL,
-														 &syllabified,
-														 error);
+			pron = memo_acquire(memo, downcase_word, error);
 			if (S_CHK_ERR(error, S_CONTERR,
 						  "Run",
-						  "Call to method \"get_word\" (SAddendum) failed"))
+						  "Call to \"memo_acquire\" failed"))
+			{
+				S_FREE(downcase_word);
 				goto quit_error;
+			}
+
+			if (pron != NULL)
+			{
+				S_FREE(downcase_word);
+				memo_build(pron, wordItem, syllableRel, sylStructRel, segmentRel, error);
+				memo_release(memo, pron);
+				if (S_CHK_ERR(error, S_CONTERR,
+							  "Run",
+							  "Call to \"memo_build\" failed"))
+					goto quit_error;
+
+				runWord->memoized = TRUE;
+				goto continue_cycle;
+			}
 		}
 
-		if ((phones == NULL) && (lexicon != NULL))
+		phones = NULL;
+		wordInfo = NULL;
+		syllabified = FALSE;
+
+		/* get phone sequence for word */
+		if (index != NULL)
 		{
-			phones = S_LEXICON_CALL(lexicon, get_word)(lexicon,
-													   downcase_word,
-													   NULL,
-													   &syllabified,
-													   error);
+			/* one probe, the pronunciation is borrowed unless phones is set */
+			wordInfo = s_pron_index_get_word(index, downcase_word, &syllabified,
+											 &phones, error);
 			if (S_CHK_ERR(error, S_CONTERR,
 						  "Run",
-						  "Call to method \"get_word\" (SLexicon) failed"))
+						  "Call to \"s_pron_index_get_word\" failed"))
+			{
+				S_FREE(downcase_word);
 				goto quit_error;
+			}
 		}
-
-		if ((phones == NULL) && (g2p != NULL))
+		else
 		{
-			phones = S_G2P_CALL(g2p, apply)(g2p, downcase_word, error);
-			if (S_CHK_ERR(error, S_CONTERR,
-						  "Run",
-						  "Call to method \"apply\" (SG2P) failed"))
-				goto quit_error;
+			if (addendum != NULL)
+			{
+				phones = S_ADDENDUM_CALL(addendum, get_word)(addendum,
+															 downcase_word,
+															 NULL,
+															 &syllabified,
+															 error);
+				if (S_CHK_ERR(error, S_CONTERR,
+							  "Run",
+							  "Call to method \"get_word\" (SAddendum) failed"))
+					goto quit_error;
+			}
+
+			if ((phones == NULL) && (lexicon != NULL))
+			{
+				phones = S_LEXICON_CALL(lexicon, get_word)(lexicon,
+														   downcase_word,
+														   NULL,
+														   &syllabified,
+														   error);
+				if (S_CHK_ERR(error, S_CONTERR,
+							  "Run",
+							  "Call to method \"get_word\" (SLexicon) failed"))
+					goto quit_error;
+			}
+
+			if ((phones == NULL) && (g2p != NULL))
+			{
+				phones = S_G2P_CALL(g2p, apply)(g2p, downcase_word, error);
+				if (S_CHK_ERR(error, S_CONTERR,
+							  "Run",
+							  "Call to method \"apply\" (SG2P) failed"))
+					goto quit_error;
+			}
+
+			wordInfo = phones;
 		}
 
-		if (phones == NULL)
+		if (wordInfo == NULL)
 		{
 			S_CTX_ERR(error, S_FAILURE,
 					  "Run",
 					  "Failed to get phone sequence for word '%s'", downcase_word);
 			S_FREE(downcase_word);
-			continue;
+			goto quit_error;
 		}
 
-		S_FREE(downcase_word);
+		/* the memo gets the word once the pronunciation is complete */
+		if (memo != NULL)
+			runWord->word = downcase_word;
+		else
+			S_FREE(downcase_word);
 
 		/* syllabify phone sequence */
+		own_syllables = TRUE;
 		if (syllabified == FALSE)
 		{
 			if (syllab != NULL)
 			{
 				syllablesPhones = S_SYLLABIFICATION_CALL(syllab, syllabify)(syllab,
 																			wordItem,
-																			phones,
+																			wordInfo,
 																			error);
 				if (S_CHK_ERR(error, S_CONTERR,
 							  "Run",
 							  "Call to method \"syllabify\" failed"))
 					goto quit_error;
 
-				S_DELETE(phones, "Run", error);
+				if (phones != NULL)
+					S_DELETE(phones, "Run", error);
 			}
 			else
 			{
+				/* the syllable list takes hold of the phones */
+				if (phones == NULL)
+				{
+					phones = SListCopy(NULL, wordInfo, error);
+					if (S_CHK_ERR(error, S_CONTERR,
+								  "Run",
+								  "Call to \"SListCopy\" failed"))
+						goto quit_error;
+				}
+
 				syllablesPhones = S_LIST(S_NEW(SListList, error));
 				if (S_CHK_ERR(error, S_CONTERR,
 							  "Run",
@@ -790,7 +1768,11 @@ static void Run(const SUttProcessor *self, SUtterance *utt,
 			}
 		}
 		else
-			syllablesPhones = (SList*)phones;
+		{
+			/* borrowed syllables are only read */
+			syllablesPhones = (SList*)wordInfo;
+			own_syllables = (phones != NULL);
+		}
 
 		/* create new syllable structure word item, shares content
 		 * with word item.
@@ -870,7 +1852,8 @@ static void Run(const SUttProcessor *self, SUtterance *utt,
 			sylItr = SIteratorNext(sylItr);
 		}
 
-		S_DELETE(syllablesPhones, "Run", error);
+		if (own_syllables)
+			S_DELETE(syllablesPhones, "Run", error);
 continue_cycle:
 		wordItem = SItemNext(wordItem, error);
 		if (S_CHK_ERR(error, S_CONTERR,
@@ -900,8 +1883,14 @@ continue_cycle:
 			goto quit_error;
 	}
 
+	word_index = 0;
 	while (wordItem != NULL)
 	{
+		runWord = (word_index < num_words) ? &words[word_index++] : NULL;
+
+		/* memoized pronunciations are complete */
+		if ((runWord != NULL) && runWord->memoized)
+			goto next_word;
 
 		if(stress_featproc) {
 			s_compute_stresses(stress_featproc, wordItem, error);
@@ -917,6 +1906,16 @@ continue_cycle:
 					  "Call to \"s_compute_phonetic_features\" failed"))
 			goto quit_error;
 
+		if ((runWord != NULL) && (runWord->word != NULL))
+		{
+			memo_add(memo, generation, runWord->word, wordItem, error);
+			if (S_CHK_ERR(error, S_CONTERR,
+						  "Run",
+						  "Call to \"memo_add\" failed"))
+				goto quit_error;
+		}
+
+next_word:
 		wordItem = SItemNext(wordItem, error);
 		if (S_CHK_ERR(error, S_CONTERR,
 					  "Run",
@@ -925,6 +1924,10 @@ continue_cycle:
 	}
 
 	/* here all is OK */
+	if (index != NULL)
+		s_pron_resolver_release(resolver, index);
+
+	run_words_free(words, num_words);
 	return;
 
 
@@ -960,6 +1963,10 @@ quit_error:
 	if (phoneItr != NULL)
 		S_DELETE(phoneItr, "Run", error);
 
+	if (index != NULL)
+		s_pron_resolver_release(resolver, index);
+
+	run_words_free(words, num_words);
 	self = NULL;
 }
 
@@ -985,6 +1992,9 @@ static SLexLookupUttProcClass LexLookupUttProcClass =
 		NULL,            /* copy    */
 	},
 	/* SUttProcessorClass */
-	Initialize,          /* initialize */
-	Run                  /* run        */
+	Initialize,          /* initialize    */
+	Run,                 /* run           */
+	NULL,                /* create_state  */
+	NULL,                /* destroy_state */
+	NULL                 /* run_state     */
 };
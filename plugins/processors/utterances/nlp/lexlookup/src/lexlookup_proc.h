@@ -75,6 +75,23 @@
  *
  * If this processor fails then it will delete the relation and all
  * the created items.
+ *
+ * The pronunciation of every word (syllables, phones, stress and the
+ * phonetic features of the phones) is memoized, per voice, on the
+ * down-cased word, and copied into later utterances instead of
+ * being looked up, syllabified and stressed again. The memo holds at
+ * most "pronunciation memo size" (#SInt feature of the processor,
+ * default 4096) words, the least recently used words are dropped
+ * first, a size of 0 disables it. The memo is emptied when the data
+ * objects of the voice change (see #SVoiceGetDataGeneration). The
+ * syllabification and stress functions must therefore only depend on
+ * the phones of the word.
+ *
+ * If the "pronunciation resolver" #SInt feature of the processor is
+ * not 0 (default 0), the words are looked up with a
+ * @ref SLexLookupPronResolver, one probe of an index of the addendum
+ * and lexicon words instead of a lookup in the addendum and then in
+ * the lexicon, without copying their pronunciations.
  * @{
  */
 
@@ -86,6 +103,7 @@
 /************************************************************************************/
 
 #include "speect.h"
+#include "pron_resolver.h"
 
 
 /************************************************************************************/
@@ -103,10 +121,32 @@ S_BEGIN_C_DECLS
 /************************************************************************************/
 
 /**
- * Typedef of the LexLookup utterance processor. Does not add any
- * new members, therefore exactly the same as #SUttProcessor.
+ * Opaque memo of word pronunciations.
+ */
+typedef struct s_lexlookup_memo s_lexlookup_memo;
+
+
+/**
+ * The SLexLookupUttProc structure.
+ * @extends SUttProcessor
  */
-typedef SUttProcessor SLexLookupUttProc;
+typedef struct
+{
+	/**
+	 * @protected Inherit from #SUttProcessor.
+	 */
+	SUttProcessor     obj;
+
+	/**
+	 * @protected Memo of word pronunciations, #NULL if disabled.
+	 */
+	s_lexlookup_memo *memo;
+
+	/**
+	 * @protected Pronunciation resolver, #NULL if disabled.
+	 */
+	s_pron_resolver  *resolver;
+} SLexLookupUttProc;
 
 
 /**
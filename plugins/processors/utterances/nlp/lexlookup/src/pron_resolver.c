@@ -0,0 +1,467 @@
+/************************************************************************************/
+/* Copyright (c) 2009-2011 The Department of Arts and Culture,                      */
+/* The Government of the Republic of South Africa.                                  */
+/*                                                                                  */
+/* Contributors:  Meraka Institute, CSIR, South Africa.                             */
+/*                                                                                  */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy     */
+/* of this software and associated documentation files (the "Software"), to deal    */
+/* in the Software without restriction, including without limitation the rights     */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        */
+/* copies of the Software, and to permit persons to whom the Software is            */
+/* furnished to do so, subject to the following conditions:                         */
+/* The above copyright notice and this permission notice shall be included in       */
+/* all copies or substantial portions of the Software.                              */
+/*                                                                                  */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN        */
+/* THE SOFTWARE.                                                                    */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* AUTHOR  : Speect contributors                                                    */
+/* DATE    : 19 October 2026                                                        */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* A pronunciation resolver, one index of the addendum and lexicon words.           */
+/*                                                                                  */
+/*                                                                                  */
+/************************************************************************************/
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Modules used                                                                     */
+/*                                                                                  */
+/************************************************************************************/
+
+#include "pron_resolver.h"
+#include "base/containers/hashtable/hash_table.h"
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Defines                                                                          */
+/*                                                                                  */
+/************************************************************************************/
+
+/* initial size of the index hash table, 2^S_PRON_INDEX_TABLE_SIZE */
+#define S_PRON_INDEX_TABLE_SIZE 10
+
+/* number of entries in a block of index entries */
+#define S_PRON_BLOCK_SIZE 1024
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Data types                                                                       */
+/*                                                                                  */
+/************************************************************************************/
+
+/* a word of the index, the pronunciation belongs to the addendum or lexicon */
+typedef struct
+{
+	const SList *info;
+	s_bool       syllabified;
+} s_pron_entry;
+
+
+/* the entries are allocated in blocks, they never move */
+typedef struct s_pron_block s_pron_block;
+
+struct s_pron_block
+{
+	s_pron_block *next;
+	uint32        num_entries;
+	s_pron_entry  entries[S_PRON_BLOCK_SIZE];
+};
+
+
+struct s_pron_index
+{
+	s_hash_table    *words;      /* word -> s_pron_entry, keys belong to the data objects. */
+	s_pron_block    *blocks;
+	const SAddendum *addendum;
+	const SLexicon  *lexicon;
+	const SG2P      *g2p;
+	s_bool           addendum_indexed;  /* else probed before the index. */
+	s_bool           lexicon_indexed;   /* else probed after the index. */
+	uint32           generation;
+	uint32           refs;       /* resolver and runs using it, guarded by resolver_mutex. */
+};
+
+
+struct s_pron_resolver
+{
+	s_pron_index *current;
+	S_DECLARE_MUTEX(resolver_mutex);
+};
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static function prototypes                                                       */
+/*                                                                                  */
+/************************************************************************************/
+
+static void index_add_word(const char *word, const SList *info, s_bool syllabified,
+						   void *userdata, s_erc *error);
+
+static void index_add_lexicon_word(const char *word, const SList *info,
+								   s_bool syllabified, void *userdata, s_erc *error);
+
+static s_pron_index *index_new(uint32 generation, const SAddendum *addendum,
+							   const SLexicon *lexicon, const SG2P *g2p, s_erc *error);
+
+static void index_free(s_pron_index *index);
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Function implementations                                                         */
+/*                                                                                  */
+/************************************************************************************/
+
+S_LOCAL s_pron_resolver *s_pron_resolver_new(s_erc *error)
+{
+	s_pron_resolver *self;
+
+
+	S_CLR_ERR(error);
+
+	self = S_CALLOC(s_pron_resolver, 1);
+	if (self == NULL)
+	{
+		S_FTL_ERR(error, S_MEMERROR,
+				  "s_pron_resolver_new",
+				  "Failed to allocate memory for 's_pron_resolver' object");
+		return NULL;
+	}
+
+	s_mutex_init(&self->resolver_mutex);
+
+	return self;
+}
+
+
+S_LOCAL void s_pron_resolver_delete(s_pron_resolver *self, s_erc *error)
+{
+	S_CLR_ERR(error);
+
+	if (self == NULL)
+		return;
+
+	if ((self->current != NULL) && (--self->current->refs == 0))
+		index_free(self->current);
+
+	s_mutex_destroy(&self->resolver_mutex);
+	S_FREE(self);
+}
+
+
+S_LOCAL s_pron_index *s_pron_resolver_acquire(s_pron_resolver *self, uint32 generation,
+											  const SAddendum *addendum,
+											  const SLexicon *lexicon,
+											  const SG2P *g2p, s_erc *error)
+{
+	s_pron_index *index;
+
+
+	S_CLR_ERR(error);
+
+	s_mutex_lock(&self->resolver_mutex);
+	index = self->current;
+	if ((index == NULL)
+		|| (index->generation != generation)
+		|| (index->addendum != addendum)
+		|| (index->lexicon != lexicon)
+		|| (index->g2p != g2p))
+	{
+		/* the voice data has changed, index the new data */
+		index = index_new(generation, addendum, lexicon, g2p, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "s_pron_resolver_acquire",
+					  "Call to \"index_new\" failed"))
+		{
+			s_mutex_unlock(&self->resolver_mutex);
+			return NULL;
+		}
+
+		if ((self->current != NULL) && (--self->current->refs == 0))
+			index_free(self->current);
+
+		self->current = index;
+	}
+
+	index->refs++;
+	s_mutex_unlock(&self->resolver_mutex);
+
+	return index;
+}
+
+
+S_LOCAL void s_pron_resolver_release(s_pron_resolver *self, s_pron_index *index)
+{
+	s_mutex_lock(&self->resolver_mutex);
+	if (--index->refs == 0)
+		index_free(index);
+	s_mutex_unlock(&self->resolver_mutex);
+
+	S_UNUSED(self); /* without threads */
+}
+
+
+S_LOCAL const SList *s_pron_index_get_word(const s_pron_index *index, const char *word,
+										   s_bool *syllabified, SList **owned,
+										   s_erc *error)
+{
+	const s_hash_element *element;
+	const s_pron_entry *entry;
+	SList *list;
+
+
+	S_CLR_ERR(error);
+
+	*owned = NULL;
+	*syllabified = FALSE;
+
+	/* an addendum that is not indexed still overrides the index */
+	if ((index->addendum != NULL) && !index->addendum_indexed)
+	{
+		list = S_ADDENDUM_CALL(index->addendum, get_word)(index->addendum, word,
+														  NULL, syllabified,
+														  error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "s_pron_index_get_word",
+					  "Call to method \"get_word\" (SAddendum) failed"))
+			return NULL;
+
+		if (list != NULL)
+		{
+			*owned = list;
+			return list;
+		}
+	}
+
+	/* one probe for the indexed addendum and lexicon */
+	element = s_hash_table_find(index->words, word, s_strzsize(word, error), error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "s_pron_index_get_word",
+				  "Call to \"s_hash_table_find\" failed"))
+		return NULL;
+
+	if (element != NULL)
+	{
+		entry = (const s_pron_entry*)s_hash_element_get_data(element, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "s_pron_index_get_word",
+					  "Call to \"s_hash_element_get_data\" failed"))
+			return NULL;
+
+		*syllabified = entry->syllabified;
+		return entry->info;
+	}
+
+	if ((index->lexicon != NULL) && !index->lexicon_indexed)
+	{
+		list = S_LEXICON_CALL(index->lexicon, get_word)(index->lexicon, word,
+														NULL, syllabified,
+														error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "s_pron_index_get_word",
+					  "Call to method \"get_word\" (SLexicon) failed"))
+			return NULL;
+
+		if (list != NULL)
+		{
+			*owned = list;
+			return list;
+		}
+	}
+
+	if (index->g2p == NULL)
+		return NULL;
+
+	*syllabified = FALSE;
+	list = S_G2P_CALL(index->g2p, apply)(index->g2p, word, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "s_pron_index_get_word",
+				  "Call to method \"apply\" (SG2P) failed"))
+		return NULL;
+
+	*owned = list;
+	return list;
+}
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static function implementations                                                  */
+/*                                                                                  */
+/************************************************************************************/
+
+/* add a word to the index, the word must not be in the index */
+static void index_add_word(const char *word, const SList *info, s_bool syllabified,
+						   void *userdata, s_erc *error)
+{
+	s_pron_index *index = userdata;
+	s_pron_block *block;
+	s_pron_entry *entry;
+
+
+	S_CLR_ERR(error);
+
+	block = index->blocks;
+	if ((block == NULL) || (block->num_entries == S_PRON_BLOCK_SIZE))
+	{
+		block = S_MALLOC(s_pron_block, 1);
+		if (block == NULL)
+		{
+			S_FTL_ERR(error, S_MEMERROR,
+					  "index_add_word",
+					  "Failed to allocate memory for 's_pron_block' object");
+			return;
+		}
+
+		block->num_entries = 0;
+		block->next = index->blocks;
+		index->blocks = block;
+	}
+
+	entry = &block->entries[block->num_entries];
+	entry->info = info;
+	entry->syllabified = syllabified;
+
+	/* the key is not freed by the index, it belongs to the data object */
+	s_hash_table_add(index->words, (void*)word, s_strzsize(word, error), entry, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "index_add_word",
+				  "Call to \"s_hash_table_add\" failed"))
+		return;
+
+	block->num_entries++;
+}
+
+
+/* lexicon words are only added if the addendum does not have them */
+static void index_add_lexicon_word(const char *word, const SList *info,
+								   s_bool syllabified, void *userdata, s_erc *error)
+{
+	s_pron_index *index = userdata;
+	const s_hash_element *element;
+
+
+	S_CLR_ERR(error);
+
+	element = s_hash_table_find(index->words, word, s_strzsize(word, error), error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "index_add_lexicon_word",
+				  "Call to \"s_hash_table_find\" failed"))
+		return;
+
+	if (element != NULL)
+		return;
+
+	index_add_word(word, info, syllabified, userdata, error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "index_add_lexicon_word",
+			  "Call to \"index_add_word\" failed");
+}
+
+
+static s_pron_index *index_new(uint32 generation, const SAddendum *addendum,
+							   const SLexicon *lexicon, const SG2P *g2p, s_erc *error)
+{
+	s_pron_index *index;
+
+
+	S_CLR_ERR(error);
+
+	index = S_CALLOC(s_pron_index, 1);
+	if (index == NULL)
+	{
+		S_FTL_ERR(error, S_MEMERROR,
+				  "index_new",
+				  "Failed to allocate memory for 's_pron_index' object");
+		return NULL;
+	}
+
+	/* no free function, the keys and entries are not owned by the table */
+	index->words = s_hash_table_new(NULL, S_PRON_INDEX_TABLE_SIZE, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "index_new",
+				  "Call to \"s_hash_table_new\" failed"))
+	{
+		S_FREE(index);
+		return NULL;
+	}
+
+	index->generation = generation;
+	index->addendum = addendum;
+	index->lexicon = lexicon;
+	index->g2p = g2p;
+	index->refs = 1;
+
+	/* the addendum first, its words override the lexicon words */
+	if (addendum != NULL)
+	{
+		if (S_ADDENDUM_METH_VALID(addendum, foreach_word))
+		{
+			S_ADDENDUM_CALL(addendum, foreach_word)(addendum, index_add_word,
+													index, error);
+			if (S_CHK_ERR(error, S_CONTERR,
+						  "index_new",
+						  "Call to method \"foreach_word\" (SAddendum) failed"))
+			{
+				index_free(index);
+				return NULL;
+			}
+
+			index->addendum_indexed = TRUE;
+		}
+	}
+
+	if (lexicon != NULL)
+	{
+		if (S_LEXICON_METH_VALID(lexicon, foreach_word))
+		{
+			S_LEXICON_CALL(lexicon, foreach_word)(lexicon, index_add_lexicon_word,
+												  index, error);
+			if (S_CHK_ERR(error, S_CONTERR,
+						  "index_new",
+						  "Call to method \"foreach_word\" (SLexicon) failed"))
+			{
+				index_free(index);
+				return NULL;
+			}
+
+			index->lexicon_indexed = TRUE;
+		}
+	}
+
+	return index;
+}
+
+
+static void index_free(s_pron_index *index)
+{
+	s_pron_block *block;
+	s_erc local_err = S_SUCCESS;
+
+
+	s_hash_table_delete(index->words, &local_err);
+
+	while (index->blocks != NULL)
+	{
+		block = index->blocks;
+		index->blocks = block->next;
+		S_FREE(block);
+	}
+
+	S_FREE(index);
+}
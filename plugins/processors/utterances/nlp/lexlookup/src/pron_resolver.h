@@ -0,0 +1,205 @@
+/************************************************************************************/
+/* Copyright (c) 2009-2011 The Department of Arts and Culture,                      */
+/* The Government of the Republic of South Africa.                                  */
+/*                                                                                  */
+/* Contributors:  Meraka Institute, CSIR, South Africa.                             */
+/*                                                                                  */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy     */
+/* of this software and associated documentation files (the "Software"), to deal    */
+/* in the Software without restriction, including without limitation the rights     */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        */
+/* copies of the Software, and to permit persons to whom the Software is            */
+/* furnished to do so, subject to the following conditions:                         */
+/* The above copyright notice and this permission notice shall be included in       */
+/* all copies or substantial portions of the Software.                              */
+/*                                                                                  */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN        */
+/* THE SOFTWARE.                                                                    */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* AUTHOR  : Speect contributors                                                    */
+/* DATE    : 19 October 2026                                                        */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* A pronunciation resolver, one index of the addendum and lexicon words.           */
+/*                                                                                  */
+/*                                                                                  */
+/************************************************************************************/
+
+#ifndef _SPCT_PLUGIN_UTTPROCESSOR_PRON_RESOLVER_H__
+#define _SPCT_PLUGIN_UTTPROCESSOR_PRON_RESOLVER_H__
+
+
+/**
+ * @file pron_resolver.h
+ * A pronunciation resolver.
+ */
+
+
+/**
+ * @ingroup SUttProcLexLookup
+ * @defgroup SLexLookupPronResolver Pronunciation resolver
+ * Resolves the pronunciation of a word with one probe of an index of
+ * the words of the addendum and the lexicon of a voice, where the
+ * addendum entries override the lexicon entries. The index refers to
+ * the pronunciations of the addendum and lexicon, nothing is copied.
+ * The G2P is only applied to words that are not in the index.
+ *
+ * The index is built from the addendum and lexicon
+ * @c foreach_word methods. An addendum or lexicon that does not
+ * implement @c foreach_word is not indexed, it is probed with
+ * @c get_word, keeping the order addendum, lexicon, G2P. The index
+ * is rebuilt when the data of the voice changes (see
+ * #SVoiceGetDataGeneration), words added to the addendum with
+ * @c add_word are only seen after that.
+ * @{
+ */
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Modules used                                                                     */
+/*                                                                                  */
+/************************************************************************************/
+
+#include "speect.h"
+#include "addendum.h"
+#include "lexicon.h"
+#include "g2p.h"
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Begin external c declaration                                                     */
+/*                                                                                  */
+/************************************************************************************/
+S_BEGIN_C_DECLS
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Typedef                                                                          */
+/*                                                                                  */
+/************************************************************************************/
+
+/**
+ * Opaque pronunciation resolver.
+ */
+typedef struct s_pron_resolver s_pron_resolver;
+
+
+/**
+ * Opaque index of the words of an addendum and a lexicon.
+ */
+typedef struct s_pron_index s_pron_index;
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Function prototypes                                                              */
+/*                                                                                  */
+/************************************************************************************/
+
+/**
+ * Create a new pronunciation resolver.
+ * @private
+ *
+ * @param error Error code.
+ *
+ * @return The new pronunciation resolver.
+ */
+S_LOCAL s_pron_resolver *s_pron_resolver_new(s_erc *error);
+
+
+/**
+ * Delete a pronunciation resolver. Indexes that have been acquired
+ * must be released first.
+ * @private
+ *
+ * @param self The pronunciation resolver.
+ * @param error Error code.
+ */
+S_LOCAL void s_pron_resolver_delete(s_pron_resolver *self, s_erc *error);
+
+
+/**
+ * Get the index of the given addendum and lexicon. The index is
+ * built if the given data generation is not the generation of the
+ * current index.
+ * @private
+ *
+ * @param self The pronunciation resolver.
+ * @param generation The data generation of the voice of the
+ * addendum, lexicon and G2P.
+ * @param addendum The addendum, can be @c NULL.
+ * @param lexicon The lexicon, can be @c NULL.
+ * @param g2p The G2P, can be @c NULL.
+ * @param error Error code.
+ *
+ * @return The index, which must be released with
+ * #s_pron_resolver_release.
+ *
+ * @note Thread safe.
+ */
+S_LOCAL s_pron_index *s_pron_resolver_acquire(s_pron_resolver *self, uint32 generation,
+											  const SAddendum *addendum,
+											  const SLexicon *lexicon,
+											  const SG2P *g2p, s_erc *error);
+
+
+/**
+ * Release an index acquired with #s_pron_resolver_acquire.
+ * @private
+ *
+ * @param self The pronunciation resolver.
+ * @param index The index.
+ *
+ * @note Thread safe.
+ */
+S_LOCAL void s_pron_resolver_release(s_pron_resolver *self, s_pron_index *index);
+
+
+/**
+ * Get the pronunciation of a word.
+ * @private
+ *
+ * @param index The index.
+ * @param word The down-cased word.
+ * @param syllabified Set to @c TRUE if the returned list is a list
+ * of syllables (lists of phones), else it is a list of phones.
+ * @param owned Set to the returned list if the caller must delete
+ * it (the G2P or a probed addendum or lexicon created it), else to
+ * @c NULL.
+ * @param error Error code.
+ *
+ * @return The phones or syllables of the word, or @c NULL if the
+ * word could not be resolved.
+ *
+ * @note Thread safe, the returned list must not be changed.
+ */
+S_LOCAL const SList *s_pron_index_get_word(const s_pron_index *index, const char *word,
+										   s_bool *syllabified, SList **owned,
+										   s_erc *error);
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* End external c declaration                                                       */
+/*                                                                                  */
+/************************************************************************************/
+S_END_C_DECLS
+
+
+/**
+ * @}
+ * end documentation
+ */
+
+#endif /* _SPCT_PLUGIN_UTTPROCESSOR_PRON_RESOLVER_H__ */
@@ -525,6 +525,9 @@ static SMorphDecompUttProcClass MorphDecompUttProcClass =
 		NULL,            /* copy    */
 	},
 	/* SUttProcessorClass */
-	NULL,                /* initialize */
-	Run                  /* run        */
+	NULL,                /* initialize    */
+	Run,                 /* run           */
+	NULL,                /* create_state  */
+	NULL,                /* destroy_state */
+	NULL                 /* run_state     */
 };
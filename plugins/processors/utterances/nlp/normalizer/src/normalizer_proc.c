@@ -305,6 +305,9 @@ static SNormalizationUttProcClass NormalizationUttProcClass =
 		NULL,            /* copy    */
 	},
 	/* SUttProcessorClass */
-	NULL,                /* initialize */
-	Run                  /* run        */
+	NULL,                /* initialize    */
+	Run,                 /* run           */
+	NULL,                /* create_state  */
+	NULL,                /* destroy_state */
+	NULL                 /* run_state     */
 };
@@ -316,6 +316,9 @@ static SPausesUttProcClass PausesUttProcClass =
 		NULL,            /* copy    */
 	},
 	/* SUttProcessorClass */
-	NULL,                /* initialize */
-	Run                  /* run        */
+	NULL,                /* initialize    */
+	Run,                 /* run           */
+	NULL,                /* create_state  */
+	NULL,                /* destroy_state */
+	NULL                 /* run_state     */
 };
@@ -1784,6 +1784,9 @@ static SRuleBasedEndtoneUttProcClass RuleBasedEndtoneUttProcClass =
 		NULL,            /* copy    */
 	},
 	/* SUttProcessorClass */
-	Initialize,          /* initialize */
-	Run                  /* run     */
+	Initialize,          /* initialize    */
+	Run,                 /* run           */
+	NULL,                /* create_state  */
+	NULL,                /* destroy_state */
+	NULL                 /* run_state     */
 };
@@ -796,6 +796,9 @@ static SRuleBasedFeaturesUttProcClass RuleBasedFeaturesUttProcClass =
 		NULL,            /* copy    */
 	},
 	/* SUttProcessorClass */
-	Initialize,          /* initialize */
-	Run                  /* run     */
+	Initialize,          /* initialize    */
+	Run,                 /* run           */
+	NULL,                /* create_state  */
+	NULL,                /* destroy_state */
+	NULL                 /* run_state     */
 };
@@ -86,6 +86,8 @@ s_bool s_test_period_abbreviation(const char *token_string, const char *item_str
 s_bool s_got_uttbreak(const SToken *token, const char *token_string,
 					  const char *item_post_punc, const char *item_string, s_erc *error);
 
+static char *s_get_utt_text(const SUtterance *utt, s_erc *error);
+
 
 /************************************************************************************/
 /*                                                                                  */
@@ -575,6 +577,94 @@ s_bool s_got_uttbreak(const SToken *token, const char *token_string,
 }
 
 
+/* the text of an utterance from the uttbreak processor, the tokens
+ * with their white-space and punctuation.
+ */
+static char *s_get_utt_text(const SUtterance *utt, s_erc *error)
+{
+	const SRelation *tokenRel;
+	const SItem *itemItr;
+	const char *parts[4];
+	const char *feats[3] = { "whitespace", "prepunc", "postpunc" };
+	char *text = NULL;
+	char *tmp;
+	s_bool is_present;
+	int i;
+
+
+	S_CLR_ERR(error);
+
+	tokenRel = SUtteranceGetRelation(utt, "Token", error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "s_get_utt_text",
+				  "Call to \"SUtteranceGetRelation\" failed"))
+		return NULL;
+
+	itemItr = SRelationHead(tokenRel, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "s_get_utt_text",
+				  "Call to \"SRelationHead\" failed"))
+		return NULL;
+
+	while (itemItr != NULL)
+	{
+		for (i = 0; i < 3; i++)
+		{
+			parts[i] = "";
+			is_present = SItemFeatureIsPresent(itemItr, feats[i], error);
+			if (S_CHK_ERR(error, S_CONTERR,
+						  "s_get_utt_text",
+						  "Call to \"SItemFeatureIsPresent\" failed"))
+				goto quit_error;
+
+			if (!is_present)
+				continue;
+
+			parts[i] = SItemGetString(itemItr, feats[i], error);
+			if (S_CHK_ERR(error, S_CONTERR,
+						  "s_get_utt_text",
+						  "Call to \"SItemGetString\" failed"))
+				goto quit_error;
+		}
+
+		parts[3] = SItemGetName(itemItr, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "s_get_utt_text",
+					  "Call to \"SItemGetName\" failed"))
+			goto quit_error;
+
+		/* leading white-space of the utterance is dropped */
+		s_asprintf(&tmp, error, "%s%s%s%s%s",
+				   (text != NULL) ? text : "",
+				   (text != NULL) ? parts[0] : "",
+				   parts[1], parts[3], parts[2]);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "s_get_utt_text",
+					  "Call to \"s_asprintf\" failed"))
+			goto quit_error;
+
+		if (text != NULL)
+			S_FREE(text);
+		text = tmp;
+
+		itemItr = SItemNext(itemItr, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "s_get_utt_text",
+					  "Call to \"SItemNext\" failed"))
+			goto quit_error;
+	}
+
+	return text;
+
+	/* error clean-up */
+quit_error:
+	if (text != NULL)
+		S_FREE(text);
+
+	return NULL;
+}
+
+
 /************************************************************************************/
 /*                                                                                  */
 /* Static class function implementations                                            */
@@ -871,6 +961,126 @@ quit_error:
 
 
 
+/*
+ * Break the "input" text of the utterance into the texts of the
+ * utterances in it, set as the "utterance-texts" feature (an #SList of
+ * #SString).
+ */
+static void Run(const SUttProcessor *self, SUtterance *utt,
+				s_erc *error)
+{
+	const char *text;
+	s_bool have_input;
+	const SVoice *voice;
+	STokenstream *ts = NULL;
+	SList *uttTexts = NULL;
+	SUtterance *nextUtt;
+	char *utt_text;
+
+
+	S_CLR_ERR(error);
+
+	have_input = SUtteranceFeatureIsPresent(utt, "input", error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "Run",
+				  "Call to \"SUtteranceFeatureIsPresent\" failed"))
+		goto quit;
+
+	if (!have_input)
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "Run",
+				  "Failed to find 'input' feature of utterance");
+		goto quit;
+	}
+
+	text = SObjectGetString(SUtteranceGetFeature(utt, "input", error),
+							error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "Run",
+				  "Failed to get string from 'input' feature"))
+		goto quit;
+
+	voice = SUtteranceVoice(utt, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "Run",
+				  "Call to \"SUtteranceVoice\" failed"))
+		goto quit;
+
+	/* create string tokenizer */
+	ts = (STokenstream*)S_NEW(STokenstreamString, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "Run",
+				  "Failed to create string tokenizer"))
+		goto quit;
+
+	STokenstreamStringInit((STokenstreamString**)&ts,
+						 text,
+						 error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "Run",
+				  "Failed to initialize string tokenizer"))
+		goto quit;
+
+	SetTokenstreamSymbols(S_UTTBREAK_UTTPROC(self), ts, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "Run",
+				  "Call to \"SetTokenstreamSymbols\" failed"))
+		goto quit;
+
+	uttTexts = S_LIST(S_NEW(SListList, error));
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "Run",
+				  "Failed to create new 'SList' object"))
+		goto quit;
+
+	while (TRUE)
+	{
+		nextUtt = GetNextUtt(S_UTTBREAK_UTTPROC(self), voice, ts, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "Run",
+					  "Call to \"GetNextUtt\" failed"))
+			goto quit;
+
+		if (nextUtt == NULL)
+			break;
+
+		utt_text = s_get_utt_text(nextUtt, error);
+		S_DELETE(nextUtt, "Run", error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "Run",
+					  "Call to \"s_get_utt_text\" failed"))
+			goto quit;
+
+		if (utt_text == NULL) /* no tokens */
+			continue;
+
+		SListAppend(uttTexts, SObjectSetString(utt_text, error), error);
+		S_FREE(utt_text);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "Run",
+					  "Call to \"SListAppend\" failed"))
+			goto quit;
+	}
+
+	SUtteranceSetFeature(utt, "utterance-texts", S_OBJECT(uttTexts), error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "Run",
+				  "Call to \"SUtteranceSetFeature\" failed"))
+		goto quit;
+
+	uttTexts = NULL; /* utterance takes hold of it */
+
+	/* clean-up code */
+quit:
+	if (uttTexts != NULL)
+		S_DELETE(uttTexts, "Run", error);
+
+	if (ts != NULL)
+		S_DELETE(ts, "Run", error);
+}
+
+
 /************************************************************************************/
 /*                                                                                  */
 /* SUttBreakUttProc class initialization                                            */
@@ -893,8 +1103,11 @@ static SUttBreakUttProcClass UttBreakUttProcClass =
 			NULL,            /* copy    */
 		},
 		/* SUttProcessorClass */
-		Initialize,          /* initialize */
-		NULL,                /* run        */
+		Initialize,          /* initialize    */
+		Run,                 /* run           */
+		NULL,                /* create_state  */
+		NULL,                /* destroy_state */
+		NULL,                /* run_state     */
 	},
 	/* SUttBreakUttProcClass */
 	SetTokenstreamSymbols,   /* set_tokenstream_symbols */
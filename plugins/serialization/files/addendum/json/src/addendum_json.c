@@ -639,6 +639,62 @@ static void AddWord(SAddendum *self, const char *word, SMap *features,
 }
 
 
+static void ForeachWord(const SAddendum *self, s_addendum_word_fp func, void *userdata,
+						s_erc *error)
+{
+	const SAddendumJSON *addendum = S_ADDENDUM_JSON(self);
+	SIterator *itr;
+	const char *word;
+	const SList *info;
+	s_bool syllabified;
+
+
+	S_CLR_ERR(error);
+	if (func == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "ForeachWord",
+				  "Argument \"func\" is NULL");
+		return;
+	}
+
+	if (addendum->entries == NULL)
+		return;
+
+	itr = S_ITERATOR_GET(addendum->entries, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "ForeachWord",
+				  "Call to \"S_ITERATOR_GET\" failed"))
+		return;
+
+	for (/* NOP */; itr != NULL; itr = SIteratorNext(itr))
+	{
+		word = SIteratorKey(itr, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "ForeachWord",
+					  "Call to \"SIteratorKey\" failed"))
+			break;
+
+		info = get_word_info(SIteratorObject(itr, error), NULL, &syllabified, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "ForeachWord",
+					  "Failed to get phones/syllables for word '%s'",
+					  word))
+			break;
+
+		func(word, info, syllabified, userdata, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "ForeachWord",
+					  "Call to word function failed for word '%s'",
+					  word))
+			break;
+	}
+
+	if (itr != NULL)
+		S_DELETE(itr, "ForeachWord", error);
+}
+
+
 /************************************************************************************/
 /*                                                                                  */
 /* SAddendum class initialization                                                   */
@@ -667,5 +723,6 @@ static SAddendumJSONClass AddendumJSONClass =
 	SGetVersion,         /* get_version     */
 	GetFeature,          /* get_feature     */
 	GetWord,             /* get_word        */
-	AddWord              /* add_word        */
+	AddWord,             /* add_word        */
+	ForeachWord          /* foreach_word    */
 };
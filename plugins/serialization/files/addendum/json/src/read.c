@@ -59,7 +59,7 @@ static void set_addendum_info(SAddendum *addendum, const SMap *addendumDef,
 /*                                                                                  */
 /************************************************************************************/
 
-S_LOCAL SAddendumJSON *s_read_addendum_json(const char *path, s_erc *error)
+S_LOCAL SAddendumJSON *s_read_addendum_json(SDatasource *ds, s_erc *error)
 {
 	SAddendumJSON *addendum = NULL;
 	SMap *parsedFile = NULL;
@@ -76,13 +76,16 @@ S_LOCAL SAddendumJSON *s_read_addendum_json(const char *path, s_erc *error)
 	if (S_CHK_ERR(error, S_CONTERR,
 				  "s_read_addendum_json",
 				  "Failed to create new addendum object"))
+	{
+		S_DELETE(ds, "s_read_addendum_json", error);
 		goto quit_error;
+	}
 
-	/* read the JSON file into a SMAP */
-	parsedFile = s_json_parse_config_file(path, error);
+	/* read the JSON data source into a SMAP */
+	parsedFile = s_json_parse_config_datasource(ds, error);
 	if (S_CHK_ERR(error, S_CONTERR,
 				  "s_read_addendum_json",
-				  "Call to \"s_json_parse_config_file\" failed"))
+				  "Call to \"s_json_parse_config_datasource\" failed"))
 		goto quit_error;
 
 	/* get "addendum-definition" key */
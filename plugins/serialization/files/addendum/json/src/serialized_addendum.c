@@ -135,13 +135,37 @@ static void Dispose(void *obj, s_erc *error)
 static SObject *Load(const char *path, s_erc *error)
 {
 	SAddendumJSON *addendum;
+	SDatasource *ds;
 
 
 	S_CLR_ERR(error);
 
-	addendum = s_read_addendum_json(path, error);
+	ds = SFilesourceOpenFile(path, "r", error);
 	if (S_CHK_ERR(error, S_CONTERR,
 				  "Load",
+				  "Call to \"SFilesourceOpenFile\" failed"))
+		return NULL;
+
+	addendum = s_read_addendum_json(ds, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "Load",
+				  "Call to \"s_read_addendum_json\" failed"))
+		return NULL;
+
+	return S_OBJECT(addendum);
+}
+
+
+static SObject *LoadFromDatasource(SDatasource *ds, s_erc *error)
+{
+	SAddendumJSON *addendum;
+
+
+	S_CLR_ERR(error);
+
+	addendum = s_read_addendum_json(ds, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "LoadFromDatasource",
 				  "Call to \"s_read_addendum_json\" failed"))
 		return NULL;
 
@@ -184,5 +208,6 @@ static SJSONAddendumFileClass JSONAddendumFileClass =
 	"spct_addendum",           /* format  */
 	Load,                      /* load    */
 	Save,                      /* save    */
-	NULL                       /* save_to_datasource */
+	NULL,                      /* save_to_datasource   */
+	LoadFromDatasource         /* load_from_datasource */
 };
@@ -96,15 +96,16 @@ S_LOCAL void _s_serialized_json_addendum_free(s_erc *error);
 
 
 /**
- * Read an JSON format addendum from the given file.
+ * Read a JSON format addendum from the given data source.
  *
- * @param path The full path and file name of the JSON format addendum
- * to read.
+ * @param ds The data source to read the addendum from. The
+ * function takes hold of the data source, it is deleted when reading
+ * is done (also on errors).
  * @param error Error code.
  *
  * @return Loaded addendum or @c NULL on error.
  */
-S_LOCAL SAddendumJSON *s_read_addendum_json(const char *path, s_erc *error);
+S_LOCAL SAddendumJSON *s_read_addendum_json(SDatasource *ds, s_erc *error);
 
 
 /************************************************************************************/
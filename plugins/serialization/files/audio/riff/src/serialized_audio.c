@@ -191,8 +191,9 @@ static SRIFFAudioFileClass RIFFAudioFileClass =
 		NULL,                  /* copy    */
 	},
 	/* SSerializedFileClass */
-	"riff",                    /* format             */
-	Load,                      /* load               */
-	Save,                      /* save               */
-	SaveToDatasource           /* save to datasource */
+	"riff",                    /* format               */
+	Load,                      /* load                 */
+	Save,                      /* save                 */
+	SaveToDatasource,          /* save to datasource   */
+	NULL                       /* load from datasource */
 };
@@ -0,0 +1,287 @@
+/************************************************************************************/
+/* Copyright (c) 2009-2011 The Department of Arts and Culture,                      */
+/* The Government of the Republic of South Africa.                                  */
+/*                                                                                  */
+/* Contributors:  Meraka Institute, CSIR, South Africa.                             */
+/*                                                                                  */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy     */
+/* of this software and associated documentation files (the "Software"), to deal    */
+/* in the Software without restriction, including without limitation the rights     */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        */
+/* copies of the Software, and to permit persons to whom the Software is            */
+/* furnished to do so, subject to the following conditions:                         */
+/* The above copyright notice and this permission notice shall be included in       */
+/* all copies or substantial portions of the Software.                              */
+/*                                                                                  */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN        */
+/* THE SOFTWARE.                                                                    */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* AUTHOR  : Speect contributors                                                    */
+/* DATE    : 19 October 2026                                                        */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* Benchmark of the compiled g2p rewrites rules against the rules matched in        */
+/* order. Reads a word list (one word per line) or uses a built-in list.            */
+/*                                                                                  */
+/************************************************************************************/
+
+
+#include <stdio.h>
+#include <string.h>
+#include "speect.h"
+#include "g2p.h"
+#include "g2p_rewrites.h"
+
+
+static const char *g2p_rewrites_plugin = "g2p_rewrites.spi";
+
+static const char *default_words[] =
+{
+	"computer", "speech", "synthesis", "grapheme", "phoneme", "rewrite",
+	"knowledge", "through", "thought", "quickly", "pronunciation",
+	"international", "experience", "yesterday", "beautiful", "language",
+	"machine", "telephone", "government", "department", "university",
+	"character", "question", "weather", "whistle", "judge", "science",
+	NULL
+};
+
+#define BENCH_MAX_WORDS 100000
+
+
+/* the phones of a word as one string */
+static void phones_string(const SList *phones, char *buf, size_t size, s_erc *error)
+{
+	SIterator *itr;
+	const char *phone;
+
+
+	S_CLR_ERR(error);
+	buf[0] = '\0';
+
+	itr = S_ITERATOR_GET(phones, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "phones_string",
+				  "Call to \"S_ITERATOR_GET\" failed"))
+		return;
+
+	for (/* NOP */; itr != NULL; itr = SIteratorNext(itr))
+	{
+		phone = SObjectGetString(SIteratorObject(itr, error), error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "phones_string",
+					  "Call to \"SObjectGetString\" failed"))
+		{
+			S_DELETE(itr, "phones_string", error);
+			return;
+		}
+
+		if ((strlen(buf) + strlen(phone) + 2) > size)
+			break;
+
+		strcat(buf, phone);
+		strcat(buf, " ");
+	}
+
+	if (itr != NULL)
+		S_DELETE(itr, "phones_string", error);
+}
+
+
+/* apply the g2p to all the words, returns the time in seconds */
+static double run(SG2P *g2p, char **words, int num_words, int iterations,
+				  char **results, s_erc *error)
+{
+	SList *phones;
+	double start;
+	double end;
+	int i;
+	int j;
+
+
+	S_CLR_ERR(error);
+
+	start = s_time_monotonic(error);
+
+	for (i = 0; i < iterations; i++)
+	{
+		for (j = 0; j < num_words; j++)
+		{
+			phones = S_G2P_CALL(g2p, apply)(g2p, words[j], error);
+			if (S_CHK_ERR(error, S_CONTERR,
+						  "run",
+						  "Call to method \"apply\" failed for word '%s'",
+						  words[j]))
+				return 0.0;
+
+			if ((i == 0) && (results != NULL))
+				phones_string(phones, results[j], 1024, error);
+
+			S_DELETE(phones, "run", error);
+			if (*error != S_SUCCESS)
+				return 0.0;
+		}
+	}
+
+	end = s_time_monotonic(error);
+
+	return end - start;
+}
+
+
+int main(int argc, char **argv)
+{
+	s_erc error = S_SUCCESS;
+	SG2P *g2p = NULL;
+	SPlugin *plugin = NULL;
+	s_g2p_automaton *automaton;
+	char **words = NULL;
+	char **compiled = NULL;
+	char **legacy = NULL;
+	char line[1024];
+	int num_words = 0;
+	int iterations = 100;
+	int differ = 0;
+	double compiled_time;
+	double legacy_time;
+	FILE *fp;
+	int i;
+
+
+	S_CLR_ERR(&error);
+
+	error = speect_init(NULL);
+	if (error != S_SUCCESS)
+	{
+		printf("Failed to initialize Speect\n");
+		return 1;
+	}
+
+	words = S_CALLOC(char*, BENCH_MAX_WORDS);
+	compiled = S_CALLOC(char*, BENCH_MAX_WORDS);
+	legacy = S_CALLOC(char*, BENCH_MAX_WORDS);
+	if ((words == NULL) || (compiled == NULL) || (legacy == NULL))
+	{
+		printf("out of memory\n");
+		goto quit;
+	}
+
+	if (argc > 1)
+	{
+		fp = fopen(argv[1], "r");
+		if (fp == NULL)
+		{
+			printf("failed to open word list '%s'\n", argv[1]);
+			goto quit;
+		}
+
+		while ((num_words < BENCH_MAX_WORDS) && (fgets(line, 1024, fp) != NULL))
+		{
+			line[strcspn(line, "\r\n")] = '\0';
+			if (line[0] == '\0')
+				continue;
+
+			words[num_words++] = s_strdup(line, &error);
+		}
+
+		fclose(fp);
+	}
+	else
+	{
+		for (i = 0; default_words[i] != NULL; i++)
+			words[num_words++] = s_strdup(default_words[i], &error);
+	}
+
+	if (argc > 2)
+		iterations = atoi(argv[2]);
+
+	for (i = 0; i < num_words; i++)
+	{
+		compiled[i] = S_CALLOC(char, 1024);
+		legacy[i] = S_CALLOC(char, 1024);
+		if ((words[i] == NULL) || (compiled[i] == NULL) || (legacy[i] == NULL))
+		{
+			printf("out of memory\n");
+			goto quit;
+		}
+	}
+
+	plugin = s_pm_load_plugin(g2p_rewrites_plugin, &error);
+	if (S_CHK_ERR(&error, S_CONTERR,
+				  "main",
+				  "Failed to load plug-in at '%s'", g2p_rewrites_plugin))
+		goto quit;
+
+	g2p = (SG2P*)SObjectLoad("lwazi_english_g2p.spct", "spct_g2p_rewrites", &error);
+	if (S_CHK_ERR(&error, S_CONTERR,
+				  "main",
+				  "Failed to load g2p"))
+		goto quit;
+
+	compiled_time = run(g2p, words, num_words, iterations, compiled, &error);
+	if (error != S_SUCCESS)
+		goto quit;
+
+	/* match the rules in order */
+	automaton = S_G2PREWRITES(g2p)->automaton;
+	S_G2PREWRITES(g2p)->automaton = NULL;
+	legacy_time = run(g2p, words, num_words, iterations, legacy, &error);
+	S_G2PREWRITES(g2p)->automaton = automaton;
+	if (error != S_SUCCESS)
+		goto quit;
+
+	for (i = 0; i < num_words; i++)
+	{
+		if (strcmp(compiled[i], legacy[i]) != 0)
+		{
+			printf("differ: %s = [%s] / [%s]\n", words[i], compiled[i], legacy[i]);
+			differ++;
+		}
+	}
+
+	printf("words %d, iterations %d, differ %d\n", num_words, iterations, differ);
+	printf("compiled %.3f ms, rules in order %.3f ms, speedup %.2f\n",
+		   compiled_time * 1000.0, legacy_time * 1000.0,
+		   (compiled_time > 0.0) ? (legacy_time / compiled_time) : 0.0);
+
+quit:
+	if (g2p != NULL)
+		S_DELETE(g2p, "main", &error);
+
+	if (plugin != NULL)
+		S_DELETE(plugin, "main", &error);
+
+	for (i = 0; i < num_words; i++)
+	{
+		S_FREE(words[i]);
+		if (compiled != NULL)
+			S_FREE(compiled[i]);
+		if (legacy != NULL)
+			S_FREE(legacy[i]);
+	}
+
+	if (words != NULL)
+		S_FREE(words);
+
+	if (compiled != NULL)
+		S_FREE(compiled);
+
+	if (legacy != NULL)
+		S_FREE(legacy);
+
+	error = speect_quit();
+	if (error != S_SUCCESS)
+	{
+		printf("Call to 'speect_quit' failed\n");
+		return 1;
+	}
+
+	return (differ == 0) ? 0 : 1;
+}
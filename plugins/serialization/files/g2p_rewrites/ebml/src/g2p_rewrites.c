@@ -40,11 +40,106 @@
 /*                                                                                  */
 /************************************************************************************/
 
+#include <stdlib.h>
 #include <string.h>
 #include "g2p_rewrites_rule.h"
 #include "g2p_rewrites.h"
 
 
+/************************************************************************************/
+/*                                                                                  */
+/* Defines                                                                          */
+/*                                                                                  */
+/************************************************************************************/
+
+/* number of characters of a word that are matched without heap memory */
+#define S_G2P_WORD_STACK_SIZE 128
+
+/* number of rules in a rule set word */
+#define S_G2P_SET_BITS 32
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Data types                                                                       */
+/*                                                                                  */
+/************************************************************************************/
+
+/* a transition of a context trie */
+typedef struct
+{
+	uint32 symbol;
+	uint32 target;
+} s_g2p_arc;
+
+
+/* a state of a context trie */
+typedef struct
+{
+	s_g2p_arc *arcs;      /* sorted on symbol. */
+	uint32     num_arcs;
+	uint32     parent;
+} s_g2p_node;
+
+
+/*
+ * A trie of the left (or right) contexts of the rules of a
+ * grapheme. Every node has the set of rules whose context is a
+ * prefix of the path to the node, so the rules that match a word
+ * context are the set of the deepest node reached when following
+ * the word context.
+ */
+typedef struct
+{
+	s_g2p_node *nodes;    /* node 0 is the root. */
+	uint32      num_nodes;
+	uint32      size;
+	uint32     *sets;     /* num_nodes x set_size rule sets. */
+	uint32      set_size;
+} s_g2p_trie;
+
+
+/* the compiled rules of a grapheme */
+typedef struct
+{
+	uint32       grapheme;
+	uint32       num_rules;
+	const char **phones;  /* phone of each rule, in rule order, or NULL. */
+	s_g2p_trie   left;
+	s_g2p_trie   right;
+} s_g2p_grapheme;
+
+
+/* a grapheme zero as characters */
+typedef struct
+{
+	uint32 *symbol;
+	uint32  symbol_len;
+	uint32 *replacement;
+	uint32  replacement_len;
+} s_g2p_zero;
+
+
+struct s_g2p_automaton
+{
+	s_g2p_grapheme *graphemes;     /* sorted on grapheme. */
+	uint32          num_graphemes;
+	sint32          ascii[128];    /* index of the ASCII graphemes, or -1. */
+	s_g2p_zero     *zeros;
+	uint32          num_zeros;
+};
+
+
+/* the characters of a word being converted */
+typedef struct
+{
+	uint32 *chars;
+	uint32  len;
+	uint32  size;
+	s_bool  heap;
+} s_g2p_word;
+
+
 /************************************************************************************/
 /*                                                                                  */
 /* Static variables                                                                 */
@@ -62,6 +157,45 @@ static SG2PRewritesClass G2PRewritesClass; /* SG2PRewrites class declaration. */
 
 static char *s_add_gzeros(const SG2PRewrites *self, const char *word, s_erc *error);
 
+static uint32 *utf8_to_chars(const char *string, uint32 *len, s_erc *error);
+
+static uint32 trie_add_node(s_g2p_trie *trie, uint32 parent, s_erc *error);
+
+static uint32 trie_insert(s_g2p_trie *trie, const char *context, s_erc *error);
+
+static sint32 trie_child(const s_g2p_trie *trie, uint32 node, uint32 symbol);
+
+static void trie_sets(s_g2p_trie *trie, const uint32 *ends, uint32 num_rules,
+					  s_erc *error);
+
+static void trie_free(s_g2p_trie *trie);
+
+static void compile_grapheme(s_g2p_grapheme *grapheme, const SList *rules,
+							 s_erc *error);
+
+static int compare_graphemes(const void *a, const void *b);
+
+static void automaton_free(s_g2p_automaton *automaton);
+
+static const s_g2p_grapheme *find_grapheme(const s_g2p_automaton *automaton,
+										   uint32 grapheme);
+
+static sint32 match_rule(const s_g2p_grapheme *grapheme, const s_g2p_word *word,
+						 uint32 pos);
+
+static void word_reserve(s_g2p_word *word, uint32 size, s_erc *error);
+
+static void word_init(const s_g2p_automaton *automaton, s_g2p_word *word,
+					  const char *string, s_erc *error);
+
+static void word_free(s_g2p_word *word);
+
+static SList *apply_compiled(const SG2PRewrites *g2p, const char *word, s_erc *error);
+
+static const char *apply_at_compiled(const SG2PRewrites *g2p, const char *word,
+									 uint index, s_erc *error);
+
+
 
 /************************************************************************************/
 /*                                                                                  */
@@ -90,6 +224,177 @@ S_LOCAL void _s_g2p_rewrites_class_free(s_erc *error)
 			  "Failed to free SG2PRewritesClass");
 }
 
+/************************************************************************************/
+/*                                                                                  */
+/* Function implementations                                                         */
+/*                                                                                  */
+/************************************************************************************/
+
+S_LOCAL void _s_g2p_rewrites_compile(SG2PRewrites *self, s_erc *error)
+{
+	s_g2p_automaton *automaton;
+	const SList *rules;
+	SIterator *itr;
+	const char *key;
+	uint32 *chars;
+	uint32 len;
+	const s_gzero *zeros;
+	size_t num_rules;
+	uint32 i;
+
+
+	S_CLR_ERR(error);
+
+	if (self->rules == NULL)
+		return;
+
+	automaton = S_CALLOC(s_g2p_automaton, 1);
+	if (automaton == NULL)
+	{
+		S_FTL_ERR(error, S_MEMERROR,
+				  "_s_g2p_rewrites_compile",
+				  "Failed to allocate memory for 's_g2p_automaton' object");
+		return;
+	}
+
+	num_rules = SMapSize(self->rules, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "_s_g2p_rewrites_compile",
+				  "Call to \"SMapSize\" failed"))
+		goto quit_error;
+
+	automaton->graphemes = S_CALLOC(s_g2p_grapheme, num_rules + 1);
+	if (automaton->graphemes == NULL)
+	{
+		S_FTL_ERR(error, S_MEMERROR,
+				  "_s_g2p_rewrites_compile",
+				  "Failed to allocate memory for 's_g2p_grapheme' object");
+		goto quit_error;
+	}
+
+	itr = S_ITERATOR_GET(self->rules, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "_s_g2p_rewrites_compile",
+				  "Call to \"S_ITERATOR_GET\" failed"))
+		goto quit_error;
+
+	for (/* NOP */; itr != NULL; itr = SIteratorNext(itr))
+	{
+		key = SIteratorKey(itr, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "_s_g2p_rewrites_compile",
+					  "Call to \"SIteratorKey\" failed"))
+		{
+			S_DELETE(itr, "_s_g2p_rewrites_compile", error);
+			goto quit_error;
+		}
+
+		chars = utf8_to_chars(key, &len, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "_s_g2p_rewrites_compile",
+					  "Call to \"utf8_to_chars\" failed"))
+		{
+			S_DELETE(itr, "_s_g2p_rewrites_compile", error);
+			goto quit_error;
+		}
+
+		/* Apply looks up single characters, other keys never match */
+		if (len != 1)
+		{
+			S_FREE(chars);
+			continue;
+		}
+
+		rules = S_LIST(SIteratorObject(itr, error));
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "_s_g2p_rewrites_compile",
+					  "Call to \"SIteratorObject\" failed"))
+		{
+			S_FREE(chars);
+			S_DELETE(itr, "_s_g2p_rewrites_compile", error);
+			goto quit_error;
+		}
+
+		automaton->graphemes[automaton->num_graphemes].grapheme = chars[0];
+		S_FREE(chars);
+
+		compile_grapheme(&automaton->graphemes[automaton->num_graphemes++], rules, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "_s_g2p_rewrites_compile",
+					  "Call to \"compile_grapheme\" failed"))
+		{
+			S_DELETE(itr, "_s_g2p_rewrites_compile", error);
+			goto quit_error;
+		}
+	}
+
+	qsort(automaton->graphemes, automaton->num_graphemes, sizeof(s_g2p_grapheme),
+		  compare_graphemes);
+
+	for (i = 0; i < 128; i++)
+		automaton->ascii[i] = -1;
+
+	for (i = 0; i < automaton->num_graphemes; i++)
+	{
+		if (automaton->graphemes[i].grapheme < 128)
+			automaton->ascii[automaton->graphemes[i].grapheme] = (sint32)i;
+	}
+
+	/* grapheme zeros, in the order they are applied */
+	if (self->zeros != NULL)
+	{
+		for (zeros = self->zeros; zeros->symbol != NULL; zeros++)
+			automaton->num_zeros++;
+
+		automaton->zeros = S_CALLOC(s_g2p_zero, automaton->num_zeros + 1);
+		if (automaton->zeros == NULL)
+		{
+			S_FTL_ERR(error, S_MEMERROR,
+					  "_s_g2p_rewrites_compile",
+					  "Failed to allocate memory for 's_g2p_zero' object");
+			goto quit_error;
+		}
+
+		automaton->num_zeros = 0;
+		for (zeros = self->zeros; zeros->symbol != NULL; zeros++)
+		{
+			s_g2p_zero *zero = &automaton->zeros[automaton->num_zeros];
+
+
+			zero->symbol = utf8_to_chars(zeros->symbol, &zero->symbol_len, error);
+			if (!*error)
+				zero->replacement = utf8_to_chars(zeros->replacement,
+												  &zero->replacement_len, error);
+			if (S_CHK_ERR(error, S_CONTERR,
+						  "_s_g2p_rewrites_compile",
+						  "Call to \"utf8_to_chars\" failed"))
+				goto quit_error;
+
+			/* an empty symbol can not be replaced */
+			if (zero->symbol_len == 0)
+			{
+				S_FREE(zero->symbol);
+				if (zero->replacement != NULL)
+					S_FREE(zero->replacement);
+				continue;
+			}
+
+			automaton->num_zeros++;
+		}
+	}
+
+	if (self->automaton != NULL)
+		automaton_free(self->automaton);
+
+	self->automaton = automaton;
+	return;
+
+	/* error cleanup */
+quit_error:
+	automaton_free(automaton);
+}
+
+
 /************************************************************************************/
 /*                                                                                  */
 /* Static function implementations                                                  */
@@ -265,6 +570,752 @@ quit_error:
 }
 
 
+/* characters of an UTF-8 string, caller must free */
+static uint32 *utf8_to_chars(const char *string, uint32 *len, s_erc *error)
+{
+	uint32 *chars;
+	char *tmp;
+	uint32 c;
+	size_t size;
+
+
+	S_CLR_ERR(error);
+	*len = 0;
+
+	if (string == NULL)
+		string = "";
+
+	size = s_strlen(string, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "utf8_to_chars",
+				  "Call to \"s_strlen\" failed"))
+		return NULL;
+
+	chars = S_MALLOC(uint32, size + 1);
+	if (chars == NULL)
+	{
+		S_FTL_ERR(error, S_MEMERROR,
+				  "utf8_to_chars",
+				  "Failed to allocate memory for 'uint32' object");
+		return NULL;
+	}
+
+	tmp = (char*)string;
+	while (*len < size)
+	{
+		c = s_getx(&tmp, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "utf8_to_chars",
+					  "Call to \"s_getx\" failed"))
+		{
+			S_FREE(chars);
+			return NULL;
+		}
+
+		chars[(*len)++] = c;
+	}
+
+	return chars;
+}
+
+
+static uint32 trie_add_node(s_g2p_trie *trie, uint32 parent, s_erc *error)
+{
+	s_g2p_node *nodes;
+	uint32 new_size;
+
+
+	S_CLR_ERR(error);
+
+	if (trie->num_nodes == trie->size)
+	{
+		new_size = (trie->size == 0) ? 16 : (trie->size * 2);
+		nodes = S_REALLOC(trie->nodes, s_g2p_node, new_size);
+		if (nodes == NULL)
+		{
+			S_FTL_ERR(error, S_MEMERROR,
+					  "trie_add_node",
+					  "Failed to reallocate memory for 's_g2p_node' object");
+			return 0;
+		}
+
+		trie->nodes = nodes;
+		trie->size = new_size;
+	}
+
+	trie->nodes[trie->num_nodes].arcs = NULL;
+	trie->nodes[trie->num_nodes].num_arcs = 0;
+	trie->nodes[trie->num_nodes].parent = parent;
+
+	return trie->num_nodes++;
+}
+
+
+/* add the context to the trie, returns the node where it ends */
+static uint32 trie_insert(s_g2p_trie *trie, const char *context, s_erc *error)
+{
+	s_g2p_node *node;
+	s_g2p_arc *arcs;
+	uint32 *chars;
+	uint32 len;
+	uint32 current = 0;
+	uint32 target;
+	uint32 pos;
+	uint32 i;
+
+
+	S_CLR_ERR(error);
+
+	chars = utf8_to_chars(context, &len, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "trie_insert",
+				  "Call to \"utf8_to_chars\" failed"))
+		return 0;
+
+	for (i = 0; i < len; i++)
+	{
+		sint32 child = trie_child(trie, current, chars[i]);
+
+
+		if (child >= 0)
+		{
+			current = (uint32)child;
+			continue;
+		}
+
+		target = trie_add_node(trie, current, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "trie_insert",
+					  "Call to \"trie_add_node\" failed"))
+			break;
+
+		/* insert the arc in symbol order */
+		node = &trie->nodes[current];
+		arcs = S_MALLOC(s_g2p_arc, node->num_arcs + 1);
+		if (arcs == NULL)
+		{
+			S_FTL_ERR(error, S_MEMERROR,
+					  "trie_insert",
+					  "Failed to allocate memory for 's_g2p_arc' object");
+			break;
+		}
+
+		for (pos = 0; (pos < node->num_arcs) && (node->arcs[pos].symbol < chars[i]); pos++)
+			arcs[pos] = node->arcs[pos];
+
+		arcs[pos].symbol = chars[i];
+		arcs[pos].target = target;
+
+		for (/* NOP */; pos < node->num_arcs; pos++)
+			arcs[pos + 1] = node->arcs[pos];
+
+		if (node->arcs != NULL)
+			S_FREE(node->arcs);
+
+		node->arcs = arcs;
+		node->num_arcs++;
+		current = target;
+	}
+
+	S_FREE(chars);
+	return current;
+}
+
+
+static sint32 trie_child(const s_g2p_trie *trie, uint32 node, uint32 symbol)
+{
+	const s_g2p_arc *arcs = trie->nodes[node].arcs;
+	sint32 low = 0;
+	sint32 high = (sint32)trie->nodes[node].num_arcs - 1;
+	sint32 mid;
+
+
+	while (low <= high)
+	{
+		mid = (low + high) / 2;
+		if (arcs[mid].symbol == symbol)
+			return (sint32)arcs[mid].target;
+
+		if (arcs[mid].symbol < symbol)
+			low = mid + 1;
+		else
+			high = mid - 1;
+	}
+
+	return -1;
+}
+
+
+/*
+ * create the rule sets of the trie nodes, ends are the nodes where
+ * the contexts of the rules end.
+ */
+static void trie_sets(s_g2p_trie *trie, const uint32 *ends, uint32 num_rules,
+					  s_erc *error)
+{
+	uint32 *set;
+	uint32 *parent_set;
+	uint32 i;
+	uint32 j;
+
+
+	S_CLR_ERR(error);
+
+	trie->set_size = (num_rules + S_G2P_SET_BITS - 1) / S_G2P_SET_BITS;
+	if (trie->set_size == 0)
+		return;
+
+	trie->sets = S_CALLOC(uint32, trie->num_nodes * trie->set_size);
+	if (trie->sets == NULL)
+	{
+		S_FTL_ERR(error, S_MEMERROR,
+				  "trie_sets",
+				  "Failed to allocate memory for 'uint32' object");
+		return;
+	}
+
+	for (i = 0; i < num_rules; i++)
+		trie->sets[(ends[i] * trie->set_size) + (i / S_G2P_SET_BITS)]
+			|= (uint32)1 << (i % S_G2P_SET_BITS);
+
+	/* nodes are created after their parents */
+	for (i = 1; i < trie->num_nodes; i++)
+	{
+		set = &trie->sets[i * trie->set_size];
+		parent_set = &trie->sets[trie->nodes[i].parent * trie->set_size];
+
+		for (j = 0; j < trie->set_size; j++)
+			set[j] |= parent_set[j];
+	}
+}
+
+
+static void trie_free(s_g2p_trie *trie)
+{
+	uint32 i;
+
+
+	if (trie->nodes != NULL)
+	{
+		for (i = 0; i < trie->num_nodes; i++)
+		{
+			if (trie->nodes[i].arcs != NULL)
+				S_FREE(trie->nodes[i].arcs);
+		}
+
+		S_FREE(trie->nodes);
+	}
+
+	if (trie->sets != NULL)
+		S_FREE(trie->sets);
+}
+
+
+static void compile_grapheme(s_g2p_grapheme *grapheme, const SList *rules,
+							 s_erc *error)
+{
+	const SG2PRewritesRule *rule;
+	SIterator *itr;
+	uint32 *left_ends = NULL;
+	uint32 *right_ends = NULL;
+	uint32 i;
+
+
+	S_CLR_ERR(error);
+
+	grapheme->num_rules = SListSize(rules, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "compile_grapheme",
+				  "Call to \"SListSize\" failed"))
+		return;
+
+	grapheme->phones = S_CALLOC(const char*, grapheme->num_rules + 1);
+	left_ends = S_CALLOC(uint32, grapheme->num_rules + 1);
+	right_ends = S_CALLOC(uint32, grapheme->num_rules + 1);
+	if ((grapheme->phones == NULL) || (left_ends == NULL) || (right_ends == NULL))
+	{
+		S_FTL_ERR(error, S_MEMERROR,
+				  "compile_grapheme",
+				  "Failed to allocate memory for rule sets");
+		goto quit;
+	}
+
+	/* the roots */
+	trie_add_node(&grapheme->left, 0, error);
+	if (!*error)
+		trie_add_node(&grapheme->right, 0, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "compile_grapheme",
+				  "Call to \"trie_add_node\" failed"))
+		goto quit;
+
+	itr = S_ITERATOR_GET(rules, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "compile_grapheme",
+				  "Call to \"S_ITERATOR_GET\" failed"))
+		goto quit;
+
+	for (i = 0; itr != NULL; itr = SIteratorNext(itr), i++)
+	{
+		rule = (const SG2PRewritesRule*)SIteratorObject(itr, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "compile_grapheme",
+					  "Call to \"SIteratorObject\" failed"))
+		{
+			S_DELETE(itr, "compile_grapheme", error);
+			goto quit;
+		}
+
+		grapheme->phones[i] = rule->phone;
+
+		left_ends[i] = trie_insert(&grapheme->left, rule->left_context, error);
+		if (!*error)
+			right_ends[i] = trie_insert(&grapheme->right, rule->right_context, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "compile_grapheme",
+					  "Call to \"trie_insert\" failed"))
+		{
+			S_DELETE(itr, "compile_grapheme", error);
+			goto quit;
+		}
+	}
+
+	trie_sets(&grapheme->left, left_ends, grapheme->num_rules, error);
+	if (!*error)
+		trie_sets(&grapheme->right, right_ends, grapheme->num_rules, error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "compile_grapheme",
+			  "Call to \"trie_sets\" failed");
+
+quit:
+	if (left_ends != NULL)
+		S_FREE(left_ends);
+
+	if (right_ends != NULL)
+		S_FREE(right_ends);
+}
+
+
+static int compare_graphemes(const void *a, const void *b)
+{
+	uint32 ga = ((const s_g2p_grapheme*)a)->grapheme;
+	uint32 gb = ((const s_g2p_grapheme*)b)->grapheme;
+
+
+	return (ga < gb) ? -1 : ((ga > gb) ? 1 : 0);
+}
+
+
+static void automaton_free(s_g2p_automaton *automaton)
+{
+	uint32 i;
+
+
+	if (automaton->graphemes != NULL)
+	{
+		for (i = 0; i < automaton->num_graphemes; i++)
+		{
+			if (automaton->graphemes[i].phones != NULL)
+				S_FREE(automaton->graphemes[i].phones);
+
+			trie_free(&automaton->graphemes[i].left);
+			trie_free(&automaton->graphemes[i].right);
+		}
+
+		S_FREE(automaton->graphemes);
+	}
+
+	if (automaton->zeros != NULL)
+	{
+		for (i = 0; i < automaton->num_zeros; i++)
+		{
+			if (automaton->zeros[i].symbol != NULL)
+				S_FREE(automaton->zeros[i].symbol);
+
+			if (automaton->zeros[i].replacement != NULL)
+				S_FREE(automaton->zeros[i].replacement);
+		}
+
+		S_FREE(automaton->zeros);
+	}
+
+	S_FREE(automaton);
+}
+
+
+static const s_g2p_grapheme *find_grapheme(const s_g2p_automaton *automaton,
+										   uint32 grapheme)
+{
+	sint32 low = 0;
+	sint32 high = (sint32)automaton->num_graphemes - 1;
+	sint32 mid;
+
+
+	if (grapheme < 128)
+	{
+		if (automaton->ascii[grapheme] < 0)
+			return NULL;
+
+		return &automaton->graphemes[automaton->ascii[grapheme]];
+	}
+
+	while (low <= high)
+	{
+		mid = (low + high) / 2;
+		if (automaton->graphemes[mid].grapheme == grapheme)
+			return &automaton->graphemes[mid];
+
+		if (automaton->graphemes[mid].grapheme < grapheme)
+			low = mid + 1;
+		else
+			high = mid - 1;
+	}
+
+	return NULL;
+}
+
+
+/*
+ * index of the first rule of the grapheme at position pos of the
+ * word that matches, or -1. The left context is read from right to
+ * left, the right context from left to right.
+ */
+static sint32 match_rule(const s_g2p_grapheme *grapheme, const s_g2p_word *word,
+						 uint32 pos)
+{
+	const uint32 *left_set;
+	const uint32 *right_set;
+	uint32 left = 0;
+	uint32 right = 0;
+	uint32 matches;
+	uint32 bit;
+	sint32 child;
+	uint32 i;
+
+
+	if (grapheme->num_rules == 0)
+		return -1;
+
+	for (i = pos; i > 0; i--)
+	{
+		child = trie_child(&grapheme->left, left, word->chars[i - 1]);
+		if (child < 0)
+			break;
+
+		left = (uint32)child;
+	}
+
+	for (i = pos + 1; i < word->len; i++)
+	{
+		child = trie_child(&grapheme->right, right, word->chars[i]);
+		if (child < 0)
+			break;
+
+		right = (uint32)child;
+	}
+
+	left_set = &grapheme->left.sets[left * grapheme->left.set_size];
+	right_set = &grapheme->right.sets[right * grapheme->right.set_size];
+
+	for (i = 0; i < grapheme->left.set_size; i++)
+	{
+		matches = left_set[i] & right_set[i];
+		if (matches == 0)
+			continue;
+
+		for (bit = 0; (matches & 1) == 0; bit++)
+			matches >>= 1;
+
+		return (sint32)((i * S_G2P_SET_BITS) + bit);
+	}
+
+	return -1;
+}
+
+
+/* make room for size characters, moving to the heap if needed */
+static void word_reserve(s_g2p_word *word, uint32 size, s_erc *error)
+{
+	uint32 *chars;
+	uint32 new_size;
+
+
+	S_CLR_ERR(error);
+
+	if (size <= word->size)
+		return;
+
+	new_size = (size > (word->size * 2)) ? size : (word->size * 2);
+	chars = S_MALLOC(uint32, new_size);
+	if (chars == NULL)
+	{
+		S_FTL_ERR(error, S_MEMERROR,
+				  "word_reserve",
+				  "Failed to allocate memory for 'uint32' object");
+		return;
+	}
+
+	memcpy(chars, word->chars, sizeof(uint32) * word->len);
+
+	if (word->heap)
+		S_FREE(word->chars);
+
+	word->chars = chars;
+	word->size = new_size;
+	word->heap = TRUE;
+}
+
+
+/*
+ * the characters of "#word#" with the grapheme zeros replaced, the
+ * word must be set up with a (stack) buffer.
+ */
+static void word_init(const s_g2p_automaton *automaton, s_g2p_word *word,
+					  const char *string, s_erc *error)
+{
+	const s_g2p_zero *zero;
+	char *tmp = (char*)string;
+	uint32 c;
+	uint32 i;
+	uint32 j;
+	uint32 new_len;
+
+
+	S_CLR_ERR(error);
+
+	word->len = 0;
+	word->chars[word->len++] = '#';
+
+	while (1)
+	{
+		c = s_getx(&tmp, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "word_init",
+					  "Call to \"s_getx\" failed"))
+			return;
+
+		if (c == 0)
+			break;
+
+		/* one for this character, one for the closing '#' */
+		word_reserve(word, word->len + 2, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "word_init",
+					  "Call to \"word_reserve\" failed"))
+			return;
+
+		word->chars[word->len++] = c;
+	}
+
+	word->chars[word->len++] = '#';
+
+	/* replace the first occurrence of each zero until none is left */
+	for (i = 0; i < automaton->num_zeros; i++)
+	{
+		zero = &automaton->zeros[i];
+
+		for (j = 0; (j + zero->symbol_len) <= word->len; /* NOP */)
+		{
+			if (memcmp(&word->chars[j], zero->symbol,
+					   sizeof(uint32) * zero->symbol_len) != 0)
+			{
+				j++;
+				continue;
+			}
+
+			new_len = word->len - zero->symbol_len + zero->replacement_len;
+			word_reserve(word, new_len, error);
+			if (S_CHK_ERR(error, S_CONTERR,
+						  "word_init",
+						  "Call to \"word_reserve\" failed"))
+				return;
+
+			memmove(&word->chars[j + zero->replacement_len],
+					&word->chars[j + zero->symbol_len],
+					sizeof(uint32) * (word->len - j - zero->symbol_len));
+			memcpy(&word->chars[j], zero->replacement,
+				   sizeof(uint32) * zero->replacement_len);
+			word->len = new_len;
+
+			/* the replacement can create an earlier occurrence */
+			j = 0;
+		}
+	}
+}
+
+
+static void word_free(s_g2p_word *word)
+{
+	if (word->heap)
+		S_FREE(word->chars);
+}
+
+
+static SList *apply_compiled(const SG2PRewrites *g2p, const char *word, s_erc *error)
+{
+	uint32 stack_chars[S_G2P_WORD_STACK_SIZE];
+	const s_g2p_grapheme *grapheme;
+	s_g2p_word chars;
+	SList *phoneList;
+	char alpha[8];
+	sint32 rule;
+	uint32 pos;
+
+
+	S_CLR_ERR(error);
+
+	if (word == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "apply_compiled",
+				  "Argument \"word\" is NULL");
+		return NULL;
+	}
+
+	chars.chars = stack_chars;
+	chars.len = 0;
+	chars.size = S_G2P_WORD_STACK_SIZE;
+	chars.heap = FALSE;
+
+	word_init(g2p->automaton, &chars, word, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "apply_compiled",
+				  "Call to \"word_init\" failed"))
+	{
+		word_free(&chars);
+		return NULL;
+	}
+
+	phoneList = S_LIST(S_NEW(SListList, error));
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "apply_compiled",
+				  "Failed to create new 'SList' object"))
+	{
+		word_free(&chars);
+		return NULL;
+	}
+
+	/* skip the '#' at the beginning and the end */
+	for (pos = 1; (pos + 1) < chars.len; pos++)
+	{
+		grapheme = find_grapheme(g2p->automaton, chars.chars[pos]);
+		rule = (grapheme != NULL) ? match_rule(grapheme, &chars, pos) : -1;
+
+		if (rule < 0)
+		{
+			memset(alpha, 0, 8);
+			s_setc(alpha, chars.chars[pos], error);
+			if (S_CHK_ERR(error, S_CONTERR,
+						  "apply_compiled",
+						  "Call to \"s_setc\" failed"))
+				break;
+
+			/* issue warning */
+			if (grapheme == NULL)
+				S_WARNING(S_FAILURE,
+						  "Apply",
+						  "Failed to find a g2p rule for character '%s' of word '%s'",
+						  alpha, word);
+			else
+				S_WARNING(S_FAILURE,
+						  "Apply",
+						  "Failed to find a g2p rule match for character '%s' of word '%s'",
+						  alpha, word);
+			continue;
+		}
+
+		/* matched phone can be NULL */
+		if (grapheme->phones[rule] == NULL)
+			continue;
+
+		SListAppend(phoneList, SObjectSetString(grapheme->phones[rule], error), error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "apply_compiled",
+					  "Failed to add matched phone"))
+			break;
+	}
+
+	word_free(&chars);
+
+	if (*error != S_SUCCESS)
+	{
+		s_erc local_err = S_SUCCESS;
+
+
+		S_DELETE(phoneList, "apply_compiled", &local_err);
+		return NULL;
+	}
+
+	return phoneList;
+}
+
+
+static const char *apply_at_compiled(const SG2PRewrites *g2p, const char *word,
+									 uint index, s_erc *error)
+{
+	uint32 stack_chars[S_G2P_WORD_STACK_SIZE];
+	const s_g2p_grapheme *grapheme;
+	s_g2p_word chars;
+	char alpha[8];
+	sint32 rule = -1;
+	uint32 pos = index + 1;
+
+
+	S_CLR_ERR(error);
+
+	chars.chars = stack_chars;
+	chars.len = 0;
+	chars.size = S_G2P_WORD_STACK_SIZE;
+	chars.heap = FALSE;
+
+	word_init(g2p->automaton, &chars, word, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "apply_at_compiled",
+				  "Call to \"word_init\" failed"))
+	{
+		word_free(&chars);
+		return NULL;
+	}
+
+	if (pos >= chars.len)
+	{
+		word_free(&chars);
+		return NULL;
+	}
+
+	grapheme = find_grapheme(g2p->automaton, chars.chars[pos]);
+	if (grapheme != NULL)
+		rule = match_rule(grapheme, &chars, pos);
+
+	if (rule < 0)
+	{
+		memset(alpha, 0, 8);
+		s_setc(alpha, chars.chars[pos], error);
+		word_free(&chars);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "apply_at_compiled",
+					  "Call to \"s_setc\" failed"))
+			return NULL;
+
+		/* issue warning */
+		if (grapheme == NULL)
+			S_WARNING(S_FAILURE,
+					  "ApplyAt",
+					  "Failed to find a g2p rule for character '%s' of word '%s'",
+					  alpha, word);
+		else
+			S_WARNING(S_FAILURE,
+					  "ApplyAt",
+					  "Failed to find a g2p rule match for character '%s' of word '%s'",
+					  alpha, word);
+		return NULL;
+	}
+
+	word_free(&chars);
+	return grapheme->phones[rule];
+}
+
+
 /************************************************************************************/
 /*                                                                                  */
 /* Static class function implementations                                            */
@@ -279,6 +1330,7 @@ static void Init(void *obj, s_erc *error)
 	S_CLR_ERR(error);
 	self->rules = NULL;
 	self->zeros = NULL;
+	self->automaton = NULL;
 }
 
 
@@ -303,6 +1355,9 @@ static void Destroy(void *obj, s_erc *error)
 
 		S_FREE(self->zeros);
 	}
+
+	if (self->automaton != NULL)
+		automaton_free(self->automaton);
 }
 
 
@@ -421,6 +1476,15 @@ static SList *Apply(const SG2P *self, const char *word, s_erc *error)
 		return NULL;
 	}
 
+	if (g2p->automaton != NULL)
+	{
+		phoneList = apply_compiled(g2p, word, error);
+		S_CHK_ERR(error, S_CONTERR,
+				  "Apply",
+				  "Call to \"apply_compiled\" failed");
+		return phoneList;
+	}
+
 	/* create a list for the phones */
 	phoneList = S_LIST(S_NEW(SListList, error));
 	if (S_CHK_ERR(error, S_CONTERR,
@@ -687,6 +1751,15 @@ static const char *ApplyAt(const SG2P *self, const char *word, uint index, s_erc
 		return NULL;
 	}
 
+	if (g2p->automaton != NULL)
+	{
+		matched_phone = apply_at_compiled(g2p, word, index, error);
+		S_CHK_ERR(error, S_CONTERR,
+				  "ApplyAt",
+				  "Call to \"apply_at_compiled\" failed");
+		return matched_phone;
+	}
+
 	/* +2 for # at begin and end */
 	word_size = s_strzsize(word, error) + 2;
 	if (S_CHK_ERR(error, S_CONTERR,
@@ -136,6 +136,13 @@ typedef struct
 } s_gzero;
 
 
+/**
+ * The rewrite rules compiled into context tries, see
+ * #_s_g2p_rewrites_compile. Opaque type.
+ */
+typedef struct s_g2p_automaton s_g2p_automaton;
+
+
 /************************************************************************************/
 /*                                                                                  */
 /* SG2PRewrites definition                                                          */
@@ -162,6 +169,12 @@ typedef struct
 	 * @protected Grapheme zero's.
 	 */
 	s_gzero   *zeros;
+
+	/**
+	 * @protected Compiled rules and zero's, used by @c apply and
+	 * @c apply_at when not @c NULL.
+	 */
+	s_g2p_automaton *automaton;
 } SG2PRewrites;
 
 
@@ -203,6 +216,23 @@ S_LOCAL void _s_g2p_rewrites_class_reg(s_erc *error);
 S_LOCAL void _s_g2p_rewrites_class_free(s_erc *error);
 
 
+/**
+ * Compile the rules and grapheme zero's of the given #SG2PRewrites
+ * for matching in a single left-to-right pass. The left and right
+ * contexts of the rules of each grapheme are stored in a trie whose
+ * nodes hold the set of rules matching up to that node, so that the
+ * first matching rule is found by following the word context once
+ * in each trie. Matching gives the same results as the rules in
+ * order, without any heap allocation for words shorter than 128
+ * characters.
+ * @private
+ *
+ * @param self The rewrites to compile.
+ * @param error Error code.
+ */
+S_LOCAL void _s_g2p_rewrites_compile(SG2PRewrites *self, s_erc *error);
+
+
 /************************************************************************************/
 /*                                                                                  */
 /* End external c declaration                                                       */
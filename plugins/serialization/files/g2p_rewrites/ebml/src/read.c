@@ -199,6 +199,13 @@ S_LOCAL SG2PRewrites *s_read_g2p_rewrites(SDatasource *ds, s_erc *error)
 		}
 	}
 
+	/* compile the rules for matching */
+	_s_g2p_rewrites_compile(g2p, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "s_read_g2p_rewrites",
+				  "Call to \"_s_g2p_rewrites_compile\" failed"))
+		goto quit_error;
+
 	/* if we get here then everything was OK */
 	goto quit;
 
@@ -156,6 +156,23 @@ static SObject *Load(const char *path, s_erc *error)
 }
 
 
+static SObject *LoadFromDatasource(SDatasource *ds, s_erc *error)
+{
+	SG2PRewrites *g2p;
+
+
+	S_CLR_ERR(error);
+
+	g2p = s_read_g2p_rewrites(ds, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "LoadFromDatasource",
+				  "Call to \"s_read_g2p_rewrites_ebml\" failed"))
+		return NULL;
+
+	return S_OBJECT(g2p);
+}
+
+
 static void Save(const SObject *object, const char *path, s_erc *error)
 {
 	S_CTX_ERR(error, S_FAILURE,
@@ -190,5 +207,6 @@ static SEBMLG2PRewritesFileClass EBMLG2PRewritesFileClass =
 	"spct_g2p_rewrites",       /* format  */
 	Load,                      /* load    */
 	Save,                      /* save    */
-	NULL                       /* save_to_datasource */
+	NULL,                      /* save_to_datasource   */
+	LoadFromDatasource         /* load_from_datasource */
 };
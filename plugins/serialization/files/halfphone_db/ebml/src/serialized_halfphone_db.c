@@ -156,6 +156,23 @@ static SObject *Load(const char *path, s_erc *error)
 }
 
 
+static SObject *LoadFromDatasource(SDatasource *ds, s_erc *error)
+{
+	SHalfphoneDBEbml *db;
+
+
+	S_CLR_ERR(error);
+
+	db = s_read_halfphone_db_ebml(ds, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "LoadFromDatasource",
+				  "Call to \"s_read_halfphone_db_ebml\" failed"))
+		return NULL;
+
+	return S_OBJECT(db);
+}
+
+
 static void Save(const SObject *object, const char *path, s_erc *error)
 {
 	S_CTX_ERR(error, S_FAILURE,
@@ -190,5 +207,6 @@ static SEBMLHalfphoneDBFileClass EBMLHalfphoneDBFileClass =
 	"spct_halfphone_db",       /* format  */
 	Load,                      /* load    */
 	Save,                      /* save    */
-	NULL                       /* save_to_datasource */
+	NULL,                      /* save_to_datasource   */
+	LoadFromDatasource         /* load_from_datasource */
 };
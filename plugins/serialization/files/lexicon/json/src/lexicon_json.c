@@ -502,6 +502,62 @@ static SList *GetWord(const SLexicon *self, const char *word,
 }
 
 
+static void ForeachWord(const SLexicon *self, s_lexicon_word_fp func, void *userdata,
+						s_erc *error)
+{
+	const SLexiconJSON *lex = S_LEXICON_JSON(self);
+	SIterator *itr;
+	const char *word;
+	const SList *info;
+	s_bool syllabified;
+
+
+	S_CLR_ERR(error);
+	if (func == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "ForeachWord",
+				  "Argument \"func\" is NULL");
+		return;
+	}
+
+	if (lex->entries == NULL)
+		return;
+
+	itr = S_ITERATOR_GET(lex->entries, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "ForeachWord",
+				  "Call to \"S_ITERATOR_GET\" failed"))
+		return;
+
+	for (/* NOP */; itr != NULL; itr = SIteratorNext(itr))
+	{
+		word = SIteratorKey(itr, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "ForeachWord",
+					  "Call to \"SIteratorKey\" failed"))
+			break;
+
+		info = get_word_info(SIteratorObject(itr, error), NULL, &syllabified, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "ForeachWord",
+					  "Failed to get phones/syllables for word '%s'",
+					  word))
+			break;
+
+		func(word, info, syllabified, userdata, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "ForeachWord",
+					  "Call to word function failed for word '%s'",
+					  word))
+			break;
+	}
+
+	if (itr != NULL)
+		S_DELETE(itr, "ForeachWord", error);
+}
+
+
 /************************************************************************************/
 /*                                                                                  */
 /* SLexicon class initialization                                                    */
@@ -529,5 +585,6 @@ static SLexiconJSONClass LexiconJSONClass =
 	GetLangCode,         /* get_lang_code   */
 	SGetVersion,         /* get_version     */
 	GetFeature,          /* get_feature     */
-	GetWord              /* get_word        */
+	GetWord,             /* get_word        */
+	ForeachWord          /* foreach_word    */
 };
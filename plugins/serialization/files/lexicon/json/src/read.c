@@ -58,7 +58,7 @@ static void set_lex_info(SLexicon *lex, const SMap *lexDef, s_erc *error);
 /*                                                                                  */
 /************************************************************************************/
 
-S_LOCAL SLexiconJSON *s_read_lexicon_json(const char *path, s_erc *error)
+S_LOCAL SLexiconJSON *s_read_lexicon_json(SDatasource *ds, s_erc *error)
 {
 	SLexiconJSON *lex = NULL;
 	SMap *parsedFile = NULL;
@@ -75,13 +75,16 @@ S_LOCAL SLexiconJSON *s_read_lexicon_json(const char *path, s_erc *error)
 	if (S_CHK_ERR(error, S_CONTERR,
 				  "s_read_lexicon_json",
 				  "Failed to create new lexicon object"))
+	{
+		S_DELETE(ds, "s_read_lexicon_json", error);
 		goto quit_error;
+	}
 
-	/* read the JSON file into a SMAP */
-	parsedFile = s_json_parse_config_file(path, error);
+	/* read the JSON data source into a SMAP */
+	parsedFile = s_json_parse_config_datasource(ds, error);
 	if (S_CHK_ERR(error, S_CONTERR,
 				  "s_read_lexicon_json",
-				  "Call to \"s_json_parse_config_file\" failed"))
+				  "Call to \"s_json_parse_config_datasource\" failed"))
 		goto quit_error;
 
 	/* get "lexicon-definition" key */
@@ -135,13 +135,37 @@ static void Dispose(void *obj, s_erc *error)
 static SObject *Load(const char *path, s_erc *error)
 {
 	SLexiconJSON *lex;
+	SDatasource *ds;
 
 
 	S_CLR_ERR(error);
 
-	lex = s_read_lexicon_json(path, error);
+	ds = SFilesourceOpenFile(path, "r", error);
 	if (S_CHK_ERR(error, S_CONTERR,
 				  "Load",
+				  "Call to \"SFilesourceOpenFile\" failed"))
+		return NULL;
+
+	lex = s_read_lexicon_json(ds, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "Load",
+				  "Call to \"s_read_lexicon_json\" failed"))
+		return NULL;
+
+	return S_OBJECT(lex);
+}
+
+
+static SObject *LoadFromDatasource(SDatasource *ds, s_erc *error)
+{
+	SLexiconJSON *lex;
+
+
+	S_CLR_ERR(error);
+
+	lex = s_read_lexicon_json(ds, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "LoadFromDatasource",
 				  "Call to \"s_read_lexicon_json\" failed"))
 		return NULL;
 
@@ -183,6 +207,7 @@ static SJSONLexiconFileClass JSONLexiconFileClass =
 	"spct_lexicon",            /* format  */
 	Load,                      /* load    */
 	Save,                      /* save    */
-	NULL                       /* save_to_datasource */
+	NULL,                      /* save_to_datasource   */
+	LoadFromDatasource         /* load_from_datasource */
 
 };
@@ -96,15 +96,16 @@ S_LOCAL void _s_serialized_json_lexicon_free(s_erc *error);
 
 
 /**
- * Read an JSON format lexicon from the given file.
+ * Read a JSON format lexicon from the given data source.
  *
- * @param path The full path and file name of the JSON format lexicon
- * to read.
+ * @param ds The data source to read the lexicon from. The
+ * function takes hold of the data source, it is deleted when reading
+ * is done (also on errors).
  * @param error Error code.
  *
  * @return Loaded lexicon or @c NULL on error.
  */
-S_LOCAL SLexiconJSON *s_read_lexicon_json(const char *path, s_erc *error);
+S_LOCAL SLexiconJSON *s_read_lexicon_json(SDatasource *ds, s_erc *error);
 
 
 /************************************************************************************/
@@ -0,0 +1,31 @@
+######################################################################################
+##                                                                                  ##
+## AUTHOR  : Speect contributors                                                    ##
+## DATE    : 19 October 2026                                                        ##
+##                                                                                  ##
+######################################################################################
+##                                                                                  ##
+## Source files for Lexicon Trie formatter plug-in                                  ##
+##                                                                                  ##
+##                                                                                  ##
+######################################################################################
+
+
+######## source files ##################
+
+speect_plugin_sources(
+  src/plugin.c
+  src/lexicon_trie.c
+  src/serialized_lex_trie.c
+  src/read.c
+  src/write.c
+  )
+ 
+
+######## header files ##################
+
+speect_plugin_headers(
+  src/lexicon_trie.h
+  src/serialized_lex_trie.h
+  )
+
@@ -0,0 +1,680 @@
+/************************************************************************************/
+/* Copyright (c) 2009-2011 The Department of Arts and Culture,                      */
+/* The Government of the Republic of South Africa.                                  */
+/*                                                                                  */
+/* Contributors:  Meraka Institute, CSIR, South Africa.                             */
+/*                                                                                  */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy     */
+/* of this software and associated documentation files (the "Software"), to deal    */
+/* in the Software without restriction, including without limitation the rights     */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        */
+/* copies of the Software, and to permit persons to whom the Software is            */
+/* furnished to do so, subject to the following conditions:                         */
+/* The above copyright notice and this permission notice shall be included in       */
+/* all copies or substantial portions of the Software.                              */
+/*                                                                                  */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN        */
+/* THE SOFTWARE.                                                                    */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* AUTHOR  : Speect contributors                                                    */
+/* DATE    : 19 October 2026                                                        */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* A lexicon class implementation with the lexicon entries in a compact             */
+/* trie format that is memory mapped from file. Inherits from SLexicon.             */
+/*                                                                                  */
+/*                                                                                  */
+/************************************************************************************/
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Modules used                                                                     */
+/*                                                                                  */
+/************************************************************************************/
+
+#include <string.h>
+#include "lexicon_trie.h"
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static variables                                                                 */
+/*                                                                                  */
+/************************************************************************************/
+
+static SLexiconTrieClass LexiconTrieClass; /* SLexiconTrie class declaration. */
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static function prototypes                                                       */
+/*                                                                                  */
+/************************************************************************************/
+
+static uint32 find_word(const SLexiconTrie *self, const char *word, s_erc *error);
+
+static const char *get_string(const SLexiconTrie *self, uint32 offset, s_erc *error);
+
+static s_bool check_if_match(const SLexiconTrie *self, uint32 record,
+							 const SMap *features, s_erc *error);
+
+static SList *get_phones(const SLexiconTrie *self, const s_lexicon_trie_pron *pron,
+						 s_erc *error);
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Plug-in class registration/free                                                  */
+/*                                                                                  */
+/************************************************************************************/
+
+
+/* local functions to register and free classes */
+S_LOCAL void _s_lexicon_trie_class_reg(s_erc *error)
+{
+	S_CLR_ERR(error);
+	s_class_reg(S_OBJECTCLASS(&LexiconTrieClass), error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "_s_lexicon_trie_class_reg",
+			  "Failed to register SLexiconTrieClass");
+}
+
+
+S_LOCAL void _s_lexicon_trie_class_free(s_erc *error)
+{
+	S_CLR_ERR(error);
+	s_class_free(S_OBJECTCLASS(&LexiconTrieClass), error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "_s_lexicon_trie_class_free",
+			  "Failed to free SLexiconTrieClass");
+}
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static function implementations                                                  */
+/*                                                                                  */
+/************************************************************************************/
+
+/* word index of the given word, or S_LEXICON_TRIE_NONE */
+static uint32 find_word(const SLexiconTrie *self, const char *word, s_erc *error)
+{
+	const uchar *c;
+	uint32 node = 0;
+	uint32 low;
+	uint32 high;
+	uint32 mid;
+	uint32 num_arcs = self->header.num_nodes - 1;
+
+
+	S_CLR_ERR(error);
+
+	for (c = (const uchar*)word; *c != '\0'; c++)
+	{
+		low = self->nodes[node];
+		high = self->nodes[node + 1];
+
+		if ((low > high) || (high > num_arcs))
+		{
+			S_CTX_ERR(error, S_FAILURE,
+					  "find_word",
+					  "Lexicon data is corrupt (arcs of node %d)", node);
+			return S_LEXICON_TRIE_NONE;
+		}
+
+		/* binary search of the sorted arc labels */
+		while (low < high)
+		{
+			mid = low + ((high - low) / 2);
+			if (self->labels[mid] < *c)
+				low = mid + 1;
+			else
+				high = mid;
+		}
+
+		if ((low == self->nodes[node + 1]) || (self->labels[low] != *c))
+			return S_LEXICON_TRIE_NONE;
+
+		node = low + 1;
+	}
+
+	if ((self->words[node] != S_LEXICON_TRIE_NONE)
+		&& (self->words[node] >= self->header.num_words))
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "find_word",
+				  "Lexicon data is corrupt (word of node %d)", node);
+		return S_LEXICON_TRIE_NONE;
+	}
+
+	return self->words[node];
+}
+
+
+static const char *get_string(const SLexiconTrie *self, uint32 offset, s_erc *error)
+{
+	S_CLR_ERR(error);
+
+	if (offset >= self->header.strings_size)
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "get_string",
+				  "Lexicon data is corrupt (string offset %d)", offset);
+		return NULL;
+	}
+
+	return self->strings + offset;
+}
+
+
+/* all the given features must be in the feature record with equal values */
+static s_bool check_if_match(const SLexiconTrie *self, uint32 record,
+							 const SMap *features, s_erc *error)
+{
+	const uint32 *triples;
+	uint32 count;
+	SIterator *itr;
+	const char *key;
+	const SObject *featuresObject;
+	s_bool match;
+	uint32 i;
+
+
+	S_CLR_ERR(error);
+
+	if ((record >= self->header.features_size)
+		|| (self->feature_records[record] > ((self->header.features_size - record - 1) / 3)))
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "check_if_match",
+				  "Lexicon data is corrupt (feature record %d)", record);
+		return FALSE;
+	}
+
+	count = self->feature_records[record];
+	triples = self->feature_records + record + 1;
+
+	itr = S_ITERATOR_GET(features, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "check_if_match",
+				  "Call to \"S_ITERATOR_GET\" failed"))
+		return FALSE;
+
+	for (/* NOP */; itr != NULL; itr = SIteratorNext(itr))
+	{
+		key = SIteratorKey(itr, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "check_if_match",
+					  "Call to \"SIteratorKey\" failed"))
+			goto quit_error;
+
+		featuresObject = SIteratorObject(itr, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "check_if_match",
+					  "Call to \"SIteratorObject\" failed"))
+			goto quit_error;
+
+		/* feature must be present */
+		for (i = 0; i < count; i++)
+		{
+			const char *entry_key = get_string(self, triples[i * 3], error);
+
+
+			if (S_CHK_ERR(error, S_CONTERR,
+						  "check_if_match",
+						  "Call to \"get_string\" failed"))
+				goto quit_error;
+
+			if (s_strcmp(key, entry_key, error) == 0)
+				break;
+		}
+
+		if (i == count)
+			goto no_match;
+
+		match = FALSE;
+		switch (triples[(i * 3) + 1])
+		{
+		case S_LEXICON_TRIE_FEAT_STRING:
+		{
+			const char *value;
+
+
+			if (!SObjectIsType(featuresObject, "SString", error))
+				break;
+
+			value = get_string(self, triples[(i * 3) + 2], error);
+			if (S_CHK_ERR(error, S_CONTERR,
+						  "check_if_match",
+						  "Call to \"get_string\" failed"))
+				goto quit_error;
+
+			match = (s_strcmp(SObjectGetString(featuresObject, error), value, error) == 0);
+			break;
+		}
+		case S_LEXICON_TRIE_FEAT_INT:
+		{
+			if (!SObjectIsType(featuresObject, "SInt", error))
+				break;
+
+			match = (SObjectGetInt(featuresObject, error) == (sint32)triples[(i * 3) + 2]);
+			break;
+		}
+		case S_LEXICON_TRIE_FEAT_FLOAT:
+		{
+			float value;
+
+
+			if (!SObjectIsType(featuresObject, "SFloat", error))
+				break;
+
+			memcpy(&value, &triples[(i * 3) + 2], sizeof(float));
+			match = (SObjectGetFloat(featuresObject, error) == value);
+			break;
+		}
+		default:
+			S_CTX_ERR(error, S_FAILURE,
+					  "check_if_match",
+					  "Lexicon data is corrupt (feature type %d)",
+					  triples[(i * 3) + 1]);
+			goto quit_error;
+		}
+
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "check_if_match",
+					  "Failed to compare feature '%s'", key))
+			goto quit_error;
+
+		if (!match)
+			goto no_match;
+
+		/* continue if this one matched */
+	}
+
+	/* if we get here then they matched */
+	return TRUE;
+
+no_match:
+	S_DELETE(itr, "check_if_match", error);
+	return FALSE;
+
+quit_error:
+	{
+		s_erc local_err = S_SUCCESS;
+
+
+		S_DELETE(itr, "check_if_match", &local_err);
+	}
+
+	return FALSE;
+}
+
+
+/* the phones (or syllables of phones) of the given pronunciation */
+static SList *get_phones(const SLexiconTrie *self, const s_lexicon_trie_pron *pron,
+						 s_erc *error)
+{
+	SList *phoneList = NULL;
+	SList *syllable = NULL;
+	const char *phone;
+	uint16 id;
+	uint32 i;
+
+
+	S_CLR_ERR(error);
+
+	if ((pron->phones > self->header.phones_size)
+		|| (pron->num_phones > (self->header.phones_size - pron->phones)))
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "get_phones",
+				  "Lexicon data is corrupt (phones %d)", pron->phones);
+		return NULL;
+	}
+
+	phoneList = S_LIST(S_NEW(SListList, error));
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "get_phones",
+				  "Failed to create new 'SList' object"))
+		return NULL;
+
+	for (i = 0; i <= pron->num_phones; i++)
+	{
+		id = (i < pron->num_phones) ? self->phones[pron->phones + i] : S_LEXICON_TRIE_SYLLABLE_BREAK;
+
+		if (pron->syllabified && (syllable == NULL) && (i < pron->num_phones))
+		{
+			syllable = S_LIST(S_NEW(SListList, error));
+			if (S_CHK_ERR(error, S_CONTERR,
+						  "get_phones",
+						  "Failed to create new 'SList' object"))
+				goto quit_error;
+		}
+
+		if (id == S_LEXICON_TRIE_SYLLABLE_BREAK)
+		{
+			if (syllable == NULL)
+				continue;
+
+			SListAppend(phoneList, S_OBJECT(syllable), error);
+			if (S_CHK_ERR(error, S_CONTERR,
+						  "get_phones",
+						  "Call to \"SListAppend\" failed"))
+				goto quit_error;
+
+			syllable = NULL;
+			continue;
+		}
+
+		if (id >= self->header.num_phones)
+		{
+			S_CTX_ERR(error, S_FAILURE,
+					  "get_phones",
+					  "Lexicon data is corrupt (phone %d)", id);
+			goto quit_error;
+		}
+
+		phone = get_string(self, self->phone_names[id], error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "get_phones",
+					  "Call to \"get_string\" failed"))
+			goto quit_error;
+
+		SListAppend((syllable != NULL) ? syllable : phoneList,
+					SObjectSetString(phone, error), error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "get_phones",
+					  "Call to \"SListAppend\" failed"))
+			goto quit_error;
+	}
+
+	return phoneList;
+
+quit_error:
+	{
+		s_erc local_err = S_SUCCESS;
+
+
+		if (syllable != NULL)
+			S_DELETE(syllable, "get_phones", &local_err);
+
+		S_DELETE(phoneList, "get_phones", &local_err);
+	}
+
+	return NULL;
+}
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static class function implementations                                            */
+/*                                                                                  */
+/************************************************************************************/
+
+static void Init(void *obj, s_erc *error)
+{
+	SLexiconTrie *self = obj;
+
+
+	S_CLR_ERR(error);
+	self->data = NULL;
+	self->data_size = 0;
+	self->handle = NULL;
+	self->source = NULL;
+	memset(&(self->header), 0, sizeof(s_lexicon_trie_header));
+	self->nodes = NULL;
+	self->words = NULL;
+	self->labels = NULL;
+	self->word_prons = NULL;
+	self->prons = NULL;
+	self->feature_records = NULL;
+	self->phone_names = NULL;
+	self->phones = NULL;
+	self->strings = NULL;
+}
+
+
+static void Destroy(void *obj, s_erc *error)
+{
+	SLexiconTrie *self = obj;
+
+
+	S_CLR_ERR(error);
+
+	if (self->handle != NULL)
+	{
+		s_mmapfile_close(self->handle, self->data, error);
+		S_CHK_ERR(error, S_CONTERR,
+				  "Destroy",
+				  "Call to \"s_mmapfile_close\" failed");
+	}
+	else if (self->source != NULL)
+	{
+		/* data is the memory of the source */
+		S_DELETE(self->source, "Destroy", error);
+	}
+	else if (self->data != NULL)
+	{
+		S_FREE(self->data);
+	}
+}
+
+
+static void Dispose(void *obj, s_erc *error)
+{
+	S_CLR_ERR(error);
+	SObjectDecRef(obj);
+}
+
+
+static const char *GetName(const SLexicon *self, s_erc *error)
+{
+	S_CLR_ERR(error);
+
+	if (self->info == NULL)
+		return NULL;
+
+
+	return (const char*)self->info->name;
+}
+
+
+static const char *GetDescription(const SLexicon *self, s_erc *error)
+{
+	S_CLR_ERR(error);
+
+	if (self->info == NULL)
+		return NULL;
+
+
+	return (const char*)self->info->description;
+}
+
+
+static const char *GetLanguage(const SLexicon *self, s_erc *error)
+{
+	S_CLR_ERR(error);
+
+	if (self->info == NULL)
+		return NULL;
+
+
+	return (const char*)self->info->language;
+}
+
+
+static const char *GetLangCode(const SLexicon *self, s_erc *error)
+{
+	S_CLR_ERR(error);
+
+	if (self->info == NULL)
+		return NULL;
+
+
+	return (const char*)self->info->lang_code;
+}
+
+
+static const s_version *SGetVersion(const SLexicon *self, s_erc *error)
+{
+	S_CLR_ERR(error);
+
+	if (self->info == NULL)
+		return NULL;
+
+
+	return (const s_version*)&(self->info->version);
+}
+
+static const SObject *GetFeature(const SLexicon *self, const char *key,
+								 s_erc *error)
+{
+	const SObject *feature;
+
+
+	S_CLR_ERR(error);
+	if (key == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "GetFeature",
+				  "Argument \"key\" is NULL");
+		return NULL;
+	}
+
+	if (self->features == NULL)
+		return NULL;
+
+	feature = SMapGetObjectDef(self->features, key, NULL, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "GetFeature",
+				  "Call to \"SMapGetObjectDef\" failed"))
+		return NULL;
+
+	return feature;
+}
+
+
+static SList *GetWord(const SLexicon *self, const char *word,
+					  const SMap *features, s_bool *syllabified,
+					  s_erc *error)
+{
+	const SLexiconTrie *lex = S_LEXICON_TRIE(self);
+	const s_lexicon_trie_pron *pron = NULL;
+	SList *phoneList;
+	s_bool matches;
+	uint32 index;
+	uint32 first;
+	uint32 last;
+
+
+	S_CLR_ERR(error);
+	if (word == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "GetWord",
+				  "Argument \"word\" is NULL");
+		return NULL;
+	}
+
+	if (syllabified == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "GetWord",
+				  "Argument \"syllabified\" is NULL");
+		return NULL;
+	}
+
+	if (lex->data == NULL)
+		return NULL;
+
+	index = find_word(lex, word, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "GetWord",
+				  "Call to \"find_word\" failed"))
+		return NULL;
+
+	if (index == S_LEXICON_TRIE_NONE)
+		return NULL; /* word not found */
+
+	first = lex->word_prons[index];
+	last = lex->word_prons[index + 1];
+	if ((first >= last) || (last > lex->header.num_prons))
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "GetWord",
+				  "Lexicon data is corrupt (entries of word '%s')", word);
+		return NULL;
+	}
+
+	/*
+	 * return the first entry that matches the given features, as
+	 * the JSON lexicon the last entry is used if none match.
+	 */
+	for (/* NOP */; first < last; first++)
+	{
+		pron = &(lex->prons[first]);
+
+		if (features == NULL)
+			break; /* we take the first entry */
+
+		matches = check_if_match(lex, pron->features, features, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "GetWord",
+					  "Call to \"check_if_match\" failed"))
+			return NULL;
+
+		if (matches)
+			break;
+	}
+
+	phoneList = get_phones(lex, pron, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "GetWord",
+				  "Failed to get phones/syllables for word '%s'",
+				  word))
+		return NULL;
+
+	*syllabified = pron->syllabified ? TRUE : FALSE;
+	return phoneList;
+}
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* SLexicon class initialization                                                    */
+/*                                                                                  */
+/************************************************************************************/
+
+static SLexiconTrieClass LexiconTrieClass =
+{
+	/* SObjectClass */
+	{
+		"SLexicon:SLexiconTrie",
+		sizeof(SLexiconTrie),
+		{ 0, 1},
+		Init,            /* init    */
+		Destroy,         /* destroy */
+		Dispose,         /* dispose */
+		NULL,            /* compare */
+		NULL,            /* print   */
+		NULL,            /* copy    */
+	},
+	/* SLexiconClass */
+	GetName,             /* get_name        */
+	GetDescription,      /* get_description */
+	GetLanguage,         /* get_language    */
+	GetLangCode,         /* get_lang_code   */
+	SGetVersion,         /* get_version     */
+	GetFeature,          /* get_feature     */
+	GetWord,             /* get_word        */
+	NULL                 /* foreach_word    */
+};
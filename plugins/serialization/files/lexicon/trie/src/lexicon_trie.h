@@ -0,0 +1,337 @@
+/************************************************************************************/
+/* Copyright (c) 2009-2011 The Department of Arts and Culture,                      */
+/* The Government of the Republic of South Africa.                                  */
+/*                                                                                  */
+/* Contributors:  Meraka Institute, CSIR, South Africa.                             */
+/*                                                                                  */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy     */
+/* of this software and associated documentation files (the "Software"), to deal    */
+/* in the Software without restriction, including without limitation the rights     */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        */
+/* copies of the Software, and to permit persons to whom the Software is            */
+/* furnished to do so, subject to the following conditions:                         */
+/* The above copyright notice and this permission notice shall be included in       */
+/* all copies or substantial portions of the Software.                              */
+/*                                                                                  */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN        */
+/* THE SOFTWARE.                                                                    */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* AUTHOR  : Speect contributors                                                    */
+/* DATE    : 19 October 2026                                                        */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* A lexicon class implementation with the lexicon entries in a compact             */
+/* trie format that is memory mapped from file. Inherits from SLexicon.             */
+/*                                                                                  */
+/*                                                                                  */
+/************************************************************************************/
+
+#ifndef _SPCT_PLUGIN_LEXICON_TRIE_H__
+#define _SPCT_PLUGIN_LEXICON_TRIE_H__
+
+
+/**
+ * @file lexicon_trie.h
+ * A lexicon class implementation with the lexicon entries in a
+ * compact trie format that is memory mapped from file.
+ */
+
+
+/**
+ * @ingroup SLexicon
+ * @defgroup SLexiconTrie Trie Lexicon
+ * A lexicon class implementation with the lexicon entries in a
+ * compact trie format. Inherits from SLexicon.
+ *
+ * The words are stored in a byte trie, and the pronunciations as
+ * arrays of phone identifiers. All the data is kept in one flat
+ * block that is memory mapped from the file and queried in place, no
+ * objects are created for the lexicon entries. The format is written
+ * from a JSON format lexicon with the @c speect-compile-lexicon
+ * tool, and is loaded with the @c "spct_lexicon_trie" format.
+ *
+ * The file starts with a #s_lexicon_trie_header, followed by the
+ * sections it gives the offsets of:
+ * <ul>
+ *  <li> @c nodes: <tt>num_nodes + 1</tt> @c uint32, the index of
+ *       the first arc of each node. The arcs of node @c i are
+ *       <tt>nodes[i]</tt> to <tt>nodes[i + 1] - 1</tt>, and arc @c a
+ *       leads to node <tt>a + 1</tt> (nodes are in breadth first
+ *       order, node 0 is the root). </li>
+ *  <li> @c words: @c num_nodes @c uint32, the word index of each
+ *       node or #S_LEXICON_TRIE_NONE. </li>
+ *  <li> @c labels: <tt>num_nodes - 1</tt> bytes, the label of each
+ *       arc, sorted per node. Labels are the bytes of the UTF-8
+ *       words. </li>
+ *  <li> @c word_prons: <tt>num_words + 1</tt> @c uint32, the
+ *       pronunciations of word @c w are <tt>word_prons[w]</tt> to
+ *       <tt>word_prons[w + 1] - 1</tt>, in lexicon order. </li>
+ *  <li> @c prons: @c num_prons #s_lexicon_trie_pron. </li>
+ *  <li> @c features: @c features_size @c uint32, feature records of
+ *       a count followed by (key, type, value) triples, see
+ *       #s_lexicon_trie_feature_type. </li>
+ *  <li> @c phone_names: @c num_phones @c uint32, the string offset
+ *       of each phone name. </li>
+ *  <li> @c phones: @c phones_size @c uint16, phone identifiers, with
+ *       #S_LEXICON_TRIE_SYLLABLE_BREAK between syllables. </li>
+ *  <li> @c strings: @c strings_size bytes of @c NULL terminated
+ *       strings. </li>
+ * </ul>
+ * The data is in the byte order of the machine that wrote it.
+ * @{
+ */
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Modules used                                                                     */
+/*                                                                                  */
+/************************************************************************************/
+
+#include "speect.h"
+#include "lexicon.h"
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Begin external c declaration                                                     */
+/*                                                                                  */
+/************************************************************************************/
+S_BEGIN_C_DECLS
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Macros                                                                           */
+/*                                                                                  */
+/************************************************************************************/
+
+/**
+ * @hideinitializer
+ * Return the given #SLexiconTrie child/parent class object as a
+ * #SLexiconTrie object.
+ *
+ * @param SELF The given object.
+ *
+ * @return Given object as #SLexiconTrie* type.
+ * @note This casting is not safety checked.
+ */
+#define S_LEXICON_TRIE(SELF)    ((SLexiconTrie *)(SELF))
+
+
+/**
+ * The magic bytes at the start of a trie lexicon file.
+ */
+#define S_LEXICON_TRIE_MAGIC "SPCTLEXT"
+
+
+/**
+ * Byte order mark of a trie lexicon file.
+ */
+#define S_LEXICON_TRIE_BYTE_ORDER 0x01020304
+
+
+/**
+ * Version of the trie lexicon file format.
+ */
+#define S_LEXICON_TRIE_FORMAT_VERSION 1
+
+
+/**
+ * No index.
+ */
+#define S_LEXICON_TRIE_NONE 0xFFFFFFFF
+
+
+/**
+ * Syllable boundary in the phones of a syllabified pronunciation.
+ */
+#define S_LEXICON_TRIE_SYLLABLE_BREAK 0xFFFF
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Data types                                                                       */
+/*                                                                                  */
+/************************************************************************************/
+
+/**
+ * The header of a trie lexicon file. String fields are offsets in the
+ * strings section, section offsets are byte offsets from the start of
+ * the file.
+ */
+typedef struct
+{
+	char   magic[8];          /*!< #S_LEXICON_TRIE_MAGIC, not @c NULL terminated. */
+	uint32 byte_order;        /*!< #S_LEXICON_TRIE_BYTE_ORDER.                      */
+	uint32 format_version;    /*!< #S_LEXICON_TRIE_FORMAT_VERSION.                  */
+	uint32 name;              /*!< Lexicon name.                                    */
+	uint32 description;       /*!< Lexicon description.                             */
+	uint32 language;          /*!< Lexicon language.                                */
+	uint32 lang_code;         /*!< Lexicon language code.                           */
+	uint32 version_major;     /*!< Lexicon major version.                           */
+	uint32 version_minor;     /*!< Lexicon minor version.                           */
+	uint32 features;          /*!< Feature record of the lexicon features.          */
+	uint32 num_nodes;         /*!< Number of trie nodes.                            */
+	uint32 num_words;         /*!< Number of words.                                 */
+	uint32 num_prons;         /*!< Number of pronunciations.                        */
+	uint32 num_phones;        /*!< Number of phone names.                           */
+	uint32 features_size;     /*!< Size of the features section in @c uint32.       */
+	uint32 phones_size;       /*!< Size of the phones section in @c uint16.         */
+	uint32 strings_size;      /*!< Size of the strings section in bytes.            */
+	uint32 nodes_offset;      /*!< Offset of the nodes section.                     */
+	uint32 words_offset;      /*!< Offset of the words section.                     */
+	uint32 labels_offset;     /*!< Offset of the labels section.                    */
+	uint32 word_prons_offset; /*!< Offset of the word pronunciations section.       */
+	uint32 prons_offset;      /*!< Offset of the pronunciations section.            */
+	uint32 features_offset;   /*!< Offset of the features section.                  */
+	uint32 phone_names_offset; /*!< Offset of the phone names section.               */
+	uint32 phones_offset;     /*!< Offset of the phones section.                    */
+	uint32 strings_offset;    /*!< Offset of the strings section.                   */
+} s_lexicon_trie_header;
+
+
+/**
+ * A pronunciation of a word in a trie lexicon file.
+ */
+typedef struct
+{
+	uint32 features;    /*!< Feature record of the entry (POS and others). */
+	uint32 phones;      /*!< Index of the first phone.                      */
+	uint32 num_phones;  /*!< Number of phones, including syllable breaks.   */
+	uint32 syllabified; /*!< If the phones are split in syllables.          */
+} s_lexicon_trie_pron;
+
+
+/**
+ * Type of the value of a feature in a feature record.
+ */
+typedef enum
+{
+	S_LEXICON_TRIE_FEAT_STRING = 0, /*!< String offset. */
+	S_LEXICON_TRIE_FEAT_INT    = 1, /*!< Signed integer. */
+	S_LEXICON_TRIE_FEAT_FLOAT  = 2  /*!< Float bits.     */
+} s_lexicon_trie_feature_type;
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* SLexiconTrie definition                                                          */
+/*                                                                                  */
+/************************************************************************************/
+
+/**
+ * The SLexiconTrie structure.
+ * @extends SLexicon
+ */
+typedef struct
+{
+	/**
+	 * @protected Inherit from #SLexicon.
+	 */
+	SLexicon                   obj;
+
+	/**
+	 * @protected Lexicon data, mapped or read from file, or the
+	 * memory of @c source.
+	 */
+	uint8                     *data;
+
+	/**
+	 * @protected Size of the lexicon data in bytes.
+	 */
+	size_t                     data_size;
+
+	/**
+	 * @protected Memory mapped file handle, @c NULL if the data was
+	 * read into memory.
+	 */
+	s_mmap_file_handle        *handle;
+
+	/**
+	 * @protected Memory data source of which the memory is used in
+	 * place (for example a slice of a voice image), owned by the
+	 * lexicon and deleted with it, or @c NULL.
+	 */
+	SDatasource               *source;
+
+	/**
+	 * @protected The file header.
+	 */
+	s_lexicon_trie_header      header;
+
+	/**
+	 * @protected Sections of the data, see #s_lexicon_trie_header.
+	 */
+	const uint32              *nodes;
+	const uint32              *words;
+	const uint8               *labels;
+	const uint32              *word_prons;
+	const s_lexicon_trie_pron *prons;
+	const uint32              *feature_records;
+	const uint32              *phone_names;
+	const uint16              *phones;
+	const char                *strings;
+} SLexiconTrie;
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* SLexiconTrieClass definition                                                     */
+/*                                                                                  */
+/************************************************************************************/
+
+/**
+ * Definition of the SLexiconTrie class. This class adds no class methods to the
+ * #SLexiconClass and is therefore exactly the same.
+ */
+typedef SLexiconClass SLexiconTrieClass;
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Plug-in class registration/free                                                  */
+/*                                                                                  */
+/************************************************************************************/
+
+/**
+ * Register the #SLexiconTrie plug-in class with the Speect Engine object
+ * system.
+ * @private
+ *
+ * @param error Error code.
+ */
+S_LOCAL void _s_lexicon_trie_class_reg(s_erc *error);
+
+/**
+ * Free the #SLexiconTrie plug-in class from the Speect Engine object
+ * system.
+ * @private
+ *
+ * @param error Error code.
+ */
+S_LOCAL void _s_lexicon_trie_class_free(s_erc *error);
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* End external c declaration                                                       */
+/*                                                                                  */
+/************************************************************************************/
+S_END_C_DECLS
+
+
+/**
+ * @}
+ * end documentation
+ */
+
+#endif /* _SPCT_PLUGIN_LEXICON_TRIE_H__ */
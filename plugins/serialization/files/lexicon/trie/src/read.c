@@ -0,0 +1,544 @@
+/************************************************************************************/
+/* Copyright (c) 2009-2011 The Department of Arts and Culture,                      */
+/* The Government of the Republic of South Africa.                                  */
+/*                                                                                  */
+/* Contributors:  Meraka Institute, CSIR, South Africa.                             */
+/*                                                                                  */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy     */
+/* of this software and associated documentation files (the "Software"), to deal    */
+/* in the Software without restriction, including without limitation the rights     */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        */
+/* copies of the Software, and to permit persons to whom the Software is            */
+/* furnished to do so, subject to the following conditions:                         */
+/* The above copyright notice and this permission notice shall be included in       */
+/* all copies or substantial portions of the Software.                              */
+/*                                                                                  */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN        */
+/* THE SOFTWARE.                                                                    */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* AUTHOR  : Speect contributors                                                    */
+/* DATE    : 19 October 2026                                                        */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* Read trie format lexicons.                                                       */
+/*                                                                                  */
+/*                                                                                  */
+/************************************************************************************/
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Modules used                                                                     */
+/*                                                                                  */
+/************************************************************************************/
+
+#include <string.h>
+#include "serialized_lex_trie.h"
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Defines                                                                          */
+/*                                                                                  */
+/************************************************************************************/
+
+/* size of the blocks in which a data source is read */
+#define S_LEXICON_TRIE_READ_BLOCK 65536
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static function prototypes                                                       */
+/*                                                                                  */
+/************************************************************************************/
+
+static const void *get_section(const SLexiconTrie *lex, uint32 offset, uint32 count,
+							   size_t elem_size, const char *name, s_erc *error);
+
+static void set_lex_data(SLexiconTrie *lex, s_erc *error);
+
+static void set_lex_info(SLexiconTrie *lex, s_erc *error);
+
+static void set_lex_features(SLexiconTrie *lex, s_erc *error);
+
+static s_bool use_in_place(SLexiconTrie *lex, SDatasource *ds, s_erc *error);
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Function implementations                                                         */
+/*                                                                                  */
+/************************************************************************************/
+
+S_LOCAL SLexiconTrie *s_read_lexicon_trie_file(const char *path, s_erc *error)
+{
+	SLexiconTrie *lex = NULL;
+
+
+	S_CLR_ERR(error);
+
+	/* create lexicon */
+	lex = S_NEW(SLexiconTrie, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "s_read_lexicon_trie_file",
+				  "Failed to create new lexicon object"))
+		return NULL;
+
+	lex->handle = s_mmapfile_open(path, &(lex->data_size), &(lex->data), error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "s_read_lexicon_trie_file",
+				  "Call to \"s_mmapfile_open\" failed for file '%s'", path))
+	{
+		lex->handle = NULL;
+		lex->data = NULL;
+		goto quit_error;
+	}
+
+	set_lex_data(lex, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "s_read_lexicon_trie_file",
+				  "Failed to read lexicon file '%s'", path))
+		goto quit_error;
+
+	/* done */
+	return lex;
+
+	/* errors start clean up code here */
+quit_error:
+	{
+		s_erc local_err = S_SUCCESS;
+
+
+		S_DELETE(lex, "s_read_lexicon_trie_file", &local_err);
+	}
+
+	return NULL;
+}
+
+
+S_LOCAL SLexiconTrie *s_read_lexicon_trie(SDatasource *ds, s_erc *error)
+{
+	SLexiconTrie *lex = NULL;
+	uint8 *data = NULL;
+	uint8 *tmp;
+	size_t size = 0;
+	size_t read;
+	s_bool in_place = FALSE;
+
+
+	S_CLR_ERR(error);
+
+	/* create lexicon */
+	lex = S_NEW(SLexiconTrie, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "s_read_lexicon_trie",
+				  "Failed to create new lexicon object"))
+		goto quit_error;
+
+	/* memory data sources are not copied, the lexicon holds them */
+	in_place = use_in_place(lex, ds, error);
+	if (in_place)
+		goto set_data;
+
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "s_read_lexicon_trie",
+				  "Call to \"use_in_place\" failed"))
+		goto quit_error;
+
+	/* read the whole data source */
+	do
+	{
+		tmp = S_REALLOC(data, uint8, size + S_LEXICON_TRIE_READ_BLOCK);
+		if (tmp == NULL)
+		{
+			S_FTL_ERR(error, S_MEMERROR,
+					  "s_read_lexicon_trie",
+					  "Failed to allocate memory for lexicon data");
+			goto quit_error;
+		}
+
+		data = tmp;
+		read = SDatasourceRead(ds, data + size, 1, S_LEXICON_TRIE_READ_BLOCK, error);
+		size += read;
+
+		if ((error != NULL) && (*error == S_IOEOF))
+		{
+			S_CLR_ERR(error);
+			break;
+		}
+
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "s_read_lexicon_trie",
+					  "Call to \"SDatasourceRead\" failed"))
+			goto quit_error;
+	} while (read == S_LEXICON_TRIE_READ_BLOCK);
+
+	lex->data = data;
+	lex->data_size = size;
+	data = NULL;
+
+set_data:
+	set_lex_data(lex, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "s_read_lexicon_trie",
+				  "Failed to read lexicon data"))
+		goto quit_error;
+
+	/* done */
+	goto quit;
+
+
+	/* errors start clean up code here */
+quit_error:
+	if (lex != NULL)
+	{
+		s_erc local_err = S_SUCCESS;
+
+
+		S_DELETE(lex, "s_read_lexicon_trie", &local_err);  /* sets lex = NULL */
+	}
+
+	if (data != NULL)
+		S_FREE(data);
+
+	/* normal exit start clean up code here */
+quit:
+	if (!in_place)
+	{
+		s_erc local_err = S_SUCCESS;
+
+
+		S_DELETE(ds, "s_read_lexicon_trie", &local_err);
+	}
+
+	return lex;
+}
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static function implementations                                                  */
+/*                                                                                  */
+/************************************************************************************/
+
+/*
+ * Use the memory of a memory data source (see SMemsourceOpenOwned),
+ * from its current position, as the lexicon data. The lexicon takes
+ * over the reader's hold of the data source, which keeps the memory
+ * valid until the lexicon is deleted. Returns
+ * FALSE if the data source is not a memory data source or its memory
+ * is not aligned for the sections, the data must then be read.
+ */
+static s_bool use_in_place(SLexiconTrie *lex, SDatasource *ds, s_erc *error)
+{
+	const SMemsource *memSource;
+	s_bool is_mem;
+
+
+	S_CLR_ERR(error);
+
+	is_mem = SObjectIsType(S_OBJECT(ds), "SMemsource", error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "use_in_place",
+				  "Call to \"SObjectIsType\" failed"))
+		return FALSE;
+
+	if (!is_mem)
+		return FALSE;
+
+	memSource = (const SMemsource*)ds;
+	if ((memSource->mem == NULL)
+		|| (memSource->offset < 0)
+		|| ((size_t)memSource->offset > memSource->size)
+		|| ((((size_t)(memSource->mem + memSource->offset)) & 3) != 0))
+		return FALSE;
+
+	/* the lexicon only reads its data */
+	lex->data = (uint8*)(memSource->mem + memSource->offset);
+	lex->data_size = memSource->size - (size_t)memSource->offset;
+
+	lex->source = ds;
+
+	return TRUE;
+}
+
+
+/*
+ * check that the section is in the data and aligned, sections of
+ * records are aligned to their uint32 members.
+ */
+static const void *get_section(const SLexiconTrie *lex, uint32 offset, uint32 count,
+							   size_t elem_size, const char *name, s_erc *error)
+{
+	size_t alignment = (elem_size > sizeof(uint32)) ? sizeof(uint32) : elem_size;
+
+
+	S_CLR_ERR(error);
+
+	if (((offset % alignment) != 0)
+		|| (offset > lex->data_size)
+		|| (count > ((lex->data_size - offset) / elem_size)))
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "get_section",
+				  "Section '%s' is not within the lexicon data", name);
+		return NULL;
+	}
+
+	return lex->data + offset;
+}
+
+
+static void set_lex_data(SLexiconTrie *lex, s_erc *error)
+{
+	s_lexicon_trie_header *header = &(lex->header);
+
+
+	S_CLR_ERR(error);
+
+	if (lex->data_size < sizeof(s_lexicon_trie_header))
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "set_lex_data",
+				  "Lexicon data is too small for the lexicon header");
+		return;
+	}
+
+	memcpy(header, lex->data, sizeof(s_lexicon_trie_header));
+
+	if (memcmp(header->magic, S_LEXICON_TRIE_MAGIC, 8) != 0)
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "set_lex_data",
+				  "Lexicon data is not in the trie lexicon format");
+		return;
+	}
+
+	if (header->byte_order != S_LEXICON_TRIE_BYTE_ORDER)
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "set_lex_data",
+				  "Lexicon data was written with a different byte order");
+		return;
+	}
+
+	if (header->format_version != S_LEXICON_TRIE_FORMAT_VERSION)
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "set_lex_data",
+				  "Unsupported trie lexicon format version %d (require %d)",
+				  header->format_version, S_LEXICON_TRIE_FORMAT_VERSION);
+		return;
+	}
+
+	if ((header->num_nodes == 0) || (header->num_words == S_LEXICON_TRIE_NONE)
+		|| (header->strings_size == 0))
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "set_lex_data",
+				  "Lexicon data is corrupt (header)");
+		return;
+	}
+
+	lex->nodes = get_section(lex, header->nodes_offset, header->num_nodes + 1,
+							 sizeof(uint32), "nodes", error);
+	if (!*error)
+		lex->words = get_section(lex, header->words_offset, header->num_nodes,
+								 sizeof(uint32), "words", error);
+	if (!*error)
+		lex->labels = get_section(lex, header->labels_offset, header->num_nodes - 1,
+								  sizeof(uint8), "labels", error);
+	if (!*error)
+		lex->word_prons = get_section(lex, header->word_prons_offset, header->num_words + 1,
+									  sizeof(uint32), "word_prons", error);
+	if (!*error)
+		lex->prons = get_section(lex, header->prons_offset, header->num_prons,
+								 sizeof(s_lexicon_trie_pron), "prons", error);
+	if (!*error)
+		lex->feature_records = get_section(lex, header->features_offset, header->features_size,
+										   sizeof(uint32), "features", error);
+	if (!*error)
+		lex->phone_names = get_section(lex, header->phone_names_offset, header->num_phones,
+									   sizeof(uint32), "phone_names", error);
+	if (!*error)
+		lex->phones = get_section(lex, header->phones_offset, header->phones_size,
+								  sizeof(uint16), "phones", error);
+	if (!*error)
+		lex->strings = get_section(lex, header->strings_offset, header->strings_size,
+								   sizeof(char), "strings", error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "set_lex_data",
+				  "Call to \"get_section\" failed"))
+		return;
+
+	/* strings can not run past the end of the strings section */
+	if (lex->strings[header->strings_size - 1] != '\0')
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "set_lex_data",
+				  "Lexicon data is corrupt (strings)");
+		return;
+	}
+
+	set_lex_info(lex, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "set_lex_data",
+				  "Call to \"set_lex_info\" failed"))
+		return;
+
+	set_lex_features(lex, error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "set_lex_data",
+			  "Call to \"set_lex_features\" failed");
+}
+
+
+static void set_lex_info(SLexiconTrie *lex, s_erc *error)
+{
+	const s_lexicon_trie_header *header = &(lex->header);
+	s_lex_info *info = S_LEXICON(lex)->info;
+	uint32 offsets[4];
+	char **strings[4];
+	int i;
+
+
+	S_CLR_ERR(error);
+
+	offsets[0] = header->name;
+	offsets[1] = header->description;
+	offsets[2] = header->language;
+	offsets[3] = header->lang_code;
+	strings[0] = &(info->name);
+	strings[1] = &(info->description);
+	strings[2] = &(info->language);
+	strings[3] = &(info->lang_code);
+
+	for (i = 0; i < 4; i++)
+	{
+		if (offsets[i] >= header->strings_size)
+		{
+			S_CTX_ERR(error, S_FAILURE,
+					  "set_lex_info",
+					  "Lexicon data is corrupt (lexicon definition)");
+			return;
+		}
+
+		*(strings[i]) = s_strdup(lex->strings + offsets[i], error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "set_lex_info",
+					  "Call to \"s_strdup\" failed"))
+			return;
+	}
+
+	info->version.major = (uint8)header->version_major;
+	info->version.minor = (uint8)header->version_minor;
+}
+
+
+/* the lexicon features, read into a map */
+static void set_lex_features(SLexiconTrie *lex, s_erc *error)
+{
+	const uint32 *triples;
+	uint32 record = lex->header.features;
+	uint32 count;
+	SMap *features;
+	SObject *value;
+	const char *key;
+	float f;
+	uint32 i;
+
+
+	S_CLR_ERR(error);
+
+	if ((record >= lex->header.features_size)
+		|| (lex->feature_records[record] > ((lex->header.features_size - record - 1) / 3)))
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "set_lex_features",
+				  "Lexicon data is corrupt (lexicon features)");
+		return;
+	}
+
+	count = lex->feature_records[record];
+	if (count == 0)
+		return;
+
+	triples = lex->feature_records + record + 1;
+
+	features = S_MAP(S_NEW(SMapList, error));
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "set_lex_features",
+				  "Failed to create new 'SMap' object"))
+		return;
+
+	for (i = 0; i < count; i++)
+	{
+		if ((triples[i * 3] >= lex->header.strings_size)
+			|| ((triples[(i * 3) + 1] == S_LEXICON_TRIE_FEAT_STRING)
+				&& (triples[(i * 3) + 2] >= lex->header.strings_size)))
+		{
+			S_CTX_ERR(error, S_FAILURE,
+					  "set_lex_features",
+					  "Lexicon data is corrupt (lexicon features)");
+			goto quit_error;
+		}
+
+		key = lex->strings + triples[i * 3];
+
+		switch (triples[(i * 3) + 1])
+		{
+		case S_LEXICON_TRIE_FEAT_STRING:
+			value = SObjectSetString(lex->strings + triples[(i * 3) + 2], error);
+			break;
+		case S_LEXICON_TRIE_FEAT_INT:
+			value = SObjectSetInt((sint32)triples[(i * 3) + 2], error);
+			break;
+		case S_LEXICON_TRIE_FEAT_FLOAT:
+			memcpy(&f, &triples[(i * 3) + 2], sizeof(float));
+			value = SObjectSetFloat(f, error);
+			break;
+		default:
+			S_CTX_ERR(error, S_FAILURE,
+					  "set_lex_features",
+					  "Lexicon data is corrupt (feature type %d)",
+					  triples[(i * 3) + 1]);
+			goto quit_error;
+		}
+
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "set_lex_features",
+					  "Failed to create feature '%s'", key))
+			goto quit_error;
+
+		SMapSetObject(features, key, value, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "set_lex_features",
+					  "Call to \"SMapSetObject\" failed"))
+		{
+			s_erc local_err = S_SUCCESS;
+
+
+			S_DELETE(value, "set_lex_features", &local_err);
+			goto quit_error;
+		}
+	}
+
+	S_LEXICON(lex)->features = features;
+	return;
+
+quit_error:
+	{
+		s_erc local_err = S_SUCCESS;
+
+
+		S_DELETE(features, "set_lex_features", &local_err);
+	}
+}
@@ -0,0 +1,236 @@
+/************************************************************************************/
+/* Copyright (c) 2009-2011 The Department of Arts and Culture,                      */
+/* The Government of the Republic of South Africa.                                  */
+/*                                                                                  */
+/* Contributors:  Meraka Institute, CSIR, South Africa.                             */
+/*                                                                                  */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy     */
+/* of this software and associated documentation files (the "Software"), to deal    */
+/* in the Software without restriction, including without limitation the rights     */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        */
+/* copies of the Software, and to permit persons to whom the Software is            */
+/* furnished to do so, subject to the following conditions:                         */
+/* The above copyright notice and this permission notice shall be included in       */
+/* all copies or substantial portions of the Software.                              */
+/*                                                                                  */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN        */
+/* THE SOFTWARE.                                                                    */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* AUTHOR  : Speect contributors                                                    */
+/* DATE    : 19 October 2026                                                        */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* SSerializedFile implementation for trie format lexicons.                         */
+/* Read lexicons from, and write lexicons to, trie format files.                    */
+/*                                                                                  */
+/************************************************************************************/
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Modules used                                                                     */
+/*                                                                                  */
+/************************************************************************************/
+
+#include "serialized_lex_trie.h"
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Typedefs                                                                         */
+/*                                                                                  */
+/************************************************************************************/
+
+typedef SSerializedFile STrieLexiconFile;
+
+typedef SSerializedFileClass STrieLexiconFileClass;
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static variables                                                                 */
+/*                                                                                  */
+/************************************************************************************/
+
+static STrieLexiconFileClass TrieLexiconFileClass; /* STrieLexiconFile class declaration. */
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Plug-in class registration/free                                                  */
+/*                                                                                  */
+/************************************************************************************/
+
+
+/* local functions to register and free classes */
+S_LOCAL void _s_serialized_trie_lexicon_reg(s_erc *error)
+{
+	S_CLR_ERR(error);
+	s_class_reg(S_OBJECTCLASS(&TrieLexiconFileClass), error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "_s_serialized_trie_lexicon_reg",
+				  "Failed to register STrieLexiconFileClass"))
+		return;
+
+	SSerializedFileRegister(&TrieLexiconFileClass, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "_s_serialized_trie_lexicon_reg",
+				  "Failed to add serialized file class STrieLexiconFileClass"))
+	{
+		s_erc local_err = S_SUCCESS;
+
+
+		s_class_free(S_OBJECTCLASS(&TrieLexiconFileClass), &local_err);
+		return;
+	}
+}
+
+
+S_LOCAL void _s_serialized_trie_lexicon_free(s_erc *error)
+{
+	s_erc local_err;
+
+
+	S_CLR_ERR(&local_err);
+	S_CLR_ERR(error);
+
+	SSerializedFileFree(&TrieLexiconFileClass, &local_err);
+	S_CHK_ERR(&local_err, S_CONTERR,
+			  "_s_serialized_trie_lexicon_free",
+			  "Failed to remove serialized file class STrieLexiconFileClass");
+
+	s_class_free(S_OBJECTCLASS(&TrieLexiconFileClass), error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "_s_serialized_trie_lexicon_free",
+			  "Failed to free STrieLexiconFileClass");
+
+	if ((local_err != S_SUCCESS)
+		&& (error != NULL)
+		&& (*error == S_SUCCESS))
+		*error = local_err;
+}
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static class function implementations                                            */
+/*                                                                                  */
+/************************************************************************************/
+
+static void Dispose(void *obj, s_erc *error)
+{
+	S_CLR_ERR(error);
+	SObjectDecRef(obj);
+}
+
+
+static SObject *Load(const char *path, s_erc *error)
+{
+	SLexiconTrie *lex;
+
+
+	S_CLR_ERR(error);
+
+	lex = s_read_lexicon_trie_file(path, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "Load",
+				  "Call to \"s_read_lexicon_trie_file\" failed"))
+		return NULL;
+
+	return S_OBJECT(lex);
+}
+
+
+static SObject *LoadFromDatasource(SDatasource *ds, s_erc *error)
+{
+	SLexiconTrie *lex;
+
+
+	S_CLR_ERR(error);
+
+	lex = s_read_lexicon_trie(ds, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "LoadFromDatasource",
+				  "Call to \"s_read_lexicon_trie\" failed"))
+		return NULL;
+
+	return S_OBJECT(lex);
+}
+
+
+static void Save(const SObject *object, const char *path, s_erc *error)
+{
+	SDatasource *ds;
+	s_erc local_err = S_SUCCESS;
+
+
+	S_CLR_ERR(error);
+
+	ds = SFilesourceOpenFile(path, "wb", error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "Save",
+				  "Call to \"SFilesourceOpenFile\" failed"))
+		return;
+
+	s_write_lexicon_trie(object, ds, error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "Save",
+			  "Call to \"s_write_lexicon_trie\" failed for file '%s'",
+			  path);
+
+	S_DELETE(ds, "Save", &local_err);
+	if (S_CHK_ERR(&local_err, S_CONTERR,
+				  "Save",
+				  "Failed to close file '%s'", path)
+		&& (*error == S_SUCCESS))
+		*error = local_err;
+}
+
+
+static void SaveToDatasource(const SObject *object, SDatasource *ds, s_erc *error)
+{
+	S_CLR_ERR(error);
+
+	s_write_lexicon_trie(object, ds, error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "SaveToDatasource",
+			  "Call to \"s_write_lexicon_trie\" failed");
+}
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* STrieLexiconFile class initialization                                            */
+/*                                                                                  */
+/************************************************************************************/
+
+static STrieLexiconFileClass TrieLexiconFileClass =
+{
+	/* SObjectClass */
+	{
+		"SSerializedFile:STrieLexiconFile",
+		sizeof(STrieLexiconFile),
+		{ 0, 1},
+		NULL,                  /* init    */
+		NULL,                  /* destroy */
+		Dispose,               /* dispose */
+		NULL,                  /* compare */
+		NULL,                  /* print   */
+		NULL,                  /* copy    */
+	},
+	/* SSerializedFileClass */
+	"spct_lexicon_trie",       /* format  */
+	Load,                      /* load    */
+	Save,                      /* save    */
+	SaveToDatasource,          /* save_to_datasource   */
+	LoadFromDatasource         /* load_from_datasource */
+
+};
@@ -0,0 +1,152 @@
+/************************************************************************************/
+/* Copyright (c) 2009-2011 The Department of Arts and Culture,                      */
+/* The Government of the Republic of South Africa.                                  */
+/*                                                                                  */
+/* Contributors:  Meraka Institute, CSIR, South Africa.                             */
+/*                                                                                  */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy     */
+/* of this software and associated documentation files (the "Software"), to deal    */
+/* in the Software without restriction, including without limitation the rights     */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        */
+/* copies of the Software, and to permit persons to whom the Software is            */
+/* furnished to do so, subject to the following conditions:                         */
+/* The above copyright notice and this permission notice shall be included in       */
+/* all copies or substantial portions of the Software.                              */
+/*                                                                                  */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN        */
+/* THE SOFTWARE.                                                                    */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* AUTHOR  : Speect contributors                                                    */
+/* DATE    : 19 October 2026                                                        */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* SSerializedFile implementation for trie format lexicons.                         */
+/* Read lexicons from, and write lexicons to, trie format files.                    */
+/*                                                                                  */
+/*                                                                                  */
+/************************************************************************************/
+
+#ifndef _SPCT_PLUGIN_SERIALIZED_TRIE_LEXICONS__
+#define _SPCT_PLUGIN_SERIALIZED_TRIE_LEXICONS__
+
+
+/**
+ * @file serialized_lex_trie.h
+ * SSerializedFile implementation for trie format lexicons.
+ */
+
+
+/**
+ * @ingroup SSerializedFile
+ * @defgroup STrieLexicon Serialized Trie Lexicon
+ * SSerializedFile implementation for trie format lexicons, with the
+ * @c "spct_lexicon_trie" format. Files are memory mapped when loaded
+ * from a path, and read into memory when loaded from a data source.
+ * Saving accepts a #SLexiconTrie, or the #SMap of a parsed JSON format
+ * lexicon file, which converts the JSON lexicon to the trie format.
+ * @{
+ */
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Modules used                                                                     */
+/*                                                                                  */
+/************************************************************************************/
+
+#include "speect.h"
+#include "lexicon_trie.h"
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Begin external c declaration                                                     */
+/*                                                                                  */
+/************************************************************************************/
+S_BEGIN_C_DECLS
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Plug-in class registration/free                                                  */
+/*                                                                                  */
+/************************************************************************************/
+
+/**
+ * Register the plug-in class with the Speect Engine object
+ * system.
+ * @private
+ *
+ * @param error Error code.
+ */
+S_LOCAL void _s_serialized_trie_lexicon_reg(s_erc *error);
+
+
+/**
+ * Free the plug-in class from the Speect Engine object
+ * system.
+ * @private
+ *
+ * @param error Error code.
+ */
+S_LOCAL void _s_serialized_trie_lexicon_free(s_erc *error);
+
+
+/**
+ * Memory map a trie format lexicon file.
+ *
+ * @param path The path of the lexicon file.
+ * @param error Error code.
+ *
+ * @return Loaded lexicon or @c NULL on error.
+ */
+S_LOCAL SLexiconTrie *s_read_lexicon_trie_file(const char *path, s_erc *error);
+
+
+/**
+ * Read a trie format lexicon from the given data source into memory.
+ *
+ * @param ds The data source to read the lexicon from. The
+ * function takes hold of the data source, it is deleted when reading
+ * is done (also on errors).
+ * @param error Error code.
+ *
+ * @return Loaded lexicon or @c NULL on error.
+ */
+S_LOCAL SLexiconTrie *s_read_lexicon_trie(SDatasource *ds, s_erc *error);
+
+
+/**
+ * Write a trie format lexicon to the given data source.
+ *
+ * @param object Either a #SLexiconTrie, or the #SMap of a parsed JSON
+ * format lexicon file (with "lexicon-definition", "features" and
+ * "lexicon-entries" keys) that is converted to the trie format.
+ * @param ds The data source to write the lexicon to.
+ * @param error Error code.
+ */
+S_LOCAL void s_write_lexicon_trie(const SObject *object, SDatasource *ds, s_erc *error);
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* End external c declaration                                                       */
+/*                                                                                  */
+/************************************************************************************/
+S_END_C_DECLS
+
+
+/**
+ * @}
+ * end documentation
+ */
+
+#endif /* _SPCT_PLUGIN_SERIALIZED_TRIE_LEXICONS__ */
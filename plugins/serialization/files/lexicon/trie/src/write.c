@@ -0,0 +1,1256 @@
+/************************************************************************************/
+/* Copyright (c) 2009-2011 The Department of Arts and Culture,                      */
+/* The Government of the Republic of South Africa.                                  */
+/*                                                                                  */
+/* Contributors:  Meraka Institute, CSIR, South Africa.                             */
+/*                                                                                  */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy     */
+/* of this software and associated documentation files (the "Software"), to deal    */
+/* in the Software without restriction, including without limitation the rights     */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        */
+/* copies of the Software, and to permit persons to whom the Software is            */
+/* furnished to do so, subject to the following conditions:                         */
+/* The above copyright notice and this permission notice shall be included in       */
+/* all copies or substantial portions of the Software.                              */
+/*                                                                                  */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN        */
+/* THE SOFTWARE.                                                                    */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* AUTHOR  : Speect contributors                                                    */
+/* DATE    : 19 October 2026                                                        */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* Write trie format lexicons, converting JSON format lexicons.                     */
+/*                                                                                  */
+/*                                                                                  */
+/************************************************************************************/
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Modules used                                                                     */
+/*                                                                                  */
+/************************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include "serialized_lex_trie.h"
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Data types                                                                       */
+/*                                                                                  */
+/************************************************************************************/
+
+/* a word of the lexicon and its entries */
+typedef struct
+{
+	const char    *word;
+	const SObject *entries;
+} s_trie_word;
+
+
+/* a node of the trie to be written, the words with the same prefix */
+typedef struct
+{
+	uint32 low;
+	uint32 high;
+	uint32 depth;
+} s_trie_range;
+
+
+/* the sections of the lexicon being written */
+typedef struct
+{
+	s_buffer     *strings;
+	s_hash_table *string_offsets;
+	s_buffer     *features;
+	s_buffer     *phone_names;
+	s_hash_table *phone_ids;
+	s_buffer     *phones;
+	s_buffer     *prons;
+	s_buffer     *word_prons;
+	s_buffer     *nodes;
+	s_buffer     *words;
+	s_buffer     *labels;
+} s_trie_writer;
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static function prototypes                                                       */
+/*                                                                                  */
+/************************************************************************************/
+
+static void free_id(void *key, void *data, s_erc *error);
+
+static uint32 buffer_count(const s_buffer *buf, size_t elem_size, s_erc *error);
+
+static void append_uint32(s_buffer *buf, uint32 value, s_erc *error);
+
+static uint32 intern(s_buffer *buf, s_hash_table *ids, const char *string,
+					 uint32 id, s_erc *error);
+
+static uint32 add_string(s_trie_writer *writer, const char *string, s_erc *error);
+
+static uint16 add_phone_name(s_trie_writer *writer, const char *phone, s_erc *error);
+
+static uint32 add_features(s_trie_writer *writer, const SMap *features, s_erc *error);
+
+static void add_phones(s_trie_writer *writer, const SList *phones, s_erc *error);
+
+static void add_entry(s_trie_writer *writer, const SMap *entry, s_erc *error);
+
+static void add_words(s_trie_writer *writer, const SMap *entries, s_erc *error);
+
+static void add_trie(s_trie_writer *writer, const s_trie_word *words, uint32 num_words,
+					 s_erc *error);
+
+static int compare_words(const void *a, const void *b);
+
+static void set_header(s_trie_writer *writer, s_lexicon_trie_header *header,
+					   const SMap *lexicon, s_erc *error);
+
+static void write_data(SDatasource *ds, const void *data, size_t size, s_erc *error);
+
+static void write_lexicon(s_trie_writer *writer, s_lexicon_trie_header *header,
+						  SDatasource *ds, s_erc *error);
+
+static void writer_init(s_trie_writer *writer, s_erc *error);
+
+static void writer_free(s_trie_writer *writer);
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Function implementations                                                         */
+/*                                                                                  */
+/************************************************************************************/
+
+S_LOCAL void s_write_lexicon_trie(const SObject *object, SDatasource *ds, s_erc *error)
+{
+	s_trie_writer writer;
+	s_lexicon_trie_header header;
+	const SMap *lexicon;
+	const SObject *tmp;
+	const SMap *entries;
+	s_bool is_trie;
+
+
+	S_CLR_ERR(error);
+
+	if (object == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "s_write_lexicon_trie",
+				  "Argument \"object\" is NULL");
+		return;
+	}
+
+	/* a loaded trie lexicon is written as is */
+	is_trie = SObjectIsType(object, "SLexiconTrie", error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "s_write_lexicon_trie",
+				  "Call to \"SObjectIsType\" failed"))
+		return;
+
+	if (is_trie)
+	{
+		write_data(ds, S_LEXICON_TRIE(object)->data, S_LEXICON_TRIE(object)->data_size,
+				   error);
+		S_CHK_ERR(error, S_CONTERR,
+				  "s_write_lexicon_trie",
+				  "Call to \"write_data\" failed");
+		return;
+	}
+
+	lexicon = S_CAST(object, SMap, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "s_write_lexicon_trie",
+				  "Object must be a 'SLexiconTrie' or the 'SMap' of a JSON lexicon"))
+		return;
+
+	writer_init(&writer, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "s_write_lexicon_trie",
+				  "Call to \"writer_init\" failed"))
+		goto quit;
+
+	set_header(&writer, &header, lexicon, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "s_write_lexicon_trie",
+				  "Call to \"set_header\" failed"))
+		goto quit;
+
+	/* get lexicon entries */
+	tmp = SMapGetObjectDef(lexicon, "lexicon-entries", NULL, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "s_write_lexicon_trie",
+				  "Call to \"SMapGetObjectDef\" failed"))
+		goto quit;
+
+	if (tmp == NULL)
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "s_write_lexicon_trie",
+				  "Lexicon does not have a 'lexicon-entries' key");
+		goto quit;
+	}
+
+	/* cast to make sure it's a map */
+	entries = S_CAST(tmp, SMap, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "s_write_lexicon_trie",
+				  "Lexicon key 'lexicon-entries' must be a map type"))
+		goto quit;
+
+	add_words(&writer, entries, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "s_write_lexicon_trie",
+				  "Call to \"add_words\" failed"))
+		goto quit;
+
+	write_lexicon(&writer, &header, ds, error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "s_write_lexicon_trie",
+			  "Call to \"write_lexicon\" failed");
+
+quit:
+	writer_free(&writer);
+}
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static function implementations                                                  */
+/*                                                                                  */
+/************************************************************************************/
+
+static void free_id(void *key, void *data, s_erc *error)
+{
+	S_CLR_ERR(error);
+
+	if (key != NULL)
+		S_FREE(key);
+
+	if (data != NULL)
+		S_FREE(data);
+}
+
+
+/* number of elements in the buffer, which must fit in a uint32 */
+static uint32 buffer_count(const s_buffer *buf, size_t elem_size, s_erc *error)
+{
+	size_t count;
+
+
+	S_CLR_ERR(error);
+
+	count = s_buffer_size(buf, error) / elem_size;
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "buffer_count",
+				  "Call to \"s_buffer_size\" failed"))
+		return 0;
+
+	if (count >= S_LEXICON_TRIE_NONE)
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "buffer_count",
+				  "Lexicon is too large for the trie lexicon format");
+		return 0;
+	}
+
+	return (uint32)count;
+}
+
+
+static void append_uint32(s_buffer *buf, uint32 value, s_erc *error)
+{
+	S_CLR_ERR(error);
+
+	s_buffer_append(buf, &value, sizeof(uint32), error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "append_uint32",
+			  "Call to \"s_buffer_append\" failed");
+}
+
+
+/*
+ * the id of the given string in the table, if it is not there yet
+ * the string is added with the given id, and appended to the buffer
+ * if not NULL.
+ */
+static uint32 intern(s_buffer *buf, s_hash_table *ids, const char *string,
+					 uint32 id, s_erc *error)
+{
+	const s_hash_element *element;
+	char *key;
+	uint32 *data;
+	size_t size;
+
+
+	S_CLR_ERR(error);
+
+	size = s_strzsize(string, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "intern",
+				  "Call to \"s_strzsize\" failed"))
+		return 0;
+
+	element = s_hash_table_find(ids, string, size, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "intern",
+				  "Call to \"s_hash_table_find\" failed"))
+		return 0;
+
+	if (element != NULL)
+	{
+		data = (uint32*)s_hash_element_get_data(element, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "intern",
+					  "Call to \"s_hash_element_get_data\" failed"))
+			return 0;
+
+		return *data;
+	}
+
+	key = s_strdup(string, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "intern",
+				  "Call to \"s_strdup\" failed"))
+		return 0;
+
+	data = S_MALLOC(uint32, 1);
+	if (data == NULL)
+	{
+		S_FTL_ERR(error, S_MEMERROR,
+				  "intern",
+				  "Failed to allocate memory for 'uint32' object");
+		S_FREE(key);
+		return 0;
+	}
+
+	*data = id;
+	s_hash_table_add(ids, key, size, data, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "intern",
+				  "Call to \"s_hash_table_add\" failed"))
+	{
+		S_FREE(key);
+		S_FREE(data);
+		return 0;
+	}
+
+	if (buf != NULL)
+	{
+		s_buffer_append(buf, string, size, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "intern",
+					  "Call to \"s_buffer_append\" failed"))
+			return 0;
+	}
+
+	return id;
+}
+
+
+/* offset of the string in the strings section */
+static uint32 add_string(s_trie_writer *writer, const char *string, s_erc *error)
+{
+	uint32 offset;
+
+
+	S_CLR_ERR(error);
+
+	offset = buffer_count(writer->strings, sizeof(char), error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "add_string",
+				  "Call to \"buffer_count\" failed"))
+		return 0;
+
+	offset = intern(writer->strings, writer->string_offsets, string, offset, error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "add_string",
+			  "Call to \"intern\" failed");
+
+	return offset;
+}
+
+
+/* identifier of the phone */
+static uint16 add_phone_name(s_trie_writer *writer, const char *phone, s_erc *error)
+{
+	uint32 num_phones;
+	uint32 id;
+	uint32 offset;
+
+
+	S_CLR_ERR(error);
+
+	num_phones = buffer_count(writer->phone_names, sizeof(uint32), error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "add_phone_name",
+				  "Call to \"buffer_count\" failed"))
+		return 0;
+
+	id = intern(NULL, writer->phone_ids, phone, num_phones, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "add_phone_name",
+				  "Call to \"intern\" failed"))
+		return 0;
+
+	if (id < num_phones)
+		return (uint16)id;
+
+	if (id >= S_LEXICON_TRIE_SYLLABLE_BREAK)
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "add_phone_name",
+				  "Lexicon has too many different phones for the trie lexicon format");
+		return 0;
+	}
+
+	offset = add_string(writer, phone, error);
+	if (!*error)
+		append_uint32(writer->phone_names, offset, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "add_phone_name",
+				  "Failed to add phone name '%s'", phone))
+		return 0;
+
+	return (uint16)id;
+}
+
+
+/*
+ * a feature record of the features in the map, except "phones" and
+ * "syllables". Returns the record offset.
+ */
+static uint32 add_features(s_trie_writer *writer, const SMap *features, s_erc *error)
+{
+	SIterator *itr;
+	const char *key;
+	const SObject *value = NULL;
+	uint32 record;
+	uint32 count = 0;
+	uint32 triple[3];
+	float f;
+
+
+	S_CLR_ERR(error);
+
+	record = buffer_count(writer->features, sizeof(uint32), error);
+	if (!*error)
+		append_uint32(writer->features, 0, error); /* count, set below */
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "add_features",
+				  "Failed to start feature record"))
+		return 0;
+
+	itr = S_ITERATOR_GET(features, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "add_features",
+				  "Call to \"S_ITERATOR_GET\" failed"))
+		return 0;
+
+	for (/* NOP */; itr != NULL; itr = SIteratorNext(itr))
+	{
+		key = SIteratorKey(itr, error);
+		if (!*error)
+			value = SIteratorObject(itr, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "add_features",
+					  "Failed to get feature from iterator"))
+			goto quit_error;
+
+		if ((s_strcmp(key, "phones", error) == 0)
+			|| (s_strcmp(key, "syllables", error) == 0))
+			continue;
+
+		triple[0] = add_string(writer, key, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "add_features",
+					  "Call to \"add_string\" failed"))
+			goto quit_error;
+
+		if (SObjectIsType(value, "SString", error))
+		{
+			triple[1] = S_LEXICON_TRIE_FEAT_STRING;
+			triple[2] = add_string(writer, SObjectGetString(value, error), error);
+		}
+		else if (SObjectIsType(value, "SInt", error))
+		{
+			triple[1] = S_LEXICON_TRIE_FEAT_INT;
+			triple[2] = (uint32)SObjectGetInt(value, error);
+		}
+		else if (SObjectIsType(value, "SFloat", error))
+		{
+			triple[1] = S_LEXICON_TRIE_FEAT_FLOAT;
+			f = SObjectGetFloat(value, error);
+			memcpy(&triple[2], &f, sizeof(float));
+		}
+		else
+		{
+			S_CTX_ERR(error, S_FAILURE,
+					  "add_features",
+					  "Feature '%s' is of type '%s', only strings, integers and floats are supported",
+					  key, SObjectType(value, error));
+			goto quit_error;
+		}
+
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "add_features",
+					  "Failed to get value of feature '%s'", key))
+			goto quit_error;
+
+		s_buffer_append(writer->features, triple, sizeof(uint32) * 3, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "add_features",
+					  "Call to \"s_buffer_append\" failed"))
+			goto quit_error;
+
+		count++;
+	}
+
+	/* set the count */
+	memcpy((uchar*)s_buffer_data(writer->features, error) + (record * sizeof(uint32)),
+		   &count, sizeof(uint32));
+
+	return record;
+
+quit_error:
+	{
+		s_erc local_err = S_SUCCESS;
+
+
+		S_DELETE(itr, "add_features", &local_err);
+	}
+
+	return 0;
+}
+
+
+/* the phone identifiers of a list of phones */
+static void add_phones(s_trie_writer *writer, const SList *phones, s_erc *error)
+{
+	SIterator *itr;
+	const char *phone;
+	uint16 id;
+
+
+	S_CLR_ERR(error);
+
+	itr = S_ITERATOR_GET(phones, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "add_phones",
+				  "Call to \"S_ITERATOR_GET\" failed"))
+		return;
+
+	for (/* NOP */; itr != NULL; itr = SIteratorNext(itr))
+	{
+		phone = SObjectGetString(SIteratorObject(itr, error), error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "add_phones",
+					  "Phones must be strings"))
+			goto quit_error;
+
+		id = add_phone_name(writer, phone, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "add_phones",
+					  "Call to \"add_phone_name\" failed"))
+			goto quit_error;
+
+		s_buffer_append(writer->phones, &id, sizeof(uint16), error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "add_phones",
+					  "Call to \"s_buffer_append\" failed"))
+			goto quit_error;
+	}
+
+	return;
+
+quit_error:
+	{
+		s_erc local_err = S_SUCCESS;
+
+
+		S_DELETE(itr, "add_phones", &local_err);
+	}
+}
+
+
+/* a pronunciation, syllables are used if present as the JSON lexicon */
+static void add_entry(s_trie_writer *writer, const SMap *entry, s_erc *error)
+{
+	s_lexicon_trie_pron pron;
+	const SObject *tmp;
+	const SList *phones;
+	SIterator *itr;
+	uint16 syllable_break = S_LEXICON_TRIE_SYLLABLE_BREAK;
+	s_bool first = TRUE;
+
+
+	S_CLR_ERR(error);
+
+	pron.features = add_features(writer, entry, error);
+	if (!*error)
+		pron.phones = buffer_count(writer->phones, sizeof(uint16), error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "add_entry",
+				  "Failed to add entry features"))
+		return;
+
+	tmp = SMapGetObjectDef(entry, "syllables", NULL, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "add_entry",
+				  "Call to \"SMapGetObjectDef\" failed"))
+		return;
+
+	pron.syllabified = (tmp != NULL);
+
+	if (tmp == NULL)
+	{
+		tmp = SMapGetObjectDef(entry, "phones", NULL, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "add_entry",
+					  "Call to \"SMapGetObjectDef\" failed"))
+			return;
+
+		/* the word must have either phones or syllables */
+		if (tmp == NULL)
+		{
+			S_CTX_ERR(error, S_FAILURE,
+					  "add_entry",
+					  "Word entry does not have 'phones' or 'syllables' defined");
+			return;
+		}
+	}
+
+	phones = S_CAST(tmp, SList, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "add_entry",
+				  "'phones'/'syllables' entry for word is not a list"))
+		return;
+
+	if (!pron.syllabified)
+	{
+		add_phones(writer, phones, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "add_entry",
+					  "Call to \"add_phones\" failed"))
+			return;
+	}
+	else
+	{
+		itr = S_ITERATOR_GET(phones, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "add_entry",
+					  "Call to \"S_ITERATOR_GET\" failed"))
+			return;
+
+		for (/* NOP */; itr != NULL; itr = SIteratorNext(itr), first = FALSE)
+		{
+			const SList *syllable = S_CAST(SIteratorObject(itr, error), SList, error);
+
+
+			if (S_CHK_ERR(error, S_CONTERR,
+						  "add_entry",
+						  "Syllable of word is not a list"))
+				goto quit_error;
+
+			if (!first)
+			{
+				s_buffer_append(writer->phones, &syllable_break, sizeof(uint16), error);
+				if (S_CHK_ERR(error, S_CONTERR,
+							  "add_entry",
+							  "Call to \"s_buffer_append\" failed"))
+					goto quit_error;
+			}
+
+			add_phones(writer, syllable, error);
+			if (S_CHK_ERR(error, S_CONTERR,
+						  "add_entry",
+						  "Call to \"add_phones\" failed"))
+				goto quit_error;
+		}
+	}
+
+	pron.num_phones = buffer_count(writer->phones, sizeof(uint16), error) - pron.phones;
+	if (!*error)
+		s_buffer_append(writer->prons, &pron, sizeof(s_lexicon_trie_pron), error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "add_entry",
+			  "Failed to add pronunciation");
+	return;
+
+quit_error:
+	{
+		s_erc local_err = S_SUCCESS;
+
+
+		S_DELETE(itr, "add_entry", &local_err);
+	}
+}
+
+
+static int compare_words(const void *a, const void *b)
+{
+	return strcmp(((const s_trie_word*)a)->word, ((const s_trie_word*)b)->word);
+}
+
+
+/* the entries of all the words, in word order, and the trie */
+static void add_words(s_trie_writer *writer, const SMap *entries, s_erc *error)
+{
+	s_trie_word *words = NULL;
+	SIterator *itr = NULL;
+	size_t num_words;
+	uint32 i = 0;
+
+
+	S_CLR_ERR(error);
+
+	num_words = SMapSize(entries, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "add_words",
+				  "Call to \"SMapSize\" failed"))
+		return;
+
+	if (num_words >= S_LEXICON_TRIE_NONE)
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "add_words",
+				  "Lexicon has too many words for the trie lexicon format");
+		return;
+	}
+
+	words = S_CALLOC(s_trie_word, num_words + 1);
+	if (words == NULL)
+	{
+		S_FTL_ERR(error, S_MEMERROR,
+				  "add_words",
+				  "Failed to allocate memory for 's_trie_word' object");
+		return;
+	}
+
+	itr = S_ITERATOR_GET(entries, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "add_words",
+				  "Call to \"S_ITERATOR_GET\" failed"))
+		goto quit;
+
+	for (/* NOP */; (itr != NULL) && (i < num_words); itr = SIteratorNext(itr), i++)
+	{
+		words[i].word = SIteratorKey(itr, error);
+		if (!*error)
+			words[i].entries = SIteratorObject(itr, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "add_words",
+					  "Failed to get lexicon entry from iterator"))
+			goto quit;
+	}
+
+	num_words = i;
+	qsort(words, num_words, sizeof(s_trie_word), compare_words);
+
+	for (i = 0; i < num_words; i++)
+	{
+		const SList *entryList;
+		SIterator *entryItr;
+		uint32 num_prons;
+
+
+		num_prons = buffer_count(writer->prons, sizeof(s_lexicon_trie_pron), error);
+		if (!*error)
+			append_uint32(writer->word_prons, num_prons, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "add_words",
+					  "Failed to add word pronunciations"))
+			goto quit;
+
+		entryList = S_CAST(words[i].entries, SList, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "add_words",
+					  "Lexicon entry for word '%s' is not a list object",
+					  words[i].word))
+			goto quit;
+
+		if (SListSize(entryList, error) == 0)
+		{
+			S_CTX_ERR(error, S_FAILURE,
+					  "add_words",
+					  "Lexicon entry for word '%s' is empty",
+					  words[i].word);
+			goto quit;
+		}
+
+		entryItr = S_ITERATOR_GET(entryList, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "add_words",
+					  "Call to \"S_ITERATOR_GET\" failed"))
+			goto quit;
+
+		for (/* NOP */; entryItr != NULL; entryItr = SIteratorNext(entryItr))
+		{
+			const SMap *entry = S_CAST(SIteratorObject(entryItr, error), SMap, error);
+
+
+			if (!*error)
+				add_entry(writer, entry, error);
+			if (S_CHK_ERR(error, S_CONTERR,
+						  "add_words",
+						  "Failed to add lexicon entry of word '%s'",
+						  words[i].word))
+			{
+				s_erc local_err = S_SUCCESS;
+
+
+				S_DELETE(entryItr, "add_words", &local_err);
+				goto quit;
+			}
+		}
+	}
+
+	num_words = buffer_count(writer->prons, sizeof(s_lexicon_trie_pron), error);
+	if (!*error)
+		append_uint32(writer->word_prons, (uint32)num_words, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "add_words",
+				  "Failed to add word pronunciations"))
+		goto quit;
+
+	add_trie(writer, words, i, error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "add_words",
+			  "Call to \"add_trie\" failed");
+
+quit:
+	if (itr != NULL)
+	{
+		s_erc local_err = S_SUCCESS;
+
+
+		S_DELETE(itr, "add_words", &local_err);
+	}
+
+	S_FREE(words);
+}
+
+
+/*
+ * the trie of the sorted words, in breadth first order so that arc a
+ * leads to node a + 1.
+ */
+static void add_trie(s_trie_writer *writer, const s_trie_word *words, uint32 num_words,
+					 s_erc *error)
+{
+	s_trie_range *queue;
+	s_trie_range *tmp;
+	s_trie_range range;
+	size_t queue_size = 1024;
+	size_t head = 0;
+	size_t tail = 0;
+	uint32 num_arcs = 0;
+	uint32 low;
+	uint32 high;
+	uchar label;
+
+
+	S_CLR_ERR(error);
+
+	queue = S_MALLOC(s_trie_range, queue_size);
+	if (queue == NULL)
+	{
+		S_FTL_ERR(error, S_MEMERROR,
+				  "add_trie",
+				  "Failed to allocate memory for 's_trie_range' object");
+		return;
+	}
+
+	/* the root */
+	queue[tail].low = 0;
+	queue[tail].high = num_words;
+	queue[tail++].depth = 0;
+
+	while (head < tail)
+	{
+		range = queue[head++];
+		low = range.low;
+
+		append_uint32(writer->nodes, num_arcs, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "add_trie",
+					  "Call to \"append_uint32\" failed"))
+			goto quit;
+
+		/* a word that ends here sorts before the longer words */
+		if ((low < range.high) && (words[low].word[range.depth] == '\0'))
+			append_uint32(writer->words, low++, error);
+		else
+			append_uint32(writer->words, S_LEXICON_TRIE_NONE, error);
+
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "add_trie",
+					  "Call to \"append_uint32\" failed"))
+			goto quit;
+
+		/* an arc for each different next byte */
+		while (low < range.high)
+		{
+			label = (uchar)words[low].word[range.depth];
+			for (high = low + 1;
+				 (high < range.high) && ((uchar)words[high].word[range.depth] == label);
+				 high++)
+				/* NOP */;
+
+			s_buffer_append(writer->labels, &label, sizeof(uchar), error);
+			if (S_CHK_ERR(error, S_CONTERR,
+						  "add_trie",
+						  "Call to \"s_buffer_append\" failed"))
+				goto quit;
+
+			if (tail == queue_size)
+			{
+				queue_size *= 2;
+				tmp = S_REALLOC(queue, s_trie_range, queue_size);
+				if (tmp == NULL)
+				{
+					S_FTL_ERR(error, S_MEMERROR,
+							  "add_trie",
+							  "Failed to reallocate memory for 's_trie_range' object");
+					goto quit;
+				}
+
+				queue = tmp;
+			}
+
+			queue[tail].low = low;
+			queue[tail].high = high;
+			queue[tail++].depth = range.depth + 1;
+
+			if (++num_arcs == S_LEXICON_TRIE_NONE)
+			{
+				S_CTX_ERR(error, S_FAILURE,
+						  "add_trie",
+						  "Lexicon is too large for the trie lexicon format");
+				goto quit;
+			}
+
+			low = high;
+		}
+	}
+
+	/* end of the arcs of the last node */
+	append_uint32(writer->nodes, num_arcs, error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "add_trie",
+			  "Call to \"append_uint32\" failed");
+
+quit:
+	S_FREE(queue);
+}
+
+
+/* the lexicon definition and features */
+static void set_header(s_trie_writer *writer, s_lexicon_trie_header *header,
+					   const SMap *lexicon, s_erc *error)
+{
+	const SObject *tmp;
+	const SMap *lexDef;
+	const SMap *versionMap;
+	const char *keys[4] = { "name", "description", "language", "lang-code" };
+	uint32 *fields[4];
+	const char *tmp_string;
+	int i;
+
+
+	S_CLR_ERR(error);
+
+	memset(header, 0, sizeof(s_lexicon_trie_header));
+	memcpy(header->magic, S_LEXICON_TRIE_MAGIC, 8);
+	header->byte_order = S_LEXICON_TRIE_BYTE_ORDER;
+	header->format_version = S_LEXICON_TRIE_FORMAT_VERSION;
+
+	/* get "lexicon-definition" key */
+	tmp = SMapGetObjectDef(lexicon, "lexicon-definition", NULL, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "set_header",
+				  "Call to \"SMapGetObjectDef\" failed"))
+		return;
+
+	if (tmp == NULL)
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "set_header",
+				  "Lexicon does not have a 'lexicon-definition' key");
+		return;
+	}
+
+	/* cast to make sure it's a map */
+	lexDef = S_CAST(tmp, SMap, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "set_header",
+				  "Lexicon key 'lexicon-definition' must be a map type"))
+		return;
+
+	fields[0] = &(header->name);
+	fields[1] = &(header->description);
+	fields[2] = &(header->language);
+	fields[3] = &(header->lang_code);
+
+	for (i = 0; i < 4; i++)
+	{
+		tmp_string = SMapGetStringDef(lexDef, keys[i], NULL, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "set_header",
+					  "Call to \"SMapGetStringDef\" failed"))
+			return;
+
+		if (tmp_string == NULL)
+		{
+			S_CTX_ERR(error, S_FAILURE,
+					  "set_header",
+					  "'lexicon-definition' does not have a '%s' key", keys[i]);
+			return;
+		}
+
+		*(fields[i]) = add_string(writer, tmp_string, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "set_header",
+					  "Call to \"add_string\" failed"))
+			return;
+	}
+
+	/* get lexicon version */
+	tmp = SMapGetObjectDef(lexDef, "version", NULL, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "set_header",
+				  "Call to \"SMapGetObjectDef\" failed"))
+		return;
+
+	if (tmp == NULL)
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "set_header",
+				  "'lexicon-definition' does not have a 'version' key");
+		return;
+	}
+
+	versionMap = S_CAST(tmp, SMap, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "set_header",
+				  "'lexicon-definition' key 'version' must be a map type"))
+		return;
+
+	header->version_major = (uint32)SMapGetInt(versionMap, "major", error);
+	if (!*error)
+		header->version_minor = (uint32)SMapGetInt(versionMap, "minor", error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "set_header",
+				  "Call to \"SMapGetInt\" failed"))
+		return;
+
+	/* get lexicon features, if any */
+	tmp = SMapGetObjectDef(lexicon, "features", NULL, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "set_header",
+				  "Call to \"SMapGetObjectDef\" failed"))
+		return;
+
+	if (tmp == NULL)
+		return; /* empty feature record at 0 */
+
+	header->features = add_features(writer, S_CAST(tmp, SMap, error), error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "set_header",
+			  "Failed to add lexicon features");
+}
+
+
+static void write_data(SDatasource *ds, const void *data, size_t size, s_erc *error)
+{
+	size_t written;
+
+
+	S_CLR_ERR(error);
+
+	if (size == 0)
+		return;
+
+	written = SDatasourceWrite(ds, data, 1, size, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "write_data",
+				  "Call to \"SDatasourceWrite\" failed"))
+		return;
+
+	if (written != size)
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "write_data",
+				  "Failed to write lexicon data");
+	}
+}
+
+
+/* the header and the sections, each aligned to 4 bytes */
+static void write_lexicon(s_trie_writer *writer, s_lexicon_trie_header *header,
+						  SDatasource *ds, s_erc *error)
+{
+	const s_buffer *sections[9];
+	uint32 *offsets[9];
+	size_t sizes[9];
+	const uchar *padding = (const uchar*)"\0\0\0";
+	size_t offset = sizeof(s_lexicon_trie_header);
+	size_t pad;
+	int i;
+
+
+	S_CLR_ERR(error);
+
+	sections[0] = writer->nodes;        offsets[0] = &(header->nodes_offset);
+	sections[1] = writer->words;        offsets[1] = &(header->words_offset);
+	sections[2] = writer->labels;       offsets[2] = &(header->labels_offset);
+	sections[3] = writer->word_prons;   offsets[3] = &(header->word_prons_offset);
+	sections[4] = writer->prons;        offsets[4] = &(header->prons_offset);
+	sections[5] = writer->features;     offsets[5] = &(header->features_offset);
+	sections[6] = writer->phone_names;  offsets[6] = &(header->phone_names_offset);
+	sections[7] = writer->phones;       offsets[7] = &(header->phones_offset);
+	sections[8] = writer->strings;      offsets[8] = &(header->strings_offset);
+
+	header->num_nodes = buffer_count(writer->words, sizeof(uint32), error);
+	if (!*error)
+		header->num_words = buffer_count(writer->word_prons, sizeof(uint32), error) - 1;
+	if (!*error)
+		header->num_prons = buffer_count(writer->prons, sizeof(s_lexicon_trie_pron), error);
+	if (!*error)
+		header->num_phones = buffer_count(writer->phone_names, sizeof(uint32), error);
+	if (!*error)
+		header->features_size = buffer_count(writer->features, sizeof(uint32), error);
+	if (!*error)
+		header->phones_size = buffer_count(writer->phones, sizeof(uint16), error);
+	if (!*error)
+		header->strings_size = buffer_count(writer->strings, sizeof(char), error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "write_lexicon",
+				  "Call to \"buffer_count\" failed"))
+		return;
+
+	for (i = 0; i < 9; i++)
+	{
+		offset = (offset + 3) & ~((size_t)3);
+		if (offset >= S_LEXICON_TRIE_NONE)
+		{
+			S_CTX_ERR(error, S_FAILURE,
+					  "write_lexicon",
+					  "Lexicon is too large for the trie lexicon format");
+			return;
+		}
+
+		*(offsets[i]) = (uint32)offset;
+		sizes[i] = s_buffer_size(sections[i], error);
+		offset += sizes[i];
+	}
+
+	write_data(ds, header, sizeof(s_lexicon_trie_header), error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "write_lexicon",
+				  "Failed to write lexicon header"))
+		return;
+
+	offset = sizeof(s_lexicon_trie_header);
+	for (i = 0; i < 9; i++)
+	{
+		pad = *(offsets[i]) - offset;
+		write_data(ds, padding, pad, error);
+		if (!*error)
+			write_data(ds, s_buffer_data(sections[i], error), sizes[i], error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "write_lexicon",
+					  "Failed to write lexicon section"))
+			return;
+
+		offset += pad + sizes[i];
+	}
+}
+
+
+static void writer_init(s_trie_writer *writer, s_erc *error)
+{
+	S_CLR_ERR(error);
+
+	memset(writer, 0, sizeof(s_trie_writer));
+
+	writer->strings = s_buffer_new(error);
+	if (!*error)
+		writer->string_offsets = s_hash_table_new(&free_id, 12, error);
+	if (!*error)
+		writer->features = s_buffer_new(error);
+	if (!*error)
+		writer->phone_names = s_buffer_new(error);
+	if (!*error)
+		writer->phone_ids = s_hash_table_new(&free_id, 8, error);
+	if (!*error)
+		writer->phones = s_buffer_new(error);
+	if (!*error)
+		writer->prons = s_buffer_new(error);
+	if (!*error)
+		writer->word_prons = s_buffer_new(error);
+	if (!*error)
+		writer->nodes = s_buffer_new(error);
+	if (!*error)
+		writer->words = s_buffer_new(error);
+	if (!*error)
+		writer->labels = s_buffer_new(error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "writer_init",
+				  "Failed to create lexicon sections"))
+		return;
+
+	/* the empty string at 0, and the empty feature record at 0 */
+	add_string(writer, "", error);
+	if (!*error)
+		append_uint32(writer->features, 0, error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "writer_init",
+			  "Failed to initialize lexicon sections");
+}
+
+
+static void writer_free(s_trie_writer *writer)
+{
+	s_buffer *buffers[9];
+	s_erc local_err = S_SUCCESS;
+	int i;
+
+
+	buffers[0] = writer->strings;
+	buffers[1] = writer->features;
+	buffers[2] = writer->phone_names;
+	buffers[3] = writer->phones;
+	buffers[4] = writer->prons;
+	buffers[5] = writer->word_prons;
+	buffers[6] = writer->nodes;
+	buffers[7] = writer->words;
+	buffers[8] = writer->labels;
+
+	for (i = 0; i < 9; i++)
+	{
+		if (buffers[i] != NULL)
+			s_buffer_delete(buffers[i], &local_err);
+	}
+
+	if (writer->string_offsets != NULL)
+		s_hash_table_delete(writer->string_offsets, &local_err);
+
+	if (writer->phone_ids != NULL)
+		s_hash_table_delete(writer->phone_ids, &local_err);
+}
@@ -0,0 +1,107 @@
+/************************************************************************************/
+/* Copyright (c) 2008-2011 The Department of Arts and Culture,                      */
+/* The Government of the Republic of South Africa.                                  */
+/*                                                                                  */
+/* Contributors:  Meraka Institute, CSIR, South Africa.                             */
+/*                                                                                  */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy     */
+/* of this software and associated documentation files (the "Software"), to deal    */
+/* in the Software without restriction, including without limitation the rights     */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        */
+/* copies of the Software, and to permit persons to whom the Software is            */
+/* furnished to do so, subject to the following conditions:                         */
+/* The above copyright notice and this permission notice shall be included in       */
+/* all copies or substantial portions of the Software.                              */
+/*                                                                                  */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN        */
+/* THE SOFTWARE.                                                                    */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* AUTHOR  : Speect contributors                                                    */
+/* DATE    : 19 October 2026                                                        */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* Convert a JSON format lexicon into a trie format lexicon, that can be            */
+/* memory mapped by the Trie Lexicon plug-in (format "spct_lexicon_trie").          */
+/*                                                                                  */
+/*                                                                                  */
+/************************************************************************************/
+
+#include <stdio.h>
+#include "speect.h"
+
+
+int main(int argc, char **argv)
+{
+	s_erc error;
+	SPlugin *plugin = NULL;
+	SMap *lexicon = NULL;
+	int rv = 1;
+
+
+	S_CLR_ERR(&error);
+
+	if (argc != 3)
+	{
+		printf("Usage: %s <JSON lexicon file> <trie lexicon file>\n", argv[0]);
+		return 1;
+	}
+
+	/*
+	 * initialize speect, log errors to the console
+	 */
+	error = speect_init(s_logger_console_new(FALSE));
+	if (error != S_SUCCESS)
+	{
+		printf("Failed to initialize Speect\n");
+		return 1;
+	}
+
+	plugin = s_pm_load_plugin("lexicon_trie.spi", &error);
+	if (S_CHK_ERR(&error, S_CONTERR,
+				  "main",
+				  "Failed to load plug-in 'lexicon_trie.spi'"))
+		goto quit;
+
+	lexicon = s_json_parse_config_file(argv[1], &error);
+	if (S_CHK_ERR(&error, S_CONTERR,
+				  "main",
+				  "Failed to parse JSON lexicon '%s'", argv[1]))
+		goto quit;
+
+	SObjectSave(S_OBJECT(lexicon), argv[2], "spct_lexicon_trie", &error);
+	if (S_CHK_ERR(&error, S_CONTERR,
+				  "main",
+				  "Failed to convert lexicon '%s' to trie lexicon '%s'",
+				  argv[1], argv[2]))
+		goto quit;
+
+	printf("Converted lexicon '%s' to trie lexicon '%s'\n", argv[1], argv[2]);
+	rv = 0;
+
+quit:
+	if (lexicon != NULL)
+		S_DELETE(lexicon, "main", &error);
+
+	if (plugin != NULL)
+		S_DELETE(plugin, "main", &error);
+
+	/*
+	 * quit speect
+	 */
+	error = speect_quit();
+	if (error != S_SUCCESS)
+	{
+		printf("Call to 'speect_quit' failed\n");
+		return 1;
+	}
+
+	return rv;
+}
@@ -202,6 +202,56 @@ static const SObject *GetFeature(const SPhoneset *self, const char *key,
 	return feature;
 }
 
+/* identifier of the name in the table, or -1 if it is not in the table */
+static sint32 get_id(const s_hash_table *table, const char *name, s_erc *error)
+{
+	const s_hash_element *element;
+	const uint32 *id;
+	size_t size;
+
+
+	S_CLR_ERR(error);
+
+	size = s_strzsize(name, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "get_id",
+				  "Call to \"s_strzsize\" failed"))
+		return -1;
+
+	element = s_hash_table_find(table, name, size, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "get_id",
+				  "Call to \"s_hash_table_find\" failed"))
+		return -1;
+
+	if (element == NULL)
+		return -1;
+
+	id = s_hash_element_get_data(element, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "get_id",
+				  "Call to \"s_hash_element_get_data\" failed"))
+		return -1;
+
+	return (sint32)*id;
+}
+
+
+static s_bool id_has_feature(const s_phoneset_ids *ids, sint32 phone_id,
+							 sint32 feature_id)
+{
+	if ((phone_id < 0) || ((uint32)phone_id >= ids->num_phones)
+		|| (feature_id < 0) || ((uint32)feature_id >= ids->num_features))
+		return FALSE;
+
+	if (ids->masks[(phone_id * ids->mask_size) + (feature_id / 32)]
+		& ((uint32)1 << (feature_id % 32)))
+		return TRUE;
+
+	return FALSE;
+}
+
+
 static s_bool PhoneHasFeature(const SPhoneset *self, const char *phone,
 							  const char *feature, s_erc *error)
 {
@@ -229,6 +279,23 @@ static s_bool PhoneHasFeature(const SPhoneset *self, const char *phone,
 		return FALSE;
 	}
 
+	if (self->ids != NULL)
+	{
+		sint32 phone_id;
+		sint32 feature_id = -1;
+
+
+		phone_id = get_id(self->ids->phone_ids, phone, error);
+		if (!*error)
+			feature_id = get_id(self->ids->feature_ids, feature, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "PhoneHasFeature",
+					  "Call to \"get_id\" failed"))
+			return FALSE;
+
+		return id_has_feature(self->ids, phone_id, feature_id);
+	}
+
 	tmp = SMapGetObjectDef(phoneset->phones, phone, NULL, error);
 	if (S_CHK_ERR(error, S_CONTERR,
 				  "PhoneHasFeature",
@@ -280,6 +347,20 @@ static s_bool HasPhone(const SPhoneset *self, const char *phone, s_erc *error)
 		return FALSE;
 	}
 
+	if (self->ids != NULL)
+	{
+		sint32 phone_id;
+
+
+		phone_id = get_id(self->ids->phone_ids, phone, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "HasPhone",
+					  "Call to \"get_id\" failed"))
+			return FALSE;
+
+		return (phone_id >= 0);
+	}
+
 	tmp = SMapGetObjectDef(phoneset->phones, phone, NULL, error);
 	if (S_CHK_ERR(error, S_CONTERR,
 				  "HasPhone",
@@ -347,6 +428,116 @@ static SList *GetPhoneList(const SPhoneset *self, s_erc *error)
 }
 
 
+static uint32 GetNumPhones(const SPhoneset *self, s_erc *error)
+{
+	SPhonesetJSON *phoneset = S_PHONESET_JSON(self);
+	size_t num_phones;
+
+
+	S_CLR_ERR(error);
+
+	if (self->ids != NULL)
+		return self->ids->num_phones;
+
+	num_phones = SMapSize(phoneset->phones, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "GetNumPhones",
+				  "Call to \"SMapSize\" failed"))
+		return 0;
+
+	return (uint32)num_phones;
+}
+
+
+static sint32 GetPhoneId(const SPhoneset *self, const char *phone, s_erc *error)
+{
+	sint32 phone_id;
+
+
+	S_CLR_ERR(error);
+	if (phone == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "GetPhoneId",
+				  "Argument \"phone\" is NULL");
+		return -1;
+	}
+
+	if (self->ids == NULL)
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "GetPhoneId",
+				  "Phoneset phones are not numbered");
+		return -1;
+	}
+
+	phone_id = get_id(self->ids->phone_ids, phone, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "GetPhoneId",
+				  "Call to \"get_id\" failed"))
+		return -1;
+
+	return phone_id;
+}
+
+
+static const char *GetPhoneName(const SPhoneset *self, sint32 phone_id, s_erc *error)
+{
+	S_CLR_ERR(error);
+
+	if ((self->ids == NULL)
+		|| (phone_id < 0)
+		|| ((uint32)phone_id >= self->ids->num_phones))
+		return NULL;
+
+	return self->ids->phone_names[phone_id];
+}
+
+
+static sint32 GetFeatureId(const SPhoneset *self, const char *feature, s_erc *error)
+{
+	sint32 feature_id;
+
+
+	S_CLR_ERR(error);
+	if (feature == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "GetFeatureId",
+				  "Argument \"feature\" is NULL");
+		return -1;
+	}
+
+	if (self->ids == NULL)
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "GetFeatureId",
+				  "Phoneset features are not numbered");
+		return -1;
+	}
+
+	feature_id = get_id(self->ids->feature_ids, feature, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "GetFeatureId",
+				  "Call to \"get_id\" failed"))
+		return -1;
+
+	return feature_id;
+}
+
+
+static s_bool PhoneIdHasFeature(const SPhoneset *self, sint32 phone_id,
+								sint32 feature_id, s_erc *error)
+{
+	S_CLR_ERR(error);
+
+	if (self->ids == NULL)
+		return FALSE;
+
+	return id_has_feature(self->ids, phone_id, feature_id);
+}
+
+
 /************************************************************************************/
 /*                                                                                  */
 /* SPhoneset class initialization                                                   */
@@ -377,5 +568,10 @@ static SPhonesetJSONClass PhonesetJSONClass =
 	PhoneHasFeature,     /* phone_has_feature  */
 	HasPhone,            /* has_phone          */
 	GetPhoneFeatures,    /* get_phone_features */
-	GetPhoneList         /* get_phone_list     */
+	GetPhoneList,        /* get_phone_list     */
+	GetNumPhones,        /* get_num_phones     */
+	GetPhoneId,          /* get_phone_id       */
+	GetPhoneName,        /* get_phone_name     */
+	GetFeatureId,        /* get_feature_id     */
+	PhoneIdHasFeature    /* phone_id_has_feature */
 };
@@ -52,7 +52,9 @@
  * A Phoneset class implementation with the phones in a SMap structure
  * read from a JSON format file. The phones in the phoneset have
  * binary features, i.e. a phone either has a specific named feature
- * or it doesn't.
+ * or it doesn't. The phones and their features are numbered when the
+ * phoneset is read (see #s_phoneset_ids), which the phone feature
+ * queries use.
  * @{
  */
 
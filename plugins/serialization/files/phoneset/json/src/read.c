@@ -52,6 +52,13 @@
 static void set_phoneset_info(SPhoneset *phoneset, const SMap *phonesetDef,
 							  s_erc *error);
 
+static void free_id(void *key, void *data, s_erc *error);
+
+static uint32 add_id(s_hash_table *table, const char *name, uint32 id,
+					 const char **key, s_erc *error);
+
+static void set_phoneset_ids(SPhoneset *phoneset, const SMap *phones, s_erc *error);
+
 
 /************************************************************************************/
 /*                                                                                  */
@@ -59,7 +66,7 @@ static void set_phoneset_info(SPhoneset *phoneset, const SMap *phonesetDef,
 /*                                                                                  */
 /************************************************************************************/
 
-S_LOCAL SPhonesetJSON *s_read_phoneset_json(const char *path, s_erc *error)
+S_LOCAL SPhonesetJSON *s_read_phoneset_json(SDatasource *ds, s_erc *error)
 {
 	SPhonesetJSON *phoneset = NULL;
 	SMap *parsedFile = NULL;
@@ -76,13 +83,16 @@ S_LOCAL SPhonesetJSON *s_read_phoneset_json(const char *path, s_erc *error)
 	if (S_CHK_ERR(error, S_CONTERR,
 				  "s_read_phoneset_json",
 				  "Failed to create new phoneset object"))
+	{
+		S_DELETE(ds, "s_read_phoneset_json", error);
 		goto quit_error;
+	}
 
-	/* read the JSON file into a SMAP */
-	parsedFile = s_json_parse_config_file(path, error);
+	/* read the JSON data source into a SMAP */
+	parsedFile = s_json_parse_config_datasource(ds, error);
 	if (S_CHK_ERR(error, S_CONTERR,
 				  "s_read_phoneset_json",
-				  "Call to \"s_json_parse_config_file\" failed"))
+				  "Call to \"s_json_parse_config_datasource\" failed"))
 		goto quit_error;
 
 	/* get "phoneset-definition" key */
@@ -203,6 +213,13 @@ S_LOCAL SPhonesetJSON *s_read_phoneset_json(const char *path, s_erc *error)
 				  "Call to \"SMapCopy\" failed"))
 		goto quit_error;
 
+	/* number the phones and features, in file order */
+	set_phoneset_ids(S_PHONESET(phoneset), tmpMap, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "s_read_phoneset_json",
+				  "Call to \"set_phoneset_ids\" failed"))
+		goto quit_error;
+
 	/* done */
 	goto quit;
 
@@ -352,3 +369,287 @@ static void set_phoneset_info(SPhoneset *phoneset, const SMap *phonesetDef, s_er
 				  "Call to \"SMapGetInt\" failed"))
 		return;
 }
+
+
+static void free_id(void *key, void *data, s_erc *error)
+{
+	S_CLR_ERR(error);
+
+	if (key != NULL)
+		S_FREE(key);
+
+	if (data != NULL)
+		S_FREE(data);
+}
+
+
+/*
+ * the identifier of the name in the table, if it is not there yet it
+ * is added with the given identifier. The table's copy of the name
+ * is returned in key.
+ */
+static uint32 add_id(s_hash_table *table, const char *name, uint32 id,
+					 const char **key, s_erc *error)
+{
+	const s_hash_element *element;
+	char *name_copy;
+	uint32 *data;
+	size_t size;
+
+
+	S_CLR_ERR(error);
+
+	size = s_strzsize(name, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "add_id",
+				  "Call to \"s_strzsize\" failed"))
+		return 0;
+
+	element = s_hash_table_find(table, name, size, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "add_id",
+				  "Call to \"s_hash_table_find\" failed"))
+		return 0;
+
+	if (element != NULL)
+	{
+		data = (uint32*)s_hash_element_get_data(element, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "add_id",
+					  "Call to \"s_hash_element_get_data\" failed"))
+			return 0;
+
+		return *data;
+	}
+
+	name_copy = s_strdup(name, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "add_id",
+				  "Call to \"s_strdup\" failed"))
+		return 0;
+
+	data = S_MALLOC(uint32, 1);
+	if (data == NULL)
+	{
+		S_FTL_ERR(error, S_MEMERROR,
+				  "add_id",
+				  "Failed to allocate memory for 'uint32' object");
+		S_FREE(name_copy);
+		return 0;
+	}
+
+	*data = id;
+	s_hash_table_add(table, name_copy, size, data, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "add_id",
+				  "Call to \"s_hash_table_add\" failed"))
+	{
+		S_FREE(name_copy);
+		S_FREE(data);
+		return 0;
+	}
+
+	*key = name_copy;
+	return id;
+}
+
+
+/*
+ * number the phones and their features, and set the feature
+ * bitmasks of the phones.
+ */
+static void set_phoneset_ids(SPhoneset *phoneset, const SMap *phones, s_erc *error)
+{
+	s_phoneset_ids *ids;
+	SIterator *itr = NULL;
+	SIterator *featureItr = NULL;
+	const SList *featureList;
+	const char *feature;
+	const char **tmp;
+	uint32 feature_id;
+	uint32 max_features = 32;
+	uint32 i;
+
+
+	S_CLR_ERR(error);
+
+	ids = S_CALLOC(s_phoneset_ids, 1);
+	if (ids == NULL)
+	{
+		S_FTL_ERR(error, S_MEMERROR,
+				  "set_phoneset_ids",
+				  "Failed to allocate memory for 's_phoneset_ids' object");
+		return;
+	}
+
+	/* the phoneset frees the identifiers */
+	phoneset->ids = ids;
+
+	ids->num_phones = (uint32)SMapSize(phones, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "set_phoneset_ids",
+				  "Call to \"SMapSize\" failed"))
+		return;
+
+	ids->phone_ids = s_hash_table_new(&free_id, 8, error);
+	if (!*error)
+		ids->feature_ids = s_hash_table_new(&free_id, 6, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "set_phoneset_ids",
+				  "Call to \"s_hash_table_new\" failed"))
+		return;
+
+	ids->phone_names = S_CALLOC(const char*, ids->num_phones + 1);
+	ids->feature_names = S_CALLOC(const char*, max_features);
+	if ((ids->phone_names == NULL) || (ids->feature_names == NULL))
+	{
+		S_FTL_ERR(error, S_MEMERROR,
+				  "set_phoneset_ids",
+				  "Failed to allocate memory for 'const char*' object");
+		return;
+	}
+
+	/* number the phones and the features */
+	itr = S_ITERATOR_GET(phones, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "set_phoneset_ids",
+				  "Call to \"S_ITERATOR_GET\" failed"))
+		return;
+
+	for (i = 0; (itr != NULL) && (i < ids->num_phones); itr = SIteratorNext(itr), i++)
+	{
+		add_id(ids->phone_ids, SIteratorKey(itr, error), i, &(ids->phone_names[i]), error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "set_phoneset_ids",
+					  "Call to \"add_id\" failed"))
+			goto quit_error;
+
+		featureList = S_CAST(SIteratorObject(itr, error), SList, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "set_phoneset_ids",
+					  "Phoneset features of phone '%s' is not a list",
+					  ids->phone_names[i]))
+			goto quit_error;
+
+		featureItr = S_ITERATOR_GET(featureList, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "set_phoneset_ids",
+					  "Call to \"S_ITERATOR_GET\" failed"))
+			goto quit_error;
+
+		for (/* NOP */; featureItr != NULL; featureItr = SIteratorNext(featureItr))
+		{
+			feature = SObjectGetString(SIteratorObject(featureItr, error), error);
+			if (S_CHK_ERR(error, S_CONTERR,
+						  "set_phoneset_ids",
+						  "Phoneset feature of phone '%s' is not a string",
+						  ids->phone_names[i]))
+				goto quit_error;
+
+			if (ids->num_features == max_features)
+			{
+				max_features *= 2;
+				tmp = S_REALLOC(ids->feature_names, const char*, max_features);
+				if (tmp == NULL)
+				{
+					S_FTL_ERR(error, S_MEMERROR,
+							  "set_phoneset_ids",
+							  "Failed to reallocate memory for 'const char*' object");
+					goto quit_error;
+				}
+
+				ids->feature_names = tmp;
+			}
+
+			feature_id = add_id(ids->feature_ids, feature, ids->num_features,
+								&(ids->feature_names[ids->num_features]), error);
+			if (S_CHK_ERR(error, S_CONTERR,
+						  "set_phoneset_ids",
+						  "Call to \"add_id\" failed"))
+				goto quit_error;
+
+			if (feature_id == ids->num_features)
+				ids->num_features++;
+		}
+	}
+
+	if (itr != NULL)
+	{
+		S_DELETE(itr, "set_phoneset_ids", error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "set_phoneset_ids",
+					  "Failed to delete iterator"))
+			return;
+	}
+
+	ids->num_phones = i;
+
+	/* set the feature bitmasks */
+	ids->mask_size = (ids->num_features + 31) / 32;
+	ids->masks = S_CALLOC(uint32, (ids->num_phones * ids->mask_size) + 1);
+	if (ids->masks == NULL)
+	{
+		S_FTL_ERR(error, S_MEMERROR,
+				  "set_phoneset_ids",
+				  "Failed to allocate memory for 'uint32' object");
+		return;
+	}
+
+	itr = S_ITERATOR_GET(phones, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "set_phoneset_ids",
+				  "Call to \"S_ITERATOR_GET\" failed"))
+		return;
+
+	for (i = 0; (itr != NULL) && (i < ids->num_phones); itr = SIteratorNext(itr), i++)
+	{
+		featureItr = S_ITERATOR_GET(SIteratorObject(itr, error), error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "set_phoneset_ids",
+					  "Call to \"S_ITERATOR_GET\" failed"))
+			goto quit_error;
+
+		for (/* NOP */; featureItr != NULL; featureItr = SIteratorNext(featureItr))
+		{
+			const s_hash_element *element = NULL;
+			const uint32 *data = NULL;
+
+
+			feature = SObjectGetString(SIteratorObject(featureItr, error), error);
+			if (!*error)
+				element = s_hash_table_find(ids->feature_ids, feature,
+											s_strzsize(feature, error), error);
+			if (!*error)
+				data = s_hash_element_get_data(element, error);
+			if (S_CHK_ERR(error, S_CONTERR,
+						  "set_phoneset_ids",
+						  "Failed to get feature identifier"))
+				goto quit_error;
+
+			ids->masks[(i * ids->mask_size) + (*data / 32)] |= ((uint32)1 << (*data % 32));
+		}
+	}
+
+	if (itr != NULL)
+	{
+		S_DELETE(itr, "set_phoneset_ids", error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "set_phoneset_ids",
+					  "Failed to delete iterator"))
+			return;
+	}
+
+	return;
+
+quit_error:
+	{
+		s_erc local_err = S_SUCCESS;
+
+
+		if (featureItr != NULL)
+			S_DELETE(featureItr, "set_phoneset_ids", &local_err);
+
+		if (itr != NULL)
+			S_DELETE(itr, "set_phoneset_ids", &local_err);
+	}
+}
@@ -135,13 +135,37 @@ static void Dispose(void *obj, s_erc *error)
 static SObject *Load(const char *path, s_erc *error)
 {
 	SPhonesetJSON *phoneset;
+	SDatasource *ds;
 
 
 	S_CLR_ERR(error);
 
-	phoneset = s_read_phoneset_json(path, error);
+	ds = SFilesourceOpenFile(path, "r", error);
 	if (S_CHK_ERR(error, S_CONTERR,
 				  "Load",
+				  "Call to \"SFilesourceOpenFile\" failed"))
+		return NULL;
+
+	phoneset = s_read_phoneset_json(ds, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "Load",
+				  "Call to \"s_read_phoneset_json\" failed"))
+		return NULL;
+
+	return S_OBJECT(phoneset);
+}
+
+
+static SObject *LoadFromDatasource(SDatasource *ds, s_erc *error)
+{
+	SPhonesetJSON *phoneset;
+
+
+	S_CLR_ERR(error);
+
+	phoneset = s_read_phoneset_json(ds, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "LoadFromDatasource",
 				  "Call to \"s_read_phoneset_json\" failed"))
 		return NULL;
 
@@ -183,5 +207,6 @@ static SJSONPhonesetFileClass JSONPhonesetFileClass =
 	"spct_phoneset",           /* format  */
 	Load,                      /* load    */
 	Save,                      /* save    */
-	NULL                       /* save_to_datasource */
+	NULL,                      /* save_to_datasource   */
+	LoadFromDatasource         /* load_from_datasource */
 };
@@ -96,15 +96,16 @@ S_LOCAL void _s_serialized_json_phoneset_free(s_erc *error);
 
 
 /**
- * Read an JSON format phoneset from the given file.
+ * Read a JSON format phoneset from the given data source.
  *
- * @param path The full path and file name of the JSON format phoneset
- * to read.
+ * @param ds The data source to read the phoneset from. The
+ * function takes hold of the data source, it is deleted when reading
+ * is done (also on errors).
  * @param error Error code.
  *
  * @return Loaded phoneset or @c NULL on error.
  */
-S_LOCAL SPhonesetJSON *s_read_phoneset_json(const char *path, s_erc *error);
+S_LOCAL SPhonesetJSON *s_read_phoneset_json(SDatasource *ds, s_erc *error);
 
 
 /************************************************************************************/
@@ -40,6 +40,7 @@
 /*                                                                                  */
 /************************************************************************************/
 
+#include <string.h>
 #include "syllab_rewrites_rule.h"
 #include "syllab_rewrites.h"
 
@@ -52,6 +53,104 @@
 
 /* #define DBG_PRINT_RULE 1 */
 
+/* number of phones of a word that are syllabified without heap memory */
+#define S_SYLLAB_WORD_STACK_SIZE 128
+
+/* number of rules in a rule set word */
+#define S_SYLLAB_SET_BITS 32
+
+/* maximum number of rule set words of a phone */
+#define S_SYLLAB_MAX_SET_WORDS 32
+
+/* maximum number of items in a compiled context */
+#define S_SYLLAB_MAX_CONTEXT 32
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Data types                                                                       */
+/*                                                                                  */
+/************************************************************************************/
+
+/* operator of a context item, applies to the item before it */
+typedef enum
+{
+	S_SYLLAB_OP_NONE = 0,
+	S_SYLLAB_OP_STAR = 1,  /* "*", zero or more of the item before */
+	S_SYLLAB_OP_PLUS = 2   /* "+", one or more of the item before */
+} s_syllab_op;
+
+
+/* an item of a compiled context */
+typedef struct
+{
+	uint32      cls;       /* phone class of the item. */
+	s_syllab_op op;
+} s_syllab_item;
+
+
+/* a compiled rule */
+typedef struct
+{
+	s_syllab_item *LC;         /* swapped, as in the rule. */
+	uint32         lc_size;
+	s_bool         lc_fixed;   /* no operators, matched in the left table. */
+	uint32        *A;          /* phone class of each item. */
+	uint32         a_size;
+	s_syllab_item *RC;
+	uint32         rc_size;
+	s_bool         rc_fixed;   /* no operators, matched in the right table. */
+	uint32        *boundaries; /* a_size + 1 boundaries before each A item, and after. */
+} s_syllab_rule;
+
+
+/*
+ * The rules of a phone. The rules that can match at a position of
+ * the word are the intersection of the rule sets of the phones at
+ * the positions to the right (A and RC) and to the left (LC) of
+ * it. A position past the end of the word is matched by the rules
+ * without an item at the position.
+ */
+typedef struct
+{
+	uint32 *rules;       /* automaton rule of each rule, in rule order. */
+	uint32  num_rules;
+	uint32  set_size;
+	uint32  right_size;
+	uint32 *right;       /* right_size x num_symbols x set_size rule sets. */
+	uint32 *right_end;   /* right_size x set_size rule sets. */
+	uint32  left_size;
+	uint32 *left;        /* left_size x num_symbols x set_size rule sets. */
+	uint32 *left_end;    /* left_size x set_size rule sets. */
+} s_syllab_phone;
+
+
+struct s_syllab_automaton
+{
+	s_hash_table   *ids;          /* phone identifiers. */
+	uint32          num_ids;
+	uint32          num_symbols;  /* num_ids + 1, symbol num_ids is unknown phones. */
+	uint32          word_end;     /* identifier of "#". */
+	sint32          boundary;     /* identifier of the syllable boundary symbol, or -1. */
+	uint32         *classes;      /* num_classes x class_size phone sets. */
+	uint32          num_classes;
+	uint32          class_size;
+	s_syllab_rule  *rules;
+	uint32          num_rules;
+	s_syllab_phone *phones;       /* num_symbols phones. */
+};
+
+
+/* temporary tables of the compilation */
+typedef struct
+{
+	const SMap   *sets;
+	s_hash_table *class_ids;      /* class of a rule item string. */
+	s_hash_table *rule_ids;       /* automaton rule of a rule object. */
+	uint32        classes_size;
+	uint32        rules_size;
+} s_syllab_compiler;
+
 
 /************************************************************************************/
 /*                                                                                  */
@@ -79,6 +178,65 @@ static s_str_list *run_rewrite_rules(const SSyllabificationRewrites *self,
 static void replace_B(const s_str_list *B, s_str_list *A,
 					  const char *syllable_boundary_symbol, s_erc *error);
 
+static const char *get_boundary_symbol(const SSyllabification *self, s_erc *error);
+
+static void free_id(void *key, void *data, s_erc *error);
+
+static uint32 add_id(s_hash_table *table, const void *key, size_t key_size,
+					 uint32 id, s_erc *error);
+
+static sint32 find_id(const s_hash_table *table, const void *key, size_t key_size,
+					  s_erc *error);
+
+static uint32 add_phone_id(s_syllab_automaton *automaton, const char *name,
+						   s_erc *error);
+
+static void add_phone_ids(s_syllab_automaton *automaton, const s_str_list *list,
+						  s_erc *error);
+
+static void add_rules_phone_ids(s_syllab_automaton *automaton, const SList *rules,
+								s_erc *error);
+
+static void add_sets_phone_ids(s_syllab_automaton *automaton, const SMap *sets,
+							   s_erc *error);
+
+static uint32 get_class(s_syllab_automaton *automaton, s_syllab_compiler *compiler,
+						const char *string, s_erc *error);
+
+static s_syllab_item *compile_context(s_syllab_automaton *automaton,
+									  s_syllab_compiler *compiler,
+									  const s_str_list *context, uint32 *size,
+									  s_bool *fixed, s_erc *error);
+
+static sint32 compile_rule(s_syllab_automaton *automaton, s_syllab_compiler *compiler,
+						   const SSyllabificationRewritesRule *rule,
+						   const char *syllable_boundary_symbol, s_erc *error);
+
+static s_bool compile_phone(s_syllab_automaton *automaton, s_syllab_compiler *compiler,
+							s_syllab_phone *phone, const SList *rules,
+							const char *syllable_boundary_symbol, s_erc *error);
+
+static void phone_sets(const s_syllab_automaton *automaton, s_syllab_phone *phone,
+					   s_bool right, s_erc *error);
+
+static void automaton_free(s_syllab_automaton *automaton);
+
+static s_bool class_has(const s_syllab_automaton *automaton, uint32 cls, uint32 id);
+
+static s_bool context_match(const s_syllab_automaton *automaton,
+							const s_syllab_item *pattern, uint32 size,
+							const uint32 *tape, sint32 pos, sint32 step,
+							sint32 remaining);
+
+static sint32 match_rule(const s_syllab_automaton *automaton,
+						 const s_syllab_phone *phone, const uint32 *tape,
+						 uint32 tape_size, uint32 pos);
+
+static SList *add_syllable(SList *syllables, SList *syl, s_erc *error);
+
+static SList *syllabify_compiled(const SSyllabificationRewrites *self,
+								 const SList *phoneList, s_erc *error);
+
 
 /************************************************************************************/
 /*                                                                                  */
@@ -535,209 +693,1447 @@ error_return:
 }
 
 
-/************************************************************************************/
-/*                                                                                  */
-/* Static class function implementations                                            */
-/*                                                                                  */
-/************************************************************************************/
-
-static void Init(void *obj, s_erc *error)
+/* the syllable boundary symbol of the features, defaults to "-" */
+static const char *get_boundary_symbol(const SSyllabification *self, s_erc *error)
 {
-	SSyllabificationRewrites *self = obj;
+	const SObject *tmp;
+	const char *syllable_boundary_symbol;
 
 
 	S_CLR_ERR(error);
-	self->rules = NULL;
-	self->sets = NULL;
-}
 
+	if (self->features == NULL)
+		return "-";
 
-static void Destroy(void *obj, s_erc *error)
-{
-	SSyllabificationRewrites *self = obj;
+	tmp = SMapGetObjectDef(self->features, "syllable-boundary-symbol", NULL, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "get_boundary_symbol",
+				  "Call to \"SMapGetObjectDef\" failed"))
+		return NULL;
 
+	if (tmp == NULL)
+		return "-";
 
-	S_CLR_ERR(error);
-	if (self->rules != NULL)
-		S_DELETE(self->rules, "Destroy", error);
+	syllable_boundary_symbol = SObjectGetString(tmp, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "get_boundary_symbol",
+				  "Call to \"SObjectGetString\" failed"))
+		return NULL;
 
-	if (self->sets != NULL)
-		S_DELETE(self->sets, "Destroy", error);
+	return syllable_boundary_symbol;
 }
 
 
-static void Dispose(void *obj, s_erc *error)
+static void free_id(void *key, void *data, s_erc *error)
 {
 	S_CLR_ERR(error);
-	SObjectDecRef(obj);
+
+	if (key != NULL)
+		S_FREE(key);
+
+	if (data != NULL)
+		S_FREE(data);
 }
 
 
-static const char *GetName(const SSyllabification *self, s_erc *error)
+/*
+ * the identifier of the key in the table, if it is not there yet it
+ * is added with the given identifier.
+ */
+static uint32 add_id(s_hash_table *table, const void *key, size_t key_size,
+					 uint32 id, s_erc *error)
 {
+	const s_hash_element *element;
+	char *key_copy;
+	uint32 *data;
+
+
 	S_CLR_ERR(error);
 
-	if (self->info == NULL)
-		return NULL;
+	element = s_hash_table_find(table, key, key_size, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "add_id",
+				  "Call to \"s_hash_table_find\" failed"))
+		return 0;
 
-	return (const char*)self->info->name;
+	if (element != NULL)
+	{
+		data = (uint32*)s_hash_element_get_data(element, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "add_id",
+					  "Call to \"s_hash_element_get_data\" failed"))
+			return 0;
+
+		return *data;
+	}
+
+	key_copy = S_MALLOC(char, key_size);
+	data = S_MALLOC(uint32, 1);
+	if ((key_copy == NULL) || (data == NULL))
+	{
+		S_FTL_ERR(error, S_MEMERROR,
+				  "add_id",
+				  "Failed to allocate memory for hash table element");
+		if (key_copy != NULL)
+			S_FREE(key_copy);
+		if (data != NULL)
+			S_FREE(data);
+		return 0;
+	}
+
+	memcpy(key_copy, key, key_size);
+	*data = id;
+
+	s_hash_table_add(table, key_copy, key_size, data, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "add_id",
+				  "Call to \"s_hash_table_add\" failed"))
+	{
+		S_FREE(key_copy);
+		S_FREE(data);
+		return 0;
+	}
+
+	return id;
 }
 
 
-static const char *GetDescription(const SSyllabification *self, s_erc *error)
+/* the identifier of the key in the table, or -1 */
+static sint32 find_id(const s_hash_table *table, const void *key, size_t key_size,
+					  s_erc *error)
 {
+	const s_hash_element *element;
+	const uint32 *data;
+
+
 	S_CLR_ERR(error);
 
-	if (self->info == NULL)
-		return NULL;
+	element = s_hash_table_find(table, key, key_size, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "find_id",
+				  "Call to \"s_hash_table_find\" failed"))
+		return -1;
 
-	return (const char*)self->info->description;
+	if (element == NULL)
+		return -1;
+
+	data = (const uint32*)s_hash_element_get_data(element, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "find_id",
+				  "Call to \"s_hash_element_get_data\" failed"))
+		return -1;
+
+	return (sint32)*data;
 }
 
 
-static const char *GetLanguage(const SSyllabification *self, s_erc *error)
+/* the identifier of the phone, numbering it if it is new */
+static uint32 add_phone_id(s_syllab_automaton *automaton, const char *name,
+						   s_erc *error)
 {
+	size_t size;
+	uint32 id;
+
+
 	S_CLR_ERR(error);
 
-	if (self->info == NULL)
-		return NULL;
+	size = s_strzsize(name, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "add_phone_id",
+				  "Call to \"s_strzsize\" failed"))
+		return 0;
 
-	return (const char*)self->info->language;
+	id = add_id(automaton->ids, name, size, automaton->num_ids, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "add_phone_id",
+				  "Call to \"add_id\" failed"))
+		return 0;
+
+	if (id == automaton->num_ids)
+		automaton->num_ids++;
+
+	return id;
 }
 
 
-static const char *GetLangCode(const SSyllabification *self, s_erc *error)
+static void add_phone_ids(s_syllab_automaton *automaton, const s_str_list *list,
+						  s_erc *error)
 {
+	const s_str_list_element *itr;
+	const char *element;
+
+
 	S_CLR_ERR(error);
 
-	if (self->info == NULL)
-		return NULL;
+	itr = s_str_list_first(list, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "add_phone_ids",
+				  "Call to \"s_str_list_first\" failed"))
+		return;
 
-	return (const char*)self->info->lang_code;
+	while (itr != NULL)
+	{
+		element = s_str_list_element_get(itr, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "add_phone_ids",
+					  "Call to \"s_str_list_element_get\" failed"))
+			return;
+
+		add_phone_id(automaton, element, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "add_phone_ids",
+					  "Call to \"add_phone_id\" failed"))
+			return;
+
+		itr = s_str_list_element_next(itr, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "add_phone_ids",
+					  "Call to \"s_str_list_element_next\" failed"))
+			return;
+	}
 }
 
 
-static const s_version *SGetVersion(const SSyllabification *self, s_erc *error)
+/* number the phones and set names of the contexts of the rules */
+static void add_rules_phone_ids(s_syllab_automaton *automaton, const SList *rules,
+								s_erc *error)
 {
+	const SSyllabificationRewritesRule *rule;
+	SIterator *itr;
+
+
 	S_CLR_ERR(error);
 
-	if (self->info == NULL)
-		return NULL;
+	itr = S_ITERATOR_GET(rules, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "add_rules_phone_ids",
+				  "Call to \"S_ITERATOR_GET\" failed"))
+		return;
 
-	return (const s_version*)&(self->info->version);
+	for (/* NOP */; itr != NULL; itr = SIteratorNext(itr))
+	{
+		rule = (const SSyllabificationRewritesRule*)SIteratorObject(itr, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "add_rules_phone_ids",
+					  "Call to \"SIteratorObject\" failed"))
+			break;
+
+		add_phone_ids(automaton, rule->LC, error);
+		if (!*error)
+			add_phone_ids(automaton, rule->A, error);
+		if (!*error)
+			add_phone_ids(automaton, rule->RC, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "add_rules_phone_ids",
+					  "Call to \"add_phone_ids\" failed"))
+			break;
+	}
+
+	if (itr != NULL)
+		S_DELETE(itr, "add_rules_phone_ids", error);
 }
 
 
-static const SObject *GetFeature(const SSyllabification *self, const char *key,
-								 s_erc *error)
+/* number the phones of the sets */
+static void add_sets_phone_ids(s_syllab_automaton *automaton, const SMap *sets,
+							   s_erc *error)
 {
-	const SObject *feature;
+	const SList *setList;
+	SIterator *itr;
+	SIterator *setItr = NULL;
 
 
 	S_CLR_ERR(error);
-	if (key == NULL)
+
+	itr = S_ITERATOR_GET(sets, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "add_sets_phone_ids",
+				  "Call to \"S_ITERATOR_GET\" failed"))
+		return;
+
+	for (/* NOP */; itr != NULL; itr = SIteratorNext(itr))
 	{
-		S_CTX_ERR(error, S_ARGERROR,
-				  "GetFeature",
-				  "Argument \"key\" is NULL");
-		return NULL;
-	}
+		setList = S_CAST(SIteratorObject(itr, error), SList, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "add_sets_phone_ids",
+					  "Call to \"S_CAST(SList)\" failed"))
+			break;
 
-	if (self->features == NULL)
-		return NULL;
+		setItr = S_ITERATOR_GET(setList, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "add_sets_phone_ids",
+					  "Call to \"S_ITERATOR_GET\" failed"))
+			break;
 
-	feature = SMapGetObjectDef(self->features, key, NULL, error);
-	if (S_CHK_ERR(error, S_CONTERR,
-				  "GetFeature",
-				  "Call to \"SMapGetObjectDef\" failed"))
-		return NULL;
+		for (/* NOP */; setItr != NULL; setItr = SIteratorNext(setItr))
+		{
+			add_phone_id(automaton,
+						 SObjectGetString(SIteratorObject(setItr, error), error),
+						 error);
+			if (S_CHK_ERR(error, S_CONTERR,
+						  "add_sets_phone_ids",
+						  "Call to \"SObjectGetString/add_phone_id\" failed"))
+				break;
+		}
 
-	return feature;
+		if (*error)
+			break;
+	}
+
+	if (setItr != NULL)
+		S_DELETE(setItr, "add_sets_phone_ids", error);
+
+	if (itr != NULL)
+		S_DELETE(itr, "add_sets_phone_ids", error);
 }
 
 
-/**
- * return a vallist of vallists where the primary list is syllables and the secondary
- * lists are the phones in the syllables. for example :
- * for mathematics phonelist is : (m , ae , th, ax, m, ae, t, ih, k, s)
- * syllfunc returns : ((m, ae), (th, ax), (m, ae), (t, ih, k, s))
+/*
+ * the class of a rule item, the set of phones that it matches: the
+ * phone with the same name, and the phones of the set with the
+ * same name.
  */
-
-static SList *Syllabify(const SSyllabification *self, const SItem *word,
-						const SList *phoneList, s_erc *error)
+static uint32 get_class(s_syllab_automaton *automaton, s_syllab_compiler *compiler,
+						const char *string, s_erc *error)
 {
-	s_str_list *string_list = NULL;
-	SList *syl = NULL;
-	SList *syllables = NULL;
-	s_bool got_more_syllables;
-	const s_str_list_element *itr;
-	const char *syllable_boundary_symbol;
 	const SObject *tmp;
+	const SList *setList;
+	SIterator *itr;
+	uint32 *classes;
+	uint32 *bits;
+	uint32 new_size;
+	uint32 cls;
+	sint32 id;
+	size_t size;
 
 
 	S_CLR_ERR(error);
-	if (phoneList == NULL)
-	{
-		S_CTX_ERR(error, S_ARGERROR,
-				  "Syllabify",
-				  "Argument \"phoneList\" is NULL");
-		goto error_return;
-	}
 
-	/* get syllable boundary symbol */
-	tmp = SMapGetObjectDef(self->features, "syllable-boundary-symbol", NULL, error);
+	size = s_strzsize(string, error);
 	if (S_CHK_ERR(error, S_CONTERR,
-				  "Syllabify",
-				  "Call to \"SMapGetObjectDef\" failed"))
-		goto error_return;
+				  "get_class",
+				  "Call to \"s_strzsize\" failed"))
+		return 0;
 
-	if (tmp != NULL)
-	{
-		syllable_boundary_symbol = SObjectGetString(tmp, error);
-		if (S_CHK_ERR(error, S_CONTERR,
-					  "Syllabify",
-					  "Call to \"SObjectGetString\" failed"))
-			goto error_return;
-	}
-	else
+	id = find_id(compiler->class_ids, string, size, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "get_class",
+				  "Call to \"find_id\" failed"))
+		return 0;
+
+	if (id >= 0)
+		return (uint32)id;
+
+	if (automaton->num_classes == compiler->classes_size)
 	{
-		syllable_boundary_symbol = "-"; /* defaults to "-" */
-	}
+		new_size = (compiler->classes_size == 0) ? 32 : (compiler->classes_size * 2);
+		classes = S_REALLOC(automaton->classes, uint32, new_size * automaton->class_size);
+		if (classes == NULL)
+		{
+			S_FTL_ERR(error, S_MEMERROR,
+					  "get_class",
+					  "Failed to reallocate memory for 'uint32' object");
+			return 0;
+		}
 
-	string_list = run_rewrite_rules(S_SYLLABIFICATIONREWRITES(self),
-									phoneList, syllable_boundary_symbol,
-									error);
-	if (S_CHK_ERR(error, S_CONTERR,
-				  "Syllabify",
-				  "Call to \"run_rewrite_rules\" failed"))
-		goto error_return;
+		memset(classes + (compiler->classes_size * automaton->class_size), 0,
+			   sizeof(uint32) * (new_size - compiler->classes_size) * automaton->class_size);
+		automaton->classes = classes;
+		compiler->classes_size = new_size;
+	}
 
-	/* create a new syllable */
-	syl = S_LIST(S_NEW(SListList, error));
-	if (S_CHK_ERR(error, S_CONTERR,
-				  "Syllabify",
-				  "Failed to create new list"))
-		goto error_return;
+	cls = automaton->num_classes++;
+	bits = &automaton->classes[cls * automaton->class_size];
 
-	/* create a new syllables list */
-	syllables = S_LIST(S_NEW(SListList, error));
+	id = find_id(automaton->ids, string, size, error);
 	if (S_CHK_ERR(error, S_CONTERR,
-				  "Syllabify",
-				  "Failed to create new list"))
-		goto error_return;
+				  "get_class",
+				  "Call to \"find_id\" failed"))
+		return 0;
 
-	/* iterate over otape */
-	itr = s_str_list_first(string_list, error);
-	if (S_CHK_ERR(error, S_CONTERR,
-				  "Syllabify",
-				  "Call to \"s_str_list_first\" failed"))
-		goto error_return;
+	if (id >= 0)
+		bits[id / S_SYLLAB_SET_BITS] |= (uint32)1 << (id % S_SYLLAB_SET_BITS);
 
-	got_more_syllables = FALSE;
-	while (itr != NULL)
+	if (compiler->sets != NULL)
 	{
-		const char *element;
-		int rv;
+		tmp = SMapGetObjectDef(compiler->sets, string, NULL, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "get_class",
+					  "Call to \"SMapGetObjectDef\" failed"))
+			return 0;
+
+		if (tmp != NULL)
+		{
+			setList = S_CAST(tmp, SList, error);
+			if (S_CHK_ERR(error, S_CONTERR,
+						  "get_class",
+						  "Call to \"S_CAST(SList)\" failed"))
+				return 0;
+
+			itr = S_ITERATOR_GET(setList, error);
+			if (S_CHK_ERR(error, S_CONTERR,
+						  "get_class",
+						  "Call to \"S_ITERATOR_GET\" failed"))
+				return 0;
+
+			for (/* NOP */; itr != NULL; itr = SIteratorNext(itr))
+			{
+				const char *member;
+
+
+				member = SObjectGetString(SIteratorObject(itr, error), error);
+				if (!*error)
+					id = find_id(automaton->ids, member, s_strzsize(member, error), error);
+				if (S_CHK_ERR(error, S_CONTERR,
+							  "get_class",
+							  "Call to \"SObjectGetString/find_id\" failed"))
+				{
+					S_DELETE(itr, "get_class", error);
+					return 0;
+				}
+
+				if (id >= 0)
+					bits[id / S_SYLLAB_SET_BITS] |= (uint32)1 << (id % S_SYLLAB_SET_BITS);
+			}
+		}
+	}
+
+	add_id(compiler->class_ids, string, size, cls, error);
+	S_CHK_ERR(error, S_CONTERR,
+			  "get_class",
+			  "Call to \"add_id\" failed");
+
+	return cls;
+}
+
+
+/* the items of a context, fixed is FALSE if it has "*" or "+" operators */
+static s_syllab_item *compile_context(s_syllab_automaton *automaton,
+									  s_syllab_compiler *compiler,
+									  const s_str_list *context, uint32 *size,
+									  s_bool *fixed, s_erc *error)
+{
+	s_syllab_item *items;
+	const s_str_list_element *itr;
+	const char *element;
+	uint32 i;
+
+
+	S_CLR_ERR(error);
+	*fixed = TRUE;
+
+	*size = s_str_list_size(context, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "compile_context",
+				  "Call to \"s_str_list_size\" failed"))
+		return NULL;
+
+	if (*size == 0)
+		return NULL;
+
+	items = S_CALLOC(s_syllab_item, *size);
+	if (items == NULL)
+	{
+		S_FTL_ERR(error, S_MEMERROR,
+				  "compile_context",
+				  "Failed to allocate memory for 's_syllab_item' object");
+		return NULL;
+	}
+
+	itr = s_str_list_first(context, error);
+	for (i = 0; (*error == S_SUCCESS) && (itr != NULL) && (i < *size); i++)
+	{
+		element = s_str_list_element_get(itr, error);
+		if (*error)
+			break;
+
+		items[i].cls = get_class(automaton, compiler, element, error);
+		if (*error)
+			break;
+
+		if (s_strcmp(element, "*", error) == 0)
+			items[i].op = S_SYLLAB_OP_STAR;
+		else if (s_strcmp(element, "+", error) == 0)
+			items[i].op = S_SYLLAB_OP_PLUS;
+		else
+			items[i].op = S_SYLLAB_OP_NONE;
+
+		if (items[i].op != S_SYLLAB_OP_NONE)
+			*fixed = FALSE;
+
+		itr = s_str_list_element_next(itr, error);
+	}
+
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "compile_context",
+				  "Failed to compile context item"))
+	{
+		S_FREE(items);
+		return NULL;
+	}
+
+	return items;
+}
+
+
+/*
+ * the automaton rule of the given rule, compiling it if it is new,
+ * or -1 if the rule can not be compiled.
+ */
+static sint32 compile_rule(s_syllab_automaton *automaton, s_syllab_compiler *compiler,
+						   const SSyllabificationRewritesRule *rule,
+						   const char *syllable_boundary_symbol, s_erc *error)
+{
+	s_syllab_rule *compiled;
+	s_syllab_rule *rules;
+	const s_str_list_element *itr;
+	const char *element;
+	uint32 new_size;
+	uint32 index;
+	uint32 i;
+	sint32 id;
+
+
+	S_CLR_ERR(error);
+
+	id = find_id(compiler->rule_ids, &rule, sizeof(rule), error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "compile_rule",
+				  "Call to \"find_id\" failed"))
+		return -1;
+
+	if (id >= 0)
+		return id;
+
+	if ((s_str_list_size(rule->LC, error) > S_SYLLAB_MAX_CONTEXT)
+		|| (s_str_list_size(rule->A, error) > S_SYLLAB_MAX_CONTEXT)
+		|| (s_str_list_size(rule->RC, error) > S_SYLLAB_MAX_CONTEXT)
+		|| (s_str_list_size(rule->A, error) == 0))
+		return -1;
+
+	if (automaton->num_rules == compiler->rules_size)
+	{
+		new_size = (compiler->rules_size == 0) ? 64 : (compiler->rules_size * 2);
+		rules = S_REALLOC(automaton->rules, s_syllab_rule, new_size);
+		if (rules == NULL)
+		{
+			S_FTL_ERR(error, S_MEMERROR,
+					  "compile_rule",
+					  "Failed to reallocate memory for 's_syllab_rule' object");
+			return -1;
+		}
+
+		automaton->rules = rules;
+		compiler->rules_size = new_size;
+	}
+
+	/* counted before it is filled in, so that it is freed on errors */
+	index = automaton->num_rules++;
+	compiled = &automaton->rules[index];
+	memset(compiled, 0, sizeof(s_syllab_rule));
+
+	compiled->LC = compile_context(automaton, compiler, rule->LC, &compiled->lc_size,
+								   &compiled->lc_fixed, error);
+	if (!*error)
+		compiled->RC = compile_context(automaton, compiler, rule->RC, &compiled->rc_size,
+									   &compiled->rc_fixed, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "compile_rule",
+				  "Call to \"compile_context\" failed"))
+		return -1;
+
+	compiled->a_size = s_str_list_size(rule->A, error);
+	compiled->A = S_MALLOC(uint32, compiled->a_size);
+	compiled->boundaries = S_CALLOC(uint32, compiled->a_size + 1);
+	if ((compiled->A == NULL) || (compiled->boundaries == NULL))
+	{
+		S_FTL_ERR(error, S_MEMERROR,
+				  "compile_rule",
+				  "Failed to allocate memory for 'uint32' object");
+		return -1;
+	}
+
+	itr = s_str_list_first(rule->A, error);
+	for (i = 0; (*error == S_SUCCESS) && (itr != NULL) && (i < compiled->a_size); i++)
+	{
+		element = s_str_list_element_get(itr, error);
+		if (!*error)
+			compiled->A[i] = get_class(automaton, compiler, element, error);
+		if (!*error)
+			itr = s_str_list_element_next(itr, error);
+	}
+
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "compile_rule",
+				  "Failed to compile rule context"))
+		return -1;
+
+	/*
+	 * the boundaries of the replacement, as replace_B inserts
+	 * them: a boundary symbol of B is inserted before the current
+	 * phone of A, any other symbol moves on to the next phone, and
+	 * one boundary is added at the end if B is longer.
+	 */
+	i = 0;
+	itr = s_str_list_first(rule->B, error);
+	while ((*error == S_SUCCESS) && (itr != NULL) && (i < compiled->a_size))
+	{
+		element = s_str_list_element_get(itr, error);
+		if (*error)
+			break;
+
+		if (s_strcmp(element, syllable_boundary_symbol, error) == 0)
+			compiled->boundaries[i]++;
+		else
+			i++;
+
+		itr = s_str_list_element_next(itr, error);
+	}
+
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "compile_rule",
+				  "Failed to compile rule replacement"))
+		return -1;
+
+	if (itr != NULL)
+		compiled->boundaries[compiled->a_size] = 1;
+
+	add_id(compiler->rule_ids, &rule, sizeof(rule), index, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "compile_rule",
+				  "Call to \"add_id\" failed"))
+		return -1;
+
+	return (sint32)index;
+}
+
+
+/*
+ * compile the rules of a phone, returns FALSE if they can not be
+ * compiled.
+ */
+static s_bool compile_phone(s_syllab_automaton *automaton, s_syllab_compiler *compiler,
+							s_syllab_phone *phone, const SList *rules,
+							const char *syllable_boundary_symbol, s_erc *error)
+{
+	const SSyllabificationRewritesRule *rule;
+	SIterator *itr;
+	sint32 index;
+	uint32 num_rules;
+	uint32 i;
+
+
+	S_CLR_ERR(error);
+
+	num_rules = SListSize(rules, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "compile_phone",
+				  "Call to \"SListSize\" failed"))
+		return FALSE;
+
+	if (num_rules == 0)
+		return FALSE;
+
+	phone->set_size = (num_rules + S_SYLLAB_SET_BITS - 1) / S_SYLLAB_SET_BITS;
+	if (phone->set_size > S_SYLLAB_MAX_SET_WORDS)
+		return FALSE;
+
+	phone->rules = S_MALLOC(uint32, num_rules);
+	if (phone->rules == NULL)
+	{
+		S_FTL_ERR(error, S_MEMERROR,
+				  "compile_phone",
+				  "Failed to allocate memory for 'uint32' object");
+		return FALSE;
+	}
+
+	itr = S_ITERATOR_GET(rules, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "compile_phone",
+				  "Call to \"S_ITERATOR_GET\" failed"))
+		return FALSE;
+
+	for (i = 0; (itr != NULL) && (i < num_rules); itr = SIteratorNext(itr), i++)
+	{
+		rule = (const SSyllabificationRewritesRule*)SIteratorObject(itr, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "compile_phone",
+					  "Call to \"SIteratorObject\" failed"))
+			break;
+
+		index = compile_rule(automaton, compiler, rule, syllable_boundary_symbol, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "compile_phone",
+					  "Call to \"compile_rule\" failed"))
+			break;
+
+		if (index < 0)
+			break;
+
+		phone->rules[i] = (uint32)index;
+	}
+
+	if (itr != NULL)
+	{
+		S_DELETE(itr, "compile_phone", error);
+		return FALSE;
+	}
+
+	phone->num_rules = num_rules;
+
+	phone_sets(automaton, phone, TRUE, error);
+	if (!*error)
+		phone_sets(automaton, phone, FALSE, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "compile_phone",
+				  "Call to \"phone_sets\" failed"))
+		return FALSE;
+
+	return TRUE;
+}
+
+
+/*
+ * create the rule sets of the positions to the right (A and RC)
+ * or to the left (LC) of the phone. Contexts with operators are not
+ * in the sets, they are matched on the rules that are selected.
+ */
+static void phone_sets(const s_syllab_automaton *automaton, s_syllab_phone *phone,
+					   s_bool right, s_erc *error)
+{
+	const s_syllab_rule *rule;
+	uint32 *sets;
+	uint32 *end;
+	uint32 size = 0;
+	uint32 items;
+	uint32 word;
+	uint32 bit;
+	uint32 cls;
+	uint32 i;
+	uint32 k;
+	uint32 q;
+
+
+	S_CLR_ERR(error);
+
+	for (i = 0; i < phone->num_rules; i++)
+	{
+		rule = &automaton->rules[phone->rules[i]];
+		if (right)
+			items = rule->a_size + (rule->rc_fixed ? rule->rc_size : 0);
+		else
+			items = rule->lc_fixed ? rule->lc_size : 0;
+
+		if (items > size)
+			size = items;
+	}
+
+	if (size == 0)
+		return;
+
+	sets = S_CALLOC(uint32, size * automaton->num_symbols * phone->set_size);
+	end = S_CALLOC(uint32, size * phone->set_size);
+	if ((sets == NULL) || (end == NULL))
+	{
+		S_FTL_ERR(error, S_MEMERROR,
+				  "phone_sets",
+				  "Failed to allocate memory for 'uint32' object");
+		if (sets != NULL)
+			S_FREE(sets);
+		if (end != NULL)
+			S_FREE(end);
+		return;
+	}
+
+	for (i = 0; i < phone->num_rules; i++)
+	{
+		rule = &automaton->rules[phone->rules[i]];
+		word = i / S_SYLLAB_SET_BITS;
+		bit = (uint32)1 << (i % S_SYLLAB_SET_BITS);
+
+		for (k = 0; k < size; k++)
+		{
+			s_bool has_item = TRUE;
+
+
+			if (right && (k < rule->a_size))
+				cls = rule->A[k];
+			else if (right && rule->rc_fixed && ((k - rule->a_size) < rule->rc_size))
+				cls = rule->RC[k - rule->a_size].cls;
+			else if (!right && rule->lc_fixed && (k < rule->lc_size))
+				cls = rule->LC[k].cls;
+			else
+				has_item = FALSE;
+
+			if (!has_item)
+				end[(k * phone->set_size) + word] |= bit;
+
+			for (q = 0; q < automaton->num_symbols; q++)
+			{
+				if (!has_item || class_has(automaton, cls, q))
+					sets[(((k * automaton->num_symbols) + q) * phone->set_size) + word] |= bit;
+			}
+		}
+	}
+
+	if (right)
+	{
+		phone->right = sets;
+		phone->right_end = end;
+		phone->right_size = size;
+	}
+	else
+	{
+		phone->left = sets;
+		phone->left_end = end;
+		phone->left_size = size;
+	}
+}
+
+
+static void automaton_free(s_syllab_automaton *automaton)
+{
+	s_erc local_err = S_SUCCESS;
+	uint32 i;
+
+
+	if (automaton->ids != NULL)
+		s_hash_table_delete(automaton->ids, &local_err);
+
+	if (automaton->classes != NULL)
+		S_FREE(automaton->classes);
+
+	if (automaton->rules != NULL)
+	{
+		for (i = 0; i < automaton->num_rules; i++)
+		{
+			if (automaton->rules[i].LC != NULL)
+				S_FREE(automaton->rules[i].LC);
+
+			if (automaton->rules[i].A != NULL)
+				S_FREE(automaton->rules[i].A);
+
+			if (automaton->rules[i].RC != NULL)
+				S_FREE(automaton->rules[i].RC);
+
+			if (automaton->rules[i].boundaries != NULL)
+				S_FREE(automaton->rules[i].boundaries);
+		}
+
+		S_FREE(automaton->rules);
+	}
+
+	if (automaton->phones != NULL)
+	{
+		for (i = 0; i < automaton->num_symbols; i++)
+		{
+			if (automaton->phones[i].rules != NULL)
+				S_FREE(automaton->phones[i].rules);
+
+			if (automaton->phones[i].right != NULL)
+				S_FREE(automaton->phones[i].right);
+
+			if (automaton->phones[i].right_end != NULL)
+				S_FREE(automaton->phones[i].right_end);
+
+			if (automaton->phones[i].left != NULL)
+				S_FREE(automaton->phones[i].left);
+
+			if (automaton->phones[i].left_end != NULL)
+				S_FREE(automaton->phones[i].left_end);
+		}
+
+		S_FREE(automaton->phones);
+	}
+
+	S_FREE(automaton);
+}
+
+
+static s_bool class_has(const s_syllab_automaton *automaton, uint32 cls, uint32 id)
+{
+	const uint32 *bits = &automaton->classes[cls * automaton->class_size];
+
+
+	return ((bits[id / S_SYLLAB_SET_BITS] >> (id % S_SYLLAB_SET_BITS)) & 1) ? TRUE : FALSE;
+}
+
+
+/*
+ * the same as _context_match of the rules, on phone identifiers.
+ * The tape is read from pos in the direction of step, and has
+ * remaining phones in that direction.
+ */
+static s_bool context_match(const s_syllab_automaton *automaton,
+							const s_syllab_item *pattern, uint32 size,
+							const uint32 *tape, sint32 pos, sint32 step,
+							sint32 remaining)
+{
+	s_syllab_item new_pattern[S_SYLLAB_MAX_CONTEXT];
+	s_bool first;
+
+
+	if (size == 0) /* rule context is none, so match */
+		return TRUE;
+
+	if (remaining <= 0)
+		return FALSE;
+
+	first = class_has(automaton, pattern[0].cls, tape[pos]);
+
+	if ((size > 1) && (pattern[1].op == S_SYLLAB_OP_STAR))
+	{
+		/* pattern[2:] */
+		if (context_match(automaton, pattern + 2, size - 2, tape, pos, step, remaining))
+			return TRUE;
+
+		/* pattern[0] + pattern[2:] */
+		new_pattern[0] = pattern[0];
+		memcpy(new_pattern + 1, pattern + 2, sizeof(s_syllab_item) * (size - 2));
+		if (context_match(automaton, new_pattern, size - 1, tape, pos, step, remaining))
+			return TRUE;
+
+		/* pattern against tape[1:] */
+		return first && context_match(automaton, pattern, size, tape,
+									  pos + step, step, remaining - 1);
+	}
+
+	if ((size > 1) && (pattern[1].op == S_SYLLAB_OP_PLUS))
+	{
+		if (!first)
+			return FALSE;
+
+		/* pattern[0] + "*" + pattern[2:] against the same tape */
+		new_pattern[0] = pattern[0];
+		new_pattern[1] = pattern[1];
+		new_pattern[1].op = S_SYLLAB_OP_STAR;
+		memcpy(new_pattern + 2, pattern + 2, sizeof(s_syllab_item) * (size - 2));
+		return context_match(automaton, new_pattern, size, tape, pos, step, remaining);
+	}
+
+	return first && context_match(automaton, pattern + 1, size - 1, tape,
+								  pos + step, step, remaining - 1);
+}
+
+
+/*
+ * the automaton rule of the first rule of the phone that matches at
+ * position pos of the tape, or -1. The tape is the phone identifiers
+ * of "# phones #".
+ */
+static sint32 match_rule(const s_syllab_automaton *automaton,
+						 const s_syllab_phone *phone, const uint32 *tape,
+						 uint32 tape_size, uint32 pos)
+{
+	uint32 set[S_SYLLAB_MAX_SET_WORDS];
+	const s_syllab_rule *rule;
+	const uint32 *row;
+	uint32 matches;
+	uint32 bit;
+	uint32 i;
+	uint32 k;
+
+
+	for (i = 0; i < phone->set_size; i++)
+		set[i] = ~(uint32)0;
+
+	if ((phone->num_rules % S_SYLLAB_SET_BITS) != 0)
+		set[phone->set_size - 1] = ((uint32)1 << (phone->num_rules % S_SYLLAB_SET_BITS)) - 1;
+
+	for (k = 0; k < phone->right_size; k++)
+	{
+		if ((pos + k) < tape_size)
+			row = &phone->right[((k * automaton->num_symbols) + tape[pos + k]) * phone->set_size];
+		else
+			row = &phone->right_end[k * phone->set_size];
+
+		for (i = 0; i < phone->set_size; i++)
+			set[i] &= row[i];
+	}
+
+	for (k = 0; k < phone->left_size; k++)
+	{
+		if (k < pos)
+			row = &phone->left[((k * automaton->num_symbols) + tape[pos - k - 1]) * phone->set_size];
+		else
+			row = &phone->left_end[k * phone->set_size];
+
+		for (i = 0; i < phone->set_size; i++)
+			set[i] &= row[i];
+	}
+
+	for (i = 0; i < phone->set_size; i++)
+	{
+		for (matches = set[i]; matches != 0; matches &= ~((uint32)1 << bit))
+		{
+			for (bit = 0; ((matches >> bit) & 1) == 0; bit++)
+				/* NOP */;
+
+			rule = &automaton->rules[phone->rules[(i * S_SYLLAB_SET_BITS) + bit]];
+
+			if (!rule->lc_fixed
+				&& !context_match(automaton, rule->LC, rule->lc_size, tape,
+								  (sint32)pos - 1, -1, (sint32)pos))
+				continue;
+
+			if (!rule->rc_fixed
+				&& !context_match(automaton, rule->RC, rule->rc_size, tape,
+								  (sint32)(pos + rule->a_size), 1,
+								  (sint32)tape_size - (sint32)(pos + rule->a_size)))
+				continue;
+
+			return (sint32)phone->rules[(i * S_SYLLAB_SET_BITS) + bit];
+		}
+	}
+
+	return -1;
+}
+
+
+/*
+ * syllable break, add syl to the syllables and return a new empty
+ * syllable. On errors syl is deleted.
+ */
+static SList *add_syllable(SList *syllables, SList *syl, s_erc *error)
+{
+	S_CLR_ERR(error);
+
+	SListPush(syllables, S_OBJECT(syl), error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "add_syllable",
+				  "Call to \"SListPush\" failed"))
+	{
+		s_erc local_err = S_SUCCESS;
+
+		S_DELETE(syl, "add_syllable", &local_err);
+		return NULL;
+	}
+
+	syl = S_LIST(S_NEW(SListList, error));
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "add_syllable",
+				  "Failed to create new list"))
+		return NULL;
+
+	return syl;
+}
+
+
+/* Syllabify with the compiled rules, see Syllabify */
+static SList *syllabify_compiled(const SSyllabificationRewrites *self,
+								 const SList *phoneList, s_erc *error)
+{
+	const s_syllab_automaton *automaton = self->automaton;
+	uint32 stack_tape[S_SYLLAB_WORD_STACK_SIZE + 2];
+	const char *stack_phones[S_SYLLAB_WORD_STACK_SIZE];
+	uint32 *tape = stack_tape;
+	const char **phones = stack_phones;
+	const s_syllab_rule *rule;
+	SList *syl = NULL;
+	SList *syllables = NULL;
+	SIterator *itr;
+	s_bool got_more_syllables = FALSE;
+	uint32 num_phones;
+	uint32 pos;
+	uint32 i;
+	uint32 j;
+	sint32 id = -1;
+
+
+	S_CLR_ERR(error);
+
+	num_phones = SListSize(phoneList, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "syllabify_compiled",
+				  "Call to \"SListSize\" failed"))
+		return NULL;
+
+	if (num_phones > S_SYLLAB_WORD_STACK_SIZE)
+	{
+		tape = S_MALLOC(uint32, num_phones + 2);
+		phones = S_MALLOC(const char*, num_phones);
+		if ((tape == NULL) || (phones == NULL))
+		{
+			S_FTL_ERR(error, S_MEMERROR,
+					  "syllabify_compiled",
+					  "Failed to allocate memory for phone identifiers");
+			goto quit_error;
+		}
+	}
+
+	/* the tape is "# phones #" */
+	tape[0] = automaton->word_end;
+	tape[num_phones + 1] = automaton->word_end;
+
+	itr = S_ITERATOR_GET(phoneList, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "syllabify_compiled",
+				  "Call to \"S_ITERATOR_GET\" failed"))
+		goto quit_error;
+
+	for (i = 0; (itr != NULL) && (i < num_phones); itr = SIteratorNext(itr), i++)
+	{
+		phones[i] = SObjectGetString(SIteratorObject(itr, error), error);
+		if (!*error)
+			id = find_id(automaton->ids, phones[i], s_strzsize(phones[i], error), error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "syllabify_compiled",
+					  "Call to \"SObjectGetString/find_id\" failed"))
+		{
+			S_DELETE(itr, "syllabify_compiled", error);
+			goto quit_error;
+		}
+
+		tape[i + 1] = (id < 0) ? automaton->num_ids : (uint32)id;
+	}
+
+	if (itr != NULL)
+		S_DELETE(itr, "syllabify_compiled", error);
+
+	/* create a new syllable */
+	syl = S_LIST(S_NEW(SListList, error));
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "syllabify_compiled",
+				  "Failed to create new list"))
+		goto quit_error;
+
+	/* create a new syllables list */
+	syllables = S_LIST(S_NEW(SListList, error));
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "syllabify_compiled",
+				  "Failed to create new list"))
+		goto quit_error;
+
+	pos = 1;
+	while (pos < (num_phones + 1))
+	{
+		const s_syllab_phone *phone = &automaton->phones[tape[pos]];
+
+
+		if (phone->num_rules == 0) /* no rules found !!! */
+		{
+			S_CTX_ERR(error, S_FAILURE,
+					  "syllabify_compiled",
+					  "No rewrite rules for phone '%s'", phones[pos - 1]);
+			goto quit_error;
+		}
+
+		id = match_rule(automaton, phone, tape, num_phones + 2, pos);
+		if (id < 0)
+		{
+			S_CTX_ERR(error, S_FAILURE,
+					  "syllabify_compiled",
+					  "Failed to find a matching rule for phone '%s'", phones[pos - 1]);
+			goto quit_error;
+		}
+
+		rule = &automaton->rules[id];
+
+		/* the phones of A, with the boundaries of B */
+		for (i = 0; i <= rule->a_size; i++)
+		{
+			s_bool boundary;
+
+
+			for (j = 0; j < rule->boundaries[i]; j++)
+			{
+				syl = add_syllable(syllables, syl, error);
+				if (S_CHK_ERR(error, S_CONTERR,
+							  "syllabify_compiled",
+							  "Call to \"add_syllable\" failed"))
+					goto quit_error;
+
+				got_more_syllables = FALSE;
+			}
+
+			if (i == rule->a_size)
+				break;
+
+			/* a phone that is the boundary symbol is a boundary */
+			boundary = (automaton->boundary >= 0)
+				&& (tape[pos + i] == (uint32)automaton->boundary);
+
+			if (boundary)
+			{
+				syl = add_syllable(syllables, syl, error);
+				if (S_CHK_ERR(error, S_CONTERR,
+							  "syllabify_compiled",
+							  "Call to \"add_syllable\" failed"))
+					goto quit_error;
+
+				got_more_syllables = FALSE;
+			}
+			else
+			{
+				got_more_syllables = TRUE;
+				SListPush(syl,
+						  SObjectSetString(((pos + i) <= num_phones) ? phones[pos + i - 1] : "#",
+										   error),
+						  error);
+				if (S_CHK_ERR(error, S_CONTERR,
+							  "syllabify_compiled",
+							  "Call to \"SObjectSetString/SListPush\" failed"))
+					goto quit_error;
+			}
+		}
+
+		pos += rule->a_size;
+	}
+
+	if (got_more_syllables)
+	{
+		/* add last syl */
+		SListPush(syllables, S_OBJECT(syl), error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "syllabify_compiled",
+					  "Call to \"SListPush\" failed"))
+			goto quit_error;
+	}
+	else
+	{
+		/* nothing in syl, delete it */
+		S_DELETE(syl, "syllabify_compiled", error);
+	}
+
+	syl = NULL;
+
+	if (tape != stack_tape)
+	{
+		S_FREE(tape);
+		S_FREE(phones);
+	}
+
+	return syllables;
+
+	/* error occurred, clean up */
+quit_error:
+	{
+		s_erc local_err = S_SUCCESS;
+
+		if (syl != NULL)
+			S_DELETE(syl, "syllabify_compiled", &local_err);
+
+		if (syllables != NULL)
+			S_DELETE(syllables, "syllabify_compiled", &local_err);
+	}
+
+	if (tape != stack_tape)
+	{
+		if (tape != NULL)
+			S_FREE(tape);
+
+		if (phones != NULL)
+			S_FREE(phones);
+	}
+
+	return NULL;
+}
+
+
+/************************************************************************************/
+/*                                                                                  */
+/* Static class function implementations                                            */
+/*                                                                                  */
+/************************************************************************************/
+
+static void Init(void *obj, s_erc *error)
+{
+	SSyllabificationRewrites *self = obj;
+
+
+	S_CLR_ERR(error);
+	self->rules = NULL;
+	self->sets = NULL;
+	self->automaton = NULL;
+}
+
+
+static void Destroy(void *obj, s_erc *error)
+{
+	SSyllabificationRewrites *self = obj;
+
+
+	S_CLR_ERR(error);
+	if (self->rules != NULL)
+		S_DELETE(self->rules, "Destroy", error);
+
+	if (self->sets != NULL)
+		S_DELETE(self->sets, "Destroy", error);
+
+	if (self->automaton != NULL)
+		automaton_free(self->automaton);
+}
+
+
+static void Dispose(void *obj, s_erc *error)
+{
+	S_CLR_ERR(error);
+	SObjectDecRef(obj);
+}
+
+
+static const char *GetName(const SSyllabification *self, s_erc *error)
+{
+	S_CLR_ERR(error);
+
+	if (self->info == NULL)
+		return NULL;
+
+	return (const char*)self->info->name;
+}
+
+
+static const char *GetDescription(const SSyllabification *self, s_erc *error)
+{
+	S_CLR_ERR(error);
+
+	if (self->info == NULL)
+		return NULL;
+
+	return (const char*)self->info->description;
+}
+
+
+static const char *GetLanguage(const SSyllabification *self, s_erc *error)
+{
+	S_CLR_ERR(error);
+
+	if (self->info == NULL)
+		return NULL;
+
+	return (const char*)self->info->language;
+}
+
+
+static const char *GetLangCode(const SSyllabification *self, s_erc *error)
+{
+	S_CLR_ERR(error);
+
+	if (self->info == NULL)
+		return NULL;
+
+	return (const char*)self->info->lang_code;
+}
+
+
+static const s_version *SGetVersion(const SSyllabification *self, s_erc *error)
+{
+	S_CLR_ERR(error);
+
+	if (self->info == NULL)
+		return NULL;
+
+	return (const s_version*)&(self->info->version);
+}
+
+
+static const SObject *GetFeature(const SSyllabification *self, const char *key,
+								 s_erc *error)
+{
+	const SObject *feature;
+
+
+	S_CLR_ERR(error);
+	if (key == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "GetFeature",
+				  "Argument \"key\" is NULL");
+		return NULL;
+	}
+
+	if (self->features == NULL)
+		return NULL;
+
+	feature = SMapGetObjectDef(self->features, key, NULL, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "GetFeature",
+				  "Call to \"SMapGetObjectDef\" failed"))
+		return NULL;
+
+	return feature;
+}
+
+
+/**
+ * return a vallist of vallists where the primary list is syllables and the secondary
+ * lists are the phones in the syllables. for example :
+ * for mathematics phonelist is : (m , ae , th, ax, m, ae, t, ih, k, s)
+ * syllfunc returns : ((m, ae), (th, ax), (m, ae), (t, ih, k, s))
+ */
+
+static SList *Syllabify(const SSyllabification *self, const SItem *word,
+						const SList *phoneList, s_erc *error)
+{
+	s_str_list *string_list = NULL;
+	SList *syl = NULL;
+	SList *syllables = NULL;
+	s_bool got_more_syllables;
+	const s_str_list_element *itr;
+	const char *syllable_boundary_symbol;
+
+
+	S_CLR_ERR(error);
+	if (phoneList == NULL)
+	{
+		S_CTX_ERR(error, S_ARGERROR,
+				  "Syllabify",
+				  "Argument \"phoneList\" is NULL");
+		goto error_return;
+	}
+
+	if (S_SYLLABIFICATIONREWRITES(self)->automaton != NULL)
+	{
+		syllables = syllabify_compiled(S_SYLLABIFICATIONREWRITES(self), phoneList, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "Syllabify",
+					  "Call to \"syllabify_compiled\" failed"))
+			return NULL;
+
+		return syllables;
+	}
+
+	/* get syllable boundary symbol */
+	syllable_boundary_symbol = get_boundary_symbol(self, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "Syllabify",
+				  "Call to \"get_boundary_symbol\" failed"))
+		goto error_return;
+
+	string_list = run_rewrite_rules(S_SYLLABIFICATIONREWRITES(self),
+									phoneList, syllable_boundary_symbol,
+									error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "Syllabify",
+				  "Call to \"run_rewrite_rules\" failed"))
+		goto error_return;
+
+	/* create a new syllable */
+	syl = S_LIST(S_NEW(SListList, error));
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "Syllabify",
+				  "Failed to create new list"))
+		goto error_return;
+
+	/* create a new syllables list */
+	syllables = S_LIST(S_NEW(SListList, error));
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "Syllabify",
+				  "Failed to create new list"))
+		goto error_return;
+
+	/* iterate over otape */
+	itr = s_str_list_first(string_list, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "Syllabify",
+				  "Call to \"s_str_list_first\" failed"))
+		goto error_return;
+
+	got_more_syllables = FALSE;
+	while (itr != NULL)
+	{
+		const char *element;
+		int rv;
 
 
 		element = s_str_list_element_get(itr, error);
@@ -831,33 +2227,225 @@ error_return:
 	S_UNUSED(word);
 }
 
+
+static void Compile(SSyllabificationRewrites *self, s_erc *error)
+{
+	s_syllab_automaton *automaton = NULL;
+	s_syllab_compiler compiler;
+	const char *syllable_boundary_symbol;
+	const char *phone;
+	const SList *rules = NULL;
+	SIterator *itr = NULL;
+	s_bool compiled = TRUE;
+	sint32 id = -1;
+
+
+	S_CLR_ERR(error);
+
+	compiler.sets = self->sets;
+	compiler.class_ids = NULL;
+	compiler.rule_ids = NULL;
+	compiler.classes_size = 0;
+	compiler.rules_size = 0;
+
+	if (self->automaton != NULL)
+	{
+		automaton_free(self->automaton);
+		self->automaton = NULL;
+	}
+
+	if (self->rules == NULL)
+	{
+		S_CTX_ERR(error, S_FAILURE,
+				  "Compile",
+				  "Syllabification rewrites has no rules");
+		return;
+	}
+
+	syllable_boundary_symbol = get_boundary_symbol(S_SYLLABIFICATION(self), error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "Compile",
+				  "Call to \"get_boundary_symbol\" failed"))
+		return;
+
+	automaton = S_CALLOC(s_syllab_automaton, 1);
+	if (automaton == NULL)
+	{
+		S_FTL_ERR(error, S_MEMERROR,
+				  "Compile",
+				  "Failed to allocate memory for 's_syllab_automaton' object");
+		return;
+	}
+
+	automaton->ids = s_hash_table_new(&free_id, 8, error);
+	if (!*error)
+		compiler.class_ids = s_hash_table_new(&free_id, 8, error);
+	if (!*error)
+		compiler.rule_ids = s_hash_table_new(&free_id, 8, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "Compile",
+				  "Call to \"s_hash_table_new\" failed"))
+		goto quit;
+
+	/* number the phones of the rules and sets, "#" is the word ends */
+	automaton->word_end = add_phone_id(automaton, "#", error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "Compile",
+				  "Call to \"add_phone_id\" failed"))
+		goto quit;
+
+	itr = S_ITERATOR_GET(self->rules, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "Compile",
+				  "Call to \"S_ITERATOR_GET\" failed"))
+		goto quit;
+
+	for (/* NOP */; itr != NULL; itr = SIteratorNext(itr))
+	{
+		add_phone_id(automaton, SIteratorKey(itr, error), error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "Compile",
+					  "Call to \"SIteratorKey/add_phone_id\" failed"))
+			goto quit;
+
+		rules = S_CAST(SIteratorObject(itr, error), SList, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "Compile",
+					  "Call to \"S_CAST(SList)\" failed"))
+			goto quit;
+
+		add_rules_phone_ids(automaton, rules, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "Compile",
+					  "Call to \"add_rules_phone_ids\" failed"))
+			goto quit;
+	}
+
+	if (self->sets != NULL)
+	{
+		add_sets_phone_ids(automaton, self->sets, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "Compile",
+					  "Call to \"add_sets_phone_ids\" failed"))
+			goto quit;
+	}
+
+	automaton->num_symbols = automaton->num_ids + 1;
+	automaton->class_size = (automaton->num_symbols + S_SYLLAB_SET_BITS - 1) / S_SYLLAB_SET_BITS;
+
+	automaton->boundary = find_id(automaton->ids, syllable_boundary_symbol,
+								  s_strzsize(syllable_boundary_symbol, error), error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "Compile",
+				  "Call to \"find_id\" failed"))
+		goto quit;
+
+	automaton->phones = S_CALLOC(s_syllab_phone, automaton->num_symbols);
+	if (automaton->phones == NULL)
+	{
+		S_FTL_ERR(error, S_MEMERROR,
+				  "Compile",
+				  "Failed to allocate memory for 's_syllab_phone' object");
+		goto quit;
+	}
+
+	/* compile the rules of each phone */
+	itr = S_ITERATOR_GET(self->rules, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "Compile",
+				  "Call to \"S_ITERATOR_GET\" failed"))
+		goto quit;
+
+	for (/* NOP */; itr != NULL; itr = SIteratorNext(itr))
+	{
+		phone = SIteratorKey(itr, error);
+		if (!*error)
+			id = find_id(automaton->ids, phone, s_strzsize(phone, error), error);
+		if (!*error)
+			rules = S_CAST(SIteratorObject(itr, error), SList, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "Compile",
+					  "Failed to get rules of phone"))
+			goto quit;
+
+		if (id < 0)
+			continue;
+
+		compiled = compile_phone(automaton, &compiler, &automaton->phones[id], rules,
+								 syllable_boundary_symbol, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "Compile",
+					  "Call to \"compile_phone\" failed for phone '%s'", phone))
+			goto quit;
+
+		if (!compiled)
+			break;
+	}
+
+	/* if the rules could not be compiled they are matched in order */
+	if (compiled)
+	{
+		self->automaton = automaton;
+		automaton = NULL;
+	}
+
+quit:
+	if (itr != NULL)
+	{
+		s_erc local_err = S_SUCCESS;
+
+		S_DELETE(itr, "Compile", &local_err);
+	}
+
+	if (automaton != NULL)
+		automaton_free(automaton);
+
+	if (compiler.class_ids != NULL)
+	{
+		s_erc local_err = S_SUCCESS;
+
+		s_hash_table_delete(compiler.class_ids, &local_err);
+	}
+
+	if (compiler.rule_ids != NULL)
+	{
+		s_erc local_err = S_SUCCESS;
+
+		s_hash_table_delete(compiler.rule_ids, &local_err);
+	}
+}
+
+
 /************************************************************************************/
 /*                                                                                  */
 /* SSyllabificationRewrites class initialization                                    */
 /*                                                                                  */
 /************************************************************************************/
 
-/* same as SSyllabificationClass */
 static SSyllabificationRewritesClass SyllabificationRewritesClass =
 {
-	/* SObjectClass */
-	{
-		"SSyllabification:SSyllabificationRewrites",
-		sizeof(SSyllabificationRewrites),
-		{ 0, 1},
-		Init,            /* init    */
-		Destroy,         /* destroy */
-		Dispose,         /* dispose */
-		NULL,            /* compare */
-		NULL,            /* print   */
-		NULL,            /* copy    */
+	{
+		/* SObjectClass */
+		{
+			"SSyllabification:SSyllabificationRewrites",
+			sizeof(SSyllabificationRewrites),
+			{ 0, 1},
+			Init,            /* init    */
+			Destroy,         /* destroy */
+			Dispose,         /* dispose */
+			NULL,            /* compare */
+			NULL,            /* print   */
+			NULL,            /* copy    */
+		},
+		/* SSyllabificationClass */
+		GetName,             /* get_name        */
+		GetDescription,      /* get_description */
+		GetLanguage,         /* get_language    */
+		GetLangCode,         /* get_lang_code   */
+		SGetVersion,         /* get_version     */
+		GetFeature,          /* get_feature     */
+		Syllabify            /* syllabify       */
 	},
-	/* SSyllabificationClass */
-	GetName,             /* get_name        */
-	GetDescription,      /* get_description */
-	GetLanguage,         /* get_language    */
-	GetLangCode,         /* get_lang_code   */
-	SGetVersion,         /* get_version     */
-	GetFeature,          /* get_feature     */
-	Syllabify            /* syllabify       */
+	/* SSyllabificationRewritesClass */
+	Compile                  /* compile         */
 };
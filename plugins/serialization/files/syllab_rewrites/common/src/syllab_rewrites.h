@@ -114,6 +114,19 @@ S_BEGIN_C_DECLS
 	S_SYLLABIFICATIONREWRITES_CALL(SELF, FUNC) ? TRUE : FALSE
 
 
+/************************************************************************************/
+/*                                                                                  */
+/* Data types                                                                       */
+/*                                                                                  */
+/************************************************************************************/
+
+/**
+ * The rewrite rules compiled for matching on phone identifiers, see
+ * #SSyllabificationRewritesClass::compile. Opaque type.
+ */
+typedef struct s_syllab_automaton s_syllab_automaton;
+
+
 /************************************************************************************/
 /*                                                                                  */
 /* SSyllabificationRewrites definition                                              */
@@ -140,6 +153,12 @@ typedef struct
 	 * @protected Set definitions.
 	 */
 	SMap            *sets;
+
+	/**
+	 * @protected Compiled rules, used by @c syllabify when not
+	 * @c NULL.
+	 */
+	s_syllab_automaton *automaton;
 } SSyllabificationRewrites;
 
 
@@ -150,10 +169,39 @@ typedef struct
 /************************************************************************************/
 
 /**
- * Typedef of the SSyllabificationRewrites class. Exactly the same as
- * SSyllabificationClass as no class methods are added.
+ * The SSyllabificationRewritesClass structure.
+ * @extends SSyllabificationClass
  */
-typedef SSyllabificationClass SSyllabificationRewritesClass;
+typedef struct
+{
+	/* Class members */
+	/**
+	 * @protected Inherit from #SSyllabificationClass.
+	 */
+	SSyllabificationClass  _inherit;
+
+	/* Class methods */
+	/**
+	 * Compile the rules and sets of the given syllabification
+	 * rewrites for matching on phone identifiers. Every phone and
+	 * set name of the rules is given an identifier, and every rule
+	 * item a bitset of the phones it matches. The rules of a phone
+	 * are selected with a table of rule bitsets per context position
+	 * and phone, so that the first matching rule is found without
+	 * trying the rules one by one. Rules with @c "*" or @c "+"
+	 * contexts are checked on the identifiers after selection.
+	 * Syllabification gives the same results as the rules in order.
+	 *
+	 * @param self The given syllabification rewrites, its rules,
+	 * sets and features must be set.
+	 * @param error Error code.
+	 *
+	 * @note If the rules can not be compiled (too many rules for a
+	 * phone, or too long contexts) the rules are matched in order,
+	 * this is not an error.
+	 */
+	void (*compile)(SSyllabificationRewrites *self, s_erc *error);
+} SSyllabificationRewritesClass;
 
 
 /************************************************************************************/
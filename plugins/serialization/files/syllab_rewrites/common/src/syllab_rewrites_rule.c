@@ -703,10 +703,10 @@ static s_bool _context_match(const s_str_list *pattern, const s_str_list *string
 						  "Call to \"s_str_list_nth_string\" failed"))
 				goto error_return;
 
-			s_str_list_prepend(tmp, s_strdup(pattern0, error), error);
+			s_str_list_prepend(tmp, pattern0, error);
 			if (S_CHK_ERR(error, S_CONTERR,
 						  "_context_match",
-						  "Call to \"s_strdup/s_str_list_prepend\" failed"))
+						  "Call to \"s_str_list_prepend\" failed"))
 				goto error_return;
 
 			s = _context_match(tmp, string, sets, error);
@@ -790,16 +790,16 @@ static s_bool _context_match(const s_str_list *pattern, const s_str_list *string
 						  "Call to \"s_str_list_slice\" failed"))
 				return FALSE;
 
-			s_str_list_prepend(tmp, s_strdup("*", error), error);
+			s_str_list_prepend(tmp, "*", error);
 			if (S_CHK_ERR(error, S_CONTERR,
 						  "_context_match",
-						  "Call to \"s_strdup/s_str_list_prepend\" failed"))
+						  "Call to \"s_str_list_prepend\" failed"))
 				goto error_return;
 
-			s_str_list_prepend(tmp, s_strdup(pattern0, error), error);
+			s_str_list_prepend(tmp, pattern0, error);
 			if (S_CHK_ERR(error, S_CONTERR,
 						  "_context_match",
-						  "Call to \"s_strdup/s_str_list_prepend\" failed"))
+						  "Call to \"s_str_list_prepend\" failed"))
 				goto error_return;
 
 			new_string = s_str_list_slice(string, 1, -1, error); /* string[1:] */
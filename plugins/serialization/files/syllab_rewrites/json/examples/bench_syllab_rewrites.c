@@ -0,0 +1,377 @@
+/************************************************************************************/
+/* Copyright (c) 2009-2011 The Department of Arts and Culture,                      */
+/* The Government of the Republic of South Africa.                                  */
+/*                                                                                  */
+/* Contributors:  Meraka Institute, CSIR, South Africa.                             */
+/*                                                                                  */
+/* Permission is hereby granted, free of charge, to any person obtaining a copy     */
+/* of this software and associated documentation files (the "Software"), to deal    */
+/* in the Software without restriction, including without limitation the rights     */
+/* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell        */
+/* copies of the Software, and to permit persons to whom the Software is            */
+/* furnished to do so, subject to the following conditions:                         */
+/* The above copyright notice and this permission notice shall be included in       */
+/* all copies or substantial portions of the Software.                              */
+/*                                                                                  */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR       */
+/* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,         */
+/* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE      */
+/* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER           */
+/* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,    */
+/* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN        */
+/* THE SOFTWARE.                                                                    */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* AUTHOR  : Speect contributors                                                    */
+/* DATE    : 19 October 2026                                                        */
+/*                                                                                  */
+/************************************************************************************/
+/*                                                                                  */
+/* Benchmark of the compiled syllabification rewrites rules against the rules      */
+/* matched in order. Reads a word list (the phones of a word separated by spaces    */
+/* on each line) or uses a built-in list.                                           */
+/*                                                                                  */
+/************************************************************************************/
+
+
+#include <stdio.h>
+#include <string.h>
+#include "speect.h"
+#include "syllabification.h"
+#include "syllab_rewrites.h"
+
+
+static const char *syllab_rewrites_json_plugin = "syllab_rewrites_json.spi";
+
+static const char *default_words[] =
+{
+	"s i l a b i f i k ei sh _ n",
+	"m a th _ m a t i k s",
+	"k _ m p y uu t _",
+	"i n t _ n a sh _ n _ l",
+	"ii k s p i _ r i _ n s",
+	"y e s t _ d ei",
+	"b y uu t i f _ l",
+	"l a ng g w i jh",
+	"t e l _ f ou n",
+	"g a v _ n m _ n t",
+	"d i p aa t m _ n t",
+	"y uu n i v _ s i t i",
+	"k a r _ k t _",
+	"k w e s ch _ n",
+	"s ai _ n s",
+	"e k s t r a",
+	"i n s t r uu m _ n t",
+	"k o n s t r a k sh _ n",
+	"ai s k r ii m",
+	"a b s t r a k t",
+	NULL
+};
+
+#define BENCH_MAX_WORDS 100000
+
+
+/* the phones of a word as a list */
+static SList *phone_list(const char *word, s_erc *error)
+{
+	SList *phones;
+	s_str_list *split;
+	const s_str_list_element *itr;
+
+
+	S_CLR_ERR(error);
+
+	phones = S_LIST(S_NEW(SListList, error));
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "phone_list",
+				  "Failed to create new list"))
+		return NULL;
+
+	split = s_str_list_split(word, " ", error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "phone_list",
+				  "Call to \"s_str_list_split\" failed"))
+	{
+		S_DELETE(phones, "phone_list", error);
+		return NULL;
+	}
+
+	for (itr = s_str_list_first(split, error);
+		 (itr != NULL) && (*error == S_SUCCESS);
+		 itr = s_str_list_element_next(itr, error))
+	{
+		SListAppend(phones, SObjectSetString(s_str_list_element_get(itr, error), error), error);
+	}
+
+	s_str_list_delete(split, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "phone_list",
+				  "Failed to create phone list"))
+	{
+		S_DELETE(phones, "phone_list", error);
+		return NULL;
+	}
+
+	return phones;
+}
+
+
+/* the syllables of a word as one string */
+static void syllables_string(const SList *syllables, char *buf, size_t size,
+							 s_erc *error)
+{
+	SIterator *itr;
+	SIterator *phoneItr;
+	const char *phone;
+
+
+	S_CLR_ERR(error);
+	buf[0] = '\0';
+
+	itr = S_ITERATOR_GET(syllables, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "syllables_string",
+				  "Call to \"S_ITERATOR_GET\" failed"))
+		return;
+
+	for (/* NOP */; itr != NULL; itr = SIteratorNext(itr))
+	{
+		phoneItr = S_ITERATOR_GET(SIteratorObject(itr, error), error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "syllables_string",
+					  "Call to \"S_ITERATOR_GET\" failed"))
+		{
+			S_DELETE(itr, "syllables_string", error);
+			return;
+		}
+
+		for (/* NOP */; phoneItr != NULL; phoneItr = SIteratorNext(phoneItr))
+		{
+			phone = SObjectGetString(SIteratorObject(phoneItr, error), error);
+			if (S_CHK_ERR(error, S_CONTERR,
+						  "syllables_string",
+						  "Call to \"SObjectGetString\" failed"))
+			{
+				S_DELETE(phoneItr, "syllables_string", error);
+				S_DELETE(itr, "syllables_string", error);
+				return;
+			}
+
+			if ((strlen(buf) + strlen(phone) + 2) < size)
+			{
+				strcat(buf, phone);
+				strcat(buf, " ");
+			}
+		}
+
+		if ((strlen(buf) + 3) < size)
+			strcat(buf, "- ");
+	}
+}
+
+
+/* syllabify all the words, returns the time in seconds */
+static double run(SSyllabification *syllab, SList **words, int num_words,
+				  int iterations, char **results, s_erc *error)
+{
+	SList *syllables;
+	double start;
+	double end;
+	int i;
+	int j;
+
+
+	S_CLR_ERR(error);
+
+	start = s_time_monotonic(error);
+
+	for (i = 0; i < iterations; i++)
+	{
+		for (j = 0; j < num_words; j++)
+		{
+			syllables = S_SYLLABIFICATION_CALL(syllab, syllabify)(syllab, NULL,
+																  words[j], error);
+			if (S_CHK_ERR(error, S_CONTERR,
+						  "run",
+						  "Call to method \"syllabify\" failed for word %d", j))
+				return 0.0;
+
+			if ((i == 0) && (results != NULL))
+				syllables_string(syllables, results[j], 1024, error);
+
+			S_DELETE(syllables, "run", error);
+			if (*error != S_SUCCESS)
+				return 0.0;
+		}
+	}
+
+	end = s_time_monotonic(error);
+
+	return end - start;
+}
+
+
+int main(int argc, char **argv)
+{
+	s_erc error = S_SUCCESS;
+	SSyllabification *syllab = NULL;
+	SPlugin *plugin = NULL;
+	s_syllab_automaton *automaton;
+	SList **words = NULL;
+	char **compiled = NULL;
+	char **legacy = NULL;
+	char line[1024];
+	int num_words = 0;
+	int iterations = 100;
+	int differ = 0;
+	double compiled_time;
+	double legacy_time;
+	FILE *fp;
+	int i;
+
+
+	S_CLR_ERR(&error);
+
+	error = speect_init(NULL);
+	if (error != S_SUCCESS)
+	{
+		printf("Failed to initialize Speect\n");
+		return 1;
+	}
+
+	words = S_CALLOC(SList*, BENCH_MAX_WORDS);
+	compiled = S_CALLOC(char*, BENCH_MAX_WORDS);
+	legacy = S_CALLOC(char*, BENCH_MAX_WORDS);
+	if ((words == NULL) || (compiled == NULL) || (legacy == NULL))
+	{
+		printf("out of memory\n");
+		goto quit;
+	}
+
+	if (argc > 1)
+	{
+		fp = fopen(argv[1], "r");
+		if (fp == NULL)
+		{
+			printf("failed to open word list '%s'\n", argv[1]);
+			goto quit;
+		}
+
+		while ((num_words < BENCH_MAX_WORDS) && (fgets(line, 1024, fp) != NULL))
+		{
+			line[strcspn(line, "\r\n")] = '\0';
+			if (line[0] == '\0')
+				continue;
+
+			words[num_words++] = phone_list(line, &error);
+			if (error != S_SUCCESS)
+				break;
+		}
+
+		fclose(fp);
+	}
+	else
+	{
+		for (i = 0; (default_words[i] != NULL) && (error == S_SUCCESS); i++)
+			words[num_words++] = phone_list(default_words[i], &error);
+	}
+
+	if (error != S_SUCCESS)
+	{
+		printf("failed to read the word list\n");
+		goto quit;
+	}
+
+	if (argc > 2)
+		iterations = atoi(argv[2]);
+
+	for (i = 0; i < num_words; i++)
+	{
+		compiled[i] = S_CALLOC(char, 1024);
+		legacy[i] = S_CALLOC(char, 1024);
+		if ((compiled[i] == NULL) || (legacy[i] == NULL))
+		{
+			printf("out of memory\n");
+			goto quit;
+		}
+	}
+
+	plugin = s_pm_load_plugin(syllab_rewrites_json_plugin, &error);
+	if (S_CHK_ERR(&error, S_CONTERR,
+				  "main",
+				  "Failed to load plug-in at '%s'", syllab_rewrites_json_plugin))
+		goto quit;
+
+	syllab = (SSyllabification*)SObjectLoad("syllabification.json",
+											"spct_syllabification_rewrites_json",
+											&error);
+	if (S_CHK_ERR(&error, S_CONTERR,
+				  "main",
+				  "Failed to load syllabification"))
+		goto quit;
+
+	if (S_SYLLABIFICATIONREWRITES(syllab)->automaton == NULL)
+		printf("rules are not compiled\n");
+
+	compiled_time = run(syllab, words, num_words, iterations, compiled, &error);
+	if (error != S_SUCCESS)
+		goto quit;
+
+	/* match the rules in order */
+	automaton = S_SYLLABIFICATIONREWRITES(syllab)->automaton;
+	S_SYLLABIFICATIONREWRITES(syllab)->automaton = NULL;
+	legacy_time = run(syllab, words, num_words, iterations, legacy, &error);
+	S_SYLLABIFICATIONREWRITES(syllab)->automaton = automaton;
+	if (error != S_SUCCESS)
+		goto quit;
+
+	for (i = 0; i < num_words; i++)
+	{
+		if (strcmp(compiled[i], legacy[i]) != 0)
+		{
+			printf("differ: word %d = [%s] / [%s]\n", i, compiled[i], legacy[i]);
+			differ++;
+		}
+	}
+
+	printf("words %d, iterations %d, differ %d\n", num_words, iterations, differ);
+	printf("compiled %.3f ms, rules in order %.3f ms, speedup %.2f\n",
+		   compiled_time * 1000.0, legacy_time * 1000.0,
+		   (compiled_time > 0.0) ? (legacy_time / compiled_time) : 0.0);
+
+quit:
+	if (syllab != NULL)
+		S_DELETE(syllab, "main", &error);
+
+	if (plugin != NULL)
+		S_DELETE(plugin, "main", &error);
+
+	for (i = 0; i < num_words; i++)
+	{
+		if (words[i] != NULL)
+			S_DELETE(words[i], "main", &error);
+		if (compiled != NULL)
+			S_FREE(compiled[i]);
+		if (legacy != NULL)
+			S_FREE(legacy[i]);
+	}
+
+	if (words != NULL)
+		S_FREE(words);
+
+	if (compiled != NULL)
+		S_FREE(compiled);
+
+	if (legacy != NULL)
+		S_FREE(legacy);
+
+	error = speect_quit();
+	if (error != S_SUCCESS)
+	{
+		printf("Call to 'speect_quit' failed\n");
+		return 1;
+	}
+
+	return (differ == 0) ? 0 : 1;
+}
@@ -71,7 +71,7 @@ static s_str_list *check_and_set_string_list(const SObject *poppedObject, s_erc
 /*                                                                                  */
 /************************************************************************************/
 
-S_LOCAL SSyllabificationRewrites *s_read_syllabification_rewrites_json(const char *path, s_erc *error)
+S_LOCAL SSyllabificationRewrites *s_read_syllabification_rewrites_json(SDatasource *ds, s_erc *error)
 {
 	SSyllabificationRewrites *syllab = NULL;
 	SMap *parsedFile = NULL;
@@ -89,13 +89,16 @@ S_LOCAL SSyllabificationRewrites *s_read_syllabification_rewrites_json(const cha
 	if (S_CHK_ERR(error, S_CONTERR,
 				  "s_read_syllabification_rewrites_json",
 				  "Failed to create new syllabification rewrite rules object"))
+	{
+		S_DELETE(ds, "s_read_syllabification_rewrites_json", error);
 		goto quit_error;
+	}
 
-	/* read the JSON file into a SMAP */
-	parsedFile = s_json_parse_config_file(path, error);
+	/* read the JSON data source into a SMAP */
+	parsedFile = s_json_parse_config_datasource(ds, error);
 	if (S_CHK_ERR(error, S_CONTERR,
 				  "s_read_syllabification_rewrites_json",
-				  "Call to \"s_json_parse_config_file\" failed"))
+				  "Call to \"s_json_parse_config_datasource\" failed"))
 		goto quit_error;
 
 	/* get "syllabification-definition" key */
@@ -225,6 +228,16 @@ S_LOCAL SSyllabificationRewrites *s_read_syllabification_rewrites_json(const cha
 	/* give rules to SSyllabificationRewrites */
 	syllab->rules = rules;
 
+	/* compile the rules for matching */
+	if (S_SYLLABIFICATIONREWRITES_METH_VALID(syllab, compile))
+	{
+		S_SYLLABIFICATIONREWRITES_CALL(syllab, compile)(syllab, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "s_read_syllabification_rewrites_json",
+					  "Call to method \"compile\" failed"))
+			goto quit_error;
+	}
+
 	/* done */
 	goto quit;
 
@@ -137,13 +137,37 @@ static void Dispose(void *obj, s_erc *error)
 static SObject *Load(const char *path, s_erc *error)
 {
 	SSyllabificationRewrites *syllab;
+	SDatasource *ds;
 
 
 	S_CLR_ERR(error);
 
-	syllab = s_read_syllabification_rewrites_json(path, error);
+	ds = SFilesourceOpenFile(path, "r", error);
 	if (S_CHK_ERR(error, S_CONTERR,
 				  "Load",
+				  "Call to \"SFilesourceOpenFile\" failed"))
+		return NULL;
+
+	syllab = s_read_syllabification_rewrites_json(ds, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "Load",
+				  "Call to \"s_read_syllabification_rewrites_json\" failed"))
+		return NULL;
+
+	return S_OBJECT(syllab);
+}
+
+
+static SObject *LoadFromDatasource(SDatasource *ds, s_erc *error)
+{
+	SSyllabificationRewrites *syllab;
+
+
+	S_CLR_ERR(error);
+
+	syllab = s_read_syllabification_rewrites_json(ds, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "LoadFromDatasource",
 				  "Call to \"s_read_syllabification_rewrites_json\" failed"))
 		return NULL;
 
@@ -185,5 +209,6 @@ static SJSONSyllabificationRewritesFileClass JSONSyllabificationRewritesFileClas
 	"spct_syllabification_rewrites_json",    /* format  */
 	Load,                                    /* load    */
 	Save,                      /* save    */
-	NULL                       /* save_to_datasource */
+	NULL,                      /* save_to_datasource   */
+	LoadFromDatasource         /* load_from_datasource */
 };
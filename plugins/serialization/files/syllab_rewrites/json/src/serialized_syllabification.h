@@ -89,16 +89,16 @@ S_LOCAL void _s_serialized_json_syllabification_rewrites_free(s_erc *error);
 
 
 /**
- * Read an JSON format syllabification rewrites rule-set from the given file.
+ * Read a JSON format syllabification rewrites rule-set from the given data source.
  *
- * @param path The full path and file name of the JSON format
- * syllabification rewrites rule-set to read.
+ * @param ds The data source to read the syllabification rewrites rule-set from. The
+ * function takes hold of the data source, it is deleted when reading
+ * is done (also on errors).
  * @param error Error code.
  *
  * @return Loaded syllabification or @c NULL on error.
  */
-S_LOCAL SSyllabificationRewrites *s_read_syllabification_rewrites_json(const char *path,
-																	   s_erc *error);
+S_LOCAL SSyllabificationRewrites *s_read_syllabification_rewrites_json(SDatasource *ds, s_erc *error);
 
 
 /************************************************************************************/
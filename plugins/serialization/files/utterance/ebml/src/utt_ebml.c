@@ -155,6 +155,23 @@ static SObject *Load(const char *path, s_erc *error)
 }
 
 
+static SObject *LoadFromDatasource(SDatasource *ds, s_erc *error)
+{
+	SUtterance *utt;
+
+
+	S_CLR_ERR(error);
+
+	utt = s_read_utt_ebml(ds, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "LoadFromDatasource",
+				  "Call to \"s_read_utt_ebml\" failed"))
+		return NULL;
+
+	return S_OBJECT(utt);
+}
+
+
 static void Save(const SObject *object, const char *path, s_erc *error)
 {
 	SUtterance *utt = S_UTTERANCE(object);
@@ -199,5 +216,6 @@ static SEbmlUttFileClass EbmlUttFileClass =
 	"spct_utt",                /* format  */
 	Load,                      /* load    */
 	Save,                      /* save    */
-	NULL                       /* save_to_datasource */
+	NULL,                      /* save_to_datasource   */
+	LoadFromDatasource         /* load_from_datasource */
 };
@@ -320,5 +320,6 @@ static SUttHTSLabelsExportClass UttHTSLabelsExportClass =
 	"spct_utt_htslabelsXML",       /* format  */
 	Load,                          /* load    */
 	Save,                      /* save    */
-	NULL                       /* save_to_datasource */
+	NULL,                      /* save_to_datasource   */
+	NULL                       /* load_from_datasource */
 };
@@ -187,5 +187,6 @@ static SMaryXMLUttFileClass MaryXMLUttFileClass =
 	"spct_utt_maryxml", 	   /* format  */
 	Load,                      /* load    */
 	Save,                      /* save    */
-	NULL                       /* save_to_datasource */
+	NULL,                      /* save_to_datasource   */
+	NULL                       /* load_from_datasource */
 };
@@ -188,5 +188,6 @@ static STextGridUttFileClass TextGridUttFileClass =
 	"spct_utt_textgrid",       /* format  */
 	Load,                      /* load    */
 	Save,                      /* save    */
-	NULL                       /* save_to_datasource */
+	NULL,                      /* save_to_datasource   */
+	NULL                       /* load_from_datasource */
 };
@@ -598,6 +598,7 @@ static void Init(void *obj, s_erc *error)
 	self->do_pruning = FALSE;
 	self->path_prune_envelope_width = -1.0;
 	self->cand_prune_envelope_width = -1.0;
+	self->cancel = NULL;
 
 	self->features = S_MAP(S_NEW(SMapList, error));
 	S_CHK_ERR(error, S_CONTERR,
@@ -630,6 +631,7 @@ static void InitViterbi(SViterbi **self, SRelation *rel,
 						candFunc userCandFunc, pathFunc userPathFunc,
 						int num_states, const SMap *config, s_erc *error)
 {
+	const SUtterance *utt;
 	const SItem *item;
 	SViterbiPoint *t;
 	SViterbiPoint *n;
@@ -676,6 +678,21 @@ static void InitViterbi(SViterbi **self, SRelation *rel,
 	/* set number of states */
 	(*self)->num_states = num_states;
 
+	utt = SRelationUtterance(rel, error);
+	if (S_CHK_ERR(error, S_CONTERR,
+				  "InitViterbi",
+				  "Call to \"SRelationUtterance\" failed"))
+		goto quit_error;
+
+	if (utt != NULL)
+	{
+		(*self)->cancel = SCancelTokenGetFromUtt(utt, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "InitViterbi",
+					  "Call to \"SCancelTokenGetFromUtt\" failed"))
+			goto quit_error;
+	}
+
 	if (config != NULL)
 	{
 		set_viterbi_params(*self, config, error);
@@ -937,6 +954,12 @@ static void Search(SViterbi *self, s_erc *error)
 
 	for (p = self->timeLine; p->next != NULL; p = p->next)
 	{
+		SCancelTokenCheck(self->cancel, error);
+		if (S_CHK_ERR(error, S_CONTERR,
+					  "Search",
+					  "Search stopped"))
+			return;
+
 		/* For each point in time find the candidates */
 		p->cands = (*self->userCandFunc)(p->s, self->features, error);  /* P(S|B) */
 		if (S_CHK_ERR(error, S_CONTERR,
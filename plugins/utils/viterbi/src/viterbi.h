@@ -264,6 +264,12 @@ typedef struct
 	 * @protected Viterbi features.
 	 */
 	SMap          *features;
+
+	/**
+	 * @protected Cancellation token of the utterance, checked at
+	 * every time point of the search, can be @c NULL.
+	 */
+	const SCancelToken *cancel;
 } SViterbi;
 
 
@@ -382,7 +388,9 @@ typedef struct
 							   s_erc *error);
 
 	/**
-	 * Do the the actual search.
+	 * Do the the actual search. Stops with the #S_CANCELLED error
+	 * code if the cancellation token of the utterance of the
+	 * relation (see #SCancelTokenGetFromUtt) is cancelled.
 	 *
 	 * @param self The given viterbi.
 	 * @param error Error code.